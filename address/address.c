@@ -994,6 +994,15 @@ const char *mutt_addr_for_display(const struct Address *a)
   if (!a->mailbox || addr_is_local(a))
     return a->mailbox;
 
+  /* A plain ascii mailbox without an ACE prefix displays as itself - skip
+   * the IDNA round-trip and its allocations.  This runs for every index
+   * row, so the common case must stay cheap.  */
+  if (mutt_str_is_ascii(a->mailbox, mutt_str_len(a->mailbox)) &&
+      !mutt_istr_find(a->mailbox, "xn--"))
+  {
+    return a->mailbox;
+  }
+
   if (addr_mbox_to_udomain(a->mailbox, &user, &domain) == -1)
     return a->mailbox;
 
@@ -62,6 +62,52 @@ bool C_IdnDecode; ///< Config: (idn) Decode international domain names
 bool C_IdnEncode; ///< Config: (idn) Encode international domain names
 #endif
 
+/// Map of "decode-flag|charset|domain" to the domain ready for display.
+/// Domains repeat enormously in mail, but mutt_addr_for_display() is called
+/// afresh for every index line, so without a cache the Punycode decode and
+/// charset conversion run on every redraw of an international folder.
+static struct HashTable *DomainCache = NULL;
+static size_t DomainCacheUsed = 0; ///< Entries in #DomainCache
+
+/// Drop #DomainCache when it reaches this many entries - a folder rarely has
+/// anywhere near this many distinct sending domains
+#define DOMAIN_CACHE_MAX 4096
+
+/**
+ * domain_cache_key - Build the #DomainCache key for a domain
+ * @param buf    Buffer for the key
+ * @param buflen Length of buffer
+ * @param domain Domain to look up
+ *
+ * The settings that influence the conversion are part of the key, so changing
+ * `$charset` or `$idn_decode` at runtime simply stops the old entries matching.
+ */
+static void domain_cache_key(char *buf, size_t buflen, const char *domain)
+{
+  int decode = 0;
+#ifdef HAVE_LIBIDN
+  decode = C_IdnDecode;
+#endif
+  snprintf(buf, buflen, "%d|%s|%s", decode, NONULL(C_Charset), domain);
+}
+
+/**
+ * domain_cache_elem_free - Free an entry in the #DomainCache - Implements ::hash_hdata_free_t
+ */
+static void domain_cache_elem_free(int type, void *obj, intptr_t data)
+{
+  FREE(&obj);
+}
+
+/**
+ * mutt_idna_cache_cleanup - Free the cache of converted domains
+ */
+void mutt_idna_cache_cleanup(void)
+{
+  mutt_hash_free(&DomainCache);
+  DomainCacheUsed = 0;
+}
+
 #ifdef HAVE_LIBIDN
 /* Work around incompatibilities in the libidn API */
 #if (!defined(HAVE_IDNA_TO_ASCII_8Z) && defined(HAVE_IDNA_TO_ASCII_FROM_UTF8))
@@ -153,6 +199,28 @@ char *mutt_idna_intl_to_local(const char *user, const char *domain, int flags)
   char *local_user = mutt_str_dup(user);
   char *local_domain = mutt_str_dup(domain);
 
+  /* The display path (MI_MAY_BE_IRREVERSIBLE) converts the same few domains
+   * over and over - answer those from the cache.  The reversible path is
+   * rare (sending) and its checks depend on the user part too, so it always
+   * does the full conversion. */
+  char keybuf[1024];
+  const bool cacheable = (flags & MI_MAY_BE_IRREVERSIBLE) && domain &&
+                         (mutt_str_len(domain) < 256);
+  if (cacheable)
+  {
+    domain_cache_key(keybuf, sizeof(keybuf), domain);
+    const char *hit = DomainCache ? mutt_hash_find(DomainCache, keybuf) : NULL;
+    if (hit)
+    {
+      if (mutt_ch_convert_string(&local_user, "utf-8", C_Charset, 0) != 0)
+        goto cleanup;
+      mutt_str_replace(&local_domain, hit);
+      mailbox = mutt_mem_malloc(mutt_str_len(local_user) + mutt_str_len(local_domain) + 2);
+      sprintf(mailbox, "%s@%s", NONULL(local_user), NONULL(local_domain));
+      goto cleanup;
+    }
+  }
+
 #ifdef HAVE_LIBIDN
   bool is_idn_encoded = check_idn(local_domain);
   if (is_idn_encoded && C_IdnDecode)
@@ -177,6 +245,19 @@ char *mutt_idna_intl_to_local(const char *user, const char *domain, int flags)
   if (mutt_ch_convert_string(&local_domain, "utf-8", C_Charset, 0) != 0)
     goto cleanup;
 
+  if (cacheable)
+  {
+    if (DomainCacheUsed >= DOMAIN_CACHE_MAX)
+      mutt_idna_cache_cleanup();
+    if (!DomainCache)
+    {
+      DomainCache = mutt_hash_new(256, MUTT_HASH_STRDUP_KEYS);
+      mutt_hash_set_destructor(DomainCache, domain_cache_elem_free, 0);
+    }
+    if (mutt_hash_insert(DomainCache, keybuf, mutt_str_dup(local_domain)))
+      DomainCacheUsed++;
+  }
+
   /* make sure that we can convert back and come out with the same
    * user and domain name.  */
   if ((flags & MI_MAY_BE_IRREVERSIBLE) == 0)
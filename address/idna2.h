@@ -31,6 +31,7 @@ extern bool C_IdnEncode;
 
 #define MI_MAY_BE_IRREVERSIBLE (1 << 0)
 
+void        mutt_idna_cache_cleanup(void);
 char *      mutt_idna_intl_to_local(const char *user, const char *domain, int flags);
 char *      mutt_idna_local_to_intl(const char *user, const char *domain);
 const char *mutt_idna_print_version(void);
@@ -54,6 +54,11 @@
 
 struct AliasList Aliases = TAILQ_HEAD_INITIALIZER(Aliases); ///< List of all the user's email aliases
 
+ARRAY_HEAD(AliasNameArray, struct Alias *);
+
+static struct AliasNameArray NameIndex = ARRAY_HEAD_INITIALIZER; ///< Aliases sorted by name, for completion
+static bool NameIndexValid = false; ///< Does NameIndex still match the Aliases list?
+
 /**
  * write_safe_address - Defang malicious email addresses
  * @param fp File to write to
@@ -481,6 +486,7 @@ retry_name:
 
   alias_reverse_add(alias);
   TAILQ_INSERT_TAIL(&Aliases, alias, entries);
+  NameIndexValid = false; /* no NT_ALIAS event is sent on this path */
 
   const char *alias_file = cs_subset_path(sub, "alias_file");
   mutt_str_copy(buf, NONULL(alias_file), sizeof(buf));
@@ -599,6 +605,98 @@ bool mutt_addr_is_user(const struct Address *addr)
   return false;
 }
 
+/**
+ * alias_name_cmp - Compare two Aliases by name - Implements ::sort_t
+ */
+static int alias_name_cmp(const void *a, const void *b)
+{
+  const struct Alias *x = *(struct Alias const *const *) a;
+  const struct Alias *y = *(struct Alias const *const *) b;
+
+  return strcmp(x->name, y->name);
+}
+
+/**
+ * name_index_build - Rebuild the sorted name index
+ *
+ * The index is rebuilt lazily: any change to the Aliases list just clears
+ * NameIndexValid (see alias_name_index_observer()) and the next completion
+ * pays for one sort.
+ */
+static void name_index_build(void)
+{
+  ARRAY_SHRINK(&NameIndex, ARRAY_SIZE(&NameIndex));
+
+  struct Alias *np = NULL;
+  TAILQ_FOREACH(np, &Aliases, entries)
+  {
+    if (np->name)
+      ARRAY_ADD(&NameIndex, np);
+  }
+  ARRAY_SORT(&NameIndex, alias_name_cmp);
+
+  NameIndexValid = true;
+}
+
+/**
+ * alias_name_index_observer - Listen for Alias changes - Implements ::observer_t
+ */
+static int alias_name_index_observer(struct NotifyCallback *nc)
+{
+  if (nc->event_type != NT_ALIAS)
+    return 0;
+
+  NameIndexValid = false;
+  return 0;
+}
+
+/**
+ * alias_complete_match - Find the Aliases whose name starts with a prefix
+ * @param[in]  prefix      Alias name prefix, e.g. from the user's partial input
+ * @param[out] num_matches Number of matching Aliases
+ * @retval ptr  First element of a contiguous array of matching Aliases
+ * @retval NULL No matches
+ *
+ * The matches come from a name-sorted index, so they're found with a binary
+ * search and returned as one contiguous run - no walk over the whole list.
+ * The returned pointers are only valid until the Aliases list next changes.
+ */
+struct Alias **alias_complete_match(const char *prefix, size_t *num_matches)
+{
+  *num_matches = 0;
+  const size_t plen = mutt_str_len(prefix);
+  if (plen == 0)
+    return NULL;
+
+  if (!NameIndexValid)
+    name_index_build();
+
+  /* find the first name that doesn't sort before the prefix */
+  size_t lo = 0;
+  size_t hi = ARRAY_SIZE(&NameIndex);
+  while (lo < hi)
+  {
+    const size_t mid = lo + ((hi - lo) / 2);
+    if (strncmp((*ARRAY_GET(&NameIndex, mid))->name, prefix, plen) < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  size_t end = lo;
+  while ((end < ARRAY_SIZE(&NameIndex)) &&
+         mutt_strn_equal((*ARRAY_GET(&NameIndex, end))->name, prefix, plen))
+  {
+    end++;
+  }
+
+  if (end == lo)
+    return NULL;
+
+  *num_matches = end - lo;
+  return ARRAY_GET(&NameIndex, lo);
+}
+
 /**
  * alias_new - Create a new Alias
  * @retval ptr Newly allocated Alias
@@ -653,6 +751,7 @@ void aliaslist_free(struct AliasList *al)
 void alias_init(void)
 {
   alias_reverse_init();
+  notify_observer_add(NeoMutt->notify, NT_ALIAS, alias_name_index_observer, NULL);
 }
 
 /**
@@ -667,4 +766,7 @@ void alias_shutdown(void)
   }
   aliaslist_free(&Aliases);
   alias_reverse_shutdown();
+  notify_observer_remove(NeoMutt->notify, alias_name_index_observer, NULL);
+  ARRAY_FREE(&NameIndex);
+  NameIndexValid = false;
 }
@@ -65,4 +65,6 @@ void          alias_free    (struct Alias **ptr);
 void          aliaslist_free(struct AliasList *al);
 struct Alias *alias_new     (void);
 
+struct Alias **alias_complete_match(const char *prefix, size_t *num_matches);
+
 #endif /* MUTT_ALIAS_ALIAS_H */
@@ -53,6 +53,9 @@ struct ConfigDef AliasVars[] = {
   { "sort_alias", DT_SORT|DT_SORT_REVERSE, NULL, SORT_ALIAS, IP SortAliasMethods, NULL,
     "Sort method for the alias menu"
   },
+  { "query_cache_timeout", DT_NUMBER|DT_NOT_NEGATIVE, NULL, 0, 0, NULL,
+    "Reuse $query_command results for this many seconds (0 to disable)"
+  },
   { "query_command", DT_STRING|DT_COMMAND, NULL, 0, 0, NULL,
     "External command to query and external address book"
   },
@@ -382,23 +382,24 @@ int alias_complete(char *buf, size_t buflen, struct ConfigSubset *sub)
 
   if (buf[0] != '\0')
   {
-    TAILQ_FOREACH(np, &Aliases, entries)
+    /* The matches are one contiguous run of the name-sorted index */
+    size_t num_matches = 0;
+    struct Alias **matches = alias_complete_match(buf, &num_matches);
+    for (size_t m = 0; m < num_matches; m++)
     {
-      if (np->name && mutt_strn_equal(np->name, buf, strlen(buf)))
+      np = matches[m];
+      if (bestname[0] == '\0') /* init */
       {
-        if (bestname[0] == '\0') /* init */
-        {
-          mutt_str_copy(bestname, np->name,
-                        MIN(mutt_str_len(np->name) + 1, sizeof(bestname)));
-        }
-        else
-        {
-          int i;
-          for (i = 0; np->name[i] && (np->name[i] == bestname[i]); i++)
-            ; // do nothing
+        mutt_str_copy(bestname, np->name,
+                      MIN(mutt_str_len(np->name) + 1, sizeof(bestname)));
+      }
+      else
+      {
+        int i;
+        for (i = 0; np->name[i] && (np->name[i] == bestname[i]); i++)
+          ; // do nothing
 
-          bestname[i] = '\0';
-        }
+        bestname[i] = '\0';
       }
     }
 
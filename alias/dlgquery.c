@@ -67,6 +67,63 @@ static const struct Mapping QueryHelp[] = {
   // clang-format on
 };
 
+/**
+ * struct QueryCacheEntry - Parsed results of one $query_command run
+ */
+struct QueryCacheEntry
+{
+  char *cmd;                            ///< Expanded command the results came from
+  time_t when;                          ///< When the command was run
+  struct AliasList results;             ///< Parsed Aliases
+  TAILQ_ENTRY(QueryCacheEntry) entries; ///< Linked list
+};
+TAILQ_HEAD(QueryCache, QueryCacheEntry);
+
+/// Results of recent $query_command runs, newest first
+static struct QueryCache QueryResults = TAILQ_HEAD_INITIALIZER(QueryResults);
+
+/**
+ * query_cache_entry_free - Free a cached query result
+ * @param[out] ptr Entry to free
+ */
+static void query_cache_entry_free(struct QueryCacheEntry **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct QueryCacheEntry *qce = *ptr;
+
+  FREE(&qce->cmd);
+  struct Alias *np = NULL;
+  struct Alias *tmp = NULL;
+  TAILQ_FOREACH_SAFE(np, &qce->results, entries, tmp)
+  {
+    TAILQ_REMOVE(&qce->results, np, entries);
+    alias_free(&np);
+  }
+  FREE(ptr);
+}
+
+/**
+ * query_cache_copy - Deep-copy a list of Aliases
+ * @param dst List to append to
+ * @param src First Alias to copy, and all those after it
+ *
+ * The cache keeps its own Aliases because callers take ownership of the
+ * results they are given.
+ */
+static void query_cache_copy(struct AliasList *dst, const struct Alias *src)
+{
+  for (; src; src = TAILQ_NEXT(src, entries))
+  {
+    struct Alias *alias = alias_new();
+    mutt_addrlist_copy(&alias->addr, &src->addr, false);
+    alias->name = mutt_str_dup(src->name);
+    alias->comment = mutt_str_dup(src->comment);
+    TAILQ_INSERT_TAIL(dst, alias, entries);
+  }
+}
+
 /**
  * alias_to_addrlist - Turn an Alias into an AddressList
  * @param al    AddressList to fill (must be empty)
@@ -247,6 +304,33 @@ static int query_run(char *s, bool verbose, struct AliasList *al,
   const char *query_command = cs_subset_string(sub, "query_command");
   mutt_buffer_file_expand_fmt_quote(cmd, query_command, s);
 
+  /* LDAP-backed query scripts easily take a second or two per fork; reuse
+   * recent results while they are fresh */
+  const short c_query_cache_timeout = cs_subset_number(sub, "query_cache_timeout");
+  if (c_query_cache_timeout > 0)
+  {
+    struct QueryCacheEntry *qce = NULL;
+    struct QueryCacheEntry *tmp = NULL;
+    TAILQ_FOREACH_SAFE(qce, &QueryResults, entries, tmp)
+    {
+      if ((mutt_date_epoch() - qce->when) >= c_query_cache_timeout)
+      {
+        TAILQ_REMOVE(&QueryResults, qce, entries);
+        query_cache_entry_free(&qce);
+        continue;
+      }
+      if (mutt_str_equal(qce->cmd, mutt_b2s(cmd)))
+      {
+        query_cache_copy(al, TAILQ_FIRST(&qce->results));
+        mutt_buffer_pool_release(&cmd);
+        return 0;
+      }
+    }
+  }
+
+  /* remember where this run's results start, for filling the cache */
+  struct Alias *al_last = TAILQ_LAST(al, AliasList);
+
   pid_t pid = filter_create(mutt_b2s(cmd), NULL, &fp, NULL);
   if (pid < 0)
   {
@@ -254,7 +338,6 @@ static int query_run(char *s, bool verbose, struct AliasList *al,
     mutt_buffer_pool_release(&cmd);
     return -1;
   }
-  mutt_buffer_pool_release(&cmd);
 
   if (verbose)
     mutt_message(_("Waiting for response..."));
@@ -293,8 +376,20 @@ static int query_run(char *s, bool verbose, struct AliasList *al,
   {
     if (verbose)
       mutt_message("%s", msg);
+
+    if (c_query_cache_timeout > 0)
+    {
+      struct QueryCacheEntry *qce = mutt_mem_calloc(1, sizeof(*qce));
+      qce->cmd = mutt_buffer_strdup(cmd);
+      qce->when = mutt_date_epoch();
+      TAILQ_INIT(&qce->results);
+      query_cache_copy(&qce->results,
+                       al_last ? TAILQ_NEXT(al_last, entries) : TAILQ_FIRST(al));
+      TAILQ_INSERT_HEAD(&QueryResults, qce, entries);
+    }
   }
   FREE(&msg);
+  mutt_buffer_pool_release(&cmd);
 
   return 0;
 }
@@ -552,7 +552,8 @@ enum AutocryptRec mutt_autocrypt_ui_recommendation(struct Email *e, char **keyli
 {
   enum AutocryptRec rc = AUTOCRYPT_REC_OFF;
   struct AutocryptAccount *account = NULL;
-  struct AutocryptPeer *peer = NULL;
+  struct AutocryptPeer **peers = NULL;
+  int num_peers = 0;
   struct Address *recip = NULL;
   bool all_encrypt = true, has_discourage = false;
   const char *matching_key = NULL;
@@ -609,9 +610,14 @@ enum AutocryptRec mutt_autocrypt_ui_recommendation(struct Email *e, char **keyli
   if (TAILQ_EMPTY(&recips))
     goto cleanup;
 
+  /* Batch the peer lookups; multi-recipient messages hit the database once */
+  mutt_autocrypt_db_peer_get_all(&recips, &peers, &num_peers);
+
+  int peer_idx = 0;
   TAILQ_FOREACH(recip, &recips, entries)
   {
-    if (mutt_autocrypt_db_peer_get(recip, &peer) <= 0)
+    struct AutocryptPeer *peer = peers[peer_idx++];
+    if (!peer)
     {
       if (keylist)
       {
@@ -654,8 +660,6 @@ enum AutocryptRec mutt_autocrypt_ui_recommendation(struct Email *e, char **keyli
     if (!mutt_buffer_is_empty(keylist_buf))
       mutt_buffer_addch(keylist_buf, ' ');
     mutt_buffer_addstr(keylist_buf, matching_key);
-
-    mutt_autocrypt_db_peer_free(&peer);
   }
 
   if (all_encrypt)
@@ -671,7 +675,9 @@ enum AutocryptRec mutt_autocrypt_ui_recommendation(struct Email *e, char **keyli
 cleanup:
   mutt_autocrypt_db_account_free(&account);
   mutt_addrlist_clear(&recips);
-  mutt_autocrypt_db_peer_free(&peer);
+  for (int i = 0; i < num_peers; i++)
+    mutt_autocrypt_db_peer_free(&peers[i]);
+  FREE(&peers);
   mutt_buffer_pool_release(&keylist_buf);
   return rc;
 }
@@ -49,6 +49,21 @@ static sqlite3_stmt *GossipHistoryInsertStmt;
 
 sqlite3 *AutocryptDB = NULL;
 
+/**
+ * autocrypt_db_tune - Tune the database connection
+ *
+ * Peer upserts happen for every incoming message carrying an Autocrypt
+ * header, so the rollback journal's fsync-per-statement cost is visible when
+ * opening a folder.  WAL mode with NORMAL synchronous amortises that cost.
+ * Failure is not fatal - an old sqlite or a read-only directory just leaves
+ * the default journal mode in place.
+ */
+static void autocrypt_db_tune(void)
+{
+  sqlite3_exec(AutocryptDB, "PRAGMA journal_mode = WAL;", NULL, NULL, NULL);
+  sqlite3_exec(AutocryptDB, "PRAGMA synchronous = NORMAL;", NULL, NULL, NULL);
+}
+
 /**
  * autocrypt_db_create - Create an Autocrypt SQLite database
  * @param db_path Path to database file
@@ -65,6 +80,7 @@ static int autocrypt_db_create(const char *db_path)
     mutt_error(_("Unable to open autocrypt database %s"), db_path);
     return -1;
   }
+  autocrypt_db_tune();
   return mutt_autocrypt_schema_init();
 }
 
@@ -98,6 +114,7 @@ int mutt_autocrypt_db_init(bool can_create)
       goto cleanup;
     }
 
+    autocrypt_db_tune();
     if (mutt_autocrypt_schema_update())
       goto cleanup;
   }
@@ -600,6 +617,57 @@ cleanup:
   return rc;
 }
 
+/**
+ * mutt_autocrypt_db_peer_get_all - Get peer info for a list of Addresses
+ * @param[in]  al        List of Addresses to look up
+ * @param[out] peers     Array of peers, in list order; misses are NULL
+ * @param[out] num_peers Number of entries in the array
+ * @retval  0 Success
+ * @retval -1 Error (the array is still returned; failed lookups are NULL)
+ *
+ * Multi-recipient messages look up every recipient in one go.  The batch
+ * runs inside a single read transaction, so the database lock is taken once
+ * and all the lookups see the same snapshot.
+ *
+ * @note The caller must free each entry and the array itself
+ */
+int mutt_autocrypt_db_peer_get_all(struct AddressList *al,
+                                   struct AutocryptPeer ***peers, int *num_peers)
+{
+  int rc = 0;
+
+  *peers = NULL;
+  *num_peers = 0;
+
+  int count = 0;
+  struct Address *a = NULL;
+  TAILQ_FOREACH(a, al, entries)
+  {
+    count++;
+  }
+  if (count == 0)
+    return 0;
+
+  struct AutocryptPeer **results = mutt_mem_calloc(count, sizeof(*results));
+
+  const bool txn = (sqlite3_exec(AutocryptDB, "BEGIN;", NULL, NULL, NULL) == SQLITE_OK);
+
+  int i = 0;
+  TAILQ_FOREACH(a, al, entries)
+  {
+    if (mutt_autocrypt_db_peer_get(a, &results[i]) < 0)
+      rc = -1;
+    i++;
+  }
+
+  if (txn)
+    sqlite3_exec(AutocryptDB, "COMMIT;", NULL, NULL, NULL);
+
+  *peers = results;
+  *num_peers = count;
+  return rc;
+}
+
 /**
  * mutt_autocrypt_db_peer_insert - Insert a peer into the Autocrypt database
  * @param addr Email Address
@@ -55,6 +55,7 @@ void                           mutt_autocrypt_db_normalize_addr(struct Address *
 void                           mutt_autocrypt_db_normalize_addrlist(struct AddressList *al);
 void                           mutt_autocrypt_db_peer_free(struct AutocryptPeer **ptr);
 int                            mutt_autocrypt_db_peer_get(struct Address *addr, struct AutocryptPeer **peer);
+int                            mutt_autocrypt_db_peer_get_all(struct AddressList *al, struct AutocryptPeer ***peers, int *num_peers);
 void                           mutt_autocrypt_db_peer_history_free(struct AutocryptPeerHistory **ptr);
 int                            mutt_autocrypt_db_peer_history_insert(struct Address *addr, struct AutocryptPeerHistory *peerhist);
 struct AutocryptPeerHistory *  mutt_autocrypt_db_peer_history_new(void);
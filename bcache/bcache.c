@@ -31,6 +31,7 @@
 #include <dirent.h>
 #include <errno.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -38,6 +39,9 @@
 #include "mutt/lib.h"
 #include "email/lib.h"
 #include "bcache/lib.h"
+#ifdef USE_HCACHE_COMPRESSION
+#include "compress/lib.h"
+#endif
 #include "mutt_account.h"
 #include "muttlib.h"
 
@@ -46,6 +50,20 @@ struct ConnAccount;
 /* These Config Variables are only used in bcache.c */
 bool C_MessageCacheClean; ///< Config: (imap/pop) Clean out obsolete entries from the message cache
 char *C_MessageCachedir; ///< Config: (imap/pop) Directory for the message cache
+#ifdef USE_HCACHE_COMPRESSION
+short C_MessageCacheCompressLevel; ///< Config: (imap/pop) Level of compression for the message cache
+char *C_MessageCacheCompressMethod; ///< Config: (imap/pop) Enable message cache compression
+#endif
+
+#ifdef USE_HCACHE_COMPRESSION
+/// Magic bytes identifying a compressed cache entry; raw entries are RFC5322
+/// messages and can never start with these
+#define BCACHE_MAGIC "\0NMBC"
+#define BCACHE_MAGIC_LEN 5
+
+/// Length of the NUL-padded method name in a compressed entry's header
+#define BCACHE_METHOD_LEN 8
+#endif
 
 /**
  * struct BodyCache - Local cache of email bodies
@@ -53,6 +71,10 @@ char *C_MessageCachedir; ///< Config: (imap/pop) Directory for the message cache
 struct BodyCache
 {
   char *path;
+#ifdef USE_HCACHE_COMPRESSION
+  const struct ComprOps *cops; ///< Compression backend, NULL to store raw
+  void *cctx;                  ///< Open compression context
+#endif
 };
 
 /**
@@ -152,6 +174,21 @@ struct BodyCache *mutt_bcache_open(struct ConnAccount *account, const char *mail
     return NULL;
   }
 
+#ifdef USE_HCACHE_COMPRESSION
+  if (C_MessageCacheCompressMethod)
+  {
+    bcache->cops = compress_get_ops(C_MessageCacheCompressMethod);
+    if (bcache->cops)
+      bcache->cctx = bcache->cops->open(C_MessageCacheCompressLevel);
+    if (!bcache->cctx)
+    {
+      mutt_debug(LL_DEBUG1, "bcache: can't set up %s compression, storing raw\n",
+                 C_MessageCacheCompressMethod);
+      bcache->cops = NULL;
+    }
+  }
+#endif
+
   return bcache;
 }
 
@@ -165,10 +202,156 @@ void mutt_bcache_close(struct BodyCache **bcache)
 {
   if (!bcache || !*bcache)
     return;
+#ifdef USE_HCACHE_COMPRESSION
+  if ((*bcache)->cops)
+    (*bcache)->cops->close(&(*bcache)->cctx);
+#endif
   FREE(&(*bcache)->path);
   FREE(bcache);
 }
 
+#ifdef USE_HCACHE_COMPRESSION
+/**
+ * bcache_decompress - Transparently decompress a cache entry
+ * @param bcache Body Cache the entry came from
+ * @param fp     Just-opened cache file, positioned at the start
+ * @retval ptr  Readable stream of the message, positioned at the start
+ * @retval NULL The entry can't be decoded; treat it as a cache miss
+ *
+ * Raw entries (e.g. written before compression was enabled) are passed
+ * through untouched.  Compressed ones are inflated into an unlinked
+ * temporary stream and @a fp is closed.  An entry compressed with a method
+ * that isn't available now reads as a miss; the message is re-fetched and
+ * the entry overwritten.
+ */
+static FILE *bcache_decompress(struct BodyCache *bcache, FILE *fp)
+{
+  char magic[BCACHE_MAGIC_LEN];
+  if ((fread(magic, 1, sizeof(magic), fp) != sizeof(magic)) ||
+      (memcmp(magic, BCACHE_MAGIC, sizeof(magic)) != 0))
+  {
+    rewind(fp);
+    return fp;
+  }
+
+  char method[BCACHE_METHOD_LEN] = { 0 };
+  uint32_t dlen = 0;
+  char *cbuf = NULL;
+  FILE *fp_out = NULL;
+
+  if ((fread(method, 1, sizeof(method), fp) != sizeof(method)) ||
+      (fread(&dlen, 1, sizeof(dlen), fp) != sizeof(dlen)))
+  {
+    goto done;
+  }
+  method[sizeof(method) - 1] = '\0';
+
+  if (!bcache->cops || !mutt_str_equal(method, bcache->cops->name))
+  {
+    mutt_debug(LL_DEBUG1, "bcache: entry compressed with %s, can't decode\n", method);
+    goto done;
+  }
+
+  struct stat sb;
+  const size_t hlen = BCACHE_MAGIC_LEN + BCACHE_METHOD_LEN + sizeof(uint32_t);
+  if ((fstat(fileno(fp), &sb) != 0) || ((size_t) sb.st_size <= hlen))
+    goto done;
+  const size_t clen = sb.st_size - hlen;
+
+  cbuf = mutt_mem_malloc(clen);
+  if (fread(cbuf, 1, clen, fp) != clen)
+    goto done;
+
+  void *data = bcache->cops->decompress(bcache->cctx, cbuf, clen);
+  if (!data)
+    goto done;
+
+  fp_out = mutt_file_mkstemp();
+  if (!fp_out)
+    goto done;
+  if (fwrite(data, 1, dlen, fp_out) != dlen)
+  {
+    mutt_file_fclose(&fp_out);
+    goto done;
+  }
+  rewind(fp_out);
+
+done:
+  FREE(&cbuf);
+  mutt_file_fclose(&fp);
+  return fp_out;
+}
+
+/**
+ * bcache_compress_commit - Compress a temporary file into its final cache slot
+ * @param bcache Body Cache the file belongs to
+ * @param id     Per-mailbox unique identifier for the message
+ * @retval  0 Success; the temporary file has been consumed
+ * @retval -1 Failure; the caller should fall back to a plain rename
+ *
+ * Incompressible bodies (mostly messages that are one big base64 attachment)
+ * are left for the caller to store raw, so a cache entry is only ever
+ * compressed when that actually saves space.
+ */
+static int bcache_compress_commit(struct BodyCache *bcache, const char *id)
+{
+  int rc = -1;
+  char *data = NULL;
+  FILE *fp_out = NULL;
+  struct Buffer *tmppath = mutt_buffer_pool_get();
+  struct Buffer *dstpath = mutt_buffer_pool_get();
+  mutt_buffer_printf(tmppath, "%s%s.tmp", bcache->path, id);
+  mutt_buffer_printf(dstpath, "%s%s", bcache->path, id);
+
+  FILE *fp = mutt_file_fopen(mutt_b2s(tmppath), "r");
+  if (!fp)
+    goto done;
+
+  struct stat sb;
+  if ((fstat(fileno(fp), &sb) != 0) || (sb.st_size <= 0) || (sb.st_size > UINT32_MAX))
+    goto done;
+  const size_t dlen = sb.st_size;
+
+  data = mutt_mem_malloc(dlen);
+  if (fread(data, 1, dlen, fp) != dlen)
+    goto done;
+
+  size_t clen = 0;
+  void *cdata = bcache->cops->compress(bcache->cctx, data, dlen, &clen);
+  const size_t hlen = BCACHE_MAGIC_LEN + BCACHE_METHOD_LEN + sizeof(uint32_t);
+  if (!cdata || ((clen + hlen) >= dlen))
+    goto done;
+
+  fp_out = mutt_file_fopen(mutt_b2s(dstpath), "w");
+  if (!fp_out)
+    goto done;
+
+  char method[BCACHE_METHOD_LEN] = { 0 };
+  mutt_str_copy(method, bcache->cops->name, sizeof(method));
+  const uint32_t dlen32 = dlen;
+  if ((fwrite(BCACHE_MAGIC, 1, BCACHE_MAGIC_LEN, fp_out) != BCACHE_MAGIC_LEN) ||
+      (fwrite(method, 1, sizeof(method), fp_out) != sizeof(method)) ||
+      (fwrite(&dlen32, 1, sizeof(dlen32), fp_out) != sizeof(dlen32)) ||
+      (fwrite(cdata, 1, clen, fp_out) != clen) || (mutt_file_fclose(&fp_out) != 0))
+  {
+    mutt_file_fclose(&fp_out);
+    unlink(mutt_b2s(dstpath));
+    goto done;
+  }
+
+  mutt_debug(LL_DEBUG3, "bcache: compressed '%s': %zu -> %zu\n", id, dlen, clen + hlen);
+  unlink(mutt_b2s(tmppath));
+  rc = 0;
+
+done:
+  mutt_file_fclose(&fp);
+  FREE(&data);
+  mutt_buffer_pool_release(&tmppath);
+  mutt_buffer_pool_release(&dstpath);
+  return rc;
+}
+#endif /* USE_HCACHE_COMPRESSION */
+
 /**
  * mutt_bcache_get - Open a file in the Body Cache
  * @param bcache Body Cache from mutt_bcache_open()
@@ -186,6 +369,10 @@ FILE *mutt_bcache_get(struct BodyCache *bcache, const char *id)
   mutt_buffer_addstr(path, id);
 
   FILE *fp = mutt_file_fopen(mutt_b2s(path), "r");
+#ifdef USE_HCACHE_COMPRESSION
+  if (fp)
+    fp = bcache_decompress(bcache, fp);
+#endif
 
   mutt_debug(LL_DEBUG3, "bcache: get: '%s': %s\n", mutt_b2s(path), fp ? "yes" : "no");
 
@@ -236,6 +423,35 @@ FILE *mutt_bcache_put(struct BodyCache *bcache, const char *id)
   return fp;
 }
 
+/**
+ * mutt_bcache_append - Reopen an uncommitted file in the Body Cache
+ * @param bcache Body Cache from mutt_bcache_open()
+ * @param id     Per-mailbox unique identifier for the message
+ * @retval ptr  Success, positioned at the end of the partial data
+ * @retval NULL No uncommitted file exists for this id
+ *
+ * An interrupted download leaves a temporary file behind - see
+ * mutt_bcache_put().  This reopens it so the caller can continue where the
+ * download stopped, rather than starting from scratch.
+ */
+FILE *mutt_bcache_append(struct BodyCache *bcache, const char *id)
+{
+  if (!id || (*id == '\0') || !bcache)
+    return NULL;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  mutt_buffer_printf(path, "%s%s%s", bcache->path, id, ".tmp");
+
+  FILE *fp = mutt_file_fopen(mutt_b2s(path), "r+");
+  if (fp)
+    fseek(fp, 0, SEEK_END);
+
+  mutt_debug(LL_DEBUG3, "bcache: append: '%s': %s\n", mutt_b2s(path), fp ? "yes" : "no");
+
+  mutt_buffer_pool_release(&path);
+  return fp;
+}
+
 /**
  * mutt_bcache_commit - Move a temporary file into the Body Cache
  * @param bcache Body Cache from mutt_bcache_open()
@@ -245,6 +461,16 @@ FILE *mutt_bcache_put(struct BodyCache *bcache, const char *id)
  */
 int mutt_bcache_commit(struct BodyCache *bcache, const char *id)
 {
+#ifdef USE_HCACHE_COMPRESSION
+  /* any failure falls through to the plain rename - a raw entry is always a
+   * valid entry */
+  if (bcache && bcache->cops && id && (*id != '\0') &&
+      (bcache_compress_commit(bcache, id) == 0))
+  {
+    return 0;
+  }
+#endif
+
   struct Buffer *tmpid = mutt_buffer_pool_get();
   mutt_buffer_printf(tmpid, "%s.tmp", id);
 
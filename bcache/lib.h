@@ -34,6 +34,7 @@
 #ifndef MUTT_BCACHE_LIB_H
 #define MUTT_BCACHE_LIB_H
 
+#include "config.h"
 #include <stdio.h>
 
 struct ConnAccount;
@@ -42,6 +43,10 @@ struct BodyCache;
 /* These Config Variables are only used in bcache.c */
 extern bool  C_MessageCacheClean;
 extern char *C_MessageCachedir;
+#ifdef USE_HCACHE_COMPRESSION
+extern short C_MessageCacheCompressLevel;
+extern char *C_MessageCacheCompressMethod;
+#endif
 
 /**
  * typedef bcache_list_t - Prototype for mutt_bcache_list() callback
@@ -55,6 +60,7 @@ extern char *C_MessageCachedir;
  */
 typedef int (*bcache_list_t)(const char *id, struct BodyCache *bcache, void *data);
 
+FILE *            mutt_bcache_append(struct BodyCache *bcache, const char *id);
 void              mutt_bcache_close (struct BodyCache **bcache);
 int               mutt_bcache_commit(struct BodyCache *bcache, const char *id);
 int               mutt_bcache_del   (struct BodyCache *bcache, const char *id);
@@ -117,6 +117,118 @@ static void init_lastdir(void)
   }
 }
 
+/// How many directory listings to keep cached per session
+#define DIR_CACHE_LEN 20
+
+/**
+ * struct DirCacheEntry - One cached directory entry
+ */
+struct DirCacheEntry
+{
+  char *name;     ///< File name within the directory
+  struct stat st; ///< lstat() result from the scan
+};
+
+/**
+ * struct DirCache - Cached listing of one scanned directory
+ *
+ * A listing stays valid while the directory's mtime is unchanged and the same
+ * prefix and $mask are in effect, so revisiting a big maildir root over NFS
+ * costs one stat() instead of one lstat() per folder.
+ */
+struct DirCache
+{
+  char *path;                    ///< Directory that was scanned
+  char *prefix;                  ///< Prefix filter used during the scan
+  char *mask;                    ///< $mask pattern used during the scan
+  time_t mtime;                  ///< Directory mtime at scan time
+  struct DirCacheEntry *entries; ///< Entries that survived the filters
+  size_t num;                    ///< Number of entries
+  size_t max;                    ///< Allocated size of entries
+  STAILQ_ENTRY(DirCache) link;   ///< Linked list
+};
+STAILQ_HEAD(DirCacheList, DirCache);
+
+/// Cached directory listings, newest first
+static struct DirCacheList DirCaches = STAILQ_HEAD_INITIALIZER(DirCaches);
+static int DirCachesLen = 0; ///< Number of cached listings
+
+/**
+ * dir_cache_free - Free one cached directory listing
+ * @param ptr DirCache to free
+ */
+static void dir_cache_free(struct DirCache **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct DirCache *dc = *ptr;
+  for (size_t i = 0; i < dc->num; i++)
+    FREE(&dc->entries[i].name);
+  FREE(&dc->entries);
+  FREE(&dc->path);
+  FREE(&dc->prefix);
+  FREE(&dc->mask);
+  FREE(ptr);
+}
+
+/**
+ * dir_cache_find - Find a cached listing for a directory
+ * @param path   Directory to look up
+ * @param prefix Prefix filter in effect
+ * @param mask   $mask pattern in effect
+ * @retval ptr  Matching listing
+ * @retval NULL Nothing cached
+ */
+static struct DirCache *dir_cache_find(const char *path, const char *prefix,
+                                       const char *mask)
+{
+  struct DirCache *dc = NULL;
+  STAILQ_FOREACH(dc, &DirCaches, link)
+  {
+    if (mutt_str_equal(dc->path, path) && mutt_str_equal(dc->prefix, prefix) &&
+        mutt_str_equal(dc->mask, mask))
+    {
+      return dc;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * dir_cache_remove - Drop a listing from the cache
+ * @param dc DirCache to remove and free
+ */
+static void dir_cache_remove(struct DirCache *dc)
+{
+  STAILQ_REMOVE(&DirCaches, dc, DirCache, link);
+  DirCachesLen--;
+  dir_cache_free(&dc);
+}
+
+/**
+ * dir_cache_add - Insert a freshly scanned listing into the cache
+ * @param dc DirCache to insert (ownership is taken)
+ *
+ * The oldest listing is evicted once the cache is full.
+ */
+static void dir_cache_add(struct DirCache *dc)
+{
+  if (DirCachesLen == DIR_CACHE_LEN)
+  {
+    struct DirCache *last = STAILQ_FIRST(&DirCaches);
+    struct DirCache *np = NULL;
+    STAILQ_FOREACH(np, &DirCaches, link)
+    {
+      last = np;
+    }
+    dir_cache_remove(last);
+  }
+
+  STAILQ_INSERT_HEAD(&DirCaches, dc, link);
+  DirCachesLen++;
+}
+
 /**
  * mutt_browser_cleanup - Clean up working Buffers
  */
@@ -124,6 +236,14 @@ void mutt_browser_cleanup(void)
 {
   mutt_buffer_dealloc(&LastDir);
   mutt_buffer_dealloc(&LastDirBackup);
+
+  struct DirCache *dc = NULL;
+  while ((dc = STAILQ_FIRST(&DirCaches)))
+  {
+    STAILQ_REMOVE_HEAD(&DirCaches, link);
+    dir_cache_free(&dc);
+  }
+  DirCachesLen = 0;
 }
 
 /**
@@ -740,58 +860,112 @@ static int examine_directory(struct Menu *menu, struct BrowserState *state,
     if (Context && Context->mailbox)
       mutt_mailbox_check(Context->mailbox, 0);
 
-    dp = opendir(d);
-    if (!dp)
+    const char *mask = (C_Mask && C_Mask->pattern) ? C_Mask->pattern : "";
+
+    struct DirCache *dc = dir_cache_find(d, NONULL(prefix), mask);
+    if (dc && (dc->mtime != s.st_mtime))
     {
-      mutt_perror(d);
-      goto ed_out;
+      dir_cache_remove(dc);
+      dc = NULL;
+    }
+
+    if (!dc)
+    {
+      dp = opendir(d);
+      if (!dp)
+      {
+        mutt_perror(d);
+        goto ed_out;
+      }
     }
 
     init_state(state, menu);
 
     struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
     neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
-    while ((de = readdir(dp)))
+
+    /* Looking each entry up in the mailbox list is O(folders * mailboxes)
+     * with the straight list walk, which hurts at maildir-root sizes */
+    struct HashTable *mb_hash = mutt_hash_new(64, MUTT_HASH_NO_FLAGS);
+    struct MailboxNode *np = NULL;
+    STAILQ_FOREACH(np, &ml, entries)
     {
-      if (mutt_str_equal(de->d_name, "."))
-        continue; /* we don't need . */
+      mutt_hash_insert(mb_hash, mailbox_path(np->mailbox), np);
+    }
 
-      if (prefix && *prefix && !mutt_str_startswith(de->d_name, prefix))
+    if (dc)
+    {
+      /* Replay the cached scan - no lstat() calls at all */
+      for (size_t i = 0; i < dc->num; i++)
       {
-        continue;
+        const struct DirCacheEntry *dce = &dc->entries[i];
+        mutt_buffer_concat_path(buf, d, dce->name);
+        np = mutt_hash_find(mb_hash, mutt_b2s(buf));
+        if (np && Context && Context->mailbox &&
+            mutt_str_equal(np->mailbox->realpath, Context->mailbox->realpath))
+        {
+          np->mailbox->msg_count = Context->mailbox->msg_count;
+          np->mailbox->msg_unread = Context->mailbox->msg_unread;
+        }
+        add_folder(menu, state, dce->name, NULL, &dce->st, np ? np->mailbox : NULL, NULL);
       }
-      if (!mutt_regex_match(C_Mask, de->d_name))
+    }
+    else
+    {
+      dc = mutt_mem_calloc(1, sizeof(struct DirCache));
+      dc->path = mutt_str_dup(d);
+      dc->prefix = mutt_str_dup(NONULL(prefix));
+      dc->mask = mutt_str_dup(mask);
+      dc->mtime = s.st_mtime;
+
+      struct stat sd = s;
+      while ((de = readdir(dp)))
       {
-        continue;
-      }
+        if (mutt_str_equal(de->d_name, "."))
+          continue; /* we don't need . */
 
-      mutt_buffer_concat_path(buf, d, de->d_name);
-      if (lstat(mutt_b2s(buf), &s) == -1)
-        continue;
+        if (prefix && *prefix && !mutt_str_startswith(de->d_name, prefix))
+        {
+          continue;
+        }
+        if (!mutt_regex_match(C_Mask, de->d_name))
+        {
+          continue;
+        }
 
-      /* No size for directories or symlinks */
-      if (S_ISDIR(s.st_mode) || S_ISLNK(s.st_mode))
-        s.st_size = 0;
-      else if (!S_ISREG(s.st_mode))
-        continue;
+        mutt_buffer_concat_path(buf, d, de->d_name);
+        if (lstat(mutt_b2s(buf), &sd) == -1)
+          continue;
 
-      struct MailboxNode *np = NULL;
-      STAILQ_FOREACH(np, &ml, entries)
-      {
-        if (mutt_str_equal(mutt_b2s(buf), mailbox_path(np->mailbox)))
-          break;
-      }
+        /* No size for directories or symlinks */
+        if (S_ISDIR(sd.st_mode) || S_ISLNK(sd.st_mode))
+          sd.st_size = 0;
+        else if (!S_ISREG(sd.st_mode))
+          continue;
 
-      if (np && Context && Context->mailbox &&
-          mutt_str_equal(np->mailbox->realpath, Context->mailbox->realpath))
-      {
-        np->mailbox->msg_count = Context->mailbox->msg_count;
-        np->mailbox->msg_unread = Context->mailbox->msg_unread;
+        if (dc->num == dc->max)
+        {
+          dc->max = (dc->max == 0) ? 256 : (dc->max * 2);
+          mutt_mem_realloc(&dc->entries, dc->max * sizeof(struct DirCacheEntry));
+        }
+        dc->entries[dc->num].name = mutt_str_dup(de->d_name);
+        dc->entries[dc->num].st = sd;
+        dc->num++;
+
+        np = mutt_hash_find(mb_hash, mutt_b2s(buf));
+        if (np && Context && Context->mailbox &&
+            mutt_str_equal(np->mailbox->realpath, Context->mailbox->realpath))
+        {
+          np->mailbox->msg_count = Context->mailbox->msg_count;
+          np->mailbox->msg_unread = Context->mailbox->msg_unread;
+        }
+        add_folder(menu, state, de->d_name, NULL, &sd, np ? np->mailbox : NULL, NULL);
       }
-      add_folder(menu, state, de->d_name, NULL, &s, np ? np->mailbox : NULL, NULL);
+      closedir(dp);
+      dir_cache_add(dc);
     }
+    mutt_hash_free(&mb_hash);
     neomutt_mailboxlist_clear(&ml);
-    closedir(dp);
   }
   browser_sort(state);
   rc = 0;
@@ -475,6 +475,9 @@ int source_rc(const char *rcfile_path, struct Buffer *err)
     return -1;
   }
 
+  /* Sourced files nest, so the report shows the include tree */
+  const int span = mutt_trace_start(rcfile);
+
   token = mutt_buffer_pool_get();
   linebuf = mutt_buffer_pool_get();
 
@@ -558,6 +561,7 @@ int source_rc(const char *rcfile_path, struct Buffer *err)
 
   mutt_buffer_pool_release(&token);
   mutt_buffer_pool_release(&linebuf);
+  mutt_trace_end(span);
   return rc;
 }
 
@@ -869,6 +873,7 @@ enum CommandResult parse_ignore(struct Buffer *buf, struct Buffer *s,
     add_to_stailq(&Ignore, buf->data);
   } while (MoreArgs(s));
 
+  mutt_ignore_invalidate();
   return MUTT_CMD_SUCCESS;
 }
 
@@ -1896,6 +1901,7 @@ enum CommandResult parse_unignore(struct Buffer *buf, struct Buffer *s,
     remove_from_stailq(&Ignore, buf->data);
   } while (MoreArgs(s));
 
+  mutt_ignore_invalidate();
   return MUTT_CMD_SUCCESS;
 }
 
@@ -168,6 +168,7 @@ static void process_protected_headers(struct Email *e)
       e->env->real_subj = e->env->subject + pmatch[0].rm_eo;
     else
       e->env->real_subj = e->env->subject;
+    e->env->real_subj_hash = 0;
 
     if (Context->mailbox->subj_hash)
       mutt_hash_insert(Context->mailbox->subj_hash, e->env->real_subj, e);
@@ -191,6 +192,31 @@ static void process_protected_headers(struct Email *e)
 #endif
 }
 
+/**
+ * filter_cache_store_file - Remember a file's contents in the decode cache
+ * @param key  Cache key
+ * @param path File holding the filtered message text
+ *
+ * Used to keep the output of $display_filter, so re-reading a message
+ * doesn't fork the filter again.
+ */
+static void filter_cache_store_file(const char *key, const char *path)
+{
+  struct stat st;
+  if ((stat(path, &st) != 0) || (st.st_size > (C_DecodeCacheSize / 4)))
+    return;
+
+  FILE *fp = mutt_file_fopen(path, "r");
+  if (!fp)
+    return;
+
+  char *buf = mutt_mem_malloc((st.st_size > 0) ? st.st_size : 1);
+  if ((off_t) fread(buf, 1, st.st_size, fp) == st.st_size)
+    mutt_decode_cache_store(key, buf, st.st_size);
+  FREE(&buf);
+  mutt_file_fclose(&fp);
+}
+
 /**
  * mutt_display_message - Display a message in the pager
  * @param win_index Index Window
@@ -212,6 +238,7 @@ int mutt_display_message(struct MuttWindow *win_index, struct MuttWindow *win_ib
   CopyHeaderFlags chflags;
   pid_t filterpid = -1;
   struct Buffer *tempfile = NULL;
+  struct Buffer *filter_key = NULL;
   int res;
 
   mutt_parse_mime_message(m, e);
@@ -269,61 +296,107 @@ int mutt_display_message(struct MuttWindow *win_index, struct MuttWindow *win_ib
     goto cleanup;
   }
 
-  if (C_DisplayFilter)
-  {
-    fp_filter_out = fp_out;
-    fp_out = NULL;
-    filterpid = filter_create_fd(C_DisplayFilter, &fp_out, NULL, NULL, -1,
-                                 fileno(fp_filter_out), -1);
-    if (filterpid < 0)
-    {
-      mutt_error(_("Can't create display filter"));
-      mutt_file_fclose(&fp_filter_out);
-      unlink(mutt_b2s(tempfile));
-      goto cleanup;
-    }
-  }
-
   if (!C_Pager || mutt_str_equal(C_Pager, "builtin"))
     builtin = true;
-  else
-  {
-    char buf[1024];
-    struct HdrFormatInfo hfi;
-
-    hfi.mailbox = m;
-    hfi.msg_in_pager = Context ? Context->msg_in_pager : -1;
-    hfi.pager_progress = ExtPagerProgress;
-    hfi.email = e;
-    mutt_make_string_info(buf, sizeof(buf), win_index->state.cols,
-                          NONULL(C_PagerFormat), &hfi, MUTT_FORMAT_NO_FLAGS);
-    fputs(buf, fp_out);
-    fputs("\n\n", fp_out);
-  }
 
   chflags = (C_Weed ? (CH_WEED | CH_REORDER) : CH_NO_FLAGS) | CH_DECODE | CH_FROM | CH_DISPLAY;
 #ifdef USE_NOTMUCH
   if (m->type == MUTT_NOTMUCH)
     chflags |= CH_VIRTUAL;
 #endif
-  res = mutt_copy_message(fp_out, m, e, cmflags, chflags, win_index->state.cols);
 
-  if (((mutt_file_fclose(&fp_out) != 0) && (errno != EPIPE)) || (res < 0))
+  bool filter_hit = false;
+  bool filter_cacheable = false;
+  if (C_DisplayFilter)
   {
-    mutt_error(_("Could not copy message"));
-    if (fp_filter_out)
+    /* The filtered text is cached alongside the decoded text, so re-reading
+     * a message doesn't fork $display_filter again.  An external pager gets
+     * a per-view header line mixed into the filter input, so only the
+     * builtin pager can reuse the output. */
+    if (builtin && (C_DecodeCacheSize > 0) && !((WithCrypto != 0) && e->security))
+    {
+      filter_key = mutt_buffer_pool_get();
+      mutt_decode_cache_key(filter_key, m, e, ((unsigned int) chflags << 4) | cmflags);
+      mutt_buffer_add_printf(filter_key, "|%s|%s", C_DisplayFilter, columns);
+      size_t len = 0;
+      const char *data = mutt_decode_cache_peek(mutt_b2s(filter_key), &len);
+      if (data)
+      {
+        if (fwrite(data, 1, len, fp_out) == len)
+        {
+          filter_hit = true;
+        }
+        else
+        {
+          (void) ftruncate(fileno(fp_out), 0);
+          rewind(fp_out);
+        }
+      }
+      else
+        filter_cacheable = true;
+    }
+
+    if (!filter_hit)
     {
-      filter_wait(filterpid);
-      mutt_file_fclose(&fp_filter_out);
+      fp_filter_out = fp_out;
+      fp_out = NULL;
+      filterpid = filter_create_fd(C_DisplayFilter, &fp_out, NULL, NULL, -1,
+                                   fileno(fp_filter_out), -1);
+      if (filterpid < 0)
+      {
+        mutt_error(_("Can't create display filter"));
+        mutt_file_fclose(&fp_filter_out);
+        unlink(mutt_b2s(tempfile));
+        goto cleanup;
+      }
     }
-    mutt_file_unlink(mutt_b2s(tempfile));
-    goto cleanup;
   }
 
-  if (fp_filter_out && (filter_wait(filterpid) != 0))
-    mutt_any_key_to_continue(NULL);
+  if (filter_hit)
+  {
+    mutt_file_fclose(&fp_out);
+  }
+  else
+  {
+    if (!builtin)
+    {
+      char buf[1024];
+      struct HdrFormatInfo hfi;
+
+      hfi.mailbox = m;
+      hfi.msg_in_pager = Context ? Context->msg_in_pager : -1;
+      hfi.pager_progress = ExtPagerProgress;
+      hfi.email = e;
+      mutt_make_string_info(buf, sizeof(buf), win_index->state.cols,
+                            NONULL(C_PagerFormat), &hfi, MUTT_FORMAT_NO_FLAGS);
+      fputs(buf, fp_out);
+      fputs("\n\n", fp_out);
+    }
+
+    res = mutt_copy_message_cached(fp_out, m, e, cmflags, chflags, win_index->state.cols);
+
+    if (((mutt_file_fclose(&fp_out) != 0) && (errno != EPIPE)) || (res < 0))
+    {
+      mutt_error(_("Could not copy message"));
+      if (fp_filter_out)
+      {
+        filter_wait(filterpid);
+        mutt_file_fclose(&fp_filter_out);
+      }
+      mutt_file_unlink(mutt_b2s(tempfile));
+      goto cleanup;
+    }
 
-  mutt_file_fclose(&fp_filter_out); /* XXX - check result? */
+    if (fp_filter_out)
+    {
+      if (filter_wait(filterpid) != 0)
+        mutt_any_key_to_continue(NULL);
+      else if (filter_cacheable && (res == 0))
+        filter_cache_store_file(mutt_b2s(filter_key), mutt_b2s(tempfile));
+    }
+
+    mutt_file_fclose(&fp_filter_out); /* XXX - check result? */
+  }
 
   if (WithCrypto)
   {
@@ -404,6 +477,7 @@ int mutt_display_message(struct MuttWindow *win_index, struct MuttWindow *win_ib
 cleanup:
   mutt_envlist_unset("COLUMNS");
   mutt_buffer_pool_release(&tempfile);
+  mutt_buffer_pool_release(&filter_key);
   return rc;
 }
 
@@ -1214,6 +1288,7 @@ int mutt_save_message(struct Mailbox *m, struct EmailList *el,
     if (m->type == MUTT_NOTMUCH)
       nm_db_longrun_init(m, true);
 #endif
+    mx_msg_batch_begin(ctx_save->mailbox);
     STAILQ_FOREACH(en, el, entries)
     {
       mutt_progress_update(&progress, ++tagged_progress_count, -1);
@@ -1242,6 +1317,8 @@ int mutt_save_message(struct Mailbox *m, struct EmailList *el,
     if (m->type == MUTT_NOTMUCH)
       nm_db_longrun_done(m);
 #endif
+    if ((mx_msg_batch_end(ctx_save->mailbox) != 0) && (rc == 0))
+      rc = -1;
     if (rc != 0)
     {
       mx_mbox_close(&ctx_save);
@@ -33,11 +33,13 @@
  */
 
 #include "config.h"
+#include <fcntl.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <utime.h>
 #include "mutt/lib.h"
 #include "core/lib.h"
 #include "gui/lib.h"
@@ -136,28 +138,80 @@ static void unlock_realpath(struct Mailbox *m)
 
 /**
  * setup_paths - Set the mailbox paths
- * @param m Mailbox to modify
+ * @param m         Mailbox to modify
+ * @param use_cache Allow reuse of the persistent cache copy, see $compress_cache
  * @retval  0 Success
  * @retval -1 Error
  *
  * Save the compressed filename in mailbox->realpath.
  * Create a temporary filename and put its name in mailbox->path.
  * The temporary file is created to prevent symlink attacks.
+ *
+ * With $compress_cache set, the plaintext file gets a stable name derived
+ * from the compressed file's path and is kept between openings.  If that copy
+ * is at least as new as the compressed file, the caller can skip the
+ * decompression entirely.
  */
-static int setup_paths(struct Mailbox *m)
+static int setup_paths(struct Mailbox *m, bool use_cache)
 {
   if (!m)
     return -1;
 
+  struct CompressInfo *ci = m->compress_info;
+
   /* Setup the right paths */
   mutt_str_replace(&m->realpath, mailbox_path(m));
 
-  /* We will uncompress to /tmp */
   struct Buffer *buf = mutt_buffer_pool_get();
-  mutt_buffer_mktemp(buf);
+
+  if (use_cache && C_CompressCache)
+  {
+    /* Decompress to a stable location instead of a throwaway file, so an
+     * unchanged mailbox can be reopened without decompressing it again */
+    unsigned char digest[16];
+    char hash[33];
+    mutt_md5(m->realpath, digest);
+    mutt_md5_toascii(digest, hash);
+    mutt_buffer_printf(buf, "%s/neomutt-compress-%s", NONULL(C_Tmpdir), hash);
+
+    struct stat st = { 0 };
+    if (lstat(mutt_b2s(buf), &st) == 0)
+    {
+      /* Only trust a plain file that we own and nobody else can read */
+      if (S_ISREG(st.st_mode) && (st.st_uid == getuid()) && ((st.st_mode & 0077) == 0))
+      {
+        ci->cache_used = true;
+
+        struct stat st_arch = { 0 };
+        if ((st.st_size > 0) && (stat(m->realpath, &st_arch) == 0) &&
+            (st.st_mtime >= st_arch.st_mtime))
+        {
+          ci->cache_valid = true;
+        }
+      }
+    }
+    else
+    {
+      /* Create it exclusively, so nobody can plant a symlink first */
+      int fd = open(mutt_b2s(buf), O_CREAT | O_EXCL | O_WRONLY, 0600);
+      if (fd >= 0)
+      {
+        close(fd);
+        ci->cache_used = true;
+      }
+    }
+    /* Anything suspicious: fall back to a throwaway temporary file */
+  }
+
+  if (!ci->cache_used)
+    mutt_buffer_mktemp(buf);
+
   mutt_buffer_copy(&m->pathbuf, buf);
   mutt_buffer_pool_release(&buf);
 
+  if (ci->cache_valid)
+    return 0; /* keep the cached contents */
+
   FILE *fp = mutt_file_fopen(mailbox_path(m), "w");
   if (!fp)
     return -1;
@@ -446,21 +500,29 @@ static int comp_mbox_open(struct Mailbox *m)
   if (!ci->cmd_close || (access(mailbox_path(m), W_OK) != 0))
     m->readonly = true;
 
-  if (setup_paths(m) != 0)
+  if (setup_paths(m, true) != 0)
     goto cmo_fail;
   store_size(m);
 
-  if (!lock_realpath(m, false))
+  if (ci->cache_valid)
   {
-    mutt_error(_("Unable to lock mailbox"));
-    goto cmo_fail;
+    /* The cached plaintext copy is fresher than the compressed file */
+    mutt_debug(LL_DEBUG1, "compress: reusing cached copy of '%s'\n", m->realpath);
   }
+  else
+  {
+    if (!lock_realpath(m, false))
+    {
+      mutt_error(_("Unable to lock mailbox"));
+      goto cmo_fail;
+    }
 
-  rc = execute_command(m, ci->cmd_open, _("Decompressing %s"));
-  if (rc == 0)
-    goto cmo_fail;
+    rc = execute_command(m, ci->cmd_open, _("Decompressing %s"));
+    if (rc == 0)
+      goto cmo_fail;
 
-  unlock_realpath(m);
+    unlock_realpath(m);
+  }
 
   m->type = mx_path_probe(mailbox_path(m));
   if (m->type == MUTT_UNKNOWN)
@@ -509,7 +571,9 @@ static int comp_mbox_open_append(struct Mailbox *m, OpenMailboxFlags flags)
     goto cmoa_fail1;
   }
 
-  if (setup_paths(m) != 0)
+  /* The append temporary only ever holds the new messages, so it must not
+   * reuse the cached copy of the whole mailbox */
+  if (setup_paths(m, false) != 0)
     goto cmoa_fail2;
 
   /* Lock the realpath for the duration of the append.
@@ -717,6 +781,13 @@ static int comp_mbox_close(struct Mailbox *m)
     {
       remove(m->realpath);
     }
+    else if (ci->cache_used)
+    {
+      /* Keep the plaintext copy for the next visit.  Any changes have
+       * already been recompressed by the sync, so freshen the timestamp to
+       * mark the copy as still valid. */
+      utime(mailbox_path(m), NULL);
+    }
     else
     {
       remove(mailbox_path(m));
@@ -945,6 +1016,7 @@ struct MxOps MxCompOps = {
   .msg_open_new     = comp_msg_open_new,
   .msg_commit       = comp_msg_commit,
   .msg_close        = comp_msg_close,
+  .msg_prefetch     = NULL,
   .msg_padding_size = comp_msg_padding_size,
   .msg_save_hcache  = comp_msg_save_hcache,
   .tags_edit        = comp_tags_edit,
@@ -54,6 +54,8 @@ struct CompressInfo
   const struct MxOps *child_ops; ///< callbacks of de-compressed file
   bool locked;                   ///< if realpath is locked
   FILE *fp_lock;                 ///< fp used for locking
+  bool cache_used;               ///< plaintext file is the persistent cache copy
+  bool cache_valid;              ///< cache copy is fresher than the compressed file
 };
 
 void mutt_comp_init(void);
@@ -58,6 +58,7 @@
 #include "init.h"
 #include "keymap.h"
 #include "mutt_attach.h"
+#include "mutt_body.h"
 #include "mutt_globals.h"
 #include "mutt_header.h"
 #include "mutt_logging.h"
@@ -1230,7 +1231,7 @@ static void compose_custom_redraw(struct Menu *menu)
     menu->redraw &= ~REDRAW_STATUS;
   }
 
-  if (menu->redraw & REDRAW_INDEX)
+  if (menu->redraw & (REDRAW_INDEX | REDRAW_SCROLL))
     menu_redraw_index(menu);
   else if (menu->redraw & (REDRAW_MOTION | REDRAW_MOTION_RESYNC))
     menu_redraw_motion(menu);
@@ -1293,6 +1294,13 @@ static unsigned long cum_attachs_size(struct Menu *menu)
   {
     b = idx[i]->body;
 
+    if (b->preencoded)
+    {
+      /* The tempfile already holds the wire form - its size is exact */
+      s += mutt_file_get_size(b->filename);
+      continue;
+    }
+
     if (!b->content)
       b->content = mutt_get_content_info(b->filename, b, sub);
 
@@ -1457,6 +1465,106 @@ static int compose_header_observer(struct NotifyCallback *nc)
   return -1;
 }
 
+/**
+ * autosave_path - Work out the rescue-draft path for an Email
+ * @param buf Buffer for the result
+ * @param e   Email being composed
+ * @retval true The Email has a body tempfile to sit beside
+ */
+static bool autosave_path(struct Buffer *buf, struct Email *e)
+{
+  if (!e || !e->body || !e->body->filename)
+    return false;
+
+  mutt_buffer_printf(buf, "%s.rescue", e->body->filename);
+  return true;
+}
+
+/**
+ * autosave_draft - Save a crash-rescue copy of the message being composed
+ * @param e    Email being composed
+ * @param actx Attachment context
+ * @param sub  ConfigSubset
+ *
+ * Write the envelope, an "Attach:" manifest for the attachments and a raw
+ * copy of the body text to a file beside the body tempfile.  The copy is
+ * written to a sibling file and renamed into place, so a crash never leaves
+ * a torn rescue file.  Attachments are referenced by path, never encoded,
+ * which keeps the write cheap however large they are.
+ *
+ * The result is a draft file: it can be resumed with `neomutt -H <file>` and
+ * the Attach: lines are re-attached by mutt_edit_headers() when $edit_headers
+ * is set.  The file is removed again on any deliberate exit from the compose
+ * menu - it only survives a crash.
+ */
+static void autosave_draft(struct Email *e, struct AttachCtx *actx,
+                           struct ConfigSubset *sub)
+{
+  const bool c_compose_autosave = cs_subset_bool(sub, "compose_autosave");
+  if (!c_compose_autosave)
+    return;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  struct Buffer *tmp = mutt_buffer_pool_get();
+
+  if (!autosave_path(path, e))
+    goto done;
+  mutt_buffer_printf(tmp, "%s.tmp", mutt_b2s(path));
+
+  FILE *fp = mutt_file_fopen(mutt_b2s(tmp), "w");
+  if (!fp)
+    goto done;
+
+  mutt_rfc822_write_header(fp, e->env, NULL, MUTT_WRITE_HEADER_EDITHDRS, false, false, sub);
+  for (int i = 1; i < actx->idxlen; i++)
+  {
+    struct Body *b = actx->idx[i]->body;
+    if (!b->filename)
+      continue;
+    fputs("Attach: ", fp);
+    for (const char *p = b->filename; *p; p++)
+    {
+      if ((p[0] == '\\') || (p[0] == ' ') || (p[0] == '\t'))
+        fputc('\\', fp);
+      fputc(*p, fp);
+    }
+    if (b->description)
+      fprintf(fp, " %s", b->description);
+    fputc('\n', fp);
+  }
+  fputc('\n', fp);
+
+  FILE *fp_body = mutt_file_fopen(e->body->filename, "r");
+  if (fp_body)
+  {
+    mutt_file_copy_stream(fp_body, fp);
+    mutt_file_fclose(&fp_body);
+  }
+
+  if ((ferror(fp) != 0) || (mutt_file_fsync_close(&fp) != 0) ||
+      (rename(mutt_b2s(tmp), mutt_b2s(path)) != 0))
+  {
+    mutt_file_fclose(&fp);
+    unlink(mutt_b2s(tmp));
+  }
+
+done:
+  mutt_buffer_pool_release(&path);
+  mutt_buffer_pool_release(&tmp);
+}
+
+/**
+ * autosave_remove - Delete the rescue draft on a deliberate exit
+ * @param e Email being composed
+ */
+static void autosave_remove(struct Email *e)
+{
+  struct Buffer *path = mutt_buffer_pool_get();
+  if (autosave_path(path, e))
+    unlink(mutt_b2s(path));
+  mutt_buffer_pool_release(&path);
+}
+
 /**
  * mutt_compose_menu - Allow the user to edit the message envelope
  * @param e      Email to fill
@@ -2367,6 +2475,7 @@ int mutt_compose_menu(struct Email *e, struct Buffer *fcc, struct Email *e_cur,
       {
         CHECK_COUNT;
         const char *c_editor = cs_subset_string(sub, "editor");
+        mutt_body_decode_preencoded(CUR_ATTACH->body);
         mutt_edit_file(NONULL(c_editor), CUR_ATTACH->body->filename);
         mutt_update_encoding(CUR_ATTACH->body, sub);
         menu->redraw |= REDRAW_CURRENT | REDRAW_STATUS;
@@ -2755,8 +2864,13 @@ int mutt_compose_menu(struct Email *e, struct Buffer *fcc, struct Email *e_cur,
       }
 #endif
     }
+
+    if (loop && (op >= 0))
+      autosave_draft(e, actx, sub);
   }
 
+  autosave_remove(e);
+
   mutt_buffer_dealloc(&fname);
 
 #ifdef USE_AUTOCRYPT
@@ -35,6 +35,9 @@
 
 static struct ConfigDef ComposeVars[] = {
   // clang-format off
+  { "compose_autosave", DT_BOOL, NULL, false, 0, NULL,
+    "Keep a crash-rescue copy of the message on disk while composing"
+  },
   { "compose_show_user_headers", DT_BOOL, NULL, true, 0, NULL,
     "Controls whether or not custom headers are shown in the compose envelope"
   },
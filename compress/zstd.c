@@ -46,16 +46,61 @@ struct ComprZstdCtx
   void *buf;   ///< Temporary buffer
   short level; ///< Compression Level to be used
 
-  ZSTD_CCtx *cctx; ///< Compression context
-  ZSTD_DCtx *dctx; ///< Decompression context
+  ZSTD_CCtx *cctx;   ///< Compression context
+  ZSTD_DCtx *dctx;   ///< Decompression context
+  ZSTD_CDict *cdict; ///< Optional pre-digested compression dictionary
+  ZSTD_DDict *ddict; ///< Optional pre-digested decompression dictionary
 };
 
+/**
+ * zstd_load_dictionary - Load the user's compression dictionary, if any
+ * @param ctx Private Zstandard Compression Context
+ *
+ * Read `$header_cache_compress_dictionary` and digest it for both compression
+ * and decompression.  On any failure the dictionaries are left unset and
+ * compression falls back to dictionary-less mode.
+ */
+static void zstd_load_dictionary(struct ComprZstdCtx *ctx)
+{
+  if (!C_HeaderCacheCompressDictionary)
+    return;
+
+  long size = mutt_file_get_size(C_HeaderCacheCompressDictionary);
+  if (size <= 0)
+    return;
+
+  FILE *fp = mutt_file_fopen(C_HeaderCacheCompressDictionary, "r");
+  if (!fp)
+    return;
+
+  char *dict = mutt_mem_malloc(size);
+  const bool read_ok = (fread(dict, 1, size, fp) == (size_t) size);
+  mutt_file_fclose(&fp);
+
+  if (read_ok)
+  {
+    ctx->cdict = ZSTD_createCDict(dict, size, ctx->level);
+    ctx->ddict = ZSTD_createDDict(dict, size);
+  }
+  FREE(&dict);
+
+  if (!ctx->cdict || !ctx->ddict)
+  {
+    mutt_debug(LL_DEBUG1, "Failed to load compression dictionary %s\n",
+               C_HeaderCacheCompressDictionary);
+    ZSTD_freeCDict(ctx->cdict);
+    ZSTD_freeDDict(ctx->ddict);
+    ctx->cdict = NULL;
+    ctx->ddict = NULL;
+  }
+}
+
 /**
  * compr_zstd_open - Implements ComprOps::open()
  */
 static void *compr_zstd_open(short level)
 {
-  struct ComprZstdCtx *ctx = mutt_mem_malloc(sizeof(struct ComprZstdCtx));
+  struct ComprZstdCtx *ctx = mutt_mem_calloc(1, sizeof(struct ComprZstdCtx));
 
   ctx->buf = mutt_mem_malloc(ZSTD_compressBound(1024 * 128));
   ctx->cctx = ZSTD_createCCtx();
@@ -81,6 +126,8 @@ static void *compr_zstd_open(short level)
 
   ctx->level = level;
 
+  zstd_load_dictionary(ctx);
+
   return ctx;
 }
 
@@ -97,7 +144,11 @@ static void *compr_zstd_compress(void *cctx, const char *data, size_t dlen, size
   size_t len = ZSTD_compressBound(dlen);
   mutt_mem_realloc(&ctx->buf, len);
 
-  size_t ret = ZSTD_compressCCtx(ctx->cctx, ctx->buf, len, data, dlen, ctx->level);
+  size_t ret;
+  if (ctx->cdict)
+    ret = ZSTD_compress_usingCDict(ctx->cctx, ctx->buf, len, data, dlen, ctx->cdict);
+  else
+    ret = ZSTD_compressCCtx(ctx->cctx, ctx->buf, len, data, dlen, ctx->level);
   if (ZSTD_isError(ret))
     return NULL; // LCOV_EXCL_LINE
 
@@ -125,7 +176,11 @@ static void *compr_zstd_decompress(void *cctx, const char *cbuf, size_t clen)
     return NULL; // LCOV_EXCL_LINE
   mutt_mem_realloc(&ctx->buf, len);
 
-  size_t ret = ZSTD_decompressDCtx(ctx->dctx, ctx->buf, len, cbuf, clen);
+  size_t ret;
+  if (ctx->ddict)
+    ret = ZSTD_decompress_usingDDict(ctx->dctx, ctx->buf, len, cbuf, clen, ctx->ddict);
+  else
+    ret = ZSTD_decompressDCtx(ctx->dctx, ctx->buf, len, cbuf, clen);
   if (ZSTD_isError(ret))
     return NULL; // LCOV_EXCL_LINE
 
@@ -148,6 +203,12 @@ static void compr_zstd_close(void **cctx)
   if (ctx->dctx)
     ZSTD_freeDCtx(ctx->dctx);
 
+  if (ctx->cdict)
+    ZSTD_freeCDict(ctx->cdict);
+
+  if (ctx->ddict)
+    ZSTD_freeDDict(ctx->ddict);
+
   FREE(&ctx->buf);
   FREE(cctx);
 }
@@ -116,6 +116,7 @@ void cs_subset_free(struct ConfigSubset **ptr)
     FREE(&list);
   }
 
+  mutt_hash_free(&sub->cache);
   notify_free(&sub->notify);
   FREE(&sub->name);
   FREE(ptr);
@@ -156,6 +157,8 @@ struct ConfigSubset *cs_subset_new(const char *name, struct ConfigSubset *sub_pa
   sub->notify = notify_new();
   notify_set_parent(sub->notify, not_parent);
 
+  sub->cache = mutt_hash_new(64, MUTT_HASH_STRDUP_KEYS);
+
   return sub;
 }
 
@@ -185,28 +188,41 @@ struct HashElem *cs_subset_lookup(const struct ConfigSubset *sub, const char *na
  * @param name Name of config item
  * @retval ptr  HashElem of the config item
  * @retval NULL Error
+ *
+ * Resolved items are cached in the Subset, so repeated reads of the same
+ * option cost a single small hash lookup.  The cache never goes stale: a
+ * HashElem lives as long as its Subset and value changes go through the elem.
  */
 struct HashElem *cs_subset_create_inheritance(const struct ConfigSubset *sub, const char *name)
 {
-  if (!sub)
+  if (!sub || !name)
     return NULL;
 
-  struct HashElem *he = cs_subset_lookup(sub, name);
+  struct HashElem *he = mutt_hash_find(sub->cache, name);
   if (he)
     return he;
 
-  if (sub->parent)
+  he = cs_subset_lookup(sub, name);
+  if (!he)
   {
-    // Create parent before creating name
-    he = cs_subset_create_inheritance(sub->parent, name);
-  }
+    if (sub->parent)
+    {
+      // Create parent before creating name
+      he = cs_subset_create_inheritance(sub->parent, name);
+    }
 
-  if (!he)
-    return NULL;
+    if (!he)
+      return NULL;
 
-  char scope[256];
-  snprintf(scope, sizeof(scope), "%s:%s", sub->name, name);
-  return cs_inherit_variable(sub->cs, he, scope);
+    char scope[256];
+    snprintf(scope, sizeof(scope), "%s:%s", sub->name, name);
+    he = cs_inherit_variable(sub->cs, he, scope);
+    if (!he)
+      return NULL;
+  }
+
+  mutt_hash_insert(sub->cache, name, he);
+  return he;
 }
 
 /**
@@ -28,6 +28,7 @@
 struct Buffer;
 struct ConfigSet;
 struct HashElem;
+struct HashTable;
 struct Notify;
 
 /**
@@ -50,6 +51,7 @@ struct ConfigSubset
   struct ConfigSubset *parent; ///< Parent Subset
   struct ConfigSet *cs;        ///< Parent ConfigSet
   struct Notify *notify;       ///< Notifications system
+  struct HashTable *cache;     ///< Cache of resolved config items: name -> HashElem
 };
 
 /**
@@ -28,6 +28,10 @@
 #include <time.h>
 #include "connaccount.h"
 
+/// Size of the Connection read buffer - big enough that bulk transfers
+/// (IMAP literals, POP bodies) refill it rarely
+#define MUTT_SOCKET_BUFFER_SIZE 65536
+
 /**
  * struct Connection - An open network connection (socket)
  */
@@ -35,7 +39,7 @@ struct Connection
 {
   struct ConnAccount account; ///< Account details: username, password, etc
   unsigned int ssf;           ///< Security strength factor, in bits (see below)
-  char inbuf[1024];           ///< Buffer for incoming traffic
+  char inbuf[MUTT_SOCKET_BUFFER_SIZE]; ///< Buffer for incoming traffic
   int bufpos;                 ///< Current position in the buffer
   int fd;                     ///< Socket file descriptor
   int available;              ///< Amount of data waiting to be read
@@ -28,18 +28,113 @@
 
 #include "config.h"
 #include <netdb.h>
+#include <stdio.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
 #include "mutt/lib.h"
 #include "conn/lib.h" // IWYU pragma: keep
 
+/**
+ * domain_cache_path - Get the path of the last-known-good domain cache
+ * @param path Buffer for the result
+ * @retval true A path was constructed
+ */
+static bool domain_cache_path(struct Buffer *path)
+{
+  const char *cache_home = mutt_str_getenv("XDG_CACHE_HOME");
+  if (cache_home)
+  {
+    mutt_buffer_printf(path, "%s/%s/hostname", cache_home, PACKAGE);
+    return true;
+  }
+
+  const char *home = mutt_str_getenv("HOME");
+  if (home)
+  {
+    mutt_buffer_printf(path, "%s/.cache/%s/hostname", home, PACKAGE);
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * domain_cache_read - Look up the last-known-good domain for a host
+ * @param node   Hostname the domain must belong to
+ * @param domain Buffer for the result
+ * @retval true Success, domain has been filled in
+ *
+ * The cache records which hostname the domain was resolved for, so a stale
+ * entry from a different host is never used.
+ */
+static bool domain_cache_read(const char *node, struct Buffer *domain)
+{
+  struct Buffer *path = mutt_buffer_pool_get();
+  bool rc = false;
+
+  if (domain_cache_path(path))
+  {
+    FILE *fp = mutt_file_fopen(mutt_b2s(path), "r");
+    if (fp)
+    {
+      char cached_node[256] = { 0 };
+      char cached_domain[256] = { 0 };
+      if ((fscanf(fp, "%255s %255s", cached_node, cached_domain) == 2) &&
+          mutt_str_equal(cached_node, node))
+      {
+        mutt_buffer_strcpy(domain, cached_domain);
+        rc = true;
+      }
+      mutt_file_fclose(&fp);
+    }
+  }
+
+  mutt_buffer_pool_release(&path);
+  return rc;
+}
+
+/**
+ * domain_cache_write - Record the last-known-good domain for a host
+ * @param node   Hostname the domain was resolved for
+ * @param domain Domain the resolver returned
+ */
+static void domain_cache_write(const char *node, const char *domain)
+{
+  struct Buffer *path = mutt_buffer_pool_get();
+
+  if (domain_cache_path(path))
+  {
+    char *slash = strrchr(path->data, '/');
+    if (slash)
+    {
+      *slash = '\0';
+      mutt_file_mkdir(mutt_b2s(path), S_IRWXU);
+      *slash = '/';
+    }
+
+    FILE *fp = mutt_file_fopen(mutt_b2s(path), "w");
+    if (fp)
+    {
+      fprintf(fp, "%s %s\n", node, domain);
+      mutt_file_fclose(&fp);
+    }
+  }
+
+  mutt_buffer_pool_release(&path);
+}
+
 /**
  * getdnsdomainname - Lookup the host's name using DNS
  * @param domain Buffer for the result
  * @retval  0 Success
  * @retval -1 Error
+ *
+ * The lookup runs with a short deadline (where getaddrinfo_a() allows one);
+ * if the resolver doesn't answer in time, the last answer it ever gave for
+ * this host is used instead, so a broken network can't stall startup.
  */
 int getdnsdomainname(struct Buffer *domain)
 {
@@ -100,6 +195,12 @@ int getdnsdomainname(struct Buffer *domain)
     rc = 0;
     mutt_debug(LL_DEBUG1, "Hostname: %s\n", mutt_b2s(domain));
     freeaddrinfo(h);
+    domain_cache_write(node, mutt_b2s(domain));
+  }
+  else if (domain_cache_read(node, domain))
+  {
+    rc = 0;
+    mutt_debug(LL_DEBUG1, "Hostname (cached): %s\n", mutt_b2s(domain));
   }
 #endif /* HAVE_GETADDRINFO || defined HAVE_GETADDRINFO_A */
 
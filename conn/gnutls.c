@@ -81,6 +81,77 @@ struct TlsSockData
   gnutls_certificate_credentials_t xcred;
 };
 
+/* TLS sessions negotiated with each "host:port", so that reconnecting to a
+ * server can resume a session instead of paying for a full handshake */
+static struct HashTable *TlsSessionCache = NULL;
+
+/**
+ * tls_session_free - Free a cached TLS session - Implements ::hash_hdata_free_t
+ */
+static void tls_session_free(int type, void *obj, intptr_t data)
+{
+  gnutls_datum_t *sess = obj;
+  FREE(&sess->data);
+  FREE(&sess);
+}
+
+/**
+ * tls_session_key - Build the session cache key for a Connection
+ * @param conn   Connection to a server
+ * @param buf    Buffer for the key
+ * @param buflen Length of the buffer
+ */
+static void tls_session_key(struct Connection *conn, char *buf, size_t buflen)
+{
+  snprintf(buf, buflen, "%s:%hu", conn->account.host, conn->account.port);
+}
+
+/**
+ * tls_cache_session - Remember the session negotiated with a server
+ * @param conn Connection to a server
+ * @param data TLS socket data
+ *
+ * Called at close, not after the handshake, because a TLS 1.3 session ticket
+ * only arrives once the server follows up.
+ */
+static void tls_cache_session(struct Connection *conn, struct TlsSockData *data)
+{
+#if defined(GNUTLS_SFLAGS_SESSION_TICKET) && defined(GNUTLS_TLS1_3)
+  /* without a ticket there's nothing to resume, and exporting the session
+   * would block waiting for one */
+  if ((gnutls_protocol_get_version(data->state) == GNUTLS_TLS1_3) &&
+      !(gnutls_session_get_flags(data->state) & GNUTLS_SFLAGS_SESSION_TICKET))
+  {
+    return;
+  }
+#endif
+
+  gnutls_datum_t sess = { 0 };
+  if (gnutls_session_get_data2(data->state, &sess) != 0)
+    return;
+  if (sess.size == 0)
+  {
+    gnutls_free(sess.data);
+    return;
+  }
+
+  gnutls_datum_t *copy = mutt_mem_malloc(sizeof(*copy));
+  copy->data = mutt_mem_malloc(sess.size);
+  memcpy(copy->data, sess.data, sess.size);
+  copy->size = sess.size;
+  gnutls_free(sess.data);
+
+  char key[256];
+  tls_session_key(conn, key, sizeof(key));
+  if (!TlsSessionCache)
+  {
+    TlsSessionCache = mutt_hash_new(32, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(TlsSessionCache, tls_session_free, 0);
+  }
+  mutt_hash_delete(TlsSessionCache, key, NULL);
+  mutt_hash_insert(TlsSessionCache, key, copy);
+}
+
 /**
  * tls_init - Set up Gnu TLS
  * @retval  0 Success
@@ -926,6 +997,17 @@ static int tls_negotiate(struct Connection *conn)
 
   gnutls_credentials_set(data->state, GNUTLS_CRD_CERTIFICATE, data->xcred);
 
+  /* a session from an earlier connection to this server lets the handshake
+   * resume in a single round trip */
+  if (TlsSessionCache)
+  {
+    char key[256];
+    tls_session_key(conn, key, sizeof(key));
+    const gnutls_datum_t *sess = mutt_hash_find(TlsSessionCache, key);
+    if (sess)
+      gnutls_session_set_data(data->state, sess->data, sess->size);
+  }
+
   do
   {
     err = gnutls_handshake(data->state);
@@ -996,6 +1078,8 @@ static int tls_socket_close(struct Connection *conn)
   struct TlsSockData *data = conn->sockdata;
   if (data)
   {
+    tls_cache_session(conn, data);
+
     /* shut down only the write half to avoid hanging waiting for the remote to respond.
      *
      * RFC5246 7.2.1. "Closure Alerts"
@@ -86,8 +86,32 @@ static int SkipModeExDataIndex = -1;
  * open up another connection to the same server in this session */
 static STACK_OF(X509) *SslSessionCerts = NULL;
 
+/* TLS sessions negotiated with each "host:port", so that reconnecting to a
+ * server can resume a session instead of paying for a full handshake */
+static struct HashTable *SslSessionCache = NULL;
+
 static int ssl_socket_close(struct Connection *conn);
 
+/**
+ * ssl_session_free - Free a cached SSL_SESSION - Implements ::hash_hdata_free_t
+ */
+static void ssl_session_free(int type, void *obj, intptr_t data)
+{
+  SSL_SESSION *sess = obj;
+  SSL_SESSION_free(sess);
+}
+
+/**
+ * ssl_session_key - Build the session cache key for a Connection
+ * @param conn   Connection to a server
+ * @param buf    Buffer for the key
+ * @param buflen Length of the buffer
+ */
+static void ssl_session_key(struct Connection *conn, char *buf, size_t buflen)
+{
+  snprintf(buf, buflen, "%s:%hu", conn->account.host, conn->account.port);
+}
+
 /**
  * struct SslSockData - SSL socket data
  */
@@ -1138,6 +1162,17 @@ static int ssl_negotiate(struct Connection *conn, struct SslSockData *ssldata)
     mutt_error(_("Warning: unable to set TLS SNI host name"));
   }
 
+  /* a session from an earlier connection to this server lets the handshake
+   * resume in a single round trip */
+  if (SslSessionCache)
+  {
+    char key[256];
+    ssl_session_key(conn, key, sizeof(key));
+    SSL_SESSION *sess = mutt_hash_find(SslSessionCache, key);
+    if (sess)
+      SSL_set_session(ssldata->ssl, sess);
+  }
+
   ERR_clear_error();
 
   err = SSL_connect(ssldata->ssl);
@@ -1351,6 +1386,26 @@ static int ssl_socket_close(struct Connection *conn)
 
   if (data)
   {
+    if (data->isopen)
+    {
+      /* remember the session so the next connection to this server can
+       * resume it.  Done at close, not after the handshake, because a
+       * TLS 1.3 session ticket only arrives once the server follows up.  */
+      SSL_SESSION *sess = SSL_get1_session(data->ssl);
+      if (sess)
+      {
+        char key[256];
+        ssl_session_key(conn, key, sizeof(key));
+        if (!SslSessionCache)
+        {
+          SslSessionCache = mutt_hash_new(32, MUTT_HASH_STRDUP_KEYS);
+          mutt_hash_set_destructor(SslSessionCache, ssl_session_free, 0);
+        }
+        mutt_hash_delete(SslSessionCache, key, NULL);
+        mutt_hash_insert(SslSessionCache, key, sess);
+      }
+    }
+
     if (data->isopen && (raw_socket_poll(conn, 0) >= 0))
       SSL_shutdown(data->ssl);
 
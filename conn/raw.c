@@ -56,6 +56,7 @@
 #include <stdbool.h>
 #endif
 
+#ifndef HAVE_GETADDRINFO
 /**
  * socket_connect - set up to connect to a socket fd
  * @param fd File descriptor to connect with
@@ -109,6 +110,137 @@ static int socket_connect(int fd, struct sockaddr *sa)
 
   return save_errno;
 }
+#endif
+
+#ifdef HAVE_GETADDRINFO
+/// Delay before trying the next address while earlier attempts are pending (microseconds)
+static const suseconds_t CONNECT_STAGGER_USEC = 250000;
+
+/**
+ * socket_connect_all - Connect to a host, racing its addresses
+ * @param conn Connection to fill in
+ * @param res  Address list from getaddrinfo(3)
+ * @retval  0 Success, conn->fd is connected
+ * @retval >0 An errno, e.g. ETIMEDOUT
+ * @retval -1 Error
+ *
+ * "Happy eyeballs": start a non-blocking connect to the first address and,
+ * every quarter second without an answer, to the next one as well.  The first
+ * to complete wins and the rest are closed.  Trying the addresses serially
+ * would cost a full $connect_timeout per dead address - typically an
+ * unreachable IPv6 route before the IPv4 one is ever tried.  SIGINT aborts
+ * the whole race.
+ */
+static int socket_connect_all(struct Connection *conn, struct addrinfo *res)
+{
+  size_t num = 0;
+  for (struct addrinfo *cur = res; cur; cur = cur->ai_next)
+    num++;
+  if (num == 0)
+    return -1;
+
+  int *fds = mutt_mem_calloc(num, sizeof(int));
+  size_t pending = 0;
+  struct addrinfo *next = res;
+  int winner = -1;
+  int save_errno = -1;
+
+  const time_t deadline = (C_ConnectTimeout > 0) ?
+                              (mutt_date_epoch() + C_ConnectTimeout) :
+                              0;
+
+  mutt_sig_allow_interrupt(true);
+
+  while (winner < 0)
+  {
+    if (next)
+    {
+      int fd = socket(next->ai_family, next->ai_socktype, next->ai_protocol);
+      if (fd >= 0)
+      {
+        const int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        if (connect(fd, next->ai_addr, next->ai_addrlen) == 0)
+          winner = fd;
+        else if (errno == EINPROGRESS)
+          fds[pending++] = fd;
+        else
+        {
+          save_errno = errno;
+          close(fd);
+        }
+      }
+      next = next->ai_next;
+      if (winner >= 0)
+        break;
+    }
+
+    if (!next && (pending == 0))
+      break; /* every address has failed */
+
+    fd_set wfds;
+    FD_ZERO(&wfds);
+    int maxfd = -1;
+    for (size_t i = 0; i < pending; i++)
+    {
+      FD_SET(fds[i], &wfds);
+      if (fds[i] > maxfd)
+        maxfd = fds[i];
+    }
+
+    struct timeval tv = { 0, CONNECT_STAGGER_USEC };
+    int sel = select(maxfd + 1, NULL, &wfds, NULL, &tv);
+    if (sel < 0)
+    {
+      if ((errno != EINTR) || SigInt)
+      {
+        save_errno = EINTR;
+        break; /* user abort */
+      }
+      continue; /* SIGWINCH and friends */
+    }
+
+    for (size_t i = 0; (sel > 0) && (i < pending); i++)
+    {
+      if (!FD_ISSET(fds[i], &wfds))
+        continue;
+      int err = 0;
+      socklen_t len = sizeof(err);
+      if ((getsockopt(fds[i], SOL_SOCKET, SO_ERROR, &err, &len) == 0) && (err == 0))
+      {
+        winner = fds[i];
+        fds[i] = fds[--pending];
+        break;
+      }
+      save_errno = err;
+      close(fds[i]);
+      fds[i--] = fds[--pending];
+    }
+
+    if ((winner < 0) && (deadline != 0) && (mutt_date_epoch() >= deadline))
+    {
+      save_errno = ETIMEDOUT;
+      break;
+    }
+  }
+
+  mutt_sig_allow_interrupt(false);
+  SigInt = 0;
+
+  for (size_t i = 0; i < pending; i++)
+    close(fds[i]);
+  FREE(&fds);
+
+  if (winner < 0)
+    return save_errno;
+
+  /* the rest of the code expects a blocking socket */
+  fcntl(winner, F_SETFL, fcntl(winner, F_GETFL, 0) & ~O_NONBLOCK);
+  fcntl(winner, F_SETFD, FD_CLOEXEC);
+  conn->fd = winner;
+  return 0;
+}
+#endif
 
 /**
  * raw_socket_open - Open a socket - Implements Connection::open()
@@ -126,7 +258,6 @@ int raw_socket_open(struct Connection *conn)
   char port[6];
   struct addrinfo hints;
   struct addrinfo *res = NULL;
-  struct addrinfo *cur = NULL;
 
   /* we accept v4 or v6 STREAM sockets */
   memset(&hints, 0, sizeof(hints));
@@ -168,23 +299,7 @@ int raw_socket_open(struct Connection *conn)
   if (!OptNoCurses)
     mutt_message(_("Connecting to %s..."), conn->account.host);
 
-  rc = -1;
-  for (cur = res; cur; cur = cur->ai_next)
-  {
-    int fd = socket(cur->ai_family, cur->ai_socktype, cur->ai_protocol);
-    if (fd >= 0)
-    {
-      rc = socket_connect(fd, cur->ai_addr);
-      if (rc == 0)
-      {
-        fcntl(fd, F_SETFD, FD_CLOEXEC);
-        conn->fd = fd;
-        break;
-      }
-      else
-        close(fd);
-    }
-  }
+  rc = socket_connect_all(conn, res);
 
   freeaddrinfo(res);
 #else
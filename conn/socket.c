@@ -126,6 +126,54 @@ int mutt_socket_read(struct Connection *conn, char *buf, size_t len)
   return conn->read(conn, buf, len);
 }
 
+/**
+ * mutt_socket_read_exact - Fill a buffer from a Connection
+ * @param conn   Connection to a server
+ * @param buf    Buffer to store the data
+ * @param buflen Number of bytes to read
+ * @retval num Success, number of bytes read (buflen)
+ * @retval  -1 Error
+ *
+ * Bulk counterpart of mutt_socket_readchar(): drain the read buffer first,
+ * then read the remainder directly into the caller's buffer, so large
+ * payloads (e.g. IMAP literals) skip the per-byte path.
+ */
+int mutt_socket_read_exact(struct Connection *conn, char *buf, size_t buflen)
+{
+  size_t have = 0;
+
+  /* data already buffered by mutt_socket_readchar() */
+  if (conn->bufpos < conn->available)
+  {
+    const size_t n = MIN(buflen, (size_t) (conn->available - conn->bufpos));
+    memcpy(buf, conn->inbuf + conn->bufpos, n);
+    conn->bufpos += n;
+    have = n;
+  }
+
+  while (have < buflen)
+  {
+    if (conn->fd < 0)
+    {
+      mutt_debug(LL_DEBUG1, "attempt to read from closed connection\n");
+      return -1;
+    }
+    const int rc = conn->read(conn, buf + have, buflen - have);
+    if (rc == 0)
+    {
+      mutt_error(_("Connection to %s closed"), conn->account.host);
+    }
+    if (rc <= 0)
+    {
+      mutt_socket_close(conn);
+      return -1;
+    }
+    have += rc;
+  }
+
+  return have;
+}
+
 /**
  * mutt_socket_write - write to a Connection
  * @param conn Connection to a server
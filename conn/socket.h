@@ -44,6 +44,7 @@ struct Connection *mutt_socket_new     (enum ConnectionType type);
 int                mutt_socket_open    (struct Connection *conn);
 int                mutt_socket_poll    (struct Connection *conn, time_t wait_secs);
 int                mutt_socket_read    (struct Connection *conn, char *buf, size_t len);
+int                mutt_socket_read_exact(struct Connection *conn, char *buf, size_t buflen);
 int                mutt_socket_readchar(struct Connection *conn, char *c);
 int                mutt_socket_readln_d(char *buf, size_t buflen, struct Connection *conn, int dbg);
 int                mutt_socket_write   (struct Connection *conn, const char *buf, size_t len);
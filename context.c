@@ -32,6 +32,7 @@
 #include "email/lib.h"
 #include "core/lib.h"
 #include "context.h"
+#include "index.h"
 #include "imap/lib.h"
 #include "maildir/lib.h"
 #include "ncrypt/lib.h"
@@ -166,7 +167,11 @@ void ctx_update(struct Context *ctx)
       {
         e2->superseded = true;
         if (C_Score)
+        {
+          /* force a fresh score, it may depend on the superseded flag */
+          e2->scored = false;
           mutt_score_message(ctx->mailbox, e2, true);
+        }
       }
     }
 
@@ -213,6 +218,8 @@ static void update_tables(struct Context *ctx)
 
   int i, j, padding;
 
+  IndexLineGen++; /* expunging renumbers the messages */
+
   /* update memory to reflect the new state of the mailbox */
   m->vcount = 0;
   ctx->vsize = 0;
@@ -47,6 +47,9 @@
 #include "mutt_globals.h"
 #include "mx.h"
 #include "state.h"
+#ifdef USE_HCACHE
+#include "maildir/lib.h"
+#endif
 #ifdef USE_NOTMUCH
 #include "notmuch/lib.h"
 #include "muttlib.h"
@@ -431,6 +434,9 @@ int mutt_copy_header(FILE *fp_in, struct Email *e, FILE *fp_out,
     fputc('\n', fp_out);
   }
 
+  if (chflags & (CH_UPDATE_IRT | CH_UPDATE_REFS))
+    mutt_env_parse_threads(e->env);
+
   if ((chflags & CH_UPDATE_IRT) && !STAILQ_EMPTY(&e->env->in_reply_to))
   {
     fputs("In-Reply-To:", fp_out);
@@ -743,6 +749,8 @@ int mutt_copy_message_fp(FILE *fp_out, FILE *fp_in, struct Email *e,
       s.flags |= MUTT_VERIFY;
 
     rc = mutt_body_handler(body, &s);
+    if ((rc == 0) && (s.flags & MUTT_TRUNCATED))
+      rc = 1; /* partial decode - ok to display, but don't cache it */
   }
   else if ((WithCrypto != 0) && (cmflags & MUTT_CM_DECODE_CRYPT) && (e->security & SEC_ENCRYPT))
   {
@@ -818,6 +826,141 @@ int mutt_copy_message_fp(FILE *fp_out, FILE *fp_in, struct Email *e,
   return rc;
 }
 
+/* These Config Variables are only used in copy.c */
+long C_DecodeCacheSize; ///< Config: Bytes of decoded message text to keep in memory
+
+/**
+ * struct DecodeCacheEntry - One cached decoded message
+ */
+struct DecodeCacheEntry
+{
+  char *key;   ///< Identity of the message and the decode settings
+  char *data;  ///< Decoded bytes
+  size_t len;  ///< Number of decoded bytes
+  TAILQ_ENTRY(DecodeCacheEntry) entries; ///< Linked list, most recently used first
+};
+TAILQ_HEAD(DecodeCacheList, DecodeCacheEntry);
+
+/* Decoding a multi-megabyte message (base64/QP/charset) is expensive and a
+ * read-reply workflow does it several times over: pager display, search
+ * inside the pager, reply quoting.  The most recent results are kept here,
+ * LRU-evicted by total bytes ($decode_cache_size). */
+static struct DecodeCacheList DecodeCacheLru = TAILQ_HEAD_INITIALIZER(DecodeCacheLru);
+static struct HashTable *DecodeCacheHash = NULL;
+static size_t DecodeCacheUsed = 0;
+
+/**
+ * decode_cache_remove - Drop one entry from the decode cache
+ * @param dce Entry to remove and free
+ */
+static void decode_cache_remove(struct DecodeCacheEntry *dce)
+{
+  mutt_hash_delete(DecodeCacheHash, dce->key, dce);
+  TAILQ_REMOVE(&DecodeCacheLru, dce, entries);
+  DecodeCacheUsed -= dce->len;
+  FREE(&dce->data);
+  FREE(&dce->key);
+  FREE(&dce);
+}
+
+/**
+ * mutt_decode_cache_key - Build the cache key for a decoded message
+ * @param key   Buffer for the key
+ * @param m     Mailbox holding the message
+ * @param e     Email
+ * @param flags Caller-specific decode settings
+ *
+ * The key ties the entry to the message's position and date in this mailbox
+ * file and to $charset, so a rewritten mailbox or a charset change simply
+ * stops matching and the old entries age out.
+ */
+void mutt_decode_cache_key(struct Buffer *key, struct Mailbox *m,
+                           struct Email *e, unsigned int flags)
+{
+  mutt_buffer_printf(key, "%s|%lld|%ld|%lld|%u|%s", m ? m->realpath : "",
+                     (long long) e->offset, (long) e->body->length,
+                     (long long) e->received, flags, NONULL(C_Charset));
+}
+
+/**
+ * mutt_decode_cache_peek - Look up decoded bytes in the cache
+ * @param[in]  key Cache key from mutt_decode_cache_key()
+ * @param[out] len Number of cached bytes
+ * @retval ptr  The decoded bytes (owned by the cache - copy before modifying)
+ * @retval NULL Not cached
+ */
+const char *mutt_decode_cache_peek(const char *key, size_t *len)
+{
+  if (!DecodeCacheHash || !key)
+    return NULL;
+
+  struct DecodeCacheEntry *dce = mutt_hash_find(DecodeCacheHash, key);
+  if (!dce)
+  {
+    mutt_stats_count("dcache/miss", 1);
+    return NULL;
+  }
+
+  TAILQ_REMOVE(&DecodeCacheLru, dce, entries);
+  TAILQ_INSERT_HEAD(&DecodeCacheLru, dce, entries);
+  mutt_stats_count("dcache/hit", 1);
+  *len = dce->len;
+  return dce->data;
+}
+
+/**
+ * mutt_decode_cache_store - Remember decoded bytes
+ * @param key  Cache key from mutt_decode_cache_key()
+ * @param data Decoded bytes (copied)
+ * @param len  Number of bytes
+ *
+ * Entries larger than a quarter of $decode_cache_size are not kept - one
+ * giant message must not evict everything else.
+ */
+void mutt_decode_cache_store(const char *key, const char *data, size_t len)
+{
+  if (!key || !data || (C_DecodeCacheSize <= 0) ||
+      (len > ((size_t) C_DecodeCacheSize / 4)))
+  {
+    return;
+  }
+
+  if (!DecodeCacheHash)
+    DecodeCacheHash = mutt_hash_new(64, MUTT_HASH_NO_FLAGS);
+
+  struct DecodeCacheEntry *dce = mutt_hash_find(DecodeCacheHash, key);
+  if (dce)
+    decode_cache_remove(dce);
+
+  dce = mutt_mem_calloc(1, sizeof(struct DecodeCacheEntry));
+  dce->key = mutt_str_dup(key);
+  dce->data = mutt_mem_malloc(len ? len : 1);
+  memcpy(dce->data, data, len);
+  dce->len = len;
+  mutt_hash_insert(DecodeCacheHash, dce->key, dce);
+  TAILQ_INSERT_HEAD(&DecodeCacheLru, dce, entries);
+  DecodeCacheUsed += len;
+
+  while (DecodeCacheUsed > (size_t) C_DecodeCacheSize)
+  {
+    struct DecodeCacheEntry *last = TAILQ_LAST(&DecodeCacheLru, DecodeCacheList);
+    if (!last)
+      break;
+    decode_cache_remove(last);
+  }
+}
+
+/**
+ * mutt_decode_cache_cleanup - Free the decode cache
+ */
+void mutt_decode_cache_cleanup(void)
+{
+  struct DecodeCacheEntry *dce = NULL;
+  while ((dce = TAILQ_FIRST(&DecodeCacheLru)))
+    decode_cache_remove(dce);
+  mutt_hash_free(&DecodeCacheHash);
+}
+
 /**
  * mutt_copy_message - Copy a message from a Mailbox
  * @param fp_out  FILE pointer to write to
@@ -850,6 +993,74 @@ int mutt_copy_message(FILE *fp_out, struct Mailbox *m, struct Email *e,
   return rc;
 }
 
+/**
+ * mutt_copy_message_cached - Copy a message, reusing cached decoded text
+ * @param fp_out  FILE pointer to write to
+ * @param m       Source mailbox
+ * @param e       Email
+ * @param cmflags Flags, see #CopyMessageFlags
+ * @param chflags Flags, see #CopyHeaderFlags
+ * @param wraplen Width to wrap at (when chflags & CH_DISPLAY)
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * A drop-in for mutt_copy_message() on the decode paths (pager display,
+ * reply quoting): the decoded output is remembered and replayed on the next
+ * call with the same message and settings.  Encrypted messages are never
+ * cached - decrypted text must not outlive its use.
+ */
+int mutt_copy_message_cached(FILE *fp_out, struct Mailbox *m, struct Email *e,
+                             CopyMessageFlags cmflags, CopyHeaderFlags chflags, int wraplen)
+{
+  if (!(cmflags & MUTT_CM_DECODE) || (C_DecodeCacheSize <= 0) ||
+      ((WithCrypto != 0) && (e->security & SEC_ENCRYPT)))
+  {
+    return mutt_copy_message(fp_out, m, e, cmflags, chflags, wraplen);
+  }
+
+  struct Buffer *key = mutt_buffer_pool_get();
+  mutt_decode_cache_key(key, m, e, ((unsigned int) chflags << 4) | cmflags);
+  mutt_buffer_add_printf(key, "|%d", wraplen);
+
+  int rc;
+  size_t len = 0;
+  const char *data = mutt_decode_cache_peek(mutt_b2s(key), &len);
+  if (data)
+  {
+    rc = (fwrite(data, 1, len, fp_out) == len) ? 0 : -1;
+    mutt_buffer_pool_release(&key);
+    return rc;
+  }
+
+  FILE *fp_tmp = mutt_file_mkstemp();
+  if (!fp_tmp)
+  {
+    mutt_buffer_pool_release(&key);
+    return mutt_copy_message(fp_out, m, e, cmflags, chflags, wraplen);
+  }
+
+  rc = mutt_copy_message(fp_tmp, m, e, cmflags, chflags, wraplen);
+  if (rc >= 0)
+  {
+    fflush(fp_tmp);
+    const long sz = ftell(fp_tmp);
+    /* rc > 0 is a partial decode (e.g. interrupted) - display it, don't keep it */
+    if ((rc == 0) && (sz >= 0) && ((size_t) sz <= ((size_t) C_DecodeCacheSize / 4)))
+    {
+      char *buf = mutt_mem_malloc((sz > 0) ? sz : 1);
+      rewind(fp_tmp);
+      if ((long) fread(buf, 1, sz, fp_tmp) == sz)
+        mutt_decode_cache_store(mutt_b2s(key), buf, sz);
+      FREE(&buf);
+    }
+    rewind(fp_tmp);
+    mutt_file_copy_stream(fp_tmp, fp_out);
+  }
+  mutt_file_fclose(&fp_tmp);
+  mutt_buffer_pool_release(&key);
+  return rc;
+}
+
 /**
  * append_message - appends a copy of the given message to a mailbox
  * @param dest    destination mailbox
@@ -880,9 +1091,25 @@ static int append_message(struct Mailbox *dest, FILE *fp_in, struct Mailbox *src
     chflags |= CH_FROM | CH_FORCE_FROM;
   chflags |= ((dest->type == MUTT_MAILDIR) ? CH_NOSTATUS : CH_UPDATE);
   rc = mutt_copy_message_fp(msg->fp, fp_in, e, cmflags, chflags, 0);
+#ifdef USE_HCACHE
+  const long written = (rc == 0) ? ftello(msg->fp) : -1;
+#endif
   if (mx_msg_commit(dest, msg) != 0)
     rc = -1;
 
+#ifdef USE_HCACHE
+  /* A verbatim copy means the in-memory Email already describes the new
+   * file, so hand its header-cache record to the destination too.  Any
+   * transformation (decode, weeding, a stripped Status: header) shows up
+   * as a size change and disqualifies the transfer. */
+  if ((rc == 0) && msg->committed_path && (dest->type == MUTT_MAILDIR) &&
+      (cmflags == MUTT_CM_NO_FLAGS) && e->body &&
+      (written == (e->body->offset - e->offset + e->body->length)))
+  {
+    maildir_msg_transfer_hcache(dest, msg->committed_path, e);
+  }
+#endif
+
 #ifdef USE_NOTMUCH
   if (msg->committed_path && (dest->type == MUTT_MAILDIR) && (src->type == MUTT_NOTMUCH))
     nm_update_filename(src, NULL, msg->committed_path, e);
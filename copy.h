@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+struct Buffer;
 struct Email;
 struct Mailbox;
 
@@ -75,8 +76,16 @@ int mutt_copy_hdr(FILE *fp_in, FILE *fp_out, LOFF_T off_start, LOFF_T off_end, C
 
 int mutt_copy_header(FILE *fp_in, struct Email *e, FILE *fp_out, CopyHeaderFlags chflags, const char *prefix, int wraplen);
 
+extern long C_DecodeCacheSize;
+
 int mutt_copy_message_fp(FILE *fp_out, FILE *fp_in,       struct Email *e, CopyMessageFlags cmflags, CopyHeaderFlags chflags, int wraplen);
 int mutt_copy_message   (FILE *fp_out, struct Mailbox *m, struct Email *e, CopyMessageFlags cmflags, CopyHeaderFlags chflags, int wraplen);
+int mutt_copy_message_cached(FILE *fp_out, struct Mailbox *m, struct Email *e, CopyMessageFlags cmflags, CopyHeaderFlags chflags, int wraplen);
+
+void        mutt_decode_cache_cleanup(void);
+void        mutt_decode_cache_key    (struct Buffer *key, struct Mailbox *m, struct Email *e, unsigned int flags);
+const char *mutt_decode_cache_peek   (const char *key, size_t *len);
+void        mutt_decode_cache_store  (const char *key, const char *data, size_t len);
 
 int mutt_append_message(struct Mailbox *dest, struct Mailbox *src, struct Email *e, CopyMessageFlags cmflags, CopyHeaderFlags chflags);
 
@@ -180,6 +180,9 @@ void mailbox_update(struct Mailbox *m)
  * mailbox_changed - Notify observers of a change to a Mailbox
  * @param m      Mailbox
  * @param action Change to Mailbox
+ *
+ * Inside a notify_begin_batch() scope, repeated change events for the same
+ * Mailbox are merged before the observers run.
  */
 void mailbox_changed(struct Mailbox *m, enum NotifyMailbox action)
 {
@@ -187,7 +190,16 @@ void mailbox_changed(struct Mailbox *m, enum NotifyMailbox action)
     return;
 
   struct EventMailbox ev_m = { m };
-  notify_send(m->notify, NT_MAILBOX, action, &ev_m);
+  if (action == NT_MAILBOX_CLOSED)
+  {
+    /* Observers drop their Mailbox pointers on this one - it must never be
+     * deferred past the Mailbox's lifetime */
+    notify_send(m->notify, NT_MAILBOX, action, &ev_m);
+  }
+  else
+  {
+    notify_send_coalesce(m->notify, NT_MAILBOX, action, &ev_m, sizeof(ev_m));
+  }
 }
 
 /**
@@ -27,6 +27,7 @@
 #include "config.h"
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <sys/types.h>
 #include <time.h>
 #include "mutt/lib.h"
@@ -107,6 +108,7 @@ struct Mailbox
   struct timespec mtime;              ///< Time Mailbox was last changed
   struct timespec last_visited;       ///< Time of last exit from this mailbox
   struct timespec stats_last_checked; ///< Mtime of mailbox the last time stats where checked.
+  time_t next_slow_check;             ///< Don't poll before this time (set after a slow check)
 
   const struct MxOps *mx_ops;         ///< MXAPI callback functions
 
@@ -120,6 +122,8 @@ struct Mailbox
 
   AclFlags rights;                    ///< ACL bits, see #AclFlags
 
+  FILE *journal_fp;                   ///< Open flag-intent journal, see mutt_journal.c
+
 #ifdef USE_COMP_MBOX
   void *compress_info;                ///< Compressed mbox module private data
 #endif
@@ -47,6 +47,7 @@ struct Body *mutt_body_new(void)
   p->disposition = DISP_ATTACH;
   p->use_disp = true;
   TAILQ_INIT(&p->parameter);
+  mutt_stats_count("mem/body-live", 1);
   return p;
 }
 
@@ -93,7 +94,10 @@ void mutt_body_free(struct Body **ptr)
 
     mutt_env_free(&b->mime_headers);
     mutt_body_free(&b->parts);
+    mutt_body_free(&b->decrypted);
+    mutt_file_fclose(&b->fp_decrypted);
     FREE(&b);
+    mutt_stats_count("mem/body-live", -1);
   }
 
   *ptr = NULL;
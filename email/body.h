@@ -25,6 +25,7 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdio.h>
 #include <time.h>
 #include "parameter.h"
 
@@ -55,6 +56,8 @@ struct Body
   struct Email *email;            ///< header information for message/rfc822
 
   struct AttachPtr *aptr;         ///< Menu information, used in recvattach.c
+  struct Body *decrypted;         ///< Cached decryption of this part, see mutt_generate_recvattach_list()
+  FILE *fp_decrypted;             ///< Temporary file holding the cached decryption
 
   signed short attach_count;      ///< Number of attachments
 
@@ -72,6 +75,7 @@ struct Body
 
   bool noconv : 1;                ///< Don't do character set conversion
   bool force_charset : 1;         ///< Send mode: don't adjust the character set when in send-mode.
+  bool preencoded : 1;            ///< Send mode: `filename` already holds the part in wire form (content-transfer-encoded)
   bool goodsig : 1;               ///< Good cryptographic signature
   bool warnsig : 1;               ///< Maybe good signature
   bool badsig : 1;                ///< Bad cryptographic signature (needed to check encrypted s/mime-signatures)
@@ -36,6 +36,29 @@
 
 void nm_edata_free(void **ptr);
 
+/// Number of Emails carved out of each slab
+#define EMAIL_SLAB_SIZE 256
+
+/**
+ * struct EmailSlab - A block of Emails allocated together
+ *
+ * Opening a big folder creates one Email per message; half a million
+ * individual mallocs cost time and fragment the heap.  Emails are instead
+ * carved out of fixed-size slabs, so their addresses are stable, appending is
+ * O(1), and expunged Emails go on a free list for reuse.  The slabs are never
+ * returned to the system; a mail session's high-water mark is its steady
+ * state.
+ */
+struct EmailSlab
+{
+  struct Email emails[EMAIL_SLAB_SIZE]; ///< The Emails themselves
+  struct EmailSlab *next;               ///< Linked list of slabs
+};
+
+static struct EmailSlab *EmailSlabs = NULL; ///< All allocated slabs, newest first
+static size_t EmailSlabUsed = EMAIL_SLAB_SIZE; ///< Slots carved from the newest slab
+static struct Email *EmailFreeList = NULL; ///< Freed Emails ready for reuse
+
 /**
  * email_free - Free an Email
  * @param[out] ptr Email to free
@@ -54,6 +77,7 @@ void email_free(struct Email **ptr)
   mutt_body_free(&e->body);
   FREE(&e->tree);
   FREE(&e->path);
+  FREE(&e->index_line);
 #ifdef MIXMASTER
   mutt_list_free(&e->chain);
 #endif
@@ -62,7 +86,11 @@ void email_free(struct Email **ptr)
 #endif
   driver_tags_free(&e->tags);
 
-  FREE(ptr);
+  /* The slot is dead, so its first bytes can link the free list */
+  *(struct Email **) e = EmailFreeList;
+  EmailFreeList = e;
+  *ptr = NULL;
+  mutt_stats_count("mem/email-live", -1);
 }
 
 /**
@@ -73,13 +101,32 @@ struct Email *email_new(void)
 {
   static size_t sequence = 0;
 
-  struct Email *e = mutt_mem_calloc(1, sizeof(struct Email));
+  struct Email *e = NULL;
+  if (EmailFreeList)
+  {
+    e = EmailFreeList;
+    EmailFreeList = *(struct Email **) e;
+  }
+  else
+  {
+    if (EmailSlabUsed == EMAIL_SLAB_SIZE)
+    {
+      struct EmailSlab *slab = mutt_mem_calloc(1, sizeof(*slab));
+      slab->next = EmailSlabs;
+      EmailSlabs = slab;
+      EmailSlabUsed = 0;
+    }
+    e = &EmailSlabs->emails[EmailSlabUsed++];
+  }
+  memset(e, 0, sizeof(*e));
+
 #ifdef MIXMASTER
   STAILQ_INIT(&e->chain);
 #endif
   STAILQ_INIT(&e->tags);
   e->visible = true;
   e->sequence = sequence++;
+  mutt_stats_count("mem/email-live", 1);
   return e;
 }
 
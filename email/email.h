@@ -67,6 +67,8 @@ struct Email
   bool searched : 1;           ///< Email has been searched
   bool matched  : 1;           ///< Search matches this Email
 
+  bool scored   : 1;           ///< Email::score is valid for the current score rules
+
   bool attach_valid : 1;       ///< true when the attachment count is valid
 
   // the following are used to support collapsing threads
@@ -78,6 +80,15 @@ struct Email
   short recipient;             ///< User_is_recipient()'s return value, cached
 
   int pair;                    ///< Color-pair to use when displaying in the index
+  int pair_author;             ///< Cached `color index_author` pair (0 = unset, -1 = no rule matched)
+  int pair_flags;              ///< Cached `color index_flags` pair (0 = unset, -1 = no rule matched)
+  int pair_subject;            ///< Cached `color index_subject` pair (0 = unset, -1 = no rule matched)
+
+  char *index_line;            ///< Cached rendered `$index_format` line
+  int index_line_gen;          ///< ::IndexLineGen value index_line was rendered at
+  int index_line_flags;        ///< MuttFormatFlags index_line was rendered with
+  short index_line_cols;       ///< Screen width index_line was rendered for
+  bool index_line_in_pager;    ///< index_line was rendered as the message open in the pager
 
   time_t date_sent;            ///< Time when the message was sent (UTC)
   time_t received;             ///< Time when the message was placed in the mailbox
@@ -115,8 +126,6 @@ struct Email
    * @param ptr Private data to be freed
    */
   void (*edata_free)(void **ptr);
-
-  struct Notify *notify;       ///< Notifications handler
 };
 
 /**
@@ -34,6 +34,7 @@
 #include "mutt/lib.h"
 #include "address/lib.h"
 #include "envelope.h"
+#include "parse.h"
 
 /**
  * mutt_env_new - Create a new Envelope
@@ -54,6 +55,7 @@ struct Envelope *mutt_env_new(void)
   STAILQ_INIT(&e->references);
   STAILQ_INIT(&e->in_reply_to);
   STAILQ_INIT(&e->userhdrs);
+  mutt_stats_count("mem/envelope-live", 1);
   return e;
 }
 
@@ -128,8 +130,10 @@ void mutt_env_free(struct Envelope **ptr)
 
   mutt_buffer_dealloc(&env->spam);
 
-  mutt_list_free(&env->references);
-  mutt_list_free(&env->in_reply_to);
+  mutt_intern_list_free(&env->references);
+  mutt_intern_list_free(&env->in_reply_to);
+  FREE(&env->references_raw);
+  FREE(&env->in_reply_to_raw);
   mutt_list_free(&env->userhdrs);
 
 #ifdef USE_AUTOCRYPT
@@ -138,6 +142,7 @@ void mutt_env_free(struct Envelope **ptr)
 #endif
 
   FREE(ptr);
+  mutt_stats_count("mem/envelope-live", -1);
 }
 
 /**
@@ -153,6 +158,8 @@ void mutt_env_merge(struct Envelope *base, struct Envelope **extra)
   if (!base || !extra || !*extra)
     return;
 
+  base->content_hash = 0;
+
 /* copies each existing element if necessary, and sets the element
  * to NULL in the source so that mutt_env_free doesn't leave us
  * with dangling pointers. */
@@ -202,10 +209,12 @@ void mutt_env_merge(struct Envelope *base, struct Envelope **extra)
   if (!(base->changed & MUTT_ENV_CHANGED_REFS))
   {
     MOVE_STAILQ(references);
+    MOVE_ELEM(references_raw);
   }
   if (!(base->changed & MUTT_ENV_CHANGED_IRT))
   {
     MOVE_STAILQ(in_reply_to);
+    MOVE_ELEM(in_reply_to_raw);
   }
 
   /* real_subj is subordinate to subject */
@@ -213,9 +222,11 @@ void mutt_env_merge(struct Envelope *base, struct Envelope **extra)
   {
     base->subject = (*extra)->subject;
     base->real_subj = (*extra)->real_subj;
+    base->real_subj_hash = (*extra)->real_subj_hash;
     base->disp_subj = (*extra)->disp_subj;
     (*extra)->subject = NULL;
     (*extra)->real_subj = NULL;
+    (*extra)->real_subj_hash = 0;
     (*extra)->disp_subj = NULL;
   }
   /* spam and user headers should never be hashed, and the new envelope may
@@ -232,6 +243,121 @@ void mutt_env_merge(struct Envelope *base, struct Envelope **extra)
   mutt_env_free(extra);
 }
 
+/**
+ * mutt_env_real_subj_hash - Hash of the Envelope's normalized subject
+ * @param env Envelope
+ * @retval num Hash of real_subj
+ * @retval 0   Envelope has no subject
+ *
+ * Computed on first use and remembered, so subject-threading passes can
+ * compare subjects without rereading the strings.  Sites that change
+ * real_subj must reset real_subj_hash to 0.
+ */
+uint64_t mutt_env_real_subj_hash(struct Envelope *env)
+{
+  if (!env || !env->real_subj)
+    return 0;
+
+  if (env->real_subj_hash == 0)
+  {
+    uint64_t hash = mutt_fasthash_str(env->real_subj, MUTT_FASTHASH_INIT);
+    if (hash == 0)
+      hash = 1; // 0 means "not yet computed"
+    env->real_subj_hash = hash;
+  }
+
+  return env->real_subj_hash;
+}
+
+/**
+ * hash_str - Feed one string field into an Envelope content hash
+ * @param s    String, may be NULL
+ * @param hash Hash state
+ * @retval num New hash state
+ */
+static uint64_t hash_str(const char *s, uint64_t hash)
+{
+  hash = mutt_fasthash_str(s, hash);
+  // Field separator, so adjacent fields can't compensate for each other
+  return mutt_fasthash_bytes("\x1f", 1, hash);
+}
+
+/**
+ * hash_addrlist - Feed an AddressList into an Envelope content hash
+ * @param al   AddressList
+ * @param hash Hash state
+ * @retval num New hash state
+ *
+ * Covers the same parts of each Address that mutt_addrlist_equal() compares.
+ */
+static uint64_t hash_addrlist(const struct AddressList *al, uint64_t hash)
+{
+  struct Address *a = NULL;
+  TAILQ_FOREACH(a, al, entries)
+  {
+    hash = hash_str(a->mailbox, hash);
+    hash = hash_str(a->personal, hash);
+  }
+  return mutt_fasthash_bytes("\x1e", 1, hash);
+}
+
+/**
+ * hash_list - Feed a string list into an Envelope content hash
+ * @param lh   List of strings
+ * @param hash Hash state
+ * @retval num New hash state
+ */
+static uint64_t hash_list(const struct ListHead *lh, uint64_t hash)
+{
+  struct ListNode *np = NULL;
+  STAILQ_FOREACH(np, lh, entries)
+  {
+    hash = hash_str(np->data, hash);
+  }
+  return mutt_fasthash_bytes("\x1e", 1, hash);
+}
+
+/**
+ * mutt_env_content_hash - Hash of the fields that identify an Envelope
+ * @param env Envelope
+ * @retval num Hash of the fields compared by mutt_env_cmp_strict()
+ * @retval 0   No Envelope
+ *
+ * Computed on first use and remembered, so reconciliation loops that compare
+ * many Envelopes pairwise (e.g. re-matching headers after a mailbox was
+ * modified externally) can reject mismatches with an integer compare.
+ *
+ * Sites that rewrite an Envelope's identity fields must reset content_hash
+ * to 0: a stale hash may misreport two identical Envelopes as different.
+ * Equal hashes are never trusted on their own, see mutt_env_cmp_strict().
+ */
+uint64_t mutt_env_content_hash(struct Envelope *env)
+{
+  if (!env)
+    return 0;
+
+  if (env->content_hash == 0)
+  {
+    /* the references list may not have been materialized yet */
+    mutt_env_parse_threads(env);
+
+    uint64_t hash = hash_str(env->message_id, MUTT_FASTHASH_INIT);
+    hash = hash_str(env->subject, hash);
+    hash = hash_list(&env->references, hash);
+    hash = hash_addrlist(&env->from, hash);
+    hash = hash_addrlist(&env->sender, hash);
+    hash = hash_addrlist(&env->reply_to, hash);
+    hash = hash_addrlist(&env->to, hash);
+    hash = hash_addrlist(&env->cc, hash);
+    hash = hash_addrlist(&env->return_path, hash);
+    if (hash == 0)
+      hash = 1; // 0 means "not yet computed"
+    env->content_hash = hash;
+  }
+
+  return env->content_hash;
+}
+
 /**
  * mutt_env_cmp_strict - Strictly compare two Envelopes
  * @param e1 First Envelope
@@ -242,6 +368,18 @@ bool mutt_env_cmp_strict(const struct Envelope *e1, const struct Envelope *e2)
 {
   if (e1 && e2)
   {
+    /* Differing hashes prove inequality; equal hashes still need the field
+     * compare below (collisions, NULL/"" ambiguity) */
+    if (mutt_env_content_hash((struct Envelope *) e1) !=
+        mutt_env_content_hash((struct Envelope *) e2))
+    {
+      return false;
+    }
+
+    /* the references lists may not have been materialized yet */
+    mutt_env_parse_threads((struct Envelope *) e1);
+    mutt_env_parse_threads((struct Envelope *) e2);
+
     if (!mutt_str_equal(e1->message_id, e2->message_id) ||
         !mutt_str_equal(e1->subject, e2->subject) ||
         !mutt_list_compare(&e1->references, &e2->references) ||
@@ -273,6 +411,7 @@ void mutt_env_to_local(struct Envelope *env)
   if (!env)
     return;
 
+  env->content_hash = 0;
   mutt_addrlist_to_local(&env->return_path);
   mutt_addrlist_to_local(&env->from);
   mutt_addrlist_to_local(&env->to);
@@ -311,6 +450,7 @@ int mutt_env_to_intl(struct Envelope *env, const char **tag, char **err)
   if (!env)
     return 1;
 
+  env->content_hash = 0;
   int e = 0;
   H_TO_INTL(return_path);
   H_TO_INTL(from);
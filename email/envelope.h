@@ -65,6 +65,7 @@ struct Envelope
   char *list_post;                     ///< This stores a mailto URL, or nothing
   char *subject;                       ///< Email's subject
   char *real_subj;                     ///< Offset of the real subject
+  uint64_t real_subj_hash;             ///< Hash of real_subj, see mutt_env_real_subj_hash()
   char *disp_subj;                     ///< Display subject (modified copy of subject)
   char *message_id;                    ///< Message ID
   char *supersedes;                    ///< Supersedes header
@@ -80,15 +81,20 @@ struct Envelope
   struct Buffer spam;                  ///< Spam header
   struct ListHead references;          ///< message references (in reverse order)
   struct ListHead in_reply_to;         ///< in-reply-to header content
+  char *references_raw;                ///< Unparsed References, see mutt_env_parse_threads()
+  char *in_reply_to_raw;               ///< Unparsed In-Reply-To, see mutt_env_parse_threads()
   struct ListHead userhdrs;            ///< user defined headers
 #ifdef USE_AUTOCRYPT
   struct AutocryptHeader *autocrypt;
   struct AutocryptHeader *autocrypt_gossip;
 #endif
+  uint64_t content_hash;               ///< Hash of the identity fields, see mutt_env_content_hash()
   unsigned char changed;               ///< Changed fields, e.g. #MUTT_ENV_CHANGED_SUBJECT
 };
 
 bool             mutt_env_cmp_strict(const struct Envelope *e1, const struct Envelope *e2);
+uint64_t         mutt_env_content_hash(struct Envelope *env);
+uint64_t         mutt_env_real_subj_hash(struct Envelope *env);
 void             mutt_env_free      (struct Envelope **ptr);
 void             mutt_env_merge     (struct Envelope *base, struct Envelope **extra);
 struct Envelope *mutt_env_new       (void);
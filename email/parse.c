@@ -286,7 +286,35 @@ static void parse_references(struct ListHead *head, const char *s)
   char *m = NULL;
   for (size_t off = 0; (m = mutt_extract_message_id(s, &off)); s += off)
   {
-    mutt_list_insert_head(head, m);
+    /* the same ids recur across a whole thread - share their storage */
+    mutt_list_insert_head(head, mutt_intern_dup(m));
+    FREE(&m);
+  }
+}
+
+/**
+ * mutt_env_parse_threads - Parse the deferred threading headers
+ * @param env Envelope
+ *
+ * References and In-Reply-To are kept as raw strings at header-read time and
+ * only tokenized when threading, patterns or reply construction first look at
+ * them.  Most folders are opened unthreaded, where the lists are never
+ * consulted at all.
+ */
+void mutt_env_parse_threads(struct Envelope *env)
+{
+  if (!env)
+    return;
+
+  if (env->references_raw)
+  {
+    parse_references(&env->references, env->references_raw);
+    FREE(&env->references_raw);
+  }
+  if (env->in_reply_to_raw)
+  {
+    parse_references(&env->in_reply_to, env->in_reply_to_raw);
+    FREE(&env->in_reply_to_raw);
   }
 }
 
@@ -304,16 +332,182 @@ static void parse_content_language(const char *s, struct Body *ct)
   ct->language = mutt_str_dup(s);
 }
 
+/**
+ * struct WeedTrieNode - One byte of a compiled header-weeding pattern
+ *
+ * The `ignore`/`unignore` patterns are case-insensitive prefixes of header
+ * lines.  Both lists are compiled into a single trie of case-folded bytes, so
+ * matching a header costs one walk of the line, however many patterns there
+ * are.  Terminal flags record which list a pattern came from.
+ */
+struct WeedTrieNode
+{
+  unsigned char key;  ///< Case-folded byte this node matches
+  bool ignore : 1;    ///< An Ignore pattern ends at this node
+  bool unignore : 1;  ///< An UnIgnore pattern ends at this node
+  ARRAY_HEAD(WeedTrieNodeArray, struct WeedTrieNode *) children; ///< Sorted by key
+};
+
+static struct WeedTrieNode *WeedTrie = NULL; ///< Compiled Ignore/UnIgnore patterns
+static bool WeedTrieValid = false; ///< false when the lists changed since the last build
+
+/**
+ * weed_trie_free - Recursively free a trie of weed patterns
+ * @param ptr Trie to free
+ */
+static void weed_trie_free(struct WeedTrieNode **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct WeedTrieNode *node = *ptr;
+  struct WeedTrieNode **np = NULL;
+  ARRAY_FOREACH(np, &node->children)
+  {
+    weed_trie_free(np);
+  }
+  ARRAY_FREE(&node->children);
+  FREE(ptr);
+}
+
+/**
+ * weed_trie_lookup - Find the child node matching a byte
+ * @param node Parent node
+ * @param c    Case-folded byte to look for
+ * @retval ptr  Matching child node
+ * @retval NULL No child matches
+ */
+static struct WeedTrieNode *weed_trie_lookup(struct WeedTrieNode *node, unsigned char c)
+{
+  size_t lo = 0;
+  size_t hi = ARRAY_SIZE(&node->children);
+
+  while (lo < hi)
+  {
+    size_t mid = lo + (hi - lo) / 2;
+    struct WeedTrieNode *child = *ARRAY_GET(&node->children, mid);
+    if (child->key == c)
+      return child;
+    if (child->key < c)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return NULL;
+}
+
+/**
+ * weed_trie_insert - Add one pattern to the weed trie
+ * @param root     Root of the trie
+ * @param pat      Pattern string
+ * @param unignore true if the pattern comes from the UnIgnore list
+ *
+ * A pattern starting with '*' matches every header, which is recorded as a
+ * terminal flag on the root (mutt_list_match() only ever looked at the first
+ * character).
+ */
+static void weed_trie_insert(struct WeedTrieNode *root, const char *pat, bool unignore)
+{
+  if (!pat || (pat[0] == '\0'))
+    return;
+
+  struct WeedTrieNode *node = root;
+  if (pat[0] != '*')
+  {
+    for (; *pat; pat++)
+    {
+      const unsigned char c = tolower((unsigned char) *pat);
+      struct WeedTrieNode *child = weed_trie_lookup(node, c);
+      if (!child)
+      {
+        child = mutt_mem_calloc(1, sizeof(*child));
+        child->key = c;
+
+        /* keep the children sorted by key */
+        size_t pos = 0;
+        while ((pos < ARRAY_SIZE(&node->children)) &&
+               ((*ARRAY_GET(&node->children, pos))->key < c))
+        {
+          pos++;
+        }
+        ARRAY_ADD(&node->children, child);
+        memmove(&node->children.entries[pos + 1], &node->children.entries[pos],
+                (ARRAY_SIZE(&node->children) - pos - 1) * sizeof(child));
+        node->children.entries[pos] = child;
+      }
+      node = child;
+    }
+  }
+
+  if (unignore)
+    node->unignore = true;
+  else
+    node->ignore = true;
+}
+
+/**
+ * weed_trie_get - Get the compiled weed patterns, rebuilding if necessary
+ * @retval ptr Root of the trie
+ */
+static struct WeedTrieNode *weed_trie_get(void)
+{
+  if (WeedTrieValid)
+    return WeedTrie;
+
+  weed_trie_free(&WeedTrie);
+  WeedTrie = mutt_mem_calloc(1, sizeof(*WeedTrie));
+
+  struct ListNode *np = NULL;
+  STAILQ_FOREACH(np, &Ignore, entries)
+  {
+    weed_trie_insert(WeedTrie, np->data, false);
+  }
+  STAILQ_FOREACH(np, &UnIgnore, entries)
+  {
+    weed_trie_insert(WeedTrie, np->data, true);
+  }
+
+  WeedTrieValid = true;
+  return WeedTrie;
+}
+
+/**
+ * mutt_ignore_invalidate - Forget the compiled Ignore/UnIgnore patterns
+ *
+ * Must be called whenever the Ignore or UnIgnore lists change, e.g. by the
+ * 'ignore' and 'unignore' commands.  The trie is rebuilt on the next match.
+ */
+void mutt_ignore_invalidate(void)
+{
+  weed_trie_free(&WeedTrie);
+  WeedTrieValid = false;
+}
+
 /**
  * mutt_matches_ignore - Does the string match the ignore list
  * @param s String to check
  * @retval true If string matches
  *
- * Checks Ignore and UnIgnore using mutt_list_match
+ * A string matches if any Ignore pattern is a prefix of it and no UnIgnore
+ * pattern is.  Case is ignored, as in mutt_list_match().
  */
 bool mutt_matches_ignore(const char *s)
 {
-  return mutt_list_match(s, &Ignore) && !mutt_list_match(s, &UnIgnore);
+  struct WeedTrieNode *node = weed_trie_get();
+
+  bool ign = node->ignore;      /* '*' in the ignore list */
+  bool unign = node->unignore;  /* '*' in the unignore list */
+
+  for (; s && *s; s++)
+  {
+    node = weed_trie_lookup(node, tolower((unsigned char) *s));
+    if (!node)
+      break;
+    ign |= node->ignore;
+    unign |= node->unignore;
+  }
+
+  return ign && !unign;
 }
 
 /**
@@ -743,8 +937,8 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       if (!mutt_istr_equal(line + 1, "n-reply-to"))
         break;
 
-      mutt_list_free(&env->in_reply_to);
-      parse_references(&env->in_reply_to, p);
+      mutt_intern_list_free(&env->in_reply_to);
+      mutt_str_replace(&env->in_reply_to_raw, p);
       matched = true;
       break;
 
@@ -851,8 +1045,8 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
     case 'r':
       if (mutt_istr_equal(line + 1, "eferences"))
       {
-        mutt_list_free(&env->references);
-        parse_references(&env->references, p);
+        mutt_intern_list_free(&env->references);
+        mutt_str_replace(&env->references_raw, p);
         matched = true;
       }
       else if (mutt_istr_equal(line + 1, "eply-to"))
@@ -1113,6 +1307,8 @@ struct Envelope *mutt_rfc822_read_header(FILE *fp, struct Email *e, bool user_hd
   if (!fp)
     return NULL;
 
+  mutt_stats_count("parse/header", 1);
+
   struct Envelope *env = mutt_env_new();
   char *p = NULL;
   LOFF_T loc;
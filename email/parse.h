@@ -35,7 +35,9 @@ struct Email;
 void             mutt_auto_subscribe      (const char *mailto);
 int              mutt_check_encoding      (const char *c);
 enum ContentType mutt_check_mime_type     (const char *s);
+void             mutt_env_parse_threads   (struct Envelope *env);
 char *           mutt_extract_message_id  (const char *s, size_t *len);
+void             mutt_ignore_invalidate   (void);
 bool             mutt_is_message_type     (int type, const char *subtype);
 bool             mutt_matches_ignore      (const char *s);
 void             mutt_parse_content_type  (const char *s, struct Body *ct);
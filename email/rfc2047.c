@@ -140,6 +140,14 @@ static size_t q_encoder(char *str, const char *buf, size_t buflen, const char *t
 static char *parse_encoded_word(char *str, enum ContentEncoding *enc, char **charset,
                                 size_t *charsetlen, char **text, size_t *textlen)
 {
+  /* An encoded word always starts with "=?" - find the first candidate with
+   * strstr() before involving the regex, which would otherwise scan every
+   * byte of the (usually unencoded) prefix */
+  char *cand = strstr(str, "=?");
+  if (!cand)
+    return NULL;
+  str = cand;
+
   regmatch_t *match = mutt_prex_capture(PREX_RFC2047_ENCODED_WORD, str);
   if (!match)
     return NULL;
@@ -201,11 +209,9 @@ static size_t try_block(const char *d, size_t dlen, const char *fromcode,
         (iconv(cd, NULL, NULL, &ob, &obl) == (size_t)(-1)))
     {
       assert(errno == E2BIG);
-      iconv_close(cd);
       assert(ib > d);
       return ((ib - d) == dlen) ? dlen : ib - d + 1;
     }
-    iconv_close(cd);
   }
   else
   {
@@ -281,7 +287,6 @@ static size_t encode_block(char *str, char *buf, size_t buflen, const char *from
   const size_t n1 = iconv(cd, (ICONV_CONST char **) &ib, &ibl, &ob, &obl);
   const size_t n2 = iconv(cd, NULL, NULL, &ob, &obl);
   assert(n1 != (size_t)(-1) && n2 != (size_t)(-1));
-  iconv_close(cd);
   return (*encoder)(str, tmp, ob - tmp, tocode);
 }
 
@@ -641,6 +646,11 @@ void rfc2047_decode(char **pd)
   if (!pd || !*pd)
     return;
 
+  /* A header with no encoded words comes out of the loop below unchanged,
+   * so don't bother copying it (unless $assumed_charset may convert it) */
+  if (!C_AssumedCharset && !strstr(*pd, "=?"))
+    return;
+
   struct Buffer buf = mutt_buffer_make(0); /* Output buffer            */
   char *s = *pd;            /* Read pointer                           */
   char *beg = NULL;         /* Begin of encoded word                  */
@@ -780,6 +790,7 @@ void rfc2047_decode_envelope(struct Envelope *env)
 {
   if (!env)
     return;
+  env->content_hash = 0;
   rfc2047_decode_addrlist(&env->from);
   rfc2047_decode_addrlist(&env->to);
   rfc2047_decode_addrlist(&env->cc);
@@ -800,6 +811,7 @@ void rfc2047_encode_envelope(struct Envelope *env)
 {
   if (!env)
     return;
+  env->content_hash = 0;
   rfc2047_encode_addrlist(&env->from, "From");
   rfc2047_encode_addrlist(&env->to, "To");
   rfc2047_encode_addrlist(&env->cc, "Cc");
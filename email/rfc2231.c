@@ -36,6 +36,7 @@
 #include <ctype.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
 #include "mutt/lib.h"
 #include "rfc2231.h"
@@ -57,7 +58,6 @@ struct Rfc2231Parameter
   char *value;
   int index;
   bool encoded;
-  struct Rfc2231Parameter *next;
 };
 
 /**
@@ -136,30 +136,26 @@ static struct Rfc2231Parameter *parameter_new(void)
 }
 
 /**
- * list_insert - Insert parameter into an ordered list
- * @param[out] list List to insert into
- * @param[in]  par  Parameter to insert
+ * parameter_sort - Compare two Rfc2231Parameter pointers for qsort()
+ * @param a First Parameter
+ * @param b Second Parameter
+ * @retval -1 a precedes b
+ * @retval  0 a and b are identical
+ * @retval  1 b precedes a
  *
  * Primary sorting key: attribute
  * Secondary sorting key: index
  */
-static void list_insert(struct Rfc2231Parameter **list, struct Rfc2231Parameter *par)
+static int parameter_sort(const void *a, const void *b)
 {
-  struct Rfc2231Parameter **last = list;
-  struct Rfc2231Parameter *p = *list;
+  const struct Rfc2231Parameter *pa = *(struct Rfc2231Parameter const *const *) a;
+  const struct Rfc2231Parameter *pb = *(struct Rfc2231Parameter const *const *) b;
 
-  while (p)
-  {
-    const int c = strcmp(par->attribute, p->attribute);
-    if ((c < 0) || ((c == 0) && (par->index <= p->index)))
-      break;
-
-    last = &p->next;
-    p = p->next;
-  }
+  const int c = strcmp(pa->attribute, pb->attribute);
+  if (c != 0)
+    return c;
 
-  par->next = p;
-  *last = par;
+  return (pa->index > pb->index) - (pa->index < pb->index);
 }
 
 /**
@@ -178,16 +174,20 @@ static void parameter_free(struct Rfc2231Parameter **p)
 
 /**
  * join_continuations - Process continuation parameters
- * @param pl  Parameter List for the results
- * @param par Continuation Parameter
+ * @param pl    Parameter List for the results
+ * @param pars  Array of continuation Parameters, sorted by (attribute, index)
+ * @param count Number of entries in pars
  */
-static void join_continuations(struct ParameterList *pl, struct Rfc2231Parameter *par)
+static void join_continuations(struct ParameterList *pl,
+                               struct Rfc2231Parameter **pars, size_t count)
 {
   char attribute[256];
   char charset[256];
 
-  while (par)
+  size_t i = 0;
+  while (i < count)
   {
+    struct Rfc2231Parameter *par = pars[i];
     char *value = NULL;
     size_t l = 0;
 
@@ -211,9 +211,9 @@ static void join_continuations(struct ParameterList *pl, struct Rfc2231Parameter
       strcpy(value + l, par->value);
       l += vl;
 
-      struct Rfc2231Parameter *q = par->next;
-      parameter_free(&par);
-      par = q;
+      parameter_free(&pars[i]);
+      i++;
+      par = (i < count) ? pars[i] : NULL;
       if (par)
         valp = par->value;
     } while (par && (strcmp(par->attribute, attribute) == 0));
@@ -237,8 +237,10 @@ void rfc2231_decode_parameters(struct ParameterList *pl)
   if (!pl)
     return;
 
-  struct Rfc2231Parameter *conthead = NULL;
+  struct Rfc2231Parameter **contpars = NULL;
   struct Rfc2231Parameter *conttmp = NULL;
+  size_t contcount = 0;
+  size_t contsize = 0;
 
   char *s = NULL, *t = NULL;
   char charset[256];
@@ -303,13 +305,22 @@ void rfc2231_decode_parameters(struct ParameterList *pl)
       TAILQ_REMOVE(pl, np, entries);
       FREE(&np);
 
-      list_insert(&conthead, conttmp);
+      if (contcount == contsize)
+      {
+        contsize = (contsize == 0) ? 16 : (contsize * 2);
+        mutt_mem_realloc(&contpars, contsize * sizeof(*contpars));
+      }
+      contpars[contcount++] = conttmp;
     }
   }
 
-  if (conthead)
+  if (contpars)
   {
-    join_continuations(pl, conthead);
+    /* Sorting once and joining in a single pass beats the old per-fragment
+     * ordered insert, which was quadratic for in-order continuation indices */
+    qsort(contpars, contcount, sizeof(*contpars), parameter_sort);
+    join_continuations(pl, contpars, contcount);
+    FREE(&contpars);
     dirty = true;
   }
 
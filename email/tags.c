@@ -53,7 +53,7 @@ static char *driver_tags_getter(struct TagList *head, bool show_hidden,
   if (!head)
     return NULL;
 
-  char *tags = NULL;
+  struct Buffer buf = mutt_buffer_make(0);
   struct Tag *np = NULL;
   STAILQ_FOREACH(np, head, entries)
   {
@@ -61,13 +61,20 @@ static char *driver_tags_getter(struct TagList *head, bool show_hidden,
       continue;
     if (show_hidden || !np->hidden)
     {
+      if (!mutt_buffer_is_empty(&buf))
+        mutt_buffer_addch(&buf, ' ');
       if (show_transformed && np->transformed)
-        mutt_str_append_item(&tags, np->transformed, ' ');
+        mutt_buffer_addstr(&buf, np->transformed);
       else
-        mutt_str_append_item(&tags, np->name, ' ');
+        mutt_buffer_addstr(&buf, np->name);
     }
   }
-  return tags;
+
+  if (mutt_buffer_is_empty(&buf))
+    return NULL;
+
+  /* hand the string over to the caller */
+  return buf.data;
 }
 
 /**
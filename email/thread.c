@@ -34,6 +34,7 @@
 #include "thread.h"
 #include "email.h"
 #include "envelope.h"
+#include "parse.h"
 
 /**
  * is_descendant - Is one thread a descendant of another
@@ -183,6 +184,8 @@ void clean_references(struct MuttThread *brk, struct MuttThread *cur)
     if (!cur->message)
       break; /* skip pseudo-message */
 
+    mutt_env_parse_threads(cur->message->env);
+
     /* Looking for the first bad reference according to the new threading.
      * Optimal since NeoMutt stores the references in reverse order, and the
      * first loop should match immediately for mails respecting RFC2822. */
@@ -208,7 +211,7 @@ void clean_references(struct MuttThread *brk, struct MuttThread *cur)
       while ((np = STAILQ_NEXT(ref, entries)))
       {
         STAILQ_REMOVE_AFTER(&cur->message->env->references, ref, entries);
-        FREE(&np->data);
+        mutt_intern_release(&np->data);
         FREE(&np);
       }
 
@@ -227,8 +230,10 @@ void mutt_break_thread(struct Email *e)
   if (!e)
     return;
 
-  mutt_list_free(&e->env->in_reply_to);
-  mutt_list_free(&e->env->references);
+  mutt_intern_list_free(&e->env->in_reply_to);
+  mutt_intern_list_free(&e->env->references);
+  FREE(&e->env->in_reply_to_raw);
+  FREE(&e->env->references_raw);
   e->changed = true;
   e->env->changed |= (MUTT_ENV_CHANGED_IRT | MUTT_ENV_CHANGED_REFS);
 
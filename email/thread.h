@@ -48,6 +48,12 @@ struct MuttThread
   struct MuttThread *prev;          ///< Previous sibling Thread
   struct Email *message;            ///< Email this Thread refers to
   struct Email *sort_key;           ///< Email that this Thread is sorted against
+
+  int agg_gen;                      ///< ::ThreadAggGen the cached counters were computed at
+  unsigned int agg_visible;         ///< Cached: visible messages in this subtree
+  bool agg_new     : 1;             ///< Cached: subtree has a visible unread message
+  bool agg_old     : 1;             ///< Cached: subtree has a visible old (unread) message
+  bool agg_flagged : 1;             ///< Cached: subtree has a visible flagged message
 };
 
 void          clean_references      (struct MuttThread *brk, struct MuttThread *cur);
@@ -39,7 +39,9 @@
 #include "index.h"
 #include "keymap.h"
 #include "mutt_globals.h"
+#include "mutt_journal.h"
 #include "mutt_menu.h"
+#include "mutt_thread.h"
 #include "protos.h"
 #include "sort.h"
 
@@ -327,7 +329,19 @@ void mutt_set_flag_update(struct Mailbox *m, struct Email *e, int flag, bool bf,
 
   if (update)
   {
-    mutt_set_header_color(m, e);
+    if (upd_mbox)
+      mutt_journal_log(m, e, flag, bf);
+
+    /* Invalidate the cached colour instead of recomputing it here; matching
+     * the index colour patterns is O(rules) per message, which makes
+     * tag-all/delete-all on a big folder quadratic-feeling, and
+     * index_color() refills the cache lazily for the rows actually drawn */
+    e->pair = 0;
+    e->pair_author = 0;
+    e->pair_flags = 0;
+    e->pair_subject = 0;
+    IndexLineGen++; /* flags are rendered into the index lines */
+    ThreadAggGen++; /* flags feed the cached thread counters */
   }
 
   /* if the message status has changed, we need to invalidate the cached
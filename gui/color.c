@@ -305,7 +305,8 @@ static void color_line_free(struct Colors *c, struct ColorLine **ptr, bool free_
     mutt_color_free(c, cl->fg, cl->bg);
 #endif
 
-  regfree(&cl->regex);
+  if (cl->rx_ready)
+    regfree(&cl->regex);
   mutt_pattern_free(&cl->color_pattern);
   FREE(&cl->pattern);
   FREE(ptr);
@@ -410,6 +411,38 @@ static struct ColorLine *color_line_new(void)
   return cl;
 }
 
+/**
+ * mutt_color_line_regex - Get a ColorLine's compiled regex
+ * @param cl ColorLine
+ * @retval ptr  Compiled regex
+ * @retval NULL The regex failed to compile
+ *
+ * Colour regexes are compiled on first use rather than when the `color`
+ * command is parsed - see add_pattern().  A pattern that fails to compile is
+ * reported once and never matches.
+ */
+regex_t *mutt_color_line_regex(struct ColorLine *cl)
+{
+  if (!cl->rx_ready)
+  {
+    if (cl->rx_bad)
+      return NULL;
+
+    const int r = REG_COMP(&cl->regex, cl->pattern, cl->rx_flags);
+    if (r != 0)
+    {
+      char msg[256];
+      regerror(r, &cl->regex, msg, sizeof(msg));
+      mutt_error("%s: %s", cl->pattern, msg);
+      cl->rx_bad = true;
+      return NULL;
+    }
+    cl->rx_ready = true;
+  }
+
+  return &cl->regex;
+}
+
 #ifdef HAVE_COLOR
 #ifdef USE_SLANG_CURSES
 /**
@@ -1007,13 +1040,10 @@ static enum CommandResult add_pattern(struct Colors *c, struct ColorLineList *to
       else
         flags = REG_ICASE;
 
-      const int r = REG_COMP(&tmp->regex, s, flags);
-      if (r != 0)
-      {
-        regerror(r, &tmp->regex, err->data, err->dsize);
-        color_line_free(c, &tmp, true);
-        return MUTT_CMD_ERROR;
-      }
+      /* Compilation is deferred to mutt_color_line_regex() - with a
+       * colourful config, eagerly compiling every colour regex was a
+       * noticeable part of the startup time */
+      tmp->rx_flags = flags;
     }
     tmp->pattern = mutt_str_dup(s);
     tmp->match = match;
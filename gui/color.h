@@ -34,15 +34,18 @@
  */
 struct ColorLine
 {
-  regex_t regex;                     ///< Compiled regex
+  regex_t regex;                     ///< Compiled regex - only valid once `rx_ready` is set
   int match;                         ///< Substring to match, 0 for old behaviour
   char *pattern;                     ///< Pattern to match
   struct PatternList *color_pattern; ///< Compiled pattern to speed up index color calculation
   uint32_t fg;                       ///< Foreground colour
   uint32_t bg;                       ///< Background colour
   int pair;                          ///< Colour pair index
+  int rx_flags;                      ///< cflags for the deferred regex compilation
 
   bool stop_matching : 1;            ///< Used by the pager for body patterns, to prevent the color from being retried once it fails
+  bool rx_ready : 1;                 ///< Regex has been compiled by mutt_color_line_regex()
+  bool rx_bad : 1;                   ///< Regex failed to compile
 
   STAILQ_ENTRY(ColorLine) entries;   ///< Linked list
 };
@@ -176,6 +179,8 @@ int  mutt_color_alloc  (struct Colors *c, uint32_t fg,      uint32_t bg);
 int  mutt_color_combine(struct Colors *c, uint32_t fg_attr, uint32_t bg_attr);
 void mutt_color_free   (struct Colors *c, uint32_t fg,      uint32_t bg);
 
+regex_t *mutt_color_line_regex(struct ColorLine *cl);
+
 struct Colors *mutt_colors_new(void);
 void           mutt_colors_free(struct Colors **ptr);
 
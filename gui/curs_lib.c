@@ -102,6 +102,15 @@ void mutt_beep(bool force)
     beep();
 }
 
+/**
+ * mutt_macro_pending - Are macro/push events still queued?
+ * @retval true Key events remain in the macro buffer
+ */
+bool mutt_macro_pending(void)
+{
+  return (MacroBufferCount > 0) && !OptIgnoreMacroEvents;
+}
+
 /**
  * mutt_refresh - Force a refresh of the screen
  */
@@ -112,7 +121,7 @@ void mutt_refresh(void)
     return;
 
   /* don't refresh in the middle of macros unless necessary */
-  if (MacroBufferCount && !OptForceRefresh && !OptIgnoreMacroEvents)
+  if (mutt_macro_pending() && !OptForceRefresh)
     return;
 
   /* else */
@@ -173,6 +182,38 @@ static int mutt_monitor_getch(void)
 }
 #endif /* USE_INOTIFY */
 
+/// Time spent away from the keyboard (in ms) above which a stall is logged
+#define STALL_THRESHOLD_MS 1000
+
+/// When the last blocking key read returned, i.e. when the UI went busy
+static uint64_t BusySince = 0;
+
+/**
+ * stall_check - Log it when the UI was unresponsive for too long
+ *
+ * We regularly get "it froze" reports that can't be attributed.  A watchdog
+ * thread doesn't fit a single-threaded program, but the blocking key read is
+ * a natural heartbeat: everything between one read returning and the next
+ * one starting is time the UI couldn't react.  When that window exceeds
+ * #STALL_THRESHOLD_MS, log its duration - the `Got op` line preceding it in
+ * the debug log names the operation that caused it - and feed the `:stats`
+ * counters.  Spells spent blocked on input don't count.
+ */
+static void stall_check(void)
+{
+  if (BusySince == 0)
+    return;
+
+  const uint64_t spent = mutt_date_epoch_ms() - BusySince;
+  if (spent < STALL_THRESHOLD_MS)
+    return;
+
+  mutt_debug(LL_DEBUG1, "watchdog: UI busy for %llums after key %d\n",
+             (unsigned long long) spent, LastKey);
+  mutt_stats_count("watchdog/stalls", 1);
+  mutt_stats_record_ms("watchdog/stall", spent);
+}
+
 /**
  * mutt_getch - Read a character from the input buffer
  * @retval obj KeyEvent to process
@@ -200,6 +241,8 @@ struct KeyEvent mutt_getch(void)
 
   SigInt = 0;
 
+  stall_check();
+
   mutt_sig_allow_interrupt(true);
 #ifdef KEY_RESIZE
   /* ncurses 4.2 sends this when the screen is resized */
@@ -213,6 +256,9 @@ struct KeyEvent mutt_getch(void)
 #endif /* USE_INOTIFY */
   mutt_sig_allow_interrupt(false);
 
+  /* The read is over - from here on the UI is busy again */
+  BusySince = mutt_date_epoch_ms();
+
   if (SigInt)
   {
     mutt_query_exit();
@@ -1105,6 +1151,33 @@ void mutt_simple_format(char *buf, size_t buflen, int min_width, int max_width,
   memset(&mbstate2, 0, sizeof(mbstate2));
   buflen--;
   char *p = buf;
+
+  /* if the string is entirely printable ascii, every byte is one cell wide
+   * and truncation is a byte count - no need for the mbrtowc dance below.
+   * This is the common case for every index row on every redraw.  */
+  bool ascii = !arboreal;
+  for (size_t i = 0; ascii && (i < n); i++)
+  {
+    const unsigned char c = s[i];
+    if ((c < 0x20) || (c > 0x7e))
+      ascii = false;
+  }
+  if (ascii)
+  {
+    size_t len = n;
+    if (max_width < 0)
+      len = 0;
+    else if ((size_t) max_width < len)
+      len = max_width;
+    if (len > buflen)
+      len = buflen;
+    memcpy(p, s, len);
+    p += len;
+    buflen -= len;
+    min_width -= len;
+    n = 0;
+  }
+
   for (; n && (k = mbrtowc(&wc, s, n, &mbstate1)); s += k, n -= k)
   {
     if ((k == (size_t)(-1)) || (k == (size_t)(-2)))
@@ -1374,6 +1447,15 @@ int mutt_strnwidth(const char *s, size_t n)
   if (!s)
     return 0;
 
+  /* A string of printable ascii is one cell per byte, and that describes
+   * almost every string measured while drawing the index.  Check first and
+   * skip the mbrtowc() walk below. */
+  size_t i = 0;
+  while ((i < n) && ((unsigned char) s[i] >= 0x20) && ((unsigned char) s[i] <= 0x7e))
+    i++;
+  if (i == n)
+    return (int) n;
+
   wchar_t wc;
   int w;
   size_t k;
@@ -384,6 +384,42 @@ int mutt_window_move(struct MuttWindow *win, int col, int row)
   return move(win->state.row_offset + row, win->state.col_offset + col);
 }
 
+/**
+ * mutt_window_scroll_rows - Scroll a Window's rows using the terminal
+ * @param win   Window to scroll
+ * @param delta Rows to scroll by; positive moves the content up
+ * @retval true The terminal moved the rows
+ * @retval false Scrolling isn't possible - the caller must repaint
+ *
+ * Uses a curses scroll region so the terminal shifts the existing lines
+ * instead of NeoMutt retransmitting them - a large win on slow links.  Only
+ * full-width Windows can be scrolled this way; scroll regions always span
+ * the whole screen width, so a Window sharing its rows (e.g. with the
+ * sidebar) would drag its neighbour's content along.
+ *
+ * The rows exposed by the scroll are left blank; the caller repaints them.
+ */
+bool mutt_window_scroll_rows(struct MuttWindow *win, int delta)
+{
+  if (!win || !win->state.visible || (delta == 0))
+    return false;
+  if ((win->state.col_offset != 0) || (win->state.cols != COLS))
+    return false;
+  if ((delta >= win->state.rows) || (-delta >= win->state.rows))
+    return false;
+
+  const int top = win->state.row_offset;
+  const int bottom = top + win->state.rows - 1;
+
+  setscrreg(top, bottom);
+  scrollok(stdscr, true);
+  scrl(delta);
+  scrollok(stdscr, false);
+  setscrreg(0, LINES - 1);
+
+  return true;
+}
+
 /**
  * mutt_window_mvaddstr - Move the cursor and write a fixed string to a Window
  * @param win Window to write to
@@ -426,6 +462,36 @@ int mutt_window_mvprintw(struct MuttWindow *win, int col, int row, const char *f
   return rc;
 }
 
+/**
+ * window_tree_changed - Did a reflow change any Window's geometry?
+ * @param win Window tree to check
+ * @retval true Some Window's size, position or visibility changed
+ *
+ * Compares each Window's state against the `old` state saved by the last
+ * window_notify_all().
+ */
+static bool window_tree_changed(struct MuttWindow *win)
+{
+  if (!win)
+    return false;
+
+  if ((win->state.visible != win->old.visible) ||
+      (win->state.rows != win->old.rows) || (win->state.cols != win->old.cols) ||
+      (win->state.row_offset != win->old.row_offset) ||
+      (win->state.col_offset != win->old.col_offset))
+  {
+    return true;
+  }
+
+  struct MuttWindow *np = NULL;
+  TAILQ_FOREACH(np, &win->children, entries)
+  {
+    if (window_tree_changed(np))
+      return true;
+  }
+  return false;
+}
+
 /**
  * mutt_window_reflow - Resize a Window and its children
  * @param win Window to resize
@@ -440,6 +506,13 @@ void mutt_window_reflow(struct MuttWindow *win)
 
   mutt_debug(LL_DEBUG2, "entering\n");
   window_reflow(win);
+
+  /* If the layout came out identical - common when dialogs are stacked and
+   * the terminal hasn't changed - there's nothing to tell the observers and
+   * no reason to force a full repaint on a possibly slow terminal */
+  if (!window_tree_changed(win))
+    return;
+
   window_notify_all(win);
 
   mutt_menu_set_current_redraw_full();
@@ -178,26 +178,69 @@ static void decode_xbit(struct State *s, long len, bool istext, iconv_t cd)
 
   state_set_prefix(s);
 
-  int c;
+  /* Read in blocks and let memchr() hunt for the carriage returns, instead of
+   * inspecting every byte through fgetc().  Most lines have none at all.  */
+  char raw[BUFI_SIZE];
   char bufi[BUFI_SIZE];
   size_t l = 0;
-  while (((c = fgetc(s->fp_in)) != EOF) && len--)
+  bool pending_cr = false; /* chunk ended in '\r'; is an '\n' next? */
+
+  while ((len > 0) && (SigInt != 1))
   {
-    if ((c == '\r') && len)
+    size_t chunk = MIN((size_t) len, sizeof(raw));
+    chunk = fread(raw, 1, chunk, s->fp_in);
+    if (chunk == 0)
+      break;
+    len -= chunk;
+
+    const char *p = raw;
+    const char *end = raw + chunk;
+    while (p < end)
     {
-      const int ch = fgetc(s->fp_in);
-      if (ch == '\n')
+      if (pending_cr)
       {
-        c = ch;
-        len--;
+        pending_cr = false;
+        if (*p != '\n')
+        {
+          bufi[l++] = '\r';
+          if (l == sizeof(bufi))
+            convert_to_state(cd, bufi, &l, s);
+        }
+      }
+
+      const char *cr = memchr(p, '\r', end - p);
+      const char *stop = cr ? cr : end;
+      while (p < stop)
+      {
+        const size_t n = MIN((size_t) (stop - p), sizeof(bufi) - l);
+        memcpy(bufi + l, p, n);
+        l += n;
+        p += n;
+        if (l == sizeof(bufi))
+          convert_to_state(cd, bufi, &l, s);
+      }
+
+      if (cr)
+      {
+        p++; /* the '\r' is dropped if an '\n' follows, even across chunks */
+        if (p == end)
+          pending_cr = true;
+        else if (*p != '\n')
+        {
+          bufi[l++] = '\r';
+          if (l == sizeof(bufi))
+            convert_to_state(cd, bufi, &l, s);
+        }
       }
-      else
-        ungetc(ch, s->fp_in);
     }
+  }
 
-    bufi[l++] = c;
+  if (pending_cr)
+  {
+    /* the data ended in a lone '\r' */
     if (l == sizeof(bufi))
       convert_to_state(cd, bufi, &l, s);
+    bufi[l++] = '\r';
   }
 
   convert_to_state(cd, bufi, &l, s);
@@ -249,6 +292,18 @@ static void qp_decode_line(char *dest, char *src, size_t *l, int last)
 
   for (d = dest, s = src; *s;)
   {
+    if (*s != '=')
+    {
+      /* bulk-copy the run of literal characters up to the next '=' */
+      const char *eq = strchr(s, '=');
+      const size_t n = eq ? (size_t) (eq - s) : strlen(s);
+      memcpy(d, s, n);
+      d += n;
+      s += n;
+      kind = -1;
+      continue;
+    }
+
     switch ((kind = qp_decode_triple(s, &c)))
     {
       case 0:
@@ -315,7 +370,7 @@ static void decode_quoted(struct State *s, long len, bool istext, iconv_t cd)
   if (istext)
     state_set_prefix(s);
 
-  while (len > 0)
+  while ((len > 0) && (SigInt != 1))
   {
     /* It's ok to use a fixed size buffer for input, even if the line turns
      * out to be longer than this.  Just process the line in chunks.  This
@@ -387,7 +442,7 @@ static void decode_uuencoded(struct State *s, long len, bool istext, iconv_t cd)
     if (mutt_str_startswith(tmps, "begin "))
       break;
   }
-  while (len > 0)
+  while ((len > 0) && (SigInt != 1))
   {
     if (!fgets(tmps, sizeof(tmps), s->fp_in))
       return;
@@ -562,26 +617,35 @@ static int autoview_handler(struct Body *a, struct State *s)
       mutt_message(_("Invoking autoview command: %s"), mutt_b2s(cmd));
     }
 
-    fp_in = mutt_file_fopen(mutt_b2s(tempfile), "w+");
-    if (!fp_in)
-    {
-      mutt_perror("fopen");
-      mailcap_entry_free(&entry);
-      rc = -1;
-      goto cleanup;
-    }
-
-    mutt_file_copy_bytes(s->fp_in, fp_in, a->length);
-
     if (piped)
     {
-      unlink(mutt_b2s(tempfile));
+      /* The command reads stdin, so the decoded part never needs a name */
+      fp_in = mutt_file_mkstemp();
+      if (!fp_in)
+      {
+        mutt_perror(_("Can't create temporary file"));
+        mailcap_entry_free(&entry);
+        rc = -1;
+        goto cleanup;
+      }
+
+      mutt_file_copy_bytes(s->fp_in, fp_in, a->length);
       fflush(fp_in);
       rewind(fp_in);
       pid = filter_create_fd(mutt_b2s(cmd), NULL, &fp_out, &fp_err, fileno(fp_in), -1, -1);
     }
     else
     {
+      fp_in = mutt_file_fopen(mutt_b2s(tempfile), "w+");
+      if (!fp_in)
+      {
+        mutt_perror("fopen");
+        mailcap_entry_free(&entry);
+        rc = -1;
+        goto cleanup;
+      }
+
+      mutt_file_copy_bytes(s->fp_in, fp_in, a->length);
       mutt_file_fclose(&fp_in);
       pid = filter_create(mutt_b2s(cmd), NULL, &fp_out, &fp_err);
     }
@@ -1299,9 +1363,6 @@ static int run_decode_and_handler(struct Body *b, struct State *s,
   LOFF_T tmpoffset = 0;
   int decode = 0;
   int rc = 0;
-#ifndef USE_FMEMOPEN
-  struct Buffer *tempfile = NULL;
-#endif
 
   fseeko(s->fp_in, b->offset, SEEK_SET);
 
@@ -1329,14 +1390,13 @@ static int run_decode_and_handler(struct Body *b, struct State *s,
         return -1;
       }
 #else
-      tempfile = mutt_buffer_pool_get();
-      mutt_buffer_mktemp(tempfile);
-      s->fp_out = mutt_file_fopen(mutt_b2s(tempfile), "w");
+      /* An unlinked stream: it doubles as the handler's input below, so the
+       * decoded part never needs a name or a second open(2) */
+      s->fp_out = mutt_file_mkstemp();
       if (!s->fp_out)
       {
         mutt_error(_("Unable to open temporary file"));
-        mutt_debug(LL_DEBUG1, "Can't open %s\n", mutt_b2s(tempfile));
-        mutt_buffer_pool_release(&tempfile);
+        mutt_debug(LL_DEBUG1, "Can't create temporary file\n");
         return -1;
       }
 #endif
@@ -1366,13 +1426,11 @@ static int run_decode_and_handler(struct Body *b, struct State *s,
        * update tempsize. On the other hand, fflush does.  See
        * https://github.com/neomutt/neomutt/issues/440 */
       fflush(s->fp_out);
-#endif
       mutt_file_fclose(&s->fp_out);
 
       /* restore final destination and substitute the tempfile for input */
       s->fp_out = fp;
       fp = s->fp_in;
-#ifdef USE_FMEMOPEN
       if (tempsize)
       {
         s->fp_in = fmemopen(temp, tempsize, "r");
@@ -1388,9 +1446,14 @@ static int run_decode_and_handler(struct Body *b, struct State *s,
         return -1;
       }
 #else
-      s->fp_in = fopen(mutt_b2s(tempfile), "r");
-      unlink(mutt_b2s(tempfile));
-      mutt_buffer_pool_release(&tempfile);
+      /* restore final destination; the decode stream becomes the handler's
+       * input - rewind it instead of closing and reopening by name */
+      fflush(s->fp_out);
+      rewind(s->fp_out);
+      FILE *fp_decoded = s->fp_out;
+      s->fp_out = fp;
+      fp = s->fp_in;
+      s->fp_in = fp_decoded;
 #endif
       /* restore the prefix */
       s->prefix = save_prefix;
@@ -1496,6 +1559,9 @@ void mutt_decode_base64(struct State *s, size_t len, bool istext, iconv_t cd)
   char buf[5];
   int ch, i;
   bool cr = false;
+  char raw[BUFI_SIZE]; ///< Block of undecoded input
+  size_t rl = 0;       ///< Its fill level
+  size_t rpos = 0;     ///< Its read cursor
   char bufi[BUFI_SIZE];
   size_t l = 0;
 
@@ -1504,14 +1570,21 @@ void mutt_decode_base64(struct State *s, size_t len, bool istext, iconv_t cd)
   if (istext)
     state_set_prefix(s);
 
-  while (len > 0)
+  while ((len > 0) && (SigInt != 1))
   {
+    /* Gather the next quartet.  The input is read in blocks; saving a large
+     * attachment used to go through fgetc() for every single byte.  */
     for (i = 0; (i < 4) && (len > 0); len--)
     {
-      ch = fgetc(s->fp_in);
-      if (ch == EOF)
-        break;
-      if ((ch >= 0) && (ch < 128) && ((base64val(ch) != -1) || (ch == '=')))
+      if (rpos == rl)
+      {
+        rl = fread(raw, 1, MIN(len, sizeof(raw)), s->fp_in);
+        rpos = 0;
+        if (rl == 0)
+          break;
+      }
+      ch = (unsigned char) raw[rpos++];
+      if ((ch < 128) && ((base64val(ch) != -1) || (ch == '=')))
         buf[i++] = ch;
     }
     if (i != 4)
@@ -1855,7 +1928,21 @@ void mutt_decode_attachment(struct Body *b, struct State *s)
         charset = mutt_ch_get_default_charset();
     }
     if (charset && C_Charset)
-      cd = mutt_ch_iconv_open(C_Charset, charset, MUTT_ICONV_HOOK_FROM);
+    {
+      /* the descriptor feeds a whole decoded body, so keep it private */
+      cd = mutt_ch_iconv_open(C_Charset, charset, MUTT_ICONV_HOOK_FROM | MUTT_ICONV_NO_CACHE);
+    }
+  }
+
+  /* Decoding a very large part for display can take long enough to feel like
+   * a hang.  Let Ctrl-C cut it short - the decode loops stop at the next
+   * block and the missing tail is marked below.  Anything that isn't a
+   * display (saving, piping, forwarding) must never truncate. */
+  const bool interruptible = (s->flags & MUTT_DISPLAY) && (b->length > (1024 * 1024));
+  if (interruptible)
+  {
+    SigInt = 0;
+    mutt_sig_allow_interrupt(true);
   }
 
   fseeko(s->fp_in, b->offset, SEEK_SET);
@@ -1887,6 +1974,18 @@ void mutt_decode_attachment(struct Body *b, struct State *s)
       break;
   }
 
+  if (interruptible)
+  {
+    mutt_sig_allow_interrupt(false);
+    if (SigInt == 1)
+    {
+      SigInt = 0;
+      s->flags |= MUTT_TRUNCATED;
+      state_mark_attach(s);
+      state_printf(s, _("[-- Decoding interrupted - the rest of this part is not shown --]\n"));
+    }
+  }
+
   if (cd != (iconv_t)(-1))
     iconv_close(cd);
 }
@@ -34,12 +34,15 @@
 #include "lib.h"
 #include "compress/lib.h"
 #include "store/lib.h"
+#include "fts.h"
+#include "threads.h"
 #include "init.h"
 
 // clang-format off
 char *C_HeaderCache;               ///< Config: (hcache) Directory/file for the header cache database
 char *C_HeaderCacheBackend;        ///< Config: (hcache) Header cache backend to use
 #ifdef USE_HCACHE_COMPRESSION
+char *C_HeaderCacheCompressDictionary; ///< Config: (hcache) File containing a zstd dictionary for entry compression
 short C_HeaderCacheCompressLevel;  ///< Config: (hcache) Level of compression for method
 char *C_HeaderCacheCompressMethod; ///< Config: (hcache) Enable generic hcache database compression
 #endif
@@ -123,13 +126,19 @@ int compress_level_validator(const struct ConfigSet *cs, const struct ConfigDef
 
 struct ConfigDef HcacheVars[] = {
   // clang-format off
+  { "body_search_index", DT_BOOL, &C_BodySearchIndex, false, 0, NULL,
+    "(hcache) Cache body digests to speed up '~B' searches"
+  },
   { "header_cache", DT_PATH, &C_HeaderCache, 0, 0, NULL,
     "(hcache) Directory/file for the header cache database"
   },
   { "header_cache_backend", DT_STRING, &C_HeaderCacheBackend, 0, 0, hcache_validator,
-    "(hcache) Header cache backend to use"
+    "(hcache) Header cache backend to use ('auto' picks the fastest measured)"
   },
 #if defined(USE_HCACHE_COMPRESSION)
+  { "header_cache_compress_dictionary", DT_PATH, &C_HeaderCacheCompressDictionary, 0, 0, NULL,
+    "(hcache) File containing a zstd dictionary for entry compression"
+  },
   { "header_cache_compress_level", DT_NUMBER|DT_NOT_NEGATIVE, &C_HeaderCacheCompressLevel, 1, 0, compress_level_validator,
     "(hcache) Level of compression for method"
   },
@@ -143,6 +152,9 @@ struct ConfigDef HcacheVars[] = {
 #if defined(HAVE_GDBM) || defined(HAVE_BDB)
   { "header_cache_pagesize", DT_DEPRECATED|DT_LONG, &C_HeaderCachePagesize, 0, 0, NULL, NULL },
 #endif
+  { "thread_cache", DT_BOOL, &C_ThreadCache, false, 0, NULL,
+    "(hcache) Save the thread tree to speed up reopening folders"
+  },
   { NULL, 0, NULL, 0, 0, NULL, NULL },
   // clang-format on
 };
@@ -0,0 +1,325 @@
+/**
+ * @file
+ * Body-search digest cache
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page hc_fts Body-search digest cache
+ *
+ * A persistent index of message bodies, used to speed up repeated '~B'
+ * pattern searches.
+ *
+ * For each message that has been decoded for a body search, a small digest is
+ * stored in a database beside the header cache: a Bloom filter over the
+ * case-folded character trigrams of the decoded text.  Before a later search
+ * opens a message, the digest can prove that a literal search string does not
+ * occur in it - every trigram of the string would have to be present.  The
+ * filter can return false positives (the message is then searched normally),
+ * but never false negatives.
+ *
+ * The database is keyed by Message-ID; the record stores the body length and
+ * date so that a recycled Message-ID is detected and treated as a miss.
+ */
+
+#include "config.h"
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "lib.h"
+#include "store/lib.h"
+#include "fts.h"
+#include "muttlib.h"
+#include "serialize.h"
+
+/* These Config Variables are only used in hcache/fts.c */
+bool C_BodySearchIndex; ///< Config: (hcache) Cache body digests to speed up '~B' searches
+
+/// Version of the digest record format
+#define FTS_VERSION 1
+
+/// Size of the trigram Bloom filter, in bits (must be a power of two)
+#define FTS_DIGEST_BITS 2048
+
+/// Size of the trigram Bloom filter, in bytes
+#define FTS_DIGEST_BYTES (FTS_DIGEST_BITS / 8)
+
+static void *FtsCtx = NULL;     ///< Backend-specific context, NULL if closed
+static bool FtsTried = false;   ///< Has opening the database been attempted?
+
+#define fts_get_ops() mutt_hcache_store_ops()
+
+/**
+ * struct FtsDigest - Bloom filter being built from a stream of text
+ */
+struct FtsDigest
+{
+  unsigned char bits[FTS_DIGEST_BYTES]; ///< The filter itself
+  uint32_t window;                      ///< Rolling window of folded bytes
+  size_t count;                         ///< Bytes fed in so far
+};
+
+/**
+ * digest_set - Set the filter bits for one trigram
+ * @param bits    Bloom filter
+ * @param trigram Packed trigram of case-folded bytes
+ */
+static void digest_set(unsigned char *bits, uint32_t trigram)
+{
+  const uint32_t h1 = trigram * UINT32_C(2654435761);
+  const uint32_t h2 = (trigram * UINT32_C(2246822519)) ^ (trigram >> 11);
+
+  bits[(h1 % FTS_DIGEST_BITS) / 8] |= 1 << (h1 % 8);
+  bits[(h2 % FTS_DIGEST_BITS) / 8] |= 1 << (h2 % 8);
+}
+
+/**
+ * digest_isset - Check the filter bits for one trigram
+ * @param bits    Bloom filter
+ * @param trigram Packed trigram of case-folded bytes
+ * @retval true All bits for the trigram are set
+ */
+static bool digest_isset(const unsigned char *bits, uint32_t trigram)
+{
+  const uint32_t h1 = trigram * UINT32_C(2654435761);
+  const uint32_t h2 = (trigram * UINT32_C(2246822519)) ^ (trigram >> 11);
+
+  return (bits[(h1 % FTS_DIGEST_BITS) / 8] & (1 << (h1 % 8))) &&
+         (bits[(h2 % FTS_DIGEST_BITS) / 8] & (1 << (h2 % 8)));
+}
+
+/**
+ * digest_add - Feed text into a digest
+ * @param fd     Digest being built
+ * @param buf    Text to add
+ * @param buflen Length of the text
+ *
+ * May be called repeatedly - the trigram window carries over between calls.
+ */
+static void digest_add(struct FtsDigest *fd, const char *buf, size_t buflen)
+{
+  for (size_t i = 0; i < buflen; i++)
+  {
+    fd->window = ((fd->window << 8) | tolower((unsigned char) buf[i])) & 0xffffff;
+    fd->count++;
+    if (fd->count >= 3)
+      digest_set(fd->bits, fd->window);
+  }
+}
+
+/**
+ * fts_open - Open the digest database, if configured
+ * @retval true Database is open
+ *
+ * The database lives beside the header cache: in `$header_cache` if that is a
+ * directory, or next to it if it is a file.  Opening is attempted only once.
+ */
+static bool fts_open(void)
+{
+  if (FtsTried)
+    return (FtsCtx != NULL);
+  FtsTried = true;
+
+  if (!C_BodySearchIndex || !C_HeaderCache || (C_HeaderCache[0] == '\0'))
+    return false;
+
+  const struct StoreOps *ops = fts_get_ops();
+  if (!ops)
+    return false;
+
+  struct stat st;
+  const int plen = mutt_str_len(C_HeaderCache);
+  const bool slash = (C_HeaderCache[plen - 1] == '/');
+  const bool dir = ((stat(C_HeaderCache, &st) == 0) && S_ISDIR(st.st_mode)) || slash;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  if (dir)
+    mutt_buffer_printf(path, "%s%sneomutt-fts", C_HeaderCache, slash ? "" : "/");
+  else
+    mutt_buffer_printf(path, "%s-fts", C_HeaderCache);
+  mutt_encode_path(path, mutt_b2s(path));
+
+  FtsCtx = ops->open(mutt_b2s(path));
+  if (!FtsCtx)
+  {
+    /* remove a possibly incompatible version */
+    if (unlink(mutt_b2s(path)) == 0)
+      FtsCtx = ops->open(mutt_b2s(path));
+  }
+
+  mutt_buffer_pool_release(&path);
+  return (FtsCtx != NULL);
+}
+
+/**
+ * fts_key - Get the database key for an email
+ * @param e Email
+ * @retval ptr Key (the Message-ID), or NULL if the email can't be indexed
+ */
+static const char *fts_key(const struct Email *e)
+{
+  if (!e || !e->env || !e->body)
+    return NULL;
+  return e->env->message_id;
+}
+
+/**
+ * fts_store - Store a finished digest for an email
+ * @param e  Email the digest describes
+ * @param fd Digest of the email's decoded text
+ */
+static void fts_store(const struct Email *e, struct FtsDigest *fd)
+{
+  const char *key = fts_key(e);
+  if (!key)
+    return;
+
+  int off = 0;
+  unsigned char *d = mutt_mem_malloc(3 * sizeof(uint32_t) + FTS_DIGEST_BYTES);
+
+  d = serial_dump_uint32_t(FTS_VERSION, d, &off);
+  d = serial_dump_uint32_t((uint32_t) e->body->length, d, &off);
+  d = serial_dump_uint32_t((uint32_t) e->date_sent, d, &off);
+  lazy_realloc(&d, off, off + FTS_DIGEST_BYTES);
+  memcpy(d + off, fd->bits, FTS_DIGEST_BYTES);
+  off += FTS_DIGEST_BYTES;
+
+  fts_get_ops()->store(FtsCtx, key, mutt_str_len(key), d, off);
+  FREE(&d);
+}
+
+/**
+ * mutt_fts_check - Can an email's body contain a string?
+ * @param e      Email to check
+ * @param needle Literal text being searched for
+ * @retval enum #FtsResult
+ *
+ * #FTS_NO_MATCH is definitive and the message need not be opened; on
+ * #FTS_UNKNOWN or #FTS_MAY_MATCH the caller must search the message.
+ *
+ * Matching is done on case-folded trigrams, so the answer is valid for both
+ * case-sensitive and case-insensitive searches, but only for literal strings,
+ * never for regexes.
+ */
+enum FtsResult mutt_fts_check(const struct Email *e, const char *needle)
+{
+  const size_t nlen = mutt_str_len(needle);
+  const char *key = fts_key(e);
+  if (!key || (nlen < 3) || !fts_open())
+    return FTS_UNKNOWN;
+
+  size_t vlen = 0;
+  const struct StoreOps *ops = fts_get_ops();
+  void *v = ops->fetch(FtsCtx, key, mutt_str_len(key), &vlen);
+  if (!v)
+    return FTS_UNKNOWN;
+
+  enum FtsResult rc = FTS_UNKNOWN;
+  uint32_t version = 0, length = 0, date = 0;
+  int off = 0;
+
+  if (vlen >= (3 * sizeof(uint32_t) + FTS_DIGEST_BYTES))
+  {
+    serial_restore_uint32_t(&version, v, &off);
+    serial_restore_uint32_t(&length, v, &off);
+    serial_restore_uint32_t(&date, v, &off);
+
+    /* A stale record (e.g. a recycled Message-ID) is treated as a miss */
+    if ((version == FTS_VERSION) && (vlen == (off + FTS_DIGEST_BYTES)) &&
+        (length == (uint32_t) e->body->length) && (date == (uint32_t) e->date_sent))
+    {
+      const unsigned char *bits = (unsigned char *) v + off;
+      uint32_t window = 0;
+
+      rc = FTS_MAY_MATCH;
+      for (size_t i = 0; i < nlen; i++)
+      {
+        window = ((window << 8) | tolower((unsigned char) needle[i])) & 0xffffff;
+        if ((i >= 2) && !digest_isset(bits, window))
+        {
+          rc = FTS_NO_MATCH;
+          break;
+        }
+      }
+    }
+  }
+
+  ops->free(FtsCtx, &v);
+  return rc;
+}
+
+/**
+ * mutt_fts_learn - Index the decoded text of an email
+ * @param e      Email the text belongs to
+ * @param buf    Decoded text (body, or header and body)
+ * @param buflen Length of the text
+ *
+ * The text may be a superset of the body (extra text only adds bits to the
+ * filter), but it must contain the whole decoded body, or later lookups could
+ * give false negatives.
+ */
+void mutt_fts_learn(const struct Email *e, const char *buf, size_t buflen)
+{
+  if (!fts_key(e) || !fts_open())
+    return;
+
+  struct FtsDigest fd = { 0 };
+  digest_add(&fd, buf, buflen);
+  fts_store(e, &fd);
+}
+
+/**
+ * mutt_fts_learn_file - Index the decoded text of an email from a file
+ * @param e  Email the text belongs to
+ * @param fp Open file holding the decoded text
+ *
+ * As mutt_fts_learn(), but reads the whole of @a fp, which is rewound first.
+ */
+void mutt_fts_learn_file(const struct Email *e, FILE *fp)
+{
+  if (!fts_key(e) || !fts_open())
+    return;
+
+  if (fseek(fp, 0, SEEK_SET) != 0)
+    return;
+
+  struct FtsDigest fd = { 0 };
+  char buf[4096];
+  size_t len;
+  while ((len = fread(buf, 1, sizeof(buf), fp)) > 0)
+    digest_add(&fd, buf, len);
+
+  fts_store(e, &fd);
+}
+
+/**
+ * mutt_fts_shutdown - Close the digest database
+ */
+void mutt_fts_shutdown(void)
+{
+  if (FtsCtx)
+    fts_get_ops()->close(&FtsCtx);
+  FtsTried = false;
+}
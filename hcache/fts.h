@@ -0,0 +1,50 @@
+/**
+ * @file
+ * Body-search digest cache
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_HCACHE_FTS_H
+#define MUTT_HCACHE_FTS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+struct Email;
+
+/* These Config Variables are only used in hcache/fts.c */
+extern bool C_BodySearchIndex;
+
+/**
+ * enum FtsResult - Result of a body-digest lookup
+ */
+enum FtsResult
+{
+  FTS_UNKNOWN,   ///< No (valid) digest is stored for this message
+  FTS_NO_MATCH,  ///< The digest proves the text can't occur in the body
+  FTS_MAY_MATCH, ///< The digest allows a match (may be a false positive)
+};
+
+enum FtsResult mutt_fts_check(const struct Email *e, const char *needle);
+void mutt_fts_learn(const struct Email *e, const char *buf, size_t buflen);
+void mutt_fts_learn_file(const struct Email *e, FILE *fp);
+void mutt_fts_shutdown(void);
+
+#endif /* MUTT_HCACHE_FTS_H */
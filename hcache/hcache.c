@@ -35,6 +35,7 @@
 #include "config.h"
 #include <assert.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <limits.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -49,7 +50,9 @@
 #include "compress/lib.h"
 #include "store/lib.h"
 #include "hcache/hcversion.h"
+#include "mutt_parse.h"
 #include "muttlib.h"
+#include "score.h"
 #include "serialize.h"
 
 #if !(defined(HAVE_BDB) || defined(HAVE_GDBM) || defined(HAVE_KC) ||           \
@@ -60,7 +63,154 @@
 
 static unsigned int hcachever = 0x0;
 
-#define hcache_get_ops() store_get_backend_ops(C_HeaderCacheBackend)
+/// Size of the per-folder key filter, in bits (must be a power of two)
+#define BLOOM_BITS 32768
+
+/// Size of the per-folder key filter, in bytes
+#define BLOOM_BYTES (BLOOM_BITS / 8)
+
+#define hcache_get_ops() mutt_hcache_store_ops()
+
+/**
+ * mutt_hcache_store_dir - Directory on the filesystem the cache lives on
+ * @retval ptr Static buffer with the path
+ *
+ * `$header_cache` if it is a directory, `$tmpdir` otherwise.  Used to place
+ * the scratch databases of store_benchmark() where the real cache will be.
+ */
+const char *mutt_hcache_store_dir(void)
+{
+  static char dir[PATH_MAX];
+
+  mutt_str_copy(dir, NONULL(C_HeaderCache), sizeof(dir));
+  mutt_expand_path(dir, sizeof(dir));
+
+  struct stat st = { 0 };
+  if ((dir[0] != '\0') && (stat(dir, &st) == 0) && S_ISDIR(st.st_mode))
+    return dir;
+
+  mutt_str_copy(dir, NONULL(C_Tmpdir), sizeof(dir));
+  return dir;
+}
+
+/**
+ * mutt_hcache_store_ops - Get the StoreOps for `$header_cache_backend`
+ * @retval ptr  Set of function pointers
+ * @retval NULL No backend is compiled in
+ *
+ * "auto" benchmarks the compiled backends on the `$header_cache` filesystem
+ * (once per process) and uses whichever measured fastest.
+ */
+const struct StoreOps *mutt_hcache_store_ops(void)
+{
+  if (mutt_istr_equal(C_HeaderCacheBackend, "auto"))
+    return store_auto_backend_ops(mutt_hcache_store_dir());
+
+  return store_get_backend_ops(C_HeaderCacheBackend);
+}
+
+/**
+ * bloom_set - Mark a key as present in the folder's key filter
+ * @param hc     Header cache handle
+ * @param key    Backend key, as produced by realkey()
+ * @param keylen Length of the key
+ */
+static void bloom_set(struct HeaderCache *hc, const char *key, size_t keylen)
+{
+  if (!hc->bloom)
+    return;
+
+  const uint64_t h = mutt_fasthash_bytes(key, keylen, 0);
+  const uint32_t h1 = h % BLOOM_BITS;
+  const uint32_t h2 = (h >> 32) % BLOOM_BITS;
+
+  const unsigned char old1 = hc->bloom[h1 / 8];
+  const unsigned char old2 = hc->bloom[h2 / 8];
+  hc->bloom[h1 / 8] = old1 | (1 << (h1 % 8));
+  hc->bloom[h2 / 8] = old2 | (1 << (h2 % 8));
+  if ((hc->bloom[h1 / 8] != old1) || (hc->bloom[h2 / 8] != old2))
+    hc->bloom_dirty = true;
+}
+
+/**
+ * bloom_maybe - Can a key be present in the store?
+ * @param hc     Header cache handle
+ * @param key    Backend key, as produced by realkey()
+ * @param keylen Length of the key
+ * @retval true  The key may be stored (or the filter can't be trusted)
+ * @retval false The key is definitely not stored
+ */
+static bool bloom_maybe(struct HeaderCache *hc, const char *key, size_t keylen)
+{
+  if (!hc || !hc->bloom || !hc->bloom_trust)
+    return true;
+
+  const uint64_t h = mutt_fasthash_bytes(key, keylen, 0);
+  const uint32_t h1 = h % BLOOM_BITS;
+  const uint32_t h2 = (h >> 32) % BLOOM_BITS;
+
+  return (hc->bloom[h1 / 8] & (1 << (h1 % 8))) && (hc->bloom[h2 / 8] & (1 << (h2 % 8)));
+}
+
+/**
+ * folder_lock - Take the folder's writer lock
+ * @param hc Header cache handle
+ * @retval >=0 File descriptor holding the lock, for folder_unlock()
+ * @retval  -1 The lock couldn't be taken
+ *
+ * A sidecar lock next to the database file serialises the folder-level
+ * records (/BLOOM, /GENERATION) between concurrent neomutt instances.  The
+ * per-message records don't need it; they're only ever rewritten with
+ * equivalent content.
+ */
+static int folder_lock(struct HeaderCache *hc)
+{
+  if (!hc->dbpath)
+    return -1;
+
+  struct Buffer *lockfile = mutt_buffer_pool_get();
+  mutt_buffer_printf(lockfile, "%s.lock", hc->dbpath);
+  int fd = open(mutt_b2s(lockfile), O_WRONLY | O_CREAT, 0600);
+  mutt_buffer_pool_release(&lockfile);
+  if (fd < 0)
+    return -1;
+
+  if (mutt_file_lock(fd, true, true) < 0)
+  {
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+/**
+ * folder_unlock - Release the folder's writer lock
+ * @param fd Descriptor returned by folder_lock(), may be -1
+ */
+static void folder_unlock(int fd)
+{
+  if (fd < 0)
+    return;
+  mutt_file_unlock(fd);
+  close(fd);
+}
+
+/**
+ * generation_fetch - Read the folder's generation number
+ * @param hc Header cache handle
+ * @retval num Stored generation, 0 if the folder has never been written
+ */
+static uint32_t generation_fetch(struct HeaderCache *hc)
+{
+  uint32_t gen = 0;
+  size_t dlen = 0;
+  uint32_t *stored = mutt_hcache_fetch_raw(hc, "/GENERATION", 11, &dlen);
+  if (stored && (dlen == sizeof(*stored)))
+    gen = *stored;
+  mutt_hcache_free_raw(hc, (void **) &stored);
+  return gen;
+}
 
 #ifdef USE_HCACHE_COMPRESSION
 #define compr_get_ops() compress_get_ops(C_HeaderCacheCompressMethod)
@@ -99,7 +249,7 @@ static void *dump(struct HeaderCache *hc, const struct Email *e, int *off, uint3
 
   assert((size_t) *off == header_size());
 
-  lazy_realloc(&d, *off + sizeof(struct Email));
+  lazy_realloc(&d, *off, *off + sizeof(struct Email));
   memcpy(&e_dump, e, sizeof(struct Email));
 
   /* some fields are not safe to cache */
@@ -114,11 +264,38 @@ static void *dump(struct HeaderCache *hc, const struct Email *e, int *off, uint3
   e_dump.num_hidden = 0;
   e_dump.recipient = 0;
   e_dump.pair = 0;
-  e_dump.attach_valid = false;
+  e_dump.pair_author = 0;
+  e_dump.pair_flags = 0;
+  e_dump.pair_subject = 0;
+  e_dump.index_line = NULL;
+  e_dump.index_line_gen = 0;
+  e_dump.index_line_flags = 0;
+  e_dump.index_line_cols = 0;
+  e_dump.index_line_in_pager = false;
+  if (hc->attachhash == 0)
+  {
+    /* no attachment-count rules are in effect, so there's nothing to keep */
+    e_dump.attach_valid = false;
+    e_dump.attach_total = 0;
+  }
   e_dump.path = NULL;
   e_dump.tree = NULL;
   e_dump.thread = NULL;
   e_dump.sequence = 0;
+  /* env and body are serialised separately; the raw pointers would only make
+   * otherwise-identical records differ between sessions */
+  e_dump.env = NULL;
+  e_dump.body = NULL;
+  e_dump.edata_free = NULL;
+#ifdef USE_NOTMUCH
+  e_dump.nm_edata = NULL;
+#endif
+  if (hc->scorehash == 0)
+  {
+    /* the score rules depend on session state (or there are none) */
+    e_dump.score = 0;
+    e_dump.scored = false;
+  }
   STAILQ_INIT(&e_dump.tags);
 #ifdef MIXMASTER
   STAILQ_INIT(&e_dump.chain);
@@ -128,8 +305,8 @@ static void *dump(struct HeaderCache *hc, const struct Email *e, int *off, uint3
   memcpy(d + *off, &e_dump, sizeof(struct Email));
   *off += sizeof(struct Email);
 
-  d = serial_dump_envelope(e_dump.env, d, off, convert);
-  d = serial_dump_body(e_dump.body, d, off, convert);
+  d = serial_dump_envelope(e->env, d, off, convert);
+  d = serial_dump_body(e->body, d, off, convert);
 
   return d;
 }
@@ -159,6 +336,14 @@ static struct Email *restore(const unsigned char *d)
   off += sizeof(struct Email);
   e->sequence = sequence;
 
+  /* Scrub pointers that can't be valid in this process; records written by
+   * older code may still carry them */
+  e->index_line = NULL;
+  e->edata_free = NULL;
+#ifdef USE_NOTMUCH
+  e->nm_edata = NULL;
+#endif
+
   STAILQ_INIT(&e->tags);
 #ifdef MIXMASTER
   STAILQ_INIT(&e->chain);
@@ -407,6 +592,60 @@ struct HeaderCache *mutt_hcache_open(const char *path, const char *folder, hcach
     }
   }
 
+  if (hc && hc->ctx)
+  {
+    hc->dbpath = mutt_str_dup(mutt_b2s(hcpath));
+
+    /* Snapshot the folder's generation number.  Every writing session bumps
+     * it once, so a mismatch at close tells us another instance has written
+     * the folder behind our back. */
+    hc->generation = generation_fetch(hc);
+
+    /* Email::score survives in the cache, but only for the rules that
+     * produced it.  Tag the database with a hash of the score rules and drop
+     * just the cached scores, not the whole cache, when they don't match.  */
+    hc->scorehash = mutt_score_hash();
+    hc->scores_stale = true;
+    if (hc->scorehash != 0)
+    {
+      size_t dlen = 0;
+      uint32_t *stored = mutt_hcache_fetch_raw(hc, "/SCOREHASH", 10, &dlen);
+      if (stored && (dlen == sizeof(*stored)) && (*stored == hc->scorehash))
+        hc->scores_stale = false;
+      else
+        mutt_hcache_store_raw(hc, "/SCOREHASH", 10, &hc->scorehash, sizeof(hc->scorehash));
+      mutt_hcache_free_raw(hc, (void **) &stored);
+    }
+
+    /* Same deal for the `$index_format` %X attachment counts: they depend on
+     * the `attachments` command's rules, and computing one opens the message */
+    hc->attachhash = mutt_attach_check_hash();
+    hc->attach_stale = true;
+    if (hc->attachhash != 0)
+    {
+      size_t dlen = 0;
+      uint32_t *stored = mutt_hcache_fetch_raw(hc, "/ATTACHHASH", 11, &dlen);
+      if (stored && (dlen == sizeof(*stored)) && (*stored == hc->attachhash))
+        hc->attach_stale = false;
+      else
+        mutt_hcache_store_raw(hc, "/ATTACHHASH", 11, &hc->attachhash, sizeof(hc->attachhash));
+      mutt_hcache_free_raw(hc, (void **) &stored);
+    }
+
+    /* Load the folder's key filter, so fetches for uncached messages can
+     * skip the backend entirely.  Without a stored filter, this session
+     * just learns one for next time. */
+    size_t blen = 0;
+    unsigned char *bdata = mutt_hcache_fetch_raw(hc, "/BLOOM", 6, &blen);
+    hc->bloom = mutt_mem_calloc(1, BLOOM_BYTES);
+    if (bdata && (blen == BLOOM_BYTES))
+    {
+      memcpy(hc->bloom, bdata, BLOOM_BYTES);
+      hc->bloom_trust = true;
+    }
+    mutt_hcache_free_raw(hc, (void **) &bdata);
+  }
+
   mutt_buffer_pool_release(&hcpath);
   return hc;
 }
@@ -425,28 +664,53 @@ void mutt_hcache_close(struct HeaderCache *hc)
     compr_get_ops()->close(&hc->cctx);
 #endif
 
+  /* Write the key filter back, but only one that can be trusted: either it
+   * was complete when loaded, or it was learnt across a full folder scan.
+   * A part-learnt filter would turn into false "not stored" answers. */
+  if (hc->bloom && (hc->bloom_trust ? hc->bloom_dirty : hc->bloom_primed))
+  {
+    /* If the generation number moved while we had the folder open, another
+     * instance stored records our filter doesn't cover, and blindly writing
+     * ours would lose its keys.  Filters of equal size union by OR, so merge
+     * the stored one in first; the writer lock keeps the read-merge-write
+     * atomic against other closing instances.  A failed lock still merges,
+     * which at worst re-reads a filter - never loses one. */
+    const int lockfd = folder_lock(hc);
+    if (generation_fetch(hc) != hc->generation)
+    {
+      size_t blen = 0;
+      unsigned char *bdata = mutt_hcache_fetch_raw(hc, "/BLOOM", 6, &blen);
+      if (bdata && (blen == BLOOM_BYTES))
+      {
+        for (size_t i = 0; i < BLOOM_BYTES; i++)
+          hc->bloom[i] |= bdata[i];
+      }
+      mutt_hcache_free_raw(hc, (void **) &bdata);
+    }
+    mutt_hcache_store_raw(hc, "/BLOOM", 6, hc->bloom, BLOOM_BYTES);
+    folder_unlock(lockfd);
+  }
+  FREE(&hc->bloom);
+
   ops->close(&hc->ctx);
   FREE(&hc->folder);
+  FREE(&hc->dbpath);
   FREE(&hc);
 }
 
 /**
- * mutt_hcache_fetch - Multiplexor for StoreOps::fetch
+ * restore_entry - Validate and restore a fetched cache record
+ * @param hc          Header cache handle
+ * @param data        Raw blob, as returned by the store backend
+ * @param dlen        Length of the raw blob
+ * @param uidvalidity Only restore if it matches the stored uidvalidity, 0 to skip
+ * @retval obj HCacheEntry containing an Email, empty on failure
  */
-struct HCacheEntry mutt_hcache_fetch(struct HeaderCache *hc, const char *key,
-                                     size_t keylen, uint32_t uidvalidity)
+static struct HCacheEntry restore_entry(struct HeaderCache *hc, void *data,
+                                        size_t dlen, uint32_t uidvalidity)
 {
-  struct RealKey *rk = realkey(key, keylen);
   struct HCacheEntry entry = { 0 };
 
-  size_t dlen;
-  void *data = mutt_hcache_fetch_raw(hc, rk->key, rk->len, &dlen);
-  void *to_free = data;
-  if (!data)
-  {
-    goto end;
-  }
-
   /* restore uidvalidity and crc */
   size_t hlen = header_size();
   int off = 0;
@@ -455,7 +719,7 @@ struct HCacheEntry mutt_hcache_fetch(struct HeaderCache *hc, const char *key,
   assert((size_t) off == hlen);
   if (entry.crc != hc->crc || ((uidvalidity != 0) && uidvalidity != entry.uidvalidity))
   {
-    goto end;
+    return entry;
   }
 
 #ifdef USE_HCACHE_COMPRESSION
@@ -466,19 +730,126 @@ struct HCacheEntry mutt_hcache_fetch(struct HeaderCache *hc, const char *key,
     void *dblob = cops->decompress(hc->cctx, (char *) data + hlen, dlen - hlen);
     if (!dblob)
     {
-      goto end;
+      return entry;
     }
     data = (char *) dblob - hlen; /* restore skips uidvalidity and crc */
   }
 #endif
 
   entry.email = restore(data);
+  if (hc->scores_stale)
+  {
+    entry.email->score = 0;
+    entry.email->scored = false;
+  }
+  if (hc->attach_stale)
+  {
+    entry.email->attach_total = 0;
+    entry.email->attach_valid = false;
+  }
+  return entry;
+}
 
-end:
-  mutt_hcache_free_raw(hc, &to_free);
+/**
+ * mutt_hcache_fetch - Multiplexor for StoreOps::fetch
+ */
+struct HCacheEntry mutt_hcache_fetch(struct HeaderCache *hc, const char *key,
+                                     size_t keylen, uint32_t uidvalidity)
+{
+  struct RealKey *rk = realkey(key, keylen);
+  struct HCacheEntry entry = { 0 };
+
+  if (hc)
+    hc->bloom_primed = true;
+  if (!bloom_maybe(hc, rk->key, rk->len))
+  {
+    mutt_stats_count("hcache/miss", 1);
+    return entry; /* the filter proves the key isn't stored */
+  }
+
+  const int span = mutt_trace_start("mutt_hcache_fetch");
+
+  size_t dlen;
+  void *data = mutt_hcache_fetch_raw(hc, rk->key, rk->len, &dlen);
+  if (!data)
+  {
+    mutt_stats_count("hcache/miss", 1);
+    mutt_trace_end(span);
+    return entry;
+  }
+  mutt_stats_count("hcache/hit", 1);
+
+  if (!hc->bloom_trust)
+    bloom_set(hc, rk->key, rk->len);
+  entry = restore_entry(hc, data, dlen, uidvalidity);
+  mutt_hcache_free_raw(hc, &data);
+  mutt_trace_end(span);
   return entry;
 }
 
+/**
+ * mutt_hcache_fetch_multi - Fetch and validate a batch of headers from the cache
+ * @param[in]  hc          Pointer to the struct HeaderCache structure got by mutt_hcache_open()
+ * @param[in]  keys        Array of message identification strings (NULL entries are skipped)
+ * @param[in]  keylens     Array of key lengths
+ * @param[in]  num         Number of keys
+ * @param[in]  uidvalidity Only restore if it matches the stored uidvalidity, 0 to skip
+ * @param[out] entries     Caller-allocated array of @a num results
+ * @retval num Number of cache hits
+ * @retval  -1 Error
+ *
+ * Resolving a whole mailbox through one call amortises the per-lookup
+ * path-building and gives the store a single sweep in key order, instead of
+ * one independent point lookup per message.
+ */
+int mutt_hcache_fetch_multi(struct HeaderCache *hc, const char **keys,
+                            const size_t *keylens, size_t num,
+                            uint32_t uidvalidity, struct HCacheEntry *entries)
+{
+  const struct StoreOps *ops = hcache_get_ops();
+
+  if (!hc || !ops || !keys || !keylens || !entries)
+    return -1;
+
+  int hits = 0;
+  struct Buffer path = mutt_buffer_make(1024);
+
+  for (size_t i = 0; i < num; i++)
+  {
+    entries[i] = (struct HCacheEntry){ 0 };
+    if (!keys[i])
+      continue;
+
+    struct RealKey *rk = realkey(keys[i], keylens[i]);
+    hc->bloom_primed = true;
+    if (!bloom_maybe(hc, rk->key, rk->len))
+    {
+      mutt_stats_count("hcache/miss", 1);
+      continue; /* the filter proves the key isn't stored */
+    }
+
+    size_t klen = mutt_buffer_printf(&path, "%s%.*s", hc->folder, (int) rk->len, rk->key);
+    size_t dlen = 0;
+    void *data = ops->fetch(hc->ctx, mutt_b2s(&path), klen, &dlen);
+    if (!data)
+    {
+      mutt_stats_count("hcache/miss", 1);
+      continue;
+    }
+    mutt_stats_count("hcache/hit", 1);
+
+    if (!hc->bloom_trust)
+      bloom_set(hc, rk->key, rk->len);
+    entries[i] = restore_entry(hc, data, dlen, uidvalidity);
+    ops->free(hc->ctx, &data);
+    if (entries[i].email)
+      hits++;
+  }
+
+  mutt_buffer_dealloc(&path);
+  return hits;
+}
+
 /**
  * mutt_hcache_fetch_raw - Fetch a message's header from the cache
  * @param[in]  hc     Pointer to the struct HeaderCache structure got by mutt_hcache_open()
@@ -528,6 +899,8 @@ int mutt_hcache_store(struct HeaderCache *hc, const char *key, size_t keylen,
   if (!hc)
     return -1;
 
+  const int span = mutt_trace_start("mutt_hcache_store");
+
   int dlen = 0;
   char *data = dump(hc, e, &dlen, uidvalidity);
 
@@ -546,6 +919,7 @@ int mutt_hcache_store(struct HeaderCache *hc, const char *key, size_t keylen,
     if (!cdata)
     {
       FREE(&data);
+      mutt_trace_end(span);
       return -1;
     }
 
@@ -560,11 +934,37 @@ int mutt_hcache_store(struct HeaderCache *hc, const char *key, size_t keylen,
   }
 #endif
 
-  /* store uncompressed data */
   struct RealKey *rk = realkey(key, keylen);
+  const bool maybe_stored = bloom_maybe(hc, rk->key, rk->len);
+  bloom_set(hc, rk->key, rk->len);
+
+  /* Most routine stores are byte-identical to the record already on disk;
+   * checking costs a read, which is far cheaper than a rewrite.  The leading
+   * uint32 is a timestamp when the mailbox has no uidvalidity, so only
+   * compare it when the caller supplied a real one. */
+  size_t old_dlen = 0;
+  void *old_data = maybe_stored ? mutt_hcache_fetch_raw(hc, rk->key, rk->len, &old_dlen) : NULL;
+  if (old_data)
+  {
+    const size_t skip = (uidvalidity == 0) ? sizeof(uint32_t) : 0;
+    const bool same = (old_dlen == (size_t) dlen) &&
+                      (memcmp((char *) old_data + skip, data + skip, dlen - skip) == 0);
+    mutt_hcache_free_raw(hc, &old_data);
+    if (same)
+    {
+      mutt_stats_count("hcache/store_unchanged", 1);
+      FREE(&data);
+      mutt_trace_end(span);
+      return 0;
+    }
+  }
+
+  /* store uncompressed data */
+  mutt_stats_count("hcache/store", 1);
   int rc = mutt_hcache_store_raw(hc, rk->key, rk->len, data, dlen);
 
   FREE(&data);
+  mutt_trace_end(span);
 
   return rc;
 }
@@ -587,6 +987,16 @@ int mutt_hcache_store_raw(struct HeaderCache *hc, const char *key,
   if (!hc || !ops)
     return -1;
 
+  /* The first write of a session bumps the folder's generation number, so
+   * other instances sharing this cache can tell that their open-time
+   * snapshots (e.g. the key filter) have gone stale. */
+  if (!hc->gen_bumped)
+  {
+    hc->gen_bumped = true;
+    hc->generation++;
+    mutt_hcache_store_raw(hc, "/GENERATION", 11, &hc->generation, sizeof(hc->generation));
+  }
+
   struct Buffer path = mutt_buffer_make(1024);
 
   keylen = mutt_buffer_printf(&path, "%s%.*s", hc->folder, (int) keylen, key);
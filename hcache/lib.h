@@ -67,12 +67,14 @@
 #ifndef MUTT_HCACHE_LIB_H
 #define MUTT_HCACHE_LIB_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 struct Buffer;
 struct ConfigSet;
 struct Email;
+struct StoreOps;
 
 /**
  * struct HeaderCache - header cache structure
@@ -85,7 +87,18 @@ struct Email;
 struct HeaderCache
 {
   char *folder;
+  char *dbpath;        ///< Path of the database file, for the sidecar writer lock
   unsigned int crc;
+  uint32_t generation; ///< Folder generation number seen at open (or after our bump)
+  bool gen_bumped;     ///< This session has announced itself as a writer
+  uint32_t scorehash;  ///< Hash of the score rules, 0 if scores can't be cached
+  bool scores_stale;   ///< Cached Email::score values predate the current score rules
+  uint32_t attachhash; ///< Hash of the `attachments` rules, 0 if counts can't be cached
+  bool attach_stale;   ///< Cached Email::attach_total values predate the current rules
+  unsigned char *bloom; ///< Bloom filter over the folder's stored keys
+  bool bloom_trust;    ///< Filter was loaded complete; misses can skip the backend
+  bool bloom_dirty;    ///< Filter gained bits and must be written back
+  bool bloom_primed;   ///< A freshly learnt filter has seen a full folder scan
   void *ctx;
   void *cctx;
 };
@@ -109,6 +122,7 @@ typedef void (*hcache_namer_t)(const char *path, struct Buffer *dest);
 
 extern char *C_HeaderCache;
 extern char *C_HeaderCacheBackend;
+extern char *C_HeaderCacheCompressDictionary;
 extern short C_HeaderCacheCompressLevel;
 extern char *C_HeaderCacheCompressMethod;
 
@@ -155,6 +169,21 @@ int mutt_hcache_store(struct HeaderCache *hc, const char *key, size_t keylen,
  */
 struct HCacheEntry mutt_hcache_fetch(struct HeaderCache *hc, const char *key, size_t keylen, uint32_t uidvalidity);
 
+/**
+ * mutt_hcache_fetch_multi - fetch and validate a batch of headers from the cache
+ * @param[in]  hc          Pointer to the struct HeaderCache structure got by mutt_hcache_open()
+ * @param[in]  keys        Array of message identification strings (NULL entries are skipped)
+ * @param[in]  keylens     Array of key lengths
+ * @param[in]  num         Number of keys
+ * @param[in]  uidvalidity Only restore if it matches the stored uidvalidity, 0 to skip
+ * @param[out] entries     Caller-allocated array of @a num results
+ * @retval num Number of cache hits
+ * @retval  -1 Error
+ */
+int mutt_hcache_fetch_multi(struct HeaderCache *hc, const char **keys,
+                            const size_t *keylens, size_t num,
+                            uint32_t uidvalidity, struct HCacheEntry *entries);
+
 int mutt_hcache_store_raw(struct HeaderCache *hc, const char *key, size_t keylen,
                           void *data, size_t dlen);
 
@@ -177,6 +206,19 @@ void mutt_hcache_free_raw(struct HeaderCache *hc, void **data);
  */
 int mutt_hcache_delete_record(struct HeaderCache *hc, const char *key, size_t keylen);
 
+/**
+ * mutt_hcache_store_dir - Directory on the filesystem the cache lives on
+ * @retval ptr Static buffer with the path
+ */
+const char *mutt_hcache_store_dir(void);
+
+/**
+ * mutt_hcache_store_ops - Get the StoreOps for `$header_cache_backend`
+ * @retval ptr  Set of function pointers
+ * @retval NULL No backend is compiled in
+ */
+const struct StoreOps *mutt_hcache_store_ops(void);
+
 bool config_init_hcache(struct ConfigSet *cs);
 
 #endif /* MUTT_HCACHE_LIB_H */
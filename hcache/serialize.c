@@ -39,76 +39,35 @@
 #include "serialize.h"
 
 /**
- * lazy_realloc - Reallocate some memory
- * @param ptr Pointer to resize
+ * lazy_realloc - Grow a serialisation buffer geometrically
+ * @param ptr  Pointer to resize
+ * @param used Bytes already written to the buffer
  * @param size Minimum size
  *
- * The minimum size is 4KiB to avoid repeated resizing.
+ * Every serialisation buffer starts out as a 4KiB allocation and is only ever
+ * grown through this function, so its capacity is always
+ * max(4096, next-power-of-two(used)).  That invariant lets us derive the
+ * current capacity from @a used and skip the realloc when @a size still fits,
+ * instead of calling realloc once per field for large blobs.
  */
-void lazy_realloc(void *ptr, size_t size)
+void lazy_realloc(void *ptr, size_t used, size_t size)
 {
   void **p = (void **) ptr;
 
   if (p && (size < 4096))
     return;
 
-  mutt_mem_realloc(ptr, size);
-}
+  size_t capa = 4096;
+  while (capa < used)
+    capa <<= 1;
 
-/**
- * serial_dump_int - Pack an integer into a binary blob
- * @param i   Integer to save
- * @param d   Binary blob to add to
- * @param off Offset into the blob
- * @retval ptr End of the newly packed binary
- */
-unsigned char *serial_dump_int(unsigned int i, unsigned char *d, int *off)
-{
-  lazy_realloc(&d, *off + sizeof(int));
-  memcpy(d + *off, &i, sizeof(int));
-  (*off) += sizeof(int);
+  if (capa >= size)
+    return;
 
-  return d;
-}
+  while (capa < size)
+    capa <<= 1;
 
-/**
- * serial_dump_uint32_t - Pack a uint32_t into a binary blob
- * @param s   uint32_t to save
- * @param d   Binary blob to add to
- * @param off Offset into the blob
- * @retval ptr End of the newly packed binary
- */
-unsigned char *serial_dump_uint32_t(uint32_t s, unsigned char *d, int *off)
-{
-  lazy_realloc(&d, *off + sizeof(uint32_t));
-  memcpy(d + *off, &s, sizeof(uint32_t));
-  (*off) += sizeof(uint32_t);
-
-  return d;
-}
-
-/**
- * serial_restore_int - Unpack an integer from a binary blob
- * @param i   Integer to write to
- * @param d   Binary blob to read from
- * @param off Offset into the blob
- */
-void serial_restore_int(unsigned int *i, const unsigned char *d, int *off)
-{
-  memcpy(i, d + *off, sizeof(int));
-  (*off) += sizeof(int);
-}
-
-/**
- * serial_restore_uint32_t - Unpack an uint32_t from a binary blob
- * @param s   uint32_t to write to
- * @param d   Binary blob to read from
- * @param off Offset into the blob
- */
-void serial_restore_uint32_t(uint32_t *s, const unsigned char *d, int *off)
-{
-  memcpy(s, d + *off, sizeof(uint32_t));
-  (*off) += sizeof(uint32_t);
+  mutt_mem_realloc(ptr, capa);
 }
 
 /**
@@ -142,7 +101,7 @@ unsigned char *serial_dump_char_size(char *c, ssize_t size, unsigned char *d,
   }
 
   d = serial_dump_int(size, d, off);
-  lazy_realloc(&d, *off + size);
+  lazy_realloc(&d, *off, *off + size);
   memcpy(d + *off, p, size);
   *off += size;
 
@@ -183,21 +142,23 @@ void serial_restore_char(char **c, const unsigned char *d, int *off, bool conver
     return;
   }
 
-  *c = mutt_mem_malloc(size);
-  memcpy(*c, d + *off, size);
-  if (convert && !mutt_str_is_ascii(*c, size))
+  /* Decide up front whether the string needs converting, so the common
+   * all-ascii case costs a single allocation and copy */
+  const char *src = (const char *) d + *off;
+  if (convert && !mutt_str_is_ascii(src, size))
   {
-    char *tmp = mutt_str_dup(*c);
+    char *tmp = mutt_strn_dup(src, size - 1);
     if (mutt_ch_convert_string(&tmp, "utf-8", C_Charset, 0) == 0)
     {
-      FREE(c);
       *c = tmp;
+      *off += size;
+      return;
     }
-    else
-    {
-      FREE(&tmp);
-    }
+    FREE(&tmp);
   }
+
+  *c = mutt_mem_malloc(size);
+  memcpy(*c, src, size);
   *off += size;
 }
 
@@ -433,8 +394,10 @@ unsigned char *serial_dump_body(struct Body *c, unsigned char *d, int *off, bool
   nb.aptr = NULL;
   nb.mime_headers = NULL;
   nb.language = NULL;
+  nb.decrypted = NULL;
+  nb.fp_decrypted = NULL;
 
-  lazy_realloc(&d, *off + sizeof(struct Body));
+  lazy_realloc(&d, *off, *off + sizeof(struct Body));
   memcpy(d + *off, &nb, sizeof(struct Body));
   *off += sizeof(struct Body);
 
@@ -463,6 +426,8 @@ void serial_restore_body(struct Body *c, const unsigned char *d, int *off, bool
   memcpy(c, d + *off, sizeof(struct Body));
   *off += sizeof(struct Body);
   c->language = NULL;
+  c->decrypted = NULL;
+  c->fp_decrypted = NULL;
 
   serial_restore_char(&c->xtype, d, off, false);
   serial_restore_char(&c->subtype, d, off, false);
@@ -476,6 +441,24 @@ void serial_restore_body(struct Body *c, const unsigned char *d, int *off, bool
   serial_restore_char(&c->d_filename, d, off, convert);
 }
 
+/**
+ * ENVELOPE_ADDRESS_FIELDS - Schema of the Envelope's AddressList members
+ *
+ * One field list drives both serial_dump_envelope() and
+ * serial_restore_envelope(), so the two can't drift apart.  The order is part
+ * of the on-disk format: only ever append, and bumping the header cache
+ * version is handled automatically by the struct checksum in hcachever.
+ */
+#define ENVELOPE_ADDRESS_FIELDS                                                \
+  ENVELOPE_ADDRESS(return_path)                                                \
+  ENVELOPE_ADDRESS(from)                                                       \
+  ENVELOPE_ADDRESS(to)                                                         \
+  ENVELOPE_ADDRESS(cc)                                                         \
+  ENVELOPE_ADDRESS(bcc)                                                        \
+  ENVELOPE_ADDRESS(sender)                                                     \
+  ENVELOPE_ADDRESS(reply_to)                                                   \
+  ENVELOPE_ADDRESS(mail_followup_to)
+
 /**
  * serial_dump_envelope - Pack an Envelope into a binary blob
  * @param env     Envelope to pack
@@ -487,14 +470,9 @@ void serial_restore_body(struct Body *c, const unsigned char *d, int *off, bool
 unsigned char *serial_dump_envelope(struct Envelope *env, unsigned char *d,
                                     int *off, bool convert)
 {
-  d = serial_dump_address(&env->return_path, d, off, convert);
-  d = serial_dump_address(&env->from, d, off, convert);
-  d = serial_dump_address(&env->to, d, off, convert);
-  d = serial_dump_address(&env->cc, d, off, convert);
-  d = serial_dump_address(&env->bcc, d, off, convert);
-  d = serial_dump_address(&env->sender, d, off, convert);
-  d = serial_dump_address(&env->reply_to, d, off, convert);
-  d = serial_dump_address(&env->mail_followup_to, d, off, convert);
+#define ENVELOPE_ADDRESS(name) d = serial_dump_address(&env->name, d, off, convert);
+  ENVELOPE_ADDRESS_FIELDS
+#undef ENVELOPE_ADDRESS
 
   d = serial_dump_char(env->list_post, d, off, convert);
   d = serial_dump_char(env->subject, d, off, convert);
@@ -512,6 +490,8 @@ unsigned char *serial_dump_envelope(struct Envelope *env, unsigned char *d,
 
   d = serial_dump_buffer(&env->spam, d, off, convert);
 
+  /* the cache stores the parsed lists; materialize them if still deferred */
+  mutt_env_parse_threads(env);
   d = serial_dump_stailq(&env->references, d, off, false);
   d = serial_dump_stailq(&env->in_reply_to, d, off, false);
   d = serial_dump_stailq(&env->userhdrs, d, off, convert);
@@ -536,14 +516,9 @@ void serial_restore_envelope(struct Envelope *env, const unsigned char *d, int *
 {
   int real_subj_off;
 
-  serial_restore_address(&env->return_path, d, off, convert);
-  serial_restore_address(&env->from, d, off, convert);
-  serial_restore_address(&env->to, d, off, convert);
-  serial_restore_address(&env->cc, d, off, convert);
-  serial_restore_address(&env->bcc, d, off, convert);
-  serial_restore_address(&env->sender, d, off, convert);
-  serial_restore_address(&env->reply_to, d, off, convert);
-  serial_restore_address(&env->mail_followup_to, d, off, convert);
+#define ENVELOPE_ADDRESS(name) serial_restore_address(&env->name, d, off, convert);
+  ENVELOPE_ADDRESS_FIELDS
+#undef ENVELOPE_ADDRESS
 
   serial_restore_char(&env->list_post, d, off, convert);
 
@@ -29,6 +29,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <sys/types.h>
 
 struct AddressList;
@@ -44,8 +45,6 @@ unsigned char *serial_dump_buffer   (struct Buffer *buf,       unsigned char *d,
 unsigned char *serial_dump_char     (char *c,                  unsigned char *d, int *off, bool convert);
 unsigned char *serial_dump_char_size(char *c, ssize_t size,    unsigned char *d, int *off, bool convert);
 unsigned char *serial_dump_envelope (struct Envelope *e,       unsigned char *d, int *off, bool convert);
-unsigned char *serial_dump_int      (unsigned int i,           unsigned char *d, int *off);
-unsigned char *serial_dump_uint32_t (uint32_t s,               unsigned char *d, int *off);
 unsigned char *serial_dump_parameter(struct ParameterList *pl, unsigned char *d, int *off, bool convert);
 unsigned char *serial_dump_stailq   (struct ListHead *l,       unsigned char *d, int *off, bool convert);
 
@@ -54,11 +53,69 @@ void serial_restore_body     (struct Body *c,           const unsigned char *d,
 void serial_restore_buffer   (struct Buffer *buf,       const unsigned char *d, int *off, bool convert);
 void serial_restore_char     (char **c,                 const unsigned char *d, int *off, bool convert);
 void serial_restore_envelope (struct Envelope *e,       const unsigned char *d, int *off, bool convert);
-void serial_restore_int      (unsigned int *i,          const unsigned char *d, int *off);
-void serial_restore_uint32_t (uint32_t *s,              const unsigned char *d, int *off);
 void serial_restore_parameter(struct ParameterList *pl, const unsigned char *d, int *off, bool convert);
 void serial_restore_stailq   (struct ListHead *l,       const unsigned char *d, int *off, bool convert);
 
-void lazy_realloc(void *ptr, size_t size);
+void lazy_realloc(void *ptr, size_t used, size_t size);
+
+/* The fixed-size packers are inline, so the compiler can fold the size
+ * arithmetic into the per-field serialisers instead of paying a function call
+ * per integer. */
+
+/**
+ * serial_dump_int - Pack an integer into a binary blob
+ * @param i   Integer to save
+ * @param d   Binary blob to add to
+ * @param off Offset into the blob
+ * @retval ptr End of the newly packed binary
+ */
+static inline unsigned char *serial_dump_int(unsigned int i, unsigned char *d, int *off)
+{
+  lazy_realloc(&d, *off, *off + sizeof(int));
+  memcpy(d + *off, &i, sizeof(int));
+  (*off) += sizeof(int);
+
+  return d;
+}
+
+/**
+ * serial_dump_uint32_t - Pack a uint32_t into a binary blob
+ * @param s   uint32_t to save
+ * @param d   Binary blob to add to
+ * @param off Offset into the blob
+ * @retval ptr End of the newly packed binary
+ */
+static inline unsigned char *serial_dump_uint32_t(uint32_t s, unsigned char *d, int *off)
+{
+  lazy_realloc(&d, *off, *off + sizeof(uint32_t));
+  memcpy(d + *off, &s, sizeof(uint32_t));
+  (*off) += sizeof(uint32_t);
+
+  return d;
+}
+
+/**
+ * serial_restore_int - Unpack an integer from a binary blob
+ * @param i   Integer to write to
+ * @param d   Binary blob to read from
+ * @param off Offset into the blob
+ */
+static inline void serial_restore_int(unsigned int *i, const unsigned char *d, int *off)
+{
+  memcpy(i, d + *off, sizeof(int));
+  (*off) += sizeof(int);
+}
+
+/**
+ * serial_restore_uint32_t - Unpack an uint32_t from a binary blob
+ * @param s   uint32_t to write to
+ * @param d   Binary blob to read from
+ * @param off Offset into the blob
+ */
+static inline void serial_restore_uint32_t(uint32_t *s, const unsigned char *d, int *off)
+{
+  memcpy(s, d + *off, sizeof(uint32_t));
+  (*off) += sizeof(uint32_t);
+}
 
 #endif /* MUTT_HCACHE_SERIALIZE_H */
@@ -0,0 +1,258 @@
+/**
+ * @file
+ * Thread-tree snapshot cache
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page hc_threads Thread-tree snapshot cache
+ *
+ * A persistent record of each folder's thread tree, used to avoid re-walking
+ * the References of every message each time the folder is opened.
+ *
+ * When a threaded folder is closed, one record per folder is written to a
+ * database beside the header cache: for each message, its Message-ID and the
+ * Message-ID of its parent in the tree.  On the next open, messages found in
+ * the snapshot are attached to their saved parent directly; only messages the
+ * snapshot doesn't cover (new arrivals, messages whose parent has gone, or
+ * ones threaded under a missing "ghost" message) take the full References
+ * walk.  A stale entry can never mislink: a Message-ID that no longer
+ * resolves simply falls back to the normal walk.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "lib.h"
+#include "store/lib.h"
+#include "threads.h"
+#include "mutt_thread.h"
+#include "muttlib.h"
+#include "serialize.h"
+
+/* These Config Variables are only used in hcache/threads.c */
+bool C_ThreadCache; ///< Config: (hcache) Save the thread tree to speed up reopening folders
+
+/// Version of the snapshot record format
+#define THREADS_VERSION 1
+
+static void *ThreadsCtx = NULL;   ///< Backend-specific context, NULL if closed
+static bool ThreadsTried = false; ///< Has opening the database been attempted?
+
+#define threads_get_ops() mutt_hcache_store_ops()
+
+/**
+ * threads_open - Open the snapshot database, if configured
+ * @retval true Database is open
+ *
+ * The database lives beside the header cache: in `$header_cache` if that is a
+ * directory, or next to it if it is a file.  Opening is attempted only once.
+ */
+static bool threads_open(void)
+{
+  if (ThreadsTried)
+    return (ThreadsCtx != NULL);
+  ThreadsTried = true;
+
+  if (!C_ThreadCache || !C_HeaderCache || (C_HeaderCache[0] == '\0'))
+    return false;
+
+  const struct StoreOps *ops = threads_get_ops();
+  if (!ops)
+    return false;
+
+  struct stat st;
+  const int plen = mutt_str_len(C_HeaderCache);
+  const bool slash = (C_HeaderCache[plen - 1] == '/');
+  const bool dir = ((stat(C_HeaderCache, &st) == 0) && S_ISDIR(st.st_mode)) || slash;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  if (dir)
+    mutt_buffer_printf(path, "%s%sneomutt-threads", C_HeaderCache, slash ? "" : "/");
+  else
+    mutt_buffer_printf(path, "%s-threads", C_HeaderCache);
+  mutt_encode_path(path, mutt_b2s(path));
+
+  ThreadsCtx = ops->open(mutt_b2s(path));
+  if (!ThreadsCtx)
+  {
+    /* remove a possibly incompatible version */
+    if (unlink(mutt_b2s(path)) == 0)
+      ThreadsCtx = ops->open(mutt_b2s(path));
+  }
+
+  mutt_buffer_pool_release(&path);
+  return (ThreadsCtx != NULL);
+}
+
+/**
+ * threads_flags - Pack the config that shaped a thread tree
+ * @retval num Flags word stored in the record
+ *
+ * A snapshot built under different threading config must not be replayed.
+ */
+static uint32_t threads_flags(void)
+{
+  return (C_StrictThreads ? 1 : 0) | (C_DuplicateThreads ? 2 : 0);
+}
+
+/**
+ * threads_entry_free - Free a ThreadCacheEntry - Implements ::hash_hdata_free_t
+ */
+static void threads_entry_free(int type, void *obj, intptr_t data)
+{
+  struct ThreadCacheEntry *tce = obj;
+  FREE(&tce->parent);
+  FREE(&tce);
+}
+
+/**
+ * mutt_thread_cache_save - Save a Mailbox's thread tree
+ * @param m Mailbox whose tree is saved
+ *
+ * Stores one record for the whole folder, keyed by its path.  Messages that
+ * can't be replayed safely are simply left out of the record: duplicates,
+ * messages without a Message-ID, and messages threaded under a ghost (a
+ * parent with no message, known only from References) - those take the
+ * normal References walk on the next open.
+ */
+void mutt_thread_cache_save(struct Mailbox *m)
+{
+  if (!m || !threads_open())
+    return;
+
+  int off = 0;
+  uint32_t count = 0;
+  unsigned char *d = mutt_mem_malloc(4096);
+
+  d = serial_dump_uint32_t(THREADS_VERSION, d, &off);
+  d = serial_dump_uint32_t(threads_flags(), d, &off);
+  const int count_off = off;
+  d = serial_dump_uint32_t(count, d, &off);
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e || !e->thread || e->thread->duplicate_thread || !e->env->message_id)
+      continue;
+
+    struct MuttThread *parent = e->thread->parent;
+    char *parent_id = NULL;
+    if (parent)
+    {
+      if (!parent->message || !parent->message->env->message_id)
+        continue; /* ghost parent - let this one rethread normally */
+      parent_id = parent->message->env->message_id;
+    }
+
+    d = serial_dump_char(e->env->message_id, d, &off, false);
+    d = serial_dump_char(parent_id ? parent_id : "", d, &off, false);
+    d = serial_dump_uint32_t(e->thread->fake_thread, d, &off);
+    count++;
+  }
+
+  /* An unthreaded session has nothing to say; keep any earlier snapshot */
+  if (count != 0)
+  {
+    memcpy(d + count_off, &count, sizeof(count));
+    const char *key = mailbox_path(m);
+    threads_get_ops()->store(ThreadsCtx, key, mutt_str_len(key), d, off);
+  }
+  FREE(&d);
+}
+
+/**
+ * mutt_thread_cache_load - Load a Mailbox's saved thread tree
+ * @param m Mailbox being threaded
+ * @retval ptr Hash Table of Message-ID to ThreadCacheEntry
+ * @retval NULL No (usable) snapshot is stored for this folder
+ *
+ * The caller owns the table and frees it with mutt_hash_free().
+ */
+struct HashTable *mutt_thread_cache_load(struct Mailbox *m)
+{
+  if (!m || !threads_open())
+    return NULL;
+
+  size_t vlen = 0;
+  const struct StoreOps *ops = threads_get_ops();
+  const char *key = mailbox_path(m);
+  void *v = ops->fetch(ThreadsCtx, key, mutt_str_len(key), &vlen);
+  if (!v)
+    return NULL;
+
+  struct HashTable *table = NULL;
+  uint32_t version = 0, flags = 0, count = 0;
+  int off = 0;
+
+  if (vlen >= (3 * sizeof(uint32_t)))
+  {
+    serial_restore_uint32_t(&version, v, &off);
+    serial_restore_uint32_t(&flags, v, &off);
+    serial_restore_uint32_t(&count, v, &off);
+
+    if ((version == THREADS_VERSION) && (flags == threads_flags()))
+    {
+      table = mutt_hash_new(count * 2, MUTT_HASH_STRDUP_KEYS);
+      mutt_hash_set_destructor(table, threads_entry_free, 0);
+
+      for (uint32_t i = 0; (i < count) && ((size_t) off < vlen); i++)
+      {
+        char *msgid = NULL;
+        struct ThreadCacheEntry *tce = mutt_mem_calloc(1, sizeof(struct ThreadCacheEntry));
+        uint32_t fake = 0;
+
+        serial_restore_char(&msgid, v, &off, false);
+        serial_restore_char(&tce->parent, v, &off, false);
+        serial_restore_uint32_t(&fake, v, &off);
+        tce->fake = fake;
+
+        if (msgid && tce->parent)
+        {
+          mutt_hash_insert(table, msgid, tce);
+          FREE(&msgid);
+        }
+        else
+        {
+          FREE(&msgid);
+          threads_entry_free(0, tce, 0);
+        }
+      }
+    }
+  }
+
+  ops->free(ThreadsCtx, &v);
+  return table;
+}
+
+/**
+ * mutt_thread_cache_shutdown - Close the snapshot database
+ */
+void mutt_thread_cache_shutdown(void)
+{
+  if (ThreadsCtx)
+    threads_get_ops()->close(&ThreadsCtx);
+  ThreadsTried = false;
+}
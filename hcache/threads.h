@@ -0,0 +1,47 @@
+/**
+ * @file
+ * Thread-tree snapshot cache
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_HCACHE_THREADS_H
+#define MUTT_HCACHE_THREADS_H
+
+#include <stdbool.h>
+
+struct HashTable;
+struct Mailbox;
+
+/* These Config Variables are only used in hcache/threads.c */
+extern bool C_ThreadCache;
+
+/**
+ * struct ThreadCacheEntry - One message's place in a saved thread tree
+ */
+struct ThreadCacheEntry
+{
+  char *parent; ///< Message-ID of the parent, or "" for a top-level message
+  bool fake;    ///< Was the message pseudo-threaded (subject-linked)?
+};
+
+struct HashTable *mutt_thread_cache_load(struct Mailbox *m);
+void mutt_thread_cache_save(struct Mailbox *m);
+void mutt_thread_cache_shutdown(void);
+
+#endif /* MUTT_HCACHE_THREADS_H */
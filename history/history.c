@@ -94,11 +94,68 @@ struct History
 
 static struct History Histories[HC_MAX];
 static int OldSize = 0;
+static bool HistLoaded[HC_MAX]; ///< Has `$history_file` been replayed into this ring?
+
+/**
+ * hist_read_class - Replay the history file into one History ring
+ * @param hclass History to load
+ *
+ * Scan `$history_file` and add the lines belonging to hclass to its ring.
+ * Lines belonging to the other classes are skipped; each ring is loaded the
+ * first time it's consulted.
+ */
+static void hist_read_class(enum HistoryClass hclass)
+{
+  int hc, read;
+  char *linebuf = NULL, *p = NULL;
+  struct MuttFileLines fl = { 0 };
+
+  if (!C_HistoryFile)
+    return;
+
+  FILE *fp = mutt_file_fopen(C_HistoryFile, "r");
+  if (!fp)
+    return;
+
+  if (!mutt_file_lines_load(&fl, fp))
+  {
+    mutt_file_fclose(&fp);
+    return;
+  }
+
+  while ((linebuf = mutt_file_lines_next(&fl)))
+  {
+    read = 0;
+    if ((sscanf(linebuf, "%d:%n", &hc, &read) < 1) || (read == 0) ||
+        (*(p = linebuf + strlen(linebuf) - 1) != '|') || (hc < 0))
+    {
+      mutt_error(_("Bad history file format (line %d)"), fl.line_num);
+      break;
+    }
+    /* silently ignore too high class (probably newer neomutt) */
+    if ((hc >= HC_MAX) || (hc != hclass))
+      continue;
+    *p = '\0';
+    p = mutt_str_dup(linebuf + read);
+    if (p)
+    {
+      mutt_ch_convert_string(&p, "utf-8", C_Charset, 0);
+      mutt_hist_add(hclass, p, false);
+      FREE(&p);
+    }
+  }
+
+  mutt_file_lines_free(&fl);
+  mutt_file_fclose(&fp);
+}
 
 /**
  * get_history - Get a particular history
  * @param hclass Type of history to find
  * @retval ptr History ring buffer
+ *
+ * On the first call for a class, its entries are replayed from
+ * `$history_file`.
  */
 static struct History *get_history(enum HistoryClass hclass)
 {
@@ -106,7 +163,17 @@ static struct History *get_history(enum HistoryClass hclass)
     return NULL;
 
   struct History *hist = &Histories[hclass];
-  return hist->hist ? hist : NULL;
+  if (!hist->hist)
+    return NULL;
+
+  if (!HistLoaded[hclass])
+  {
+    /* Set the flag first: mutt_hist_add(), used to fill the ring, calls back here */
+    HistLoaded[hclass] = true;
+    hist_read_class(hclass);
+  }
+
+  return hist;
 }
 
 /**
@@ -442,7 +509,7 @@ void mutt_hist_free(void)
  * mutt_hist_init - Create a set of empty History ring buffers
  *
  * This just creates empty histories.
- * To fill them, call mutt_hist_read_file().
+ * They're filled from `$history_file` the first time they're consulted.
  */
 void mutt_hist_init(void)
 {
@@ -450,7 +517,10 @@ void mutt_hist_init(void)
     return;
 
   for (enum HistoryClass hclass = HC_FIRST; hclass < HC_MAX; hclass++)
+  {
     init_history(&Histories[hclass]);
+    HistLoaded[hclass] = false;
+  }
 
   OldSize = C_History;
 }
@@ -563,45 +633,19 @@ void mutt_hist_reset_state(enum HistoryClass hclass)
 /**
  * mutt_hist_read_file - Read the History from a file
  *
- * The file `$history_file` is read and parsed into separate History ring buffers.
+ * Load every History ring that hasn't been consulted yet from
+ * `$history_file`.  Normally the rings are loaded on demand by
+ * get_history(); this reads the stragglers.
  */
 void mutt_hist_read_file(void)
 {
-  int line = 0, hclass, read;
-  char *linebuf = NULL, *p = NULL;
-  size_t buflen;
-
-  if (!C_HistoryFile)
-    return;
-
-  FILE *fp = mutt_file_fopen(C_HistoryFile, "r");
-  if (!fp)
-    return;
-
-  while ((linebuf = mutt_file_read_line(linebuf, &buflen, fp, &line, 0)))
+  for (enum HistoryClass hclass = HC_FIRST; hclass < HC_MAX; hclass++)
   {
-    read = 0;
-    if ((sscanf(linebuf, "%d:%n", &hclass, &read) < 1) || (read == 0) ||
-        (*(p = linebuf + strlen(linebuf) - 1) != '|') || (hclass < 0))
-    {
-      mutt_error(_("Bad history file format (line %d)"), line);
-      break;
-    }
-    /* silently ignore too high class (probably newer neomutt) */
-    if (hclass >= HC_MAX)
+    if (HistLoaded[hclass])
       continue;
-    *p = '\0';
-    p = mutt_str_dup(linebuf + read);
-    if (p)
-    {
-      mutt_ch_convert_string(&p, "utf-8", C_Charset, 0);
-      mutt_hist_add(hclass, p, false);
-      FREE(&p);
-    }
+    HistLoaded[hclass] = true;
+    hist_read_class(hclass);
   }
-
-  mutt_file_fclose(&fp);
-  FREE(&linebuf);
 }
 
 /**
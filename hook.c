@@ -65,18 +65,70 @@ bool C_SaveName; ///< Config: Save outgoing message to mailbox of recipient's na
 struct Hook
 {
   HookFlags type;              ///< Hook type
-  struct Regex regex;          ///< Regular expression
+  struct Regex regex;          ///< Regular expression (compiled on first match)
   char *command;               ///< Filename, command or pattern to execute
   struct PatternList *pattern; ///< Used for fcc,save,send-hook
+  size_t prefix_len;           ///< Literal prefix of an anchored regex, see hook_literal_prefix()
+  bool rx_bad : 1;             ///< Deferred regex compilation failed
   TAILQ_ENTRY(Hook) entries;   ///< Linked list
 };
 TAILQ_HEAD(HookList, Hook);
 
 static struct HookList Hooks = TAILQ_HEAD_INITIALIZER(Hooks);
 
+/// Bumped whenever #Hooks changes; guards caches of hook match results
+static unsigned int HooksGen = 0;
+
+ARRAY_HEAD(HookCmdArray, char *);
+
+/* The commands of the folder-hooks that matched the last (path, desc) pair.
+ * Re-entering the same folder is common (other-folder and back) and with a
+ * big config each visit costs hundreds of regexecs without this.  Commands
+ * are copied, not referenced, so replaying them stays safe even if one of
+ * them modifies the hook list. */
+static struct HookCmdArray FolderHookMemo = ARRAY_HEAD_INITIALIZER;
+static unsigned int FolderHookMemoGen = 0;
+static char *FolderHookMemoPath = NULL;
+static char *FolderHookMemoDesc = NULL;
+static bool FolderHookMemoValid = false;
+
 static struct HashTable *IdxFmtHooks = NULL;
 static HookFlags current_hook_type = MUTT_HOOK_NO_FLAGS;
 
+/**
+ * hook_literal_prefix - Length of the mandatory literal prefix of a regex
+ * @param pat Regex pattern
+ * @retval num Number of literal bytes following the '^' anchor
+ * @retval 0   Pattern is unanchored, or starts with a metacharacter
+ *
+ * A string can only match "^literal..." if it starts with the literal, which
+ * a strncmp() can check far more cheaply than a regexec().  A trailing '*',
+ * '?' or '{' quantifier makes the preceding character optional, so it's
+ * excluded from the prefix.
+ */
+static size_t hook_literal_prefix(const char *pat)
+{
+  if (!pat || (pat[0] != '^'))
+    return 0;
+
+  size_t len = 0;
+  for (const char *p = pat + 1; *p; p++)
+  {
+    if ((*p == '*') || (*p == '?') || (*p == '{'))
+    {
+      if (len > 0)
+        len--;
+      break;
+    }
+    if (*p == '+')
+      break;
+    if (strchr("\\.[]()|$^", *p))
+      break;
+    len++;
+  }
+  return len;
+}
+
 /**
  * mutt_parse_hook - Parse the 'hook' family of commands - Implements Command::parse()
  *
@@ -88,7 +140,6 @@ enum CommandResult mutt_parse_hook(struct Buffer *buf, struct Buffer *s,
   struct Hook *hook = NULL;
   int rc = MUTT_CMD_ERROR;
   bool pat_not = false;
-  regex_t *rx = NULL;
   struct PatternList *pat = NULL;
 
   struct Buffer *cmd = mutt_buffer_pool_get();
@@ -221,6 +272,7 @@ enum CommandResult mutt_parse_hook(struct Buffer *buf, struct Buffer *s,
          * based upon some other information. */
         FREE(&hook->command);
         hook->command = mutt_buffer_strdup(cmd);
+        HooksGen++;
         rc = MUTT_CMD_SUCCESS;
         goto cleanup;
       }
@@ -251,28 +303,22 @@ enum CommandResult mutt_parse_hook(struct Buffer *buf, struct Buffer *s,
     if (!pat)
       goto cleanup;
   }
-  else if (~data & MUTT_GLOBAL_HOOK) /* NOT a global hook */
-  {
-    /* Hooks not allowing full patterns: Check syntax of regex */
-    rx = mutt_mem_malloc(sizeof(regex_t));
-    int rc2 = REG_COMP(rx, NONULL(mutt_b2s(pattern)),
-                       ((data & MUTT_CRYPT_HOOK) ? REG_ICASE : 0));
-    if (rc2 != 0)
-    {
-      regerror(rc2, rx, err->data, err->dsize);
-      FREE(&rx);
-      goto cleanup;
-    }
-  }
+  /* Hooks not allowing full patterns keep a regex instead; it is compiled
+   * lazily by hook_regex_match().  With a large config the regcomp()s were a
+   * measurable part of the startup time, and most hooks never fire.  The cost
+   * is that a broken regex is only reported the first time it's matched. */
 
   hook = mutt_mem_calloc(1, sizeof(struct Hook));
   hook->type = data;
   hook->command = mutt_buffer_strdup(cmd);
   hook->pattern = pat;
   hook->regex.pattern = mutt_buffer_strdup(pattern);
-  hook->regex.regex = rx;
+  hook->regex.regex = NULL;
   hook->regex.pat_not = pat_not;
+  if (!pat && !pat_not && (!WithCrypto || !(data & MUTT_CRYPT_HOOK)))
+    hook->prefix_len = hook_literal_prefix(hook->regex.pattern);
   TAILQ_INSERT_TAIL(&Hooks, hook, entries);
+  HooksGen++;
   rc = MUTT_CMD_SUCCESS;
 
 cleanup:
@@ -315,6 +361,7 @@ void mutt_delete_hooks(HookFlags type)
     {
       TAILQ_REMOVE(&Hooks, h, entries);
       delete_hook(h);
+      HooksGen++;
     }
   }
 }
@@ -496,6 +543,60 @@ enum CommandResult mutt_parse_unhook(struct Buffer *buf, struct Buffer *s,
   return MUTT_CMD_SUCCESS;
 }
 
+/**
+ * hook_regex_match - Match a Hook's regex against a string
+ * @param hook Hook holding the regex
+ * @param str  String to match
+ * @retval true The string matches
+ *
+ * The regex is compiled on first use - see mutt_parse_hook().  If it fails to
+ * compile, the error is reported once and the hook never matches.
+ */
+static bool hook_regex_match(struct Hook *hook, const char *str)
+{
+  /* Cheap rejection: an anchored pattern can't match a string that doesn't
+   * start with its literal prefix.  Most hooks lose here for the price of a
+   * strncmp(), without compiling or executing the regex at all. */
+  if ((hook->prefix_len > 0) && !mutt_strn_equal(str, hook->regex.pattern + 1, hook->prefix_len))
+    return false;
+
+  if (!hook->regex.regex && !hook->pattern)
+  {
+    if (hook->rx_bad)
+      return false;
+
+    regex_t *rx = mutt_mem_malloc(sizeof(regex_t));
+    const int rc = REG_COMP(rx, NONULL(hook->regex.pattern),
+                            ((hook->type & MUTT_CRYPT_HOOK) ? REG_ICASE : 0));
+    if (rc != 0)
+    {
+      char msg[256];
+      regerror(rc, rx, msg, sizeof(msg));
+      mutt_error("%s: %s", hook->regex.pattern, msg);
+      FREE(&rx);
+      hook->rx_bad = true;
+      return false;
+    }
+    hook->regex.regex = rx;
+  }
+
+  return mutt_regex_match(&hook->regex, str);
+}
+
+/**
+ * folder_hook_memo_clear - Invalidate the folder-hook match memo
+ */
+static void folder_hook_memo_clear(void)
+{
+  char **cp = NULL;
+  ARRAY_FOREACH(cp, &FolderHookMemo)
+  {
+    FREE(cp);
+  }
+  ARRAY_SHRINK(&FolderHookMemo, ARRAY_SIZE(&FolderHookMemo));
+  FolderHookMemoValid = false;
+}
+
 /**
  * mutt_folder_hook - Perform a folder hook
  * @param path Path to potentially match
@@ -511,6 +612,31 @@ void mutt_folder_hook(const char *path, const char *desc)
 
   current_hook_type = MUTT_FOLDER_HOOK;
 
+  if (FolderHookMemoValid && (FolderHookMemoGen == HooksGen) &&
+      mutt_str_equal(FolderHookMemoPath, path) && mutt_str_equal(FolderHookMemoDesc, desc))
+  {
+    /* Same folder, same hooks: replay the matches without a single regexec */
+    char **cp = NULL;
+    ARRAY_FOREACH(cp, &FolderHookMemo)
+    {
+      mutt_debug(LL_DEBUG5, "    %s\n", *cp);
+      if (mutt_parse_rc_line(*cp, err) == MUTT_CMD_ERROR)
+      {
+        mutt_error("%s", mutt_b2s(err));
+        break;
+      }
+    }
+    if (FolderHookMemoGen != HooksGen)
+      folder_hook_memo_clear(); /* a command changed the hooks */
+    goto done;
+  }
+
+  folder_hook_memo_clear();
+  mutt_str_replace(&FolderHookMemoPath, path);
+  mutt_str_replace(&FolderHookMemoDesc, desc);
+  FolderHookMemoGen = HooksGen;
+  FolderHookMemoValid = true;
+
   TAILQ_FOREACH(hook, &Hooks, entries)
   {
     if (!hook->command)
@@ -520,22 +646,28 @@ void mutt_folder_hook(const char *path, const char *desc)
       continue;
 
     const char *match = NULL;
-    if (mutt_regex_match(&hook->regex, path))
+    if (hook_regex_match(hook, path))
       match = path;
-    else if (mutt_regex_match(&hook->regex, desc))
+    else if (hook_regex_match(hook, desc))
       match = desc;
 
     if (match)
     {
       mutt_debug(LL_DEBUG1, "folder-hook '%s' matches '%s'\n", hook->regex.pattern, match);
       mutt_debug(LL_DEBUG5, "    %s\n", hook->command);
+      ARRAY_ADD(&FolderHookMemo, mutt_str_dup(hook->command));
       if (mutt_parse_rc_line(hook->command, err) == MUTT_CMD_ERROR)
       {
         mutt_error("%s", mutt_b2s(err));
+        folder_hook_memo_clear(); /* the memo is incomplete */
         break;
       }
     }
   }
+  if (FolderHookMemoGen != HooksGen)
+    folder_hook_memo_clear(); /* a command changed the hooks mid-walk */
+
+done:
   mutt_buffer_pool_release(&err);
 
   current_hook_type = MUTT_HOOK_NO_FLAGS;
@@ -557,7 +689,7 @@ char *mutt_find_hook(HookFlags type, const char *pat)
   {
     if (tmp->type & type)
     {
-      if (mutt_regex_match(&tmp->regex, pat))
+      if (hook_regex_match(tmp, pat))
         return tmp->command;
     }
   }
@@ -729,7 +861,7 @@ static void list_hook(struct ListHead *matches, const char *match, HookFlags hoo
 
   TAILQ_FOREACH(tmp, &Hooks, entries)
   {
-    if ((tmp->type & hook) && mutt_regex_match(&tmp->regex, match))
+    if ((tmp->type & hook) && hook_regex_match(tmp, match))
     {
       mutt_list_insert_tail(matches, mutt_str_dup(tmp->command));
     }
@@ -769,7 +901,7 @@ void mutt_account_hook(const char *url)
     if (!(hook->command && (hook->type & MUTT_ACCOUNT_HOOK)))
       continue;
 
-    if (mutt_regex_match(&hook->regex, url))
+    if (hook_regex_match(hook, url))
     {
       inhook = true;
       mutt_debug(LL_DEBUG1, "account-hook '%s' matches '%s'\n", hook->regex.pattern, url);
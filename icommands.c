@@ -37,19 +37,31 @@
 #include "core/lib.h"
 #include "gui/lib.h"
 #include "mutt.h"
+#ifdef USE_HCACHE
+#include "hcache/lib.h"
+#include "store/lib.h"
+#endif
 #include "icommands.h"
 #include "functions.h"
 #include "init.h"
 #include "keymap.h"
+#include "mutt_logging.h"
 #include "muttlib.h"
+#include "mx.h"
 #include "opcodes.h"
 #include "pager.h"
 #include "version.h"
 
 // clang-format off
-static enum CommandResult icmd_bind   (struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
-static enum CommandResult icmd_set    (struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
-static enum CommandResult icmd_version(struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
+static enum CommandResult icmd_bind        (struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
+static enum CommandResult icmd_check_caches(struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
+static enum CommandResult icmd_set         (struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
+#ifdef USE_HCACHE
+static enum CommandResult icmd_store_bench (struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
+#endif
+static enum CommandResult icmd_stats       (struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
+static enum CommandResult icmd_trace_report(struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
+static enum CommandResult icmd_version     (struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
 
 /**
  * ICommandList - All available informational commands
@@ -57,11 +69,17 @@ static enum CommandResult icmd_version(struct Buffer *buf, struct Buffer *s, int
  * @note These commands take precedence over conventional NeoMutt rc-lines
  */
 const struct ICommand ICommandList[] = {
-  { "bind",     icmd_bind,     0 },
-  { "macro",    icmd_bind,     1 },
-  { "set",      icmd_set,      0 },
-  { "version",  icmd_version,  0 },
-  { NULL,       NULL,          0 },
+  { "bind",         icmd_bind,         0 },
+  { "check-caches", icmd_check_caches, 0 },
+  { "macro",        icmd_bind,         1 },
+  { "set",          icmd_set,          0 },
+#ifdef USE_HCACHE
+  { "store-bench",  icmd_store_bench,  0 },
+#endif
+  { "stats",        icmd_stats,        0 },
+  { "trace-report", icmd_trace_report, 0 },
+  { "version",      icmd_version,      0 },
+  { NULL,           NULL,              0 },
 };
 // clang-format on
 
@@ -300,6 +318,35 @@ static enum CommandResult icmd_bind(struct Buffer *buf, struct Buffer *s,
   return MUTT_CMD_SUCCESS;
 }
 
+/**
+ * icmd_check_caches - Parse 'check-caches' command - Implements ICommand::parse()
+ *
+ * Walk every configured mailbox, opening and closing each one.  This
+ * validates the header cache against the messages, evicts stale records and
+ * parses missing ones, so later interactive opens hit a warm, clean cache.
+ */
+static enum CommandResult icmd_check_caches(struct Buffer *buf, struct Buffer *s,
+                                            intptr_t data, struct Buffer *err)
+{
+  if (MoreArgs(s))
+  {
+    mutt_buffer_printf(err, _("%s: too many arguments"), "check-caches");
+    return MUTT_CMD_ERROR;
+  }
+
+  int failed = 0;
+  const int opened = mx_mbox_warm_all(&failed);
+  if (failed != 0)
+  {
+    mutt_buffer_printf(err, _("%d mailboxes checked, %d could not be opened"),
+                       opened, failed);
+    return MUTT_CMD_WARNING;
+  }
+
+  mutt_message(_("%d mailboxes checked"), opened);
+  return MUTT_CMD_SUCCESS;
+}
+
 /**
  * icmd_set - Parse 'set' command to display config - Implements ICommand::parse()
  */
@@ -334,6 +381,139 @@ static enum CommandResult icmd_set(struct Buffer *buf, struct Buffer *s,
   return MUTT_CMD_SUCCESS;
 }
 
+#ifdef USE_HCACHE
+/**
+ * icmd_store_bench - Parse 'store-bench' command - Implements ICommand::parse()
+ *
+ * Benchmark every compiled store backend on the $header_cache filesystem
+ * and show the report in the pager.
+ */
+static enum CommandResult icmd_store_bench(struct Buffer *buf, struct Buffer *s,
+                                           intptr_t data, struct Buffer *err)
+{
+  if (MoreArgs(s))
+  {
+    mutt_buffer_printf(err, _("%s: too many arguments"), "store-bench");
+    return MUTT_CMD_ERROR;
+  }
+
+  char tempfile[PATH_MAX];
+  mutt_mktemp(tempfile, sizeof(tempfile));
+
+  FILE *fp_out = mutt_file_fopen(tempfile, "w");
+  if (!fp_out)
+  {
+    // L10N: '%s' is the file name of the temporary file
+    mutt_buffer_printf(err, _("Could not create temporary file %s"), tempfile);
+    return MUTT_CMD_ERROR;
+  }
+
+  mutt_message(_("Benchmarking store backends..."));
+  store_benchmark(mutt_hcache_store_dir(), fp_out);
+  mutt_file_fclose(&fp_out);
+  mutt_clear_error();
+
+  if (mutt_do_pager("store-bench", tempfile, MUTT_PAGER_NO_FLAGS, NULL) == -1)
+  {
+    // L10N: '%s' is the file name of the temporary file
+    mutt_buffer_printf(err, _("Could not create temporary file %s"), tempfile);
+    return MUTT_CMD_ERROR;
+  }
+
+  return MUTT_CMD_SUCCESS;
+}
+#endif /* USE_HCACHE */
+
+/**
+ * icmd_stats - Parse 'stats' command - Implements ICommand::parse()
+ *
+ * Shows the event counters collected since startup.  An optional 'clear'
+ * argument zeroes them instead, e.g. to measure just the next operation.
+ */
+static enum CommandResult icmd_stats(struct Buffer *buf, struct Buffer *s,
+                                     intptr_t data, struct Buffer *err)
+{
+  if (MoreArgs(s))
+  {
+    mutt_extract_token(buf, s, MUTT_TOKEN_NO_FLAGS);
+    if (!mutt_istr_equal(buf->data, "clear") || MoreArgs(s))
+    {
+      mutt_buffer_printf(err, _("%s: invalid argument"), "stats");
+      return MUTT_CMD_ERROR;
+    }
+    mutt_stats_clear();
+    return MUTT_CMD_SUCCESS;
+  }
+
+  char tempfile[PATH_MAX];
+  mutt_mktemp(tempfile, sizeof(tempfile));
+
+  FILE *fp_out = mutt_file_fopen(tempfile, "w");
+  if (!fp_out)
+  {
+    // L10N: '%s' is the file name of the temporary file
+    mutt_buffer_printf(err, _("Could not create temporary file %s"), tempfile);
+    return MUTT_CMD_ERROR;
+  }
+
+  mutt_stats_report(fp_out);
+  mutt_file_fclose(&fp_out);
+
+  if (mutt_do_pager("stats", tempfile, MUTT_PAGER_NO_FLAGS, NULL) == -1)
+  {
+    // L10N: '%s' is the file name of the temporary file
+    mutt_buffer_printf(err, _("Could not create temporary file %s"), tempfile);
+    return MUTT_CMD_ERROR;
+  }
+
+  return MUTT_CMD_SUCCESS;
+}
+
+/**
+ * icmd_trace_report - Parse 'trace-report' command - Implements ICommand::parse()
+ *
+ * Shows the spans recorded while `$trace_spans` was set.  An optional 'clear'
+ * argument discards the recorded data instead.
+ */
+static enum CommandResult icmd_trace_report(struct Buffer *buf, struct Buffer *s,
+                                            intptr_t data, struct Buffer *err)
+{
+  if (MoreArgs(s))
+  {
+    mutt_extract_token(buf, s, MUTT_TOKEN_NO_FLAGS);
+    if (!mutt_istr_equal(buf->data, "clear") || MoreArgs(s))
+    {
+      mutt_buffer_printf(err, _("%s: invalid argument"), "trace-report");
+      return MUTT_CMD_ERROR;
+    }
+    mutt_trace_clear();
+    return MUTT_CMD_SUCCESS;
+  }
+
+  char tempfile[PATH_MAX];
+  mutt_mktemp(tempfile, sizeof(tempfile));
+
+  FILE *fp_out = mutt_file_fopen(tempfile, "w");
+  if (!fp_out)
+  {
+    // L10N: '%s' is the file name of the temporary file
+    mutt_buffer_printf(err, _("Could not create temporary file %s"), tempfile);
+    return MUTT_CMD_ERROR;
+  }
+
+  mutt_trace_report(fp_out);
+  mutt_file_fclose(&fp_out);
+
+  if (mutt_do_pager("trace-report", tempfile, MUTT_PAGER_NO_FLAGS, NULL) == -1)
+  {
+    // L10N: '%s' is the file name of the temporary file
+    mutt_buffer_printf(err, _("Could not create temporary file %s"), tempfile);
+    return MUTT_CMD_ERROR;
+  }
+
+  return MUTT_CMD_SUCCESS;
+}
+
 /**
  * icmd_version - Parse 'version' command - Implements ICommand::parse()
  */
@@ -106,6 +106,30 @@ int imap_authenticate(struct ImapAccountData *adata)
 {
   int rc = IMAP_AUTH_FAILURE;
 
+  /* On reconnect, lead with the method that authenticated us last time.
+   * Walking the list from the top costs a refused exchange per wrong
+   * mechanism - with Kerberos involved that's easily half a second of
+   * server round trips per connection. */
+  if (adata->auth_method)
+  {
+    mutt_debug(LL_DEBUG2, "Retrying last successful method %s\n", adata->auth_method);
+
+    for (size_t i = 0; i < mutt_array_size(imap_authenticators); i++)
+    {
+      const struct ImapAuth *auth = &imap_authenticators[i];
+      if (!auth->method || mutt_istr_equal(auth->method, adata->auth_method))
+      {
+        rc = auth->authenticate(adata, adata->auth_method);
+        if (rc == IMAP_AUTH_SUCCESS)
+          return rc;
+      }
+    }
+
+    /* it stopped working (server reconfigured, ticket expired) - forget it
+     * and run the normal scan below */
+    FREE(&adata->auth_method);
+  }
+
   if (C_ImapAuthenticators && (C_ImapAuthenticators->count > 0))
   {
     mutt_debug(LL_DEBUG2, "Trying user-defined imap_authenticators\n");
@@ -124,6 +148,7 @@ int imap_authenticate(struct ImapAccountData *adata)
           rc = auth->authenticate(adata, np->data);
           if (rc == IMAP_AUTH_SUCCESS)
           {
+            mutt_str_replace(&adata->auth_method, np->data);
             return rc;
           }
         }
@@ -139,7 +164,13 @@ int imap_authenticate(struct ImapAccountData *adata)
     {
       rc = imap_authenticators[i].authenticate(adata, NULL);
       if (rc == IMAP_AUTH_SUCCESS)
+      {
+        /* the SASL multiplexor picks its own mechanism (method is NULL), so
+         * there is no single name to come back to */
+        if (imap_authenticators[i].method)
+          mutt_str_replace(&adata->auth_method, imap_authenticators[i].method);
         return rc;
+      }
     }
   }
 
@@ -55,6 +55,8 @@
 
 #define IMAP_CMD_BUFSIZE 512
 
+static void cmd_handle_fatal(struct ImapAccountData *adata);
+
 /**
  * Capabilities - Server capabilities strings that we understand
  *
@@ -132,17 +134,38 @@ static struct ImapCommand *cmd_new(struct ImapAccountData *adata)
  * @retval  0 Success
  * @retval <0 Failure, e.g. #IMAP_RES_BAD
  *
- * If the queue is full, attempts to drain it.
+ * If the queue is full, reads responses until a slot frees up.  The rest of
+ * the window stays in flight, so a long run of queued commands (e.g. the
+ * STOREs of a large flag sync) keeps the server busy instead of stalling for
+ * a full round trip every $imap_pipeline_depth commands.
  */
 static int cmd_queue(struct ImapAccountData *adata, const char *cmdstr, ImapCmdFlags flags)
 {
   if (cmd_queue_full(adata))
   {
-    mutt_debug(LL_DEBUG3, "Draining IMAP command pipeline\n");
+    mutt_debug(LL_DEBUG3, "IMAP command pipeline full, waiting for a free slot\n");
+
+    /* flush the buffered commands so the server starts on them */
+    if (!mutt_buffer_is_empty(&adata->cmdbuf) && (imap_cmd_start(adata, NULL) < 0))
+      return IMAP_RES_BAD;
+
+    if ((flags & IMAP_CMD_POLL) && (C_ImapPollTimeout > 0) &&
+        (mutt_socket_poll(adata->conn, C_ImapPollTimeout) == 0))
+    {
+      mutt_error(_("Connection to %s timed out"), adata->conn->account.host);
+      cmd_handle_fatal(adata);
+      return IMAP_RES_BAD;
+    }
 
-    const int rc = imap_exec(adata, NULL, flags & IMAP_CMD_POLL);
+    int rc;
+    mutt_sig_allow_interrupt(true);
+    do
+    {
+      rc = imap_cmd_step(adata);
+    } while ((rc == IMAP_RES_CONTINUE) && cmd_queue_full(adata));
+    mutt_sig_allow_interrupt(false);
 
-    if (rc == IMAP_EXEC_ERROR)
+    if ((rc == IMAP_RES_NO) || (rc == IMAP_RES_BAD))
       return IMAP_RES_BAD;
   }
 
@@ -215,6 +238,7 @@ static int cmd_start(struct ImapAccountData *adata, const char *cmdstr, ImapCmdF
   if (mutt_buffer_is_empty(&adata->cmdbuf))
     return IMAP_RES_BAD;
 
+  mutt_stats_count("imap/command", 1);
   rc = mutt_socket_send_d(adata->conn, adata->cmdbuf.data,
                           (flags & IMAP_CMD_PASS) ? IMAP_LOG_PASS : IMAP_LOG_CMD);
   mutt_buffer_reset(&adata->cmdbuf);
@@ -277,16 +301,9 @@ static void cmd_parse_expunge(struct ImapAccountData *adata, const char *s)
     imap_edata_get(e)->msn = 0;
   }
 
-  /* decrement seqno of those above. */
-  const size_t max_msn = imap_msn_highest(&mdata->msn);
-  for (unsigned int cur = exp_msn; cur < max_msn; cur++)
-  {
-    e = imap_msn_get(&mdata->msn, cur);
-    if (e)
-      imap_edata_get(e)->msn--;
-    imap_msn_set(&mdata->msn, cur - 1, e);
-  }
-  imap_msn_shrink(&mdata->msn, 1);
+  /* Renumbering the messages above is deferred until the storm is over;
+   * imap_cmd_step() flushes once the command completes. */
+  imap_msn_expunge(&mdata->msn, exp_msn - 1);
 
   mdata->reopen |= IMAP_EXPUNGE_PENDING;
 }
@@ -347,33 +364,23 @@ static void cmd_parse_vanished(struct ImapAccountData *adata, char *s)
     e->index = INT_MAX;
     imap_edata_get(e)->msn = 0;
 
-    if ((exp_msn < 1) || (exp_msn > imap_msn_highest(&mdata->msn)))
+    /* The stored msn predates any expunges still pending in the cache */
+    const size_t cur_msn = imap_msn_current(&mdata->msn, exp_msn);
+    if (cur_msn == 0)
     {
       mutt_debug(LL_DEBUG1, "VANISHED: msn for UID %u is incorrect\n", uid);
       continue;
     }
-    if (imap_msn_get(&mdata->msn, exp_msn - 1) != e)
+    if (imap_msn_get(&mdata->msn, cur_msn - 1) != e)
     {
       mutt_debug(LL_DEBUG1, "VANISHED: msn_index for UID %u is incorrect\n", uid);
       continue;
     }
 
-    imap_msn_remove(&mdata->msn, exp_msn - 1);
-
-    if (!earlier)
-    {
-      /* decrement seqno of those above. */
-      const size_t max_msn = imap_msn_highest(&mdata->msn);
-      for (unsigned int cur = exp_msn; cur < max_msn; cur++)
-      {
-        e = imap_msn_get(&mdata->msn, cur);
-        if (e)
-          imap_edata_get(e)->msn--;
-        imap_msn_set(&mdata->msn, cur - 1, e);
-      }
-
-      imap_msn_shrink(&mdata->msn, 1);
-    }
+    if (earlier)
+      imap_msn_remove(&mdata->msn, cur_msn - 1);
+    else
+      imap_msn_expunge(&mdata->msn, cur_msn - 1);
   }
 
   if (rc < 0)
@@ -1182,6 +1189,14 @@ int imap_cmd_step(struct ImapAccountData *adata)
     imap_cmd_finish(adata);
   }
 
+  /* An EXPUNGE storm defers renumbering the msn cache; settle it before
+   * anyone outside the response parser looks at a sequence number */
+  if ((rc != IMAP_RES_CONTINUE) && adata->mailbox && adata->mailbox->mdata)
+  {
+    struct ImapMboxData *mdata = adata->mailbox->mdata;
+    imap_msn_flush(&mdata->msn);
+  }
+
   return rc;
 }
 
@@ -1260,11 +1275,15 @@ int imap_exec(struct ImapAccountData *adata, const char *cmdstr, ImapCmdFlags fl
   if (flags & IMAP_CMD_QUEUE)
     return IMAP_EXEC_SUCCESS;
 
+  /* The command has been sent; time the wait for the server's response */
+  const int span = mutt_trace_start("imap_exec");
+
   if ((flags & IMAP_CMD_POLL) && (C_ImapPollTimeout > 0) &&
       ((mutt_socket_poll(adata->conn, C_ImapPollTimeout)) == 0))
   {
     mutt_error(_("Connection to %s timed out"), adata->conn->account.host);
     cmd_handle_fatal(adata);
+    mutt_trace_end(span);
     return IMAP_EXEC_FATAL;
   }
 
@@ -1278,6 +1297,7 @@ int imap_exec(struct ImapAccountData *adata, const char *cmdstr, ImapCmdFlags fl
       break;
   } while (rc == IMAP_RES_CONTINUE);
   mutt_sig_allow_interrupt(false);
+  mutt_trace_end(span);
 
   if (rc == IMAP_RES_NO)
     return IMAP_EXEC_ERROR;
@@ -43,6 +43,7 @@ bool          C_ImapCondstore;           ///< Config: (imap) Enable the CONDSTOR
 bool          C_ImapDeflate;             ///< Config: (imap) Compress network traffic
 #endif
 char *        C_ImapDelimChars;          ///< Config: (imap) Characters that denote separators in IMAP folders
+bool          C_ImapFetchChunkAdaptive;  ///< Config: (imap) Adjust the header download block size to the link speed
 long          C_ImapFetchChunkSize;      ///< Config: (imap) Download headers in blocks of this size
 char *        C_ImapHeaders;             ///< Config: (imap) Additional email headers to download when getting index
 bool          C_ImapIdle;                ///< Config: (imap) Use the IMAP IDLE extension to check for new mail
@@ -54,6 +55,7 @@ char *        C_ImapPass;                ///< Config: (imap) Password for the IM
 bool          C_ImapPassive;             ///< Config: (imap) Reuse an existing IMAP connection to check for new mail
 bool          C_ImapPeek;                ///< Config: (imap) Don't mark messages as read when fetching them from the server
 short         C_ImapPipelineDepth;       ///< Config: (imap) Number of IMAP commands that may be queued up
+short         C_ImapPrefetch;            ///< Config: (imap) Fetch this many following messages into the cache when opening one
 short         C_ImapPollTimeout;         ///< Config: (imap) Maximum time to wait for a server response
 bool          C_ImapQresync;             ///< Config: (imap) Enable the QRESYNC extension
 bool          C_ImapRfc5161;             ///< Config: (imap) Use the IMAP ENABLE extension to select capabilities
@@ -107,6 +109,9 @@ struct ConfigDef ImapVars[] = {
   { "imap_delim_chars", DT_STRING, &C_ImapDelimChars, IP "/.", 0, NULL,
     "(imap) Characters that denote separators in IMAP folders"
   },
+  { "imap_fetch_chunk_adaptive", DT_BOOL, &C_ImapFetchChunkAdaptive, true, 0, NULL,
+    "(imap) Adjust the header download block size to the measured link speed"
+  },
   { "imap_fetch_chunk_size", DT_LONG|DT_NOT_NEGATIVE, &C_ImapFetchChunkSize, 0, 0, NULL,
     "(imap) Download headers in blocks of this size"
   },
@@ -149,6 +154,9 @@ struct ConfigDef ImapVars[] = {
   { "imap_poll_timeout", DT_NUMBER|DT_NOT_NEGATIVE, &C_ImapPollTimeout, 15, 0, NULL,
     "(imap) Maximum time to wait for a server response"
   },
+  { "imap_prefetch", DT_NUMBER|DT_NOT_NEGATIVE, &C_ImapPrefetch, 0, 0, NULL,
+    "(imap) Fetch this many following messages into the cache when opening one"
+  },
   { "imap_qresync", DT_BOOL, &C_ImapQresync, false, 0, NULL,
     "(imap) Enable the QRESYNC extension"
   },
@@ -57,6 +57,7 @@
 #include "mutt_logging.h"
 #include "mutt_socket.h"
 #include "muttlib.h"
+#include "uidset.h"
 #include "mx.h"
 #include "progress.h"
 #include "sort.h"
@@ -178,31 +179,26 @@ static void set_flag(struct Mailbox *m, AclFlags aclflag, int flag,
 }
 
 /**
- * make_msg_set - Make a message set
+ * make_msg_set - Collect the UIDs of all matching messages
  * @param[in]  m       Selected Imap Mailbox
- * @param[in]  buf     Buffer to store message set
+ * @param[in]  uidset  Set to collect the matching UIDs into
  * @param[in]  flag    Flags to match, e.g. #MUTT_DELETED
  * @param[in]  changed Matched messages that have been altered
  * @param[in]  invert  Flag matches should be inverted
- * @param[out] pos     Cursor used for multiple calls to this function
  * @retval num Messages in the set
  *
- * @note Headers must be in #SORT_ORDER. See imap_exec_msgset() for args.
- * Pos is an opaque pointer a la strtok(). It should be 0 at first call.
+ * See imap_exec_msgset() for args.  The UID set keeps itself sorted, so the
+ * Mailbox may be in any sort order.  Runs are merged across the UIDs of
+ * non-matching messages afterwards, so a block of matches with gappy UIDs
+ * still compresses into a single first:last range.
  */
-static int make_msg_set(struct Mailbox *m, struct Buffer *buf, int flag,
-                        bool changed, bool invert, int *pos)
+static int make_msg_set(struct Mailbox *m, struct UidSet *uidset, int flag,
+                        bool changed, bool invert)
 {
-  int count = 0;             /* number of messages in message set */
-  unsigned int setstart = 0; /* start of current message range */
-  int n;
-  bool started = false;
+  int count = 0; /* number of messages in message set */
+  struct UidSet blocked = ARRAY_HEAD_INITIALIZER;
 
-  struct ImapAccountData *adata = imap_adata_get(m);
-  if (!adata || (adata->mailbox != m))
-    return -1;
-
-  for (n = *pos; (n < m->msg_count) && (mutt_buffer_len(buf) < IMAP_MAX_CMDLEN); n++)
+  for (int n = 0; n < m->msg_count; n++)
   {
     struct Email *e = m->emails[n];
     if (!e)
@@ -250,34 +246,14 @@ static int make_msg_set(struct Mailbox *m, struct Buffer *buf, int flag,
     if (match && (!changed || e->changed))
     {
       count++;
-      if (setstart == 0)
-      {
-        setstart = imap_edata_get(e)->uid;
-        if (started)
-        {
-          mutt_buffer_add_printf(buf, ",%u", imap_edata_get(e)->uid);
-        }
-        else
-        {
-          mutt_buffer_add_printf(buf, "%u", imap_edata_get(e)->uid);
-          started = true;
-        }
-      }
-      /* tie up if the last message also matches */
-      else if (n == (m->msg_count - 1))
-        mutt_buffer_add_printf(buf, ":%u", imap_edata_get(e)->uid);
-    }
-    /* End current set if message doesn't match or we've reached the end
-     * of the mailbox via inactive messages following the last match. */
-    else if (setstart && (e->active || (n == adata->mailbox->msg_count - 1)))
-    {
-      if (imap_edata_get(m->emails[n - 1])->uid > setstart)
-        mutt_buffer_add_printf(buf, ":%u", imap_edata_get(m->emails[n - 1])->uid);
-      setstart = 0;
+      imap_uidset_add(uidset, imap_edata_get(e)->uid);
     }
+    else
+      imap_uidset_add(&blocked, imap_edata_get(e)->uid);
   }
 
-  *pos = n;
+  imap_uidset_coalesce(uidset, &blocked);
+  imap_uidset_free(&blocked);
 
   return count;
 }
@@ -573,25 +549,88 @@ void imap_logout_all(void)
   }
 }
 
+/**
+ * imap_sweep_connections - Service every open IMAP connection once
+ *
+ * Two passes over the open connections.  The first flushes each account's
+ * queued commands (e.g. the STATUS requests piled up by a mailbox check), so
+ * every server starts working on its backlog at the same time.  The second
+ * reads whatever replies have already arrived, without blocking: anything
+ * still in flight is picked up by the next sweep, at worst one check interval
+ * later.
+ *
+ * Without this, a non-selected account's queue only drained when its next
+ * foreground command happened to run, and accounts were serviced one blocking
+ * round trip at a time.  Untagged IDLE notifications from background accounts
+ * are drained here too, instead of waiting for the connection to be selected.
+ */
+void imap_sweep_connections(void)
+{
+  struct Account *np = NULL;
+  TAILQ_FOREACH(np, &NeoMutt->accounts, entries)
+  {
+    if (np->type != MUTT_IMAP)
+      continue;
+
+    struct ImapAccountData *adata = np->adata;
+    if (!adata || (adata->status == IMAP_FATAL) || (adata->state < IMAP_AUTHENTICATED))
+      continue;
+    if (!adata->conn || (adata->conn->fd < 0))
+      continue;
+
+    /* An idling connection keeps its "DONE" buffered; flushing that would
+     * knock it out of IDLE for no reason. */
+    if ((adata->state != IMAP_IDLE) && !mutt_buffer_is_empty(&adata->cmdbuf))
+      imap_cmd_start(adata, NULL);
+  }
+
+  TAILQ_FOREACH(np, &NeoMutt->accounts, entries)
+  {
+    if (np->type != MUTT_IMAP)
+      continue;
+
+    struct ImapAccountData *adata = np->adata;
+    if (!adata || (adata->status == IMAP_FATAL) || (adata->state < IMAP_AUTHENTICATED))
+      continue;
+    if (!adata->conn || (adata->conn->fd < 0))
+      continue;
+
+    while (mutt_socket_poll(adata->conn, 0) > 0)
+    {
+      /* A tagged NO just fails that command; only a dead connection stops
+       * the drain. */
+      if ((imap_cmd_step(adata) == IMAP_RES_BAD) || (adata->status == IMAP_FATAL))
+        break;
+    }
+  }
+}
+
 /**
  * imap_read_literal - Read bytes bytes from server into file
  * @param fp    File handle for email file
  * @param adata Imap Account data
  * @param bytes Number of bytes to read
  * @param pbar  Progress bar
+ * @param state Resume state to update, or NULL
  * @retval  0 Success
  * @retval -1 Failure
  *
- * Not explicitly buffered, relies on FILE buffering.
+ * The literal is read in blocks via mutt_socket_read_exact(), rather than a
+ * character at a time.
+ *
+ * If @a state is given, it seeds the `\r`-stripping carry (for a download
+ * continued with a partial FETCH) and is updated with the number of raw
+ * octets consumed, even on failure, so the caller can resume later.
  *
  * @note Strips `\r` from `\r\n`.
  *       Apparently even literals use `\r\n`-terminated strings ?!
  */
 int imap_read_literal(FILE *fp, struct ImapAccountData *adata,
-                      unsigned long bytes, struct Progress *pbar)
+                      unsigned long bytes, struct Progress *pbar,
+                      struct ImapLiteralState *state)
 {
-  char c;
-  bool r = false;
+  char chunk[8192];
+  bool r = state ? state->pending_cr : false;
   struct Buffer buf = { 0 }; // Do not allocate, maybe it won't be used
 
   if (C_DebugLevel >= IMAP_LOG_LTRL)
@@ -599,34 +638,56 @@ int imap_read_literal(FILE *fp, struct ImapAccountData *adata,
 
   mutt_debug(LL_DEBUG2, "reading %ld bytes\n", bytes);
 
-  for (unsigned long pos = 0; pos < bytes; pos++)
+  for (unsigned long pos = 0; pos < bytes;)
   {
-    if (mutt_socket_readchar(adata->conn, &c) != 1)
+    const size_t n = MIN(sizeof(chunk), bytes - pos);
+    if (mutt_socket_read_exact(adata->conn, chunk, n) < 0)
     {
       mutt_debug(LL_DEBUG1, "error during read, %ld bytes read\n", pos);
       adata->status = IMAP_FATAL;
 
+      if (state)
+      {
+        state->raw += pos;
+        state->pending_cr = r;
+      }
       mutt_buffer_dealloc(&buf);
       return -1;
     }
 
-    if (r && (c != '\n'))
-      fputc('\r', fp);
-
-    if (c == '\r')
+    /* strip \r from \r\n; a pending \r may span a block boundary */
+    const char *p = chunk;
+    const char *end = chunk + n;
+    while (p < end)
     {
-      r = true;
-      continue;
-    }
-    else
+      if (r && (*p != '\n'))
+      {
+        fputc('\r', fp);
+        if (C_DebugLevel >= IMAP_LOG_LTRL)
+          mutt_buffer_addch(&buf, '\r');
+      }
       r = false;
 
-    fputc(c, fp);
+      const char *cr = memchr(p, '\r', end - p);
+      const size_t run = cr ? (size_t) (cr - p) : (size_t) (end - p);
+      fwrite(p, 1, run, fp);
+      if (C_DebugLevel >= IMAP_LOG_LTRL)
+        mutt_buffer_addstr_n(&buf, p, run);
+      if (!cr)
+        break;
+      r = true;
+      p = cr + 1;
+    }
 
-    if (pbar && !(pos % 1024))
+    pos += n;
+    if (pbar)
       mutt_progress_update(pbar, pos, -1);
-    if (C_DebugLevel >= IMAP_LOG_LTRL)
-      mutt_buffer_addch(&buf, c);
+  }
+
+  if (state)
+  {
+    state->raw += bytes;
+    state->pending_cr = r;
   }
 
   if (C_DebugLevel >= IMAP_LOG_LTRL)
@@ -882,17 +943,6 @@ bool imap_has_flag(struct ListHead *flag_list, const char *flag)
   return false;
 }
 
-/**
- * compare_uid - Compare two Emails by UID - Implements ::sort_t
- */
-static int compare_uid(const void *a, const void *b)
-{
-  const struct Email *ea = *(struct Email const *const *) a;
-  const struct Email *eb = *(struct Email const *const *) b;
-  return imap_edata_get((struct Email *) ea)->uid -
-         imap_edata_get((struct Email *) eb)->uid;
-}
-
 /**
  * imap_exec_msgset - Prepare commands for all messages matching conditions
  * @param m       Selected Imap Mailbox
@@ -915,58 +965,29 @@ int imap_exec_msgset(struct Mailbox *m, const char *pre, const char *post,
   if (!adata || (adata->mailbox != m))
     return -1;
 
-  struct Email **emails = NULL;
-  short oldsort;
-  int pos;
-  int rc;
-  int count = 0;
-
+  struct UidSet uidset = ARRAY_HEAD_INITIALIZER;
   struct Buffer cmd = mutt_buffer_make(0);
+  size_t pos = 0;
+  int rc;
 
-  /* We make a copy of the headers just in case resorting doesn't give
-   exactly the original order (duplicate messages?), because other parts of
-   the ctx are tied to the header order. This may be overkill. */
-  oldsort = C_Sort;
-  if (C_Sort != SORT_ORDER)
-  {
-    emails = m->emails;
-    // We overcommit here, just in case new mail arrives whilst we're sync-ing
-    m->emails = mutt_mem_malloc(m->email_max * sizeof(struct Email *));
-    memcpy(m->emails, emails, m->email_max * sizeof(struct Email *));
-
-    C_Sort = SORT_ORDER;
-    qsort(m->emails, m->msg_count, sizeof(struct Email *), compare_uid);
-  }
-
-  pos = 0;
+  rc = make_msg_set(m, &uidset, flag, changed, invert);
 
-  do
+  while (rc > 0)
   {
     mutt_buffer_reset(&cmd);
     mutt_buffer_add_printf(&cmd, "%s ", pre);
-    rc = make_msg_set(m, &cmd, flag, changed, invert, &pos);
-    if (rc > 0)
+    if (imap_uidset_emit(&uidset, &pos, &cmd, IMAP_MAX_CMDLEN) == 0)
+      break;
+    mutt_buffer_add_printf(&cmd, " %s", post);
+    if (imap_exec(adata, cmd.data, IMAP_CMD_QUEUE) != IMAP_EXEC_SUCCESS)
     {
-      mutt_buffer_add_printf(&cmd, " %s", post);
-      if (imap_exec(adata, cmd.data, IMAP_CMD_QUEUE) != IMAP_EXEC_SUCCESS)
-      {
-        rc = -1;
-        goto out;
-      }
-      count += rc;
+      rc = -1;
+      break;
     }
-  } while (rc > 0);
-
-  rc = count;
+  }
 
-out:
   mutt_buffer_dealloc(&cmd);
-  if (oldsort != C_Sort)
-  {
-    C_Sort = oldsort;
-    FREE(&m->emails);
-    m->emails = emails;
-  }
+  imap_uidset_free(&uidset);
 
   return rc;
 }
@@ -1508,8 +1529,6 @@ int imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close)
   if (!m)
     return -1;
 
-  struct Email **emails = NULL;
-  int oldsort;
   int rc;
   int check;
 
@@ -1614,18 +1633,7 @@ int imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close)
   imap_hcache_close(mdata);
 #endif
 
-  /* presort here to avoid doing 10 resorts in imap_exec_msgset */
-  oldsort = C_Sort;
-  if (C_Sort != SORT_ORDER)
-  {
-    emails = m->emails;
-    m->emails = mutt_mem_malloc(m->msg_count * sizeof(struct Email *));
-    memcpy(m->emails, emails, m->msg_count * sizeof(struct Email *));
-
-    C_Sort = SORT_ORDER;
-    qsort(m->emails, m->msg_count, sizeof(struct Email *), mutt_get_sort_func(SORT_ORDER));
-  }
-
+  /* no presort needed: imap_exec_msgset keeps its UID set sorted itself */
   rc = sync_helper(m, MUTT_ACL_DELETE, MUTT_DELETED, "\\Deleted");
   if (rc >= 0)
     rc |= sync_helper(m, MUTT_ACL_WRITE, MUTT_FLAG, "\\Flagged");
@@ -1636,13 +1644,6 @@ int imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close)
   if (rc >= 0)
     rc |= sync_helper(m, MUTT_ACL_WRITE, MUTT_REPLIED, "\\Answered");
 
-  if (oldsort != C_Sort)
-  {
-    C_Sort = oldsort;
-    FREE(&m->emails);
-    m->emails = emails;
-  }
-
   /* Flush the queued flags if any were changed in sync_helper. */
   if (rc > 0)
     if (imap_exec(adata, NULL, IMAP_CMD_NO_FLAGS) != IMAP_EXEC_SUCCESS)
@@ -2464,6 +2465,7 @@ struct MxOps MxImapOps = {
   .msg_open_new     = imap_msg_open_new,
   .msg_commit       = imap_msg_commit,
   .msg_close        = imap_msg_close,
+  .msg_prefetch     = imap_msg_prefetch,
   .msg_padding_size = NULL,
   .msg_save_hcache  = imap_msg_save_hcache,
   .tags_edit        = imap_tags_edit,
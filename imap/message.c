@@ -66,6 +66,12 @@
 
 struct BodyCache;
 
+/* Adaptive header-fetch chunking - see imap_fetch_chunk_adapt() */
+#define IMAP_FETCH_CHUNK_INITIAL 128   ///< Headers in the first FETCH
+#define IMAP_FETCH_CHUNK_MIN 32        ///< Never shrink a FETCH below this
+#define IMAP_FETCH_CHUNK_MAX 65536     ///< Never grow a FETCH beyond this
+#define IMAP_FETCH_CHUNK_TARGET_MS 2000 ///< Aim for this much wall-clock per FETCH
+
 /**
  * imap_edata_free - Free the private Email data - Implements Email::edata_free()
  */
@@ -192,6 +198,103 @@ static int msg_cache_commit(struct Mailbox *m, struct Email *e)
   return mutt_bcache_commit(mdata->bcache, id);
 }
 
+/**
+ * msg_cache_resume_save - Record the progress of an interrupted download
+ * @param m        Selected Imap Mailbox
+ * @param e        Email
+ * @param raw      Raw literal octets already fetched
+ * @param stripped Bytes actually written to the cache file (after CR-stripping)
+ * @param pending_cr A '\\r' was held back at the point of interruption
+ *
+ * The partial data stays in the body cache's uncommitted file; this sidecar
+ * lets the next imap_msg_open() continue it with a partial FETCH.
+ */
+static void msg_cache_resume_save(struct Mailbox *m, struct Email *e,
+                                  unsigned long raw, unsigned long stripped, bool pending_cr)
+{
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+  if (!mdata || !mdata->bcache)
+    return;
+
+  char id[64];
+  snprintf(id, sizeof(id), "%u-%u.resume", mdata->uidvalidity, imap_edata_get(e)->uid);
+
+  FILE *fp = mutt_bcache_put(mdata->bcache, id);
+  if (!fp)
+    return;
+  fprintf(fp, "%lu %lu %d\n", raw, stripped, pending_cr ? 1 : 0);
+  mutt_file_fclose(&fp);
+  mutt_bcache_commit(mdata->bcache, id);
+}
+
+/**
+ * msg_cache_resume_clear - Drop the download-resume record for an email
+ * @param m Selected Imap Mailbox
+ * @param e Email
+ */
+static void msg_cache_resume_clear(struct Mailbox *m, struct Email *e)
+{
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+  if (!mdata || !mdata->bcache)
+    return;
+
+  char id[64];
+  snprintf(id, sizeof(id), "%u-%u.resume", mdata->uidvalidity, imap_edata_get(e)->uid);
+  mutt_bcache_del(mdata->bcache, id);
+}
+
+/**
+ * msg_cache_resume - Reopen a partial download for continuation
+ * @param[in]  m     Selected Imap Mailbox
+ * @param[in]  e     Email
+ * @param[out] state Resume state for imap_read_literal()
+ * @retval ptr  Partial cache file, positioned at its end
+ * @retval NULL No usable partial download exists
+ *
+ * The recorded stripped length doubles as an integrity check: if the
+ * uncommitted file doesn't match it, the partial data is untrustworthy and
+ * the download starts over.
+ */
+static FILE *msg_cache_resume(struct Mailbox *m, struct Email *e, struct ImapLiteralState *state)
+{
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+  if (!mdata || !mdata->bcache)
+    return NULL;
+
+  char id[64];
+  snprintf(id, sizeof(id), "%u-%u.resume", mdata->uidvalidity, imap_edata_get(e)->uid);
+
+  FILE *fp_meta = mutt_bcache_get(mdata->bcache, id);
+  if (!fp_meta)
+    return NULL;
+
+  unsigned long raw = 0, stripped = 0;
+  int pending_cr = 0;
+  const int fields = fscanf(fp_meta, "%lu %lu %d", &raw, &stripped, &pending_cr);
+  mutt_file_fclose(&fp_meta);
+
+  FILE *fp = NULL;
+  if ((fields == 3) && (raw > 0))
+  {
+    snprintf(id, sizeof(id), "%u-%u", mdata->uidvalidity, imap_edata_get(e)->uid);
+    fp = mutt_bcache_append(mdata->bcache, id);
+    if (fp && ((unsigned long) ftell(fp) != stripped))
+      mutt_file_fclose(&fp); /* doesn't match the record - start over */
+  }
+
+  if (fp)
+  {
+    mutt_debug(LL_DEBUG2, "resuming fetch of uid %u at octet %lu\n",
+               imap_edata_get(e)->uid, raw);
+    state->raw = raw;
+    state->pending_cr = pending_cr;
+  }
+  else
+    msg_cache_resume_clear(m, e);
+
+  return fp;
+}
+
 /**
  * msg_cache_clean_cb - Delete an entry from the message cache - Implements ::bcache_list_t
  * @retval 0 Always
@@ -469,7 +572,7 @@ static int msg_fetch_header(struct Mailbox *m, struct ImapHeader *ih, char *buf,
   unsigned int bytes = 0;
   if (imap_get_literal_count(buf, &bytes) == 0)
   {
-    imap_read_literal(fp, adata, bytes, NULL);
+    imap_read_literal(fp, adata, bytes, NULL, NULL);
 
     /* we may have other fields of the FETCH _after_ the literal
      * (eg Domino puts FLAGS here). Nothing wrong with that, either.
@@ -544,6 +647,71 @@ static void imap_alloc_uid_hash(struct ImapAccountData *adata, unsigned int msn_
     mdata->uid_hash = mutt_hash_int_new(MAX(6 * msn_count / 5, 30), MUTT_HASH_NO_FLAGS);
 }
 
+/**
+ * imap_fetch_chunk_init - Pick the number of headers for the first FETCH
+ * @retval num Headers to request per FETCH
+ *
+ * With adaptive chunking, the first request is deliberately modest: it
+ * completes quickly even over a slow link and gives us a throughput sample
+ * to size the following chunks with.
+ */
+static unsigned int imap_fetch_chunk_init(void)
+{
+  if (!C_ImapFetchChunkAdaptive)
+    return (C_ImapFetchChunkSize > 0) ? C_ImapFetchChunkSize : UINT_MAX;
+
+  unsigned int chunk = IMAP_FETCH_CHUNK_INITIAL;
+  if ((C_ImapFetchChunkSize > 0) && (chunk > C_ImapFetchChunkSize))
+    chunk = C_ImapFetchChunkSize;
+  return chunk;
+}
+
+/**
+ * imap_fetch_chunk_adapt - Resize the FETCH chunk from the last chunk's timing
+ * @param chunk      Current headers-per-FETCH
+ * @param fetched    Headers the last FETCH actually returned
+ * @param elapsed_ms Wall-clock time the last FETCH took
+ * @retval num Headers to request in the next FETCH
+ *
+ * Aim each chunk at roughly #IMAP_FETCH_CHUNK_TARGET_MS of wall-clock time:
+ * a fast LAN quickly grows towards one large pipelined request, while a slow
+ * link shrinks until progress updates stay responsive.  Growth and shrinkage
+ * are limited to 4x per step so one outlier (a GC pause, a huge header) can't
+ * whipsaw the size.  `$imap_fetch_chunk_size` still acts as a hard ceiling.
+ */
+static unsigned int imap_fetch_chunk_adapt(unsigned int chunk,
+                                           unsigned int fetched, uint64_t elapsed_ms)
+{
+  if (!C_ImapFetchChunkAdaptive || (fetched == 0))
+    return chunk;
+
+  if (elapsed_ms == 0)
+    elapsed_ms = 1;
+
+  uint64_t want = ((uint64_t) fetched * IMAP_FETCH_CHUNK_TARGET_MS) / elapsed_ms;
+
+  /* dampen: at most 4x growth or shrinkage per chunk */
+  if (want > (uint64_t) chunk * 4)
+    want = (uint64_t) chunk * 4;
+  else if (want < chunk / 4)
+    want = chunk / 4;
+
+  if (want < IMAP_FETCH_CHUNK_MIN)
+    want = IMAP_FETCH_CHUNK_MIN;
+  if (want > IMAP_FETCH_CHUNK_MAX)
+    want = IMAP_FETCH_CHUNK_MAX;
+  if ((C_ImapFetchChunkSize > 0) && (want > (uint64_t) C_ImapFetchChunkSize))
+    want = C_ImapFetchChunkSize;
+
+  if ((unsigned int) want != chunk)
+  {
+    mutt_debug(LL_DEBUG2, "fetch chunk %u -> %llu (%u headers in %llums)\n", chunk,
+               (unsigned long long) want, fetched, (unsigned long long) elapsed_ms);
+  }
+
+  return want;
+}
+
 /**
  * imap_fetch_msn_seqset - Generate a sequence set
  * @param[in]  buf           Buffer for the result
@@ -551,6 +719,7 @@ static void imap_alloc_uid_hash(struct ImapAccountData *adata, unsigned int msn_
  * @param[in]  evalhc        If true, check the Header Cache
  * @param[in]  msn_begin     First Message Sequence Number
  * @param[in]  msn_end       Last Message Sequence Number
+ * @param[in]  max_fetch     Largest number of headers to put in the set
  * @param[out] fetch_msn_end Highest Message Sequence Number fetched
  *
  * Generates a more complicated sequence set after using the header cache,
@@ -558,10 +727,11 @@ static void imap_alloc_uid_hash(struct ImapAccountData *adata, unsigned int msn_
  */
 static unsigned int imap_fetch_msn_seqset(struct Buffer *buf, struct ImapAccountData *adata,
                                           bool evalhc, unsigned int msn_begin,
-                                          unsigned int msn_end, unsigned int *fetch_msn_end)
+                                          unsigned int msn_end, unsigned int max_fetch,
+                                          unsigned int *fetch_msn_end)
 {
   struct ImapMboxData *mdata = adata->mailbox->mdata;
-  unsigned int max_headers_per_fetch = UINT_MAX;
+  unsigned int max_headers_per_fetch = max_fetch;
   bool first_chunk = true;
   int state = 0; /* 1: single msn, 2: range of msn */
   unsigned int msn;
@@ -573,8 +743,8 @@ static unsigned int imap_fetch_msn_seqset(struct Buffer *buf, struct ImapAccount
   if (msn_end < msn_begin)
     return 0;
 
-  if (C_ImapFetchChunkSize > 0)
-    max_headers_per_fetch = C_ImapFetchChunkSize;
+  if (max_headers_per_fetch == 0)
+    max_headers_per_fetch = UINT_MAX;
 
   if (!evalhc)
   {
@@ -842,45 +1012,62 @@ static int read_headers_qresync_eval_cache(struct ImapAccountData *adata, char *
   if (!iter)
     return -1;
 
+  /* Gather all the UIDs up front, so the header cache can be resolved in one
+   * batched sweep */
+  ARRAY_HEAD(, unsigned int) uids = ARRAY_HEAD_INITIALIZER;
   while ((rc = mutt_seqset_iterator_next(iter, &uid)) == 0)
+    ARRAY_ADD(&uids, uid);
+  mutt_seqset_iterator_free(&iter);
+  if (rc < 0)
   {
+    ARRAY_FREE(&uids);
+    return rc;
+  }
+
+  const size_t num = ARRAY_SIZE(&uids);
+  struct Email **emails = mutt_mem_calloc(num, sizeof(struct Email *));
+  imap_hcache_get_multi(mdata, uids.entries, num, emails);
+
+  unsigned int *puid = NULL;
+  ARRAY_FOREACH(puid, &uids)
+  {
+    struct Email *e = emails[ARRAY_FOREACH_IDX];
+    if (!e)
+      continue;
+
     /* The seqset may contain more headers than the fetch request, so
      * we need to watch and reallocate the context and msn_index */
     imap_msn_reserve(&mdata->msn, msn);
+    imap_msn_set(&mdata->msn, msn - 1, e);
 
-    struct Email *e = imap_hcache_get(mdata, uid);
-    if (e)
-    {
-      imap_msn_set(&mdata->msn, msn - 1, e);
-
-      if (m->msg_count >= m->email_max)
-        mx_alloc_memory(m);
+    if (m->msg_count >= m->email_max)
+      mx_alloc_memory(m);
 
-      struct ImapEmailData *edata = imap_edata_new();
-      e->edata = edata;
-      e->edata_free = imap_edata_free;
+    struct ImapEmailData *edata = imap_edata_new();
+    e->edata = edata;
+    e->edata_free = imap_edata_free;
 
-      e->index = uid;
-      e->active = true;
-      e->changed = false;
-      edata->read = e->read;
-      edata->old = e->old;
-      edata->deleted = e->deleted;
-      edata->flagged = e->flagged;
-      edata->replied = e->replied;
+    e->index = *puid;
+    e->active = true;
+    e->changed = false;
+    edata->read = e->read;
+    edata->old = e->old;
+    edata->deleted = e->deleted;
+    edata->flagged = e->flagged;
+    edata->replied = e->replied;
 
-      edata->msn = msn;
-      edata->uid = uid;
-      mutt_hash_int_insert(mdata->uid_hash, uid, e);
+    edata->msn = msn;
+    edata->uid = *puid;
+    mutt_hash_int_insert(mdata->uid_hash, *puid, e);
 
-      mailbox_size_add(m, e);
-      m->emails[m->msg_count++] = e;
+    mailbox_size_add(m, e);
+    m->emails[m->msg_count++] = e;
 
-      msn++;
-    }
+    msn++;
   }
 
-  mutt_seqset_iterator_free(&iter);
+  FREE(&emails);
+  ARRAY_FREE(&uids);
 
   return rc;
 }
@@ -1002,7 +1189,12 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
   unsigned int fetch_msn_end = 0;
   struct Progress progress;
   char *hdrreq = NULL;
+#ifdef USE_FMEMOPEN
+  char *hmem = NULL;
+  size_t hmemlen = 0;
+#else
   struct Buffer *tempfile = NULL;
+#endif
   FILE *fp = NULL;
   struct ImapHeader h;
   struct Buffer *buf = NULL;
@@ -1051,6 +1243,14 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
 
   /* instead of downloading all headers and then parsing them, we parse them
    * as they come in. */
+#ifdef USE_FMEMOPEN
+  fp = open_memstream(&hmem, &hmemlen);
+  if (!fp)
+  {
+    mutt_perror(_("Error opening 'memory stream'"));
+    goto bail;
+  }
+#else
   tempfile = mutt_buffer_pool_get();
   mutt_buffer_mktemp(tempfile);
   fp = mutt_file_fopen(mutt_b2s(tempfile), "w+");
@@ -1061,6 +1261,7 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
   }
   unlink(mutt_b2s(tempfile));
   mutt_buffer_pool_release(&tempfile);
+#endif
 
   if (m->verbose)
   {
@@ -1080,9 +1281,13 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
    *   at the end of the loop makes the comparison unneeded, but to be
    *   cautious I'm keeping it.
    */
+  unsigned int chunk_size = imap_fetch_chunk_init();
+  unsigned int chunk_count = 0;
   while ((fetch_msn_end < msn_end) &&
-         imap_fetch_msn_seqset(buf, adata, evalhc, msn_begin, msn_end, &fetch_msn_end))
+         ((chunk_count = imap_fetch_msn_seqset(buf, adata, evalhc, msn_begin, msn_end,
+                                               chunk_size, &fetch_msn_end)) != 0))
   {
+    const uint64_t chunk_start_ms = mutt_date_epoch_ms();
     char *cmd = NULL;
     mutt_str_asprintf(&cmd, "FETCH %s (UID FLAGS INTERNALDATE RFC822.SIZE %s)",
                       mutt_b2s(buf), hdrreq);
@@ -1168,10 +1373,23 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
         if (*maxuid < h.edata->uid)
           *maxuid = h.edata->uid;
 
-        rewind(fp);
         /* NOTE: if Date: header is missing, mutt_rfc822_read_header depends
          *   on h.received being set */
+#ifdef USE_FMEMOPEN
+        /* The flush makes the written header visible in hmem/hmemlen */
+        fflush(fp);
+        FILE *fp_mem = fmemopen(hmem, hmemlen, "r");
+        if (!fp_mem)
+        {
+          mutt_perror(_("Error re-opening 'memory stream'"));
+          goto bail;
+        }
+        e->env = mutt_rfc822_read_header(fp_mem, e, false, false);
+        mutt_file_fclose(&fp_mem);
+#else
+        rewind(fp);
         e->env = mutt_rfc822_read_header(fp, e, false, false);
+#endif
         /* body built as a side-effect of mutt_rfc822_read_header */
         e->body->length = h.content_length;
         mailbox_size_add(m, e);
@@ -1213,6 +1431,10 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
      * may not be correct.  So here we must assume the msn values have
      * not been altered during or after the fetch.  */
     msn_begin = fetch_msn_end + 1;
+
+    const uint64_t chunk_ms = mutt_date_epoch_ms() - chunk_start_ms;
+    mutt_stats_record_ms("imap/fetch_chunk", chunk_ms);
+    chunk_size = imap_fetch_chunk_adapt(chunk_size, chunk_count, chunk_ms);
   }
 
   retval = 0;
@@ -1220,8 +1442,12 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
 bail:
   mutt_buffer_pool_release(&hdr_list);
   mutt_buffer_pool_release(&buf);
-  mutt_buffer_pool_release(&tempfile);
   mutt_file_fclose(&fp);
+#ifdef USE_FMEMOPEN
+  FREE(&hmem);
+#else
+  mutt_buffer_pool_release(&tempfile);
+#endif
   FREE(&hdrreq);
 
   return retval;
@@ -1834,6 +2060,171 @@ char *imap_set_flags(struct Mailbox *m, struct Email *e, char *s, bool *server_c
   return s;
 }
 
+/**
+ * msg_prefetch_window - Fetch a window of messages into the body cache
+ * @param m     Mailbox
+ * @param first Index of the first message to consider
+ *
+ * Fetch the bodies of the next `$imap_prefetch` uncached messages with one
+ * batched `UID FETCH ... BODY.PEEK[]`, so that opening them later is a local
+ * cache hit.  NeoMutt is single-threaded, so the prefetch happens while the
+ * user is reading the message they just opened, not in the background.
+ *
+ * Failures are silent - this is an optimisation, the messages will simply be
+ * fetched on demand as before.
+ */
+static void msg_prefetch_window(struct Mailbox *m, int first)
+{
+  if (C_ImapPrefetch <= 0)
+    return;
+
+  struct ImapAccountData *adata = imap_adata_get(m);
+  if (!adata || (adata->mailbox != m))
+    return;
+
+  /* BODY.PEEK[] keeps the prefetch from marking messages as read */
+  if (!(adata->capabilities & IMAP_CAP_IMAP4REV1))
+    return;
+
+  const int max = C_ImapPrefetch;
+  struct Email **targets = mutt_mem_calloc(max, sizeof(struct Email *));
+  FILE **fps = mutt_mem_calloc(max, sizeof(FILE *));
+  bool *done = mutt_mem_calloc(max, sizeof(bool));
+  int num = 0;
+
+  for (int i = first; (i < m->msg_count) && (num < max); i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+
+    FILE *fp = msg_cache_get(m, e);
+    if (fp)
+    {
+      mutt_file_fclose(&fp); /* already cached */
+      continue;
+    }
+
+    fp = msg_cache_put(m, e);
+    if (!fp)
+      goto cleanup; /* no $message_cachedir - nowhere to prefetch to */
+
+    targets[num] = e;
+    fps[num] = fp;
+    num++;
+  }
+
+  if (num == 0)
+    goto cleanup;
+
+  /* Each batch blocks until the bodies arrive, so skimming quickly through a
+   * folder would otherwise pay a server round trip on every keypress.  Allow
+   * a burst of batches, then cap the sustained rate at one per second; a
+   * skipped prefetch just means those messages are fetched on demand.  The
+   * token is only spent when there is actually something to fetch. */
+  static struct TokenBucket prefetch_budget = { 0 };
+  if (prefetch_budget.burst == 0)
+    mutt_throttle_init(&prefetch_budget, 1, 8);
+  if (!mutt_throttle_take(&prefetch_budget, 1))
+    goto bail;
+
+  struct Buffer *cmd = mutt_buffer_pool_get();
+  mutt_buffer_addstr(cmd, "UID FETCH ");
+  for (int i = 0; i < num; i++)
+  {
+    mutt_buffer_add_printf(cmd, "%s%u", (i > 0) ? "," : "",
+                           imap_edata_get(targets[i])->uid);
+  }
+  mutt_buffer_addstr(cmd, " BODY.PEEK[]");
+
+  /* see the comment in imap_msg_open(): keep the command handler away from
+   * the headers we're fetching */
+  for (int i = 0; i < num; i++)
+    targets[i]->active = false;
+
+  imap_cmd_start(adata, mutt_b2s(cmd));
+  mutt_buffer_pool_release(&cmd);
+
+  int rc;
+  do
+  {
+    rc = imap_cmd_step(adata);
+    if (rc != IMAP_RES_CONTINUE)
+      break;
+
+    char *pc = adata->buf;
+    pc = imap_next_word(pc);
+    pc = imap_next_word(pc);
+    if (!mutt_istr_startswith(pc, "FETCH"))
+      continue;
+
+    int cur = -1;
+    while (*pc)
+    {
+      pc = imap_next_word(pc);
+      if (pc[0] == '(')
+        pc++;
+      if (mutt_istr_startswith(pc, "UID"))
+      {
+        unsigned int uid = 0;
+        pc = imap_next_word(pc);
+        if (mutt_str_atoui(pc, &uid) < 0)
+          goto bail;
+        for (int i = 0; i < num; i++)
+        {
+          if (imap_edata_get(targets[i])->uid == uid)
+          {
+            cur = i;
+            break;
+          }
+        }
+      }
+      else if (mutt_istr_startswith(pc, "BODY[]"))
+      {
+        unsigned int bytes = 0;
+        pc = imap_next_word(pc);
+        if ((cur < 0) || (imap_get_literal_count(pc, &bytes) < 0))
+          goto bail;
+        if (imap_read_literal(fps[cur], adata, bytes, NULL, NULL) < 0)
+          goto bail;
+        /* pick up trailing line */
+        rc = imap_cmd_step(adata);
+        if (rc != IMAP_RES_CONTINUE)
+          goto bail;
+        pc = adata->buf;
+
+        done[cur] = true;
+      }
+    }
+  } while (rc == IMAP_RES_CONTINUE);
+
+  if ((rc != IMAP_RES_OK) || !imap_code(adata->buf))
+    goto bail;
+
+  for (int i = 0; i < num; i++)
+  {
+    fflush(fps[i]);
+    if (done[i] && !ferror(fps[i]))
+      msg_cache_commit(m, targets[i]);
+    else
+      done[i] = false; /* let the cleanup below discard it */
+  }
+
+bail:
+  for (int i = 0; i < num; i++)
+  {
+    targets[i]->active = true;
+    mutt_file_fclose(&fps[i]);
+    if (!done[i])
+      imap_cache_del(m, targets[i]);
+  }
+
+cleanup:
+  FREE(&targets);
+  FREE(&fps);
+  FREE(&done);
+}
+
 /**
  * imap_msg_open - Open an email message in a Mailbox - Implements MxOps::msg_open()
  */
@@ -1865,6 +2256,7 @@ int imap_msg_open(struct Mailbox *m, struct Message *msg, int msgno)
   msg->fp = msg_cache_get(m, e);
   if (msg->fp)
   {
+    msg_prefetch_window(m, msgno + 1);
     if (imap_edata_get(e)->parsed)
       return 0;
     goto parsemsg;
@@ -1876,9 +2268,17 @@ int imap_msg_open(struct Mailbox *m, struct Message *msg, int msgno)
   if (output_progress)
     mutt_message(_("Fetching message..."));
 
-  msg->fp = msg_cache_put(m, e);
+  /* Continue an interrupted download rather than starting from octet zero */
+  struct ImapLiteralState lstate = { 0, false };
+  bool in_bcache = true;
+  msg->fp = NULL;
+  if (adata->capabilities & IMAP_CAP_IMAP4REV1) /* partial FETCH needs rev1 */
+    msg->fp = msg_cache_resume(m, e, &lstate);
+  if (!msg->fp)
+    msg->fp = msg_cache_put(m, e);
   if (!msg->fp)
   {
+    in_bcache = false;
     struct Buffer *path = mutt_buffer_pool_get();
     mutt_buffer_mktemp(path);
     msg->fp = mutt_file_fopen(mutt_b2s(path), "w+");
@@ -1894,10 +2294,20 @@ int imap_msg_open(struct Mailbox *m, struct Message *msg, int msgno)
    * command handler */
   e->active = false;
 
-  snprintf(buf, sizeof(buf), "UID FETCH %u %s", imap_edata_get(e)->uid,
-           ((adata->capabilities & IMAP_CAP_IMAP4REV1) ?
-                (C_ImapPeek ? "BODY.PEEK[]" : "BODY[]") :
-                "RFC822"));
+  if (lstate.raw > 0)
+  {
+    /* RFC3501 partial fetch; the octet count just needs to cover the rest */
+    snprintf(buf, sizeof(buf), "UID FETCH %u %s<%lu.4294967295>",
+             imap_edata_get(e)->uid,
+             (C_ImapPeek ? "BODY.PEEK[]" : "BODY[]"), lstate.raw);
+  }
+  else
+  {
+    snprintf(buf, sizeof(buf), "UID FETCH %u %s", imap_edata_get(e)->uid,
+             ((adata->capabilities & IMAP_CAP_IMAP4REV1) ?
+                  (C_ImapPeek ? "BODY.PEEK[]" : "BODY[]") :
+                  "RFC822"));
+  }
 
   imap_cmd_start(adata, buf);
   do
@@ -1940,7 +2350,7 @@ int imap_msg_open(struct Mailbox *m, struct Message *msg, int msgno)
           {
             mutt_progress_init(&progress, _("Fetching message..."), MUTT_PROGRESS_NET, bytes);
           }
-          if (imap_read_literal(msg->fp, adata, bytes, output_progress ? &progress : NULL) < 0)
+          if (imap_read_literal(msg->fp, adata, bytes, output_progress ? &progress : NULL, &lstate) < 0)
           {
             goto bail;
           }
@@ -1980,6 +2390,8 @@ int imap_msg_open(struct Mailbox *m, struct Message *msg, int msgno)
     goto bail;
 
   msg_cache_commit(m, e);
+  msg_cache_resume_clear(m, e);
+  msg_prefetch_window(m, msgno + 1);
 
 parsemsg:
   /* Update the header information.  Previously, we only downloaded a
@@ -2028,8 +2440,20 @@ parsemsg:
 
 bail:
   e->active = true;
-  mutt_file_fclose(&msg->fp);
-  imap_cache_del(m, e);
+  if (in_bcache && (lstate.raw > 0) && msg->fp && (fflush(msg->fp) == 0) && !ferror(msg->fp))
+  {
+    /* Keep the partial download; record how far we got so the next
+     * attempt can resume with a partial FETCH */
+    unsigned long stripped = ftell(msg->fp);
+    mutt_file_fclose(&msg->fp);
+    msg_cache_resume_save(m, e, lstate.raw, stripped, lstate.pending_cr);
+  }
+  else
+  {
+    mutt_file_fclose(&msg->fp);
+    imap_cache_del(m, e);
+    msg_cache_resume_clear(m, e);
+  }
   return -1;
 }
 
@@ -2057,6 +2481,19 @@ int imap_msg_close(struct Mailbox *m, struct Message *msg)
   return mutt_file_fclose(&msg->fp);
 }
 
+/**
+ * imap_msg_prefetch - Hint that an email will be needed soon - Implements MxOps::msg_prefetch()
+ *
+ * Pull a window of uncached bodies starting at the hinted message into the
+ * body cache, so that opening it (and the messages after it) becomes a local
+ * cache hit.
+ */
+int imap_msg_prefetch(struct Mailbox *m, struct Email *e)
+{
+  msg_prefetch_window(m, e->msgno);
+  return 0;
+}
+
 /**
  * imap_msg_save_hcache - Save message to the header cache - Implements MxOps::msg_save_hcache()
  */
@@ -32,6 +32,61 @@
 #include <string.h>
 #include "private.h"
 #include "msn.h"
+#include "message.h"
+
+/**
+ * msn_holes_before - Count the expunged slots below a physical index
+ * @param msn  MSN structure
+ * @param phys Physical index
+ * @retval num Number of holes at physical indices lower than @a phys
+ */
+static size_t msn_holes_before(const struct MSN *msn, size_t phys)
+{
+  size_t lo = 0;
+  size_t hi = ARRAY_SIZE(&msn->holes);
+
+  while (lo < hi)
+  {
+    const size_t mid = lo + ((hi - lo) / 2);
+    if (*ARRAY_GET(&msn->holes, mid) < phys)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/**
+ * msn_phys - Find the physical slot holding a live index
+ * @param msn MSN structure
+ * @param idx Live index, i.e. (MSN-1) after pending expunges
+ * @retval num Physical index into the cache
+ *
+ * The idx-th live slot can only lie between idx and idx+holes; binary search
+ * for the smallest physical index with idx+1 live slots at or below it.
+ */
+static size_t msn_phys(const struct MSN *msn, size_t idx)
+{
+  const size_t nholes = ARRAY_SIZE(&msn->holes);
+  if (nholes == 0)
+    return idx;
+
+  size_t lo = idx;
+  size_t hi = idx + nholes;
+
+  while (lo < hi)
+  {
+    const size_t mid = lo + ((hi - lo) / 2);
+    const size_t live = mid + 1 - msn_holes_before(msn, mid + 1);
+    if (live > idx)
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+
+  return lo;
+}
 
 /**
  * imap_msn_reserve - Create / reallocate the cache
@@ -49,7 +104,8 @@ void imap_msn_reserve(struct MSN *msn, size_t num)
     mutt_exit(1);
   }
 
-  ARRAY_RESERVE(msn, num);
+  imap_msn_flush(msn);
+  ARRAY_RESERVE(&msn->cache, num);
 }
 
 /**
@@ -58,7 +114,8 @@ void imap_msn_reserve(struct MSN *msn, size_t num)
  */
 void imap_msn_free(struct MSN *msn)
 {
-  ARRAY_FREE(msn);
+  ARRAY_FREE(&msn->cache);
+  ARRAY_FREE(&msn->holes);
 }
 
 /**
@@ -68,7 +125,7 @@ void imap_msn_free(struct MSN *msn)
  */
 size_t imap_msn_highest(const struct MSN *msn)
 {
-  return ARRAY_SIZE(msn);
+  return ARRAY_SIZE(&msn->cache) - ARRAY_SIZE(&msn->holes);
 }
 
 /**
@@ -79,7 +136,10 @@ size_t imap_msn_highest(const struct MSN *msn)
  */
 struct Email *imap_msn_get(const struct MSN *msn, size_t idx)
 {
-  struct Email **ep = ARRAY_GET(msn, idx);
+  if (idx >= imap_msn_highest(msn))
+    return NULL;
+
+  struct Email **ep = ARRAY_GET(&msn->cache, msn_phys(msn, idx));
   return ep ? *ep : NULL;
 }
 
@@ -91,7 +151,8 @@ struct Email *imap_msn_get(const struct MSN *msn, size_t idx)
  */
 void imap_msn_set(struct MSN *msn, size_t idx, struct Email *e)
 {
-  ARRAY_SET(msn, idx, e);
+  imap_msn_flush(msn);
+  ARRAY_SET(&msn->cache, idx, e);
 }
 
 /**
@@ -102,17 +163,121 @@ void imap_msn_set(struct MSN *msn, size_t idx, struct Email *e)
  */
 size_t imap_msn_shrink(struct MSN *msn, size_t num)
 {
-  return ARRAY_SHRINK(msn, num);
+  imap_msn_flush(msn);
+  return ARRAY_SHRINK(&msn->cache, num);
 }
 
 /**
  * imap_msn_remove - Remove an entry from the cache
  * @param msn MSN structure
  * @param idx Index to invalidate
+ *
+ * The slot keeps its sequence number; the entries above it do not shift.
  */
 void imap_msn_remove(struct MSN *msn, size_t idx)
 {
-  struct Email **ep = ARRAY_GET(msn, idx);
+  if (idx >= imap_msn_highest(msn))
+    return;
+
+  struct Email **ep = ARRAY_GET(&msn->cache, msn_phys(msn, idx));
   if (ep)
     *ep = NULL;
 }
+
+/**
+ * imap_msn_expunge - Remove an entry and renumber those above it
+ * @param msn MSN structure
+ * @param idx Index to remove
+ *
+ * The removal is O(log n): the slot is only recorded as a hole, and the
+ * entries above it keep their physical position.  Their Emails' cached
+ * sequence numbers are stale until imap_msn_flush() runs; until then, use
+ * imap_msn_current() to translate a stale number.
+ */
+void imap_msn_expunge(struct MSN *msn, size_t idx)
+{
+  if (idx >= imap_msn_highest(msn))
+    return;
+
+  const size_t phys = msn_phys(msn, idx);
+  struct Email **ep = ARRAY_GET(&msn->cache, phys);
+  if (!ep)
+    return;
+  *ep = NULL;
+
+  /* Keep the hole list sorted.  Expunge storms walk the mailbox in one
+   * direction, so the new hole nearly always belongs at one end. */
+  const size_t nholes = ARRAY_SIZE(&msn->holes);
+  if ((nholes == 0) || (*ARRAY_GET(&msn->holes, nholes - 1) < phys))
+  {
+    ARRAY_ADD(&msn->holes, phys);
+    return;
+  }
+
+  const size_t pos = msn_holes_before(msn, phys);
+  ARRAY_ADD(&msn->holes, phys);
+  size_t *hp = ARRAY_GET(&msn->holes, 0);
+  memmove(hp + pos + 1, hp + pos, (nholes - pos) * sizeof(*hp));
+  hp[pos] = phys;
+}
+
+/**
+ * imap_msn_current - Translate a stale sequence number to its current value
+ * @param msn    MSN structure
+ * @param stored Sequence number cached before the pending expunges
+ * @retval num The Email's current MSN
+ * @retval 0   The number is out of range, or that slot was expunged
+ *
+ * Between flushes the cache entries do not move, so a sequence number cached
+ * at the last flush still names physical slot (stored - 1); its current MSN
+ * only differs by the number of holes punched below it since.
+ */
+size_t imap_msn_current(const struct MSN *msn, size_t stored)
+{
+  if ((stored < 1) || (stored > ARRAY_SIZE(&msn->cache)))
+    return 0;
+
+  const size_t phys = stored - 1;
+  const size_t before = msn_holes_before(msn, phys);
+  const size_t *hp = ARRAY_GET(&msn->holes, before);
+  if (hp && (*hp == phys))
+    return 0;
+
+  return stored - before;
+}
+
+/**
+ * imap_msn_flush - Compact pending expunges and renumber the Emails
+ * @param msn MSN structure
+ *
+ * One pass closes every hole left by imap_msn_expunge() and rewrites the
+ * cached sequence number of each Email that moved, however many messages
+ * were expunged since the last flush.
+ */
+void imap_msn_flush(struct MSN *msn)
+{
+  const size_t nholes = ARRAY_SIZE(&msn->holes);
+  if (nholes == 0)
+    return;
+
+  const size_t size = ARRAY_SIZE(&msn->cache);
+  size_t write = *ARRAY_GET(&msn->holes, 0);
+  size_t h = 0;
+
+  for (size_t read = write; read < size; read++)
+  {
+    if ((h < nholes) && (*ARRAY_GET(&msn->holes, h) == read))
+    {
+      h++;
+      continue;
+    }
+    struct Email *e = *ARRAY_GET(&msn->cache, read);
+    if (e)
+      imap_edata_get(e)->msn = write + 1;
+    ARRAY_SET(&msn->cache, write, e);
+    write++;
+  }
+
+  ARRAY_SHRINK(&msn->cache, nholes);
+  ARRAY_SHRINK(&msn->holes, nholes);
+}
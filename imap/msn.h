@@ -25,10 +25,29 @@
 
 #include "config.h"
 #include <stdlib.h>
+#include "mutt/lib.h"
 
-struct MSN;
 struct Email;
 
+/**
+ * struct MSN - Look up Emails by Message Sequence Number
+ *
+ * Emails are stored in physical slot order.  Expunging an MSN does not shift
+ * the entries above it; the slot is recorded in the sorted @a holes list and
+ * lookups compensate with a binary search.  That makes an EXPUNGE storm
+ * O(log n) per response instead of O(n), at the cost of the Emails' cached
+ * sequence numbers going stale until imap_msn_flush() compacts the holes and
+ * renumbers everything in a single pass.
+ */
+struct MSN
+{
+  ARRAY_HEAD(MsnEmailArray, struct Email *) cache; ///< Emails in physical slot order
+  ARRAY_HEAD(MsnHoleArray, size_t) holes; ///< Sorted physical indices of expunged slots
+};
+
+size_t        imap_msn_current(const struct MSN *msn, size_t stored);
+void          imap_msn_expunge(struct MSN *msn, size_t idx);
+void          imap_msn_flush  (struct MSN *msn);
 void          imap_msn_free   (struct MSN *msn);
 struct Email *imap_msn_get    (const struct MSN *msn, size_t idx);
 size_t        imap_msn_highest(const struct MSN *msn);
@@ -33,13 +33,13 @@
 #include "mutt/lib.h"
 #include "config/lib.h"
 #include "hcache/lib.h"
+#include "msn.h"
 
 struct Account;
 struct ConnAccount;
 struct Email;
 struct Mailbox;
 struct Message;
-struct MSN;
 struct Progress;
 
 #define IMAP_PORT     143  ///< Default port for IMAP
@@ -153,6 +153,19 @@ struct ImapList
   bool noinferiors;
 };
 
+/**
+ * struct ImapLiteralState - Progress of a (possibly resumed) literal download
+ *
+ * Tracks how many raw octets of a message literal have been consumed, so an
+ * interrupted download can be continued with a partial FETCH - see
+ * imap_read_literal() and imap_msg_open().
+ */
+struct ImapLiteralState
+{
+  unsigned long raw; ///< Raw octets consumed, including any earlier attempts
+  bool pending_cr;   ///< A '\\r' was held back at the end of the last block
+};
+
 /**
  * struct ImapCommand - IMAP command structure
  */
@@ -207,6 +220,7 @@ struct ImapAccountData
   struct Mailbox *mailbox;      ///< Current selected mailbox
   struct Mailbox *prev_mailbox; ///< Previously selected mailbox
   struct Account *account;      ///< Parent Account
+  char *auth_method;            ///< Method that authenticated us last time, see imap_authenticate()
 };
 
 /**
@@ -235,7 +249,7 @@ struct ImapMboxData
 
   // Cached data used only when the mailbox is opened
   struct HashTable *uid_hash;
-  ARRAY_HEAD(MSN, struct Email *) msn; ///< look up headers by (MSN-1)
+  struct MSN msn; ///< look up headers by (MSN-1)
   struct BodyCache *bcache;
 
   struct HeaderCache *hcache;
@@ -263,6 +277,7 @@ extern bool          C_ImapCondstore;
 extern bool          C_ImapDeflate;
 #endif
 extern char *        C_ImapDelimChars;
+extern bool          C_ImapFetchChunkAdaptive;
 extern long          C_ImapFetchChunkSize;
 extern char *        C_ImapHeaders;
 extern bool          C_ImapIdle;
@@ -271,6 +286,7 @@ extern char *        C_ImapOauthRefreshCommand;
 extern char *        C_ImapPass;
 extern short         C_ImapPipelineDepth;
 extern short         C_ImapPollTimeout;
+extern short         C_ImapPrefetch;
 extern bool          C_ImapQresync;
 extern bool          C_ImapRfc5161;
 extern bool          C_ImapServernoise;
@@ -284,7 +300,8 @@ int imap_exec_msgset(struct Mailbox *m, const char *pre, const char *post,
                      int flag, bool changed, bool invert);
 int imap_open_connection(struct ImapAccountData *adata);
 void imap_close_connection(struct ImapAccountData *adata);
-int imap_read_literal(FILE *fp, struct ImapAccountData *adata, unsigned long bytes, struct Progress *pbar);
+int imap_read_literal(FILE *fp, struct ImapAccountData *adata, unsigned long bytes,
+                      struct Progress *pbar, struct ImapLiteralState *state);
 void imap_expunge_mailbox(struct Mailbox *m);
 int imap_login(struct ImapAccountData *adata);
 int imap_sync_message_for_copy(struct Mailbox *m, struct Email *e, struct Buffer *cmd, enum QuadOption *err_continue);
@@ -315,6 +332,7 @@ int imap_append_message(struct Mailbox *m, struct Message *msg);
 int imap_msg_open(struct Mailbox *m, struct Message *msg, int msgno);
 int imap_msg_close(struct Mailbox *m, struct Message *msg);
 int imap_msg_commit(struct Mailbox *m, struct Message *msg);
+int imap_msg_prefetch(struct Mailbox *m, struct Email *e);
 int imap_msg_save_hcache(struct Mailbox *m, struct Email *e);
 
 /* util.c */
@@ -324,6 +342,8 @@ struct ImapMboxData *imap_mdata_get(struct Mailbox *m);
 void imap_hcache_open(struct ImapAccountData *adata, struct ImapMboxData *mdata);
 void imap_hcache_close(struct ImapMboxData *mdata);
 struct Email *imap_hcache_get(struct ImapMboxData *mdata, unsigned int uid);
+int imap_hcache_get_multi(struct ImapMboxData *mdata, const unsigned int *uids,
+                          size_t num, struct Email **emails);
 int imap_hcache_put(struct ImapMboxData *mdata, struct Email *e);
 int imap_hcache_del(struct ImapMboxData *mdata, unsigned int uid);
 int imap_hcache_store_uid_seqset(struct ImapMboxData *mdata);
@@ -0,0 +1,196 @@
+/**
+ * @file
+ * IMAP UID interval sets
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page imap_uidset IMAP UID interval sets
+ *
+ * A UidSet is a sorted array of disjoint, inclusive UID runs.  It keeps the
+ * runs coalesced on insertion, so a set of n UIDs with r runs costs O(r)
+ * memory, and rendering it as an IMAP sequence-set yields the minimal
+ * "first:last" ranges regardless of the order the UIDs were added in.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "private.h"
+#include "uidset.h"
+
+/**
+ * uidset_search - Find the insertion point for a UID
+ * @param us  UID set
+ * @param uid UID to look for
+ * @retval num Index of the first run starting above uid
+ */
+static size_t uidset_search(const struct UidSet *us, unsigned int uid)
+{
+  size_t lo = 0;
+  size_t hi = ARRAY_SIZE(us);
+
+  while (lo < hi)
+  {
+    const size_t mid = lo + ((hi - lo) / 2);
+    if (ARRAY_GET((struct UidSet *) us, mid)->first <= uid)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+/**
+ * imap_uidset_add - Insert a UID into a set
+ * @param us  UID set
+ * @param uid UID to insert
+ *
+ * Adjacent runs are merged, so adding 5 to { 1:4, 6:9 } leaves { 1:9 }.
+ */
+void imap_uidset_add(struct UidSet *us, unsigned int uid)
+{
+  const size_t idx = uidset_search(us, uid);
+  struct UidRange *prev = (idx > 0) ? ARRAY_GET(us, idx - 1) : NULL;
+  struct UidRange *next = (idx < ARRAY_SIZE(us)) ? ARRAY_GET(us, idx) : NULL;
+
+  if (prev && (uid <= prev->last))
+    return; /* already present */
+
+  if (prev && (uid == (prev->last + 1)))
+  {
+    prev->last = uid;
+    if (next && (next->first == (uid + 1)))
+    {
+      /* the new uid bridges two runs */
+      prev->last = next->last;
+      memmove(next, next + 1, (ARRAY_SIZE(us) - idx - 1) * sizeof(*next));
+      ARRAY_SHRINK(us, 1);
+    }
+    return;
+  }
+
+  if (next && ((uid + 1) == next->first))
+  {
+    next->first = uid;
+    return;
+  }
+
+  /* open a new run at idx */
+  struct UidRange run = { uid, uid };
+  ARRAY_ADD(us, run);
+  struct UidRange *entry = ARRAY_GET(us, idx);
+  memmove(entry + 1, entry, (ARRAY_SIZE(us) - idx - 1) * sizeof(run));
+  *entry = run;
+}
+
+/**
+ * imap_uidset_intersects - Does a set contain any UID in a range?
+ * @param us    UID set
+ * @param first Lowest UID of the range (inclusive)
+ * @param last  Highest UID of the range (inclusive)
+ * @retval true The set contains a UID in [first, last]
+ */
+bool imap_uidset_intersects(const struct UidSet *us, unsigned int first, unsigned int last)
+{
+  if (first > last)
+    return false;
+
+  const size_t idx = uidset_search(us, last);
+  if (idx == 0)
+    return false;
+
+  return ARRAY_GET((struct UidSet *) us, idx - 1)->last >= first;
+}
+
+/**
+ * imap_uidset_coalesce - Merge runs that aren't separated by blocked UIDs
+ * @param us      UID set to compact
+ * @param blocked UIDs that must not end up inside a merged run
+ *
+ * An IMAP range first:last covers every existing UID in between, so two runs
+ * may be merged whenever the gap contains no UID of a message the command
+ * must not touch.  This matches the compression the server order gave the old
+ * in-order msgset builder, without requiring any particular sort.
+ */
+void imap_uidset_coalesce(struct UidSet *us, const struct UidSet *blocked)
+{
+  if (ARRAY_SIZE(us) < 2)
+    return;
+
+  size_t out = 0;
+  for (size_t idx = 1; idx < ARRAY_SIZE(us); idx++)
+  {
+    struct UidRange *tail = ARRAY_GET(us, out);
+    struct UidRange *run = ARRAY_GET(us, idx);
+    if (!imap_uidset_intersects(blocked, tail->last + 1, run->first - 1))
+    {
+      tail->last = run->last;
+    }
+    else
+    {
+      out++;
+      *ARRAY_GET(us, out) = *run;
+    }
+  }
+
+  ARRAY_SHRINK(us, ARRAY_SIZE(us) - out - 1);
+}
+
+/**
+ * imap_uidset_emit - Render part of a set as an IMAP sequence-set
+ * @param[in]     us      UID set
+ * @param[in,out] pos     Cursor used for multiple calls, 0 at first call
+ * @param[in]     buf     Buffer for the sequence-set
+ * @param[in]     max_len Stop once the buffer grows past this length
+ * @retval num Runs written to the buffer
+ *
+ * Writes "first:last" ranges (or bare UIDs for single-message runs) separated
+ * by commas, until the set is exhausted or the buffer is full.
+ */
+size_t imap_uidset_emit(const struct UidSet *us, size_t *pos, struct Buffer *buf, size_t max_len)
+{
+  size_t emitted = 0;
+  struct UidRange *run = NULL;
+
+  ARRAY_FOREACH_FROM(run, (struct UidSet *) us, *pos)
+  {
+    if (mutt_buffer_len(buf) >= max_len)
+      break;
+    if (emitted > 0)
+      mutt_buffer_addch(buf, ',');
+    if (run->first == run->last)
+      mutt_buffer_add_printf(buf, "%u", run->first);
+    else
+      mutt_buffer_add_printf(buf, "%u:%u", run->first, run->last);
+    emitted++;
+  }
+
+  *pos += emitted;
+  return emitted;
+}
+
+/**
+ * imap_uidset_free - Release the memory of a set
+ * @param us UID set
+ */
+void imap_uidset_free(struct UidSet *us)
+{
+  ARRAY_FREE(us);
+}
@@ -0,0 +1,50 @@
+/**
+ * @file
+ * IMAP UID interval sets
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_IMAP_UIDSET_H
+#define MUTT_IMAP_UIDSET_H
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include "mutt/lib.h"
+
+struct Buffer;
+
+/**
+ * struct UidRange - An inclusive run of consecutive IMAP UIDs
+ */
+struct UidRange
+{
+  unsigned int first; ///< Lowest UID in the run
+  unsigned int last;  ///< Highest UID in the run
+};
+
+ARRAY_HEAD(UidSet, struct UidRange);
+
+void   imap_uidset_add       (struct UidSet *us, unsigned int uid);
+void   imap_uidset_coalesce  (struct UidSet *us, const struct UidSet *blocked);
+size_t imap_uidset_emit      (const struct UidSet *us, size_t *pos, struct Buffer *buf, size_t max_len);
+void   imap_uidset_free      (struct UidSet *us);
+bool   imap_uidset_intersects(const struct UidSet *us, unsigned int first, unsigned int last);
+
+#endif /* !MUTT_IMAP_UIDSET_H */
@@ -71,6 +71,7 @@ void imap_adata_free(void **ptr)
   struct ImapAccountData *adata = *ptr;
 
   FREE(&adata->capstr);
+  FREE(&adata->auth_method);
   mutt_buffer_dealloc(&adata->cmdbuf);
   FREE(&adata->buf);
   FREE(&adata->cmds);
@@ -506,6 +507,48 @@ struct Email *imap_hcache_get(struct ImapMboxData *mdata, unsigned int uid)
   return hce.email;
 }
 
+/**
+ * imap_hcache_get_multi - Get a batch of header cache entries by UID
+ * @param[in]  mdata  Imap Mailbox data
+ * @param[in]  uids   UIDs to find
+ * @param[in]  num    Number of UIDs
+ * @param[out] emails Caller-allocated array of @a num results
+ * @retval num Number of cache hits
+ * @retval  -1 Failure
+ *
+ * Fetching all the UIDs through mutt_hcache_fetch_multi() gives the store one
+ * batched sweep instead of a point lookup per message.
+ */
+int imap_hcache_get_multi(struct ImapMboxData *mdata, const unsigned int *uids,
+                          size_t num, struct Email **emails)
+{
+  if (!mdata->hcache)
+    return -1;
+
+  char *keymem = mutt_mem_calloc(num, 16);
+  const char **keys = mutt_mem_calloc(num, sizeof(const char *));
+  size_t *keylens = mutt_mem_calloc(num, sizeof(size_t));
+  struct HCacheEntry *entries = mutt_mem_calloc(num, sizeof(struct HCacheEntry));
+
+  for (size_t i = 0; i < num; i++)
+  {
+    keys[i] = keymem + (i * 16);
+    keylens[i] = sprintf(keymem + (i * 16), "/%u", uids[i]);
+  }
+
+  int hits = mutt_hcache_fetch_multi(mdata->hcache, keys, keylens, num,
+                                     mdata->uidvalidity, entries);
+
+  for (size_t i = 0; i < num; i++)
+    emails[i] = entries[i].email;
+
+  FREE(&keymem);
+  FREE(&keys);
+  FREE(&keylens);
+  FREE(&entries);
+  return hits;
+}
+
 /**
  * imap_hcache_put - Add an entry to the header cache
  * @param mdata Imap Mailbox data
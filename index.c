@@ -104,6 +104,8 @@ char *C_MarkMacroPrefix; ///< Config: Prefix for macros using '<mark-message>'
 bool C_UncollapseJump; ///< Config: When opening a thread, jump to the next unread message
 bool C_UncollapseNew; ///< Config: Open collapsed threads when new mail arrives
 
+int IndexLineGen = 1; ///< Generation of the per-Email cached index lines
+
 /// Help Bar for the Index dialog
 static const struct Mapping IndexHelp[] = {
   // clang-format off
@@ -373,6 +375,30 @@ static int ci_first_message(struct Mailbox *m)
   return 0;
 }
 
+/**
+ * ci_advise_neighbours - Hint the backend about the messages likely to be read next
+ * @param m    Mailbox
+ * @param vnum Virtual index of the message being displayed
+ *
+ * When a message is displayed, the user usually continues to the next (or
+ * previous) entry in the current view - in a threaded view that's the thread
+ * traversal order.  Hand both neighbours to the backend's prefetch hook:
+ * maildir/MH kick off kernel readahead of the message files, IMAP pulls a
+ * window of bodies into the body cache.
+ */
+static void ci_advise_neighbours(struct Mailbox *m, int vnum)
+{
+  if (!m)
+    return;
+
+  for (int i = vnum - 1; i <= vnum + 1; i += 2)
+  {
+    struct Email *e = mutt_get_virt_email(m, i);
+    if (e)
+      mx_msg_prefetch(m, e);
+  }
+}
+
 /**
  * mx_toggle_write - Toggle the mailbox's readonly flag
  * @param m Mailbox
@@ -675,6 +701,149 @@ static int mailbox_index_observer(struct NotifyCallback *nc)
   return 0;
 }
 
+/**
+ * struct FolderViewState - Remembered view of a Mailbox within this session
+ *
+ * Cursor and collapse state are keyed by Message-ID rather than by position,
+ * so a remembered view stays valid however much the mailbox has changed on
+ * disk in the meantime - stale ids simply don't resolve.
+ */
+struct FolderViewState
+{
+  char *folder;                 ///< Mailbox path
+  char *cur_msgid;              ///< Message-ID of the selected Email
+  bool collapsed_all;           ///< All threads were collapsed
+  struct ListHead collapsed;    ///< Message-IDs of collapsed thread roots
+  STAILQ_ENTRY(FolderViewState) entries;
+};
+STAILQ_HEAD(FolderViewStateList, FolderViewState);
+static struct FolderViewStateList FolderViews = STAILQ_HEAD_INITIALIZER(FolderViews);
+
+/**
+ * folder_view_find - Find the remembered view of a folder
+ * @param folder Mailbox path
+ * @retval ptr  Matching view state
+ * @retval NULL This folder hasn't been visited yet
+ */
+static struct FolderViewState *folder_view_find(const char *folder)
+{
+  struct FolderViewState *fv = NULL;
+  STAILQ_FOREACH(fv, &FolderViews, entries)
+  {
+    if (mutt_str_equal(fv->folder, folder))
+      return fv;
+  }
+  return NULL;
+}
+
+/**
+ * folder_view_save - Remember the current view of a Mailbox
+ * @param ctx  Current Mailbox context
+ * @param menu Current Menu
+ *
+ * Called when leaving a folder, so re-entering it can restore the cursor and
+ * the collapse state instead of starting from scratch.
+ */
+static void folder_view_save(struct Context *ctx, struct Menu *menu)
+{
+  if (!ctx || !ctx->mailbox || !menu || (ctx->mailbox->msg_count == 0))
+    return;
+
+  struct Mailbox *m = ctx->mailbox;
+  struct FolderViewState *fv = folder_view_find(mailbox_path(m));
+  if (!fv)
+  {
+    fv = mutt_mem_calloc(1, sizeof(*fv));
+    fv->folder = mutt_str_dup(mailbox_path(m));
+    STAILQ_INIT(&fv->collapsed);
+    STAILQ_INSERT_HEAD(&FolderViews, fv, entries);
+  }
+
+  FREE(&fv->cur_msgid);
+  struct Email *e = mutt_get_virt_email(m, menu->current);
+  if (e && e->env)
+    fv->cur_msgid = mutt_str_dup(e->env->message_id);
+
+  mutt_list_free(&fv->collapsed);
+  fv->collapsed_all = ctx->collapsed;
+  if (((C_Sort & SORT_MASK) == SORT_THREADS) && !ctx->collapsed)
+  {
+    for (int i = 0; i < m->msg_count; i++)
+    {
+      struct Email *e2 = m->emails[i];
+      /* only the visible root of a collapsed thread carries a vnum */
+      if (e2 && e2->collapsed && (e2->vnum >= 0) && e2->env && e2->env->message_id)
+        mutt_list_insert_tail(&fv->collapsed, mutt_str_dup(e2->env->message_id));
+    }
+  }
+}
+
+/**
+ * folder_view_restore - Restore the remembered view of a Mailbox
+ * @param ctx  Current Mailbox context
+ * @param menu Current Menu
+ * @retval true The folder was visited before and its view was restored
+ */
+static bool folder_view_restore(struct Context *ctx, struct Menu *menu)
+{
+  if (!ctx || !ctx->mailbox || !menu)
+    return false;
+
+  struct Mailbox *m = ctx->mailbox;
+  struct FolderViewState *fv = folder_view_find(mailbox_path(m));
+  if (!fv)
+    return false;
+
+  if ((C_Sort & SORT_MASK) == SORT_THREADS)
+  {
+    if (fv->collapsed_all)
+    {
+      ctx->collapsed = true;
+      mutt_thread_collapse(ctx->threads, true);
+      mutt_set_vnum(m);
+    }
+    else if (!STAILQ_EMPTY(&fv->collapsed))
+    {
+      if (!m->id_hash)
+        m->id_hash = mutt_make_id_hash(m);
+      struct ListNode *np = NULL;
+      STAILQ_FOREACH(np, &fv->collapsed, entries)
+      {
+        struct Email *e = mutt_hash_find(m->id_hash, np->data);
+        if (e && !e->collapsed && mutt_thread_can_collapse(e))
+          mutt_collapse_thread(e);
+      }
+      mutt_set_vnum(m);
+    }
+  }
+
+  menu->current = -1;
+  if (fv->cur_msgid)
+  {
+    if (!m->id_hash)
+      m->id_hash = mutt_make_id_hash(m);
+    struct Email *e = mutt_hash_find(m->id_hash, fv->cur_msgid);
+    if (e)
+    {
+      if (e->vnum < 0)
+      {
+        /* inside a collapsed thread - land on its visible root */
+        struct MuttThread *top = e->thread;
+        while (top && top->parent)
+          top = top->parent;
+        if (top && top->message)
+          e = top->message;
+      }
+      if (e->vnum >= 0)
+        menu->current = e->vnum;
+    }
+  }
+  if (menu->current < 0)
+    menu->current = ci_first_message(m);
+
+  return true;
+}
+
 /**
  * change_folder_mailbox - Change to a different Mailbox by pointer
  * @param menu      Current Menu
@@ -707,6 +876,7 @@ static void change_folder_mailbox(struct Menu *menu, struct Mailbox *m, int *old
       new_last_folder = mutt_str_dup(mailbox_path(Context->mailbox));
     *oldcount = Context->mailbox->msg_count;
 
+    folder_view_save(Context, menu);
     int check = mx_mbox_close(&Context);
     if (check != 0)
     {
@@ -752,10 +922,13 @@ static void change_folder_mailbox(struct Menu *menu, struct Mailbox *m, int *old
     return;
 
   const int flags = read_only ? MUTT_READONLY : MUTT_OPEN_NO_FLAGS;
+  bool view_restored = false;
   Context = mx_mbox_open(m, flags);
   if (Context)
   {
-    menu->current = ci_first_message(Context->mailbox);
+    view_restored = folder_view_restore(Context, menu);
+    if (!view_restored)
+      menu->current = ci_first_message(Context->mailbox);
 #ifdef USE_INOTIFY
     mutt_monitor_add(NULL);
 #endif
@@ -765,7 +938,7 @@ static void change_folder_mailbox(struct Menu *menu, struct Mailbox *m, int *old
     menu->current = 0;
   }
 
-  if (((C_Sort & SORT_MASK) == SORT_THREADS) && C_CollapseAll)
+  if (!view_restored && ((C_Sort & SORT_MASK) == SORT_THREADS) && C_CollapseAll)
     collapse_all(Context, menu, 0);
 
   struct MuttWindow *dlg = dialog_find(menu->win_index);
@@ -925,8 +1098,25 @@ void index_make_entry(char *buf, size_t buflen, struct Menu *menu, int line)
     }
   }
 
+  /* Rendering $index_format is the hot spot of an index redraw, so the result
+   * is cached on the Email until a state change bumps IndexLineGen */
+  const bool in_pager = (Context->msg_in_pager == e->msgno);
+  if (e->index_line && (e->index_line_gen == IndexLineGen) &&
+      (e->index_line_flags == (int) flags) && (e->index_line_in_pager == in_pager) &&
+      (e->index_line_cols == menu->win_index->state.cols))
+  {
+    mutt_str_copy(buf, e->index_line, buflen);
+    return;
+  }
+
   mutt_make_string_flags(buf, buflen, menu->win_index->state.cols, NONULL(C_IndexFormat),
                          Context->mailbox, Context->msg_in_pager, e, flags);
+
+  mutt_str_replace(&e->index_line, buf);
+  e->index_line_gen = IndexLineGen;
+  e->index_line_flags = flags;
+  e->index_line_in_pager = in_pager;
+  e->index_line_cols = menu->win_index->state.cols;
 }
 
 /**
@@ -991,7 +1181,8 @@ void mutt_draw_statusline(int cols, const char *buf, size_t buflen)
     {
       regmatch_t pmatch[cl->match + 1];
 
-      if (regexec(&cl->regex, buf + offset, cl->match + 1, pmatch, 0) != 0)
+      regex_t *re = mutt_color_line_regex(cl);
+      if (!re || (regexec(re, buf + offset, cl->match + 1, pmatch, 0) != 0))
         continue; /* regex doesn't match the status bar */
 
       int first = pmatch[cl->match].rm_so + offset;
@@ -1099,15 +1290,20 @@ static void index_custom_redraw(struct Menu *menu)
   {
     menu_check_recenter(menu);
 
-    if (menu->redraw & REDRAW_INDEX)
+    if (menu->redraw & (REDRAW_INDEX | REDRAW_SCROLL))
     {
       menu_redraw_index(menu);
       menu->redraw |= REDRAW_STATUS;
     }
-    else if (menu->redraw & (REDRAW_MOTION_RESYNC | REDRAW_MOTION))
-      menu_redraw_motion(menu);
-    else if (menu->redraw & REDRAW_CURRENT)
-      menu_redraw_current(menu);
+    else
+    {
+      if (menu->redraw & REDRAW_ROWS)
+        menu_redraw_rows(menu);
+      if (menu->redraw & (REDRAW_MOTION_RESYNC | REDRAW_MOTION))
+        menu_redraw_motion(menu);
+      else if (menu->redraw & REDRAW_CURRENT)
+        menu_redraw_current(menu);
+    }
   }
 
   if (menu->redraw & REDRAW_STATUS)
@@ -1277,10 +1473,20 @@ int mutt_index_menu(struct MuttWindow *dlg)
         /* avoid the message being overwritten by mailbox */
         do_mailbox_notify = false;
 
-        bool verbose = Context->mailbox->verbose;
-        Context->mailbox->verbose = false;
-        update_index(menu, Context, check, oldcount, &cur);
-        Context->mailbox->verbose = verbose;
+        /* A flags-only change can't add, remove or reorder messages, so the
+         * index tables are still right: skip the resort and just redraw.
+         * Limits and score sorting can depend on flags, so they still take
+         * the full update. */
+        const bool flags_only = (check == MUTT_FLAGS) && !ctx_has_limit(Context) &&
+                                ((C_Sort & SORT_MASK) != SORT_SCORE) &&
+                                ((C_SortAux & SORT_MASK) != SORT_SCORE);
+        if (!flags_only)
+        {
+          bool verbose = Context->mailbox->verbose;
+          Context->mailbox->verbose = false;
+          update_index(menu, Context, check, oldcount, &cur);
+          Context->mailbox->verbose = verbose;
+        }
         menu->max = Context->mailbox->vcount;
         menu->redraw = REDRAW_FULL;
         OptSearchInvalid = true;
@@ -1438,6 +1644,8 @@ int mutt_index_menu(struct MuttWindow *dlg)
       nm_db_debug_check(Context->mailbox);
 #endif
 
+    const uint64_t op_start_ms = mutt_date_epoch_ms();
+
     switch (op)
     {
         /* ----------------------------------------------------------------------
@@ -1510,6 +1718,8 @@ int mutt_index_menu(struct MuttWindow *dlg)
           }
           else
           {
+            if (cur.e)
+              mutt_env_parse_threads(cur.e->env);
             if (!cur.e || STAILQ_EMPTY(&cur.e->env->references))
             {
               mutt_error(_("Article has no parent reference"));
@@ -1587,6 +1797,7 @@ int mutt_index_menu(struct MuttWindow *dlg)
         /* trying to find msgid of the root message */
         if (op == OP_RECONSTRUCT_THREAD)
         {
+          mutt_env_parse_threads(cur.e->env);
           struct ListNode *ref = NULL;
           STAILQ_FOREACH(ref, &cur.e->env->references, entries)
           {
@@ -1933,9 +2144,12 @@ int mutt_index_menu(struct MuttWindow *dlg)
             if (!e)
               break;
             if (e->visible)
+            {
               mutt_set_flag(m, e, MUTT_TAG, false);
+              mutt_menu_queue_row_redraw(menu, e->vnum);
+            }
           }
-          menu->redraw |= REDRAW_STATUS | REDRAW_INDEX;
+          menu->redraw |= REDRAW_STATUS;
         }
         else
         {
@@ -2576,6 +2790,7 @@ int mutt_index_menu(struct MuttWindow *dlg)
           emaillist_clear(&el);
         }
         set_current_email(&cur, mutt_get_virt_email(Context->mailbox, menu->current));
+        ci_advise_neighbours(Context->mailbox, menu->current);
 
         op = mutt_display_message(win_index, win_ibar, win_pager, win_pbar,
                                   Context->mailbox, cur.e);
@@ -2626,6 +2841,7 @@ int mutt_index_menu(struct MuttWindow *dlg)
         if (!cur.e)
           break;
 
+        mutt_env_parse_threads(cur.e->env);
         if ((C_Sort & SORT_MASK) != SORT_THREADS)
           mutt_error(_("Threading is not enabled"));
         else if (!STAILQ_EMPTY(&cur.e->env->in_reply_to) ||
@@ -2986,10 +3202,11 @@ int mutt_index_menu(struct MuttWindow *dlg)
             if (!e)
               break;
             if (message_is_tagged(Context, e))
+            {
               mutt_set_flag(m, e, MUTT_FLAG, !e->flagged);
+              mutt_menu_queue_row_redraw(menu, e->vnum);
+            }
           }
-
-          menu->redraw |= REDRAW_INDEX;
         }
         else
         {
@@ -3037,8 +3254,9 @@ int mutt_index_menu(struct MuttWindow *dlg)
               mutt_set_flag(m, e, MUTT_NEW, true);
             else
               mutt_set_flag(m, e, MUTT_READ, true);
+            mutt_menu_queue_row_redraw(menu, e->vnum);
           }
-          menu->redraw |= REDRAW_STATUS | REDRAW_INDEX;
+          menu->redraw |= REDRAW_STATUS;
         }
         else
         {
@@ -3931,6 +4149,9 @@ int mutt_index_menu(struct MuttWindow *dlg)
           km_error_key(MENU_MAIN);
     }
 
+    /* time spent handling the function, not waiting for the key */
+    mutt_stats_record_ms("index/op", mutt_date_epoch_ms() - op_start_ms);
+
 #ifdef USE_NOTMUCH
     if (Context)
       nm_db_debug_check(Context->mailbox);
@@ -3965,6 +4186,12 @@ void mutt_set_header_color(struct Mailbox *m, struct Email *e)
   struct ColorLine *color = NULL;
   struct PatternCache cache = { 0 };
 
+  /* Every `e->pair = 0` invalidation funnels through here before the menu is
+   * drawn, so drop the per-field caches too - get_color() refills them */
+  e->pair_author = 0;
+  e->pair_flags = 0;
+  e->pair_subject = 0;
+
   STAILQ_FOREACH(color, &Colors->index_list, entries)
   {
     if (mutt_pattern_exec(SLIST_FIRST(color->color_pattern),
@@ -4010,10 +4237,12 @@ int mutt_reply_observer(struct NotifyCallback *nc)
     if (mutt_regex_capture(C_ReplyRegex, env->subject, 1, pmatch))
     {
       env->real_subj = env->subject + pmatch[0].rm_eo;
+      env->real_subj_hash = 0;
       continue;
     }
 
     env->real_subj = env->subject;
+    env->real_subj_hash = 0;
   }
 
   OptResortInit = true; /* trigger a redraw of the index */
@@ -33,6 +33,10 @@ struct Menu;
 struct MuttWindow;
 struct NotifyCallback;
 
+/* Bump whenever email state changes that `$index_format` may render;
+ * invalidates every Email's cached index line */
+extern int IndexLineGen;
+
 /* These Config Variables are only used in index.c */
 extern bool  C_ChangeFolderNext;
 extern bool  C_CollapseAll;
@@ -659,6 +659,7 @@ void mutt_opts_free(void)
   mutt_list_free(&Muttrc);
   mutt_list_free(&UnIgnore);
   mutt_list_free(&UserHeader);
+  mutt_ignore_invalidate();
 
   /* Lists of AttachMatch */
   mutt_list_free_type(&AttachAllow, (list_free_t) mutt_attachmatch_free);
@@ -918,10 +919,15 @@ int mutt_init(struct ConfigSet *cs, bool skip_sys_rc, struct ListHead *commands)
     }
   }
 
+  int span = mutt_trace_start("execute_commands");
   if (execute_commands(commands) != 0)
     need_pause = 1; // TEST13: neomutt -e broken
+  mutt_trace_end(span);
 
-  if (!get_hostname(cs))
+  span = mutt_trace_start("get_hostname");
+  const bool host_ok = get_hostname(cs);
+  mutt_trace_end(span);
+  if (!host_ok)
     goto done;
 
   if (!C_Realname)
@@ -944,8 +950,8 @@ int mutt_init(struct ConfigSet *cs, bool skip_sys_rc, struct ListHead *commands)
 
   mutt_file_mkdir(C_Tmpdir, S_IRWXU);
 
+  /* The rings are filled from `$history_file` when they're first consulted */
   mutt_hist_init();
-  mutt_hist_read_file();
 
 #ifdef USE_NOTMUCH
   if (C_VirtualSpoolfile)
@@ -1003,28 +1009,23 @@ enum CommandResult mutt_parse_rc_buffer(struct Buffer *line,
     }
     mutt_extract_token(token, line, MUTT_TOKEN_NO_FLAGS);
 
-    struct Command *cmd = NULL;
-    size_t size = mutt_commands_array(&cmd);
-    size_t i;
-    for (i = 0; i < size; i++)
-    {
-      if (mutt_str_equal(token->data, cmd[i].name))
-      {
-        rc = cmd[i].parse(token, line, cmd[i].data, err);
-        if (rc != MUTT_CMD_SUCCESS)
-        {              /* -1 Error, +1 Finish */
-          goto finish; /* Propagate return code */
-        }
-        notify_send(NeoMutt->notify, NT_COMMAND, i, (void *) cmd);
-        break; /* Continue with next command */
-      }
-    }
-    if (i == size)
+    struct Command *cmd = mutt_command_get(token->data);
+    if (!cmd)
     {
       mutt_buffer_printf(err, _("%s: unknown command"), NONULL(token->data));
       rc = MUTT_CMD_ERROR;
       break; /* Ignore the rest of the line */
     }
+
+    rc = cmd->parse(token, line, cmd->data, err);
+    if (rc != MUTT_CMD_SUCCESS)
+    {              /* -1 Error, +1 Finish */
+      goto finish; /* Propagate return code */
+    }
+
+    struct Command *first = NULL;
+    mutt_commands_array(&first);
+    notify_send(NeoMutt->notify, NT_COMMAND, cmd - first, cmd);
   }
 finish:
   return rc;
@@ -224,6 +224,125 @@ static void mutt_keymaplist_free(struct KeymapList *km_list)
   }
 }
 
+/**
+ * struct KeyTrieNode - Node in a compiled key-dispatch trie
+ *
+ * Each menu's sorted Keymap list is compiled into a trie, so dispatching a
+ * keypress costs a binary search of one node's children instead of a walk of
+ * the whole list.  The trie borrows its Keymap pointers from Keymaps[] and is
+ * rebuilt lazily after any 'bind'/'macro'/'unbind' change.
+ */
+struct KeyTrieNode;
+ARRAY_HEAD(KeyTrieNodeArray, struct KeyTrieNode *);
+
+struct KeyTrieNode
+{
+  keycode_t key;                    ///< Key to press to reach this node
+  struct Keymap *map;               ///< Completed binding, NULL for a prefix
+  struct KeyTrieNodeArray children; ///< Child nodes, sorted by key
+};
+
+static struct KeyTrieNode *KeyTrie[MENU_MAX];
+static bool KeyTrieValid[MENU_MAX];
+
+/**
+ * keytrie_free - Free a trie of compiled key sequences
+ * @param ptr Trie to free
+ */
+static void keytrie_free(struct KeyTrieNode **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct KeyTrieNode *node = *ptr;
+  struct KeyTrieNode **np = NULL;
+  ARRAY_FOREACH(np, &node->children)
+  {
+    keytrie_free(np);
+  }
+  ARRAY_FREE(&node->children);
+  FREE(ptr);
+}
+
+/**
+ * keytrie_lookup - Find the child node for a key
+ * @param node Node to search below
+ * @param key  Key that was pressed
+ * @retval ptr  Child reached by pressing the key
+ * @retval NULL No such child
+ */
+static struct KeyTrieNode *keytrie_lookup(struct KeyTrieNode *node, keycode_t key)
+{
+  size_t lo = 0;
+  size_t hi = ARRAY_SIZE(&node->children);
+
+  while (lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    struct KeyTrieNode *child = *ARRAY_GET(&node->children, mid);
+    if (child->key == key)
+      return child;
+    if (child->key < key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return NULL;
+}
+
+/**
+ * keytrie_build - Compile a Keymap list into a dispatch trie
+ * @param km_list Sorted list of key bindings
+ * @retval ptr Root of the new trie
+ *
+ * The list is sorted by key sequence, so each level's children are created in
+ * ascending order and appending keeps them sorted.
+ */
+static struct KeyTrieNode *keytrie_build(struct KeymapList *km_list)
+{
+  struct KeyTrieNode *root = mutt_mem_calloc(1, sizeof(struct KeyTrieNode));
+
+  struct Keymap *np = NULL;
+  STAILQ_FOREACH(np, km_list, entries)
+  {
+    struct KeyTrieNode *node = root;
+    for (int i = 0; i < np->len; i++)
+    {
+      struct KeyTrieNode **last = ARRAY_LAST(&node->children);
+      if (last && ((*last)->key == np->keys[i]))
+      {
+        node = *last;
+        continue;
+      }
+      struct KeyTrieNode *child = mutt_mem_calloc(1, sizeof(struct KeyTrieNode));
+      child->key = np->keys[i];
+      ARRAY_ADD(&node->children, child);
+      node = child;
+    }
+    node->map = np;
+  }
+
+  return root;
+}
+
+/**
+ * keytrie_get - Get the dispatch trie for a menu, rebuilding if necessary
+ * @param menu Menu id, e.g. #MENU_PAGER
+ * @retval ptr  Root of the menu's trie
+ * @retval NULL The menu has no bindings
+ */
+static struct KeyTrieNode *keytrie_get(enum MenuType menu)
+{
+  if (!KeyTrieValid[menu])
+  {
+    keytrie_free(&KeyTrie[menu]);
+    if (!STAILQ_EMPTY(&Keymaps[menu]))
+      KeyTrie[menu] = keytrie_build(&Keymaps[menu]);
+    KeyTrieValid[menu] = true;
+  }
+  return KeyTrie[menu];
+}
+
 /**
  * alloc_keys - Allocate space for a sequence of keys
  * @param len  Number of keys
@@ -463,6 +582,8 @@ static enum CommandResult km_bind_err(const char *s, enum MenuType menu, int op,
     STAILQ_INSERT_HEAD(&Keymaps[menu], map, entries);
   }
 
+  KeyTrieValid[menu] = false;
+
   return rc;
 }
 
@@ -658,11 +779,13 @@ static int retry_generic(enum MenuType menu, keycode_t *keys, int keyslen, int l
 int km_dokey(enum MenuType menu)
 {
   struct KeyEvent tmp;
-  struct Keymap *map = STAILQ_FIRST(&Keymaps[menu]);
+  struct KeyTrieNode *root = keytrie_get(menu);
+  struct KeyTrieNode *node = root;
+  keycode_t keys[MAX_SEQ]; /* keys eaten so far, in case they must be pushed back */
   int pos = 0;
   int n = 0;
 
-  if (!map && (menu != MENU_EDITOR))
+  if (!root && (menu != MENU_EDITOR))
     return retry_generic(menu, NULL, 0, 0);
 
   while (true)
@@ -756,22 +879,20 @@ int km_dokey(enum MenuType menu)
         continue;
     }
 
-    if (!map)
+    if (!root)
       return tmp.op;
 
     /* Nope. Business as usual */
-    while (LastKey > map->keys[pos])
-    {
-      if ((pos > map->eq) || !STAILQ_NEXT(map, entries))
-        return retry_generic(menu, map->keys, pos, LastKey);
-      map = STAILQ_NEXT(map, entries);
-    }
+    struct KeyTrieNode *next = keytrie_lookup(node, LastKey);
+    if (!next)
+      return retry_generic(menu, keys, pos, LastKey);
 
-    if (LastKey != map->keys[pos])
-      return retry_generic(menu, map->keys, pos, LastKey);
+    keys[pos++] = LastKey;
+    node = next;
 
-    if (++pos == map->len)
+    if (node->map)
     {
+      struct Keymap *map = node->map;
       if (map->op != OP_MACRO)
         return map->op;
 
@@ -798,7 +919,7 @@ int km_dokey(enum MenuType menu)
       }
 
       generic_tokenize_push_string(map->macro, mutt_push_macro_event);
-      map = STAILQ_FIRST(&Keymaps[menu]);
+      node = root;
       pos = 0;
     }
   }
@@ -1526,6 +1647,7 @@ enum CommandResult mutt_parse_unbind(struct Buffer *buf, struct Buffer *s,
     if (all_keys)
     {
       km_unbind_all(&Keymaps[i], data);
+      KeyTrieValid[i] = false;
       km_bindkey("<enter>", MENU_GENERIC, OP_GENERIC_SELECT_ENTRY);
       km_bindkey("<return>", MENU_GENERIC, OP_GENERIC_SELECT_ENTRY);
       km_bindkey("<enter>", MENU_MAIN, OP_DISPLAY_MESSAGE);
@@ -1700,5 +1822,7 @@ void mutt_keys_free(void)
   for (int i = 0; i < MENU_MAX; i++)
   {
     mutt_keymaplist_free(&Keymaps[i]);
+    keytrie_free(&KeyTrie[i]);
+    KeyTrieValid[i] = false;
   }
 }
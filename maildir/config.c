@@ -35,6 +35,7 @@
 
 // clang-format off
 bool  C_CheckNew;                 ///< Config: (maildir,mh) Check for new mail while the mailbox is open
+bool  C_MaildirBatchFsync;        ///< Config: Flush batched maildir commits with one round of fsyncs
 bool  C_MaildirCheckCur;          ///< Config: Check both 'new' and 'cur' directories for new mail
 #ifdef USE_HCACHE
 bool  C_MaildirHeaderCacheVerify; ///< Config: (hcache) Check for maildir changes when opening mailbox
@@ -51,6 +52,9 @@ struct ConfigDef MaildirVars[] = {
   { "check_new", DT_BOOL, &C_CheckNew, true, 0, NULL,
     "(maildir,mh) Check for new mail while the mailbox is open"
   },
+  { "maildir_batch_fsync", DT_BOOL, &C_MaildirBatchFsync, false, 0, NULL,
+    "Batch maildir commits and fsync them together at the end of the operation"
+  },
   { "maildir_check_cur", DT_BOOL, &C_MaildirCheckCur, false, 0, NULL,
     "Check both 'new' and 'cur' directories for new mail"
   },
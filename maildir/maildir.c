@@ -42,6 +42,9 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <utime.h>
+#ifdef USE_FMEMOPEN
+#include <sys/mman.h>
+#endif
 #include "private.h"
 #include "mutt/lib.h"
 #include "email/lib.h"
@@ -202,6 +205,80 @@ void maildir_gen_flags(char *dest, size_t destlen, struct Email *e)
   }
 }
 
+/* Group-commit state: while a batch is open, committed messages skip their
+ * per-file fsync and the whole batch is made durable in maildir_batch_end() */
+static int BatchDepth = 0; ///< Nesting depth of open batches
+static struct ListHead BatchPaths = STAILQ_HEAD_INITIALIZER(BatchPaths);
+
+/**
+ * maildir_batch_begin - Start a group-commit batch
+ *
+ * While a batch is open and $maildir_batch_fsync is set,
+ * maildir_commit_message() defers its fsync; maildir_batch_end() flushes all
+ * the batched messages at once.  Batches may nest.
+ */
+void maildir_batch_begin(void)
+{
+  BatchDepth++;
+}
+
+/**
+ * maildir_batch_end - Finish a group-commit batch and make it durable
+ * @param m Mailbox the messages were committed to
+ * @retval  0 Success - every batched message is on disk
+ * @retval -1 At least one message could not be flushed
+ *
+ * Ordering guarantee: each message file is fsync'd before the cur/ and new/
+ * directories are, so a name that survives a crash always refers to complete
+ * message data.  Within the batch no ordering is promised - a crash may keep
+ * any subset of the batched messages.
+ */
+int maildir_batch_end(struct Mailbox *m)
+{
+  if (BatchDepth == 0)
+    return 0;
+  if (--BatchDepth != 0)
+    return 0;
+
+  int rc = 0;
+  struct ListNode *np = NULL;
+  STAILQ_FOREACH(np, &BatchPaths, entries)
+  {
+    const int fd = open(np->data, O_RDONLY);
+    if (fd < 0)
+    {
+      /* a later sync may have renamed it; only a real error counts */
+      if (errno != ENOENT)
+        rc = -1;
+      continue;
+    }
+    if (fsync(fd) != 0)
+      rc = -1;
+    close(fd);
+  }
+
+  if (!STAILQ_EMPTY(&BatchPaths) && m)
+  {
+    /* directory entries last: contents are durable before the names are */
+    static const char *subdirs[] = { "cur", "new" };
+    struct Buffer *dir = mutt_buffer_pool_get();
+    for (size_t i = 0; i < mutt_array_size(subdirs); i++)
+    {
+      mutt_buffer_printf(dir, "%s/%s", mailbox_path(m), subdirs[i]);
+      const int fd = open(mutt_b2s(dir), O_RDONLY);
+      if (fd < 0)
+        continue;
+      if (fsync(fd) != 0)
+        rc = -1;
+      close(fd);
+    }
+    mutt_buffer_pool_release(&dir);
+  }
+
+  mutt_list_free(&BatchPaths);
+  return rc;
+}
+
 /**
  * maildir_commit_message - Commit a message to a maildir folder
  * @param m   Mailbox
@@ -232,7 +309,8 @@ int maildir_commit_message(struct Mailbox *m, struct Message *msg, struct Email
   char suffix[16];
   int rc = 0;
 
-  if (mutt_file_fsync_close(&msg->fp))
+  const bool batch = (BatchDepth > 0) && C_MaildirBatchFsync;
+  if (batch ? (mutt_file_fclose(&msg->fp) != 0) : (mutt_file_fsync_close(&msg->fp) != 0))
   {
     mutt_perror(_("Could not flush message to disk"));
     return -1;
@@ -263,6 +341,9 @@ int maildir_commit_message(struct Mailbox *m, struct Message *msg, struct Email
 
     if (mutt_file_safe_rename(msg->path, mutt_b2s(full)) == 0)
     {
+      if (batch)
+        mutt_list_insert_tail(&BatchPaths, mutt_str_dup(mutt_b2s(full)));
+
       /* Adjust the mtime on the file to match the time at which this
        * message was received.  Currently this is only set when copying
        * messages between mailboxes, so we test to ensure that it is
@@ -445,7 +526,13 @@ int maildir_sync_message(struct Mailbox *m, int msgno)
     /* record that the message is possibly marked as trashed on disk */
     e->trash = e->deleted;
 
-    if (rename(mutt_b2s(oldpath), mutt_b2s(fullpath)) != 0)
+    /* rename relative to the cached dirfd, so expunging thousands of
+     * messages doesn't re-resolve the mailbox path once per rename */
+    const int dirfd = maildir_mdata_dirfd(m);
+    const int rc_rename = (dirfd >= 0) ?
+                              renameat(dirfd, e->path, dirfd, mutt_b2s(partpath)) :
+                              rename(mutt_b2s(oldpath), mutt_b2s(fullpath));
+    if (rc_rename != 0)
     {
       mutt_perror("rename");
       rc = -1;
@@ -511,12 +598,17 @@ int maildir_parse_dir(struct Mailbox *m, struct MdEmailArray *mda,
   bool is_old = false;
   struct MdEmail *entry = NULL;
   struct Email *e = NULL;
+  char path[PATH_MAX];
 
   struct Buffer *buf = mutt_buffer_pool_get();
+  const int span = mutt_trace_start("maildir_parse_dir");
 
   mutt_buffer_printf(buf, "%s/%s", mailbox_path(m), subdir);
   is_old = C_MarkOld ? mutt_str_equal("cur", subdir) : false;
 
+  /* Format the subdir prefix once; only the filename changes per entry */
+  const size_t prefix_len = snprintf(path, sizeof(path), "%s/", subdir);
+
   DIR *dirp = opendir(mutt_b2s(buf));
   if (!dirp)
   {
@@ -529,6 +621,17 @@ int maildir_parse_dir(struct Mailbox *m, struct MdEmailArray *mda,
     if (*de->d_name == '.')
       continue;
 
+#ifdef DT_REG
+    /* Skip stray subdirectories and the like without paying for a stat() */
+    if ((de->d_type != DT_REG) && (de->d_type != DT_LNK) && (de->d_type != DT_UNKNOWN))
+      continue;
+#endif
+
+    /* Fixed-headroom growth means thousands of reallocs on big maildirs;
+     * grow the array geometrically instead */
+    if (ARRAY_SIZE(mda) == mda->capacity)
+      ARRAY_RESERVE(mda, (2 * mda->capacity) + 128);
+
     /* FOO - really ignore the return value? */
     mutt_debug(LL_DEBUG2, "queueing %s\n", de->d_name);
 
@@ -542,8 +645,8 @@ int maildir_parse_dir(struct Mailbox *m, struct MdEmailArray *mda,
     if (m->verbose && progress)
       mutt_progress_update(progress, ARRAY_SIZE(mda) + 1, -1);
 
-    mutt_buffer_printf(buf, "%s/%s", subdir, de->d_name);
-    e->path = mutt_buffer_strdup(buf);
+    mutt_str_copy(path + prefix_len, de->d_name, sizeof(path) - prefix_len);
+    e->path = mutt_str_dup(path);
 
     entry = maildir_entry_new();
     entry->email = e;
@@ -556,12 +659,14 @@ int maildir_parse_dir(struct Mailbox *m, struct MdEmailArray *mda,
   if (SigInt == 1)
   {
     SigInt = 0;
-    return -2; /* action aborted */
+    rc = -2; /* action aborted */
+    goto cleanup;
   }
 
   ARRAY_SORT(mda, md_cmp_inode);
 
 cleanup:
+  mutt_trace_end(span);
   mutt_buffer_pool_release(&buf);
 
   return rc;
@@ -591,18 +696,70 @@ void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
 {
   char fn[PATH_MAX];
 
+  struct MdEmail *md = NULL;
+  struct MdEmail **mdp = NULL;
+
 #ifdef USE_HCACHE
   struct HeaderCache *hc = mutt_hcache_open(C_HeaderCache, mailbox_path(m), NULL);
+
+  /* Resolve all the cached headers in one batched sweep, instead of one
+   * point lookup per message */
+  const size_t num = ARRAY_SIZE(mda);
+  const char **keys = mutt_mem_calloc(num, sizeof(const char *));
+  size_t *keylens = mutt_mem_calloc(num, sizeof(size_t));
+  struct HCacheEntry *hces = mutt_mem_calloc(num, sizeof(struct HCacheEntry));
+  if (hc)
+  {
+    ARRAY_FOREACH(mdp, mda)
+    {
+      md = *mdp;
+      if (!md || !md->email || md->header_parsed)
+        continue;
+
+      keys[ARRAY_FOREACH_IDX] = md->email->path + 3;
+      keylens[ARRAY_FOREACH_IDX] = maildir_hcache_keylen(keys[ARRAY_FOREACH_IDX]);
+    }
+    mutt_hcache_fetch_multi(hc, keys, keylens, num, 0, hces);
+  }
 #endif
 
-  struct MdEmail *md = NULL;
-  struct MdEmail **mdp = NULL;
+  bool aborted = false;
+  size_t advised = 0;
+
   ARRAY_FOREACH(mdp, mda)
   {
     md = *mdp;
     if (!md || !md->email || md->header_parsed)
       continue;
 
+    /* keep a window of kernel readahead in flight, so parsing a header
+     * overlaps the disk reads for the next ones instead of alternating
+     * with them - on a cold cache that I/O wait dominates the open */
+    for (; advised <= (size_t) ARRAY_FOREACH_IDX + 32; advised++)
+    {
+      struct MdEmail **madvp = ARRAY_GET(mda, advised);
+      if (!madvp)
+        break;
+      struct MdEmail *madv = *madvp;
+      if (madv && madv->email && !madv->header_parsed)
+      {
+        snprintf(fn, sizeof(fn), "%s/%s", mailbox_path(m), madv->email->path);
+        mutt_file_advise_willneed(fn);
+      }
+    }
+
+    if (aborted || (SigInt == 1))
+    {
+      /* Interrupted - drop the unparsed remainder so the caller presents
+       * only the messages whose headers were read before the Ctrl-C */
+      aborted = true;
+#ifdef USE_HCACHE
+      email_free(&hces[ARRAY_FOREACH_IDX].email);
+#endif
+      email_free(&md->email);
+      continue;
+    }
+
     if (m->verbose && progress)
       mutt_progress_update(progress, ARRAY_FOREACH_IDX, -1);
 
@@ -616,9 +773,7 @@ void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
       rc = stat(fn, &lastchanged);
     }
 
-    const char *key = md->email->path + 3;
-    size_t keylen = maildir_hcache_keylen(key);
-    struct HCacheEntry hce = mutt_hcache_fetch(hc, key, keylen, 0);
+    struct HCacheEntry hce = hces[ARRAY_FOREACH_IDX];
 
     if (hce.email && (rc == 0) && (lastchanged.st_mtime <= hce.uidvalidity))
     {
@@ -633,12 +788,15 @@ void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
     else
 #endif
     {
+#ifdef USE_HCACHE
+      email_free(&hce.email); /* stale entry - the file has changed on disk */
+#endif
       if (maildir_parse_message(m->type, fn, md->email->old, md->email))
       {
         md->header_parsed = true;
 #ifdef USE_HCACHE
-        key = md->email->path + 3;
-        keylen = maildir_hcache_keylen(key);
+        const char *key = md->email->path + 3;
+        size_t keylen = maildir_hcache_keylen(key);
         mutt_hcache_store(hc, key, keylen, md->email, 0);
 #endif
       }
@@ -646,7 +804,13 @@ void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
         email_free(&md->email);
     }
   }
+
+  if (aborted)
+    SigInt = 0;
 #ifdef USE_HCACHE
+  FREE(&keys);
+  FREE(&keylens);
+  FREE(&hces);
   mutt_hcache_close(hc);
 #endif
 }
@@ -872,14 +1036,19 @@ struct Email *maildir_parse_stream(enum MailboxType type, FILE *fp,
   }
   e->env = mutt_rfc822_read_header(fp, e, false, false);
 
-  struct stat st;
-  fstat(fileno(fp), &st);
-
   if (!e->received)
     e->received = e->date_sent;
 
   /* always update the length since we have fresh information available. */
-  e->body->length = st.st_size - e->body->offset;
+  struct stat st;
+  if (fstat(fileno(fp), &st) == 0)
+    e->body->length = st.st_size - e->body->offset;
+  else
+  {
+    /* memory-backed stream (fmemopen) - no file descriptor to stat */
+    fseeko(fp, 0, SEEK_END);
+    e->body->length = ftello(fp) - e->body->offset;
+  }
 
   e->index = -1;
 
@@ -894,6 +1063,60 @@ struct Email *maildir_parse_stream(enum MailboxType type, FILE *fp,
   return e;
 }
 
+#ifdef USE_FMEMOPEN
+/**
+ * maildir_parse_map - Parse a Maildir message from a memory map
+ * @param type   Mailbox type, e.g. #MUTT_MAILDIR
+ * @param fname  Message filename
+ * @param is_old true, if the email is old (read)
+ * @param e      Email to populate (OPTIONAL)
+ * @retval ptr  Populated Email
+ * @retval NULL File couldn't be mapped, caller should fall back to stdio
+ *
+ * Map the whole message read-only and let the header parser work over the
+ * mapped bytes instead of filling a stdio buffer with read(2) per block.
+ * Only the normalized header values end up being copied out of the map.
+ */
+static struct Email *maildir_parse_map(enum MailboxType type, const char *fname,
+                                       bool is_old, struct Email *e)
+{
+  const int fd = open(fname, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+
+  struct stat st;
+  if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_size == 0))
+  {
+    close(fd);
+    return NULL;
+  }
+
+  void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (map == MAP_FAILED)
+  {
+    close(fd);
+    return NULL;
+  }
+
+  FILE *fp = fmemopen(map, st.st_size, "r");
+  if (!fp)
+  {
+    munmap(map, st.st_size);
+    close(fd);
+    return NULL;
+  }
+
+  e = maildir_parse_stream(type, fp, fname, is_old, e);
+  mutt_file_fclose(&fp);
+  munmap(map, st.st_size);
+  /* header scans walk the whole mailbox; don't let them evict pages the
+   * user is actually reading */
+  mutt_file_advise_dontneed(fd);
+  close(fd);
+  return e;
+}
+#endif
+
 /**
  * maildir_parse_message - Actually parse a maildir message
  * @param type   Mailbox type, e.g. #MUTT_MAILDIR
@@ -908,11 +1131,20 @@ struct Email *maildir_parse_stream(enum MailboxType type, FILE *fp,
 struct Email *maildir_parse_message(enum MailboxType type, const char *fname,
                                     bool is_old, struct Email *e)
 {
+#ifdef USE_FMEMOPEN
+  struct Email *e_map = maildir_parse_map(type, fname, is_old, e);
+  if (e_map)
+    return e_map;
+#endif
+
   FILE *fp = fopen(fname, "r");
   if (!fp)
     return NULL;
 
   e = maildir_parse_stream(type, fp, fname, is_old, e);
+  /* header scans walk the whole mailbox; don't let them evict pages the
+   * user is actually reading */
+  mutt_file_advise_dontneed(fileno(fp));
   mutt_file_fclose(&fp);
   return e;
 }
@@ -933,8 +1165,6 @@ int maildir_sync_mailbox_message(struct Mailbox *m, int msgno, struct HeaderCach
 
   if (e->deleted && !C_MaildirTrash)
   {
-    char path[PATH_MAX];
-    snprintf(path, sizeof(path), "%s/%s", mailbox_path(m), e->path);
 #ifdef USE_HCACHE
     if (hc)
     {
@@ -943,7 +1173,15 @@ int maildir_sync_mailbox_message(struct Mailbox *m, int msgno, struct HeaderCach
       mutt_hcache_delete_record(hc, key, keylen);
     }
 #endif
-    unlink(path);
+    const int dirfd = maildir_mdata_dirfd(m);
+    if (dirfd >= 0)
+      unlinkat(dirfd, e->path, 0);
+    else
+    {
+      char path[PATH_MAX];
+      snprintf(path, sizeof(path), "%s/%s", mailbox_path(m), e->path);
+      unlink(path);
+    }
   }
   else if (e->changed || e->attach_del ||
            ((C_MaildirTrash || e->trash) && (e->deleted != e->trash)))
@@ -1029,7 +1267,14 @@ int maildir_open_message(struct Mailbox *m, struct Message *msg, int msgno)
 
   snprintf(path, sizeof(path), "%s/%s", mailbox_path(m), e->path);
 
-  msg->fp = fopen(path, "r");
+  const int dirfd = maildir_mdata_dirfd(m);
+  if (dirfd >= 0)
+  {
+    const int fd = openat(dirfd, e->path, O_RDONLY);
+    msg->fp = (fd >= 0) ? fdopen(fd, "r") : NULL;
+  }
+  else
+    msg->fp = fopen(path, "r");
   if (!msg->fp && (errno == ENOENT))
     msg->fp = maildir_open_find_message(mailbox_path(m), e->path, NULL);
 
@@ -1166,6 +1411,67 @@ static int maildir_mbox_open_append(struct Mailbox *m, OpenMailboxFlags flags)
   return 0;
 }
 
+#ifdef USE_INOTIFY
+/**
+ * maildir_parse_events - Build a Maildir list from monitor events
+ * @param[in]  m      Mailbox
+ * @param[in]  events Complete set of events seen on new/ (and cur/, if watched)
+ * @param[out] mda    Array for the added/changed files
+ * @retval ptr  Hash of the removed files, keyed by their subdir-relative path
+ * @retval NULL No files were removed
+ *
+ * Instead of rescanning the whole directory, create entries for just the
+ * files named by the monitor's events.  A flag change made by another client
+ * shows up as a removal of the old name plus an arrival of the new one; the
+ * caller correlates the two through the canonical filename.
+ */
+static struct HashTable *maildir_parse_events(struct Mailbox *m,
+                                              struct MonitorEventArray *events,
+                                              struct MdEmailArray *mda)
+{
+  struct HashTable *removals = NULL;
+  struct HashTable *seen = mutt_hash_new(ARRAY_SIZE(events), MUTT_HASH_STRDUP_KEYS);
+  char path[PATH_MAX];
+
+  struct MonitorEvent *ev = NULL;
+  ARRAY_FOREACH(ev, events)
+  {
+    snprintf(path, sizeof(path), "%s/%s", ev->in_cur ? "cur" : "new", ev->name);
+
+    if (ev->removed)
+    {
+      if (!removals)
+        removals = mutt_hash_new(ARRAY_SIZE(events), MUTT_HASH_STRDUP_KEYS);
+      if (!mutt_hash_find(removals, path))
+        mutt_hash_insert(removals, path, ev->name);
+      continue;
+    }
+
+    /* several events can name the same file - only queue it once */
+    if (mutt_hash_find(seen, path))
+      continue;
+    mutt_hash_insert(seen, path, ev->name);
+
+    mutt_debug(LL_DEBUG2, "queueing %s from monitor event\n", path);
+
+    struct Email *e = email_new();
+    e->edata = maildir_edata_new();
+    e->edata_free = maildir_edata_free;
+    e->old = C_MarkOld ? ev->in_cur : false;
+    maildir_parse_flags(e, ev->name);
+
+    e->path = mutt_str_dup(path);
+
+    struct MdEmail *entry = maildir_entry_new();
+    entry->email = e;
+    ARRAY_ADD(mda, entry);
+  }
+
+  mutt_hash_free(&seen);
+  return removals;
+}
+#endif
+
 /**
  * maildir_mbox_check - Check for new mail - Implements MxOps::mbox_check()
  *
@@ -1219,16 +1525,30 @@ int maildir_mbox_check(struct Mailbox *m)
     return 0; /* nothing to do */
   }
 
+#ifdef USE_INOTIFY
+  /* If the monitor has a complete picture of what happened, handle just the
+   * named files instead of rescanning the directories.  cur/ is only watched
+   * for the current mailbox and the watch can fail, so a change there is
+   * handled incrementally only when the monitor vouches for its coverage. */
+  struct MonitorEventArray events = ARRAY_HEAD_INITIALIZER;
+  bool cur_covered = false;
+  const bool events_complete = mutt_monitor_take_events(&events, &cur_covered);
+  const bool incremental = events_complete && !ARRAY_EMPTY(&events) &&
+                           (!(changed & MMC_CUR_DIR) || cur_covered);
+#endif
+
   /* Update the modification times on the mailbox.
    *
    * The monitor code notices changes in the open mailbox too quickly.
    * In practice, this sometimes leads to all the new messages not being
    * noticed during the SAME group of mtime stat updates.  To work around
-   * the problem, don't update the stat times for a monitor caused check. */
+   * the problem, don't update the stat times for a monitor caused check.
+   * An event-driven check fully accounts for the changes, so its times
+   * can be trusted. */
 #ifdef USE_INOTIFY
-  if (MonitorContextChanged)
-    MonitorContextChanged = false;
-  else
+  const bool monitor_triggered = MonitorContextChanged;
+  MonitorContextChanged = false;
+  if (!monitor_triggered || incremental)
 #endif
   {
     mutt_file_get_stat_timespec(&mdata->mtime_cur, &st_cur, MUTT_STAT_MTIME);
@@ -1238,10 +1558,20 @@ int maildir_mbox_check(struct Mailbox *m)
   /* do a fast scan of just the filenames in
    * the subdirectories that have changed.  */
   struct MdEmailArray mda = ARRAY_HEAD_INITIALIZER;
-  if (changed & MMC_NEW_DIR)
-    maildir_parse_dir(m, &mda, "new", NULL);
-  if (changed & MMC_CUR_DIR)
-    maildir_parse_dir(m, &mda, "cur", NULL);
+#ifdef USE_INOTIFY
+  struct HashTable *removals = NULL;
+  if (incremental)
+  {
+    removals = maildir_parse_events(m, &events, &mda);
+  }
+  else
+#endif
+  {
+    if (changed & MMC_NEW_DIR)
+      maildir_parse_dir(m, &mda, "new", NULL);
+    if (changed & MMC_CUR_DIR)
+      maildir_parse_dir(m, &mda, "cur", NULL);
+  }
 
   /* we create a hash table keyed off the canonical (sans flags) filename
    * of each message we scanned.  This is used in the loop over the
@@ -1300,8 +1630,12 @@ int maildir_mbox_check(struct Mailbox *m)
     /* This message was not in the list of messages we just scanned.
      * Check to see if we have enough information to know if the
      * message has disappeared out from underneath us.  */
-    else if (((changed & MMC_NEW_DIR) && mutt_strn_equal(e->path, "new/", 4)) ||
-             ((changed & MMC_CUR_DIR) && mutt_strn_equal(e->path, "cur/", 4)))
+    else if (
+#ifdef USE_INOTIFY
+        incremental ? (removals && mutt_hash_find(removals, e->path)) :
+#endif
+            (((changed & MMC_NEW_DIR) && mutt_strn_equal(e->path, "new/", 4)) ||
+             ((changed & MMC_CUR_DIR) && mutt_strn_equal(e->path, "cur/", 4))))
     {
       /* This message disappeared, so we need to simulate a "reopen"
        * event.  We know it disappeared because we just scanned the
@@ -1321,6 +1655,10 @@ int maildir_mbox_check(struct Mailbox *m)
 
   /* destroy the file name hash */
   mutt_hash_free(&fnames);
+#ifdef USE_INOTIFY
+  mutt_hash_free(&removals);
+  mutt_monitor_events_free(&events);
+#endif
 
   /* If we didn't just get new mail, update the tables. */
   if (occult)
@@ -1357,6 +1695,29 @@ static int maildir_mbox_check_stats(struct Mailbox *m, int flags)
   bool check_stats = flags;
   bool check_new = true;
 
+  struct stat st_new = { 0 };
+  struct stat st_cur = { 0 };
+  struct Buffer *path = mutt_buffer_pool_get();
+  mutt_buffer_printf(path, "%s/new", mailbox_path(m));
+  bool have_new = (stat(mutt_b2s(path), &st_new) == 0);
+  mutt_buffer_printf(path, "%s/cur", mailbox_path(m));
+  bool have_cur = (stat(mutt_b2s(path), &st_cur) == 0);
+  mutt_buffer_pool_release(&path);
+
+  /* The counts can only change when new/ or cur/ does.  If neither directory
+   * has been modified since the last stats scan, and the user hasn't visited
+   * the mailbox in the meantime (which affects what counts as recent mail),
+   * keep the previous counts rather than re-reading both directories.  With
+   * many mailboxes in the sidebar, those readdir() passes dominate the cost
+   * of every poll.  */
+  if (check_stats && have_new && have_cur && (m->stats_last_checked.tv_sec != 0) &&
+      (mutt_file_stat_timespec_compare(&st_new, MUTT_STAT_MTIME, &m->stats_last_checked) <= 0) &&
+      (mutt_file_stat_timespec_compare(&st_cur, MUTT_STAT_MTIME, &m->stats_last_checked) <= 0) &&
+      (mutt_file_timespec_compare(&m->last_visited, &m->stats_last_checked) <= 0))
+  {
+    return m->msg_new;
+  }
+
   if (check_stats)
   {
     m->msg_count = 0;
@@ -1371,6 +1732,15 @@ static int maildir_mbox_check_stats(struct Mailbox *m, int flags)
   if (check_new || check_stats)
     maildir_check_dir(m, "cur", check_new, check_stats);
 
+  if (check_stats && have_new && have_cur)
+  {
+    /* remember the newer of the two mtimes so the next poll can tell whether
+     * anything has changed */
+    mutt_file_get_stat_timespec(&m->stats_last_checked, &st_new, MUTT_STAT_MTIME);
+    if (mutt_file_stat_timespec_compare(&st_cur, MUTT_STAT_MTIME, &m->stats_last_checked) > 0)
+      mutt_file_get_stat_timespec(&m->stats_last_checked, &st_cur, MUTT_STAT_MTIME);
+  }
+
   return m->msg_new;
 }
 
@@ -1403,14 +1773,20 @@ int maildir_mbox_sync(struct Mailbox *m)
     mutt_progress_init(&progress, msg, MUTT_PROGRESS_WRITE, m->msg_count);
   }
 
+  maildir_batch_begin();
   for (int i = 0; i < m->msg_count; i++)
   {
     if (m->verbose)
       mutt_progress_update(&progress, i, -1);
 
     if (maildir_sync_mailbox_message(m, i, hc) == -1)
+    {
+      maildir_batch_end(m);
       goto err;
+    }
   }
+  if (maildir_batch_end(m) != 0)
+    goto err;
 
 #ifdef USE_HCACHE
   if (m->type == MUTT_MAILDIR)
@@ -1551,6 +1927,23 @@ int maildir_msg_close(struct Mailbox *m, struct Message *msg)
   return mutt_file_fclose(&msg->fp);
 }
 
+/**
+ * maildir_msg_prefetch - Hint that an email will be needed soon - Implements MxOps::msg_prefetch()
+ *
+ * One file per message, so kernel readahead of that file is all there is to do.
+ */
+static int maildir_msg_prefetch(struct Mailbox *m, struct Email *e)
+{
+  if (!e->path)
+    return -1;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  mutt_buffer_printf(path, "%s/%s", mailbox_path(m), e->path);
+  mutt_file_advise_willneed(mutt_b2s(path));
+  mutt_buffer_pool_release(&path);
+  return 0;
+}
+
 /**
  * maildir_msg_save_hcache - Save message to the header cache - Implements MxOps::msg_save_hcache()
  */
@@ -1567,6 +1960,47 @@ static int maildir_msg_save_hcache(struct Mailbox *m, struct Email *e)
   return rc;
 }
 
+/**
+ * maildir_msg_transfer_hcache - Seed the destination's header cache after a save
+ * @param m    Destination Mailbox
+ * @param path Full path of the committed message file
+ * @param e    Source Email the message was copied from
+ *
+ * When a message is saved verbatim into another maildir, the in-memory Email
+ * already describes the file we just wrote - the destination shouldn't have
+ * to re-parse it (or miss its header cache) on the next open.  Store the
+ * source Email under the new filename's key, with the stream offsets rebased
+ * to the start of the file (an mbox source counts them from the start of the
+ * folder).
+ *
+ * Only the top-level Body is serialized by the header cache, so nested MIME
+ * offsets don't need fixing up here.
+ */
+void maildir_msg_transfer_hcache(struct Mailbox *m, const char *path, const struct Email *e)
+{
+#ifdef USE_HCACHE
+  if (!m || !path || !e || !e->body)
+    return;
+
+  struct HeaderCache *hc = mutt_hcache_open(C_HeaderCache, mailbox_path(m), NULL);
+  if (!hc)
+    return;
+
+  const char *key = strrchr(path, '/');
+  key = key ? (key + 1) : path;
+
+  struct Email e_tmp = *e;
+  struct Body b_tmp = *e->body;
+  e_tmp.body = &b_tmp;
+  b_tmp.hdr_offset -= e->offset;
+  b_tmp.offset -= e->offset;
+  e_tmp.offset = 0;
+
+  mutt_hcache_store(hc, key, maildir_hcache_keylen(key), &e_tmp, 0);
+  mutt_hcache_close(hc);
+#endif
+}
+
 /**
  * maildir_path_canon - Canonicalise a Mailbox path - Implements MxOps::path_canon()
  */
@@ -1645,6 +2079,7 @@ struct MxOps MxMaildirOps = {
   .msg_open_new     = maildir_msg_open_new,
   .msg_commit       = maildir_msg_commit,
   .msg_close        = maildir_msg_close,
+  .msg_prefetch     = maildir_msg_prefetch,
   .msg_padding_size = NULL,
   .msg_save_hcache  = maildir_msg_save_hcache,
   .tags_edit        = NULL,
@@ -27,6 +27,8 @@
  */
 
 #include "config.h"
+#include <fcntl.h>
+#include <unistd.h>
 #include "mutt/lib.h"
 #include "core/lib.h"
 #include "mdata.h"
@@ -39,7 +41,9 @@ void maildir_mdata_free(void **ptr)
   if (!ptr || !*ptr)
     return;
 
-  // struct MaildirMboxData *mdata = *ptr;
+  struct MaildirMboxData *mdata = *ptr;
+  if (mdata->dirfd >= 0)
+    close(mdata->dirfd);
   FREE(ptr);
 }
 
@@ -50,6 +54,7 @@ void maildir_mdata_free(void **ptr)
 struct MaildirMboxData *maildir_mdata_new(void)
 {
   struct MaildirMboxData *mdata = mutt_mem_calloc(1, sizeof(struct MaildirMboxData));
+  mdata->dirfd = -1;
   return mdata;
 }
 
@@ -64,3 +69,25 @@ struct MaildirMboxData *maildir_mdata_get(struct Mailbox *m)
     return NULL;
   return m->mdata;
 }
+
+/**
+ * maildir_mdata_dirfd - Get a directory descriptor for the Mailbox
+ * @param m Mailbox
+ * @retval num Descriptor, for use with openat(2) and friends
+ * @retval -1  Error
+ *
+ * Opened on first use and kept for the life of the Mailbox, so the ...at()
+ * calls in the sync and message-open paths don't re-resolve the mailbox path
+ * on every message - on NFS each resolution is a round trip.
+ */
+int maildir_mdata_dirfd(struct Mailbox *m)
+{
+  struct MaildirMboxData *mdata = maildir_mdata_get(m);
+  if (!mdata)
+    return -1;
+
+  if (mdata->dirfd < 0)
+    mdata->dirfd = open(mailbox_path(m), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+  return mdata->dirfd;
+}
@@ -35,8 +35,10 @@ struct MaildirMboxData
 {
   struct timespec mtime_cur;
   mode_t mh_umask;
+  int dirfd; ///< Cached O_DIRECTORY descriptor for the mailbox, or -1
 };
 
+int                     maildir_mdata_dirfd(struct Mailbox *m);
 void                    maildir_mdata_free(void **ptr);
 struct MaildirMboxData *maildir_mdata_get(struct Mailbox *m);
 struct MaildirMboxData *maildir_mdata_new(void);
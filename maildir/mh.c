@@ -593,6 +593,9 @@ struct Email *mh_parse_message(const char *fname, struct Email *e)
   e->body->length = st.st_size - e->body->offset;
   e->index = -1;
 
+  /* header scans walk the whole mailbox; don't let them evict pages the
+   * user is actually reading */
+  mutt_file_advise_dontneed(fileno(fp));
   mutt_file_fclose(&fp);
   return e;
 }
@@ -611,6 +614,8 @@ void mh_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda, struct Prog
   struct HeaderCache *hc = mutt_hcache_open(C_HeaderCache, mailbox_path(m), NULL);
 #endif
 
+  bool aborted = false;
+
   struct MdEmail *md = NULL;
   struct MdEmail **mdp = NULL;
   ARRAY_FOREACH(mdp, mda)
@@ -619,6 +624,15 @@ void mh_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda, struct Prog
     if (!md || !md->email || md->header_parsed)
       continue;
 
+    if (aborted || (SigInt == 1))
+    {
+      /* Interrupted - drop the unparsed remainder so the caller presents
+       * only the messages whose headers were read before the Ctrl-C */
+      aborted = true;
+      email_free(&md->email);
+      continue;
+    }
+
     if (m->verbose && progress)
       mutt_progress_update(progress, ARRAY_FOREACH_IDX, -1);
 
@@ -661,6 +675,9 @@ void mh_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda, struct Prog
         email_free(&md->email);
     }
   }
+
+  if (aborted)
+    SigInt = 0;
 #ifdef USE_HCACHE
   mutt_hcache_close(hc);
 #endif
@@ -1155,6 +1172,23 @@ int mh_msg_close(struct Mailbox *m, struct Message *msg)
   return mutt_file_fclose(&msg->fp);
 }
 
+/**
+ * mh_msg_prefetch - Hint that an email will be needed soon - Implements MxOps::msg_prefetch()
+ *
+ * One file per message, so kernel readahead of that file is all there is to do.
+ */
+static int mh_msg_prefetch(struct Mailbox *m, struct Email *e)
+{
+  if (!e->path)
+    return -1;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  mutt_buffer_printf(path, "%s/%s", mailbox_path(m), e->path);
+  mutt_file_advise_willneed(mutt_b2s(path));
+  mutt_buffer_pool_release(&path);
+  return 0;
+}
+
 /**
  * mh_path_canon - Canonicalise a Mailbox path - Implements MxOps::path_canon()
  */
@@ -1255,6 +1289,7 @@ struct MxOps MxMhOps = {
   .msg_open_new     = mh_msg_open_new,
   .msg_commit       = mh_msg_commit,
   .msg_close        = mh_msg_close,
+  .msg_prefetch     = mh_msg_prefetch,
   .msg_padding_size = NULL,
   .msg_save_hcache  = mh_msg_save_hcache,
   .tags_edit        = NULL,
@@ -90,6 +90,10 @@
 #ifdef USE_AUTOCRYPT
 #include "autocrypt/lib.h"
 #endif
+#ifdef USE_HCACHE
+#include "hcache/fts.h"
+#include "hcache/threads.h"
+#endif
 
 /* These Config Variables are only used in main.c */
 bool C_ResumeEditedDraftFiles; ///< Config: Resume editing previously saved draft files
@@ -162,6 +166,7 @@ static void usage(void)
   puts(_("  neomutt [-nRy] [-e <command>] [-F <config>] [-f <mailbox>] [-m <type>]"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -A <alias>"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -B"));
+  puts(_("  neomutt [-n] [-e <command>] [-F <config>] -C"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -D [-S] [-O]"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -d <level> -l <file>"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -G"));
@@ -180,6 +185,7 @@ static void usage(void)
   puts(_("  -a <file>     Attach one or more files to a message (must be the last option)\n"
          "                Add any addresses after the '--' argument"));
   puts(_("  -B            Run in batch mode (do not start the ncurses UI)"));
+  puts(_("  -C            Check all mailboxes, refreshing their caches, and exit"));
   puts(_("  -b <address>  Specify a blind carbon copy (Bcc) recipient"));
   puts(_("  -c <address>  Specify a carbon copy (Cc) recipient"));
   puts(_("  -D            Dump all config variables as 'name=value' pairs to stdout"));
@@ -200,6 +206,8 @@ static void usage(void)
   puts(_("  -m <type>     Specify a default mailbox format type for newly created folders\n"
          "                The type is either MH, MMDF, Maildir or mbox (case-insensitive)"));
   puts(_("  -n            Do not read the system-wide configuration file"));
+  puts(_("  -P            Profile the startup: record timing spans while the config is\n"
+         "                read and print the report to stderr (see also 'trace-report')"));
   puts(_("  -p            Resume a prior postponed message, if any"));
   puts(_("  -Q <variable> Query a configuration variable and print its value to stdout\n"
          "                (after the config has been read and any commands executed)\n"
@@ -249,6 +257,12 @@ static int start_curses(void)
   cbreak();
   noecho();
   nonl();
+#ifndef USE_SLANG_CURSES
+  /* Let refresh() use the terminal's insert/delete-line capabilities, so
+   * scrolling the index or pager by a line sends a handful of bytes instead
+   * of repainting every row - a big win on slow or high-latency links */
+  idlok(stdscr, true);
+#endif
 #ifdef HAVE_TYPEAHEAD
   typeahead(-1); /* simulate smooth scrolling */
 #endif
@@ -392,6 +406,8 @@ int main(int argc, char *argv[], char *envp[])
   bool one_liner = false;
   bool hide_sensitive = false;
   bool batch_mode = false;
+  bool check_caches = false;
+  bool profile_startup = false;
   bool edit_infile = false;
 #ifdef USE_DEBUG_PARSE_TEST
   bool test_config = false;
@@ -441,7 +457,7 @@ int main(int argc, char *argv[], char *envp[])
     }
 
     /* USE_NNTP 'g:G' */
-    i = getopt(argc, argv, "+A:a:Bb:F:f:c:Dd:l:Ee:g:GH:i:hm:nOpQ:RSs:TvxyzZ");
+    i = getopt(argc, argv, "+A:a:BCb:F:f:c:Dd:l:Ee:g:GH:i:hm:nOPpQ:RSs:TvxyzZ");
     if (i != EOF)
     {
       switch (i)
@@ -455,6 +471,9 @@ int main(int argc, char *argv[], char *envp[])
         case 'B':
           batch_mode = true;
           break;
+        case 'C':
+          check_caches = true;
+          break;
         case 'b':
           mutt_list_insert_tail(&bcc_list, mutt_str_dup(optarg));
           break;
@@ -506,6 +525,9 @@ int main(int argc, char *argv[], char *envp[])
         case 'O':
           one_liner = true;
           break;
+        case 'P':
+          profile_startup = true;
+          break;
         case 'p':
           sendflags |= SEND_POSTPONED;
           break;
@@ -609,11 +631,18 @@ int main(int argc, char *argv[], char *envp[])
     cs_str_reset(cs, "debug_level", NULL);
   }
 
+  if (profile_startup)
+  {
+    /* must be on before the config files are read */
+    cs_str_native_set(cs, "trace_spans", true, NULL);
+  }
+
   mutt_log_prep();
   if (dlevel)
     mutt_log_start();
 
   MuttLogger = log_disp_queue;
+  MuttLogCeiling = LL_MAX; /* capture everything until the level is known */
 
   log_translation();
 
@@ -639,11 +668,12 @@ int main(int argc, char *argv[], char *envp[])
 
   /* Check for a batch send. */
   if (!isatty(0) || !STAILQ_EMPTY(&queries) || !STAILQ_EMPTY(&alias_queries) ||
-      dump_variables || batch_mode)
+      dump_variables || batch_mode || check_caches)
   {
     OptNoCurses = true;
     sendflags = SEND_BATCH;
     MuttLogger = log_disp_terminal;
+    MuttLogCeiling = LL_MESSAGE; /* the terminal dispatcher drops debug lines */
     log_queue_flush(log_disp_terminal);
   }
 
@@ -665,11 +695,20 @@ int main(int argc, char *argv[], char *envp[])
   }
 
   /* set defaults and read init files */
+  const int init_span = mutt_trace_start("mutt_init");
   int rc2 = mutt_init(cs, flags & MUTT_CLI_NOSYSRC, &commands);
+  mutt_trace_end(init_span);
   mutt_list_free(&commands);
   if (rc2 != 0)
     goto main_curses;
 
+  if (profile_startup)
+  {
+    /* The startup stages have all run; the spans stay available to the
+     * trace-report command afterwards */
+    mutt_trace_report(stderr);
+  }
+
   mutt_init_abort_key();
 
   /* The command line overrides the config */
@@ -761,11 +800,21 @@ int main(int argc, char *argv[], char *envp[])
     goto main_curses; // TEST20: neomutt -A alias
   }
 
+  if (check_caches)
+  {
+    int failed = 0;
+    const int opened = mx_mbox_warm_all(&failed);
+    mutt_message(_("%d mailboxes checked, %d failed"), opened, failed);
+    rc = (failed == 0) ? 0 : 1;
+    goto main_curses; // TEST51: neomutt -C
+  }
+
   if (!OptNoCurses)
   {
     mutt_curses_set_color(MT_COLOR_NORMAL);
     clear();
     MuttLogger = log_disp_curses;
+    MuttLogCeiling = C_DebugLevel;
     log_queue_flush(log_disp_curses);
     log_queue_set_max_size(100);
   }
@@ -1257,6 +1306,7 @@ int main(int argc, char *argv[], char *envp[])
 main_ok:
   rc = 0;
 main_curses:
+  mutt_sendmail_flush();
   mutt_endwin();
   mutt_unlink_temp_attachments();
   /* Repeat the last message to the user */
@@ -1264,6 +1314,7 @@ main_curses:
     puts(ErrorBuf);
 main_exit:
   MuttLogger = log_disp_queue;
+  MuttLogCeiling = LL_MAX;
   mutt_buffer_dealloc(&folder);
   mutt_buffer_dealloc(&expanded_infile);
   mutt_buffer_dealloc(&tempfile);
@@ -1274,12 +1325,24 @@ main_exit:
   mutt_envlist_free();
   mutt_browser_cleanup();
   mutt_commands_cleanup();
+  mutt_content_cache_cleanup();
+  mutt_decode_cache_cleanup();
+  mutt_idna_cache_cleanup();
+  mutt_mime_type_cache_cleanup();
+  mutt_expando_cleanup();
+#ifdef USE_HCACHE
+  mutt_fts_shutdown();
+  mutt_thread_cache_shutdown();
+#endif
+  mutt_stats_log();
   crypt_cleanup();
   mutt_opts_free();
   mutt_keys_free();
   myvarlist_free(&MyVars);
   mutt_prex_free();
+  mutt_ch_cache_cleanup();
   neomutt_free(&NeoMutt);
+  mutt_intern_cleanup();
   cs_free(&cs);
   log_queue_flush(log_disp_terminal);
   log_queue_empty();
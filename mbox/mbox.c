@@ -51,6 +51,7 @@
 #include "copy.h"
 #include "mutt_globals.h"
 #include "mutt_header.h"
+#include "mutt_journal.h"
 #include "muttlib.h"
 #include "mx.h"
 #include "progress.h"
@@ -465,15 +466,21 @@ static int mbox_parse_mailbox(struct Mailbox *m)
            * are in this message.  */
           if (e_cur->lines == 0)
           {
-            int cl = e_cur->body->length;
+            LOFF_T cl = e_cur->body->length;
 
-            /* count the number of lines in this message */
+            /* count the number of lines in this message, a block at a time -
+             * memchr() is far faster than reading char by char */
             if ((loc < 0) || (fseeko(adata->fp, loc, SEEK_SET) != 0))
               mutt_debug(LL_DEBUG1, "#2 fseek() failed\n");
-            while (cl-- > 0)
+            while (cl > 0)
             {
-              if (fgetc(adata->fp) == '\n')
+              size_t chunk = (cl < (LOFF_T) sizeof(buf)) ? cl : sizeof(buf);
+              chunk = fread(buf, 1, chunk, adata->fp);
+              if (chunk == 0)
+                break;
+              for (const char *p = buf; (p = memchr(p, '\n', buf + chunk - p)); p++)
                 e_cur->lines++;
+              cl -= chunk;
             }
           }
 
@@ -528,11 +535,73 @@ static int mbox_parse_mailbox(struct Mailbox *m)
   return 0;
 }
 
+/**
+ * mbox_unchanged_prefix - Count the leading messages untouched by a change
+ * @param m Mailbox
+ * @retval num Messages at the start of the file that can be kept
+ *
+ * When the mailbox has been modified, messages before the modification still
+ * have valid offsets.  A message is presumed unchanged if its "From " line is
+ * still at its recorded offset; messages are dropped from the back of the
+ * prefix until the last one is again followed by a separator (or the end of
+ * the file), in case the change landed inside it.
+ *
+ * Like the append check in mbox_mbox_check(), this is a heuristic: an edit
+ * that moves no separator (and doesn't change the file size) is invisible.
+ */
+static int mbox_unchanged_prefix(struct Mailbox *m)
+{
+  FILE *fp = mutt_file_fopen(mailbox_path(m), "r");
+  if (!fp)
+    return 0;
+
+  struct stat st;
+  if (fstat(fileno(fp), &st) != 0)
+  {
+    mutt_file_fclose(&fp);
+    return 0;
+  }
+
+  char buf[1024];
+  int keep = 0;
+
+  while (keep < m->msg_count)
+  {
+    struct Email *e = m->emails[keep];
+    if (!e || (e->body->length < 0) || (fseeko(fp, e->offset, SEEK_SET) != 0) ||
+        !fgets(buf, sizeof(buf), fp) || !mutt_str_startswith(buf, "From "))
+    {
+      break;
+    }
+    keep++;
+  }
+
+  while (keep > 0)
+  {
+    struct Email *e = m->emails[keep - 1];
+    LOFF_T end = e->body->offset + e->body->length + 1;
+    if (end == st.st_size)
+      break; /* the file ends exactly after this message */
+    if ((end < st.st_size) && (fseeko(fp, end, SEEK_SET) == 0) &&
+        fgets(buf, sizeof(buf), fp) && mutt_str_startswith(buf, "From "))
+    {
+      break;
+    }
+    keep--;
+  }
+
+  mutt_file_fclose(&fp);
+  return keep;
+}
+
 /**
  * reopen_mailbox - Close and reopen a mailbox
  * @param m          Mailbox
  * @retval >0 Success, e.g. #MUTT_REOPENED, #MUTT_NEW_MAIL
  * @retval -1 Error
+ *
+ * Messages before the first change to the file are kept as they are - only
+ * the changed tail is re-parsed, and only its flags need to be recovered.
  */
 static int reopen_mailbox(struct Mailbox *m)
 {
@@ -564,27 +633,50 @@ static int reopen_mailbox(struct Mailbox *m)
   e_old = NULL;
   old_msg_count = 0;
 
-  /* simulate a close */
+  /* messages from before the first change to the file can be kept */
+  const int keep = (m->type == MUTT_MBOX) ? mbox_unchanged_prefix(m) : 0;
+  LOFF_T resume = 0;
+  if (keep > 0)
+  {
+    struct Email *e = m->emails[keep - 1];
+    resume = e->body->offset + e->body->length + 1;
+  }
+
+  /* simulate a close (of the changed part) */
   mutt_hash_free(&m->id_hash);
   mutt_hash_free(&m->subj_hash);
   mutt_hash_free(&m->label_hash);
-  FREE(&m->v2r);
   if (m->readonly)
   {
-    for (int i = 0; i < m->msg_count; i++)
+    for (int i = keep; i < m->msg_count; i++)
       email_free(&(m->emails[i])); /* nothing to do! */
-    FREE(&m->emails);
+    if (keep == 0)
+      FREE(&m->emails);
   }
   else
   {
     /* save the old headers */
-    old_msg_count = m->msg_count;
-    e_old = m->emails;
-    m->emails = NULL;
+    old_msg_count = m->msg_count - keep;
+    if (keep == 0)
+    {
+      e_old = m->emails;
+      m->emails = NULL;
+    }
+    else
+    {
+      e_old = mutt_mem_calloc(old_msg_count, sizeof(struct Email *));
+      memcpy(e_old, &m->emails[keep], old_msg_count * sizeof(struct Email *));
+    }
   }
+  if (m->emails)
+    memset(&m->emails[keep], 0, (m->msg_count - keep) * sizeof(struct Email *));
 
-  m->email_max = 0; /* force allocation of new headers */
-  m->msg_count = 0;
+  if (keep == 0)
+  {
+    FREE(&m->v2r);
+    m->email_max = 0; /* force allocation of new headers */
+  }
+  m->msg_count = keep;
   m->vcount = 0;
   m->msg_tagged = 0;
   m->msg_deleted = 0;
@@ -592,6 +684,11 @@ static int reopen_mailbox(struct Mailbox *m)
   m->msg_unread = 0;
   m->msg_flagged = 0;
   m->changed = false;
+  for (int i = 0; i < keep; i++)
+  {
+    if (m->emails[i]->changed)
+      m->changed = true;
+  }
   m->id_hash = NULL;
   m->subj_hash = NULL;
   mutt_make_label_hash(m);
@@ -606,7 +703,12 @@ static int reopen_mailbox(struct Mailbox *m)
       if (!adata->fp)
         rc = -1;
       else if (m->type == MUTT_MBOX)
+      {
+        /* resume parsing after the last unchanged message */
+        if ((resume > 0) && (fseeko(adata->fp, resume, SEEK_SET) != 0))
+          mutt_debug(LL_DEBUG1, "#4 fseek() failed\n");
         rc = mbox_parse_mailbox(m);
+      }
       else
         rc = mmdf_parse_mailbox(m);
       break;
@@ -633,7 +735,7 @@ static int reopen_mailbox(struct Mailbox *m)
 
   if (!m->readonly)
   {
-    for (int i = 0; i < m->msg_count; i++)
+    for (int i = keep; i < m->msg_count; i++)
     {
       bool found = false;
 
@@ -642,7 +744,7 @@ static int reopen_mailbox(struct Mailbox *m)
        * "advanced" towards the beginning of the folder, so we begin the
        * search at index "i" */
       int j;
-      for (j = i; j < old_msg_count; j++)
+      for (j = i - keep; j < old_msg_count; j++)
       {
         if (!e_old[j])
           continue;
@@ -654,7 +756,7 @@ static int reopen_mailbox(struct Mailbox *m)
       }
       if (!found)
       {
-        for (j = 0; (j < i) && (j < old_msg_count); j++)
+        for (j = 0; (j < (i - keep)) && (j < old_msg_count); j++)
         {
           if (!e_old[j])
             continue;
@@ -935,6 +1037,9 @@ static int mbox_mbox_open(struct Mailbox *m)
     return -1;
   }
 
+  /* a larger stdio buffer speeds up the initial scan of big spools */
+  setvbuf(adata->fp, NULL, _IOFBF, 65536);
+
   mutt_sig_block();
   if (mbox_lock_mailbox(m, false, true) == -1)
   {
@@ -958,6 +1063,14 @@ static int mbox_mbox_open(struct Mailbox *m)
 
   mbox_unlock_mailbox(m);
   mutt_sig_unblock();
+
+  if (rc == 0)
+  {
+    /* recover flag changes a crashed session left behind, before the
+     * caller tallies the flag counters */
+    mutt_journal_replay(m);
+  }
+
   return rc;
 }
 
@@ -993,6 +1106,10 @@ static int mbox_mbox_open_append(struct Mailbox *m, OpenMailboxFlags flags)
       return -1;
     }
 
+    /* let a typical message image accumulate in userspace, so an appended
+     * message hits the file as one write when msg_commit() flushes it */
+    setvbuf(adata->fp, NULL, _IOFBF, 65536);
+
     if (mbox_lock_mailbox(m, true, true) != false)
     {
       mutt_error(_("Couldn't lock %s"), mailbox_path(m));
@@ -1152,6 +1269,8 @@ static int mbox_mbox_sync(struct Mailbox *m)
   int rc = -1;
   int need_sort = 0; /* flag to resort mailbox if new mail arrives */
   int first = -1;    /* first message to be written */
+  int last = -1;     /* last changed/deleted message */
+  bool tail_in_place = false; /* unchanged tail can stay where it is */
   LOFF_T offset;     /* location in mailbox to write changed messages */
   struct stat statbuf;
   struct MUpdate *new_offset = NULL;
@@ -1240,6 +1359,15 @@ static int mbox_mbox_sync(struct Mailbox *m)
   /* where to start overwriting */
   offset = m->emails[i]->offset;
 
+  /* find the last changed/deleted message.  everything after it is
+   * byte-for-byte unchanged and doesn't need to be re-serialized.  */
+  last = m->msg_count - 1;
+  while ((last > first) && !m->emails[last]->deleted &&
+         !m->emails[last]->changed && !m->emails[last]->attach_del)
+  {
+    last--;
+  }
+
   /* the offset stored in the header does not include the MMDF_SEP, so make
    * sure we seek to the correct location */
   if (m->type == MUTT_MMDF)
@@ -1269,7 +1397,7 @@ static int mbox_mbox_sync(struct Mailbox *m)
     old_offset[i - first].lines = m->emails[i]->lines;
     old_offset[i - first].length = m->emails[i]->body->length;
 
-    if (!m->emails[i]->deleted)
+    if ((i <= last) && !m->emails[i]->deleted)
     {
       j++;
 
@@ -1321,6 +1449,40 @@ static int mbox_mbox_sync(struct Mailbox *m)
     }
   }
 
+  /* messages after the last change are unchanged on disk.  if the rewritten
+   * region is the same length as the region it replaces, they can stay where
+   * they are; otherwise splice them into the temp file with one raw copy
+   * instead of parsing and re-serializing each of them.  */
+  if (last + 1 < m->msg_count)
+  {
+    LOFF_T tail_start = m->emails[last + 1]->offset;
+    if (m->type == MUTT_MMDF)
+      tail_start -= (sizeof(MMDF_SEP) - 1);
+
+    const LOFF_T delta = (ftello(fp) + offset) - tail_start;
+    if (delta == 0)
+    {
+      tail_in_place = true;
+    }
+    else
+    {
+      if ((fseeko(adata->fp, tail_start, SEEK_SET) != 0) ||
+          (mutt_file_copy_stream(adata->fp, fp) < 0))
+      {
+        mutt_perror(mutt_b2s(tempfile));
+        goto bail;
+      }
+    }
+
+    for (i = last + 1; i < m->msg_count; i++)
+    {
+      new_offset[i - first].hdr = m->emails[i]->offset + delta;
+      new_offset[i - first].body = m->emails[i]->body->offset + delta;
+      if (delta != 0)
+        mutt_body_free(&m->emails[i]->body->parts);
+    }
+  }
+
   if (mutt_file_fclose(&fp) != 0)
   {
     mutt_debug(LL_DEBUG1, "mutt_file_fclose (&) returned non-zero\n");
@@ -1379,11 +1541,19 @@ static int mbox_mbox_sync(struct Mailbox *m)
     }
     if (i >= 0)
     {
-      m->size = ftello(adata->fp); /* update the mailbox->size of the mailbox */
-      if ((m->size < 0) || (ftruncate(fileno(adata->fp), m->size) != 0))
+      if (tail_in_place)
       {
-        i = -1;
-        mutt_debug(LL_DEBUG1, "ftruncate() failed\n");
+        /* the unchanged tail was left on disk, don't truncate it away */
+        m->size = statbuf.st_size;
+      }
+      else
+      {
+        m->size = ftello(adata->fp); /* update the mailbox->size of the mailbox */
+        if ((m->size < 0) || (ftruncate(fileno(adata->fp), m->size) != 0))
+        {
+          i = -1;
+          mutt_debug(LL_DEBUG1, "ftruncate() failed\n");
+        }
       }
     }
   }
@@ -1455,6 +1625,9 @@ static int mbox_mbox_sync(struct Mailbox *m)
       mailbox_update(m_tmp);
   }
 
+  /* everything the journal protected is now on disk */
+  mutt_journal_clear(m);
+
   return 0; /* signal success */
 
 bail: /* Come here in case of disaster */
@@ -1522,6 +1695,12 @@ static int mbox_mbox_close(struct Mailbox *m)
     mutt_file_unlock(fileno(adata->fp));
     mutt_sig_unblock();
   }
+  else
+  {
+    /* a normal close ends the journal's watch - any unsynced changes were
+     * discarded deliberately, not lost to a crash */
+    mutt_journal_clear(m);
+  }
 
   mutt_file_fclose(&adata->fp);
 
@@ -1825,6 +2004,7 @@ struct MxOps MxMboxOps = {
   .msg_open_new     = mbox_msg_open_new,
   .msg_commit       = mbox_msg_commit,
   .msg_close        = mbox_msg_close,
+  .msg_prefetch     = NULL,
   .msg_padding_size = mbox_msg_padding_size,
   .msg_save_hcache  = NULL,
   .tags_edit        = NULL,
@@ -1855,6 +2035,7 @@ struct MxOps MxMmdfOps = {
   .msg_open_new     = mbox_msg_open_new,
   .msg_commit       = mmdf_msg_commit,
   .msg_close        = mbox_msg_close,
+  .msg_prefetch     = NULL,
   .msg_padding_size = mmdf_msg_padding_size,
   .msg_save_hcache  = NULL,
   .tags_edit        = NULL,
@@ -29,6 +29,7 @@
 #include "config.h"
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <wchar.h>
 #include "mutt/lib.h"
@@ -40,6 +41,7 @@
 #include "pattern/lib.h"
 #include "commands.h"
 #include "context.h"
+#include "index.h"
 #include "keymap.h"
 #include "mutt_globals.h"
 #include "mutt_logging.h"
@@ -81,17 +83,21 @@ static int get_color(int index, unsigned char *s)
   struct ColorLine *np = NULL;
   struct Email *e = mutt_get_virt_email(Context->mailbox, index);
   int type = *s;
+  int *cached = NULL;
 
   switch (type)
   {
     case MT_COLOR_INDEX_AUTHOR:
       color = &Colors->index_author_list;
+      cached = e ? &e->pair_author : NULL;
       break;
     case MT_COLOR_INDEX_FLAGS:
       color = &Colors->index_flags_list;
+      cached = e ? &e->pair_flags : NULL;
       break;
     case MT_COLOR_INDEX_SUBJECT:
       color = &Colors->index_subject_list;
+      cached = e ? &e->pair_subject : NULL;
       break;
     case MT_COLOR_INDEX_TAG:
       STAILQ_FOREACH(np, &Colors->index_tag_list, entries)
@@ -109,13 +115,24 @@ static int get_color(int index, unsigned char *s)
       return Colors->defs[type];
   }
 
+  /* Matching the patterns below is O(rules) per cell, so the result is cached
+   * on the Email; mutt_set_header_color() resets the caches */
+  if (cached && (*cached != 0))
+    return (*cached == -1) ? 0 : *cached;
+
   STAILQ_FOREACH(np, color, entries)
   {
     if (mutt_pattern_exec(SLIST_FIRST(np->color_pattern),
                           MUTT_MATCH_FULL_ADDRESS, Context->mailbox, e, NULL))
+    {
+      if (cached)
+        *cached = (np->pair == 0) ? -1 : np->pair;
       return np->pair;
+    }
   }
 
+  if (cached)
+    *cached = -1;
   return 0;
 }
 
@@ -279,14 +296,11 @@ static void print_enriched_string(int index, int attr, unsigned char *s, bool do
         }
         else
         {
-          if (get_color(index, s) == 0)
-          {
+          const int color = get_color(index, s);
+          if (color == 0)
             attron(attr);
-          }
           else
-          {
-            attron(get_color(index, s));
-          }
+            attron(color);
         }
       }
       s++;
@@ -375,56 +389,132 @@ void menu_redraw_status(struct Menu *menu)
 }
 
 /**
- * menu_redraw_index - Force the redraw of the index
+ * menu_redraw_row - Repaint a single row of the menu
  * @param menu Current Menu
+ * @param i    Row to repaint
+ *
+ * The row must be on the current page, i.e. in [top, top + pagelen).
  */
-void menu_redraw_index(struct Menu *menu)
+static void menu_redraw_row(struct Menu *menu, int i)
 {
   char buf[1024];
-  bool do_color;
-  int attr;
 
-  for (int i = menu->top; i < menu->top + menu->pagelen; i++)
-  {
-    if (i < menu->max)
-    {
-      attr = menu->color(i);
+  const int attr = menu->color(i);
 
-      make_entry(buf, sizeof(buf), menu, i);
-      menu_pad_string(menu, buf, sizeof(buf));
+  make_entry(buf, sizeof(buf), menu, i);
+  menu_pad_string(menu, buf, sizeof(buf));
 
+  mutt_curses_set_attr(attr);
+  mutt_window_move(menu->win_index, 0, i - menu->top);
+  bool do_color = true;
+
+  if (i == menu->current)
+  {
+    mutt_curses_set_color(MT_COLOR_INDICATOR);
+    if (C_ArrowCursor)
+    {
+      mutt_window_addstr(C_ArrowString);
       mutt_curses_set_attr(attr);
-      mutt_window_move(menu->win_index, 0, i - menu->top);
-      do_color = true;
+      mutt_window_addch(' ');
+    }
+    else
+      do_color = false;
+  }
+  else if (C_ArrowCursor)
+    /* Print space chars to match the screen width of `$arrow_string` */
+    mutt_window_printf("%*s", mutt_strwidth(C_ArrowString) + 1, "");
+
+  print_enriched_string(i, attr, (unsigned char *) buf, do_color);
+}
 
-      if (i == menu->current)
+/**
+ * menu_redraw_index - Force the redraw of the index
+ * @param menu Current Menu
+ */
+void menu_redraw_index(struct Menu *menu)
+{
+  const int delta = menu->top - menu->last_top;
+
+  /* If the page only scrolled (#REDRAW_SCROLL without #REDRAW_INDEX), let
+   * the terminal move the surviving rows and repaint just what's new -
+   * over a slow link that's the difference between a few lines and a
+   * whole screen per keystroke. */
+  if ((menu->redraw & REDRAW_SCROLL) && !(menu->redraw & REDRAW_INDEX) &&
+      (delta != 0) && (abs(delta) < menu->pagelen) &&
+      mutt_window_scroll_rows(menu->win_index, delta))
+  {
+    const int first = (delta > 0) ? (menu->top + menu->pagelen - delta) : menu->top;
+    const int last = first + abs(delta);
+    for (int i = first; i < last; i++)
+    {
+      if (i < menu->max)
+        menu_redraw_row(menu, i);
+      else
       {
-        mutt_curses_set_color(MT_COLOR_INDICATOR);
-        if (C_ArrowCursor)
-        {
-          mutt_window_addstr(C_ArrowString);
-          mutt_curses_set_attr(attr);
-          mutt_window_addch(' ');
-        }
-        else
-          do_color = false;
+        mutt_curses_set_color(MT_COLOR_NORMAL);
+        mutt_window_clearline(menu->win_index, i - menu->top);
       }
-      else if (C_ArrowCursor)
-        /* Print space chars to match the screen width of `$arrow_string` */
-        mutt_window_printf("%*s", mutt_strwidth(C_ArrowString) + 1, "");
+    }
 
-      print_enriched_string(i, attr, (unsigned char *) buf, do_color);
+    /* the indicator may have moved relative to the scrolled text */
+    if ((menu->oldcurrent >= menu->top) && (menu->oldcurrent < menu->max) &&
+        (menu->oldcurrent < menu->top + menu->pagelen))
+    {
+      menu_redraw_row(menu, menu->oldcurrent);
     }
-    else
+    if ((menu->current >= menu->top) && (menu->current < menu->top + menu->pagelen))
+      menu_redraw_row(menu, menu->current);
+
+    /* rows queued before the scroll still hold stale content */
+    int *row = NULL;
+    ARRAY_FOREACH(row, &menu->dirty_rows)
+    {
+      if ((*row >= menu->top) && (*row < menu->top + menu->pagelen) && (*row < menu->max))
+        menu_redraw_row(menu, *row);
+    }
+  }
+  else
+  {
+    for (int i = menu->top; i < menu->top + menu->pagelen; i++)
     {
-      mutt_curses_set_color(MT_COLOR_NORMAL);
-      mutt_window_clearline(menu->win_index, i - menu->top);
+      if (i < menu->max)
+        menu_redraw_row(menu, i);
+      else
+      {
+        mutt_curses_set_color(MT_COLOR_NORMAL);
+        mutt_window_clearline(menu->win_index, i - menu->top);
+      }
     }
   }
   mutt_curses_set_color(MT_COLOR_NORMAL);
+  ARRAY_SHRINK(&menu->dirty_rows, ARRAY_SIZE(&menu->dirty_rows));
+  menu->last_top = menu->top;
   menu->redraw = 0;
 }
 
+/**
+ * menu_redraw_rows - Repaint the dirty rows of the menu
+ * @param menu Current Menu
+ *
+ * Repaint only the rows queued with mutt_menu_queue_row_redraw().
+ * Rows that have scrolled off the current page are skipped.
+ */
+void menu_redraw_rows(struct Menu *menu)
+{
+  if (ARRAY_EMPTY(&menu->dialog))
+  {
+    int *row = NULL;
+    ARRAY_FOREACH(row, &menu->dirty_rows)
+    {
+      if ((*row >= menu->top) && (*row < menu->top + menu->pagelen) && (*row < menu->max))
+        menu_redraw_row(menu, *row);
+    }
+    mutt_curses_set_color(MT_COLOR_NORMAL);
+  }
+  ARRAY_SHRINK(&menu->dirty_rows, ARRAY_SIZE(&menu->dirty_rows));
+  menu->redraw &= ~REDRAW_ROWS;
+}
+
 /**
  * menu_redraw_motion - Force the redraw of the list part of the menu
  * @param menu Current Menu
@@ -549,7 +639,7 @@ void menu_check_recenter(struct Menu *menu)
     if (menu->top != 0)
     {
       menu->top = 0;
-      menu->redraw |= REDRAW_INDEX;
+      menu->redraw |= REDRAW_SCROLL;
     }
   }
   else
@@ -582,7 +672,7 @@ void menu_check_recenter(struct Menu *menu)
   menu->top = MAX(menu->top, 0);
 
   if (menu->top != old_top)
-    menu->redraw |= REDRAW_INDEX;
+    menu->redraw |= REDRAW_SCROLL;
 }
 
 /**
@@ -633,7 +723,7 @@ void menu_next_line(struct Menu *menu)
       menu->top++;
       if ((menu->current < menu->top + c) && (menu->current < menu->max - 1))
         menu->current++;
-      menu->redraw = REDRAW_INDEX;
+      menu->redraw = REDRAW_SCROLL;
     }
     else
       mutt_message(_("You can't scroll down farther"));
@@ -655,7 +745,7 @@ void menu_prev_line(struct Menu *menu)
     menu->top--;
     if ((menu->current >= menu->top + menu->pagelen - c) && (menu->current > 1))
       menu->current--;
-    menu->redraw = REDRAW_INDEX;
+    menu->redraw = REDRAW_SCROLL;
   }
   else
     mutt_message(_("You can't scroll up farther"));
@@ -696,7 +786,7 @@ static void menu_length_jump(struct Menu *menu, int jumplen)
         menu->current -= tmp;
       }
 
-      menu->redraw = REDRAW_INDEX;
+      menu->redraw = REDRAW_SCROLL;
     }
     else if ((menu->current != (neg ? 0 : menu->max - 1)) && ARRAY_EMPTY(&menu->dialog))
     {
@@ -838,7 +928,7 @@ void menu_current_top(struct Menu *menu)
   if (menu->max)
   {
     menu->top = menu->current;
-    menu->redraw = REDRAW_INDEX;
+    menu->redraw = REDRAW_SCROLL;
   }
   else
     mutt_error(_("No entries"));
@@ -855,7 +945,7 @@ void menu_current_middle(struct Menu *menu)
     menu->top = menu->current - menu->pagelen / 2;
     if (menu->top < 0)
       menu->top = 0;
-    menu->redraw = REDRAW_INDEX;
+    menu->redraw = REDRAW_SCROLL;
   }
   else
     mutt_error(_("No entries"));
@@ -872,7 +962,7 @@ void menu_current_bottom(struct Menu *menu)
     menu->top = menu->current - menu->pagelen + 1;
     if (menu->top < 0)
       menu->top = 0;
-    menu->redraw = REDRAW_INDEX;
+    menu->redraw = REDRAW_SCROLL;
   }
   else
     mutt_error(_("No entries"));
@@ -972,6 +1062,7 @@ void mutt_menu_free(struct Menu **ptr)
     FREE(line);
   }
   ARRAY_FREE(&m->dialog);
+  ARRAY_FREE(&m->dirty_rows);
 
   FREE(ptr);
 }
@@ -1046,6 +1137,41 @@ void mutt_menu_pop_current(struct Menu *menu)
   }
 }
 
+/**
+ * mutt_menu_queue_row_redraw - Mark a single row as needing a repaint
+ * @param menu Menu containing the row
+ * @param row  Row to repaint, or -1 for entries that aren't on display
+ *
+ * This is cheaper than #REDRAW_INDEX when an operation changes a few known
+ * rows.  Once more rows are dirty than fit on a page, a full index redraw
+ * covers them all, so fall back on #REDRAW_INDEX.
+ */
+void mutt_menu_queue_row_redraw(struct Menu *menu, int row)
+{
+  if (!menu || (row < 0))
+    return;
+
+  if (menu->redraw & (REDRAW_FULL | REDRAW_INDEX))
+    return; /* the row will be repainted anyway */
+
+  if ((menu->pagelen <= 0) || (ARRAY_SIZE(&menu->dirty_rows) >= menu->pagelen))
+  {
+    ARRAY_SHRINK(&menu->dirty_rows, ARRAY_SIZE(&menu->dirty_rows));
+    menu->redraw |= REDRAW_INDEX;
+    return;
+  }
+
+  int *r = NULL;
+  ARRAY_FOREACH(r, &menu->dirty_rows)
+  {
+    if (*r == row)
+      return;
+  }
+
+  ARRAY_ADD(&menu->dirty_rows, row);
+  menu->redraw |= REDRAW_ROWS;
+}
+
 /**
  * mutt_menu_set_current_redraw - Set redraw flags on the current menu
  * @param redraw Flags to set, see #MuttRedrawFlags
@@ -1260,9 +1386,26 @@ static int menu_dialog_dokey(struct Menu *menu, int *ip)
  */
 int menu_redraw(struct Menu *menu)
 {
+  const int span = mutt_trace_start("menu_redraw");
+  const uint64_t start_ms = mutt_date_epoch_ms();
+  mutt_stats_count("menu/redraw", 1);
+
+  /* While a macro/push is driving the UI, mutt_refresh() never copies the
+   * virtual screen to the terminal, so rendering into it between steps is
+   * wasted work too.  Collapse the skipped redraws into one full redraw
+   * that happens when the macro has drained. */
+  if (mutt_macro_pending() && !OptForceRefresh)
+  {
+    menu->redraw = REDRAW_FULL;
+    mutt_trace_end(span);
+    return OP_NULL;
+  }
+
   if (menu->custom_redraw)
   {
     menu->custom_redraw(menu);
+    mutt_stats_record_ms("menu/redraw", mutt_date_epoch_ms() - start_ms);
+    mutt_trace_end(span);
     return OP_NULL;
   }
 
@@ -1270,6 +1413,8 @@ int menu_redraw(struct Menu *menu)
   if (menu->redraw & REDRAW_FULL)
   {
     menu_redraw_full(menu);
+    mutt_stats_record_ms("menu/redraw", mutt_date_epoch_ms() - start_ms);
+    mutt_trace_end(span);
     /* allow the caller to do any local configuration */
     return OP_REDRAW;
   }
@@ -1279,16 +1424,23 @@ int menu_redraw(struct Menu *menu)
 
   if (menu->redraw & REDRAW_STATUS)
     menu_redraw_status(menu);
-  if (menu->redraw & REDRAW_INDEX)
+  if (menu->redraw & (REDRAW_INDEX | REDRAW_SCROLL))
     menu_redraw_index(menu);
-  else if (menu->redraw & (REDRAW_MOTION | REDRAW_MOTION_RESYNC))
-    menu_redraw_motion(menu);
-  else if (menu->redraw == REDRAW_CURRENT)
-    menu_redraw_current(menu);
+  else
+  {
+    if (menu->redraw & REDRAW_ROWS)
+      menu_redraw_rows(menu);
+    if (menu->redraw & (REDRAW_MOTION | REDRAW_MOTION_RESYNC))
+      menu_redraw_motion(menu);
+    else if (menu->redraw == REDRAW_CURRENT)
+      menu_redraw_current(menu);
+  }
 
   if (!ARRAY_EMPTY(&menu->dialog))
     menu_redraw_prompt(menu);
 
+  mutt_stats_record_ms("menu/redraw", mutt_date_epoch_ms() - start_ms);
+  mutt_trace_end(span);
   return OP_NULL;
 }
 
@@ -1617,6 +1769,9 @@ int mutt_menu_config_observer(struct NotifyCallback *nc)
   if (flags == R_REDRAW_NO_FLAGS)
     return 0;
 
+  /* the changed config may alter how $index_format renders */
+  IndexLineGen++;
+
   if (flags & R_INDEX)
     mutt_menu_set_redraw_full(MENU_MAIN);
   if (flags & R_PAGER)
@@ -58,7 +58,27 @@ static struct pollfd *PollFds = NULL;
 
 static int MonitorContextDescriptor = -1;
 
-#define INOTIFY_MASK_DIR (IN_MOVED_TO | IN_ATTRIB | IN_CLOSE_WRITE | IN_ISDIR)
+/* Events seen on the current mailbox since the last mutt_monitor_take_events().
+ * They allow the mailbox backend to refresh incrementally, instead of
+ * rescanning the whole directory.  The list is only usable while it is
+ * complete: a kernel queue overflow, or more events than we are willing to
+ * remember, invalidates it until the next collection window. */
+static struct MonitorEventArray MonitorContextEvents = ARRAY_HEAD_INITIALIZER;
+static bool MonitorContextEventsComplete = false;
+
+/* Maildir flag changes made by other clients are renames inside cur/, which
+ * the main watch (on new/) never sees.  For the current mailbox only, a
+ * second watch covers cur/ so those renames can be applied incrementally too.
+ * MonitorContextCurCovered records whether the cur/ watch was in place for the
+ * whole of the current collection window. */
+static int MonitorContextCurDescriptor = -1;
+static bool MonitorContextCurCovered = false;
+
+#define MONITOR_MAX_EVENTS 1024
+
+#define INOTIFY_MASK_DIR                                                       \
+  (IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_ATTRIB |           \
+   IN_CLOSE_WRITE | IN_ISDIR)
 #define INOTIFY_MASK_FILE IN_CLOSE_WRITE
 
 #define EVENT_BUFLEN MAX(4096, sizeof(struct inotify_event) + NAME_MAX + 1)
@@ -263,6 +283,138 @@ static void monitor_delete(struct Monitor *monitor)
   *ptr = monitor;
 }
 
+/**
+ * monitor_events_invalidate - Drop the collected events and mark them unusable
+ *
+ * Called whenever we can no longer guarantee that the event list covers
+ * everything that happened to the current mailbox, e.g. on queue overflow or
+ * when the watch descriptor changes.
+ */
+static void monitor_events_invalidate(void)
+{
+  mutt_monitor_events_free(&MonitorContextEvents);
+  MonitorContextEventsComplete = false;
+}
+
+/**
+ * monitor_record_event - Remember an event seen on the current mailbox
+ * @param event  Event from the inotify fd
+ * @param in_cur Event was seen on the cur/ watch, not the new/ watch
+ */
+static void monitor_record_event(const struct inotify_event *event, bool in_cur)
+{
+  if (!MonitorContextEventsComplete)
+    return;
+
+  if ((event->len == 0) || (ARRAY_SIZE(&MonitorContextEvents) >= MONITOR_MAX_EVENTS))
+  {
+    monitor_events_invalidate();
+    return;
+  }
+
+  struct MonitorEvent ev = {
+    mutt_str_dup(event->name),
+    (event->mask & (IN_MOVED_FROM | IN_DELETE)) != 0,
+    in_cur,
+  };
+  ARRAY_ADD(&MonitorContextEvents, ev);
+}
+
+/**
+ * monitor_context_cur_remove - Drop the cur/ watch on the current mailbox
+ */
+static void monitor_context_cur_remove(void)
+{
+  if ((INotifyFd != -1) && (MonitorContextCurDescriptor != -1))
+    inotify_rm_watch(INotifyFd, MonitorContextCurDescriptor);
+  MonitorContextCurDescriptor = -1;
+  MonitorContextCurCovered = false;
+}
+
+/**
+ * monitor_context_cur_add - Watch the cur/ subdirectory of the current mailbox
+ *
+ * Unlike the watches in the Monitor list, this one isn't shared: it exists
+ * only while its maildir is the current mailbox, purely so that flag-change
+ * renames in cur/ feed the incremental event list.  Failure is harmless - the
+ * backend just falls back to a full scan of cur/.
+ */
+static void monitor_context_cur_add(void)
+{
+  monitor_context_cur_remove();
+
+  if ((INotifyFd == -1) || !Context || !Context->mailbox ||
+      (Context->mailbox->type != MUTT_MAILDIR))
+  {
+    return;
+  }
+
+  char path[PATH_MAX];
+  snprintf(path, sizeof(path), "%s/cur", Context->mailbox->realpath);
+  MonitorContextCurDescriptor = inotify_add_watch(INotifyFd, path, INOTIFY_MASK_DIR);
+  if (MonitorContextCurDescriptor == -1)
+  {
+    mutt_debug(LL_DEBUG2, "inotify_add_watch failed for '%s', errno=%d %s\n",
+               path, errno, strerror(errno));
+  }
+  else
+  {
+    mutt_debug(LL_DEBUG3, "inotify_add_watch descriptor=%d for '%s'\n",
+               MonitorContextCurDescriptor, path);
+  }
+}
+
+/**
+ * mutt_monitor_take_events - Hand over the events collected for the current mailbox
+ * @param[out] events      Array to fill (to be freed with mutt_monitor_events_free())
+ * @param[out] cur_covered true if the maildir's cur/ was watched for the whole window
+ * @retval true  The events completely describe the changes since the last call
+ * @retval false The list is unusable - the caller must do a full rescan
+ *
+ * Calling this starts a fresh collection window, so the caller should invoke
+ * it once per mailbox check, even when falling back to a full rescan.
+ */
+bool mutt_monitor_take_events(struct MonitorEventArray *events, bool *cur_covered)
+{
+  const bool complete = MonitorContextEventsComplete;
+
+  if (cur_covered)
+    *cur_covered = complete && MonitorContextCurCovered;
+
+  if (complete)
+  {
+    *events = MonitorContextEvents;
+    ARRAY_INIT(&MonitorContextEvents);
+  }
+  else
+  {
+    mutt_monitor_events_free(&MonitorContextEvents);
+  }
+
+  /* The cur/ watch dies with its directory (IN_IGNORED); try to re-establish
+   * it at the start of each window */
+  if (MonitorContextCurDescriptor == -1)
+    monitor_context_cur_add();
+
+  MonitorContextEventsComplete = (MonitorContextDescriptor != -1);
+  MonitorContextCurCovered = (MonitorContextCurDescriptor != -1);
+  return complete;
+}
+
+/**
+ * mutt_monitor_events_free - Free an array of monitor events
+ * @param events Array to free
+ */
+void mutt_monitor_events_free(struct MonitorEventArray *events)
+{
+  struct MonitorEvent *ev = NULL;
+  ARRAY_FOREACH(ev, events)
+  {
+    FREE(&ev->name);
+  }
+  ARRAY_FREE(events);
+}
+
 /**
  * monitor_handle_ignore - Listen for when a backup file is closed
  * @param desc Watch descriptor
@@ -303,7 +455,10 @@ static int monitor_handle_ignore(int desc)
     }
 
     if (MonitorContextDescriptor == desc)
+    {
       MonitorContextDescriptor = new_desc;
+      monitor_events_invalidate();
+    }
 
     if (new_desc == -1)
     {
@@ -451,10 +606,28 @@ int mutt_monitor_poll(void)
                 event = (const struct inotify_event *) ptr;
                 mutt_debug(LL_DEBUG3, "+ detail: descriptor=%d mask=0x%x\n",
                            event->wd, event->mask);
-                if (event->mask & IN_IGNORED)
-                  monitor_handle_ignore(event->wd);
+                if (event->mask & IN_Q_OVERFLOW)
+                  monitor_events_invalidate();
+                else if (event->mask & IN_IGNORED)
+                {
+                  if (event->wd == MonitorContextCurDescriptor)
+                  {
+                    MonitorContextCurDescriptor = -1;
+                    MonitorContextCurCovered = false;
+                  }
+                  else
+                    monitor_handle_ignore(event->wd);
+                }
                 else if (event->wd == MonitorContextDescriptor)
+                {
                   MonitorContextChanged = true;
+                  monitor_record_event(event, false);
+                }
+                else if (event->wd == MonitorContextCurDescriptor)
+                {
+                  MonitorContextChanged = true;
+                  monitor_record_event(event, true);
+                }
                 ptr += sizeof(struct inotify_event) + event->len;
               }
             }
@@ -487,7 +660,11 @@ int mutt_monitor_add(struct Mailbox *m)
   if (desc != RESOLVE_RES_OK_NOTEXISTING)
   {
     if (!m && (desc == RESOLVE_RES_OK_EXISTING))
+    {
       MonitorContextDescriptor = info.monitor->desc;
+      monitor_events_invalidate();
+      monitor_context_cur_add();
+    }
     rc = (desc == RESOLVE_RES_OK_EXISTING) ? 0 : -1;
     goto cleanup;
   }
@@ -504,7 +681,11 @@ int mutt_monitor_add(struct Mailbox *m)
 
   mutt_debug(LL_DEBUG3, "inotify_add_watch descriptor=%d for '%s'\n", desc, info.path);
   if (!m)
+  {
     MonitorContextDescriptor = desc;
+    monitor_events_invalidate();
+    monitor_context_cur_add();
+  }
 
   monitor_new(&info, desc);
 
@@ -534,6 +715,8 @@ int mutt_monitor_remove(struct Mailbox *m)
   {
     MonitorContextDescriptor = -1;
     MonitorContextChanged = false;
+    monitor_events_invalidate();
+    monitor_context_cur_remove();
   }
 
   if (monitor_resolve(&info, m) != RESOLVE_RES_OK_EXISTING)
@@ -30,8 +30,21 @@ struct Mailbox;
 extern bool MonitorFilesChanged;   ///< true after a monitored file has changed
 extern bool MonitorContextChanged; ///< true after the current mailbox has changed
 
+/**
+ * struct MonitorEvent - A single file event seen on the current mailbox
+ */
+struct MonitorEvent
+{
+  char *name;   ///< File name within the watched directory
+  bool removed; ///< File was removed, rather than added or changed
+  bool in_cur;  ///< Event was seen in cur/, not new/ (Maildir only)
+};
+ARRAY_HEAD(MonitorEventArray, struct MonitorEvent);
+
 int mutt_monitor_add(struct Mailbox *m);
 int mutt_monitor_remove(struct Mailbox *m);
 int mutt_monitor_poll(void);
+bool mutt_monitor_take_events(struct MonitorEventArray *events, bool *cur_covered);
+void mutt_monitor_events_free(struct MonitorEventArray *events);
 
 #endif /* MUTT_MONITOR_H */
@@ -144,35 +144,39 @@ int mutt_b64_decode(const char *in, char *out, size_t olen)
   do
   {
     const unsigned char digit1 = in[0];
-    if ((digit1 > 127) || (base64val(digit1) == BAD))
+    const int val1 = base64val(digit1);
+    if ((digit1 > 127) || (val1 == BAD))
       return -1;
     const unsigned char digit2 = in[1];
-    if ((digit2 > 127) || (base64val(digit2) == BAD))
+    const int val2 = base64val(digit2);
+    if ((digit2 > 127) || (val2 == BAD))
       return -1;
     const unsigned char digit3 = in[2];
-    if ((digit3 > 127) || ((digit3 != '=') && (base64val(digit3) == BAD)))
+    const int val3 = base64val(digit3);
+    if ((digit3 > 127) || ((digit3 != '=') && (val3 == BAD)))
       return -1;
     digit4 = in[3];
-    if ((digit4 > 127) || ((digit4 != '=') && (base64val(digit4) == BAD)))
+    const int val4 = base64val(digit4);
+    if ((digit4 > 127) || ((digit4 != '=') && (val4 == BAD)))
       return -1;
     in += 4;
 
     /* digits are already sanity-checked */
     if (len == olen)
       return len;
-    *out++ = (base64val(digit1) << 2) | (base64val(digit2) >> 4);
+    *out++ = (val1 << 2) | (val2 >> 4);
     len++;
     if (digit3 != '=')
     {
       if (len == olen)
         return len;
-      *out++ = ((base64val(digit2) << 4) & 0xf0) | (base64val(digit3) >> 2);
+      *out++ = ((val2 << 4) & 0xf0) | (val3 >> 2);
       len++;
       if (digit4 != '=')
       {
         if (len == olen)
           return len;
-        *out++ = ((base64val(digit3) << 6) & 0xc0) | base64val(digit4);
+        *out++ = ((val3 << 6) & 0xc0) | val4;
         len++;
       }
     }
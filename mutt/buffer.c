@@ -102,7 +102,12 @@ size_t mutt_buffer_addstr_n(struct Buffer *buf, const char *s, size_t len)
     return 0;
 
   if (!buf->data || !buf->dptr || ((buf->dptr + len + 1) > (buf->data + buf->dsize)))
-    mutt_buffer_alloc(buf, buf->dsize + MAX(128, len + 1));
+  {
+    /* Grow geometrically: at least double, and always enough for the new
+     * text.  The old fixed 128-byte step made building a large string from
+     * small appends quadratic in realloc/copy work. */
+    mutt_buffer_alloc(buf, buf->dsize + MAX(buf->dsize, MAX(128, len + 1)));
+  }
 
   memcpy(buf->dptr, s, len);
   buf->dptr += len;
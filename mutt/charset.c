@@ -78,6 +78,21 @@ TAILQ_HEAD(LookupList, Lookup);
 
 static struct LookupList Lookups = TAILQ_HEAD_INITIALIZER(Lookups);
 
+/**
+ * struct IconvCacheEntry - Cached iconv conversion descriptor
+ */
+struct IconvCacheEntry
+{
+  char *fromcode; ///< Resolved 'from' character set
+  char *tocode;   ///< Resolved 'to' character set
+  iconv_t cd;     ///< Open iconv conversion descriptor
+};
+
+/// Number of iconv descriptors to keep open, most recently used first
+#define ICONV_CACHE_SIZE 16
+static struct IconvCacheEntry IconvCache[ICONV_CACHE_SIZE];
+static int IconvCacheUsed = 0;
+
 /**
  * struct MimeNames - MIME name lookup entry
  */
@@ -297,6 +312,33 @@ static const char *lookup_charset(enum LookupType type, const char *cs)
   return NULL;
 }
 
+/**
+ * ch_is_ascii_superset - Does a character set encode 7-bit text as ASCII?
+ * @param name  Character set to check
+ * @param flags Flags, e.g. #MUTT_ICONV_HOOK_FROM
+ * @retval true ASCII bytes mean the same thing in this character set
+ *
+ * This must stay conservative: charsets like iso-2022-jp and utf-7 use only
+ * 7-bit bytes but give them different meanings, so they must return false.
+ * If #MUTT_ICONV_HOOK_FROM is set, charset-hooks are applied first, as a hook
+ * may relabel an ASCII-looking name as one of those.
+ */
+static bool ch_is_ascii_superset(const char *name, int flags)
+{
+  char canon[128];
+
+  mutt_ch_canonical_charset(canon, sizeof(canon), name);
+  if (flags & MUTT_ICONV_HOOK_FROM)
+  {
+    const char *tmp = mutt_ch_charset_lookup(canon);
+    if (tmp)
+      mutt_ch_canonical_charset(canon, sizeof(canon), tmp);
+  }
+
+  return mutt_istr_equal(canon, "us-ascii") || mutt_istr_equal(canon, "utf-8") ||
+         (mutt_istr_startswith(canon, "iso-8859-") != 0);
+}
+
 /**
  * mutt_ch_convert_nonmime_string - Try to convert a string using a list of character sets
  * @param[in,out] ps String to be converted
@@ -561,11 +603,17 @@ const char *mutt_ch_charset_lookup(const char *chs)
  *
  * @note The top-well-named MUTT_ICONV_HOOK_FROM acts on charset-hooks,
  * not at all on iconv-hooks.
+ *
+ * @note Unless #MUTT_ICONV_NO_CACHE is given, the descriptor belongs to an
+ * internal cache and must NOT be passed to iconv_close().  Cached descriptors
+ * are only valid until the next call to this function; callers that hold a
+ * descriptor across other conversions (file streams) must use
+ * #MUTT_ICONV_NO_CACHE and close it themselves.
  */
 iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, int flags)
 {
-  char tocode1[128];
-  char fromcode1[128];
+  char tocode1[128] = { 0 };
+  char fromcode1[128] = { 0 };
   const char *tocode2 = NULL, *fromcode2 = NULL;
   const char *tmp = NULL;
 
@@ -591,12 +639,65 @@ iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, int flags)
   fromcode2 = mutt_ch_iconv_lookup(fromcode1);
   fromcode2 = fromcode2 ? fromcode2 : fromcode1;
 
+  /* The cache is keyed on the names resolved above, so later charset-hooks
+   * and iconv-hooks still take effect. */
+  if (!(flags & MUTT_ICONV_NO_CACHE))
+  {
+    for (int i = 0; i < IconvCacheUsed; i++)
+    {
+      if (strcmp(IconvCache[i].tocode, tocode2) != 0)
+        continue;
+      if (strcmp(IconvCache[i].fromcode, fromcode2) != 0)
+        continue;
+
+      /* keep the cache in most-recently-used order */
+      struct IconvCacheEntry entry = IconvCache[i];
+      memmove(&IconvCache[1], &IconvCache[0], i * sizeof(IconvCache[0]));
+      IconvCache[0] = entry;
+
+      iconv(entry.cd, NULL, NULL, NULL, NULL); /* reset shift state */
+      return entry.cd;
+    }
+  }
+
   /* call system iconv with names it appreciates */
   cd = iconv_open(tocode2, fromcode2);
-  if (cd != (iconv_t) -1)
+  if ((cd == (iconv_t) -1) || (flags & MUTT_ICONV_NO_CACHE))
     return cd;
 
-  return (iconv_t) -1;
+  if (IconvCacheUsed == ICONV_CACHE_SIZE)
+  {
+    /* evict the least recently used descriptor */
+    struct IconvCacheEntry *last = &IconvCache[IconvCacheUsed - 1];
+    iconv_close(last->cd);
+    FREE(&last->tocode);
+    FREE(&last->fromcode);
+    IconvCacheUsed--;
+  }
+
+  memmove(&IconvCache[1], &IconvCache[0], IconvCacheUsed * sizeof(IconvCache[0]));
+  IconvCache[0].tocode = mutt_str_dup(tocode2);
+  IconvCache[0].fromcode = mutt_str_dup(fromcode2);
+  IconvCache[0].cd = cd;
+  IconvCacheUsed++;
+
+  return cd;
+}
+
+/**
+ * mutt_ch_cache_cleanup - Clean up the cache of iconv descriptors
+ *
+ * Close the conversion descriptors held by mutt_ch_iconv_open()'s cache.
+ */
+void mutt_ch_cache_cleanup(void)
+{
+  for (int i = 0; i < IconvCacheUsed; i++)
+  {
+    iconv_close(IconvCache[i].cd);
+    FREE(&IconvCache[i].tocode);
+    FREE(&IconvCache[i].fromcode);
+  }
+  IconvCacheUsed = 0;
 }
 
 /**
@@ -734,7 +835,6 @@ int mutt_ch_check(const char *s, size_t slen, const char *from, const char *to)
     rc = errno;
 
   FREE(&saved_out);
-  iconv_close(cd);
   return rc;
 }
 
@@ -764,6 +864,14 @@ int mutt_ch_convert_string(char **ps, const char *from, const char *to, int flag
   if (!to || !from)
     return -1;
 
+  /* 7-bit text converts to itself between ASCII supersets; checking that is
+   * one pass over the string and far cheaper than setting up iconv */
+  if (mutt_str_is_ascii(s, strlen(s)) && ch_is_ascii_superset(to, 0) &&
+      ch_is_ascii_superset(from, flags))
+  {
+    return 0;
+  }
+
   const char *repls[] = { "\357\277\275", "?", 0 };
   int rc = 0;
 
@@ -793,7 +901,6 @@ int mutt_ch_convert_string(char **ps, const char *from, const char *to, int flag
   ob = buf;
 
   mutt_ch_iconv(cd, &ib, &ibl, &ob, &obl, inrepls, outrepl, &rc);
-  iconv_close(cd);
 
   *ob = '\0';
 
@@ -837,10 +944,7 @@ bool mutt_ch_check_charset(const char *cs, bool strict)
 
   iconv_t cd = mutt_ch_iconv_open(cs, cs, 0);
   if (cd != (iconv_t)(-1))
-  {
-    iconv_close(cd);
     return true;
-  }
 
   return false;
 }
@@ -860,8 +964,10 @@ struct FgetConv *mutt_ch_fgetconv_open(FILE *fp, const char *from, const char *t
   struct FgetConv *fc = NULL;
   iconv_t cd = (iconv_t) -1;
 
+  /* The descriptor survives until mutt_ch_fgetconv_close(), so it can't come
+   * from the descriptor cache */
   if (from && to)
-    cd = mutt_ch_iconv_open(to, from, flags);
+    cd = mutt_ch_iconv_open(to, from, flags | MUTT_ICONV_NO_CACHE);
 
   if (cd != (iconv_t) -1)
   {
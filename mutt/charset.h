@@ -70,7 +70,9 @@ enum LookupType
 };
 
 #define MUTT_ICONV_HOOK_FROM 1 ///< apply charset-hooks to fromcode
+#define MUTT_ICONV_NO_CACHE  2 ///< don't use the descriptor cache; caller must iconv_close()
 
+void             mutt_ch_cache_cleanup(void);
 void             mutt_ch_canonical_charset(char *buf, size_t buflen, const char *name);
 const char *     mutt_ch_charset_lookup(const char *chs);
 int              mutt_ch_check(const char *s, size_t slen, const char *from, const char *to);
@@ -60,7 +60,7 @@ static const char *const Months[] = {
 /**
  * TimeZones - Lookup table of Time Zones
  *
- * @note Keep in alphabetical order
+ * @note Keep in alphabetical order: find_tz() binary searches this table
  */
 static const struct Tz TimeZones[] = {
   { "aat",     1,  0, true  }, /* Atlantic Africa Time */
@@ -170,17 +170,48 @@ static time_t add_tz_offset(time_t t, bool w, time_t h, time_t m)
  * @param len Length of the s string
  * @retval ptr Pointer to the Tz struct
  * @retval NULL Not found
+ *
+ * Binary search for the leftmost entry whose first @a len characters match,
+ * which preserves the old linear-scan behaviour of "met" matching "met"
+ * rather than "met dst".
  */
 static const struct Tz *find_tz(const char *s, size_t len)
 {
-  for (size_t i = 0; i < mutt_array_size(TimeZones); i++)
+  size_t lo = 0;
+  size_t hi = mutt_array_size(TimeZones);
+
+  while (lo < hi)
   {
-    if (mutt_istrn_equal(TimeZones[i].tzname, s, len))
-      return &TimeZones[i];
+    const size_t mid = lo + (hi - lo) / 2;
+    if (mutt_istrn_cmp(TimeZones[mid].tzname, s, len) < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
   }
+
+  if ((lo < mutt_array_size(TimeZones)) && mutt_istrn_equal(TimeZones[lo].tzname, s, len))
+    return &TimeZones[lo];
   return NULL;
 }
 
+/**
+ * parse_number - Parse a run of digits
+ * @param s   String to parse
+ * @param len Maximum number of characters to parse
+ * @retval num Parsed value
+ *
+ * The callers have already regex-matched the digits, so there are no signs
+ * and no overflow to worry about.  This exists to avoid the locale machinery
+ * behind sscanf() on the per-message header-parsing path.
+ */
+static int parse_number(const char *s, size_t len)
+{
+  int num = 0;
+  for (; (len != 0) && (*s >= '0') && (*s <= '9'); s++, len--)
+    num = (num * 10) + (*s - '0');
+  return num;
+}
+
 /**
  * is_leap_year_feb - Is a given February in a leap year
  * @param tm Date to be tested
@@ -476,7 +507,7 @@ time_t mutt_date_parse_date(const char *s, struct Tz *tz_out)
   // clang-format on
 
   /* Day */
-  sscanf(s + mutt_regmatch_start(mday), "%d", &tm.tm_mday);
+  tm.tm_mday = parse_number(s + mutt_regmatch_start(mday), mutt_regmatch_len(mday));
   if (tm.tm_mday > 31)
     return -1;
 
@@ -484,18 +515,18 @@ time_t mutt_date_parse_date(const char *s, struct Tz *tz_out)
   tm.tm_mon = mutt_date_check_month(s + mutt_regmatch_start(mmonth));
 
   /* Year */
-  sscanf(s + mutt_regmatch_start(myear), "%d", &tm.tm_year);
+  tm.tm_year = parse_number(s + mutt_regmatch_start(myear), mutt_regmatch_len(myear));
   if (tm.tm_year < 50)
     tm.tm_year += 100;
   else if (tm.tm_year >= 1900)
     tm.tm_year -= 1900;
 
   /* Time */
-  int hour, min, sec = 0;
-  sscanf(s + mutt_regmatch_start(mhour), "%d", &hour);
-  sscanf(s + mutt_regmatch_start(mminute), "%d", &min);
+  int sec = 0;
+  const int hour = parse_number(s + mutt_regmatch_start(mhour), mutt_regmatch_len(mhour));
+  const int min = parse_number(s + mutt_regmatch_start(mminute), mutt_regmatch_len(mminute));
   if (mutt_regmatch_start(msecond) != -1)
-    sscanf(s + mutt_regmatch_start(msecond), "%d", &sec);
+    sec = parse_number(s + mutt_regmatch_start(msecond), mutt_regmatch_len(msecond));
   if ((hour > 23) || (min > 59) || (sec > 60))
     return -1;
   tm.tm_hour = hour;
@@ -508,9 +539,10 @@ time_t mutt_date_parse_date(const char *s, struct Tz *tz_out)
   bool zoccident = false;
   if (mutt_regmatch_start(mtz) != -1)
   {
-    char direction;
-    sscanf(s + mutt_regmatch_start(mtz), "%c%02d%02d", &direction, &zhours, &zminutes);
-    zoccident = (direction == '-');
+    const char *ztz = s + mutt_regmatch_start(mtz);
+    zoccident = (ztz[0] == '-');
+    zhours = parse_number(ztz + 1, 2);
+    zminutes = parse_number(ztz + 3, 2);
   }
   else if (mutt_regmatch_start(mtzobs) != -1)
   {
@@ -639,14 +671,43 @@ time_t mutt_date_add_timeout(time_t now, time_t timeout)
  * @retval obj Broken-down time representation
  *
  * Uses current time if t is #MUTT_DATE_NOW
+ *
+ * The result is memoized per minute: within one minute only tm_sec changes,
+ * so rendering many nearby dates, e.g. an index page, skips most of the
+ * timezone lookups behind localtime_r().  The cache is only filled when the
+ * timezone offset is a whole number of minutes (true everywhere since 1972),
+ * which keeps historical odd-second offsets correct.
  */
 struct tm mutt_date_localtime(time_t t)
 {
+  static time_t cached_minute = TIME_T_MIN; ///< First second of the cached minute
+  static struct tm cached_tm;               ///< Its broken-down local time, with tm_sec == 0
+
   struct tm tm = { 0 };
 
   if (t == MUTT_DATE_NOW)
     t = mutt_date_epoch();
 
+  if (t >= 0)
+  {
+    const time_t minute = t - (t % 60);
+    if (minute == cached_minute)
+    {
+      tm = cached_tm;
+      tm.tm_sec = t - minute;
+      return tm;
+    }
+
+    localtime_r(&t, &tm);
+    if (tm.tm_sec == (int) (t % 60))
+    {
+      cached_minute = minute;
+      cached_tm = tm;
+      cached_tm.tm_sec = 0;
+    }
+    return tm;
+  }
+
   localtime_r(&t, &tm);
   return tm;
 }
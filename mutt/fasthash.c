@@ -0,0 +1,106 @@
+/**
+ * @file
+ * Fast non-cryptographic hashing
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_fasthash Fast non-cryptographic hashing
+ *
+ * Fast hashing for keying and lookups, where a cryptographic digest would be
+ * wasted effort.  This is 64-bit FNV-1a: a multiply and a xor per byte, no
+ * block buffering, and good enough distribution for hash tables and caches.
+ *
+ * The functions are incremental: each takes the current hash state and
+ * returns the new one, so compound keys can be hashed piecewise.  Start with
+ * #MUTT_FASTHASH_INIT.
+ *
+ * @note Do not persist these hashes in file formats shared with other tools,
+ *       and do not use them where an attacker choosing collisions matters -
+ *       use mutt/md5.c for the existing on-disk formats.
+ */
+
+#include "config.h"
+#include <ctype.h>
+#include "fasthash.h"
+
+/// The FNV-1a 64-bit prime
+#define FASTHASH_PRIME 0x00000100000001b3ULL
+
+/**
+ * mutt_fasthash_bytes - Hash a block of data
+ * @param buf    Buffer to hash
+ * @param buflen Length of buffer
+ * @param hash   Current hash state, #MUTT_FASTHASH_INIT to start
+ * @retval num New hash state
+ */
+uint64_t mutt_fasthash_bytes(const void *buf, size_t buflen, uint64_t hash)
+{
+  if (!buf)
+    return hash;
+
+  const unsigned char *s = buf;
+  for (size_t i = 0; i < buflen; i++)
+  {
+    hash ^= s[i];
+    hash *= FASTHASH_PRIME;
+  }
+
+  return hash;
+}
+
+/**
+ * mutt_fasthash_str - Hash a string
+ * @param str  String to hash
+ * @param hash Current hash state, #MUTT_FASTHASH_INIT to start
+ * @retval num New hash state
+ */
+uint64_t mutt_fasthash_str(const char *str, uint64_t hash)
+{
+  if (!str)
+    return hash;
+
+  for (const unsigned char *s = (const unsigned char *) str; *s != '\0'; s++)
+  {
+    hash ^= *s;
+    hash *= FASTHASH_PRIME;
+  }
+
+  return hash;
+}
+
+/**
+ * mutt_fasthash_istr - Hash a string, ignoring case
+ * @param str  String to hash
+ * @param hash Current hash state, #MUTT_FASTHASH_INIT to start
+ * @retval num New hash state
+ */
+uint64_t mutt_fasthash_istr(const char *str, uint64_t hash)
+{
+  if (!str)
+    return hash;
+
+  for (const unsigned char *s = (const unsigned char *) str; *s != '\0'; s++)
+  {
+    hash ^= tolower(*s);
+    hash *= FASTHASH_PRIME;
+  }
+
+  return hash;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file
+ * Fast non-cryptographic hashing
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MUTT_FASTHASH_H
+#define MUTT_MUTT_FASTHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// Initial state for the hash functions (the FNV-1a offset basis)
+#define MUTT_FASTHASH_INIT 0xcbf29ce484222325ULL
+
+uint64_t mutt_fasthash_bytes(const void *buf, size_t buflen, uint64_t hash);
+uint64_t mutt_fasthash_istr (const char *str, uint64_t hash);
+uint64_t mutt_fasthash_str  (const char *str, uint64_t hash);
+
+#endif /* MUTT_MUTT_FASTHASH_H */
@@ -277,6 +277,43 @@ int mutt_file_copy_stream(FILE *fp_in, FILE *fp_out)
   size_t l;
   char buf[1024];
 
+#ifdef HAVE_COPY_FILE_RANGE
+  /* When both sides are regular files, let the kernel copy between them
+   * directly instead of shuffling 1KiB at a time through userspace.
+   * Filesystems with reflink support then share the data blocks outright. */
+  struct stat st_in = { 0 };
+  struct stat st_out = { 0 };
+  const off_t pos_in = ftello(fp_in);
+  const off_t pos_out = ftello(fp_out);
+  if ((pos_in >= 0) && (pos_out >= 0) && (fstat(fileno(fp_in), &st_in) == 0) &&
+      S_ISREG(st_in.st_mode) && (fstat(fileno(fp_out), &st_out) == 0) &&
+      S_ISREG(st_out.st_mode) && (fflush(fp_out) == 0))
+  {
+    /* explicit offsets, because stdio's logical position and the
+     * descriptor's offset aren't kept in sync */
+    off_t off_in = pos_in;
+    off_t off_out = pos_out;
+    ssize_t n;
+    while ((n = copy_file_range(fileno(fp_in), &off_in, fileno(fp_out),
+                                &off_out, 1024 * 1024 * 1024, 0)) > 0)
+    {
+      total += n;
+    }
+
+    fseeko(fp_in, off_in, SEEK_SET);
+    fseeko(fp_out, off_out, SEEK_SET);
+
+    if (n == 0)
+    {
+      if (fflush(fp_out) != 0)
+        return -1;
+      return total;
+    }
+    /* not supported for this pairing, e.g. across filesystems on an older
+     * kernel - carry on from where the copy stopped */
+  }
+#endif
+
   while ((l = fread(buf, 1, sizeof(buf), fp_in)) > 0)
   {
     if (fwrite(buf, 1, l, fp_out) != l)
@@ -726,6 +763,106 @@ char *mutt_file_read_line(char *line, size_t *size, FILE *fp, int *line_num, int
   }
 }
 
+/**
+ * mutt_file_lines_load - Load a whole file for line iteration
+ * @param fl File lines state
+ * @param fp File to read, from its current position
+ * @retval true Success
+ *
+ * Reads the rest of @a fp into one buffer, so that mutt_file_lines_next() can
+ * hand out lines without any further copying or stdio calls.  For a parse
+ * that visits every line anyway, this replaces a read-and-scan per line with
+ * one bulk read.
+ */
+bool mutt_file_lines_load(struct MuttFileLines *fl, FILE *fp)
+{
+  if (!fl || !fp)
+    return false;
+
+  fl->data = NULL;
+  fl->len = 0;
+  fl->pos = 0;
+  fl->line_num = 0;
+
+  struct stat sb;
+  size_t alloc = 4096;
+  if ((fstat(fileno(fp), &sb) == 0) && S_ISREG(sb.st_mode) && (sb.st_size > 0))
+    alloc = sb.st_size + 1;
+
+  fl->data = mutt_mem_malloc(alloc);
+  while (true)
+  {
+    if (fl->len == alloc)
+    {
+      alloc += alloc / 2;
+      mutt_mem_realloc(&fl->data, alloc);
+    }
+    const size_t n = fread(fl->data + fl->len, 1, alloc - fl->len, fp);
+    if (n == 0)
+      break;
+    fl->len += n;
+  }
+  if (ferror(fp))
+  {
+    mutt_file_lines_free(fl);
+    return false;
+  }
+
+  if (fl->len == alloc)
+    mutt_mem_realloc(&fl->data, alloc + 1);
+  fl->data[fl->len] = '\0';
+  return true;
+}
+
+/**
+ * mutt_file_lines_next - Get the next line of a loaded file
+ * @param fl File lines state
+ * @retval ptr  The line, NUL-terminated, with its "\n" or "\r\n" removed
+ * @retval NULL No lines left
+ *
+ * The line points into the loaded buffer: it is only valid until
+ * mutt_file_lines_free() and must be copied out if the caller stores it.
+ */
+char *mutt_file_lines_next(struct MuttFileLines *fl)
+{
+  if (!fl || !fl->data || (fl->pos >= fl->len))
+    return NULL;
+
+  char *line = fl->data + fl->pos;
+  char *end = memchr(line, '\n', fl->len - fl->pos);
+  if (end)
+  {
+    fl->pos = (end - fl->data) + 1;
+    *end = '\0';
+    if ((end > line) && (end[-1] == '\r'))
+      end[-1] = '\0';
+  }
+  else
+  {
+    /* the last line of the file isn't "\n" terminated */
+    fl->pos = fl->len;
+  }
+
+  fl->line_num++;
+  return line;
+}
+
+/**
+ * mutt_file_lines_free - Free a loaded file
+ * @param fl File lines state
+ *
+ * Any lines handed out by mutt_file_lines_next() become invalid.
+ */
+void mutt_file_lines_free(struct MuttFileLines *fl)
+{
+  if (!fl)
+    return;
+
+  FREE(&fl->data);
+  fl->len = 0;
+  fl->pos = 0;
+}
+
 /**
  * mutt_file_iter_line - iterate over the lines from an open file pointer
  * @param iter  State of iteration including ptr to line
@@ -1031,6 +1168,43 @@ void mutt_file_touch_atime(int fd)
 #endif
 }
 
+/**
+ * mutt_file_advise_willneed - Ask the kernel to read a file ahead of use
+ * @param path File expected to be read soon
+ *
+ * Starts asynchronous readahead for the whole file; the pages stay in the
+ * page cache after the descriptor is closed.  Silently ignored if
+ * posix_fadvise() isn't supported.
+ */
+void mutt_file_advise_willneed(const char *path)
+{
+#ifdef HAVE_POSIX_FADVISE
+  if (!path)
+    return;
+
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return;
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+  close(fd);
+#endif
+}
+
+/**
+ * mutt_file_advise_dontneed - Tell the kernel a file's cached pages won't be reused
+ * @param fd File descriptor of the file that has been read
+ *
+ * Lets bulk scans drop their pages again instead of evicting data the user is
+ * actually working with.  Silently ignored if posix_fadvise() isn't supported.
+ */
+void mutt_file_advise_dontneed(int fd)
+{
+#ifdef HAVE_POSIX_FADVISE
+  if (fd >= 0)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+}
+
 /**
  * mutt_file_chmod - Set permissions of a file
  * @param path Filename
@@ -72,6 +72,17 @@ struct MuttFileIter
   int line_num; ///< line number
 };
 
+/**
+ * struct MuttFileLines - A whole file loaded for zero-copy line iteration
+ */
+struct MuttFileLines
+{
+  char *data;   ///< file contents; returned lines point in here
+  size_t len;   ///< length of the contents
+  size_t pos;   ///< start of the next line
+  int line_num; ///< number of lines handed out so far
+};
+
 /**
  * typedef mutt_file_map_t - Callback function for mutt_file_map_lines()
  * @param line      Line of text read
@@ -82,6 +93,8 @@ struct MuttFileIter
  */
 typedef bool (*mutt_file_map_t)(char *line, int line_num, void *user_data);
 
+void        mutt_file_advise_dontneed(int fd);
+void        mutt_file_advise_willneed(const char *path);
 int         mutt_file_check_empty(const char *path);
 int         mutt_file_chmod(const char *path, mode_t mode);
 int         mutt_file_chmod_add(const char *path, mode_t mode);
@@ -99,6 +112,9 @@ int         mutt_file_fsync_close(FILE **fp);
 long        mutt_file_get_size(const char *path);
 void        mutt_file_get_stat_timespec(struct timespec *dest, struct stat *sb, enum MuttStatType type);
 bool        mutt_file_iter_line(struct MuttFileIter *iter, FILE *fp, int flags);
+void        mutt_file_lines_free(struct MuttFileLines *fl);
+bool        mutt_file_lines_load(struct MuttFileLines *fl, FILE *fp);
+char *      mutt_file_lines_next(struct MuttFileLines *fl);
 int         mutt_file_lock(int fd, bool excl, bool timeout);
 bool        mutt_file_map_lines(mutt_file_map_t func, void *user_data, FILE *fp, int flags);
 int         mutt_file_mkdir(const char *path, mode_t mode);
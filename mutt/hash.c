@@ -28,8 +28,8 @@
  */
 
 #include "config.h"
-#include <ctype.h>
 #include <stdbool.h>
+#include "fasthash.h"
 #include "hash.h"
 #include "memory.h"
 #include "string2.h"
@@ -39,16 +39,9 @@
 /**
  * gen_string_hash - Generate a hash from a string - Implements hash_gen_hash_t
  */
-static size_t gen_string_hash(union HashKey key, size_t num_elems)
+static size_t gen_string_hash(union HashKey key)
 {
-  size_t hash = 0;
-  const unsigned char *s = (const unsigned char *) key.strkey;
-
-  while (*s != '\0')
-    hash += ((hash << 7) + *s++);
-  hash = (hash * SOME_PRIME) % num_elems;
-
-  return hash;
+  return (size_t) mutt_fasthash_str(key.strkey, MUTT_FASTHASH_INIT);
 }
 
 /**
@@ -62,16 +55,9 @@ static int cmp_string_key(union HashKey a, union HashKey b)
 /**
  * gen_case_string_hash - Generate a hash from a string (ignore the case) - Implements hash_gen_hash_t
  */
-static size_t gen_case_string_hash(union HashKey key, size_t num_elems)
+static size_t gen_case_string_hash(union HashKey key)
 {
-  size_t hash = 0;
-  const unsigned char *s = (const unsigned char *) key.strkey;
-
-  while (*s != '\0')
-    hash += ((hash << 7) + tolower(*s++));
-  hash = (hash * SOME_PRIME) % num_elems;
-
-  return hash;
+  return (size_t) mutt_fasthash_istr(key.strkey, MUTT_FASTHASH_INIT);
 }
 
 /**
@@ -85,9 +71,9 @@ static int cmp_case_string_key(union HashKey a, union HashKey b)
 /**
  * gen_int_hash - Generate a hash from an integer - Implements hash_gen_hash_t
  */
-static size_t gen_int_hash(union HashKey key, size_t num_elems)
+static size_t gen_int_hash(union HashKey key)
 {
-  return (key.intkey % num_elems);
+  return ((size_t) key.intkey * SOME_PRIME);
 }
 
 /**
@@ -107,19 +93,129 @@ static int cmp_int_key(union HashKey a, union HashKey b)
  * @param num_elems Number of elements it should contain
  * @retval ptr New Hash Table
  *
- * The Hash Table can contain more elements than num_elems, but they will be
- * chained together.
+ * The Hash Table can contain more elements than num_elems: the slot array
+ * grows when it gets too full.
  */
 static struct HashTable *hash_new(size_t num_elems)
 {
   struct HashTable *table = mutt_mem_calloc(1, sizeof(struct HashTable));
-  if (num_elems == 0)
-    num_elems = 2;
-  table->num_elems = num_elems;
-  table->table = mutt_mem_calloc(num_elems, sizeof(struct HashElem *));
+  size_t slots = 8;
+  while ((slots * 3) < (num_elems * 4)) /* keep the load factor below 75% */
+    slots <<= 1;
+  table->num_elems = slots;
+  table->table = mutt_mem_calloc(slots, sizeof(struct HashElem *));
   return table;
 }
 
+/**
+ * hash_dist - How far is an entry from its preferred slot?
+ * @param table Hash Table
+ * @param hash  Hash of the entry's key
+ * @param slot  Slot the entry occupies
+ * @retval num Probe distance of the entry
+ */
+static inline size_t hash_dist(const struct HashTable *table, size_t hash, size_t slot)
+{
+  return ((slot - hash) & (table->num_elems - 1));
+}
+
+/**
+ * hash_place - Place an entry into a free slot
+ * @param table Hash Table to update
+ * @param he    Entry to place
+ *
+ * Robin-hood insertion: walk the probe sequence from the entry's preferred
+ * slot and swap with any resident that is closer to home than we are, so no
+ * entry ever ends up disproportionately far from its slot.  The caller must
+ * ensure the key isn't in the Table yet.
+ */
+static void hash_place(struct HashTable *table, struct HashElem *he)
+{
+  const size_t mask = table->num_elems - 1;
+  size_t slot = he->hash & mask;
+  size_t dist = 0;
+
+  while (table->table[slot])
+  {
+    const size_t cur_dist = hash_dist(table, table->table[slot]->hash, slot);
+    if (cur_dist < dist)
+    {
+      struct HashElem *tmp = table->table[slot];
+      table->table[slot] = he;
+      he = tmp;
+      dist = cur_dist;
+    }
+    slot = (slot + 1) & mask;
+    dist++;
+  }
+  table->table[slot] = he;
+  table->num_used++;
+}
+
+/**
+ * hash_grow - Double the slot array if the Table is getting full
+ * @param table Hash Table to grow
+ *
+ * The HashElems themselves don't move, so pointers held by the callers stay
+ * valid; only the slot array is rebuilt, using the hashes cached in the
+ * entries.
+ */
+static void hash_grow(struct HashTable *table)
+{
+  if (((table->num_used + 1) * 4) <= (table->num_elems * 3))
+    return;
+
+  const size_t old_size = table->num_elems;
+  struct HashElem **old = table->table;
+
+  table->num_elems = old_size * 2;
+  table->num_used = 0;
+  table->table = mutt_mem_calloc(table->num_elems, sizeof(struct HashElem *));
+  for (size_t i = 0; i < old_size; i++)
+  {
+    if (old[i])
+      hash_place(table, old[i]);
+  }
+  FREE(&old);
+}
+
+/**
+ * hash_lookup - Find the slot holding a key
+ * @param[in]  table Hash Table to search
+ * @param[in]  key   Key (either string or integer)
+ * @param[in]  hash  Hash of the key
+ * @param[out] slot  Slot holding the key
+ * @retval true The key was found
+ *
+ * The probe walk can stop as soon as it meets an entry that is closer to its
+ * preferred slot than the key would be - the robin-hood invariant guarantees
+ * the key can't be stored beyond that point.
+ */
+static bool hash_lookup(const struct HashTable *table, union HashKey key,
+                        size_t hash, size_t *slot)
+{
+  if (table->num_elems == 0)
+    return false; // LCOV_EXCL_LINE
+
+  const size_t mask = table->num_elems - 1;
+  size_t cur = hash & mask;
+
+  for (size_t dist = 0;; dist++)
+  {
+    const struct HashElem *he = table->table[cur];
+    if (!he)
+      return false;
+    if ((he->hash == hash) && (table->cmp_key(he->key, key) == 0))
+    {
+      *slot = cur;
+      return true;
+    }
+    if (hash_dist(table, he->hash, cur) < dist)
+      return false;
+    cur = (cur + 1) & mask;
+  }
+}
+
 /**
  * union_hash_insert - Insert into a hash table using a union as a key
  * @param table Hash Table to update
@@ -134,38 +230,37 @@ static struct HashElem *union_hash_insert(struct HashTable *table,
   if (!table)
     return NULL; // LCOV_EXCL_LINE
 
-  struct HashElem *he = mutt_mem_calloc(1, sizeof(struct HashElem));
-  size_t hash = table->gen_hash(key, table->num_elems);
-  he->key = key;
-  he->data = data;
-  he->type = type;
+  const size_t hash = table->gen_hash(key);
+  size_t slot = 0;
 
-  if (table->allow_dups)
-  {
-    he->next = table->table[hash];
-    table->table[hash] = he;
-  }
-  else
+  if (hash_lookup(table, key, hash, &slot))
   {
-    struct HashElem *tmp = NULL, *last = NULL;
-
-    for (tmp = table->table[hash], last = NULL; tmp; last = tmp, tmp = tmp->next)
+    if (!table->allow_dups)
     {
-      const int rc = table->cmp_key(tmp->key, key);
-      if (rc == 0)
-      {
-        FREE(&he);
-        return NULL;
-      }
-      if (rc > 0)
-        break;
+      if (table->strdup_keys)
+        FREE(&key.strkey);
+      return NULL;
     }
-    if (last)
-      last->next = he;
-    else
-      table->table[hash] = he;
-    he->next = tmp;
+
+    /* chain the duplicate off the canonical slot */
+    struct HashElem *he = mutt_mem_calloc(1, sizeof(struct HashElem));
+    he->hash = hash;
+    he->key = key;
+    he->data = data;
+    he->type = type;
+    he->next = table->table[slot];
+    table->table[slot] = he;
+    return he;
   }
+
+  struct HashElem *he = mutt_mem_calloc(1, sizeof(struct HashElem));
+  he->hash = hash;
+  he->key = key;
+  he->data = data;
+  he->type = type;
+
+  hash_grow(table);
+  hash_place(table, he);
   return he;
 }
 
@@ -180,14 +275,10 @@ static struct HashElem *union_hash_find_elem(const struct HashTable *table, unio
   if (!table)
     return NULL; // LCOV_EXCL_LINE
 
-  size_t hash = table->gen_hash(key, table->num_elems);
-  struct HashElem *he = table->table[hash];
-  for (; he; he = he->next)
-  {
-    if (table->cmp_key(key, he->key) == 0)
-      return he;
-  }
-  return NULL;
+  size_t slot = 0;
+  if (!hash_lookup(table, key, table->gen_hash(key), &slot))
+    return NULL;
+  return table->table[slot];
 }
 
 /**
@@ -217,13 +308,17 @@ static void union_hash_delete(struct HashTable *table, union HashKey key, const
   if (!table)
     return; // LCOV_EXCL_LINE
 
-  size_t hash = table->gen_hash(key, table->num_elems);
-  struct HashElem *he = table->table[hash];
-  struct HashElem **last = &table->table[hash];
+  size_t slot = 0;
+  if (!hash_lookup(table, key, table->gen_hash(key), &slot))
+    return;
+
+  /* all entries for this key are chained off the one slot */
+  struct HashElem *he = table->table[slot];
+  struct HashElem **last = &table->table[slot];
 
   while (he)
   {
-    if (((data == he->data) || !data) && (table->cmp_key(he->key, key) == 0))
+    if ((data == he->data) || !data)
     {
       *last = he->next;
       if (table->hdata_free)
@@ -240,6 +335,24 @@ static void union_hash_delete(struct HashTable *table, union HashKey key, const
       he = he->next;
     }
   }
+
+  if (table->table[slot])
+    return;
+
+  /* the slot is empty now - shift later entries back over it so that probe
+   * walks never cross a gap */
+  const size_t mask = table->num_elems - 1;
+  while (true)
+  {
+    const size_t next = (slot + 1) & mask;
+    struct HashElem *tmp = table->table[next];
+    if (!tmp || (hash_dist(table, tmp->hash, next) == 0))
+      break;
+    table->table[slot] = tmp;
+    slot = next;
+  }
+  table->table[slot] = NULL;
+  table->num_used--;
 }
 
 /**
@@ -396,7 +509,8 @@ void *mutt_hash_int_find(const struct HashTable *table, unsigned int intkey)
  * @param strkey String key to search for
  * @retval ptr HashElem matching the key
  *
- * Unlike mutt_hash_find_elem(), this will return the first matching entry.
+ * Unlike mutt_hash_find_elem(), this will return the whole chain of entries
+ * for the key, linked by HashElem.next.
  */
 struct HashElem *mutt_hash_find_bucket(const struct HashTable *table, const char *strkey)
 {
@@ -406,8 +520,7 @@ struct HashElem *mutt_hash_find_bucket(const struct HashTable *table, const char
   union HashKey key;
 
   key.strkey = strkey;
-  size_t hash = table->gen_hash(key, table->num_elems);
-  return table->table[hash];
+  return union_hash_find_elem(table, key);
 }
 
 /**
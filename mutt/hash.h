@@ -43,9 +43,10 @@ union HashKey
 struct HashElem
 {
   int type;              ///< Type of data stored in Hash Table, e.g. #DT_STRING
+  size_t hash;           ///< Cached hash of the key
   union HashKey key;     ///< Key representing the data
   void *data;            ///< User-supplied data
-  struct HashElem *next; ///< Linked List
+  struct HashElem *next; ///< Linked List of duplicate keys
 };
 
 /**
@@ -58,13 +59,12 @@ typedef void (*hash_hdata_free_t)(int type, void *obj, intptr_t data);
 
 /**
  * typedef hash_gen_hash_t - Prototype for a Key hashing function
- * @param key       Key to hash
- * @param num_elems Number of elements in the Hash Table
+ * @param key Key to hash
  *
- * Turn a Key (a string or an integer) into a hash id.
- * The hash id will be a number between 0 and (num_elems-1).
+ * Turn a Key (a string or an integer) into a full-width hash.
+ * The Hash Table reduces the hash to a slot index itself.
  */
-typedef size_t (*hash_gen_hash_t)(union HashKey key, size_t num_elems);
+typedef size_t (*hash_gen_hash_t)(union HashKey key);
 
 /**
  * typedef hash_cmp_key_t - Prototype for a function to compare two Hash keys
@@ -80,10 +80,17 @@ typedef int (*hash_cmp_key_t)(union HashKey a, union HashKey b);
 
 /**
  * struct HashTable - A Hash Table
+ *
+ * The table is open-addressed with robin-hood linear probing: each slot holds
+ * at most one key and probe walks stay in the flat slot array.  Duplicate keys
+ * (#MUTT_HASH_ALLOW_DUPS) are chained off their canonical slot via
+ * HashElem.next.  The slot array grows when it gets too full, but the
+ * HashElems themselves never move, so pointers to them remain valid.
  */
 struct HashTable
 {
-  size_t num_elems;             ///< Number of elements in the Hash Table
+  size_t num_elems;             ///< Number of slots in the Hash Table
+  size_t num_used;              ///< Number of slots in use
   bool strdup_keys : 1;         ///< if set, the key->strkey is strdup()'d
   bool allow_dups  : 1;         ///< if set, duplicate keys are allowed
   struct HashElem **table;      ///< Array of Hash keys
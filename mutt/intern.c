@@ -0,0 +1,127 @@
+/**
+ * @file
+ * Shared, refcounted strings
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_intern Shared, refcounted strings
+ *
+ * Header fields like References repeat the same Message-IDs across every mail
+ * in a thread.  Interning such strings makes all the identical copies share
+ * one refcounted allocation in a Hash Table.
+ *
+ * mutt_intern_release() accepts ordinary heap strings as well as interned
+ * ones, so consumers of mixed lists only need to convert their free sites.
+ */
+
+#include "config.h"
+#include <stdint.h>
+#include "intern.h"
+#include "hash.h"
+#include "list.h"
+#include "memory.h"
+#include "queue.h"
+
+/// Lookup table of the shared strings; the refcount lives in HashElem.data
+static struct HashTable *InternTable = NULL;
+
+/**
+ * mutt_intern_dup - Get a shared copy of a string
+ * @param str String to copy
+ * @retval ptr Interned copy of the string
+ *
+ * Identical strings share one allocation; every call must be balanced by
+ * mutt_intern_release().  The result must be treated as immutable.
+ */
+char *mutt_intern_dup(const char *str)
+{
+  if (!str)
+    return NULL;
+
+  if (!InternTable)
+    InternTable = mutt_hash_new(1024, MUTT_HASH_STRDUP_KEYS);
+
+  struct HashElem *he = mutt_hash_find_elem(InternTable, str);
+  if (!he)
+    he = mutt_hash_insert(InternTable, str, NULL);
+
+  he->data = (void *) ((intptr_t) he->data + 1);
+  return (char *) he->key.strkey;
+}
+
+/**
+ * mutt_intern_release - Release a string obtained from mutt_intern_dup()
+ * @param[out] ptr String to release
+ *
+ * The string is freed once its last reference is gone.  Strings that were
+ * never interned are simply freed, so it's safe to use this on fields that
+ * hold a mix of interned and plain heap strings.
+ */
+void mutt_intern_release(char **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct HashElem *he = InternTable ? mutt_hash_find_elem(InternTable, *ptr) : NULL;
+  if (!he || (he->key.strkey != *ptr))
+  {
+    FREE(ptr); /* not interned - an ordinary heap string */
+    return;
+  }
+
+  const intptr_t count = (intptr_t) he->data - 1;
+  if (count > 0)
+    he->data = (void *) count;
+  else
+    mutt_hash_delete(InternTable, *ptr, NULL);
+  *ptr = NULL;
+}
+
+/**
+ * mutt_intern_list_free - Free a List of interned strings
+ * @param h Head of the List
+ *
+ * Counterpart of mutt_list_free() for Lists whose data is interned.
+ */
+void mutt_intern_list_free(struct ListHead *h)
+{
+  if (!h)
+    return;
+
+  struct ListNode *np = STAILQ_FIRST(h), *next = NULL;
+  while (np)
+  {
+    next = STAILQ_NEXT(np, entries);
+    mutt_intern_release(&np->data);
+    FREE(&np);
+    np = next;
+  }
+  STAILQ_INIT(h);
+}
+
+/**
+ * mutt_intern_cleanup - Free the intern table
+ *
+ * All references must have been released already.
+ */
+void mutt_intern_cleanup(void)
+{
+  mutt_hash_free(&InternTable);
+}
@@ -34,9 +34,11 @@
  * | mutt/date.c      | @subpage mutt_date      |
  * | mutt/envlist.c   | @subpage mutt_envlist   |
  * | mutt/exit.c      | @subpage mutt_exit      |
+ * | mutt/fasthash.c  | @subpage mutt_fasthash  |
  * | mutt/file.c      | @subpage mutt_file      |
  * | mutt/filter.c    | @subpage mutt_filter    |
  * | mutt/hash.c      | @subpage mutt_hash      |
+ * | mutt/intern.c    | @subpage mutt_intern    |
  * | mutt/list.c      | @subpage mutt_list      |
  * | mutt/logging.c   | @subpage mutt_logging   |
  * | mutt/mapping.c   | @subpage mutt_mapping   |
@@ -51,8 +53,11 @@
  * | mutt/random.c    | @subpage mutt_random    |
  * | mutt/regex.c     | @subpage mutt_regex     |
  * | mutt/slist.c     | @subpage mutt_slist     |
+ * | mutt/stats.c     | @subpage mutt_stats     |
  * | mutt/signal.c    | @subpage mutt_signal    |
  * | mutt/string.c    | @subpage mutt_string    |
+ * | mutt/throttle.c  | @subpage mutt_throttle  |
+ * | mutt/trace.c     | @subpage mutt_trace     |
  *
  * @note The library is self-contained -- some files may depend on others in
  *       the library, but none depends on source from outside.
@@ -69,9 +74,11 @@
 #include "date.h"
 #include "envlist.h"
 #include "exit.h"
+#include "fasthash.h"
 #include "file.h"
 #include "filter.h"
 #include "hash.h"
+#include "intern.h"
 #include "list.h"
 #include "logging.h"
 #include "mapping.h"
@@ -90,7 +97,10 @@
 #include "regex3.h"
 #include "signal2.h"
 #include "slist.h"
+#include "stats.h"
 #include "string2.h"
+#include "throttle.h"
+#include "trace.h"
 // IWYU pragma: end_exports
 
 #endif /* MUTT_MUTT_LIB_H */
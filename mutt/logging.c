@@ -51,6 +51,17 @@ const char *LevelAbbr = "PEWM12345N"; ///< Abbreviations of logging level names
  */
 log_dispatcher_t MuttLogger = log_disp_terminal;
 
+/**
+ * MuttLogCeiling - Highest log level worth dispatching
+ *
+ * mutt_debug() compares its level against this inline, so debug calls in hot
+ * loops skip the dispatcher (and its varargs setup) entirely when the line
+ * would be discarded anyway.  Code that switches #MuttLogger or changes the
+ * active log level is responsible for keeping the ceiling in step; LL_MAX
+ * (the safe default) means "dispatch everything".
+ */
+int MuttLogCeiling = LL_MAX;
+
 FILE *LogFileFP = NULL;      ///< Log file handle
 char *LogFileName = NULL;    ///< Log file name
 int LogFileLevel = 0;        ///< Log file level
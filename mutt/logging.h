@@ -62,6 +62,7 @@ enum LogLevel
 typedef int (*log_dispatcher_t)(time_t stamp, const char *file, int line, const char *function, enum LogLevel level, ...);
 
 extern log_dispatcher_t MuttLogger;
+extern int MuttLogCeiling;
 
 /**
  * struct LogLine - A Log line
@@ -78,7 +79,12 @@ struct LogLine
 };
 STAILQ_HEAD(LogLineList, LogLine);
 
-#define mutt_debug(LEVEL, ...) MuttLogger(0, __FILE__, __LINE__, __func__, LEVEL,      __VA_ARGS__)
+/* The level check is inlined so that debug calls below the active level cost
+ * one integer compare, not a varargs dispatcher call.  See #MuttLogCeiling. */
+#define mutt_debug(LEVEL, ...)                                                 \
+  (((LEVEL) > MuttLogCeiling) ?                                                \
+       0 :                                                                     \
+       MuttLogger(0, __FILE__, __LINE__, __func__, LEVEL, __VA_ARGS__))
 #define mutt_warning(...)      MuttLogger(0, __FILE__, __LINE__, __func__, LL_WARNING, __VA_ARGS__)
 #define mutt_message(...)      MuttLogger(0, __FILE__, __LINE__, __func__, LL_MESSAGE, __VA_ARGS__)
 #define mutt_error(...)        MuttLogger(0, __FILE__, __LINE__, __func__, LL_ERROR,   __VA_ARGS__)
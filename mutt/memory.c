@@ -35,6 +35,7 @@
 #include "exit.h"
 #include "logging.h"
 #include "message.h"
+#include "stats.h"
 
 /**
  * mutt_mem_calloc - Allocate zeroed memory on the heap
@@ -58,6 +59,8 @@ void *mutt_mem_calloc(size_t nmemb, size_t size)
     mutt_error(_("Out of memory"));
     mutt_exit(1);
   }
+  mutt_stats_count("mem/calloc-calls", 1);
+  mutt_stats_count("mem/calloc-bytes", nmemb * size);
   return p;
 }
 
@@ -98,6 +101,8 @@ void *mutt_mem_malloc(size_t size)
     mutt_error(_("Out of memory"));
     mutt_exit(1);
   }
+  mutt_stats_count("mem/malloc-calls", 1);
+  mutt_stats_count("mem/malloc-bytes", size);
   return p;
 }
 
@@ -135,5 +140,6 @@ void mutt_mem_realloc(void *ptr, size_t size)
     mutt_exit(1);
   }
 
+  mutt_stats_count("mem/realloc-calls", 1);
   *p = r;
 }
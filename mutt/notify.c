@@ -29,6 +29,7 @@
 #include "config.h"
 #include <stddef.h>
 #include <stdbool.h>
+#include <string.h>
 #include "notify.h"
 #include "memory.h"
 #include "queue.h"
@@ -42,6 +43,27 @@ struct Notify
   struct ObserverList observers;
 };
 
+/// Maximum payload size notify_send_coalesce() can copy for deferral
+#define NOTIFY_COALESCE_MAX 32
+
+/**
+ * struct DeferredNotify - Event postponed by notify_begin_batch()
+ */
+struct DeferredNotify
+{
+  struct Notify *notify;                ///< Object the event was sent on
+  enum NotifyType event_type;           ///< Type of event, e.g. #NT_MAILBOX
+  int event_subtype;                    ///< Subtype, e.g. #NT_MAILBOX_UPDATE
+  char event_data[NOTIFY_COALESCE_MAX]; ///< Copy of the event payload
+  STAILQ_ENTRY(DeferredNotify) entries; ///< Linked list
+};
+STAILQ_HEAD(DeferredNotifyList, DeferredNotify);
+
+/// Nesting depth of notify_begin_batch() calls
+static int BatchDepth = 0;
+/// Events held back until the outermost notify_end_batch(), in first-sent order
+static struct DeferredNotifyList DeferredEvents = STAILQ_HEAD_INITIALIZER(DeferredEvents);
+
 /**
  * notify_new - Create a new notifications handler
  * @retval ptr New notification handler
@@ -69,6 +91,18 @@ void notify_free(struct Notify **ptr)
 
   notify_observer_remove_all(notify);
 
+  /* Don't let a batch dispatch events on a dead handler */
+  struct DeferredNotify *dn = NULL;
+  struct DeferredNotify *tmp = NULL;
+  STAILQ_FOREACH_SAFE(dn, &DeferredEvents, entries, tmp)
+  {
+    if (dn->notify != notify)
+      continue;
+
+    STAILQ_REMOVE(&DeferredEvents, dn, DeferredNotify, entries);
+    FREE(&dn);
+  }
+
   FREE(ptr);
 }
 
@@ -155,6 +189,97 @@ bool notify_send(struct Notify *notify, enum NotifyType event_type,
   return send(notify, notify, event_type, event_subtype, event_data);
 }
 
+/**
+ * notify_send_coalesce - Send a notification message, merging duplicates in a batch
+ * @param notify        Notification handler
+ * @param event_type    Type of event, e.g. #NT_MAILBOX
+ * @param event_subtype Subtype, e.g. #NT_MAILBOX_UPDATE
+ * @param event_data    Private data associated with the event
+ * @param size          Size of the event data, in bytes
+ * @retval true If successfully sent or deferred
+ *
+ * Outside a batch scope, this is identical to notify_send().  Inside one (see
+ * notify_begin_batch()), the event payload is copied and the dispatch is
+ * postponed until the outermost notify_end_batch().  Repeats of the same
+ * (handler, type, subtype) are merged: only one event is delivered, carrying
+ * the most recent payload.  Bulk operations can therefore send an event per
+ * item without triggering every observer per item.
+ *
+ * Only use this for events that describe object *state* (e.g. "mailbox
+ * changed"), where the last event supersedes earlier ones.  Events that each
+ * carry distinct information must go through notify_send().
+ *
+ * @note Payloads larger than #NOTIFY_COALESCE_MAX cannot be copied and are
+ *       dispatched immediately.
+ */
+bool notify_send_coalesce(struct Notify *notify, enum NotifyType event_type,
+                          int event_subtype, void *event_data, size_t size)
+{
+  if (!notify)
+    return false;
+
+  if ((BatchDepth == 0) || !event_data || (size == 0) || (size > NOTIFY_COALESCE_MAX))
+    return notify_send(notify, event_type, event_subtype, event_data);
+
+  struct DeferredNotify *dn = NULL;
+  STAILQ_FOREACH(dn, &DeferredEvents, entries)
+  {
+    if ((dn->notify == notify) && (dn->event_type == event_type) &&
+        (dn->event_subtype == event_subtype))
+    {
+      break;
+    }
+  }
+
+  if (!dn)
+  {
+    dn = mutt_mem_calloc(1, sizeof(*dn));
+    dn->notify = notify;
+    dn->event_type = event_type;
+    dn->event_subtype = event_subtype;
+    STAILQ_INSERT_TAIL(&DeferredEvents, dn, entries);
+  }
+
+  memcpy(dn->event_data, event_data, size); // last payload wins
+  return true;
+}
+
+/**
+ * notify_begin_batch - Start coalescing notification messages
+ *
+ * Until the matching notify_end_batch(), events sent with
+ * notify_send_coalesce() are held back and duplicates are merged.  Batches
+ * nest; events are delivered when the outermost batch ends.
+ */
+void notify_begin_batch(void)
+{
+  BatchDepth++;
+}
+
+/**
+ * notify_end_batch - Stop coalescing and deliver the pending messages
+ *
+ * Deferred events are dispatched in the order they were first sent.
+ */
+void notify_end_batch(void)
+{
+  if (BatchDepth == 0)
+    return;
+  if (--BatchDepth > 0)
+    return;
+
+  /* Observers may send (or free) further notifications; with BatchDepth back
+   * at zero those dispatch immediately, and notify_free() may remove entries
+   * we haven't reached yet - so re-read the head each time round */
+  struct DeferredNotify *dn = NULL;
+  while ((dn = STAILQ_FIRST(&DeferredEvents)))
+  {
+    STAILQ_REMOVE_HEAD(&DeferredEvents, entries);
+    send(dn->notify, dn->notify, dn->event_type, dn->event_subtype, dn->event_data);
+    FREE(&dn);
+  }
+}
+
 /**
  * notify_observer_add - Add an observer to an object
  * @param notify      Notification handler
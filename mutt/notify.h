@@ -24,6 +24,7 @@
 #define MUTT_LIB_NOTIFY_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include "notify_type.h"
 #include "observer.h"
 
@@ -34,6 +35,9 @@ void notify_free(struct Notify **ptr);
 void notify_set_parent(struct Notify *notify, struct Notify *parent);
 
 bool notify_send(struct Notify *notify, enum NotifyType event_type, int event_subtype, void *event_data);
+bool notify_send_coalesce(struct Notify *notify, enum NotifyType event_type, int event_subtype, void *event_data, size_t size);
+void notify_begin_batch(void);
+void notify_end_batch(void);
 bool notify_observer_add(struct Notify *notify, enum NotifyType type, observer_t callback, void *global_data);
 bool notify_observer_remove(struct Notify *notify, observer_t callback, void *global_data);
 void notify_observer_remove_all(struct Notify *notify);
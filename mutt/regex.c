@@ -42,6 +42,111 @@
 #include "regex3.h"
 #include "string2.h"
 
+/**
+ * regex_literal_filter - Find a literal that every match must contain
+ * @param pat   Regular expression
+ * @param icase Pattern will be compiled with REG_ICASE
+ * @retval ptr  Newly allocated literal substring
+ * @retval NULL No usable literal in the pattern
+ *
+ * Returns the longest run of literal characters that any match of the pattern
+ * has to include, so the caller can screen candidate strings with a substring
+ * search before paying for regexec().  The analysis is conservative: any
+ * construct it can't reason about (groups, classes, alternation, escapes)
+ * disables the filter for the whole pattern.
+ */
+static char *regex_literal_filter(const char *pat, bool icase)
+{
+  if (!pat)
+    return NULL;
+
+  char *run = mutt_mem_calloc(strlen(pat) + 1, 1);
+  size_t len = 0;     // length of the current literal run
+  size_t best = 0;    // length of the longest mandatory run so far
+  size_t best_at = 0; // where the longest run started, in `run`
+  size_t start = 0;   // where the current run started, in `run`
+
+  for (const char *p = pat; *p; p++)
+  {
+    switch (*p)
+    {
+      case '(':
+      case ')':
+      case '[':
+      case ']':
+      case '|':
+      case '\\':
+        FREE(&run);
+        return NULL;
+
+      case '{':
+        /* skip the interval - its digits are not literal text */
+        while (*p && (*p != '}'))
+          p++;
+        if (!*p)
+        {
+          FREE(&run);
+          return NULL;
+        }
+        /* fallthrough */
+      case '*':
+      case '?':
+        /* quantifier - the previous character is optional */
+        if (len > 0)
+        {
+          if (((unsigned char) run[start + len - 1]) & 0x80)
+          {
+            /* dropping one byte would split a multibyte character */
+            FREE(&run);
+            return NULL;
+          }
+          len--;
+        }
+        /* fallthrough */
+      case '.':
+      case '^':
+      case '$':
+      case '+': /* one-or-more: the character stays, but the run ends */
+        if (len > best)
+        {
+          best = len;
+          best_at = start;
+        }
+        start += len + 1;
+        len = 0;
+        break;
+
+      default:
+        if (icase && (((unsigned char) *p) & 0x80))
+        {
+          /* mutt_istr_find() folds case byte-wise, regexec() per locale */
+          FREE(&run);
+          return NULL;
+        }
+        run[start + len] = *p;
+        len++;
+        break;
+    }
+  }
+  if (len > best)
+  {
+    best = len;
+    best_at = start;
+  }
+
+  /* A one-character needle rarely rejects anything; not worth the lookup */
+  if (best < 2)
+  {
+    FREE(&run);
+    return NULL;
+  }
+
+  run[best_at + best] = '\0';
+  char *filter = mutt_str_dup(run + best_at);
+  FREE(&run);
+  return filter;
+}
+
 /**
  * mutt_regex_compile - Create an Regex from a string
  * @param str   Regular expression
@@ -58,6 +163,11 @@ struct Regex *mutt_regex_compile(const char *str, int flags)
   rx->regex = mutt_mem_calloc(1, sizeof(regex_t));
   if (REG_COMP(rx->regex, str, flags) != 0)
     mutt_regex_free(&rx);
+  else
+  {
+    rx->prefilter = regex_literal_filter(str, (flags & REG_ICASE));
+    rx->icase = (flags & REG_ICASE);
+  }
 
   return rx;
 }
@@ -100,6 +210,12 @@ struct Regex *mutt_regex_new(const char *str, int flags, struct Buffer *err)
     return NULL;
   }
 
+  if (rc == 0)
+  {
+    reg->prefilter = regex_literal_filter(str, (rflags & REG_ICASE));
+    reg->icase = (rflags & REG_ICASE);
+  }
+
   return reg;
 }
 
@@ -113,6 +229,7 @@ void mutt_regex_free(struct Regex **r)
     return;
 
   FREE(&(*r)->pattern);
+  FREE(&(*r)->prefilter);
   if ((*r)->regex)
     regfree((*r)->regex);
   FREE(&(*r)->regex);
@@ -596,6 +713,14 @@ bool mutt_regex_capture(const struct Regex *regex, const char *str,
   if (!regex || !str || !regex->regex)
     return false;
 
+  /* Screen with a substring search first: every match has to contain the
+   * prefilter literal, and most strings on the hot paths won't */
+  if (regex->prefilter &&
+      !(regex->icase ? mutt_istr_find(str, regex->prefilter) : strstr(str, regex->prefilter)))
+  {
+    return (false ^ regex->pat_not);
+  }
+
   int rc = regexec(regex->regex, str, nmatch, matches, 0);
   return ((rc == 0) ^ regex->pat_not);
 }
@@ -87,9 +87,11 @@ static inline size_t mutt_regmatch_len(const regmatch_t *match)
  */
 struct Regex
 {
-  char *pattern;  ///< printable version
-  regex_t *regex; ///< compiled expression
-  bool pat_not;       ///< do not match
+  char *pattern;    ///< printable version
+  regex_t *regex;   ///< compiled expression
+  bool pat_not;     ///< do not match
+  char *prefilter;  ///< literal every match must contain, or NULL
+  bool icase;       ///< compiled with REG_ICASE, prefilter must match likewise
 };
 
 /**
@@ -0,0 +1,258 @@
+/**
+ * @file
+ * Named event counters for performance visibility
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_stats Named event counters
+ *
+ * Cheap always-on counters for the events that matter when chasing
+ * performance: cache hits and misses, headers parsed, server commands
+ * issued, redraws.  Modules count with mutt_stats_count(), which registers
+ * the counter on first use; the `stats` command renders the registry with
+ * mutt_stats_report().  In a session that has been running for weeks the
+ * numbers show where the time has actually been going.
+ *
+ * Timers add latency histograms on top: mutt_stats_record_ms() files each
+ * duration into power-of-two millisecond buckets, and the report derives
+ * p50/p90/p99 from them - enough resolution to tell which of the rare
+ * stalls come from mail I/O and which from redraw.
+ */
+
+#include "config.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stats.h"
+#include "logging.h"
+#include "string2.h"
+
+/// How many distinct counters the registry holds
+#define STATS_COUNTERS_LEN 64
+
+/// How many distinct timers the registry holds
+#define STATS_TIMERS_LEN 16
+
+static struct StatsCounter Counters[STATS_COUNTERS_LEN];
+static int CountersUsed = 0; ///< Number of registered counters
+
+static struct StatsTimer Timers[STATS_TIMERS_LEN];
+static int TimersUsed = 0; ///< Number of registered timers
+
+/**
+ * mutt_stats_register - Find or create a named counter
+ * @param name Counter label, e.g. "hcache/hit"
+ * @retval ptr  The counter
+ * @retval NULL Invalid name, or the registry is full
+ */
+struct StatsCounter *mutt_stats_register(const char *name)
+{
+  if (!name || (*name == '\0'))
+    return NULL;
+
+  for (int i = 0; i < CountersUsed; i++)
+  {
+    if (mutt_str_equal(Counters[i].name, name))
+      return &Counters[i];
+  }
+
+  if (CountersUsed == STATS_COUNTERS_LEN)
+    return NULL;
+
+  struct StatsCounter *sc = &Counters[CountersUsed++];
+  mutt_str_copy(sc->name, name, sizeof(sc->name));
+  return sc;
+}
+
+/**
+ * mutt_stats_timer_register - Find or create a named latency timer
+ * @param name Timer label, e.g. "index/op"
+ * @retval ptr  The timer
+ * @retval NULL Invalid name, or the registry is full
+ */
+struct StatsTimer *mutt_stats_timer_register(const char *name)
+{
+  if (!name || (*name == '\0'))
+    return NULL;
+
+  for (int i = 0; i < TimersUsed; i++)
+  {
+    if (mutt_str_equal(Timers[i].name, name))
+      return &Timers[i];
+  }
+
+  if (TimersUsed == STATS_TIMERS_LEN)
+    return NULL;
+
+  struct StatsTimer *st = &Timers[TimersUsed++];
+  mutt_str_copy(st->name, name, sizeof(st->name));
+  return st;
+}
+
+/**
+ * mutt_stats_timer_record - Add one duration to a timer's histogram
+ * @param st Timer
+ * @param ms Duration in milliseconds
+ */
+void mutt_stats_timer_record(struct StatsTimer *st, uint64_t ms)
+{
+  if (!st)
+    return;
+
+  int bucket = 0;
+  while ((bucket < (STATS_TIMER_BUCKETS - 1)) && (ms >= (1ULL << bucket)))
+    bucket++;
+
+  st->count++;
+  st->total_ms += ms;
+  if (ms > st->max_ms)
+    st->max_ms = ms;
+  st->buckets[bucket]++;
+}
+
+/**
+ * timer_percentile - Estimate a percentile from a timer's histogram
+ * @param st  Timer
+ * @param pct Percentile, e.g. 99
+ * @retval num The bucket's upper bound in milliseconds
+ *
+ * The answer is only as precise as the power-of-two buckets, which is enough
+ * to tell a 2ms redraw from a 500ms mail-store stall.
+ */
+static uint64_t timer_percentile(const struct StatsTimer *st, int pct)
+{
+  const uint64_t target = (st->count * pct + 99) / 100;
+  uint64_t seen = 0;
+
+  for (int i = 0; i < STATS_TIMER_BUCKETS; i++)
+  {
+    seen += st->buckets[i];
+    if (seen >= target)
+    {
+      const uint64_t bound = (1ULL << i) - 1;
+      return (bound < st->max_ms) ? bound : st->max_ms;
+    }
+  }
+
+  return st->max_ms;
+}
+
+/**
+ * mutt_stats_clear - Zero all the counters and timers
+ *
+ * The registry itself is kept - call sites hold on to their counters.
+ */
+void mutt_stats_clear(void)
+{
+  for (int i = 0; i < CountersUsed; i++)
+    Counters[i].count = 0;
+
+  for (int i = 0; i < TimersUsed; i++)
+  {
+    char name[sizeof(Timers[i].name)];
+    mutt_str_copy(name, Timers[i].name, sizeof(name));
+    memset(&Timers[i], 0, sizeof(Timers[i]));
+    mutt_str_copy(Timers[i].name, name, sizeof(Timers[i].name));
+  }
+}
+
+/**
+ * stats_compare - Compare two counters by name - Implements ::sort_t
+ */
+static int stats_compare(const void *a, const void *b)
+{
+  const struct StatsCounter *ca = a;
+  const struct StatsCounter *cb = b;
+  return mutt_str_cmp(ca->name, cb->name);
+}
+
+/**
+ * timers_compare - Compare two timers by name - Implements ::sort_t
+ */
+static int timers_compare(const void *a, const void *b)
+{
+  const struct StatsTimer *ta = a;
+  const struct StatsTimer *tb = b;
+  return mutt_str_cmp(ta->name, tb->name);
+}
+
+/**
+ * mutt_stats_report - Write the counters and latency histograms to a file
+ * @param fp File to write to
+ */
+void mutt_stats_report(FILE *fp)
+{
+  if ((CountersUsed == 0) && (TimersUsed == 0))
+  {
+    fprintf(fp, "No events counted yet\n");
+    return;
+  }
+
+  struct StatsCounter sorted[STATS_COUNTERS_LEN];
+  memcpy(sorted, Counters, CountersUsed * sizeof(struct StatsCounter));
+  qsort(sorted, CountersUsed, sizeof(struct StatsCounter), stats_compare);
+
+  for (int i = 0; i < CountersUsed; i++)
+    fprintf(fp, "%-32s %12" PRIu64 "\n", sorted[i].name, sorted[i].count);
+
+  if (TimersUsed == 0)
+    return;
+
+  struct StatsTimer tsorted[STATS_TIMERS_LEN];
+  memcpy(tsorted, Timers, TimersUsed * sizeof(struct StatsTimer));
+  qsort(tsorted, TimersUsed, sizeof(struct StatsTimer), timers_compare);
+
+  fprintf(fp, "\n%-20s %10s %8s %8s %8s %8s\n", "latency (ms)", "count", "p50",
+          "p90", "p99", "max");
+  for (int i = 0; i < TimersUsed; i++)
+  {
+    const struct StatsTimer *st = &tsorted[i];
+    if (st->count == 0)
+      continue;
+    fprintf(fp, "%-20s %10" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64 "\n",
+            st->name, st->count, timer_percentile(st, 50),
+            timer_percentile(st, 90), timer_percentile(st, 99), st->max_ms);
+  }
+}
+
+/**
+ * mutt_stats_log - Write the counters to the debug log
+ *
+ * Called on shutdown, so a debug log of a long session ends with the totals.
+ */
+void mutt_stats_log(void)
+{
+  for (int i = 0; i < CountersUsed; i++)
+    mutt_debug(LL_DEBUG1, "stats: %s = %" PRIu64 "\n", Counters[i].name,
+               Counters[i].count);
+
+  for (int i = 0; i < TimersUsed; i++)
+  {
+    const struct StatsTimer *st = &Timers[i];
+    if (st->count == 0)
+      continue;
+    mutt_debug(LL_DEBUG1,
+               "stats: %s = %" PRIu64 " timings, p50 %" PRIu64 "ms, p99 %" PRIu64 "ms, max %" PRIu64 "ms\n",
+               st->name, st->count, timer_percentile(st, 50),
+               timer_percentile(st, 99), st->max_ms);
+  }
+}
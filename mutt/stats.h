@@ -0,0 +1,96 @@
+/**
+ * @file
+ * Named event counters for performance visibility
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_LIB_STATS_H
+#define MUTT_LIB_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * struct StatsCounter - One named event counter
+ */
+struct StatsCounter
+{
+  char name[48];  ///< Label, e.g. "hcache/hit"
+  uint64_t count; ///< Events since startup (or the last clear)
+};
+
+/// Latency buckets: bucket i counts events that took less than 2^i ms
+#define STATS_TIMER_BUCKETS 21
+
+/**
+ * struct StatsTimer - Latency histogram for one named operation
+ */
+struct StatsTimer
+{
+  char name[48];     ///< Label, e.g. "index/op"
+  uint64_t count;    ///< Events since startup (or the last clear)
+  uint64_t total_ms; ///< Sum of all the durations
+  uint64_t max_ms;   ///< Longest single duration
+  uint64_t buckets[STATS_TIMER_BUCKETS]; ///< Power-of-two millisecond buckets
+};
+
+struct StatsCounter *mutt_stats_register(const char *name);
+struct StatsTimer   *mutt_stats_timer_register(const char *name);
+void                 mutt_stats_timer_record(struct StatsTimer *st, uint64_t ms);
+void                 mutt_stats_clear(void);
+void                 mutt_stats_log(void);
+void                 mutt_stats_report(FILE *fp);
+
+/**
+ * mutt_stats_count - Count an event
+ * @param name Counter label, a string constant like "hcache/hit"
+ * @param n    Number of events
+ *
+ * The counter is looked up on first use and remembered, so counting an event
+ * afterwards costs one branch and one addition.
+ */
+#define mutt_stats_count(name, n)                                              \
+  do                                                                           \
+  {                                                                            \
+    static struct StatsCounter *counter = NULL;                                \
+    if (!counter)                                                              \
+      counter = mutt_stats_register(name);                                     \
+    if (counter)                                                               \
+      counter->count += (n);                                                   \
+  } while (false)
+
+/**
+ * mutt_stats_record_ms - Record how long an operation took
+ * @param name Timer label, a string constant like "index/op"
+ * @param ms   Duration in milliseconds
+ *
+ * Like mutt_stats_count(), the timer is looked up on first use and remembered.
+ */
+#define mutt_stats_record_ms(name, ms)                                         \
+  do                                                                           \
+  {                                                                            \
+    static struct StatsTimer *timer = NULL;                                    \
+    if (!timer)                                                                \
+      timer = mutt_stats_timer_register(name);                                 \
+    if (timer)                                                                 \
+      mutt_stats_timer_record(timer, ms);                                      \
+  } while (false)
+
+#endif /* MUTT_LIB_STATS_H */
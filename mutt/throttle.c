@@ -0,0 +1,131 @@
+/**
+ * @file
+ * Token-bucket rate limiting for background work
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_throttle Token-bucket rate limiting
+ *
+ * Opportunistic background work - prefetching message bodies, first-time
+ * statistics scans of a long mailbox list - shares its connections and disks
+ * with whatever the user just asked for.  Each such producer keeps a
+ * #TokenBucket and pays for work with mutt_throttle_take(); when the bucket
+ * is empty the work is skipped, not queued, because every producer here is
+ * retried naturally by the event loop.  The result is that a burst of
+ * background I/O is allowed when the session is quiet, but a sustained
+ * stream can never crowd out interactive traffic for long.
+ *
+ * NeoMutt is single-threaded, so this is a budget, not a scheduler: the
+ * tokens decide whether a piece of optional work runs now or later, never
+ * who runs first.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include "throttle.h"
+#include "date.h"
+#include "memory.h"
+
+/**
+ * mutt_throttle_init - Initialise a token bucket
+ * @param tb    Bucket to initialise
+ * @param rate  Tokens gained per second
+ * @param burst Most tokens the bucket can hold
+ *
+ * The bucket starts full, so the first burst of work after startup (or after
+ * a quiet period at least @a burst / @a rate seconds long) runs unthrottled.
+ */
+void mutt_throttle_init(struct TokenBucket *tb, uint64_t rate, uint64_t burst)
+{
+  if (!tb)
+    return;
+
+  tb->rate = rate;
+  tb->burst = burst;
+  tb->level_milli = burst * 1000;
+  tb->last_ms = mutt_date_epoch_ms();
+}
+
+/**
+ * mutt_throttle_take_at - Try to pay for some work, with an explicit clock
+ * @param tb     Bucket to draw from
+ * @param cost   Number of tokens the work costs
+ * @param now_ms Current time in milliseconds
+ * @retval true  The bucket could afford it; the tokens have been taken
+ * @retval false Not enough tokens; the work should be skipped
+ *
+ * The clock parameter exists for the tests; real callers use
+ * mutt_throttle_take().  Time only moves forward: a clock that appears to go
+ * backwards (e.g. wall-clock adjustment) refills nothing.
+ */
+bool mutt_throttle_take_at(struct TokenBucket *tb, uint64_t cost, uint64_t now_ms)
+{
+  if (!tb)
+    return false;
+
+  if (now_ms > tb->last_ms)
+  {
+    const uint64_t gain = (now_ms - tb->last_ms) * tb->rate;
+    tb->level_milli = MIN(tb->level_milli + gain, tb->burst * 1000);
+  }
+  tb->last_ms = now_ms;
+
+  if (tb->level_milli < (cost * 1000))
+    return false;
+
+  tb->level_milli -= cost * 1000;
+  return true;
+}
+
+/**
+ * mutt_throttle_take - Try to pay for some work
+ * @param tb   Bucket to draw from
+ * @param cost Number of tokens the work costs
+ * @retval true  The bucket could afford it; the tokens have been taken
+ * @retval false Not enough tokens; the work should be skipped
+ */
+bool mutt_throttle_take(struct TokenBucket *tb, uint64_t cost)
+{
+  return mutt_throttle_take_at(tb, cost, mutt_date_epoch_ms());
+}
+
+/**
+ * mutt_throttle_wait_ms - How long until some work becomes affordable?
+ * @param tb   Bucket to consult
+ * @param cost Number of tokens the work costs
+ * @retval 0   The bucket can afford it now
+ * @retval num Milliseconds until the balance reaches @a cost
+ * @retval UINT64_MAX The cost exceeds the burst size; it will never fit
+ */
+uint64_t mutt_throttle_wait_ms(const struct TokenBucket *tb, uint64_t cost)
+{
+  if (!tb || (tb->rate == 0))
+    return UINT64_MAX;
+  if (cost > tb->burst)
+    return UINT64_MAX;
+
+  const uint64_t need = cost * 1000;
+  if (tb->level_milli >= need)
+    return 0;
+
+  /* round up: a partial millisecond of refill isn't enough */
+  return ((need - tb->level_milli) + tb->rate - 1) / tb->rate;
+}
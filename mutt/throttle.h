@@ -0,0 +1,50 @@
+/**
+ * @file
+ * Token-bucket rate limiting for background work
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_LIB_THROTTLE_H
+#define MUTT_LIB_THROTTLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * struct TokenBucket - Budget for a stream of background operations
+ *
+ * The bucket holds at most TokenBucket::burst tokens and gains
+ * TokenBucket::rate tokens per second.  Work that can afford its cost runs
+ * immediately; work that can't is simply skipped and retried later, so a
+ * burst of activity is allowed but a sustained stream is capped at the rate.
+ */
+struct TokenBucket
+{
+  uint64_t rate;        ///< Tokens added per second
+  uint64_t burst;       ///< Most tokens the bucket can hold
+  uint64_t level_milli; ///< Current balance, in thousandths of a token
+  uint64_t last_ms;     ///< Timestamp of the last refill, in milliseconds
+};
+
+void     mutt_throttle_init   (struct TokenBucket *tb, uint64_t rate, uint64_t burst);
+bool     mutt_throttle_take   (struct TokenBucket *tb, uint64_t cost);
+bool     mutt_throttle_take_at(struct TokenBucket *tb, uint64_t cost, uint64_t now_ms);
+uint64_t mutt_throttle_wait_ms(const struct TokenBucket *tb, uint64_t cost);
+
+#endif /* MUTT_LIB_THROTTLE_H */
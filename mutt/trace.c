@@ -0,0 +1,195 @@
+/**
+ * @file
+ * Timed tracing of hot code paths
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_trace Timed tracing of hot code paths
+ *
+ * Record how long the expensive operations (folder open, header cache,
+ * threading, redraw, ...) actually take, without reaching for an external
+ * profiler.  A span is opened with mutt_trace_start() and closed with
+ * mutt_trace_end(); finished spans land in a small ring buffer, so only the
+ * most recent activity is kept, plus per-name running totals.  The report is
+ * rendered by mutt_trace_report() - in NeoMutt, via the `trace-report`
+ * command.
+ *
+ * Everything is gated on `$trace_spans`; when it's unset (the default) a span
+ * costs a single branch and no clock read, so the instrumentation can stay in
+ * the hot paths permanently.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "trace.h"
+#include "date.h"
+#include "string2.h"
+
+bool C_TraceSpans; ///< Config: Record timing spans for the trace-report command
+
+/// How many recent spans the ring buffer holds
+#define SPAN_RING_LEN 256
+
+/// How many distinct span names the totals table holds
+#define SPAN_TOTALS_LEN 32
+
+/**
+ * struct TraceSpan - One timed interval
+ */
+struct TraceSpan
+{
+  char name[48];    ///< Label, e.g. the function being timed
+  short depth;      ///< Nesting depth when the span was opened
+  uint64_t start;   ///< Start time, from mutt_date_epoch_ms()
+  uint64_t elapsed; ///< Duration in milliseconds
+  bool done;        ///< Has mutt_trace_end() been called?
+};
+
+/**
+ * struct TraceTotal - Running totals for one span name
+ */
+struct TraceTotal
+{
+  char name[48];     ///< Label, copied from the first matching span
+  size_t count;      ///< Number of finished spans with this name
+  uint64_t total_ms; ///< Sum of their durations
+};
+
+static struct TraceSpan SpanRing[SPAN_RING_LEN];
+static struct TraceTotal SpanTotals[SPAN_TOTALS_LEN];
+static int SpanCount;   ///< Spans started since the last clear
+static short SpanDepth; ///< Current nesting depth
+
+/**
+ * mutt_trace_start - Open a timed span
+ * @param name Label for the span, e.g. the function name
+ * @retval num Handle to pass to mutt_trace_end()
+ * @retval -1  Tracing is disabled
+ *
+ * When `$trace_spans` is unset this is a single branch - it's safe to leave
+ * calls in hot paths.
+ */
+int mutt_trace_start(const char *name)
+{
+  if (!C_TraceSpans || !name)
+    return -1;
+
+  const int handle = SpanCount++;
+  struct TraceSpan *ts = &SpanRing[handle % SPAN_RING_LEN];
+  mutt_str_copy(ts->name, name, sizeof(ts->name));
+  ts->depth = SpanDepth++;
+  ts->elapsed = 0;
+  ts->done = false;
+  ts->start = mutt_date_epoch_ms();
+  return handle;
+}
+
+/**
+ * mutt_trace_end - Close a timed span
+ * @param handle Handle from mutt_trace_start()
+ *
+ * Records the duration and folds it into the per-name totals.  A handle of -1
+ * (tracing was off at the start) is ignored, so callers don't need to check.
+ */
+void mutt_trace_end(int handle)
+{
+  if (handle < 0)
+    return;
+
+  if (SpanDepth > 0)
+    SpanDepth--;
+
+  if ((SpanCount - handle) > SPAN_RING_LEN)
+    return; /* the slot has been recycled by newer spans */
+
+  struct TraceSpan *ts = &SpanRing[handle % SPAN_RING_LEN];
+  ts->elapsed = mutt_date_epoch_ms() - ts->start;
+  ts->done = true;
+
+  for (int i = 0; i < SPAN_TOTALS_LEN; i++)
+  {
+    struct TraceTotal *tt = &SpanTotals[i];
+    if (tt->count == 0)
+      mutt_str_copy(tt->name, ts->name, sizeof(tt->name));
+    else if (!mutt_str_equal(tt->name, ts->name))
+      continue;
+
+    tt->count++;
+    tt->total_ms += ts->elapsed;
+    break;
+  }
+}
+
+/**
+ * mutt_trace_clear - Discard all recorded spans and totals
+ */
+void mutt_trace_clear(void)
+{
+  memset(SpanRing, 0, sizeof(SpanRing));
+  memset(SpanTotals, 0, sizeof(SpanTotals));
+  SpanCount = 0;
+  SpanDepth = 0;
+}
+
+/**
+ * mutt_trace_report - Write the recorded spans and totals to a file
+ * @param fp File to write to
+ *
+ * The spans are listed oldest-first, indented by nesting depth, with their
+ * start time relative to the oldest span still in the ring.  The totals table
+ * below covers every finished span since the last clear, including those that
+ * have already fallen out of the ring.
+ */
+void mutt_trace_report(FILE *fp)
+{
+  if (SpanCount == 0)
+  {
+    fprintf(fp, "No spans recorded - 'set trace_spans' and repeat the slow operation\n");
+    return;
+  }
+
+  const int first = (SpanCount > SPAN_RING_LEN) ? (SpanCount - SPAN_RING_LEN) : 0;
+  if (first != 0)
+    fprintf(fp, "(showing the last %d of %d spans)\n\n", SPAN_RING_LEN, SpanCount);
+
+  const uint64_t t0 = SpanRing[first % SPAN_RING_LEN].start;
+
+  fprintf(fp, "%10s %9s  span\n", "start", "elapsed");
+  for (int i = first; i < SpanCount; i++)
+  {
+    const struct TraceSpan *ts = &SpanRing[i % SPAN_RING_LEN];
+    fprintf(fp, "%8lums %7lums  %*s%s%s\n", (unsigned long) (ts->start - t0),
+            (unsigned long) ts->elapsed, 2 * ts->depth, "", ts->name,
+            ts->done ? "" : " (unfinished)");
+  }
+
+  fprintf(fp, "\n%-32s %8s %10s %8s\n", "totals", "count", "total", "mean");
+  for (int i = 0; i < SPAN_TOTALS_LEN; i++)
+  {
+    const struct TraceTotal *tt = &SpanTotals[i];
+    if (tt->count == 0)
+      break;
+    fprintf(fp, "%-32s %8zu %8lums %6lums\n", tt->name, tt->count,
+            (unsigned long) tt->total_ms, (unsigned long) (tt->total_ms / tt->count));
+  }
+}
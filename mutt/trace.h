@@ -0,0 +1,36 @@
+/**
+ * @file
+ * Timed tracing of hot code paths
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_LIB_TRACE_H
+#define MUTT_LIB_TRACE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+extern bool C_TraceSpans;
+
+int  mutt_trace_start(const char *name);
+void mutt_trace_end(int handle);
+void mutt_trace_clear(void);
+void mutt_trace_report(FILE *fp);
+
+#endif /* MUTT_LIB_TRACE_H */
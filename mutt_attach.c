@@ -48,6 +48,7 @@
 #include "copy.h"
 #include "handler.h"
 #include "mailcap.h"
+#include "mutt_body.h"
 #include "mutt_globals.h"
 #include "muttlib.h"
 #include "mx.h"
@@ -126,6 +127,8 @@ int mutt_compose_attachment(struct Body *a)
   struct Buffer *newfile = mutt_buffer_pool_get();
   struct Buffer *tmpfile = mutt_buffer_pool_get();
 
+  mutt_body_decode_preencoded(a);
+
   snprintf(type, sizeof(type), "%s/%s", TYPE(a), a->subtype);
   if (mailcap_lookup(a, type, sizeof(type), entry, MUTT_MC_COMPOSE))
   {
@@ -264,6 +267,8 @@ int mutt_edit_attachment(struct Body *a)
   struct Buffer *cmd = mutt_buffer_pool_get();
   struct Buffer *newfile = mutt_buffer_pool_get();
 
+  mutt_body_decode_preencoded(a);
+
   snprintf(type, sizeof(type), "%s/%s", TYPE(a), a->subtype);
   if (mailcap_lookup(a, type, sizeof(type), entry, MUTT_MC_EDIT))
   {
@@ -427,6 +432,9 @@ int mutt_view_attachment(FILE *fp, struct Body *a, enum ViewAttachMode mode,
   bool unlink_tempfile = false;
   bool unlink_pagerfile = false;
 
+  if (!fp)
+    mutt_body_decode_preencoded(a);
+
   bool is_message = mutt_is_message_type(a->type, a->subtype);
   if ((WithCrypto != 0) && is_message && a->email &&
       (a->email->security & SEC_ENCRYPT) && !crypt_valid_passphrase(a->email->security))
@@ -711,6 +719,9 @@ int mutt_pipe_attachment(FILE *fp, struct Body *b, const char *path, char *outfi
   FILE *fp_filter = NULL, *fp_unstuff = NULL, *fp_in = NULL;
   struct Buffer *unstuff_tempfile = NULL;
 
+  if (!fp)
+    mutt_body_decode_preencoded(b);
+
   if (outfile && *outfile)
   {
     out = mutt_file_open(outfile, O_CREAT | O_EXCL | O_WRONLY);
@@ -954,6 +965,8 @@ int mutt_save_attachment(FILE *fp, struct Body *m, const char *path,
 
     /* In send mode, just copy file */
 
+    mutt_body_decode_preencoded(m);
+
     FILE *fp_old = fopen(m->filename, "r");
     if (!fp_old)
     {
@@ -1107,6 +1120,9 @@ int mutt_print_attachment(FILE *fp, struct Body *a)
 
   int rc = 0;
 
+  if (!fp)
+    mutt_body_decode_preencoded(a);
+
   snprintf(type, sizeof(type), "%s/%s", TYPE(a), a->subtype);
 
   if (mailcap_lookup(a, type, sizeof(type), NULL, MUTT_MC_PRINT))
@@ -30,12 +30,15 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 #include "mutt/lib.h"
 #include "email/lib.h"
 #include "mutt_body.h"
 #include "send/lib.h"
+#include "handler.h"
 #include "mutt_attach.h"
 #include "muttlib.h"
+#include "state.h"
 
 /**
  * mutt_body_copy - Create a send-mode duplicate from a receive-mode body
@@ -64,8 +67,37 @@ int mutt_body_copy(FILE *fp, struct Body **tgt, struct Body *src)
     use_disp = false;
   }
 
+  /* A non-text leaf part keeps its Content-Transfer-Encoding when forwarded,
+   * so decoding it to a tempfile only to re-encode the same bytes at send
+   * time is wasted work - twice over for a large base64 attachment.  Copy
+   * the wire form of the part instead and mark it, so that
+   * mutt_write_mime_body() can splice it straight into the outgoing message.
+   * Text parts are excluded: they may be edited or charset-converted. */
+  const bool preencoded = fp &&
+                          ((src->encoding == ENC_BASE64) ||
+                           (src->encoding == ENC_QUOTED_PRINTABLE)) &&
+                          (src->type != TYPE_MESSAGE) && (src->type != TYPE_MULTIPART) &&
+                          !mutt_is_text_part(src);
+
   mutt_adv_mktemp(tmp);
-  if (mutt_save_attachment(fp, src, mutt_b2s(tmp), MUTT_SAVE_NO_FLAGS, NULL) == -1)
+  if (preencoded)
+  {
+    FILE *fp_new = mutt_file_fopen(mutt_b2s(tmp), "w");
+    int rc = -1;
+    if (fp_new)
+    {
+      if (fseeko(fp, src->offset, SEEK_SET) == 0)
+        rc = mutt_file_copy_bytes(fp, fp_new, src->length);
+      if (mutt_file_fsync_close(&fp_new) != 0)
+        rc = -1;
+    }
+    if (rc < 0)
+    {
+      mutt_buffer_pool_release(&tmp);
+      return -1;
+    }
+  }
+  else if (mutt_save_attachment(fp, src, mutt_b2s(tmp), MUTT_SAVE_NO_FLAGS, NULL) == -1)
   {
     mutt_buffer_pool_release(&tmp);
     return -1;
@@ -82,6 +114,7 @@ int mutt_body_copy(FILE *fp, struct Body **tgt, struct Body *src)
   b->filename = mutt_buffer_strdup(tmp);
   b->use_disp = use_disp;
   b->unlink = true;
+  b->preencoded = preencoded;
 
   if (mutt_is_text_part(b))
     b->noconv = true;
@@ -116,3 +149,64 @@ int mutt_body_copy(FILE *fp, struct Body **tgt, struct Body *src)
   mutt_buffer_pool_release(&tmp);
   return 0;
 }
+
+/**
+ * mutt_body_decode_preencoded - Replace a pre-encoded tempfile with its decoded form
+ * @param b Body to decode
+ * @retval  0 Success (or nothing to do)
+ * @retval -1 Failure
+ *
+ * mutt_body_copy() keeps the wire form of a forwarded attachment so that
+ * sending can splice it verbatim.  Anything that needs the actual content -
+ * viewing, piping, editing the part in the compose menu - must call this
+ * first; it decodes the tempfile in place and clears the flag, returning the
+ * Body to an ordinary send-mode part.
+ */
+int mutt_body_decode_preencoded(struct Body *b)
+{
+  if (!b || !b->preencoded)
+    return 0;
+
+  int rc = -1;
+  struct Buffer *tmp = mutt_buffer_pool_get();
+  struct State s = { 0 };
+
+  s.fp_in = fopen(b->filename, "r");
+  if (!s.fp_in)
+    goto cleanup;
+
+  mutt_buffer_strcpy(tmp, b->d_filename ? b->d_filename : b->filename);
+  mutt_adv_mktemp(tmp);
+  s.fp_out = mutt_file_fopen(mutt_b2s(tmp), "w");
+  if (!s.fp_out)
+    goto cleanup;
+
+  /* The encoded bytes start at the top of the tempfile, not at the offset
+   * the part had in its original folder */
+  off_t offset = b->offset;
+  b->offset = 0;
+  mutt_decode_attachment(b, &s);
+  b->offset = offset;
+
+  if (mutt_file_fsync_close(&s.fp_out) != 0)
+    goto cleanup;
+
+  b->length = mutt_file_get_size(mutt_b2s(tmp));
+  if (b->unlink)
+    unlink(b->filename);
+  mutt_str_replace(&b->filename, mutt_b2s(tmp));
+  b->unlink = true;
+  b->preencoded = false;
+  mutt_stamp_attachment(b);
+  rc = 0;
+
+cleanup:
+  mutt_file_fclose(&s.fp_in);
+  if (s.fp_out)
+  {
+    mutt_file_fclose(&s.fp_out);
+    unlink(mutt_b2s(tmp));
+  }
+  mutt_buffer_pool_release(&tmp);
+  return rc;
+}
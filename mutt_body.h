@@ -28,5 +28,6 @@
 struct Body;
 
 int mutt_body_copy(FILE *fp, struct Body **tgt, struct Body *src);
+int mutt_body_decode_preencoded(struct Body *b);
 
 #endif /* MUTT_MUTT_BODY_H */
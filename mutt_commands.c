@@ -29,6 +29,7 @@
 
 #include "config.h"
 #include <stddef.h>
+#include <stdlib.h>
 #include "address/lib.h"
 #include "config/lib.h"
 #include "email/lib.h"
@@ -193,16 +194,21 @@ size_t mutt_commands_array(struct Command **first)
  * @param s Command string to lookup
  * @retval ptr  Success, Command
  * @retval NULL Error, no such command
+ *
+ * The array is kept sorted by commands_register(), so the lookup is a binary
+ * search - the config parser does one lookup per rc line.
  */
 struct Command *mutt_command_get(const char *s)
 {
-  struct Command *cmd = NULL;
-  ARRAY_FOREACH(cmd, &commands)
-  {
-    if (mutt_str_equal(s, cmd->name))
-      return cmd;
-  }
-  return NULL;
+  if (!s)
+    return NULL;
+
+  struct Command *first = ARRAY_FIRST(&commands);
+  if (!first)
+    return NULL;
+
+  const struct Command key = { .name = s };
+  return bsearch(&key, first, ARRAY_SIZE(&commands), sizeof(struct Command), commands_cmp);
 }
 
 #ifdef USE_LUA
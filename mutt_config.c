@@ -39,8 +39,12 @@
 #include "gui/lib.h"
 #include "bcache/lib.h"
 #include "compose/lib.h"
+#ifdef USE_HCACHE_COMPRESSION
+#include "compress/lib.h"
+#endif
 #include "browser.h"
 #include "commands.h"
+#include "copy.h"
 #include "handler.h"
 #include "hdrline.h"
 #include "hook.h"
@@ -49,6 +53,7 @@
 #include "mailcap.h"
 #include "main.h"
 #include "mutt_globals.h"
+#include "mutt_journal.h"
 #include "mutt_logging.h"
 #include "mutt_mailbox.h"
 #include "mutt_menu.h"
@@ -156,6 +161,26 @@ int multipart_validator(const struct ConfigSet *cs, const struct ConfigDef *cdef
   return CSR_ERR_INVALID;
 }
 
+#ifdef USE_HCACHE_COMPRESSION
+/**
+ * bcache_compress_validator - Validate the "message_cache_compress_method" config variable - Implements ConfigDef::validator()
+ */
+int bcache_compress_validator(const struct ConfigSet *cs, const struct ConfigDef *cdef,
+                              intptr_t value, struct Buffer *err)
+{
+  if (value == 0)
+    return CSR_SUCCESS;
+
+  const char *str = (const char *) value;
+
+  if (compress_get_ops(str))
+    return CSR_SUCCESS;
+
+  mutt_buffer_printf(err, _("Invalid value for option %s: %s"), cdef->name, str);
+  return CSR_ERR_INVALID;
+}
+#endif
+
 /**
  * pager_validator - Check for config variables that can't be set from the pager - Implements ConfigDef::validator()
  */
@@ -278,6 +303,11 @@ struct ConfigDef MainVars[] = {
   { "collapse_unread", DT_BOOL, &C_CollapseUnread, true, 0, NULL,
     "Prevent the collapse of threads with unread emails"
   },
+#ifdef USE_COMPRESSED
+  { "compress_cache", DT_BOOL, &C_CompressCache, false, 0, NULL,
+    "Keep the decompressed copy of a compressed mailbox, so reopening an unchanged mailbox skips the decompression"
+  },
+#endif
   { "config_charset", DT_STRING, &C_ConfigCharset, 0, 0, charset_validator,
     "Character set that the config files are in"
   },
@@ -299,6 +329,9 @@ struct ConfigDef MainVars[] = {
   { "date_format", DT_STRING|DT_NOT_EMPTY|R_MENU, &C_DateFormat, IP "!%a, %b %d, %Y at %I:%M:%S%p %Z", 0, NULL,
     "strftime format string for the `%d` expando"
   },
+  { "decode_cache_size", DT_LONG|DT_NOT_NEGATIVE, &C_DecodeCacheSize, 10485760, 0, NULL,
+    "Bytes of decoded message text to keep in memory (0 to disable)"
+  },
   { "debug_file", DT_PATH|DT_PATH_FILE, &C_DebugFile, IP "~/.neomuttdebug", 0, NULL,
     "File to save debug logs"
   },
@@ -329,6 +362,9 @@ struct ConfigDef MainVars[] = {
   { "flag_chars", DT_MBTABLE|R_INDEX|R_PAGER, &C_FlagChars, IP "*!DdrONon- ", 0, NULL,
     "User-configurable index flags: tagged, new, etc"
   },
+  { "flag_journal", DT_BOOL, &C_FlagJournal, false, 0, NULL,
+    "Journal flag changes on mbox folders, recovering them after a crash"
+  },
   { "flag_safe", DT_BOOL, &C_FlagSafe, false, 0, NULL,
     "Protect flagged messages from deletion"
   },
@@ -463,6 +499,14 @@ struct ConfigDef MainVars[] = {
   { "message_cache_clean", DT_BOOL, &C_MessageCacheClean, false, 0, NULL,
     "(imap/pop) Clean out obsolete entries from the message cache"
   },
+#ifdef USE_HCACHE_COMPRESSION
+  { "message_cache_compress_level", DT_NUMBER|DT_NOT_NEGATIVE, &C_MessageCacheCompressLevel, 1, 0, NULL,
+    "(imap/pop) Level of compression for the message cache"
+  },
+  { "message_cache_compress_method", DT_STRING, &C_MessageCacheCompressMethod, 0, 0, bcache_compress_validator,
+    "(imap/pop) Compress new message cache entries with this method"
+  },
+#endif
   { "message_cachedir", DT_PATH|DT_PATH_DIR, &C_MessageCachedir, 0, 0, NULL,
     "(imap/pop) Directory for the message cache"
   },
@@ -711,6 +755,9 @@ struct ConfigDef MainVars[] = {
   { "to_chars", DT_MBTABLE|R_INDEX|R_PAGER, &C_ToChars, IP " +TCFLR", 0, NULL,
     "Indicator characters for the 'To' field in the index"
   },
+  { "trace_spans", DT_BOOL, &C_TraceSpans, false, 0, NULL,
+    "Record timings of slow operations for the trace-report command"
+  },
   { "trash", DT_STRING|DT_MAILBOX, &C_Trash, 0, 0, NULL,
     "Folder to put deleted emails"
   },
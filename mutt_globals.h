@@ -138,6 +138,7 @@ WHERE bool C_AutoTag;                        ///< Config: Automatically apply ac
 WHERE bool C_Beep;                           ///< Config: Make a noise when an error occurs
 WHERE bool C_BeepNew;                        ///< Config: Make a noise when new mail arrives
 WHERE bool C_BrailleFriendly;                ///< Config: Move the cursor to the beginning of the line
+WHERE bool C_CompressCache;                  ///< Config: Keep the decompressed copy of a compressed mailbox for fast reopening
 WHERE bool C_Confirmappend;                  ///< Config: Confirm before appending emails to a mailbox
 WHERE bool C_Confirmcreate;                  ///< Config: Confirm before creating a new mailbox
 WHERE bool C_CopyDecodeWeed;                 ///< Config: Controls whether to weed headers when copying or saving emails
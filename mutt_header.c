@@ -31,6 +31,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <time.h>
 #include "mutt/lib.h"
@@ -153,6 +154,8 @@ int mutt_label_message(struct Mailbox *m, struct EmailList *el)
       mutt_set_header_color(m, en->email);
     }
   }
+  if (changed)
+    IndexLineGen++; /* %y/%Y render the labels */
 
   return changed;
 }
@@ -225,7 +228,6 @@ void mutt_edit_headers(const char *editor, const char *body, struct Email *e,
     goto cleanup;
   }
 
-  mutt_file_unlink(body);
   mutt_list_free(&e->env->userhdrs);
 
   /* Read the temp file back in */
@@ -236,19 +238,62 @@ void mutt_edit_headers(const char *editor, const char *body, struct Email *e,
     goto cleanup;
   }
 
-  fp_out = mutt_file_fopen(body, "w");
-  if (!fp_out)
+  n = mutt_rfc822_read_header(fp_in, NULL, true, false);
+
+  /* With $edit_headers, the common edit is a small header tweak.  If the
+   * body bytes are identical to the draft file, skip rewriting it. */
+  const off_t body_off = ftello(fp_in);
+  bool body_same = false;
+  struct stat st_body;
+  if ((body_off >= 0) && (stat(body, &st_body) == 0) &&
+      (st_body.st_size == (st.st_size - body_off)))
   {
-    /* intentionally leak a possible temporary file here */
-    mutt_file_fclose(&fp_in);
-    mutt_perror(body);
-    goto cleanup;
+    FILE *fp_body = fopen(body, "r");
+    if (fp_body)
+    {
+      char buf2[1024];
+      body_same = true;
+      while ((i = fread(buf, 1, sizeof(buf), fp_in)) > 0)
+      {
+        if (((int) fread(buf2, 1, i, fp_body) != i) || (memcmp(buf, buf2, i) != 0))
+        {
+          body_same = false;
+          break;
+        }
+      }
+      mutt_file_fclose(&fp_body);
+    }
+  }
+
+  if (body_same)
+  {
+    mutt_debug(LL_DEBUG1, "message body was not modified\n");
+  }
+  else
+  {
+    if ((body_off < 0) || (fseeko(fp_in, body_off, SEEK_SET) != 0))
+    {
+      mutt_file_fclose(&fp_in);
+      mutt_env_free(&n);
+      mutt_perror(mutt_b2s(path));
+      goto cleanup;
+    }
+
+    mutt_file_unlink(body);
+    fp_out = mutt_file_fopen(body, "w");
+    if (!fp_out)
+    {
+      /* intentionally leak a possible temporary file here */
+      mutt_file_fclose(&fp_in);
+      mutt_env_free(&n);
+      mutt_perror(body);
+      goto cleanup;
+    }
+
+    mutt_file_copy_stream(fp_in, fp_out);
+    mutt_file_fclose(&fp_out);
   }
 
-  n = mutt_rfc822_read_header(fp_in, NULL, true, false);
-  while ((i = fread(buf, 1, sizeof(buf), fp_in)) > 0)
-    fwrite(buf, 1, i, fp_out);
-  mutt_file_fclose(&fp_out);
   mutt_file_fclose(&fp_in);
   mutt_file_unlink(mutt_b2s(path));
 
@@ -256,6 +301,8 @@ void mutt_edit_headers(const char *editor, const char *body, struct Email *e,
    * $edit_headers set, we remove References: as they're likely invalid;
    * we can simply compare strings as we don't generate References for
    * multiple Message-Ids in IRT anyways */
+  mutt_env_parse_threads(e->env);
+  mutt_env_parse_threads(n);
 #ifdef USE_NNTP
   if (!OptNewsSend)
 #endif
@@ -265,12 +312,12 @@ void mutt_edit_headers(const char *editor, const char *body, struct Email *e,
          !mutt_str_equal(STAILQ_FIRST(&n->in_reply_to)->data,
                          STAILQ_FIRST(&e->env->in_reply_to)->data)))
     {
-      mutt_list_free(&e->env->references);
+      mutt_intern_list_free(&e->env->references);
     }
   }
 
   /* restore old info. */
-  mutt_list_free(&n->references);
+  mutt_intern_list_free(&n->references);
   STAILQ_SWAP(&n->references, &e->env->references, ListNode);
 
   mutt_env_free(&e->env);
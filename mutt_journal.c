@@ -0,0 +1,316 @@
+/**
+ * @file
+ * Crash-safe journal of flag-change intents
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page neo_mutt_journal Crash-safe journal of flag-change intents
+ *
+ * Syncing an mbox is all-or-nothing: flag changes live only in memory until
+ * the whole file is rewritten, so a crash loses everything since the mailbox
+ * was opened.  When `$flag_journal` is set, every flag change on an mbox/mmdf
+ * mailbox is also appended to a sidecar file, `<mailbox>.neomutt-journal`, as
+ * it happens.  If the session ends without a sync, the journal is replayed
+ * the next time the mailbox is opened, so the changes survive.
+ *
+ * The journal records the mailbox's size and mtime when it is created; if the
+ * file on disk no longer matches - it was synced, or another program
+ * delivered into it - the journal is stale and is silently discarded, since
+ * the message offsets it refers to are meaningless.  A successful sync or a
+ * normal close removes the journal: it protects against crashes, not against
+ * the user deciding to discard their changes.
+ */
+
+#include "config.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "mutt_journal.h"
+#include "mutt.h"
+
+/* These Config Variables are only used in mutt_journal.c */
+bool C_FlagJournal; ///< Config: Journal flag changes on mbox folders for crash recovery
+
+/**
+ * journal_path - Build the journal file name for a mailbox
+ * @param m    Mailbox
+ * @param path Buffer for the result
+ */
+static void journal_path(struct Mailbox *m, struct Buffer *path)
+{
+  mutt_buffer_printf(path, "%s.neomutt-journal", mailbox_path(m));
+}
+
+/**
+ * journal_flag_char - Map a flag to its journal tag
+ * @param flag Flag, e.g. #MUTT_DELETE
+ * @retval ch  Tag character
+ * @retval 0   Flag isn't journalled
+ *
+ * Only flags that end up in the mailbox are recorded; MUTT_TAG is view-only
+ * state and MUTT_PURGE merely modifies how a journalled deletion is applied.
+ */
+static char journal_flag_char(int flag)
+{
+  switch (flag)
+  {
+    case MUTT_DELETE:
+      return 'D';
+    case MUTT_FLAG:
+      return 'F';
+    case MUTT_NEW:
+      return 'N';
+    case MUTT_OLD:
+      return 'O';
+    case MUTT_READ:
+      return 'R';
+    case MUTT_REPLIED:
+      return 'r';
+    default:
+      return 0;
+  }
+}
+
+/**
+ * journal_wanted - Does this mailbox get a journal?
+ * @param m Mailbox
+ * @retval true The journal applies
+ */
+static bool journal_wanted(struct Mailbox *m)
+{
+  return C_FlagJournal && m && !m->readonly && !m->peekonly &&
+         ((m->type == MUTT_MBOX) || (m->type == MUTT_MMDF));
+}
+
+/**
+ * email_by_offset - Find an Email by its offset in the mailbox file
+ * @param m      Mailbox
+ * @param offset Offset of the message
+ * @retval ptr Matching Email
+ * @retval NULL No message starts at that offset
+ *
+ * A freshly parsed mbox has its emails in file order, so binary search.
+ */
+static struct Email *email_by_offset(struct Mailbox *m, LOFF_T offset)
+{
+  int lo = 0;
+  int hi = m->msg_count - 1;
+
+  while (lo <= hi)
+  {
+    int mid = lo + (hi - lo) / 2;
+    if (m->emails[mid]->offset < offset)
+      lo = mid + 1;
+    else if (m->emails[mid]->offset > offset)
+      hi = mid - 1;
+    else
+      return m->emails[mid];
+  }
+  return NULL;
+}
+
+/**
+ * mutt_journal_log - Record a flag change in the mailbox's journal
+ * @param m    Mailbox
+ * @param e    Email that changed
+ * @param flag Flag that changed, e.g. #MUTT_DELETE
+ * @param bf   true: flag was set; false: flag was cleared
+ *
+ * Failures are silent - the journal is a safety net, not a requirement.
+ */
+void mutt_journal_log(struct Mailbox *m, struct Email *e, int flag, bool bf)
+{
+  if (!journal_wanted(m) || !e)
+    return;
+
+  const char fc = journal_flag_char(flag);
+  if (fc == 0)
+    return;
+
+  if (!m->journal_fp)
+  {
+    struct Buffer *path = mutt_buffer_pool_get();
+    journal_path(m, path);
+    m->journal_fp = mutt_file_fopen(mutt_b2s(path), "a");
+    mutt_buffer_pool_release(&path);
+    if (!m->journal_fp)
+      return; /* e.g. unwritable directory - run without the safety net */
+
+    if (ftello(m->journal_fp) == 0)
+    {
+      /* new journal - record which mailbox image the offsets refer to */
+      struct stat st;
+      if (stat(mailbox_path(m), &st) != 0)
+      {
+        mutt_file_fclose(&m->journal_fp);
+        return;
+      }
+      fprintf(m->journal_fp, "NeoMutt-Journal 1 %lld %lld\n",
+              (long long) st.st_size, (long long) st.st_mtime);
+    }
+  }
+
+  fprintf(m->journal_fp, "%c " OFF_T_FMT " %d\n", fc, (LOFF_T) e->offset, bf);
+  /* one flush per change: the intent survives a crash of this process.  An
+   * fsync per keystroke would cost more than the sync we're insuring. */
+  fflush(m->journal_fp);
+}
+
+/**
+ * mutt_journal_replay - Apply a leftover journal to a freshly opened mailbox
+ * @param m Mailbox, parsed but not yet counted
+ *
+ * Called at the end of the backend's mbox_open, before the flag counters are
+ * tallied, so the replayed flags are counted like any others.  The journal is
+ * kept until the next sync or close - replaying it again after another crash
+ * gives the same result.
+ */
+void mutt_journal_replay(struct Mailbox *m)
+{
+  if (!journal_wanted(m))
+    return;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  journal_path(m, path);
+  FILE *fp = fopen(mutt_b2s(path), "r");
+  if (!fp)
+  {
+    mutt_buffer_pool_release(&path);
+    return;
+  }
+
+  bool valid = false;
+  char line[256];
+  if (fgets(line, sizeof(line), fp))
+  {
+    long long size = -1;
+    long long mtime = -1;
+    struct stat st;
+    if ((sscanf(line, "NeoMutt-Journal 1 %lld %lld", &size, &mtime) == 2) &&
+        (stat(mailbox_path(m), &st) == 0) && ((long long) st.st_size == size) &&
+        ((long long) st.st_mtime == mtime))
+    {
+      valid = true;
+    }
+  }
+
+  int applied = 0;
+  bool flags_changed = false;
+  while (valid && fgets(line, sizeof(line), fp))
+  {
+    char fc = 0;
+    long long offset = -1;
+    int bf = 0;
+    if (sscanf(line, "%c %lld %d", &fc, &offset, &bf) != 3)
+      continue; /* torn final line from a crash mid-write */
+
+    struct Email *e = email_by_offset(m, offset);
+    if (!e)
+      continue;
+
+    switch (fc)
+    {
+      case 'D':
+        /* like the interactive path, a deletion doesn't mark the message
+         * changed, but it will make the close prompt appear */
+        e->deleted = bf;
+        break;
+      case 'F':
+        e->flagged = bf;
+        e->changed = true;
+        flags_changed = true;
+        break;
+      case 'N':
+        e->old = !bf && e->old;
+        e->read = !bf;
+        e->changed = true;
+        flags_changed = true;
+        break;
+      case 'O':
+        e->old = bf;
+        e->changed = true;
+        flags_changed = true;
+        break;
+      case 'R':
+        e->read = bf;
+        e->changed = true;
+        flags_changed = true;
+        break;
+      case 'r':
+        e->replied = bf;
+        if (bf)
+          e->read = true;
+        e->changed = true;
+        flags_changed = true;
+        break;
+      default:
+        continue;
+    }
+    applied++;
+  }
+  fclose(fp);
+
+  if (!valid)
+  {
+    /* the mailbox was rewritten behind our back - the offsets mean nothing */
+    unlink(mutt_b2s(path));
+  }
+  else if (applied > 0)
+  {
+    if (flags_changed)
+      m->changed = true;
+    mutt_message(ngettext("Recovered %d flag change from journal",
+                          "Recovered %d flag changes from journal", applied),
+                 applied);
+  }
+  mutt_buffer_pool_release(&path);
+}
+
+/**
+ * mutt_journal_clear - Remove a mailbox's journal
+ * @param m Mailbox
+ *
+ * Called after a successful sync and on normal close - in both cases the
+ * in-memory state is either on disk or deliberately discarded, so the
+ * recorded intents no longer apply.
+ */
+void mutt_journal_clear(struct Mailbox *m)
+{
+  if (!m)
+    return;
+
+  mutt_file_fclose(&m->journal_fp);
+
+  if (!C_FlagJournal || m->peekonly ||
+      ((m->type != MUTT_MBOX) && (m->type != MUTT_MMDF)))
+  {
+    return;
+  }
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  journal_path(m, path);
+  unlink(mutt_b2s(path));
+  mutt_buffer_pool_release(&path);
+}
@@ -0,0 +1,38 @@
+/**
+ * @file
+ * Crash-safe journal of flag-change intents
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_MUTT_JOURNAL_H
+#define MUTT_MUTT_JOURNAL_H
+
+#include <stdbool.h>
+
+struct Email;
+struct Mailbox;
+
+/* These Config Variables are only used in mutt_journal.c */
+extern bool C_FlagJournal;
+
+void mutt_journal_clear (struct Mailbox *m);
+void mutt_journal_log   (struct Mailbox *m, struct Email *e, int flag, bool bf);
+void mutt_journal_replay(struct Mailbox *m);
+
+#endif /* MUTT_MUTT_JOURNAL_H */
@@ -268,6 +268,11 @@ int mutt_log_set_level(enum LogLevel level, bool verbose)
   if (log_file_set_level(level, verbose) != 0)
     return -1;
 
+  /* Lower the inline mutt_debug() ceiling to match, but not while the
+   * startup queue is capturing lines for a level that isn't final yet */
+  if (MuttLogger == log_disp_curses)
+    MuttLogCeiling = level;
+
   cs_subset_str_native_set(NeoMutt->sub, "debug_level", level, NULL);
   return 0;
 }
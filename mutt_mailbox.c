@@ -26,6 +26,7 @@
  */
 
 #include "config.h"
+#include <limits.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/time.h>
@@ -36,6 +37,9 @@
 #include "gui/lib.h"
 #include "mutt_mailbox.h"
 #include "mbox/lib.h"
+#ifdef USE_IMAP
+#include "imap/lib.h"
+#endif
 #include "mutt_globals.h"
 #include "mutt_menu.h"
 #include "muttlib.h"
@@ -52,18 +56,60 @@ short C_MailCheck; ///< Config: Number of seconds before NeoMutt checks for new
 bool C_MailCheckStats;          ///< Config: Periodically check for new mail
 short C_MailCheckStatsInterval; ///< Config: How often to check for new mail
 
+/// Back off from a mailbox whose check took at least this long (seconds)
+static const time_t MailboxSlowSecs = 2;
+/// How many times the check duration to wait before polling a slow mailbox again
+static const time_t MailboxBackoff = 10;
+/// Budget for first-time statistics scans: a burst of 10, refilled at 2/second
+static struct TokenBucket MailboxFirstStatsBudget;
+
+/**
+ * mailbox_check_backoff - Note how long a mailbox took to check
+ * @param m     Mailbox that was checked
+ * @param start Time the check started
+ *
+ * A mailbox on a wedged IMAP server or stale NFS mount can take many seconds
+ * to answer, and the whole poll loop (and the UI behind it) stalls on it.
+ * When a check was slow, put the mailbox on a proportionally longer polling
+ * interval so one bad server doesn't freeze every cycle.
+ */
+static void mailbox_check_backoff(struct Mailbox *m, time_t start)
+{
+  const time_t elapsed = mutt_date_epoch() - start;
+  if (elapsed >= MailboxSlowSecs)
+  {
+    m->next_slow_check = start + (elapsed * MailboxBackoff);
+    mutt_debug(LL_DEBUG1, "mailbox %s took %llds to check, backing off\n",
+               mailbox_path(m), (long long) elapsed);
+  }
+  else
+    m->next_slow_check = 0;
+}
+
 /**
  * mailbox_check - Check a mailbox for new mail
  * @param m_cur       Current Mailbox
  * @param m_check     Mailbox to check
  * @param ctx_sb      stat() info for the current Mailbox
  * @param check_stats If true, also count the total, new and flagged messages
+ * @param force       If true, check even a mailbox that's backing off
  */
 static void mailbox_check(struct Mailbox *m_cur, struct Mailbox *m_check,
-                          struct stat *ctx_sb, bool check_stats)
+                          struct stat *ctx_sb, bool check_stats, bool force)
 {
   struct stat sb = { 0 };
 
+  /* Probing and polling can block on a dead server or mount, so honour the
+   * backoff before touching the mailbox at all.  The previous counts stay
+   * visible until it's polled again.  */
+  const time_t start = mutt_date_epoch();
+  if (!force && (start < m_check->next_slow_check))
+  {
+    if (m_check->has_new && (m_check->msg_new > 0))
+      MailboxCount++;
+    return;
+  }
+
   enum MailboxType mb_type = mx_path_probe(mailbox_path(m_check));
 
   if ((m_cur == m_check) && C_MailCheckRecent)
@@ -88,6 +134,7 @@ static void mailbox_check(struct Mailbox *m_cur, struct Mailbox *m_check,
         m_check->newly_created = true;
         m_check->type = MUTT_UNKNOWN;
         m_check->size = 0;
+        mailbox_check_backoff(m_check, start);
         return;
       }
       break; // kept for consistency.
@@ -121,6 +168,8 @@ static void mailbox_check(struct Mailbox *m_cur, struct Mailbox *m_check,
     m_check->notified = false;
   else if (!m_check->notified)
     MailboxNotify++;
+
+  mailbox_check_backoff(m_check, start);
 }
 
 /**
@@ -179,6 +228,15 @@ int mutt_mailbox_check(struct Mailbox *m_cur, int force)
     contex_sb.st_ino = 0;
   }
 
+  /* A mailbox's first statistics check scans it in full, and doing that for
+   * a long `mailboxes` list (80 maildirs on NFS, say) before the UI settles
+   * takes seconds.  Unless the user explicitly asked for statistics, pay for
+   * the first-time scans from a token bucket, spreading them over several
+   * check passes; the sidebar picks up each batch of results as it arrives. */
+  const bool stats_forced = (force & MUTT_MAILBOX_CHECK_FORCE_STATS);
+  if (MailboxFirstStatsBudget.burst == 0)
+    mutt_throttle_init(&MailboxFirstStatsBudget, 2, 10);
+
   struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
   neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
   struct MailboxNode *np = NULL;
@@ -187,12 +245,27 @@ int mutt_mailbox_check(struct Mailbox *m_cur, int force)
     if (np->mailbox->flags & MB_HIDDEN)
       continue;
 
-    mailbox_check(m_cur, np->mailbox, &contex_sb,
-                  check_stats || (!np->mailbox->first_check_stats_done && C_MailCheckStats));
-    np->mailbox->first_check_stats_done = true;
+    bool stats = check_stats || (!np->mailbox->first_check_stats_done && C_MailCheckStats);
+    if (stats && !np->mailbox->first_check_stats_done && !stats_forced &&
+        !mutt_throttle_take(&MailboxFirstStatsBudget, 1))
+    {
+      stats = false; // postpone this mailbox's first scan to a later pass
+    }
+
+    mailbox_check(m_cur, np->mailbox, &contex_sb, stats, (force != 0));
+    if (stats)
+      np->mailbox->first_check_stats_done = true;
   }
   neomutt_mailboxlist_clear(&ml);
 
+#ifdef USE_IMAP
+  /* The loop above only queues STATUS commands on non-selected IMAP
+   * connections.  Send them all now and collect whatever replies are already
+   * in, so every server answers in parallel rather than one blocking round
+   * trip per account. */
+  imap_sweep_connections();
+#endif
+
   return MailboxCount;
 }
 
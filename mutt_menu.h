@@ -45,6 +45,8 @@ typedef uint16_t MuttRedrawFlags;      ///< Flags, e.g. #REDRAW_INDEX
 #define REDRAW_FULL           (1 << 5) ///< Redraw everything
 #define REDRAW_BODY           (1 << 6) ///< Redraw the pager
 #define REDRAW_FLOW           (1 << 7) ///< Used by pager to reflow text
+#define REDRAW_ROWS           (1 << 8) ///< Redraw only the dirty rows of the menu
+#define REDRAW_SCROLL         (1 << 9) ///< The page scrolled but its content didn't change
 
 /**
  * struct Menu - GUI selectable list of items
@@ -73,9 +75,11 @@ struct Menu
 
   /* the following are used only by mutt_menu_loop() */
   int top;                ///< Entry that is the top of the current page
+  int last_top;           ///< Menu::top when the page was last painted
   int oldcurrent;         ///< For driver use only
   int search_dir;         ///< Direction of search
   int tagged;             ///< Number of tagged entries
+  ARRAY_HEAD(,int) dirty_rows; ///< Rows to repaint (#REDRAW_ROWS)
   bool custom_search : 1; ///< The menu implements its own non-Menu::search()-compatible search, trickle OP_SEARCH*
 
   /**
@@ -141,6 +145,7 @@ void         menu_redraw_current(struct Menu *menu);
 void         menu_redraw_full(struct Menu *menu);
 void         menu_redraw_index(struct Menu *menu);
 void         menu_redraw_motion(struct Menu *menu);
+void         menu_redraw_rows(struct Menu *menu);
 void         menu_redraw_status(struct Menu *menu);
 int          menu_redraw(struct Menu *menu);
 void         menu_top_page(struct Menu *menu);
@@ -151,6 +156,7 @@ void         mutt_menu_init(void);
 int          mutt_menu_loop(struct Menu *menu);
 struct Menu *mutt_menu_new(enum MenuType type);
 void         mutt_menu_pop_current(struct Menu *menu);
+void         mutt_menu_queue_row_redraw(struct Menu *menu, int row);
 void         mutt_menu_push_current(struct Menu *menu);
 void         mutt_menu_set_current_redraw_full(void);
 void         mutt_menu_set_current_redraw(MuttRedrawFlags redraw);
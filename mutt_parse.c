@@ -219,11 +219,17 @@ int mutt_count_body_parts(struct Mailbox *m, struct Email *e)
       !STAILQ_EMPTY(&InlineAllow) || !STAILQ_EMPTY(&InlineExclude))
   {
     e->attach_total = count_body_parts(e->body);
+    e->attach_valid = true;
+
+    /* opening the message was the expensive part; push the count into the
+     * header cache so the next visit to this folder doesn't repeat it */
+    mx_save_hcache(m, e);
   }
   else
+  {
     e->attach_total = 0;
-
-  e->attach_valid = true;
+    e->attach_valid = true;
+  }
 
   if (!keep_parts)
     mutt_body_free(&e->body->parts);
@@ -231,6 +237,54 @@ int mutt_count_body_parts(struct Mailbox *m, struct Email *e)
   return e->attach_total;
 }
 
+/**
+ * mutt_attach_check_hash - Hash the `attachments` command's rules
+ * @retval num 32-bit hash of the rules (never 0)
+ * @retval 0   Attachment counts must not be cached
+ *
+ * The header cache keeps Email::attach_total so that `$index_format`'s %X
+ * doesn't have to reopen every message on the next visit to a folder.  A
+ * cached count is only valid for the rules that produced it, so the cache is
+ * tagged with this hash.  Returns 0, meaning "never cache", when no rules are
+ * configured - counting is free then and there is nothing worth keeping.
+ */
+uint32_t mutt_attach_check_hash(void)
+{
+  if (STAILQ_EMPTY(&AttachAllow) && STAILQ_EMPTY(&AttachExclude) &&
+      STAILQ_EMPTY(&InlineAllow) && STAILQ_EMPTY(&InlineExclude))
+  {
+    return 0;
+  }
+
+  union
+  {
+    unsigned char charval[16];
+    uint32_t intval;
+  } digest;
+  struct Md5Ctx md5ctx;
+  struct ListHead *lists[] = { &AttachAllow, &AttachExclude, &InlineAllow, &InlineExclude };
+
+  mutt_md5_init_ctx(&md5ctx);
+  for (size_t i = 0; i < mutt_array_size(lists); i++)
+  {
+    /* a tag byte, so moving a rule between lists changes the hash */
+    const char tag = 'A' + i;
+    mutt_md5_process_bytes(&tag, sizeof(tag), &md5ctx);
+
+    struct ListNode *np = NULL;
+    STAILQ_FOREACH(np, lists[i], entries)
+    {
+      const struct AttachMatch *a = (struct AttachMatch *) np->data;
+      mutt_md5_process(a->major, &md5ctx);
+      mutt_md5_process(a->minor, &md5ctx);
+    }
+  }
+  mutt_md5_finish_ctx(&md5ctx, digest.charval);
+
+  /* 0 is reserved for "don't cache" */
+  return (digest.intval == 0) ? 1 : digest.intval;
+}
+
 /**
  * mutt_attachmatch_free - Free an AttachMatch - Implements ::list_free_t
  * @param ptr AttachMatch to free
@@ -44,6 +44,7 @@ extern struct ListHead AttachExclude;
 extern struct ListHead InlineAllow;
 extern struct ListHead InlineExclude;
 
+uint32_t mutt_attach_check_hash(void);
 int  mutt_count_body_parts(struct Mailbox *m, struct Email *e);
 void mutt_parse_mime_message(struct Mailbox *m, struct Email *e);
 void mutt_attachmatch_free(struct AttachMatch **ptr);
@@ -37,9 +37,13 @@
 #include "email/lib.h"
 #include "core/lib.h"
 #include "mutt_thread.h"
+#include "index.h"
 #include "mx.h"
 #include "protos.h"
 #include "sort.h"
+#ifdef USE_HCACHE
+#include "hcache/threads.h"
+#endif
 
 /* These Config Variables are only used in mutt_thread.c */
 bool C_CollapseFlagged; ///< Config: Prevent the collapse of threads with flagged emails
@@ -55,16 +59,71 @@ bool C_SortRe;     ///< Config: Sort method for the sidebar
 bool C_StrictThreads; ///< Config: Thread messages using 'In-Reply-To' and 'References' headers
 bool C_ThreadReceived; ///< Config: Sort threaded messages by their received date
 
+int ThreadAggGen = 1; ///< Generation of the cached MuttThread subtree counters
+
+#define THREAD_BLOCK_NODES 1024 ///< MuttThreads allocated per arena block
+
+/**
+ * struct ThreadBlock - A slab of MuttThread nodes
+ *
+ * Thread nodes are carved out of these blocks in creation order instead of
+ * being malloc'd one by one: a large tree means hundreds of thousands of
+ * tiny heap objects, and the traversals in this file visit them in roughly
+ * the order mutt_sort_threads() created them, so keeping neighbours on the
+ * same cache lines pays off.
+ */
+struct ThreadBlock
+{
+  struct ThreadBlock *next;                    ///< Previous (full) block
+  size_t used;                                 ///< Nodes handed out so far
+  struct MuttThread nodes[THREAD_BLOCK_NODES]; ///< The nodes themselves
+};
+
 /**
  * struct ThreadsContext - The "current" threading state
  */
 struct ThreadsContext
 {
-  struct Mailbox *mailbox; ///< Current mailbox
-  struct MuttThread *tree; ///< Top of thread tree
-  struct HashTable *hash;  ///< Hash table for threads
+  struct Mailbox *mailbox;    ///< Current mailbox
+  struct MuttThread *tree;    ///< Top of thread tree
+  struct HashTable *hash;     ///< Hash table for threads
+  struct ThreadBlock *blocks; ///< Arena the MuttThread nodes live in
 };
 
+/**
+ * thread_alloc - Allocate a MuttThread from the context's arena
+ * @param tctx Threading context
+ * @retval ptr New, zeroed MuttThread
+ *
+ * The node lives until mutt_clear_threads() or mutt_thread_ctx_free()
+ * releases the whole arena - individual nodes are never freed.
+ */
+static struct MuttThread *thread_alloc(struct ThreadsContext *tctx)
+{
+  struct ThreadBlock *blk = tctx->blocks;
+  if (!blk || (blk->used == THREAD_BLOCK_NODES))
+  {
+    blk = mutt_mem_calloc(1, sizeof(struct ThreadBlock));
+    blk->next = tctx->blocks;
+    tctx->blocks = blk;
+  }
+  return &blk->nodes[blk->used++];
+}
+
+/**
+ * thread_arena_free - Release every MuttThread in one sweep
+ * @param tctx Threading context
+ */
+static void thread_arena_free(struct ThreadsContext *tctx)
+{
+  while (tctx->blocks)
+  {
+    struct ThreadBlock *next = tctx->blocks->next;
+    FREE(&tctx->blocks);
+    tctx->blocks = next;
+  }
+}
+
 /**
  * is_visible - Is the message visible?
  * @param e   Email
@@ -172,15 +231,19 @@ static void linearize_tree(struct ThreadsContext *tctx)
  * this calculates whether a node is the root of a subtree that has visible
  * nodes, whether a node itself is visible, whether, if invisible, it has
  * depth anyway, and whether any of its later siblings are roots of visible
- * subtrees.  while it's at it, it frees the old thread display, so we can
- * skip parts of the tree in mutt_draw_tree() if we've decided here that we
- * don't care about them any more.
+ * subtrees.
+ *
+ * The old thread display strings are deliberately left in place -
+ * mutt_draw_tree() reuses them when the regenerated string is unchanged,
+ * which is the common case on a re-sort.
  */
 static void calculate_visibility(struct MuttThread *tree, int *max_depth)
 {
   if (!tree)
     return;
 
+  ThreadAggGen++; /* visibility feeds the cached subtree counters */
+
   struct MuttThread *tmp = NULL;
   struct MuttThread *orig_tree = tree;
   int hide_top_missing = C_HideTopMissing && !C_HideMissing;
@@ -200,7 +263,6 @@ static void calculate_visibility(struct MuttThread *tree, int *max_depth)
     tree->subtree_visible = 0;
     if (tree->message)
     {
-      FREE(&tree->message->tree);
       if (is_visible(tree->message))
       {
         tree->deep = true;
@@ -302,6 +364,7 @@ void mutt_thread_ctx_free(struct ThreadsContext **tctx)
 {
   (*tctx)->mailbox = NULL;
   mutt_hash_free(&(*tctx)->hash);
+  thread_arena_free(*tctx);
   FREE(tctx);
 }
 
@@ -319,7 +382,7 @@ void mutt_thread_ctx_free(struct ThreadsContext **tctx)
  */
 void mutt_draw_tree(struct ThreadsContext *tctx)
 {
-  char *pfx = NULL, *mypfx = NULL, *arrow = NULL, *myarrow = NULL, *new_tree = NULL;
+  char *pfx = NULL, *mypfx = NULL, *arrow = NULL, *myarrow = NULL, *scratch = NULL;
   enum TreeChar corner = (C_Sort & SORT_REVERSE) ? MUTT_TREE_ULCORNER : MUTT_TREE_LLCORNER;
   enum TreeChar vtee = (C_Sort & SORT_REVERSE) ? MUTT_TREE_BTEE : MUTT_TREE_TTEE;
   int depth = 0, start_depth = 0, max_depth = 0, width = C_NarrowTree ? 1 : 2;
@@ -327,11 +390,14 @@ void mutt_draw_tree(struct ThreadsContext *tctx)
 
   struct MuttThread *tree = tctx->tree;
 
+  IndexLineGen++; /* the tree glyphs rendered into the index lines change */
+
   /* Do the visibility calculations and free the old thread chars.
    * From now on we can simply ignore invisible subtrees */
   calculate_visibility(tree, &max_depth);
   pfx = mutt_mem_malloc((width * max_depth) + 2);
   arrow = mutt_mem_malloc((width * max_depth) + 2);
+  scratch = mutt_mem_malloc((width * max_depth) + 2);
   while (tree)
   {
     if (depth != 0)
@@ -354,18 +420,26 @@ void mutt_draw_tree(struct ThreadsContext *tctx)
       {
         myarrow[width] = MUTT_TREE_RARROW;
         myarrow[width + 1] = 0;
-        new_tree = mutt_mem_malloc(((size_t) depth * width) + 2);
         if (start_depth > 1)
         {
-          strncpy(new_tree, pfx, (size_t) width * (start_depth - 1));
-          mutt_str_copy(new_tree + (start_depth - 1) * width, arrow,
+          strncpy(scratch, pfx, (size_t) width * (start_depth - 1));
+          mutt_str_copy(scratch + (start_depth - 1) * width, arrow,
                         (1 + depth - start_depth) * width + 2);
         }
         else
-          mutt_str_copy(new_tree, arrow, ((size_t) depth * width) + 2);
-        tree->message->tree = new_tree;
+          mutt_str_copy(scratch, arrow, ((size_t) depth * width) + 2);
+        /* usually unchanged from the last (re)sort - keep the old allocation
+         * rather than churning through free()+malloc() for every message */
+        if (!mutt_str_equal(tree->message->tree, scratch))
+          mutt_str_replace(&tree->message->tree, scratch);
       }
     }
+    else if (tree->visible)
+    {
+      /* thread roots carry no arrows - clear any leftover string from a
+       * previous position deeper in a thread */
+      FREE(&tree->message->tree);
+    }
     if (tree->child && (depth != 0))
     {
       mypfx = pfx + (depth - 1) * width;
@@ -429,6 +503,7 @@ void mutt_draw_tree(struct ThreadsContext *tctx)
 
   FREE(&pfx);
   FREE(&arrow);
+  FREE(&scratch);
 }
 
 /**
@@ -600,8 +675,10 @@ static void pseudo_threads(struct ThreadsContext *tctx)
          * but only do this if they have the same real subject as the
          * parent, since otherwise they rightly belong to the message
          * we're attaching. */
-        if ((tmp == cur) || mutt_str_equal(tmp->message->env->real_subj,
-                                           parent->message->env->real_subj))
+        if ((tmp == cur) ||
+            ((mutt_env_real_subj_hash(tmp->message->env) ==
+              mutt_env_real_subj_hash(parent->message->env)) &&
+             mutt_str_equal(tmp->message->env->real_subj, parent->message->env->real_subj)))
         {
           tmp->message->subject_changed = false;
 
@@ -651,6 +728,7 @@ void mutt_clear_threads(struct ThreadsContext *tctx)
   }
   tctx->tree = NULL;
   mutt_hash_free(&tctx->hash);
+  thread_arena_free(tctx);
 }
 
 /**
@@ -853,7 +931,11 @@ static void check_subjects(struct Mailbox *m, bool init)
       e->subject_changed = true;
     else if (e->env->real_subj && tmp->message->env->real_subj)
     {
-      e->subject_changed = !mutt_str_equal(e->env->real_subj, tmp->message->env->real_subj);
+      /* cached hashes answer the common "different subject" case without
+       * touching the strings */
+      e->subject_changed =
+          (mutt_env_real_subj_hash(e->env) != mutt_env_real_subj_hash(tmp->message->env)) ||
+          !mutt_str_equal(e->env->real_subj, tmp->message->env->real_subj);
     }
     else
     {
@@ -872,6 +954,7 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
   if (!tctx || !tctx->mailbox)
     return;
 
+  const int span = mutt_trace_start("mutt_sort_threads");
   struct Mailbox *m = tctx->mailbox;
 
   struct Email *e = NULL;
@@ -890,8 +973,30 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
 
   if (init)
   {
+    /* no destructor: the nodes belong to the arena, not the hash */
     tctx->hash = mutt_hash_new(m->msg_count * 2, MUTT_HASH_ALLOW_DUPS);
-    mutt_hash_set_destructor(tctx->hash, thread_hash_destructor, 0);
+  }
+
+#ifdef USE_HCACHE
+  /* On a fresh threading, the saved tree lets most messages skip the
+   * References walk below */
+  struct HashTable *snap = init ? mutt_thread_cache_load(m) : NULL;
+#endif
+
+  /* A plain resort has no new messages to weave in, so the tree structure
+   * can't change: skip the relinking passes and go straight to sorting */
+  bool have_new = init;
+  if (!have_new)
+  {
+    for (i = 0; i < m->msg_count; i++)
+    {
+      e = m->emails[i];
+      if (e && (!e->thread || !e->threaded))
+      {
+        have_new = true;
+        break;
+      }
+    }
   }
 
   /* we want a quick way to see if things are actually attached to the top of the
@@ -909,7 +1014,7 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
    * exists.  otherwise, if there is a MuttThread that already has a message, thread
    * new message as an identical child.  if we didn't attach the message to a
    * MuttThread, make a new one for it. */
-  for (i = 0; i < m->msg_count; i++)
+  for (i = 0; have_new && (i < m->msg_count); i++)
   {
     e = m->emails[i];
     if (!e)
@@ -963,7 +1068,7 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
       {
         tnew = (C_DuplicateThreads ? thread : NULL);
 
-        thread = mutt_mem_calloc(1, sizeof(struct MuttThread));
+        thread = thread_alloc(tctx);
         thread->message = e;
         thread->check_subject = true;
         e->thread = thread;
@@ -1002,7 +1107,7 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
   }
 
   /* thread by references */
-  for (i = 0; i < m->msg_count; i++)
+  for (i = 0; have_new && (i < m->msg_count); i++)
   {
     e = m->emails[i];
     if (!e)
@@ -1015,6 +1120,42 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
     thread = e->thread;
     if (!thread)
       continue;
+
+#ifdef USE_HCACHE
+    /* replay the message's saved position; a parent that no longer resolves
+     * just falls through to the References walk */
+    if (snap && e->env->message_id)
+    {
+      struct ThreadCacheEntry *tce = mutt_hash_find(snap, e->env->message_id);
+      if (tce)
+      {
+        if (tce->parent[0] == '\0')
+        {
+          if (!thread->parent)
+            insert_message(&top.child, &top, thread);
+          continue;
+        }
+        tnew = mutt_hash_find(tctx->hash, tce->parent);
+        if (tnew)
+        {
+          if (tnew->duplicate_thread)
+            tnew = tnew->parent;
+          if (!is_descendant(tnew, thread))
+          {
+            if (thread->parent)
+              unlink_message(&top.child, thread);
+            insert_message(&tnew->child, tnew, thread);
+            thread->fake_thread = tce->fake;
+            continue;
+          }
+        }
+      }
+    }
+#endif
+
+    /* first time threading has needed this message's references */
+    mutt_env_parse_threads(e->env);
+
     using_refs = 0;
 
     while (true)
@@ -1066,7 +1207,7 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
       }
       else
       {
-        tnew = mutt_mem_calloc(1, sizeof(struct MuttThread));
+        tnew = thread_alloc(tctx);
         mutt_hash_insert(tctx->hash, ref->data, tnew);
       }
 
@@ -1082,6 +1223,10 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
       insert_message(&top.child, &top, thread);
   }
 
+#ifdef USE_HCACHE
+  mutt_hash_free(&snap);
+#endif
+
   /* detach everything from the temporary top node */
   for (thread = top.child; thread; thread = thread->next)
   {
@@ -1091,7 +1236,8 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
 
   check_subjects(tctx->mailbox, init);
 
-  if (!C_StrictThreads)
+  /* Subject matching can only find something new when the tree changed */
+  if (!C_StrictThreads && have_new)
     pseudo_threads(tctx);
 
   if (tctx->tree)
@@ -1107,6 +1253,8 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
     /* Draw the thread tree. */
     mutt_draw_tree(tctx);
   }
+
+  mutt_trace_end(span);
 }
 
 /**
@@ -1257,6 +1405,55 @@ off_t mutt_set_vnum(struct Mailbox *m)
   return vsize;
 }
 
+/**
+ * thread_update_aggregates - Recompute the cached subtree counters of a thread
+ * @param tree First sibling of the (sub)threads to count
+ *
+ * Stores, on every node, the number of visible messages in its subtree and
+ * whether the subtree contains new/old/flagged visible messages, stamped with
+ * the current ::ThreadAggGen.  The counters stay valid until a flag or
+ * visibility change bumps the generation, so the per-index-line queries in
+ * mutt_traverse_thread() can answer from the thread root instead of
+ * re-walking the whole subtree each time.
+ */
+static void thread_update_aggregates(struct MuttThread *tree)
+{
+  for (; tree; tree = tree->next)
+  {
+    thread_update_aggregates(tree->child);
+
+    tree->agg_visible = 0;
+    tree->agg_new = false;
+    tree->agg_old = false;
+    tree->agg_flagged = false;
+
+    for (struct MuttThread *kid = tree->child; kid; kid = kid->next)
+    {
+      tree->agg_visible += kid->agg_visible;
+      tree->agg_new |= kid->agg_new;
+      tree->agg_old |= kid->agg_old;
+      tree->agg_flagged |= kid->agg_flagged;
+    }
+
+    struct Email *e = tree->message;
+    if (e && e->visible)
+    {
+      tree->agg_visible++;
+      if (!e->read)
+      {
+        if (e->old)
+          tree->agg_old = true;
+        else
+          tree->agg_new = true;
+      }
+      if (e->flagged)
+        tree->agg_flagged = true;
+    }
+
+    tree->agg_gen = ThreadAggGen;
+  }
+}
+
 /**
  * mutt_traverse_thread - Recurse through an email thread, matching messages
  * @param e_cur Current Email
@@ -1283,11 +1480,25 @@ int mutt_traverse_thread(struct Email *e_cur, MuttThreadFlags flag)
     return e_cur->vnum;
   }
 
+  if (flag & (MUTT_THREAD_COLLAPSE | MUTT_THREAD_UNCOLLAPSE))
+    IndexLineGen++; /* hidden-message counts change */
+
   final = e_cur->vnum;
   thread = e_cur->thread;
   while (thread->parent)
     thread = thread->parent;
   top = thread;
+
+  /* the pure unread/flagged queries don't modify the thread; answer them
+   * from the cached subtree counters when those are still current */
+  if (flag & (MUTT_THREAD_UNREAD | MUTT_THREAD_FLAGGED))
+  {
+    if (top->agg_gen != ThreadAggGen)
+      thread_update_aggregates(top);
+    if (flag & MUTT_THREAD_UNREAD)
+      return (top->agg_old && top->agg_new) ? 1 : (top->agg_old ? 2 : (top->agg_new ? 1 : 0));
+    return top->agg_flagged;
+  }
   while (!thread->message)
     thread = thread->child;
   e_cur = thread->message;
@@ -1517,10 +1728,13 @@ int mutt_messages_in_thread(struct Mailbox *m, struct Email *e, int flag)
  * mutt_make_id_hash - Create a Hash Table for message-ids
  * @param m Mailbox
  * @retval ptr Newly allocated Hash Table
+ *
+ * Duplicate message-ids are kept: the pattern code counts them to decide
+ * whether a message is duplicated (`~=`) without building the thread tree.
  */
 struct HashTable *mutt_make_id_hash(struct Mailbox *m)
 {
-  struct HashTable *hash = mutt_hash_new(m->msg_count * 2, MUTT_HASH_NO_FLAGS);
+  struct HashTable *hash = mutt_hash_new(m->msg_count * 2, MUTT_HASH_ALLOW_DUPS);
 
   for (int i = 0; i < m->msg_count; i++)
   {
@@ -1548,7 +1762,7 @@ static bool link_threads(struct Email *parent, struct Email *child, struct Mailb
     return false;
 
   mutt_break_thread(child);
-  mutt_list_insert_head(&child->env->in_reply_to, mutt_str_dup(parent->env->message_id));
+  mutt_list_insert_head(&child->env->in_reply_to, mutt_intern_dup(parent->env->message_id));
   mutt_set_flag(m, child, MUTT_TAG, false);
 
   child->changed = true;
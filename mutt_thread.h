@@ -46,6 +46,10 @@ extern bool C_SortRe;
 extern bool C_StrictThreads;
 extern bool C_ThreadReceived;
 
+/* Bump whenever message flags or visibility change; invalidates the aggregate
+ * counters cached on MuttThread nodes */
+extern int ThreadAggGen;
+
 /**
  * enum TreeChar - Tree characters for menus
  *
@@ -758,6 +758,28 @@ void mutt_safe_path(struct Buffer *dest, const struct Address *a)
       *p = '_';
 }
 
+/// Memoized writable copies of expando format strings, see mutt_expando_format()
+static struct HashTable *FormatCache = NULL;
+/// Number of entries in #FormatCache
+static int FormatCacheCount = 0;
+
+/**
+ * format_cache_entry_free - Free a #FormatCache entry - Implements ::hash_hdata_free_t
+ */
+static void format_cache_entry_free(int type, void *obj, intptr_t data)
+{
+  FREE(&obj);
+}
+
+/**
+ * mutt_expando_cleanup - Free the memoized expando format strings
+ */
+void mutt_expando_cleanup(void)
+{
+  mutt_hash_free(&FormatCache);
+  FormatCacheCount = 0;
+}
+
 /**
  * mutt_expando_format - Expand expandos (%x) in a string
  * @param[out] buf      Buffer in which to save string
@@ -779,10 +801,8 @@ void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const c
   size_t wlen, count, len, wid;
   FILE *fp_filter = NULL;
   char *recycler = NULL;
-
-  char src2[256];
-  mutt_str_copy(src2, src, mutt_str_len(src) + 1);
-  src = src2;
+  char *work = NULL;
+  bool work_owned = false;
 
   prefix[0] = '\0';
   buflen--; /* save room for the terminal \0 */
@@ -921,6 +941,34 @@ void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const c
     }
   }
 
+  /* The parser below converts the old '%?x?y&z?' syntax to '%<x?y&z>' in
+   * place as it scans, so it needs a writable copy of the format.  The copies
+   * are memoized per format string: after one full pass the cached copy is
+   * fully converted, and subsequent calls (once per row per redraw for
+   * $index_format) skip both the allocation and the rewrite.  The cache is
+   * capped since filter formats can recycle arbitrary one-off strings. */
+  if (!FormatCache)
+  {
+    FormatCache = mutt_hash_new(64, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(FormatCache, format_cache_entry_free, 0);
+  }
+  work = mutt_hash_find(FormatCache, src);
+  if (!work)
+  {
+    const size_t n = mutt_str_len(src);
+    /* the rewrite inserts at most two bytes per byte of input */
+    work = mutt_mem_calloc((3 * n) + 2, 1);
+    memcpy(work, src, n + 1);
+    if (FormatCacheCount < 256)
+    {
+      mutt_hash_insert(FormatCache, src, work);
+      FormatCacheCount++;
+    }
+    else
+      work_owned = true;
+  }
+  src = work;
+
   while (*src && (wlen < buflen))
   {
     if (*src == '%')
@@ -1108,7 +1156,7 @@ void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const c
           /* get contents after padding */
           mutt_expando_format(tmp, sizeof(tmp), 0, cols, src + pl, callback, data, flags);
           len = mutt_str_len(tmp);
-          wid = mutt_strwidth(tmp);
+          wid = mutt_strnwidth(tmp, len); /* don't measure tmp twice */
 
           pad = (cols - col - wid) / pw;
           if (pad >= 0)
@@ -1289,6 +1337,9 @@ void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const c
     }
   }
   *wptr = '\0';
+
+  if (work_owned)
+    FREE(&work);
 }
 
 /**
@@ -50,6 +50,7 @@
 #include "context.h"
 #include "copy.h"
 #include "hook.h"
+#include "index.h"
 #include "keymap.h"
 #include "mutt_globals.h"
 #include "mutt_header.h"
@@ -75,6 +76,9 @@
 #ifdef USE_NOTMUCH
 #include "notmuch/lib.h"
 #endif
+#ifdef USE_HCACHE
+#include "hcache/threads.h"
+#endif
 #ifdef ENABLE_NLS
 #include <libintl.h>
 #endif
@@ -397,10 +401,18 @@ struct Context *mx_mbox_open(struct Mailbox *m, OpenMailboxFlags flags)
   m->msg_tagged = 0;
   m->vcount = 0;
 
+  const int span = mutt_trace_start("mx_mbox_open");
+  uint64_t start_ms = mutt_date_epoch_ms();
   int rc = m->mx_ops->mbox_open(ctx->mailbox);
+  mutt_stats_record_ms("open/read", mutt_date_epoch_ms() - start_ms);
+  mutt_trace_end(span);
   m->opened++;
   if (rc == 0)
+  {
+    start_ms = mutt_date_epoch_ms();
     ctx_update(ctx);
+    mutt_stats_record_ms("open/sort", mutt_date_epoch_ms() - start_ms);
+  }
 
   if ((rc == 0) || (rc == -2))
   {
@@ -913,6 +925,10 @@ int mx_mbox_close(struct Context **ptr)
   }
 #endif
 
+#ifdef USE_HCACHE
+  /* the emails are still alive here; fastclose frees them */
+  mutt_thread_cache_save(m);
+#endif
   mx_fastclose_mailbox(m);
   ctx_free(ptr);
 
@@ -1010,12 +1026,14 @@ int mx_mbox_sync(struct Mailbox *m)
       return -1;
   }
 
+  const uint64_t start_ms = mutt_date_epoch_ms();
 #ifdef USE_IMAP
   if (m->type == MUTT_IMAP)
     rc = imap_sync_mailbox(m, purge, false);
   else
 #endif
     rc = sync_mailbox(m);
+  mutt_stats_record_ms("sync/mailbox", mutt_date_epoch_ms() - start_ms);
   if (rc >= 0)
   {
 #ifdef USE_IMAP
@@ -1194,6 +1212,31 @@ int mx_msg_commit(struct Mailbox *m, struct Message *msg)
   return m->mx_ops->msg_commit(m, msg);
 }
 
+/**
+ * mx_msg_batch_begin - Start a group-commit batch on a Mailbox
+ * @param m Mailbox several messages are about to be committed to
+ *
+ * Only maildir batches commits; for every other type this is a no-op.
+ */
+void mx_msg_batch_begin(struct Mailbox *m)
+{
+  if (m && (m->type == MUTT_MAILDIR))
+    maildir_batch_begin();
+}
+
+/**
+ * mx_msg_batch_end - Finish a group-commit batch
+ * @param m Mailbox the messages were committed to
+ * @retval  0 Success
+ * @retval -1 Some messages could not be flushed to disk
+ */
+int mx_msg_batch_end(struct Mailbox *m)
+{
+  if (m && (m->type == MUTT_MAILDIR))
+    return maildir_batch_end(m);
+  return 0;
+}
+
 /**
  * mx_msg_close - Close a message
  * @param[in]  m   Mailbox
@@ -1231,13 +1274,17 @@ void mx_alloc_memory(struct Mailbox *m)
 {
   size_t s = MAX(sizeof(struct Email *), sizeof(int));
 
-  if ((m->email_max + 25) * s < m->email_max * s)
+  /* grow the arrays geometrically - a fixed increment would copy them
+   * O(n^2) times while a big folder is being read */
+  const int grow = MAX(m->email_max, 25);
+
+  if ((m->email_max + grow) * s < m->email_max * s)
   {
     mutt_error(_("Out of memory"));
     mutt_exit(1);
   }
 
-  m->email_max += 25;
+  m->email_max += grow;
   if (m->emails)
   {
     mutt_mem_realloc(&m->emails, sizeof(struct Email *) * m->email_max);
@@ -1248,7 +1295,7 @@ void mx_alloc_memory(struct Mailbox *m)
     m->emails = mutt_mem_calloc(m->email_max, sizeof(struct Email *));
     m->v2r = mutt_mem_calloc(m->email_max, sizeof(int));
   }
-  for (int i = m->email_max - 25; i < m->email_max; i++)
+  for (int i = m->email_max - grow; i < m->email_max; i++)
   {
     m->emails[i] = NULL;
     m->v2r[i] = -1;
@@ -1311,7 +1358,12 @@ int mx_tags_commit(struct Mailbox *m, struct Email *e, char *tags)
     return -1;
 
   if (m->mx_ops->tags_commit)
-    return m->mx_ops->tags_commit(m, e, tags);
+  {
+    const int rc = m->mx_ops->tags_commit(m, e, tags);
+    if (rc == 0)
+      IndexLineGen++; /* %g/%J render the tags */
+    return rc;
+  }
 
   mutt_message(_("Folder doesn't support tagging, aborting"));
   return -1;
@@ -1559,6 +1611,21 @@ int mx_msg_padding_size(struct Mailbox *m)
   return m->mx_ops->msg_padding_size(m);
 }
 
+/**
+ * mx_msg_prefetch - Hint that an email will be needed soon - Wrapper for MxOps::msg_prefetch()
+ * @param m Mailbox
+ * @param e Email likely to be opened next
+ * @retval  0 Success (or the backend has no prefetch)
+ * @retval -1 Failure
+ */
+int mx_msg_prefetch(struct Mailbox *m, struct Email *e)
+{
+  if (!m || !e || !m->mx_ops || !m->mx_ops->msg_prefetch)
+    return 0;
+
+  return m->mx_ops->msg_prefetch(m, e);
+}
+
 /**
  * mx_ac_find - Find the Account owning a Mailbox
  * @param m Mailbox
@@ -1823,3 +1890,50 @@ int mx_save_hcache(struct Mailbox *m, struct Email *e)
 
   return m->mx_ops->msg_save_hcache(m, e);
 }
+
+/**
+ * mx_mbox_warm_all - Open and close every configured Mailbox
+ * @param[out] failed Number of Mailboxes that couldn't be opened (may be NULL)
+ * @retval num Number of Mailboxes successfully opened
+ *
+ * Opening a mailbox runs the backend's normal consistency machinery: header
+ * cache entries are validated against the messages on disk (or the server),
+ * stale records are replaced and missing ones are parsed and stored.  Doing
+ * this for every `mailboxes` entry in one sweep leaves the caches warm and
+ * clean, so interactive opens afterwards are fast.
+ *
+ * The currently open Mailbox is skipped - its state is already live.
+ */
+int mx_mbox_warm_all(int *failed)
+{
+  int opened = 0;
+  int errors = 0;
+
+  struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
+  neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
+  struct MailboxNode *np = NULL;
+  STAILQ_FOREACH(np, &ml, entries)
+  {
+    struct Mailbox *m = np->mailbox;
+    if (Context && (Context->mailbox == m))
+      continue;
+
+    mutt_message(_("Checking %s..."), mailbox_path(m));
+    struct Context *ctx = mx_mbox_open(m, MUTT_READONLY | MUTT_QUIET | MUTT_NOSORT);
+    if (ctx)
+    {
+      mx_mbox_close(&ctx);
+      opened++;
+    }
+    else
+    {
+      mutt_debug(LL_DEBUG1, "failed to open %s\n", mailbox_path(m));
+      errors++;
+    }
+  }
+  neomutt_mailboxlist_clear(&ml);
+
+  if (failed)
+    *failed = errors;
+  return opened;
+}
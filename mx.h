@@ -258,6 +258,24 @@ struct MxOps
    */
   int (*msg_close)       (struct Mailbox *m, struct Message *msg);
 
+  /**
+   * msg_prefetch - Hint that an email will be needed soon
+   * @param m Mailbox
+   * @param e Email likely to be opened next
+   * @retval  0 Success
+   * @retval -1 Failure
+   *
+   * Optional - a backend with nothing useful to do leaves this NULL.
+   * A prefetch must not block noticeably and must not change any message
+   * flags; failures are harmless, the message is simply opened the slow
+   * way later.
+   *
+   * **Contract**
+   * - @a m is not NULL
+   * - @a e is not NULL
+   */
+  int (*msg_prefetch)    (struct Mailbox *m, struct Email *e);
+
   /**
    * msg_padding_size - Bytes of padding between messages
    * @param m Mailbox
@@ -379,11 +397,15 @@ int             mx_mbox_check_stats(struct Mailbox *m, int flags);
 int             mx_mbox_close      (struct Context **ptr);
 struct Context *mx_mbox_open       (struct Mailbox *m, OpenMailboxFlags flags);
 int             mx_mbox_sync       (struct Mailbox *m);
+int             mx_mbox_warm_all   (int *failed);
 int             mx_msg_close       (struct Mailbox *m, struct Message **msg);
+int             mx_msg_batch_end   (struct Mailbox *m);
+void            mx_msg_batch_begin (struct Mailbox *m);
 int             mx_msg_commit      (struct Mailbox *m, struct Message *msg);
 struct Message *mx_msg_open_new    (struct Mailbox *m, const struct Email *e, MsgOpenFlags flags);
 struct Message *mx_msg_open        (struct Mailbox *m, int msgno);
 int             mx_msg_padding_size(struct Mailbox *m);
+int             mx_msg_prefetch    (struct Mailbox *m, struct Email *e);
 int             mx_save_hcache     (struct Mailbox *m, struct Email *e);
 int             mx_path_canon      (char *buf, size_t buflen, const char *folder, enum MailboxType *type);
 int             mx_path_canon2     (struct Mailbox *m, const char *folder);
@@ -1107,6 +1107,96 @@ int mutt_protected_headers_handler(struct Body *a, struct State *s)
   return 0;
 }
 
+/**
+ * struct SigCacheEntry - One remembered signature verification
+ */
+struct SigCacheEntry
+{
+  uint64_t key;  ///< Hash of the signed data and its signature parts
+  bool goodsig;  ///< Did every signature check out?
+  char *output;  ///< What the backend printed while verifying
+  size_t outlen; ///< Length of output
+};
+
+/// Recent signature verifications.  Redisplaying a signed message used to
+/// spawn another gpg/openssl per signature just to reach the same verdict;
+/// the signed bytes haven't changed, so replay the stored result instead.
+#define SIG_CACHE_SIZE 64
+static struct SigCacheEntry SigCache[SIG_CACHE_SIZE];
+static size_t SigCacheNext = 0; ///< Round-robin eviction cursor
+
+/**
+ * sig_cache_key - Hash a signed part and its signatures
+ * @param s      State with the source stream
+ * @param sigs   Array of signature parts
+ * @param sigcnt Number of signatures
+ * @param tempf  File holding the signed data
+ * @retval num Cache key
+ * @retval 0   Failure - the message can't be cached
+ */
+static uint64_t sig_cache_key(struct State *s, struct Body **sigs, int sigcnt,
+                              const char *tempf)
+{
+  char buf[8192];
+  size_t n;
+
+  FILE *fp = fopen(tempf, "r");
+  if (!fp)
+    return 0;
+  uint64_t key = MUTT_FASTHASH_INIT;
+  while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+    key = mutt_fasthash_bytes(buf, n, key);
+  mutt_file_fclose(&fp);
+
+  for (int i = 0; i < sigcnt; i++)
+  {
+    if (!s->fp_in || (fseeko(s->fp_in, sigs[i]->offset, SEEK_SET) != 0))
+      return 0;
+    for (size_t left = sigs[i]->length; left != 0; left -= n)
+    {
+      n = fread(buf, 1, MIN(sizeof(buf), left), s->fp_in);
+      if (n == 0)
+        return 0;
+      key = mutt_fasthash_bytes(buf, n, key);
+    }
+  }
+
+  return key ? key : 1; /* reserve 0 for "not cacheable" */
+}
+
+/**
+ * sig_cache_find - Look up a remembered verification
+ * @param key Cache key, from sig_cache_key()
+ * @retval ptr  Matching entry
+ * @retval NULL Not in the cache
+ */
+static struct SigCacheEntry *sig_cache_find(uint64_t key)
+{
+  for (size_t i = 0; i < SIG_CACHE_SIZE; i++)
+    if (SigCache[i].output && (SigCache[i].key == key))
+      return &SigCache[i];
+  return NULL;
+}
+
+/**
+ * sig_cache_store - Remember the result of a signature verification
+ * @param key     Cache key, from sig_cache_key()
+ * @param goodsig Did every signature check out?
+ * @param output  Verification output (the entry takes ownership)
+ * @param outlen  Length of output
+ */
+static void sig_cache_store(uint64_t key, bool goodsig, char *output, size_t outlen)
+{
+  struct SigCacheEntry *sce = &SigCache[SigCacheNext];
+  SigCacheNext = (SigCacheNext + 1) % SIG_CACHE_SIZE;
+
+  FREE(&sce->output);
+  sce->key = key;
+  sce->goodsig = goodsig;
+  sce->output = output;
+  sce->outlen = outlen;
+}
+
 /**
  * mutt_signed_handler - Verify a "multipart/signed" body - Implements ::handler_t
  */
@@ -1183,6 +1273,36 @@ int mutt_signed_handler(struct Body *a, struct State *s)
       bool goodsig = true;
       if (crypt_write_signed(a, s, mutt_b2s(tempfile)) == 0)
       {
+        /* When the prefix is unset (the normal display case), try to replay
+         * an earlier verification of the same bytes instead of spawning the
+         * backend again */
+        const uint64_t key =
+            s->prefix ? 0 : sig_cache_key(s, signatures, sigcnt, mutt_b2s(tempfile));
+        struct SigCacheEntry *sce = (key != 0) ? sig_cache_find(key) : NULL;
+        FILE *fp_real = NULL, *fp_capture = NULL;
+        struct Buffer *capfile = NULL;
+
+        if (sce)
+        {
+          fwrite(sce->output, 1, sce->outlen, s->fp_out);
+          goodsig = sce->goodsig;
+          goto verified;
+        }
+
+        if (key != 0)
+        {
+          /* Divert the backend's output so it can be stored alongside the
+           * verdict.  If the capture file can't be made, verify uncached. */
+          capfile = mutt_buffer_pool_get();
+          mutt_buffer_mktemp(capfile);
+          fp_capture = mutt_file_fopen(mutt_b2s(capfile), "w+");
+          if (fp_capture)
+          {
+            fp_real = s->fp_out;
+            s->fp_out = fp_capture;
+          }
+        }
+
         for (int i = 0; i < sigcnt; i++)
         {
           if (((WithCrypto & APPLICATION_PGP) != 0) &&
@@ -1211,6 +1331,30 @@ int mutt_signed_handler(struct Body *a, struct State *s)
                          "We can't verify %s/%s signatures. --]\n\n"),
                        TYPE(signatures[i]), signatures[i]->subtype);
         }
+
+        if (fp_capture)
+        {
+          s->fp_out = fp_real;
+          fflush(fp_capture);
+          long sz = ftell(fp_capture);
+          if (sz >= 0)
+          {
+            char *output = mutt_mem_malloc((sz > 0) ? sz : 1);
+            rewind(fp_capture);
+            if ((long) fread(output, 1, sz, fp_capture) == sz)
+            {
+              fwrite(output, 1, sz, s->fp_out);
+              sig_cache_store(key, goodsig, output, sz);
+            }
+            else
+              FREE(&output);
+          }
+          mutt_file_fclose(&fp_capture);
+          mutt_file_unlink(mutt_b2s(capfile));
+        }
+
+      verified:
+        mutt_buffer_pool_release(&capfile);
       }
 
       mutt_file_unlink(mutt_b2s(tempfile));
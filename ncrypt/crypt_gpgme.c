@@ -37,6 +37,7 @@
 #include <gpg-error.h>
 #include <gpgme.h>
 #include <langinfo.h>
+#include <limits.h>
 #include <locale.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -475,6 +476,98 @@ static void crypt_key_free(struct CryptKeyInfo **keylist)
   }
 }
 
+/**
+ * struct KeyListCache - Cached result of one keyring enumeration
+ *
+ * get_candidates() listings are cached per pattern for as long as the keyring
+ * on disk is unchanged: enumerating a large keyring takes seconds, and one
+ * encrypted send repeats the enumeration for every recipient.  The cached
+ * CryptKeyInfo nodes hold their own references on the gpgme key objects.
+ */
+struct KeyListCache
+{
+  char *pattern;             ///< Escaped hint pattern the listing used
+  SecurityFlags app;         ///< Application type, e.g. #APPLICATION_PGP
+  int secret;                ///< Was this a secret-key listing?
+  struct CryptKeyInfo *keys; ///< Keys the listing produced
+  struct KeyListCache *next; ///< Linked list
+};
+
+static struct KeyListCache *KeyCache = NULL;
+static time_t KeyCacheMtime = 0; ///< Keyring mtime the cache was built against
+
+/**
+ * keyring_mtime - Last modification time of the GnuPG keyring
+ * @retval num Newest mtime among the keyring files
+ * @retval 0   No keyring file could be examined
+ *
+ * Looks at the usual files under $GNUPGHOME (or ~/.gnupg): the keybox and
+ * legacy keyring formats, and the trust database, whose changes can alter a
+ * key's validity.
+ */
+static time_t keyring_mtime(void)
+{
+  static const char *const files[] = { "pubring.kbx", "pubring.gpg", "trustdb.gpg" };
+  char base[PATH_MAX];
+  char path[PATH_MAX + 32];
+  struct stat sb;
+  time_t mtime = 0;
+
+  const char *home = mutt_str_getenv("GNUPGHOME");
+  if (home)
+    mutt_str_copy(base, home, sizeof(base));
+  else
+  {
+    const char *h = mutt_str_getenv("HOME");
+    if (!h)
+      return 0;
+    snprintf(base, sizeof(base), "%s/.gnupg", h);
+  }
+
+  for (size_t i = 0; i < mutt_array_size(files); i++)
+  {
+    snprintf(path, sizeof(path), "%s/%s", base, files[i]);
+    if ((stat(path, &sb) == 0) && (sb.st_mtime > mtime))
+      mtime = sb.st_mtime;
+  }
+
+  return mtime;
+}
+
+/**
+ * crypt_flush_keycache - Drop all cached keyring listings
+ */
+static void crypt_flush_keycache(void)
+{
+  while (KeyCache)
+  {
+    struct KeyListCache *entry = KeyCache;
+    KeyCache = entry->next;
+    crypt_key_free(&entry->keys);
+    FREE(&entry->pattern);
+    FREE(&entry);
+  }
+}
+
+/**
+ * crypt_copy_keylist - Return a copy of a list of keys
+ * @param keys List to copy
+ * @retval ptr Copy of the list
+ */
+static struct CryptKeyInfo *crypt_copy_keylist(struct CryptKeyInfo *keys)
+{
+  struct CryptKeyInfo *copy = NULL;
+  struct CryptKeyInfo **endp = &copy;
+
+  for (struct CryptKeyInfo *k = keys; k; k = k->next)
+  {
+    *endp = crypt_copy_key(k);
+    endp = &(*endp)->next;
+  }
+
+  return copy;
+}
+
 /**
  * crypt_id_is_strong - Is the key strong
  * @param key Key to test
@@ -1873,7 +1966,7 @@ static int show_one_sig_status(gpgme_ctx_t ctx, int idx, struct State *s)
 }
 
 /**
- * verify_one - Do the actual verification step
+ * verify_run - Do the actual verification step
  * @param sigbdy   Mime part containing signature
  * @param s        State to read from
  * @param tempfile Temporary file to read
@@ -1885,7 +1978,7 @@ static int show_one_sig_status(gpgme_ctx_t ctx, int idx, struct State *s)
  *
  * With is_smime set to true we assume S/MIME.
  */
-static int verify_one(struct Body *sigbdy, struct State *s, const char *tempfile, bool is_smime)
+static int verify_run(struct Body *sigbdy, struct State *s, const char *tempfile, bool is_smime)
 {
   int badsig = -1;
   int anywarn = 0;
@@ -2007,6 +2100,198 @@ static int verify_one(struct Body *sigbdy, struct State *s, const char *tempfile
   return badsig ? 1 : anywarn ? 2 : 0;
 }
 
+/**
+ * struct VerifyCache - Memoized result of one signature verification
+ *
+ * Verification runs synchronously inside message display, so a signed
+ * message blocks the pager on gpgme (and possibly a keyserver) every time
+ * it is opened.  Remember the rendered signature-information block and the
+ * return code, keyed on the content of the signature and the signed data,
+ * so that reopening a message costs a checksum instead of a gpg run.
+ */
+struct VerifyCache
+{
+  unsigned char sig_md5[16]; ///< Digest of the signature part
+  unsigned char msg_md5[16]; ///< Digest of the signed data
+  StateFlags flags;          ///< State flags the output was rendered with
+  bool is_smime;             ///< Was this an S/MIME verification?
+  int rc;                    ///< Result of verify_run()
+  char *output;              ///< Rendered signature-information block
+  size_t output_len;         ///< Length of output
+  gpgme_key_t key;           ///< Signature key, last set by show_one_sig_status()
+  struct VerifyCache *next;  ///< Linked list
+};
+
+static struct VerifyCache *VerifyCache = NULL;
+static time_t VerifyCacheMtime = 0; ///< Keyring mtime the cache was built against
+
+/**
+ * verify_flush_cache - Drop all memoized verification results
+ */
+static void verify_flush_cache(void)
+{
+  while (VerifyCache)
+  {
+    struct VerifyCache *entry = VerifyCache;
+    VerifyCache = entry->next;
+    if (entry->key)
+      gpgme_key_unref(entry->key);
+    FREE(&entry->output);
+    FREE(&entry);
+  }
+}
+
+/**
+ * md5_file_region - Digest a region of an open file
+ * @param fp     File to read
+ * @param offset Offset of the region
+ * @param length Length of the region
+ * @param digest Buffer for the 16-byte result
+ * @retval true Success
+ */
+static bool md5_file_region(FILE *fp, LOFF_T offset, size_t length, unsigned char digest[16])
+{
+  struct Md5Ctx md5ctx;
+  char buf[4096];
+
+  if (fseeko(fp, offset, SEEK_SET) != 0)
+    return false;
+
+  mutt_md5_init_ctx(&md5ctx);
+  while (length > 0)
+  {
+    const size_t n = fread(buf, 1, MIN(length, sizeof(buf)), fp);
+    if (n == 0)
+      return false;
+    mutt_md5_process_bytes(buf, n, &md5ctx);
+    length -= n;
+  }
+  mutt_md5_finish_ctx(&md5ctx, digest);
+  return true;
+}
+
+/**
+ * md5_file - Digest a whole file
+ * @param path   File to read
+ * @param digest Buffer for the 16-byte result
+ * @retval true Success
+ */
+static bool md5_file(const char *path, unsigned char digest[16])
+{
+  struct Md5Ctx md5ctx;
+  char buf[4096];
+  size_t n;
+
+  FILE *fp = fopen(path, "r");
+  if (!fp)
+    return false;
+
+  mutt_md5_init_ctx(&md5ctx);
+  while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+    mutt_md5_process_bytes(buf, n, &md5ctx);
+  const bool rc = !ferror(fp);
+  mutt_file_fclose(&fp);
+  mutt_md5_finish_ctx(&md5ctx, digest);
+  return rc;
+}
+
+/**
+ * verify_one - Verify a signature, memoizing the result
+ * @param sigbdy   Mime part containing signature
+ * @param s        State to read from
+ * @param tempfile Temporary file to read
+ * @param is_smime Is the key S/MIME?
+ * @retval  0 Success
+ * @retval  1 Bad signature
+ * @retval  2 Warnings
+ * @retval -1 Error
+ *
+ * A cache hit replays the output of the earlier verify_run() and restores
+ * the #signature_key global for the pager's check-key function.  The cache
+ * is flushed whenever the keyring changes, since a newly imported key can
+ * change a verdict; errors are never cached.
+ */
+static int verify_one(struct Body *sigbdy, struct State *s, const char *tempfile, bool is_smime)
+{
+  unsigned char sig_md5[16];
+  unsigned char msg_md5[16];
+
+  const time_t mtime = keyring_mtime();
+  if ((mtime == 0) || (mtime != VerifyCacheMtime))
+    verify_flush_cache();
+  VerifyCacheMtime = mtime;
+
+  if ((mtime == 0) ||
+      !md5_file_region(s->fp_in, sigbdy->offset, sigbdy->length, sig_md5) ||
+      !md5_file(tempfile, msg_md5))
+  {
+    return verify_run(sigbdy, s, tempfile, is_smime);
+  }
+
+  for (struct VerifyCache *entry = VerifyCache; entry; entry = entry->next)
+  {
+    if ((entry->flags == s->flags) && (entry->is_smime == is_smime) &&
+        (memcmp(entry->sig_md5, sig_md5, sizeof(sig_md5)) == 0) &&
+        (memcmp(entry->msg_md5, msg_md5, sizeof(msg_md5)) == 0))
+    {
+      state_write(s, entry->output, entry->output_len);
+      if (signature_key)
+      {
+        gpgme_key_unref(signature_key);
+        signature_key = NULL;
+      }
+      if (entry->key)
+      {
+        gpgme_key_ref(entry->key);
+        signature_key = entry->key;
+      }
+      mutt_debug(LL_DEBUG1, "cached verification, returning %d\n", entry->rc);
+      return entry->rc;
+    }
+  }
+
+  /* Capture the rendered output so a later hit can replay it */
+  FILE *fp_tmp = mutt_file_mkstemp();
+  if (!fp_tmp)
+    return verify_run(sigbdy, s, tempfile, is_smime);
+
+  struct State s_tmp = *s;
+  s_tmp.fp_out = fp_tmp;
+  const int rc = verify_run(sigbdy, &s_tmp, tempfile, is_smime);
+
+  fflush(fp_tmp);
+  const LOFF_T end = ftello(fp_tmp);
+  rewind(fp_tmp);
+  char *output = mutt_mem_malloc(end);
+  const bool complete = (fread(output, 1, end, fp_tmp) == (size_t) end);
+  mutt_file_fclose(&fp_tmp);
+
+  state_write(s, output, end);
+
+  if ((rc >= 0) && complete)
+  {
+    struct VerifyCache *entry = mutt_mem_calloc(1, sizeof(*entry));
+    memcpy(entry->sig_md5, sig_md5, sizeof(sig_md5));
+    memcpy(entry->msg_md5, msg_md5, sizeof(msg_md5));
+    entry->flags = s->flags;
+    entry->is_smime = is_smime;
+    entry->rc = rc;
+    entry->output = output; /* takes ownership */
+    entry->output_len = end;
+    if (signature_key)
+    {
+      gpgme_key_ref(signature_key);
+      entry->key = signature_key;
+    }
+    entry->next = VerifyCache;
+    VerifyCache = entry;
+  }
+  else
+    FREE(&output);
+
+  return rc;
+}
+
 /**
  * pgp_gpgme_verify_one - Implements CryptModuleSpecs::verify_one()
  */
@@ -3366,6 +3651,26 @@ static struct CryptKeyInfo *get_candidates(struct ListHead *hints, SecurityFlags
   if (!pattern)
     return NULL;
 
+  /* Serve repeated enumerations from the cache while the keyring on disk is
+   * unchanged.  A changed (or unstattable) keyring flushes everything. */
+  const time_t mtime = keyring_mtime();
+  if ((mtime == 0) || (mtime != KeyCacheMtime))
+    crypt_flush_keycache();
+  KeyCacheMtime = mtime;
+
+  if (mtime != 0)
+  {
+    for (struct KeyListCache *entry = KeyCache; entry; entry = entry->next)
+    {
+      if ((entry->app == app) && (entry->secret == secret) &&
+          mutt_str_equal(entry->pattern, pattern))
+      {
+        FREE(&pattern);
+        return crypt_copy_keylist(entry->keys);
+      }
+    }
+  }
+
   ctx = create_gpgme_context(0);
   db = NULL;
   kend = &db;
@@ -3485,6 +3790,20 @@ static struct CryptKeyInfo *get_candidates(struct ListHead *hints, SecurityFlags
   }
 
   gpgme_release(ctx);
+
+  if (mtime != 0)
+  {
+    /* Remember the result (even an empty one) for the next lookup */
+    struct KeyListCache *entry = mutt_mem_calloc(1, sizeof(*entry));
+    entry->pattern = pattern; /* takes ownership */
+    pattern = NULL;
+    entry->app = app;
+    entry->secret = secret;
+    entry->keys = crypt_copy_keylist(db);
+    entry->next = KeyCache;
+    KeyCache = entry;
+  }
+
   FREE(&pattern);
   return db;
 }
@@ -36,9 +36,11 @@
 #include <ctype.h>
 #include <fcntl.h>
 #include <iconv.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
 #include "private.h"
@@ -72,6 +74,103 @@
 
 static char *chs = NULL;
 
+/**
+ * struct PgpListCache - Cached result of one keyring listing
+ *
+ * pgp_get_candidates() forks gpg and parses its whole colon output for every
+ * invocation, which makes opening the key menu cold a multi-second operation
+ * on a big keyring.  Cache the parsed lists for the lifetime of the keyring.
+ */
+struct PgpListCache
+{
+  enum PgpRing keyring;      ///< Public or secret keyring
+  char *hints;               ///< Hint strings, joined with newlines
+  struct PgpKeyInfo *keys;   ///< Parsed keys the listing produced
+  struct PgpListCache *next; ///< Linked list
+};
+
+static struct PgpListCache *PgpListCache = NULL;
+static time_t PgpListCacheMtime = 0; ///< Keyring mtime the cache was built against
+
+/**
+ * pgp_keyring_mtime - Last modification time of the GnuPG keyring
+ * @retval num Newest mtime among the keyring files
+ * @retval 0   No keyring file could be examined
+ *
+ * Looks at the usual files under $GNUPGHOME (or ~/.gnupg).  The listing
+ * command is configurable, so this is a heuristic - if none of the files
+ * exist, the caller must not cache.
+ */
+static time_t pgp_keyring_mtime(void)
+{
+  static const char *const files[] = {
+    "pubring.kbx", "pubring.gpg", "secring.gpg", "trustdb.gpg", "private-keys-v1.d",
+  };
+  char base[PATH_MAX];
+  char path[PATH_MAX + 32];
+  struct stat sb;
+  time_t mtime = 0;
+
+  const char *home = mutt_str_getenv("GNUPGHOME");
+  if (home)
+    mutt_str_copy(base, home, sizeof(base));
+  else
+  {
+    const char *h = mutt_str_getenv("HOME");
+    if (!h)
+      return 0;
+    snprintf(base, sizeof(base), "%s/.gnupg", h);
+  }
+
+  for (size_t i = 0; i < mutt_array_size(files); i++)
+  {
+    snprintf(path, sizeof(path), "%s/%s", base, files[i]);
+    if ((stat(path, &sb) == 0) && (sb.st_mtime > mtime))
+      mtime = sb.st_mtime;
+  }
+
+  return mtime;
+}
+
+/**
+ * pgp_cache_flush - Drop all cached keyring listings
+ */
+static void pgp_cache_flush(void)
+{
+  while (PgpListCache)
+  {
+    struct PgpListCache *entry = PgpListCache;
+    PgpListCache = entry->next;
+    pgp_key_free(&entry->keys);
+    FREE(&entry->hints);
+    FREE(&entry);
+  }
+}
+
+/**
+ * hints_join - Join a list of hints into a cache key
+ * @param hints List of strings
+ * @retval ptr Hints joined with newlines
+ *
+ * @note The caller must free the result
+ */
+static char *hints_join(struct ListHead *hints)
+{
+  struct Buffer buf = mutt_buffer_make(128);
+  struct ListNode *np = NULL;
+
+  STAILQ_FOREACH(np, hints, entries)
+  {
+    if (np->data)
+    {
+      mutt_buffer_addstr(&buf, np->data);
+      mutt_buffer_addch(&buf, '\n');
+    }
+  }
+
+  return buf.data;
+}
+
 /**
  * fix_uid - Decode backslash-escaped user ids (in place)
  * @param uid String to decode
@@ -115,7 +214,6 @@ static void fix_uid(char *uid)
         memcpy(uid, buf, n);
     }
     FREE(&buf);
-    iconv_close(cd);
   }
 }
 
@@ -417,15 +515,40 @@ struct PgpKeyInfo *pgp_get_candidates(enum PgpRing keyring, struct ListHead *hin
   struct PgpKeyInfo *db = NULL, **kend = NULL, *k = NULL, *kk = NULL, *mainkey = NULL;
   bool is_sub = false;
 
+  /* Serve repeated listings from the cache while the keyring on disk is
+   * unchanged.  A changed (or unstattable) keyring flushes everything. */
+  const time_t mtime = pgp_keyring_mtime();
+  if ((mtime == 0) || (mtime != PgpListCacheMtime))
+    pgp_cache_flush();
+  PgpListCacheMtime = mtime;
+
+  char *hintstr = NULL;
+  if (mtime != 0)
+  {
+    hintstr = hints_join(hints);
+    for (struct PgpListCache *entry = PgpListCache; entry; entry = entry->next)
+    {
+      if ((entry->keyring == keyring) && mutt_str_equal(entry->hints, hintstr))
+      {
+        FREE(&hintstr);
+        return pgp_copy_keylist(entry->keys);
+      }
+    }
+  }
+
   int fd_null = open("/dev/null", O_RDWR);
   if (fd_null == -1)
+  {
+    FREE(&hintstr);
     return NULL;
+  }
 
   mutt_str_replace(&chs, C_Charset);
 
   pid = pgp_invoke_list_keys(NULL, &fp, NULL, -1, -1, fd_null, keyring, hints);
   if (pid == -1)
   {
+    FREE(&hintstr);
     close(fd_null);
     return NULL;
   }
@@ -470,5 +593,16 @@ struct PgpKeyInfo *pgp_get_candidates(enum PgpRing keyring, struct ListHead *hin
 
   close(fd_null);
 
+  if (hintstr)
+  {
+    /* Remember the result (even an empty one) for the next lookup */
+    struct PgpListCache *entry = mutt_mem_calloc(1, sizeof(*entry));
+    entry->keyring = keyring;
+    entry->hints = hintstr; /* takes ownership */
+    entry->keys = pgp_copy_keylist(db);
+    entry->next = PgpListCache;
+    PgpListCache = entry;
+  }
+
   return db;
 }
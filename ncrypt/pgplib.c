@@ -141,6 +141,42 @@ struct PgpUid *pgp_copy_uids(struct PgpUid *up, struct PgpKeyInfo *parent)
   return l;
 }
 
+/**
+ * pgp_copy_keylist - Copy a list of PGP keys
+ * @param keys List of PGP keys
+ * @retval ptr New list of PGP keys
+ *
+ * Subkey parent pointers are remapped onto the copied primaries, so the copy
+ * can be modified and freed with pgp_key_free() independently of the original.
+ */
+struct PgpKeyInfo *pgp_copy_keylist(struct PgpKeyInfo *keys)
+{
+  struct PgpKeyInfo *l = NULL;
+  struct PgpKeyInfo **lp = &l;
+  struct PgpKeyInfo *mainkey = NULL;
+
+  for (struct PgpKeyInfo *k = keys; k; k = k->next)
+  {
+    struct PgpKeyInfo *p = mutt_mem_calloc(1, sizeof(*p));
+    p->keyid = mutt_str_dup(k->keyid);
+    p->fingerprint = mutt_str_dup(k->fingerprint);
+    p->flags = k->flags;
+    p->keylen = k->keylen;
+    p->gen_time = k->gen_time;
+    p->numalg = k->numalg;
+    p->algorithm = k->algorithm;
+    if (k->parent && (k->parent != k))
+      p->parent = mainkey;
+    else
+      mainkey = p;
+    p->address = pgp_copy_uids(k->address, p);
+    *lp = p;
+    lp = &p->next;
+  }
+
+  return l;
+}
+
 /**
  * key_free - Free a PGP Key info
  * @param[out] kpp PGP Key info to free
@@ -59,6 +59,7 @@ struct PgpKeyInfo
 
 const char *pgp_pkalgbytype(unsigned char type);
 
+struct PgpKeyInfo *pgp_copy_keylist(struct PgpKeyInfo *keys);
 struct PgpUid *pgp_copy_uids(struct PgpUid *up, struct PgpKeyInfo *parent);
 
 bool pgp_canencrypt(unsigned char type);
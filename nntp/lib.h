@@ -89,6 +89,7 @@ struct NntpAccountData
   bool newsrc_modified    : 1;
   FILE *fp_newsrc;
   char *newsrc_file;
+  char *newsrc_image; ///< Copy of the .newsrc contents last written
   char *authenticators;
   char *overview_fmt;
   off_t size;
@@ -33,6 +33,7 @@
 #include <errno.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -151,6 +152,27 @@ void nntp_group_unread_stat(struct NntpMboxData *mdata)
   }
 }
 
+static int newsrc_bin_load(struct NntpAccountData *adata, const struct stat *sb);
+static void newsrc_bin_save(struct NntpAccountData *adata);
+
+/**
+ * newsrc_clear_groups - Forget the .newsrc state of every group
+ * @param adata NNTP server
+ */
+static void newsrc_clear_groups(struct NntpAccountData *adata)
+{
+  for (unsigned int i = 0; i < adata->groups_num; i++)
+  {
+    struct NntpMboxData *mdata = adata->groups_list[i];
+    if (!mdata)
+      continue;
+
+    mdata->subscribed = false;
+    mdata->newsrc_len = 0;
+    FREE(&mdata->newsrc_ent);
+  }
+}
+
 /**
  * nntp_newsrc_parse - Parse .newsrc file
  * @param adata NNTP server
@@ -161,6 +183,7 @@ void nntp_group_unread_stat(struct NntpMboxData *mdata)
 int nntp_newsrc_parse(struct NntpAccountData *adata)
 {
   char *line = NULL;
+  struct MuttFileLines fl = { 0 };
   struct stat sb;
 
   if (adata->fp_newsrc)
@@ -204,22 +227,23 @@ int nntp_newsrc_parse(struct NntpAccountData *adata)
   adata->size = sb.st_size;
   adata->mtime = sb.st_mtime;
   adata->newsrc_modified = true;
+  FREE(&adata->newsrc_image); /* the file changed under us */
   mutt_debug(LL_DEBUG1, "Parsing %s\n", adata->newsrc_file);
 
   /* .newsrc has been externally modified or hasn't been loaded yet */
-  for (unsigned int i = 0; i < adata->groups_num; i++)
-  {
-    struct NntpMboxData *mdata = adata->groups_list[i];
-    if (!mdata)
-      continue;
+  newsrc_clear_groups(adata);
 
-    mdata->subscribed = false;
-    mdata->newsrc_len = 0;
-    FREE(&mdata->newsrc_ent);
-  }
+  /* a valid binary sidecar stands in for parsing the text */
+  if (newsrc_bin_load(adata, &sb) == 0)
+    return 1;
 
-  line = mutt_mem_malloc(sb.st_size + 1);
-  while (sb.st_size && fgets(line, sb.st_size + 1, adata->fp_newsrc))
+  /* one bulk read; the entries are parsed from slices of the image */
+  if (!mutt_file_lines_load(&fl, adata->fp_newsrc))
+  {
+    nntp_newsrc_close(adata);
+    return -1;
+  }
+  while ((line = mutt_file_lines_next(&fl)))
   {
     char *b = NULL, *h = NULL;
     unsigned int j = 1;
@@ -284,7 +308,8 @@ int nntp_newsrc_parse(struct NntpAccountData *adata)
     nntp_group_unread_stat(mdata);
     mutt_debug(LL_DEBUG2, "%s\n", mdata->group);
   }
-  FREE(&line);
+  mutt_file_lines_free(&fl);
+  newsrc_bin_save(adata);
   return 1;
 }
 
@@ -487,6 +512,14 @@ int nntp_newsrc_update(struct NntpAccountData *adata)
   }
   buf[off] = '\0';
 
+  /* most syncs change nothing; skip the rewrite if the image is identical */
+  if (mutt_str_equal(adata->newsrc_image, buf))
+  {
+    mutt_debug(LL_DEBUG1, "%s unchanged, not rewriting\n", adata->newsrc_file);
+    FREE(&buf);
+    return 0;
+  }
+
   /* newrc being fully rewritten */
   mutt_debug(LL_DEBUG1, "Updating %s\n", adata->newsrc_file);
   if (adata->newsrc_file && (update_file(adata->newsrc_file, buf) == 0))
@@ -498,6 +531,8 @@ int nntp_newsrc_update(struct NntpAccountData *adata)
     {
       adata->size = sb.st_size;
       adata->mtime = sb.st_mtime;
+      mutt_str_replace(&adata->newsrc_image, buf);
+      newsrc_bin_save(adata);
     }
     else
     {
@@ -548,6 +583,161 @@ static void cache_expand(char *dst, size_t dstlen, struct ConnAccount *cac, cons
   mutt_buffer_pool_release(&tmp);
 }
 
+/// Format version of the binary .newsrc sidecar
+#define NEWSRC_BIN_VERSION 1
+
+/// Magic number of the binary .newsrc sidecar: "NMNB"
+#define NEWSRC_BIN_MAGIC 0x4e4d4e42
+
+/**
+ * struct NewsrcBinHeader - On-disk header of the binary .newsrc sidecar
+ */
+struct NewsrcBinHeader
+{
+  uint32_t magic;   ///< #NEWSRC_BIN_MAGIC
+  uint32_t version; ///< #NEWSRC_BIN_VERSION
+  int64_t mtime;    ///< mtime of the text .newsrc it was generated from
+  int64_t size;     ///< size of the text .newsrc it was generated from
+  uint32_t groups;  ///< Number of group records that follow
+};
+
+/**
+ * newsrc_bin_load - Load .newsrc state from the binary sidecar
+ * @param adata NNTP server
+ * @param sb    stat of the text .newsrc
+ * @retval  0 Success - the groups are populated
+ * @retval -1 No usable sidecar - parse the text instead
+ *
+ * The sidecar is only trusted if it was generated from exactly the text file
+ * on disk (same mtime and size); anything unexpected in it falls back to the
+ * text parser.
+ */
+static int newsrc_bin_load(struct NntpAccountData *adata, const struct stat *sb)
+{
+  if (!adata->cacheable)
+    return -1;
+
+  char file[PATH_MAX];
+  cache_expand(file, sizeof(file), &adata->conn->account, ".newsrc.bin");
+  FILE *fp = mutt_file_fopen(file, "r");
+  if (!fp)
+    return -1;
+
+  struct NewsrcBinHeader hdr = { 0 };
+  if ((fread(&hdr, sizeof(hdr), 1, fp) != 1) || (hdr.magic != NEWSRC_BIN_MAGIC) ||
+      (hdr.version != NEWSRC_BIN_VERSION) || (hdr.mtime != (int64_t) sb->st_mtime) ||
+      (hdr.size != (int64_t) sb->st_size))
+  {
+    mutt_file_fclose(&fp);
+    return -1;
+  }
+
+  mutt_debug(LL_DEBUG1, "Loading %s\n", file);
+  for (uint32_t i = 0; i < hdr.groups; i++)
+  {
+    char name[1024];
+    uint16_t namelen = 0;
+    uint8_t subscribed = 0;
+    uint32_t len = 0;
+
+    if ((fread(&namelen, sizeof(namelen), 1, fp) != 1) || (namelen == 0) ||
+        (namelen >= sizeof(name)) || (fread(name, namelen, 1, fp) != 1) ||
+        (fread(&subscribed, sizeof(subscribed), 1, fp) != 1) ||
+        (fread(&len, sizeof(len), 1, fp) != 1) || (len > 0x10000000))
+    {
+      goto nbl_fail;
+    }
+    name[namelen] = '\0';
+
+    struct NntpMboxData *mdata = mdata_find(adata, name);
+    FREE(&mdata->newsrc_ent);
+    mdata->newsrc_ent = mutt_mem_calloc(len ? len : 1, sizeof(struct NewsrcEntry));
+    if (len && (fread(mdata->newsrc_ent, len * sizeof(struct NewsrcEntry), 1, fp) != 1))
+      goto nbl_fail;
+
+    if (len == 0)
+    {
+      mdata->newsrc_ent[0].first = 1;
+      mdata->newsrc_ent[0].last = 0;
+      len = 1;
+    }
+    mdata->newsrc_len = len;
+    mdata->subscribed = subscribed;
+    if (mdata->last_message == 0)
+      mdata->last_message = mdata->newsrc_ent[len - 1].last;
+    nntp_group_unread_stat(mdata);
+  }
+
+  mutt_file_fclose(&fp);
+  return 0;
+
+nbl_fail:
+  /* a half-applied sidecar must not leak into the text parse */
+  mutt_debug(LL_DEBUG1, "%s is corrupt, falling back to text parse\n", file);
+  mutt_file_fclose(&fp);
+  newsrc_clear_groups(adata);
+  return -1;
+}
+
+/**
+ * newsrc_bin_save - Write the current .newsrc state to the binary sidecar
+ * @param adata NNTP server
+ *
+ * Called whenever the text .newsrc has just been parsed or rewritten, so
+ * adata->mtime and adata->size describe the text file the sidecar mirrors.
+ */
+static void newsrc_bin_save(struct NntpAccountData *adata)
+{
+  if (!adata->cacheable)
+    return;
+
+  char file[PATH_MAX];
+  char tmpfile[PATH_MAX + 8];
+  cache_expand(file, sizeof(file), &adata->conn->account, ".newsrc.bin");
+  snprintf(tmpfile, sizeof(tmpfile), "%s.tmp", file);
+
+  FILE *fp = mutt_file_fopen(tmpfile, "w");
+  if (!fp)
+    return;
+
+  struct NewsrcBinHeader hdr = { 0 };
+  hdr.magic = NEWSRC_BIN_MAGIC;
+  hdr.version = NEWSRC_BIN_VERSION;
+  hdr.mtime = (int64_t) adata->mtime;
+  hdr.size = (int64_t) adata->size;
+  for (unsigned int i = 0; i < adata->groups_num; i++)
+  {
+    struct NntpMboxData *mdata = adata->groups_list[i];
+    if (mdata && mdata->newsrc_ent)
+      hdr.groups++;
+  }
+  fwrite(&hdr, sizeof(hdr), 1, fp);
+
+  for (unsigned int i = 0; i < adata->groups_num; i++)
+  {
+    struct NntpMboxData *mdata = adata->groups_list[i];
+    if (!mdata || !mdata->newsrc_ent)
+      continue;
+
+    const uint16_t namelen = strlen(mdata->group);
+    const uint8_t subscribed = mdata->subscribed;
+    const uint32_t len = mdata->newsrc_len;
+    fwrite(&namelen, sizeof(namelen), 1, fp);
+    fwrite(mdata->group, namelen, 1, fp);
+    fwrite(&subscribed, sizeof(subscribed), 1, fp);
+    fwrite(&len, sizeof(len), 1, fp);
+    if (len)
+      fwrite(mdata->newsrc_ent, len * sizeof(struct NewsrcEntry), 1, fp);
+  }
+
+  if (ferror(fp) || (mutt_file_fsync_close(&fp) != 0) || (rename(tmpfile, file) != 0))
+  {
+    mutt_file_fclose(&fp);
+    unlink(tmpfile);
+    unlink(file); /* never leave a stale sidecar behind */
+  }
+}
+
 /**
  * nntp_expand_path - Make fully qualified url from newsgroup name
  * @param buf    Buffer for the result
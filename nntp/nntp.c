@@ -125,6 +125,7 @@ static void nntp_adata_free(void **ptr)
 
   mutt_file_fclose(&adata->fp_newsrc);
   FREE(&adata->newsrc_file);
+  FREE(&adata->newsrc_image);
   FREE(&adata->authenticators);
   FREE(&adata->overview_fmt);
   FREE(&adata->conn);
@@ -1556,6 +1557,10 @@ static int check_mailbox(struct Mailbox *m)
   if (rc2 != 0)
     nntp_active_save_cache(adata);
 
+  /* renumbering and new-article fetching can each invalidate the mailbox;
+   * merge those events so the observers recalculate once */
+  notify_begin_batch();
+
   /* articles have been renumbered, remove all headers */
   if (mdata->last_message < mdata->last_loaded)
   {
@@ -1720,6 +1725,8 @@ static int check_mailbox(struct Mailbox *m)
       rc = MUTT_NEW_MAIL;
   }
 
+  notify_end_batch();
+
 #ifdef USE_HCACHE
   mutt_hcache_close(hc);
 #endif
@@ -2847,6 +2854,7 @@ struct MxOps MxNntpOps = {
   .msg_open_new     = NULL,
   .msg_commit       = NULL,
   .msg_close        = nntp_msg_close,
+  .msg_prefetch     = NULL,
   .msg_padding_size = NULL,
   .msg_save_hcache  = NULL,
   .tags_edit        = NULL,
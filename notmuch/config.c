@@ -38,6 +38,7 @@ int   C_NmDbLimit;                    ///< Config: (notmuch) Default limit for N
 char *C_NmDefaultUrl;                 ///< Config: (notmuch) Path to the Notmuch database
 char *C_NmExcludeTags;                ///< Config: (notmuch) Exclude messages with these tags
 char *C_NmFlaggedTag;                 ///< Config: (notmuch) Tag to use for flagged messages
+int   C_NmOpenBatchSize;              ///< Config: (notmuch) Read message queries in batches of this size
 int   C_NmOpenTimeout;                ///< Config: (notmuch) Database timeout
 char *C_NmQueryType;                  ///< Config: (notmuch) Default query type: 'threads' or 'messages'
 int   C_NmQueryWindowCurrentPosition; ///< Config: (notmuch) Position of current search window
@@ -65,6 +66,9 @@ struct ConfigDef NotmuchVars[] = {
   { "nm_flagged_tag", DT_STRING, &C_NmFlaggedTag, IP "flagged", 0, NULL,
     "(notmuch) Tag to use for flagged messages"
   },
+  { "nm_open_batch_size", DT_NUMBER|DT_NOT_NEGATIVE, &C_NmOpenBatchSize, 0, 0, NULL,
+    "(notmuch) Read message queries in batches of this size"
+  },
   { "nm_open_timeout", DT_NUMBER|DT_NOT_NEGATIVE, &C_NmOpenTimeout, 5, 0, NULL,
     "(notmuch) Database timeout"
   },
@@ -294,6 +294,12 @@ void nm_db_longrun_init(struct Mailbox *m, bool writable)
     return;
 
   adata->longrun = true;
+  if (writable)
+  {
+    /* batch all the writes of the long run into one atomic section, so the
+     * database flushes once at the end instead of once per message */
+    nm_db_trans_begin(m);
+  }
   mutt_debug(LL_DEBUG2, "nm: long run initialized\n");
 }
 
@@ -307,6 +313,7 @@ void nm_db_longrun_done(struct Mailbox *m)
 
   if (adata)
   {
+    nm_db_trans_end(m); /* no-op unless longrun_init() opened a transaction */
     adata->longrun = false; /* to force nm_db_release() released DB */
     if (nm_db_release(m) == 0)
       mutt_debug(LL_DEBUG2, "nm: long run deinitialized\n");
@@ -196,6 +196,7 @@ void nm_mdata_free(void **ptr)
 
   url_free(&mdata->db_url);
   FREE(&mdata->db_query);
+  FREE(&mdata->stats_uuid);
   FREE(ptr);
 }
 
@@ -1114,17 +1115,16 @@ static notmuch_messages_t *get_messages(notmuch_query_t *query)
  * @param m     Mailbox
  * @param q     Notmuch query
  * @param dedup De-duplicate the results
+ * @param limit Maximum number of results (0 for unlimited)
  * @retval true  Success
  * @retval false Failure
  */
-static bool read_mesgs_query(struct Mailbox *m, notmuch_query_t *q, bool dedup)
+static bool read_mesgs_query(struct Mailbox *m, notmuch_query_t *q, bool dedup, int limit)
 {
   struct NmMboxData *mdata = nm_mdata_get(m);
   if (!mdata)
     return false;
 
-  int limit = get_limit(mdata);
-
   notmuch_messages_t *msgs = get_messages(q);
 
   if (!msgs)
@@ -2034,6 +2034,23 @@ static int nm_mbox_check_stats(struct Mailbox *m, int flags)
   if (!db)
     goto done;
 
+#if LIBNOTMUCH_CHECK_VERSION(4, 3, 0)
+  /* Counting is a full Xapian query per mailbox.  The database revision only
+   * moves when its contents change, so while it stands still the previous
+   * counts are still good. */
+  const char *uuid = NULL;
+  unsigned long revision = notmuch_database_get_revision(db, &uuid);
+  struct NmMboxData *mdata = nm_mdata_get(m);
+  if (!mdata && (init_mailbox(m) == 0))
+    mdata = nm_mdata_get(m);
+  if (mdata && mdata->stats_valid && (mdata->stats_revision == revision) &&
+      mutt_str_equal(mdata->stats_uuid, uuid))
+  {
+    rc = (m->msg_new > 0);
+    goto done;
+  }
+#endif
+
   /* all emails */
   m->msg_count = count_query(db, db_query, limit);
   while (m->email_max < m->msg_count)
@@ -2052,6 +2069,15 @@ static int nm_mbox_check_stats(struct Mailbox *m, int flags)
   m->msg_flagged = count_query(db, qstr, limit);
   FREE(&qstr);
 
+#if LIBNOTMUCH_CHECK_VERSION(4, 3, 0)
+  if (mdata)
+  {
+    mdata->stats_revision = revision;
+    mutt_str_replace(&mdata->stats_uuid, uuid);
+    mdata->stats_valid = true;
+  }
+#endif
+
   rc = (m->msg_new > 0);
 done:
   if (db)
@@ -2227,9 +2253,20 @@ static int nm_mbox_open(struct Mailbox *m)
     switch (mdata->query_type)
     {
       case NM_QUERY_TYPE_MESGS:
-        if (!read_mesgs_query(m, q, false))
+      {
+        int limit = get_limit(mdata);
+        if ((C_NmOpenBatchSize > 0) && ((limit == 0) || (C_NmOpenBatchSize < limit)))
+        {
+          /* read just the first batch now; nm_mbox_check() pulls in the rest */
+          limit = C_NmOpenBatchSize;
+          mdata->open_partial = true;
+        }
+        if (!read_mesgs_query(m, q, false, limit))
           rc = -2;
+        if (m->msg_count < limit)
+          mdata->open_partial = false; /* the query is already exhausted */
         break;
+      }
       case NM_QUERY_TYPE_THREADS:
         if (!read_threads_query(m, q, false, get_limit(mdata)))
           rc = -2;
@@ -2249,6 +2286,63 @@ static int nm_mbox_open(struct Mailbox *m)
   return rc;
 }
 
+/**
+ * mbox_check_continue - Read the next batch of a partially-open query
+ * @param m     Mailbox
+ * @param mdata Notmuch Mailbox data
+ * @retval -1 Error
+ * @retval  0 Success
+ * @retval #MUTT_NEW_MAIL More messages were loaded
+ *
+ * When `$nm_open_batch_size` is set, nm_mbox_open() only reads the first
+ * batch of results.  The index calls MxOps::mbox_check() on every pass of
+ * its event loop, so each pass appends one more batch here (the query is
+ * re-run and already-loaded messages are skipped by message-id) until the
+ * query is exhausted or `$nm_db_limit` is reached.
+ */
+static int mbox_check_continue(struct Mailbox *m, struct NmMboxData *mdata)
+{
+  int rc = 0;
+  const int oldmsgcount = m->msg_count;
+
+  notmuch_query_t *q = get_query(m, false);
+  if (!q)
+  {
+    mdata->open_partial = false;
+    return -1;
+  }
+
+  int limit = oldmsgcount + C_NmOpenBatchSize;
+  const int db_limit = get_limit(mdata);
+  if ((db_limit != 0) && (limit > db_limit))
+    limit = db_limit;
+
+  mdata->noprogress = true;
+  if (!read_mesgs_query(m, q, true, limit))
+    rc = -1;
+  if ((m->msg_count == oldmsgcount) || (m->msg_count < limit) ||
+      ((db_limit != 0) && (m->msg_count >= db_limit)))
+  {
+    mdata->open_partial = false;
+  }
+
+  notmuch_query_destroy(q);
+  nm_db_release(m);
+
+  m->mtime.tv_sec = mutt_date_epoch();
+  m->mtime.tv_nsec = 0;
+
+  if (m->msg_count > oldmsgcount)
+  {
+    mailbox_changed(m, NT_MAILBOX_INVALID);
+    rc = MUTT_NEW_MAIL;
+  }
+
+  mutt_debug(LL_DEBUG1, "nm: batch loaded [count=%d, done=%d]\n", m->msg_count,
+             !mdata->open_partial);
+  return rc;
+}
+
 /**
  * nm_mbox_check - Check for new mail - Implements MxOps::mbox_check()
  * @param m           Mailbox
@@ -2265,6 +2359,10 @@ static int nm_mbox_check(struct Mailbox *m)
   if (!mdata || (nm_db_get_mtime(m, &mtime) != 0))
     return -1;
 
+  /* finish a batched open before looking for external changes */
+  if (mdata->open_partial)
+    return mbox_check_continue(m, mdata);
+
   int new_flags = 0;
   bool occult = false;
 
@@ -2593,11 +2691,20 @@ static int nm_tags_commit(struct Mailbox *m, struct Email *e, char *buf)
 
   mutt_debug(LL_DEBUG1, "nm: tags modify: '%s'\n", buf);
 
+  /* during a longrun (tag-prefix operation) the transaction is held open by
+   * nm_db_longrun_init(), so all the edits commit as one atomic batch */
+  int trans = nm_db_trans_begin(m);
+  if (trans < 0)
+    goto done;
+
   update_tags(msg, buf);
   update_email_flags(m, e, buf);
   update_email_tags(e, msg);
   mutt_set_header_color(m, e);
 
+  if (trans == 1)
+    nm_db_trans_end(m);
+
   rc = 0;
   e->changed = true;
 done:
@@ -2668,6 +2775,7 @@ struct MxOps MxNotmuchOps = {
   .msg_open_new     = maildir_msg_open_new,
   .msg_commit       = nm_msg_commit,
   .msg_close        = nm_msg_close,
+  .msg_prefetch     = NULL,
   .msg_padding_size = NULL,
   .msg_save_hcache  = NULL,
   .tags_edit        = nm_tags_edit,
@@ -77,8 +77,13 @@ struct NmMboxData
   int oldmsgcount;
   int ignmsgcount; ///< Ignored messages
 
+  unsigned long stats_revision; ///< Database revision the cached stats were computed at
+  char *stats_uuid;             ///< Database UUID belonging to stats_revision
+
   bool noprogress : 1;     ///< Don't show the progress bar
   bool progress_ready : 1; ///< A progress bar has been initialised
+  bool open_partial : 1;   ///< Opened with `$nm_open_batch_size`; more results pending
+  bool stats_valid : 1;    ///< Mailbox counts are current for stats_revision
 };
 
 /**
@@ -96,6 +101,7 @@ extern int   C_NmDbLimit;
 extern char *C_NmDefaultUrl;
 extern char *C_NmExcludeTags;
 extern char *C_NmFlaggedTag;
+extern int   C_NmOpenBatchSize;
 extern int   C_NmOpenTimeout;
 extern char *C_NmQueryType;
 extern int   C_NmQueryWindowCurrentPosition;
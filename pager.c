@@ -140,6 +140,8 @@ struct Line
   struct TextSyntax *syntax;
   struct TextSyntax *search;
   struct QClass *quote;
+  short quote_so;           ///< start of the $quote_regex match, if quoted
+  short quote_eo;           ///< end of the $quote_regex match; 0 if unknown
   unsigned int is_cont_hdr; ///< this line is a continuation of the previous header line
 };
 
@@ -349,26 +351,6 @@ static int check_sig(const char *s, struct Line *info, int n)
   return 0;
 }
 
-/**
- * comp_syntax_t - Search for a Syntax using bsearch
- * @param m1 Search key
- * @param m2 Array member
- * @retval -1 m1 precedes m2
- * @retval  0 m1 matches m2
- * @retval  1 m2 precedes m1
- */
-static int comp_syntax_t(const void *m1, const void *m2)
-{
-  const int *cnt = (const int *) m1;
-  const struct TextSyntax *stx = (const struct TextSyntax *) m2;
-
-  if (*cnt < stx->first)
-    return -1;
-  if (*cnt >= stx->last)
-    return 1;
-  return 0;
-}
-
 /**
  * resolve_color - Set the colour for a line of text
  * @param line_info Line info array
@@ -381,15 +363,20 @@ static int comp_syntax_t(const void *m1, const void *m2)
 static void resolve_color(struct Line *line_info, int n, int cnt,
                           PagerFlags flags, int special, struct AnsiAttr *a)
 {
-  int def_color;         /* color without syntax highlight */
-  int color;             /* final color */
-  static int last_color; /* last color set */
+  int def_color;          /* color without syntax highlight */
+  int color;              /* final color */
+  static int last_color;  /* last color set */
+  static int syntax_next; /* cursor into the syntax chunks, see below */
+  static int search_next; /* cursor into the search chunks */
   bool search = false;
   int m;
-  struct TextSyntax *matching_chunk = NULL;
 
   if (cnt == 0)
+  {
     last_color = -1; /* force attrset() */
+    syntax_next = 0;
+    search_next = 0;
+  }
 
   if (line_info[n].continuation)
   {
@@ -431,24 +418,35 @@ static void resolve_color(struct Line *line_info, int n, int cnt,
     }
   }
 
+  /* We're called for every displayed character with a monotonic cnt, so walk
+   * the sorted chunk arrays forward instead of bsearching per character.
+   * The cursors reset with cnt at the start of each row. */
   color = def_color;
   if ((flags & MUTT_SHOWCOLOR) && line_info[m].chunks)
   {
-    matching_chunk = bsearch(&cnt, line_info[m].syntax, line_info[m].chunks,
-                             sizeof(struct TextSyntax), comp_syntax_t);
-    if (matching_chunk && (cnt >= matching_chunk->first) &&
-        (cnt < matching_chunk->last))
+    while ((syntax_next < line_info[m].chunks) &&
+           (cnt >= (line_info[m].syntax)[syntax_next].last))
+    {
+      syntax_next++;
+    }
+    if ((syntax_next < line_info[m].chunks) &&
+        (cnt >= (line_info[m].syntax)[syntax_next].first) &&
+        (cnt < (line_info[m].syntax)[syntax_next].last))
     {
-      color = matching_chunk->color;
+      color = (line_info[m].syntax)[syntax_next].color;
     }
   }
 
   if ((flags & MUTT_SEARCH) && line_info[m].search_cnt)
   {
-    matching_chunk = bsearch(&cnt, line_info[m].search, line_info[m].search_cnt,
-                             sizeof(struct TextSyntax), comp_syntax_t);
-    if (matching_chunk && (cnt >= matching_chunk->first) &&
-        (cnt < matching_chunk->last))
+    while ((search_next < line_info[m].search_cnt) &&
+           (cnt >= (line_info[m].search)[search_next].last))
+    {
+      search_next++;
+    }
+    if ((search_next < line_info[m].search_cnt) &&
+        (cnt >= (line_info[m].search)[search_next].first) &&
+        (cnt < (line_info[m].search)[search_next].last))
     {
       color = Colors->defs[MT_COLOR_SEARCH];
       search = 1;
@@ -600,6 +598,100 @@ static void cleanup_quote(struct QClass **quote_list)
   }
 }
 
+/**
+ * struct FlowCacheLine - Cached classification of one logical pager line
+ *
+ * The line type, quote class and highlight chunks depend only on the text,
+ * not on the window width.  When the pager reflows (e.g. on SIGWINCH) we
+ * save them here, keyed by file offset, so the rewrap doesn't have to
+ * re-run $quote_regex and the color regexes over the whole message.
+ */
+struct FlowCacheLine
+{
+  LOFF_T offset;             ///< Offset of the line in the source file
+  short type;                ///< Line colour type, e.g. #MT_COLOR_QUOTED
+  short chunks;              ///< Number of highlight chunks
+  unsigned int is_cont_hdr;  ///< This line is a continuation header
+  short quote_so;            ///< Start of the $quote_regex match
+  short quote_eo;            ///< End of the $quote_regex match
+  struct TextSyntax *syntax; ///< Copy of the highlighting info
+  struct QClass *quote;      ///< Quote class, owned by the pager's quote list
+};
+
+static struct FlowCacheLine *FlowCache = NULL;
+static int FlowCacheLen = 0;
+
+/**
+ * flow_cache_free - Forget the cached line classification
+ */
+static void flow_cache_free(void)
+{
+  for (int i = 0; i < FlowCacheLen; i++)
+    FREE(&FlowCache[i].syntax);
+  FREE(&FlowCache);
+  FlowCacheLen = 0;
+}
+
+/**
+ * flow_cache_save - Remember the classification of the scanned lines
+ * @param line_info Line info array
+ * @param last      Number of used entries in line_info
+ *
+ * Display continuations are skipped: a logical line keeps its file offset
+ * however the window is resized, so the offset identifies it afterwards.
+ */
+static void flow_cache_save(struct Line *line_info, int last)
+{
+  flow_cache_free();
+  if (last <= 0)
+    return;
+
+  FlowCache = mutt_mem_calloc(last, sizeof(struct FlowCacheLine));
+  for (int i = 0; i < last; i++)
+  {
+    if (line_info[i].continuation || (line_info[i].type == -1))
+      continue;
+
+    struct FlowCacheLine *fcl = &FlowCache[FlowCacheLen++];
+    fcl->offset = line_info[i].offset;
+    fcl->type = line_info[i].type;
+    fcl->chunks = line_info[i].chunks;
+    fcl->is_cont_hdr = line_info[i].is_cont_hdr;
+    fcl->quote_so = line_info[i].quote_so;
+    fcl->quote_eo = line_info[i].quote_eo;
+    fcl->quote = line_info[i].quote;
+
+    const size_t num = MAX(1, line_info[i].chunks);
+    fcl->syntax = mutt_mem_malloc(num * sizeof(struct TextSyntax));
+    memcpy(fcl->syntax, line_info[i].syntax, num * sizeof(struct TextSyntax));
+  }
+}
+
+/**
+ * flow_cache_find - Look up a line's cached classification
+ * @param offset Offset of the line in the source file
+ * @retval ptr  Cached classification
+ * @retval NULL Line isn't in the cache
+ */
+static struct FlowCacheLine *flow_cache_find(LOFF_T offset)
+{
+  int lo = 0;
+  int hi = FlowCacheLen - 1;
+
+  while (lo <= hi)
+  {
+    const int mid = lo + (hi - lo) / 2;
+    if (FlowCache[mid].offset == offset)
+      return &FlowCache[mid];
+    if (FlowCache[mid].offset < offset)
+      lo = mid + 1;
+    else
+      hi = mid - 1;
+  }
+
+  return NULL;
+}
+
 /**
  * classify_quote - Find a style for a string
  * @param[out] quote_list   List of quote colours
@@ -1047,7 +1139,8 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
       {
         STAILQ_FOREACH(color_line, &Colors->hdr_list, entries)
         {
-          if (regexec(&color_line->regex, buf, 0, NULL, 0) == 0)
+          regex_t *re = mutt_color_line_regex(color_line);
+          if (re && (regexec(re, buf, 0, NULL, 0) == 0))
           {
             line_info[n].type = MT_COLOR_HEADER;
             line_info[n].syntax[0].color = color_line->pair;
@@ -1108,6 +1201,13 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
                                           force_redraw, q_level);
     }
     line_info[n].type = MT_COLOR_QUOTED;
+    /* remember the prefix bounds - classifying the quote level later
+     * mustn't have to run $quote_regex over the line again */
+    if (pmatch[0].rm_eo <= SHRT_MAX)
+    {
+      line_info[n].quote_so = pmatch[0].rm_so;
+      line_info[n].quote_eo = pmatch[0].rm_eo;
+    }
   }
   else
     line_info[n].type = MT_COLOR_NORMAL;
@@ -1144,9 +1244,11 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
       null_rx = false;
       STAILQ_FOREACH(color_line, head, entries)
       {
-        if (!color_line->stop_matching &&
-            (regexec(&color_line->regex, buf + offset, 1, pmatch,
-                     ((offset != 0) ? REG_NOTBOL : 0)) == 0))
+        regex_t *re = NULL;
+        if (!color_line->stop_matching)
+          re = mutt_color_line_regex(color_line);
+        if (re && (regexec(re, buf + offset, 1, pmatch,
+                           ((offset != 0) ? REG_NOTBOL : 0)) == 0))
         {
           if (pmatch[0].rm_eo != pmatch[0].rm_so)
           {
@@ -1222,8 +1324,9 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
       null_rx = false;
       STAILQ_FOREACH(color_line, &Colors->attach_list, entries)
       {
-        if (regexec(&color_line->regex, buf + offset, 1, pmatch,
-                    ((offset != 0) ? REG_NOTBOL : 0)) == 0)
+        regex_t *re = mutt_color_line_regex(color_line);
+        if (re && (regexec(re, buf + offset, 1, pmatch,
+                           ((offset != 0) ? REG_NOTBOL : 0)) == 0))
         {
           if (pmatch[0].rm_eo != pmatch[0].rm_so)
           {
@@ -1438,7 +1541,7 @@ static int fill_buffer(FILE *fp, LOFF_T *last_pos, LOFF_T offset, unsigned char
                        unsigned char **fmt, size_t *blen, int *buf_ready)
 {
   static int b_read;
-  struct Buffer stripped;
+  static struct Buffer stripped = { 0 };
 
   if (*buf_ready == 0)
   {
@@ -1456,11 +1559,10 @@ static int fill_buffer(FILE *fp, LOFF_T *last_pos, LOFF_T offset, unsigned char
     b_read = (int) (*last_pos - offset);
     *buf_ready = 1;
 
-    mutt_buffer_init(&stripped);
+    /* The stripped Buffer is persistent, so scanning a huge message doesn't
+     * pay an allocation per line - *fmt just points into it. */
     mutt_buffer_alloc(&stripped, *blen);
     mutt_buffer_strip_formatting(&stripped, (const char *) *buf, 1);
-    /* This should be a noop, because *fmt should be NULL */
-    FREE(fmt);
     *fmt = (unsigned char *) stripped.data;
   }
 
@@ -1680,8 +1782,11 @@ static int display_line(FILE *fp, LOFF_T *last_pos, struct Line **line_info,
                         struct QClass **quote_list, int *q_level, bool *force_redraw,
                         regex_t *search_re, struct MuttWindow *win_pager)
 {
-  unsigned char *buf = NULL, *fmt = NULL;
-  size_t buflen = 0;
+  /* Persistent between calls - one pass over a 100MB attachment would
+   * otherwise malloc/free these once per line */
+  static unsigned char *buf = NULL;
+  static size_t buflen = 0;
+  unsigned char *fmt = NULL;
   unsigned char *buf_ptr = NULL;
   int ch, vch, col, cnt, b_read;
   int buf_ready = 0;
@@ -1750,8 +1855,25 @@ static int display_line(FILE *fp, LOFF_T *last_pos, struct Line **line_info,
         goto out;
       }
 
-      resolve_types((char *) fmt, (char *) buf, *line_info, n, *last,
-                    quote_list, q_level, force_redraw, flags & MUTT_SHOWCOLOR);
+      struct FlowCacheLine *fcl = flow_cache_find(curr_line->offset);
+      if (fcl)
+      {
+        /* reflowing - the text hasn't changed, only the wrapping has */
+        curr_line->type = fcl->type;
+        curr_line->quote = fcl->quote;
+        curr_line->is_cont_hdr = fcl->is_cont_hdr;
+        curr_line->quote_so = fcl->quote_so;
+        curr_line->quote_eo = fcl->quote_eo;
+        curr_line->chunks = fcl->chunks;
+        const size_t num = MAX(1, fcl->chunks);
+        mutt_mem_realloc(&curr_line->syntax, num * sizeof(struct TextSyntax));
+        memcpy(curr_line->syntax, fcl->syntax, num * sizeof(struct TextSyntax));
+      }
+      else
+      {
+        resolve_types((char *) fmt, (char *) buf, *line_info, n, *last, quote_list,
+                      q_level, force_redraw, flags & MUTT_SHOWCOLOR);
+      }
 
       /* avoid race condition for continuation lines when scrolling up */
       for (m = n + 1; m < *last && (*line_info)[m].offset && (*line_info)[m].continuation; m++)
@@ -1781,7 +1903,14 @@ static int display_line(FILE *fp, LOFF_T *last_pos, struct Line **line_info,
       goto out;
     }
 
-    if (mutt_regex_capture(C_QuoteRegex, (char *) fmt, 1, pmatch))
+    if ((curr_line->quote_eo > 0) && (curr_line->quote_so >= 0))
+    {
+      /* resolve_types() recorded where $quote_regex matched */
+      curr_line->quote = classify_quote(quote_list, (char *) fmt + curr_line->quote_so,
+                                        curr_line->quote_eo - curr_line->quote_so,
+                                        force_redraw, q_level);
+    }
+    else if (mutt_regex_capture(C_QuoteRegex, (char *) fmt, 1, pmatch))
     {
       curr_line->quote =
           classify_quote(quote_list, (char *) fmt + pmatch[0].rm_so,
@@ -1944,8 +2073,6 @@ static int display_line(FILE *fp, LOFF_T *last_pos, struct Line **line_info,
   rc = flags;
 
 out:
-  FREE(&buf);
-  FREE(&fmt);
   return rc;
 }
 
@@ -2066,6 +2193,9 @@ static void pager_custom_redraw(struct Menu *pager_menu)
   {
     if (!(rd->flags & MUTT_PAGER_RETWINCH))
     {
+      /* keep the classification of the logical lines; rewrapping to the
+       * new width will reuse it instead of re-running the regexes */
+      flow_cache_save(rd->line_info, rd->last_line);
       rd->lines = -1;
       for (int i = 0; i <= rd->topline; i++)
         if (!rd->line_info[i].continuation)
@@ -2078,6 +2208,8 @@ static void pager_custom_redraw(struct Menu *pager_menu)
         rd->line_info[i].chunks = 0;
         rd->line_info[i].search_cnt = -1;
         rd->line_info[i].quote = NULL;
+        rd->line_info[i].quote_so = 0;
+        rd->line_info[i].quote_eo = 0;
 
         mutt_mem_realloc(&(rd->line_info[i].syntax), sizeof(struct TextSyntax));
         if (rd->search_compiled && rd->line_info[i].search)
@@ -2303,6 +2435,8 @@ int mutt_pager(const char *banner, const char *fname, PagerFlags flags, struct P
     mutt_set_flag(m, extra->email, MUTT_READ, true);
   }
 
+  flow_cache_free(); /* quote classes from a previous message are gone */
+
   rd.max_line = LINES; /* number of lines on screen, from curses */
   rd.line_info = mutt_mem_calloc(rd.max_line, sizeof(struct Line));
   for (size_t i = 0; i < rd.max_line; i++)
@@ -3114,6 +3248,9 @@ int mutt_pager(const char *banner, const char *fname, PagerFlags flags, struct P
         window_set_focus(rd.extra->win_pager);
         pager_menu->redraw = REDRAW_FULL;
 
+        /* $quote_regex or the colours may have changed */
+        flow_cache_free();
+
         if (OptNeedResort)
         {
           OptNeedResort = false;
@@ -3588,6 +3725,7 @@ int mutt_pager(const char *banner, const char *fname, PagerFlags flags, struct P
     }
   }
 
+  flow_cache_free();
   cleanup_quote(&rd.quote_list);
 
   for (size_t i = 0; i < rd.max_line; i++)
@@ -73,6 +73,142 @@ enum EatRangeError
 #define KILO 1024
 #define MEGA 1048576
 
+/**
+ * regex_required_literal - Find a literal that every regex match must contain
+ * @param s     Regular expression (POSIX extended syntax)
+ * @param icase Pattern will be compiled with REG_ICASE
+ * @retval ptr  Longest required literal of 3 bytes or more
+ * @retval NULL No usable literal
+ *
+ * Used as a cheap prefilter in patmatch(): if the literal isn't in the
+ * candidate line, the regex can't match and regexec() is skipped entirely.
+ * The scan is deliberately conservative - any construct that could make a
+ * literal optional (alternation, an escape, a group, a zero-minimum
+ * quantifier) either drops the affected characters or gives up.
+ */
+static char *regex_required_literal(const char *s, bool icase)
+{
+  char run[256];
+  char best[256];
+  size_t run_len = 0;
+  size_t best_len = 0;
+
+  for (const char *p = s; *p; p++)
+  {
+    switch (*p)
+    {
+      case '|': /* any branch may match - nothing is required */
+        return NULL;
+
+      case '\\': /* conservatively exclude the escaped character */
+        if (p[1])
+          p++;
+        break;
+
+      case '[': /* bracket expression - skip it entirely */
+        p++;
+        if (*p == '^')
+          p++;
+        if (*p == ']')
+          p++;
+        while (*p && (*p != ']'))
+        {
+          if ((p[0] == '[') && ((p[1] == ':') || (p[1] == '=') || (p[1] == '.')))
+          {
+            /* [:class:], [=equiv=], [.coll.] - they contain a ']' */
+            const char delim = p[1];
+            p += 2;
+            while (*p && !((p[0] == delim) && (p[1] == ']')))
+              p++;
+            if (*p == '\0')
+              return NULL; /* malformed */
+            p += 2;
+          }
+          else
+            p++;
+        }
+        if (*p == '\0')
+          return NULL; /* malformed */
+        break;
+
+      case '(': /* skip the whole group - its content may be optional */
+      {
+        int depth = 1;
+        for (p++; *p && (depth != 0); p++)
+        {
+          if ((p[0] == '\\') && p[1])
+            p++;
+          else if (*p == '(')
+            depth++;
+          else if (*p == ')')
+            depth--;
+        }
+        if (depth != 0)
+          return NULL; /* malformed */
+        p--; /* the outer loop increments again */
+        break;
+      }
+
+      case ')':
+      case '.':
+      case '^':
+      case '$':
+        break;
+
+      case '*':
+      case '?': /* the previous character is optional */
+        if (run_len != 0)
+        {
+          if (((unsigned char) run[run_len - 1]) & 0x80)
+            return NULL; /* dropping one byte would split a multibyte character */
+          run_len--;
+        }
+        break;
+
+      case '{': /* treat any interval like '?' and skip to the '}' */
+        if (run_len != 0)
+        {
+          if (((unsigned char) run[run_len - 1]) & 0x80)
+            return NULL; /* dropping one byte would split a multibyte character */
+          run_len--;
+        }
+        while (*p && (*p != '}'))
+          p++;
+        if (*p == '\0')
+          return NULL; /* malformed */
+        break;
+
+      case '+': /* the previous character remains required */
+        break;
+
+      default:
+        if (icase && (((unsigned char) *p) & 0x80))
+          return NULL; /* strcasestr() can't case-fold multibyte characters */
+        if (run_len < sizeof(run))
+          run[run_len++] = *p;
+        continue; /* the run isn't broken - don't flush it */
+    }
+
+    if (run_len > best_len)
+    {
+      memcpy(best, run, run_len);
+      best_len = run_len;
+    }
+    run_len = 0;
+  }
+
+  if (run_len > best_len)
+  {
+    memcpy(best, run, run_len);
+    best_len = run_len;
+  }
+
+  if (best_len < 3)
+    return NULL; /* too short to be worth a scan */
+
+  return mutt_strn_dup(best, best_len);
+}
+
 /**
  * eat_regex - Parse a regex - Implements ::eat_arg_t
  */
@@ -108,19 +244,37 @@ static bool eat_regex(struct Pattern *pat, int flags, struct Buffer *s, struct B
   }
   else
   {
-    pat->p.regex = mutt_mem_malloc(sizeof(regex_t));
-    int case_flags = mutt_mb_is_lower(buf.data) ? REG_ICASE : 0;
-    int rc = REG_COMP(pat->p.regex, buf.data, REG_NEWLINE | REG_NOSUB | case_flags);
-    if (rc != 0)
+    const bool is_icase = mutt_mb_is_lower(buf.data);
+
+    /* A pattern with no regex specials is a plain substring - match it with
+     * strstr() instead of regexec().  Lower-case non-ASCII patterns keep the
+     * regex path: REG_ICASE folds multibyte characters, strcasestr() can't. */
+    if ((buf.data[strcspn(buf.data, "^$.[]()|*+?{\\")] == '\0') &&
+        (!is_icase || mutt_str_is_ascii(buf.data, mutt_str_len(buf.data))))
     {
-      char errmsg[256];
-      regerror(rc, pat->p.regex, errmsg, sizeof(errmsg));
-      mutt_buffer_add_printf(err, "'%s': %s", buf.data, errmsg);
+      pat->string_match = true;
+      pat->p.str = mutt_str_dup(buf.data);
+      pat->ign_case = is_icase;
+      FREE(&buf.data);
+    }
+    else
+    {
+      pat->p.regex = mutt_mem_malloc(sizeof(regex_t));
+      int case_flags = is_icase ? REG_ICASE : 0;
+      int rc = REG_COMP(pat->p.regex, buf.data, REG_NEWLINE | REG_NOSUB | case_flags);
+      if (rc != 0)
+      {
+        char errmsg[256];
+        regerror(rc, pat->p.regex, errmsg, sizeof(errmsg));
+        mutt_buffer_add_printf(err, "'%s': %s", buf.data, errmsg);
+        FREE(&buf.data);
+        FREE(&pat->p.regex);
+        return false;
+      }
+      pat->ign_case = is_icase;
+      pat->prefilter = regex_required_literal(buf.data, is_icase);
       FREE(&buf.data);
-      FREE(&pat->p.regex);
-      return false;
     }
-    FREE(&buf.data);
   }
 
   return true;
@@ -1023,6 +1177,7 @@ void mutt_pattern_free(struct PatternList **pat)
       regfree(np->p.regex);
       FREE(&np->p.regex);
     }
+    FREE(&np->prefilter);
 
     mutt_pattern_free(&np->child);
     FREE(&np);
@@ -1033,6 +1188,146 @@ void mutt_pattern_free(struct PatternList **pat)
   FREE(pat);
 }
 
+/**
+ * pattern_needs_msg - Does a Pattern require the message to be opened?
+ * @param pat Pattern to check
+ * @retval true The Pattern (or one of its children) reads the message itself
+ *
+ * Most patterns are pure functions of the in-memory Email, but a few (~b, ~h,
+ * ~B, ~X, ~Y) have to open, and possibly decode, the message.
+ */
+static bool pattern_needs_msg(const struct Pattern *pat)
+{
+  switch (pat->op)
+  {
+    case MUTT_PAT_BODY:
+    case MUTT_PAT_HEADER:
+    case MUTT_PAT_WHOLE_MSG:
+    case MUTT_PAT_MIMEATTACH:
+    case MUTT_PAT_MIMETYPE:
+      return true;
+    default:
+      break;
+  }
+
+  if (pat->child)
+  {
+    struct Pattern *p = NULL;
+    SLIST_FOREACH(p, pat->child, entries)
+    {
+      if (pattern_needs_msg(p))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * pattern_hoist_cheap - Evaluate cheap Patterns before expensive ones
+ * @param pats Patterns to reorder
+ *
+ * Both perform_and() and perform_or() short-circuit, so within each group of
+ * siblings the patterns that only look at the in-memory Email should run
+ * before those that have to open the message.  '~B bar ~f foo' then only
+ * opens the messages that matched '~f foo', no matter how the user ordered
+ * the terms.  The partition is stable and doesn't change what matches, as
+ * patterns have no user-visible side effects.
+ */
+static void pattern_hoist_cheap(struct PatternList *pats)
+{
+  struct PatternList cheap = SLIST_HEAD_INITIALIZER(cheap);
+  struct PatternList costly = SLIST_HEAD_INITIALIZER(costly);
+  struct Pattern *cheap_last = NULL, *costly_last = NULL;
+  struct Pattern *pat = NULL;
+
+  while ((pat = SLIST_FIRST(pats)))
+  {
+    SLIST_REMOVE_HEAD(pats, entries);
+    SLIST_NEXT(pat, entries) = NULL;
+
+    if (pat->child)
+      pattern_hoist_cheap(pat->child);
+
+    if (pattern_needs_msg(pat))
+    {
+      if (costly_last)
+        SLIST_INSERT_AFTER(costly_last, pat, entries);
+      else
+        SLIST_INSERT_HEAD(&costly, pat, entries);
+      costly_last = pat;
+    }
+    else
+    {
+      if (cheap_last)
+        SLIST_INSERT_AFTER(cheap_last, pat, entries);
+      else
+        SLIST_INSERT_HEAD(&cheap, pat, entries);
+      cheap_last = pat;
+    }
+  }
+
+  /* put the cheap patterns back first, then the costly ones */
+  SLIST_FIRST(pats) = SLIST_FIRST(&cheap);
+  if (cheap_last)
+    SLIST_NEXT(cheap_last, entries) = SLIST_FIRST(&costly);
+  else
+    SLIST_FIRST(pats) = SLIST_FIRST(&costly);
+}
+
+/**
+ * pattern_flatten - Simplify nested AND/OR Patterns
+ * @param pats Patterns to simplify
+ * @param op   Operation combining @a pats, e.g. #MUTT_PAT_AND (0 for the root)
+ *
+ * Execution recurses through perform_and()/perform_or() for every email, so
+ * the flatter the tree, the cheaper each evaluation.  Two rewrites preserve
+ * the meaning exactly:
+ * - an un-negated AND below an AND (or OR below an OR) is spliced into its
+ *   parent's list: AND(AND(a,b),c) becomes AND(a,b,c)
+ * - an AND/OR with a single child is replaced by that child, folding any
+ *   negation into it
+ */
+static void pattern_flatten(struct PatternList *pats, short op)
+{
+  struct Pattern *prev = NULL;
+  struct Pattern *pat = SLIST_FIRST(pats);
+
+  while (pat)
+  {
+    if (pat->child)
+      pattern_flatten(pat->child, pat->op);
+
+    if (((pat->op == MUTT_PAT_AND) || (pat->op == MUTT_PAT_OR)) && pat->child)
+    {
+      struct Pattern *first = SLIST_FIRST(pat->child);
+      const bool only_child = first && !SLIST_NEXT(first, entries);
+
+      if (((pat->op == op) && !pat->pat_not) || only_child)
+      {
+        /* splice the children into our list in place of pat */
+        if (only_child)
+          first->pat_not ^= pat->pat_not;
+        struct Pattern *last = first;
+        while (SLIST_NEXT(last, entries))
+          last = SLIST_NEXT(last, entries);
+        SLIST_NEXT(last, entries) = SLIST_NEXT(pat, entries);
+        if (prev)
+          SLIST_NEXT(prev, entries) = first;
+        else
+          SLIST_FIRST(pats) = first;
+        FREE(&pat->child);
+        FREE(&pat);
+        pat = first;
+        continue;
+      }
+    }
+
+    prev = pat;
+    pat = SLIST_NEXT(pat, entries);
+  }
+}
+
 /**
  * mutt_pattern_node_new - Create a new list containing a Pattern
  * @retval ptr Newly created list containing a single node with a Pattern
@@ -1324,6 +1619,9 @@ struct PatternList *mutt_pattern_comp(const char *s, PatternCompFlags flags, str
     curlist = tmp;
   }
 
+  pattern_flatten(curlist, 0);
+  pattern_hoist_cheap(curlist);
+
   return curlist;
 
 cleanup:
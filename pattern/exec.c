@@ -51,9 +51,13 @@
 #include "handler.h"
 #include "maillist.h"
 #include "mutt_parse.h"
+#include "mutt_thread.h"
 #include "muttlib.h"
 #include "mx.h"
 #include "state.h"
+#ifdef USE_HCACHE
+#include "hcache/fts.h"
+#endif
 
 /**
  * patmatch - Compare a string to a Pattern
@@ -70,6 +74,13 @@ static bool patmatch(const struct Pattern *pat, const char *buf)
     return pat->ign_case ? strcasestr(buf, pat->p.str) : strstr(buf, pat->p.str);
   if (pat->group_match)
     return mutt_group_match(pat->p.group, buf);
+  /* Sieve with the regex's required literal first - strstr() is far cheaper
+   * than regexec() on the lines that can't match anyway */
+  if (pat->prefilter &&
+      !(pat->ign_case ? strcasestr(buf, pat->prefilter) : strstr(buf, pat->prefilter)))
+  {
+    return false;
+  }
   return (regexec(pat->p.regex, buf, 0, NULL, 0) == 0);
 }
 
@@ -106,6 +117,17 @@ static void print_crypt_pattern_op_error(int op)
 static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
 {
   bool match = false;
+  struct Email *e = m->emails[msgno];
+
+#ifdef USE_HCACHE
+  /* A cached body digest may prove the message can't match */
+  if (C_ThoroughSearch && pat->string_match && (pat->op == MUTT_PAT_BODY) &&
+      (mutt_fts_check(e, pat->p.str) == FTS_NO_MATCH))
+  {
+    return false;
+  }
+#endif
+
   struct Message *msg = mx_msg_open(m, msgno);
   if (!msg)
   {
@@ -114,7 +136,6 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
 
   FILE *fp = NULL;
   long len = 0;
-  struct Email *e = m->emails[msgno];
 #ifdef USE_FMEMOPEN
   char *temp = NULL;
   size_t tempsize = 0;
@@ -128,12 +149,39 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
     struct State s = { 0 };
     s.fp_in = msg->fp;
     s.flags = MUTT_CHARCONV;
+    bool have_cached = false;
 #ifdef USE_FMEMOPEN
-    s.fp_out = open_memstream(&temp, &tempsize);
-    if (!s.fp_out)
+    /* The pager may have decoded this message already - check the cache.
+     * Bit 16 separates "search decoded header+body" keys from the copy
+     * flag space used by mutt_copy_message_cached(). */
+    unsigned int dcflags = (1U << 16);
+    if (pat->op != MUTT_PAT_BODY)
+      dcflags |= 1;
+    if (pat->op != MUTT_PAT_HEADER)
+      dcflags |= 2;
+    struct Buffer *dckey = mutt_buffer_pool_get();
+    mutt_decode_cache_key(dckey, m, e, dcflags);
+    size_t dclen = 0;
+    const char *dcdata = mutt_decode_cache_peek(mutt_b2s(dckey), &dclen);
+    if (dcdata)
     {
-      mutt_perror(_("Error opening 'memory stream'"));
-      return false;
+      /* The in-place matcher below pokes temporary NULs into the buffer,
+       * so it needs a private copy */
+      temp = mutt_mem_malloc(dclen + 1);
+      memcpy(temp, dcdata, dclen);
+      temp[dclen] = '\0';
+      tempsize = dclen;
+      have_cached = true;
+    }
+    else
+    {
+      s.fp_out = open_memstream(&temp, &tempsize);
+      if (!s.fp_out)
+      {
+        mutt_buffer_pool_release(&dckey);
+        mutt_perror(_("Error opening 'memory stream'"));
+        return false;
+      }
     }
 #else
     s.fp_out = mutt_file_mkstemp();
@@ -144,10 +192,10 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
     }
 #endif
 
-    if (pat->op != MUTT_PAT_BODY)
+    if (!have_cached && (pat->op != MUTT_PAT_BODY))
       mutt_copy_header(msg->fp, e, s.fp_out, CH_FROM | CH_DECODE, NULL, 0);
 
-    if (pat->op != MUTT_PAT_HEADER)
+    if (!have_cached && (pat->op != MUTT_PAT_HEADER))
     {
       mutt_parse_mime_message(m, e);
 
@@ -162,6 +210,9 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
           FREE(&temp);
 #endif
         }
+#ifdef USE_FMEMOPEN
+        mutt_buffer_pool_release(&dckey);
+#endif
         return false;
       }
 
@@ -170,7 +221,51 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
     }
 
 #ifdef USE_FMEMOPEN
-    mutt_file_fclose(&s.fp_out);
+    if (!have_cached)
+    {
+      mutt_file_fclose(&s.fp_out);
+      /* Remember the decoded text, but never decrypted text */
+      if (!((WithCrypto != 0) && (e->security & SEC_ENCRYPT)))
+        mutt_decode_cache_store(mutt_b2s(dckey), temp, tempsize);
+    }
+    mutt_buffer_pool_release(&dckey);
+
+    if (pat->op != MUTT_PAT_HEADER)
+    {
+#ifdef USE_HCACHE
+      /* Remember a digest of the decoded text, but never of decrypted text */
+      if (!have_cached && !((WithCrypto != 0) && (e->security & SEC_ENCRYPT)))
+        mutt_fts_learn(e, temp, tempsize);
+#endif
+      /* Match the decoded message in place, instead of reopening the buffer
+       * as a stream and copying it back out line by line.  The buffer is
+       * ours and open_memstream() keeps it nul-terminated, so each line can
+       * be terminated temporarily for the regex. */
+      char *line = temp;
+      char *end = temp + tempsize;
+      while (line && (line < end) && !match)
+      {
+        char *eol = memchr(line, '\n', end - line);
+        if (eol)
+        {
+          char *next = eol + 1;
+          const char saved = *next;
+          *next = '\0';
+          match = patmatch(pat, line);
+          *next = saved;
+          line = next;
+        }
+        else
+        {
+          match = patmatch(pat, line);
+          line = NULL;
+        }
+      }
+      mx_msg_close(m, &msg);
+      FREE(&temp);
+      return match;
+    }
+
     len = tempsize;
 
     if (tempsize != 0)
@@ -241,6 +336,15 @@ static bool msg_search(struct Mailbox *m, struct Pattern *pat, int msgno)
 
   FREE(&buf);
 
+#if defined(USE_HCACHE) && !defined(USE_FMEMOPEN)
+  /* Remember a digest of the decoded text, but never of decrypted text */
+  if (C_ThoroughSearch && (pat->op != MUTT_PAT_HEADER) &&
+      !((WithCrypto != 0) && (e->security & SEC_ENCRYPT)))
+  {
+    mutt_fts_learn_file(e, fp);
+  }
+#endif
+
   mx_msg_close(m, &msg);
 
   if (C_ThoroughSearch)
@@ -857,6 +961,7 @@ int mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags,
     case MUTT_PAT_REFERENCE:
       if (!e->env)
         return 0;
+      mutt_env_parse_threads(e->env);
       return pat->pat_not ^ (match_reference(pat, &e->env->references) ||
                              match_reference(pat, &e->env->in_reply_to));
     case MUTT_PAT_ADDRESS:
@@ -986,6 +1091,11 @@ int mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags,
       return pat->pat_not ^ (e->env->x_label && patmatch(pat, e->env->x_label));
     case MUTT_PAT_DRIVER_TAGS:
     {
+      /* don't build the joined tag string for untagged mail - in most
+       * folders that's nearly every message */
+      if (STAILQ_EMPTY(&e->tags))
+        return pat->pat_not;
+
       char *tags = driver_tags_get(&e->tags);
       bool rc = (pat->pat_not ^ (tags && patmatch(pat, tags)));
       FREE(&tags);
@@ -996,7 +1106,24 @@ int mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags,
         return 0;
       return pat->pat_not ^ (e->env->spam.data && patmatch(pat, e->env->spam.data));
     case MUTT_PAT_DUPLICATED:
-      return pat->pat_not ^ (e->thread && e->thread->duplicate_thread);
+      if (e->thread)
+        return pat->pat_not ^ e->thread->duplicate_thread;
+      /* No thread tree (sort isn't threads) - answer from the message-id
+       * hash instead, so `~=` works in every sort order */
+      if (!m || !e->env || !e->env->message_id)
+        return pat->pat_not;
+      {
+        if (!m->id_hash)
+          m->id_hash = mutt_make_id_hash(m);
+        int count = 0;
+        struct HashElem *he = mutt_hash_find_bucket(m->id_hash, e->env->message_id);
+        for (; he && (count < 2); he = he->next)
+        {
+          if (mutt_str_equal(he->key.strkey, e->env->message_id))
+            count++;
+        }
+        return pat->pat_not ^ (count > 1);
+      }
     case MUTT_PAT_MIMEATTACH:
       if (!m)
         return 0;
@@ -82,6 +82,7 @@ struct Pattern
   bool is_multi     : 1;         ///< Multiple case (only for ~I pattern now)
   int min;                       ///< Minimum for range checks
   int max;                       ///< Maximum for range checks
+  char *prefilter;               ///< Literal every regex match must contain (or NULL)
   struct PatternList *child;     ///< Arguments to logical operation
   union {
     regex_t *regex;              ///< Compiled regex, for non-pattern matching
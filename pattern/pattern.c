@@ -30,6 +30,8 @@
 #include "config.h"
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
 #include "private.h"
 #include "mutt/lib.h"
 #include "email/lib.h"
@@ -82,6 +84,7 @@ bool (*eat_arg_t)(struct Pattern *pat, int flags, struct Buffer *s, struct Buffe
 static struct PatternList *SearchPattern = NULL; ///< current search pattern
 static char LastSearch[256] = { 0 };             ///< last pattern searched for
 static char LastSearchExpn[1024] = { 0 }; ///< expanded version of LastSearch
+static char CachedSearchExpn[1024] = { 0 }; ///< pattern the Emails' searched/matched flags belong to
 
 /**
  * quote_simple - Apply simple quoting to a string
@@ -326,6 +329,147 @@ bail:
   return rc;
 }
 
+/**
+ * struct DateIndexEntry - One message in the sorted date index
+ */
+struct DateIndexEntry
+{
+  time_t date; ///< Email date (sent or received)
+  int msgno;   ///< Index into Mailbox->emails
+};
+
+/// Sorted date -> msgno table for the current mailbox.  Limiting a 10-year
+/// archive to a month used to run the pattern machinery over every message;
+/// a pure date-range limit can instead binary-search this table.
+static struct DateIndexEntry *DateIndex = NULL;
+static int DateIndexLen = 0;                    ///< Entries in #DateIndex
+static struct Mailbox *DateIndexMailbox = NULL; ///< Mailbox #DateIndex describes
+static size_t DateIndexSeq = 0;      ///< Email::sequence of the newest entry
+static bool DateIndexReceived = false; ///< Table is sorted by `received`, not `date_sent`
+
+/**
+ * date_index_cmp - Compare two date index entries - Implements ::sort_t
+ */
+static int date_index_cmp(const void *a, const void *b)
+{
+  const struct DateIndexEntry *da = a;
+  const struct DateIndexEntry *db = b;
+
+  if (da->date != db->date)
+    return (da->date < db->date) ? -1 : 1;
+  return da->msgno - db->msgno;
+}
+
+/**
+ * date_index_build - Ensure #DateIndex describes a Mailbox
+ * @param m        Mailbox to index
+ * @param received Sort by the received date rather than the sent date
+ * @retval true The table is ready
+ *
+ * The table is rebuilt when the mailbox, its message count, its most recent
+ * Email or the date of interest changes; repeated date limits on the same
+ * folder (month-by-month archive navigation) reuse it.
+ */
+static bool date_index_build(struct Mailbox *m, bool received)
+{
+  if (m->msg_count == 0)
+    return false;
+
+  struct Email *e_last = m->emails[m->msg_count - 1];
+  if (!e_last)
+    return false;
+
+  if ((DateIndexMailbox == m) && (DateIndexLen == m->msg_count) &&
+      (DateIndexSeq == e_last->sequence) && (DateIndexReceived == received))
+  {
+    return true;
+  }
+
+  mutt_mem_realloc(&DateIndex, m->msg_count * sizeof(struct DateIndexEntry));
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      return false;
+    DateIndex[i].date = received ? e->received : e->date_sent;
+    DateIndex[i].msgno = i;
+  }
+  qsort(DateIndex, m->msg_count, sizeof(struct DateIndexEntry), date_index_cmp);
+
+  DateIndexLen = m->msg_count;
+  DateIndexMailbox = m;
+  DateIndexSeq = e_last->sequence;
+  DateIndexReceived = received;
+  return true;
+}
+
+/**
+ * limit_by_date - Resolve a pure date-range limit from the date index
+ * @param m       Mailbox to limit
+ * @param pat     Compiled pattern list
+ * @param padding Padding bytes per message, see mx_msg_padding_size()
+ * @retval true The limit was resolved here; the caller's scan is unnecessary
+ *
+ * Handles a limit that is exactly one non-negated `~d`/`~r` range: the match
+ * set is found by binary-searching the sorted date table, and only a trivial
+ * flag sweep remains linear.  Anything more complicated falls back to the
+ * full pattern scan.
+ */
+static bool limit_by_date(struct Mailbox *m, struct PatternList *pat, int padding)
+{
+  struct Pattern *node = SLIST_FIRST(pat);
+  if (!node || SLIST_NEXT(node, entries) || node->pat_not || node->dynamic)
+    return false;
+  if ((node->op != MUTT_PAT_DATE) && (node->op != MUTT_PAT_DATE_RECEIVED))
+    return false;
+  if (!date_index_build(m, node->op == MUTT_PAT_DATE_RECEIVED))
+    return false;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    e->vnum = -1;
+    e->visible = false;
+    e->collapsed = false;
+    e->num_hidden = 0;
+  }
+
+  /* find the first entry inside the range ... */
+  int lo = 0;
+  int hi = DateIndexLen;
+  while (lo < hi)
+  {
+    const int mid = lo + (hi - lo) / 2;
+    if (DateIndex[mid].date < node->min)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  /* ... mark everything up to its end ... */
+  for (int i = lo; (i < DateIndexLen) && (DateIndex[i].date <= node->max); i++)
+    m->emails[DateIndex[i].msgno]->visible = true;
+
+  /* ... and rebuild the virtual index in mailbox order */
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    if (!e->visible)
+      continue;
+    e->vnum = m->vcount;
+    m->v2r[m->vcount] = i;
+    m->vcount++;
+    struct Body *b = e->body;
+    Context->vsize += b->length + b->offset - b->hdr_offset + padding;
+  }
+
+  return true;
+}
+
 /**
  * mutt_pattern_func - Perform some Pattern matching
  * @param op     Operation to perform, e.g. #MUTT_LIMIT
@@ -389,6 +533,9 @@ int mutt_pattern_func(int op, char *prompt)
     Context->collapsed = false;
     int padding = mx_msg_padding_size(m);
 
+    if (!match_all && limit_by_date(m, pat, padding))
+      goto limited;
+
     for (int i = 0; i < m->msg_count; i++)
     {
       struct Email *e = m->emails[i];
@@ -412,6 +559,7 @@ int mutt_pattern_func(int op, char *prompt)
         Context->vsize += b->length + b->offset - b->hdr_offset + padding;
       }
     }
+  limited:;
   }
   else
   {
@@ -471,6 +619,59 @@ bail:
   return rc;
 }
 
+/**
+ * search_refines - Does a new search pattern only narrow the previous one?
+ * @param old_expn Expanded pattern whose results are cached
+ * @param new_expn Expanded pattern about to be searched
+ * @retval true Every match of new_expn is also a match of old_expn
+ *
+ * The common way of refining a search is to recall the previous pattern and
+ * append further terms - juxtaposition is an implicit AND, so the new pattern
+ * can only match a subset of the old one.  That holds even if the old pattern
+ * contains alternatives, since the appended terms restrict its last branch.
+ * It breaks down if the suffix itself introduces a top-level '|', which would
+ * widen the pattern, so reject that; a '|' inside a group or a quoted string
+ * is harmless.  The suffix must start with whitespace, otherwise it could be
+ * extending the final term rather than adding new ones.
+ */
+static bool search_refines(const char *old_expn, const char *new_expn)
+{
+  const size_t len = mutt_str_startswith(new_expn, old_expn);
+  if (len == 0)
+    return false;
+
+  const char *suffix = new_expn + len;
+  if ((suffix[0] != ' ') && (suffix[0] != '\t'))
+    return false;
+
+  int depth = 0;
+  bool quoted = false;
+  for (const char *p = suffix; *p; p++)
+  {
+    if ((p[0] == '\\') && p[1])
+    {
+      p++;
+      continue;
+    }
+    if (quoted)
+    {
+      if (*p == '"')
+        quoted = false;
+      continue;
+    }
+    if (*p == '"')
+      quoted = true;
+    else if (*p == '(')
+      depth++;
+    else if (*p == ')')
+      depth--;
+    else if ((*p == '|') && (depth == 0))
+      return false;
+  }
+
+  return true;
+}
+
 /**
  * mutt_search_command - Perform a search
  * @param m   Mailbox to search through
@@ -509,9 +710,17 @@ int mutt_search_command(struct Mailbox *m, int cur, int op)
 
     if (!SearchPattern || !mutt_str_equal(mutt_b2s(tmp), LastSearchExpn))
     {
+      /* if the new pattern only appends AND-terms to the one whose results
+       * are cached, previous misses stay misses - only the previous hits
+       * need to be re-evaluated.  (Not for IMAP, where the cached results
+       * come from a server-side search.)  */
+      const bool refine = SearchPattern && !OptSearchInvalid && (m->type != MUTT_IMAP) &&
+                          search_refines(CachedSearchExpn, mutt_b2s(tmp));
+
       struct Buffer err;
       mutt_buffer_init(&err);
-      OptSearchInvalid = true;
+      if (!refine)
+        OptSearchInvalid = true;
       mutt_str_copy(LastSearch, buf, sizeof(LastSearch));
       mutt_str_copy(LastSearchExpn, mutt_b2s(tmp), sizeof(LastSearchExpn));
       mutt_message(_("Compiling search pattern..."));
@@ -526,24 +735,42 @@ int mutt_search_command(struct Mailbox *m, int cur, int op)
         FREE(&err.data);
         LastSearch[0] = '\0';
         LastSearchExpn[0] = '\0';
+        OptSearchInvalid = true;
         return -1;
       }
       FREE(&err.data);
       mutt_clear_error();
+
+      if (refine)
+      {
+        for (int i = 0; i < m->msg_count; i++)
+        {
+          struct Email *e = m->emails[i];
+          if (e->searched && e->matched)
+            e->searched = false;
+        }
+        mutt_str_copy(CachedSearchExpn, LastSearchExpn, sizeof(CachedSearchExpn));
+      }
     }
 
     mutt_buffer_pool_release(&tmp);
   }
 
+  const uint64_t scan_start_ms = mutt_date_epoch_ms();
+
   if (OptSearchInvalid)
   {
     for (int i = 0; i < m->msg_count; i++)
       m->emails[i]->searched = false;
 #ifdef USE_IMAP
     if ((m->type == MUTT_IMAP) && (!imap_search(m, SearchPattern)))
+    {
+      mutt_stats_record_ms("search/scan", mutt_date_epoch_ms() - scan_start_ms);
       return -1;
+    }
 #endif
     OptSearchInvalid = false;
+    mutt_str_copy(CachedSearchExpn, LastSearchExpn, sizeof(CachedSearchExpn));
   }
 
   int incr = OptSearchReverse ? -1 : 1;
@@ -564,6 +791,7 @@ int mutt_search_command(struct Mailbox *m, int cur, int op)
       else
       {
         mutt_message(_("Search hit bottom without finding match"));
+        mutt_stats_record_ms("search/scan", mutt_date_epoch_ms() - scan_start_ms);
         return -1;
       }
     }
@@ -575,6 +803,7 @@ int mutt_search_command(struct Mailbox *m, int cur, int op)
       else
       {
         mutt_message(_("Search hit top without finding match"));
+        mutt_stats_record_ms("search/scan", mutt_date_epoch_ms() - scan_start_ms);
         return -1;
       }
     }
@@ -588,6 +817,7 @@ int mutt_search_command(struct Mailbox *m, int cur, int op)
         mutt_clear_error();
         if (msg && *msg)
           mutt_message(msg);
+        mutt_stats_record_ms("search/scan", mutt_date_epoch_ms() - scan_start_ms);
         return i;
       }
     }
@@ -602,6 +832,7 @@ int mutt_search_command(struct Mailbox *m, int cur, int op)
         mutt_clear_error();
         if (msg && *msg)
           mutt_message(msg);
+        mutt_stats_record_ms("search/scan", mutt_date_epoch_ms() - scan_start_ms);
         return i;
       }
     }
@@ -610,6 +841,7 @@ int mutt_search_command(struct Mailbox *m, int cur, int op)
     {
       mutt_error(_("Search interrupted"));
       SigInt = 0;
+      mutt_stats_record_ms("search/scan", mutt_date_epoch_ms() - scan_start_ms);
       return -1;
     }
 
@@ -617,6 +849,7 @@ int mutt_search_command(struct Mailbox *m, int cur, int op)
   }
 
   mutt_error(_("Not found"));
+  mutt_stats_record_ms("search/scan", mutt_date_epoch_ms() - scan_start_ms);
   return -1;
 }
 
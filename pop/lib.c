@@ -158,6 +158,8 @@ static int fetch_capa(const char *line, void *data)
     adata->cmd_uidl = 1;
   else if (mutt_istr_startswith(line, "TOP"))
     adata->cmd_top = 1;
+  else if (mutt_istr_startswith(line, "PIPELINING"))
+    adata->cmd_pipelining = true;
 
   return 0;
 }
@@ -205,6 +207,7 @@ static int pop_capabilities(struct PopAccountData *adata, int mode)
     adata->cmd_user = 0;
     adata->cmd_uidl = 0;
     adata->cmd_top = 0;
+    adata->cmd_pipelining = false;
     adata->resp_codes = false;
     adata->expire = true;
     adata->login_delay = 0;
@@ -512,14 +515,37 @@ int pop_fetch_data(struct PopAccountData *adata, const char *query,
                    struct Progress *progress, pop_fetch_t callback, void *data)
 {
   char buf[1024];
-  long pos = 0;
-  size_t lenbuf = 0;
 
   mutt_str_copy(buf, query, sizeof(buf));
   int rc = pop_query(adata, buf, sizeof(buf));
   if (rc < 0)
     return rc;
 
+  return pop_fetch_multiline(adata, progress, callback, data);
+}
+
+/**
+ * pop_fetch_multiline - Read one multi-line response, calling a callback per line
+ * @param adata    POP Account data
+ * @param progress Progress bar
+ * @param callback Function called for each line read
+ * @param data     Data to pass to the callback
+ * @retval  0 Successful
+ * @retval -1 Connection lost
+ * @retval -3 Error in callback(*line, *data)
+ *
+ * Reads the byte-stuffed, dot-terminated body of a response whose status line
+ * has already been consumed.  This is the read half of pop_fetch_data(), split
+ * out so that pipelined commands can collect their replies one by one.
+ */
+int pop_fetch_multiline(struct PopAccountData *adata, struct Progress *progress,
+                        pop_fetch_t callback, void *data)
+{
+  char buf[1024];
+  long pos = 0;
+  size_t lenbuf = 0;
+  int rc = 0;
+
   char *inbuf = mutt_mem_malloc(sizeof(buf));
 
   while (true)
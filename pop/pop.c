@@ -177,17 +177,22 @@ static int pop_read_header(struct PopAccountData *adata, struct Email *e)
   }
 
   int index = 0;
-  size_t length = 0;
   char buf[1024];
 
   struct PopEmailData *edata = pop_edata_get(e);
 
-  snprintf(buf, sizeof(buf), "LIST %d\r\n", edata->refno);
-  int rc = pop_query(adata, buf, sizeof(buf));
+  /* the batched LIST at open usually knows the size already */
+  size_t length = edata->size;
+  int rc = 0;
+  if (length == 0)
+  {
+    snprintf(buf, sizeof(buf), "LIST %d\r\n", edata->refno);
+    rc = pop_query(adata, buf, sizeof(buf));
+    if (rc == 0)
+      sscanf(buf, "+OK %d %zu", &index, &length);
+  }
   if (rc == 0)
   {
-    sscanf(buf, "+OK %d %zu", &index, &length);
-
     snprintf(buf, sizeof(buf), "TOP %d 0\r\n", edata->refno);
     rc = pop_fetch_data(adata, buf, NULL, fetch_message, fp);
 
@@ -299,6 +304,187 @@ static int fetch_uidl(const char *line, void *data)
   return 0;
 }
 
+/**
+ * struct FetchSizes - Map batched LIST output onto Emails by server number
+ */
+struct FetchSizes
+{
+  struct Email **ref; ///< Email for each server message number
+  int max;            ///< Largest valid message number
+};
+
+/**
+ * fetch_sizes - parse batched LIST output - Implements ::pop_fetch_t
+ * @param line String to parse
+ * @param data FetchSizes map
+ * @retval  0 Success
+ * @retval -1 Failure
+ */
+static int fetch_sizes(const char *line, void *data)
+{
+  struct FetchSizes *fs = data;
+  char *endp = NULL;
+
+  errno = 0;
+  int index = strtol(line, &endp, 10);
+  if (errno)
+    return -1;
+  while (*endp == ' ')
+    endp++;
+
+  if ((index < 1) || (index > fs->max) || !fs->ref[index])
+    return 0;
+
+  struct PopEmailData *edata = pop_edata_get(fs->ref[index]);
+  edata->size = strtoul(endp, NULL, 10);
+  return 0;
+}
+
+/**
+ * fetch_discard - Throw away one line of a response - Implements ::pop_fetch_t
+ * @param line String to discard
+ * @param data UNUSED
+ * @retval 0 (always)
+ *
+ * Used to drain replies still in flight after a pipelined command failed.
+ */
+static int fetch_discard(const char *line, void *data)
+{
+  return 0;
+}
+
+/* number of TOP commands kept in flight on a pipelining server */
+#define POP_PIPELINE_DEPTH 32
+
+/**
+ * struct TopPipeline - In-flight TOP commands on a pipelining server
+ */
+struct TopPipeline
+{
+  void *hc;      ///< Header cache, to predict which messages need fetching
+  int sent_hi;   ///< First new message index not yet considered for sending
+  int in_flight; ///< TOP commands sent but not yet answered
+};
+
+/**
+ * pop_read_header_pipelined - Read a header, keeping a window of TOPs in flight
+ * @param adata     POP Account data
+ * @param m         Mailbox
+ * @param msgno     Index of the Email to read
+ * @param new_count Index after the last new message
+ * @param tp        Pipeline state
+ * @retval  0 Success
+ * @retval -1 Connection lost
+ * @retval -2 Invalid command or execution error
+ * @retval -3 Error writing to tempfile
+ *
+ * On a server advertising PIPELINING, the TOP commands for upcoming header
+ * cache misses are sent in one batch before their replies are read, so the
+ * fetch costs one round trip per #POP_PIPELINE_DEPTH headers instead of one
+ * per header.  The reply read here always belongs to msgno, because the main
+ * loop consumes misses in the same order they were sent.
+ */
+static int pop_read_header_pipelined(struct PopAccountData *adata, struct Mailbox *m,
+                                     int msgno, int new_count, struct TopPipeline *tp)
+{
+  char buf[1024];
+
+  /* top up the send window with TOPs for the next header cache misses */
+  struct Buffer *cmd = mutt_buffer_pool_get();
+  while ((tp->in_flight < POP_PIPELINE_DEPTH) && (tp->sent_hi < new_count))
+  {
+    struct PopEmailData *edata = pop_edata_get(m->emails[tp->sent_hi]);
+    bool cached = false;
+#ifdef USE_HCACHE
+    struct HCacheEntry hce = mutt_hcache_fetch(tp->hc, edata->uid, strlen(edata->uid), 0);
+    if (hce.email)
+    {
+      email_free(&hce.email);
+      cached = true;
+    }
+#endif
+    if (!cached)
+    {
+      mutt_buffer_add_printf(cmd, "TOP %d 0\r\n", edata->refno);
+      tp->in_flight++;
+    }
+    tp->sent_hi++;
+  }
+  if (!mutt_buffer_is_empty(cmd) &&
+      (mutt_socket_send_d(adata->conn, mutt_b2s(cmd), MUTT_SOCK_LOG_FULL) < 0))
+  {
+    mutt_buffer_pool_release(&cmd);
+    adata->status = POP_DISCONNECTED;
+    return -1;
+  }
+  mutt_buffer_pool_release(&cmd);
+
+  FILE *fp = mutt_file_mkstemp();
+  if (!fp)
+  {
+    mutt_perror(_("Can't create temporary file"));
+    return -3;
+  }
+
+  /* the next reply on the wire belongs to msgno */
+  int rc = 0;
+  if (mutt_socket_readln_d(buf, sizeof(buf), adata->conn, MUTT_SOCK_LOG_FULL) < 0)
+  {
+    adata->status = POP_DISCONNECTED;
+    rc = -1;
+  }
+  else if (!mutt_str_startswith(buf, "+OK"))
+  {
+    mutt_str_copy(adata->err_msg, buf, sizeof(adata->err_msg));
+    rc = -2;
+  }
+  else
+    rc = pop_fetch_multiline(adata, NULL, fetch_message, fp);
+  tp->in_flight--;
+
+  if ((rc == -2) || (rc == -3))
+  {
+    /* consume the replies still in flight, to keep the stream in sync */
+    while (tp->in_flight > 0)
+    {
+      if (mutt_socket_readln_d(buf, sizeof(buf), adata->conn, MUTT_SOCK_LOG_FULL) < 0)
+      {
+        adata->status = POP_DISCONNECTED;
+        break;
+      }
+      if (mutt_str_startswith(buf, "+OK") &&
+          (pop_fetch_multiline(adata, NULL, fetch_discard, NULL) < 0))
+      {
+        break;
+      }
+      tp->in_flight--;
+    }
+  }
+
+  if (rc == 0)
+  {
+    struct Email *e = m->emails[msgno];
+    struct PopEmailData *edata = pop_edata_get(e);
+
+    rewind(fp);
+    e->env = mutt_rfc822_read_header(fp, e, false, false);
+    e->body->length = edata->size - e->body->offset + 1;
+    rewind(fp);
+    while (!feof(fp))
+    {
+      e->body->length--;
+      fgets(buf, sizeof(buf), fp);
+    }
+  }
+  else if (rc == -2)
+    mutt_error("%s", adata->err_msg);
+  else if (rc == -3)
+    mutt_error(_("Can't write header to temporary file"));
+
+  mutt_file_fclose(&fp);
+  return rc;
+}
+
 /**
  * msg_cache_check - Check the Body Cache for an ID - Implements ::bcache_list_t
  */
@@ -440,6 +626,28 @@ static int pop_fetch_headers(struct Mailbox *m)
           deleted);
     }
 
+    /* fetch all the message sizes in one LIST round trip, instead of one
+     * LIST per message inside pop_read_header() */
+    bool pipelined = false;
+    struct TopPipeline tp = { NULL, old_count, 0 };
+#ifdef USE_HCACHE
+    tp.hc = hc;
+#endif
+    if (new_count > old_count)
+    {
+      struct FetchSizes fs = { NULL, new_count };
+      fs.ref = mutt_mem_calloc(new_count + 1, sizeof(struct Email *));
+      for (int j = 0; j < new_count; j++)
+      {
+        struct PopEmailData *edata = pop_edata_get(m->emails[j]);
+        if ((edata->refno >= 1) && (edata->refno <= new_count))
+          fs.ref[edata->refno] = m->emails[j];
+      }
+      if (pop_fetch_data(adata, "LIST\r\n", NULL, fetch_sizes, &fs) == 0)
+        pipelined = adata->cmd_pipelining && (adata->cmd_top == 1);
+      FREE(&fs.ref);
+    }
+
     bool hcached = false;
     for (i = old_count; i < new_count; i++)
     {
@@ -473,7 +681,8 @@ static int pop_fetch_headers(struct Mailbox *m)
       }
       else
 #endif
-          if ((rc = pop_read_header(adata, m->emails[i])) < 0)
+          if ((rc = pipelined ? pop_read_header_pipelined(adata, m, i, new_count, &tp) :
+                                pop_read_header(adata, m->emails[i])) < 0)
         break;
 #ifdef USE_HCACHE
       else
@@ -1255,6 +1464,7 @@ struct MxOps MxPopOps = {
   .msg_open_new     = NULL,
   .msg_commit       = NULL,
   .msg_close        = pop_msg_close,
+  .msg_prefetch     = NULL,
   .msg_padding_size = NULL,
   .msg_save_hcache  = pop_msg_save_hcache,
   .tags_edit        = NULL,
@@ -86,6 +86,7 @@ struct PopAccountData
   unsigned int cmd_user : 2; ///< optional command USER
   unsigned int cmd_uidl : 2; ///< optional command UIDL
   unsigned int cmd_top : 2;  ///< optional command TOP
+  bool cmd_pipelining : 1;   ///< optional command PIPELINING
   bool resp_codes : 1;       ///< server supports extended response codes
   bool expire : 1;           ///< expire is greater than 0
   bool clear_cache : 1;
@@ -106,6 +107,7 @@ struct PopEmailData
 {
   const char *uid;
   int refno;                   ///< Message number on server
+  size_t size;                 ///< Message size from the batched LIST at open
 };
 
 /**
@@ -158,6 +160,8 @@ int pop_open_connection(struct PopAccountData *adata);
 int pop_query_d(struct PopAccountData *adata, char *buf, size_t buflen, char *msg);
 int pop_fetch_data(struct PopAccountData *adata, const char *query,
                    struct Progress *progress, pop_fetch_t callback, void *data);
+int pop_fetch_multiline(struct PopAccountData *adata, struct Progress *progress,
+                        pop_fetch_t callback, void *data);
 int pop_reconnect(struct Mailbox *m);
 void pop_logout(struct Mailbox *m);
 struct PopAccountData *pop_adata_get(struct Mailbox *m);
@@ -50,6 +50,7 @@
 #include "keymap.h"
 #include "mutt_globals.h"
 #include "mutt_logging.h"
+#include "mutt_mailbox.h"
 #include "mutt_menu.h"
 #include "mutt_thread.h"
 #include "muttlib.h"
@@ -91,6 +92,7 @@ int mutt_num_postponed(struct Mailbox *m, bool force)
   struct stat st;
 
   static time_t LastModify = 0;
+  static time_t LastCheck = 0;
   static char *OldPostponed = NULL;
 
   if (UpdateNumPostponed)
@@ -138,6 +140,14 @@ int mutt_num_postponed(struct Mailbox *m, bool force)
   }
 #endif
 
+  /* The status bar asks for this count on every redraw, and polling the
+   * postponed mailbox costs a stat() (two for maildir).  Reuse the cached
+   * count at the same rate that `$mail_check` polls for new mail. */
+  const time_t now = mutt_date_epoch();
+  if (!force && (now - LastCheck < C_MailCheck))
+    return PostCount;
+  LastCheck = now;
+
   if (stat(C_Postponed, &st) == -1)
   {
     PostCount = 0;
@@ -214,47 +214,56 @@ void mutt_progress_update(struct Progress *progress, size_t pos, int percent)
   if (OptNoCurses)
     return;
 
+  if (progress->inc == 0)
+  {
+    /* non-incrementing bar: the message was shown by mutt_progress_init() */
+    if (progress->pos >= progress->size)
+      mutt_clear_error();
+    return;
+  }
+
+  /* This is the path taken for all but one-in-$read_inc of the items in the
+   * hot parse loops, so it must stay cheap: a single position comparison.
+   * The clock is only read once the position gate has passed. */
+  if ((pos != 0) && !progress_pos_needs_update(progress, pos))
+    return;
+
   const uint64_t now = mutt_date_epoch_ms();
+  if ((pos != 0) && !progress_time_needs_update(progress, now))
+    return;
 
-  const bool update = (pos == 0) /* always show the first update */ ||
-                      (progress_pos_needs_update(progress, pos) &&
-                       progress_time_needs_update(progress, now));
+  progress->pos = pos;
+  progress->timestamp = now;
 
-  if (progress->inc != 0 && update)
+  char posstr[128];
+  if (progress->is_bytes)
   {
-    progress->pos = pos;
-    progress->timestamp = now;
-
-    char posstr[128];
-    if (progress->is_bytes)
-    {
-      const size_t round_pos =
-          (progress->pos / (progress->inc << 10)) * (progress->inc << 10);
-      mutt_str_pretty_size(posstr, sizeof(posstr), round_pos);
-    }
-    else
-    {
-      snprintf(posstr, sizeof(posstr), "%zu", progress->pos);
-    }
+    const size_t round_pos =
+        (progress->pos / (progress->inc << 10)) * (progress->inc << 10);
+    mutt_str_pretty_size(posstr, sizeof(posstr), round_pos);
+  }
+  else
+  {
+    snprintf(posstr, sizeof(posstr), "%zu", progress->pos);
+  }
 
-    mutt_debug(LL_DEBUG4, "updating progress: %s\n", posstr);
+  mutt_debug(LL_DEBUG4, "updating progress: %s\n", posstr);
 
-    if (progress->size != 0)
+  if (progress->size != 0)
+  {
+    if (percent < 0)
     {
-      if (percent < 0)
-      {
-        percent = 100.0 * progress->pos / progress->size;
-      }
-      message_bar(percent, "%s %s/%s (%d%%)", progress->msg, posstr,
-                  progress->sizestr, percent);
+      percent = 100.0 * progress->pos / progress->size;
     }
+    message_bar(percent, "%s %s/%s (%d%%)", progress->msg, posstr,
+                progress->sizestr, percent);
+  }
+  else
+  {
+    if (percent > 0)
+      message_bar(percent, "%s %s (%d%%)", progress->msg, posstr, percent);
     else
-    {
-      if (percent > 0)
-        message_bar(percent, "%s %s (%d%%)", progress->msg, posstr, percent);
-      else
-        mutt_message("%s %s", progress->msg, posstr);
-    }
+      mutt_message("%s %s", progress->msg, posstr);
   }
 
   if (progress->pos >= progress->size)
@@ -1371,6 +1371,16 @@ void mutt_generate_recvattach_list(struct AttachCtx *actx, struct Email *e,
     need_secured = 0;
     secured = 0;
 
+    /* Reuse a previous decryption of this part.  Decrypting spawns a
+     * gpg/smime process per encrypted part, which is what made reopening the
+     * attachment menu of an encrypted message slow. */
+    if (m->decrypted && m->fp_decrypted)
+    {
+      mutt_generate_recvattach_list(actx, e, m->decrypted, m->fp_decrypted,
+                                    parent_type, level, 1);
+      continue;
+    }
+
     if (((WithCrypto & APPLICATION_SMIME) != 0) && (type = mutt_is_application_smime(m)))
     {
       need_secured = 1;
@@ -1417,8 +1427,12 @@ void mutt_generate_recvattach_list(struct AttachCtx *actx, struct Email *e,
 
     if (need_secured && secured)
     {
-      mutt_actx_add_fp(actx, fp_new);
-      mutt_actx_add_body(actx, new_body);
+      /* Keep the result on the encrypted part rather than handing it to the
+       * AttachCtx, so the next visit to this menu is free.  It's released
+       * with the Body, and a sync that rewrites the message re-parses the
+       * whole tree, so staleness takes care of itself. */
+      m->decrypted = new_body;
+      m->fp_decrypted = fp_new;
       mutt_generate_recvattach_list(actx, e, new_body, fp_new, parent_type, level, 1);
       continue;
     }
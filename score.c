@@ -28,6 +28,7 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -36,6 +37,7 @@
 #include "mutt.h"
 #include "score.h"
 #include "pattern/lib.h"
+#include "index.h"
 #include "init.h"
 #include "keymap.h"
 #include "mutt_commands.h"
@@ -89,9 +91,11 @@ void mutt_check_rescore(struct Mailbox *m)
       if (!e)
         break;
 
+      e->scored = false; /* the rules changed, so any cached score is void */
       mutt_score_message(m, e, true);
       e->pair = 0;
     }
+    IndexLineGen++; /* %N renders the scores */
   }
   OptNeedRescore = false;
 }
@@ -164,32 +168,130 @@ enum CommandResult mutt_parse_score(struct Buffer *buf, struct Buffer *s,
   return MUTT_CMD_SUCCESS;
 }
 
+/**
+ * score_pattern_stable - Will a pattern match the same way in a later session?
+ * @param pat Compiled pattern to check
+ * @retval true The match depends only on the message itself
+ *
+ * Message flags (~D, ~F, ~N, ...), thread relations, relative date ranges and
+ * crypto results can change without the message changing, so scores computed
+ * from them mustn't be carried across sessions by the header cache.
+ */
+static bool score_pattern_stable(struct PatternList *pat)
+{
+  struct Pattern *p = NULL;
+
+  SLIST_FOREACH(p, pat, entries)
+  {
+    if (p->op < MUTT_MT_MAX)
+      return false; /* a message flag, e.g. ~D, ~F, ~N, ~O, ~Q, ~R, ~T */
+    if (p->dynamic)
+      return false; /* relative dates are evaluated at match time */
+
+    switch (p->op)
+    {
+      case MUTT_PAT_AND:
+      case MUTT_PAT_OR:
+        if (!score_pattern_stable(p->child))
+          return false;
+        break;
+      case MUTT_PAT_THREAD:
+      case MUTT_PAT_PARENT:
+      case MUTT_PAT_CHILDREN:
+      case MUTT_PAT_COLLAPSED:
+      case MUTT_PAT_DUPLICATED:
+      case MUTT_PAT_UNREFERENCED:
+      case MUTT_PAT_BROKEN:
+      case MUTT_PAT_MESSAGE:
+      case MUTT_PAT_SCORE:
+      case MUTT_PAT_ID_EXTERNAL:
+      case MUTT_PAT_SERVERSEARCH:
+      case MUTT_PAT_DRIVER_TAGS:
+      case MUTT_PAT_CRYPT_SIGN:
+      case MUTT_PAT_CRYPT_VERIFIED:
+      case MUTT_PAT_CRYPT_ENCRYPT:
+      case MUTT_PAT_PGP_KEY:
+        return false;
+      default:
+        break;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * mutt_score_hash - Hash the user's score rules
+ * @retval num 32-bit hash of the rules (never 0)
+ * @retval 0   Scores must not be cached
+ *
+ * The header cache keeps Email::score so that unchanged messages skip
+ * re-scoring at folder open.  A cached score is only valid for the rules that
+ * produced it, so the cache is tagged with this hash.  Returns 0, meaning
+ * "never cache", when there are no rules or when any rule depends on session
+ * state.
+ */
+uint32_t mutt_score_hash(void)
+{
+  if (!ScoreList)
+    return 0;
+
+  union
+  {
+    unsigned char charval[16];
+    uint32_t intval;
+  } digest;
+  struct Md5Ctx md5ctx;
+
+  mutt_md5_init_ctx(&md5ctx);
+  for (struct Score *sp = ScoreList; sp; sp = sp->next)
+  {
+    if (!score_pattern_stable(sp->pat))
+      return 0;
+    mutt_md5_process(sp->str, &md5ctx);
+    mutt_md5_process_bytes(&sp->val, sizeof(sp->val), &md5ctx);
+    mutt_md5_process_bytes(&sp->exact, sizeof(sp->exact), &md5ctx);
+  }
+  mutt_md5_finish_ctx(&md5ctx, digest.charval);
+
+  /* 0 is reserved for "don't cache" */
+  return (digest.intval == 0) ? 1 : digest.intval;
+}
+
 /**
  * mutt_score_message - Apply scoring to an email
  * @param m        Mailbox
  * @param e        Email
  * @param upd_mbox If true, update the Mailbox too
+ *
+ * If the Email still carries a score computed with the current rules, e.g.
+ * restored from the header cache, the pattern matching is skipped and only
+ * the thresholds are re-applied.
  */
 void mutt_score_message(struct Mailbox *m, struct Email *e, bool upd_mbox)
 {
   struct Score *tmp = NULL;
   struct PatternCache cache = { 0 };
 
-  e->score = 0; /* in case of re-scoring */
-  for (tmp = ScoreList; tmp; tmp = tmp->next)
+  if (!e->scored)
   {
-    if (mutt_pattern_exec(SLIST_FIRST(tmp->pat), MUTT_MATCH_FULL_ADDRESS, NULL, e, &cache) > 0)
+    e->score = 0; /* in case of re-scoring */
+    for (tmp = ScoreList; tmp; tmp = tmp->next)
     {
-      if (tmp->exact || (tmp->val == 9999) || (tmp->val == -9999))
+      if (mutt_pattern_exec(SLIST_FIRST(tmp->pat), MUTT_MATCH_FULL_ADDRESS, NULL, e, &cache) > 0)
       {
-        e->score = tmp->val;
-        break;
+        if (tmp->exact || (tmp->val == 9999) || (tmp->val == -9999))
+        {
+          e->score = tmp->val;
+          break;
+        }
+        e->score += tmp->val;
       }
-      e->score += tmp->val;
     }
+    if (e->score < 0)
+      e->score = 0;
+    e->scored = true;
   }
-  if (e->score < 0)
-    e->score = 0;
 
   if (e->score <= C_ScoreThresholdDelete)
     mutt_set_flag_update(m, e, MUTT_DELETE, true, upd_mbox);
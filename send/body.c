@@ -158,6 +158,24 @@ static void encode_8bit(struct FgetConv *fc, FILE *fp_out)
   }
 }
 
+/**
+ * qp_put_hex - Write a quoted-printable escape, e.g. "=0A"
+ * @param dst Buffer for the result (4 bytes, including the terminating NUL)
+ * @param c   Character to encode
+ *
+ * This runs once per escaped character, so it avoids the format-string
+ * machinery of sprintf().
+ */
+static void qp_put_hex(char *dst, unsigned char c)
+{
+  static const char hex[] = "0123456789ABCDEF";
+
+  dst[0] = '=';
+  dst[1] = hex[c >> 4];
+  dst[2] = hex[c & 0x0f];
+  dst[3] = '\0';
+}
+
 /**
  * encode_quoted - Encode text as quoted printable
  * @param fc     Cursor for converting a file's encoding
@@ -224,7 +242,7 @@ static void encode_quoted(struct FgetConv *fc, FILE *fp_out, bool istext)
       {
         if (linelen < 74)
         {
-          sprintf(line + linelen - 1, "=%2.2X", (unsigned char) line[linelen - 1]);
+          qp_put_hex(line + linelen - 1, (unsigned char) line[linelen - 1]);
           fputs(line, fp_out);
         }
         else
@@ -257,7 +275,7 @@ static void encode_quoted(struct FgetConv *fc, FILE *fp_out, bool istext)
         fputc('\n', fp_out);
         linelen = 0;
       }
-      sprintf(line + linelen, "=%2.2X", (unsigned char) c);
+      qp_put_hex(line + linelen, (unsigned char) c);
       linelen += 3;
     }
     else
@@ -275,7 +293,7 @@ static void encode_quoted(struct FgetConv *fc, FILE *fp_out, bool istext)
     {
       /* take care of trailing whitespace */
       if (linelen < 74)
-        sprintf(line + linelen - 1, "=%2.2X", (unsigned char) line[linelen - 1]);
+        qp_put_hex(line + linelen - 1, (unsigned char) line[linelen - 1]);
       else
       {
         savechar = line[linelen - 1];
@@ -283,7 +301,7 @@ static void encode_quoted(struct FgetConv *fc, FILE *fp_out, bool istext)
         line[linelen] = 0;
         fputs(line, fp_out);
         fputc('\n', fp_out);
-        sprintf(line, "=%2.2X", (unsigned char) savechar);
+        qp_put_hex(line, (unsigned char) savechar);
       }
     }
     else
@@ -358,6 +376,15 @@ int mutt_write_mime_body(struct Body *a, FILE *fp, struct ConfigSubset *sub)
     return -1;
   }
 
+  if (a->preencoded)
+  {
+    /* The file already holds the part in wire form (e.g. a forwarded
+     * attachment whose encoding is retained) - splice it in verbatim */
+    mutt_file_copy_stream(fp_in, fp);
+    mutt_file_fclose(&fp_in);
+    return ferror(fp) ? -1 : 0;
+  }
+
   if ((a->type == TYPE_TEXT) && (!a->noconv))
   {
     char send_charset[128];
@@ -256,6 +256,9 @@ struct ConfigDef SendVars[] = {
   { "sendmail", DT_STRING|DT_COMMAND, NULL, IP SENDMAIL " -oem -oi", 0, NULL,
     "External command to send email"
   },
+  { "sendmail_pool", DT_NUMBER|DT_NOT_NEGATIVE, NULL, 0, 0, NULL,
+    "(optional) Number of sendmail processes to run concurrently"
+  },
   { "sendmail_wait", DT_NUMBER, NULL, 0, 0, NULL,
     "Time to wait for sendmail to finish"
   },
@@ -272,6 +275,9 @@ struct ConfigDef SendVars[] = {
   { "smtp_authenticators", DT_SLIST|SLIST_SEP_COLON, NULL, 0, 0, smtp_auth_validator,
     "(smtp) List of allowed authentication methods"
   },
+  { "smtp_keepalive", DT_NUMBER|DT_NOT_NEGATIVE, NULL, 0, 0, NULL,
+    "(smtp) Number of seconds to keep an idle SMTP connection open for reuse"
+  },
   { "smtp_oauth_refresh_command", DT_STRING|DT_COMMAND|DT_SENSITIVE, NULL, 0, 0, NULL,
     "(smtp) External command to generate OAUTH refresh token"
   },
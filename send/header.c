@@ -576,6 +576,19 @@ int mutt_rfc822_write_header(FILE *fp, struct Envelope *env, struct Body *attach
 {
   char buf[1024];
 
+  /* a resumed (postponed) message may still carry deferred threading headers */
+  mutt_env_parse_threads(env);
+
+  /* Assemble the headers in memory and hand them to the caller's stream in a
+   * single write; the dozens of tiny fputs calls per message add up when
+   * bulk-sending.  On failure just write through directly. */
+  FILE *fp_out = fp;
+  char *hdrs = NULL;
+  size_t hdrslen = 0;
+  FILE *fp_mem = open_memstream(&hdrs, &hdrslen);
+  if (fp_mem)
+    fp = fp_mem;
+
   if (((mode == MUTT_WRITE_HEADER_NORMAL) || (mode == MUTT_WRITE_HEADER_FCC) ||
       (mode == MUTT_WRITE_HEADER_POSTPONE)) && !privacy)
   {
@@ -747,7 +760,18 @@ int mutt_rfc822_write_header(FILE *fp, struct Envelope *env, struct Body *attach
     fprintf(fp, "User-Agent: NeoMutt/%s%s\n", PACKAGE_VERSION, GitVer);
   }
 
-  return (ferror(fp) == 0) ? 0 : -1;
+  int rc = (ferror(fp) == 0) ? 0 : -1;
+
+  if (fp_mem)
+  {
+    if (mutt_file_fclose(&fp_mem) != 0)
+      rc = -1;
+    if ((rc == 0) && (hdrslen > 0) && (fwrite(hdrs, 1, hdrslen, fp_out) != hdrslen))
+      rc = -1;
+    FREE(&hdrs);
+  }
+
+  return rc;
 }
 
 /**
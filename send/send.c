@@ -491,7 +491,7 @@ static int include_forward(struct Mailbox *m, struct Email *e, FILE *fp_out,
   if (c_forward_quote)
     cmflags |= MUTT_CM_PREFIX;
 
-  mutt_copy_message(fp_out, m, e, cmflags, chflags, 0);
+  mutt_copy_message_cached(fp_out, m, e, cmflags, chflags, 0);
   mutt_forward_trailer(m, e, fp_out, sub);
   return 0;
 }
@@ -660,7 +660,7 @@ static int include_reply(struct Mailbox *m, struct Email *e, FILE *fp_out,
     cmflags |= MUTT_CM_WEED;
   }
 
-  mutt_copy_message(fp_out, m, e, cmflags, chflags, 0);
+  mutt_copy_message_cached(fp_out, m, e, cmflags, chflags, 0);
 
   mutt_make_post_indent(m, e, fp_out, sub);
 
@@ -849,6 +849,7 @@ static void add_references(struct ListHead *head, struct Envelope *env)
 {
   struct ListNode *np = NULL;
 
+  mutt_env_parse_threads(env);
   struct ListHead *src = STAILQ_EMPTY(&env->references) ? &env->in_reply_to : &env->references;
   STAILQ_FOREACH(np, src, entries)
   {
@@ -997,7 +998,7 @@ static void make_reference_headers(struct EmailList *el, struct Envelope *env,
   if (!single && !STAILQ_EMPTY(&env->in_reply_to) &&
       STAILQ_NEXT(STAILQ_FIRST(&env->in_reply_to), entries))
   {
-    mutt_list_free(&env->references);
+    mutt_intern_list_free(&env->references);
   }
 }
 
@@ -1559,6 +1560,7 @@ static bool is_reply(struct Email *reply, struct Email *orig)
 {
   if (!reply || !reply->env || !orig || !orig->env)
     return false;
+  mutt_env_parse_threads(orig->env);
   return mutt_list_find(&orig->env->references, reply->env->message_id) ||
          mutt_list_find(&orig->env->in_reply_to, reply->env->message_id);
 }
@@ -50,6 +50,7 @@
 #include "context.h"
 #include "copy.h"
 #include "handler.h"
+#include "mutt_body.h"
 #include "mutt_globals.h"
 #include "mutt_mailbox.h"
 #include "mutt_parse.h"
@@ -70,6 +71,45 @@ struct ContentState
   bool was_cr;
 };
 
+/**
+ * struct ContentCacheEntry - Cached analysis of an attachment file
+ */
+struct ContentCacheEntry
+{
+  off_t size;          ///< File size when the analysis ran
+  time_t mtime;        ///< File mtime when the analysis ran
+  struct Content info; ///< Result of the content scan
+
+  /* Results of the charset-conversion trial, see convert_file_from_to().
+   * Only valid while conv_spec matches the current settings. */
+  char *conv_spec;     ///< "allowed charsets > target charsets" of the trial
+  char *conv_from;     ///< Charset the trial chose to convert from
+  char *conv_to;       ///< Charset the trial chose to convert to
+};
+
+/// Content scans by filename; re-attaching an unchanged file skips the rescan
+static struct HashTable *ContentCache = NULL;
+
+/**
+ * content_cache_entry_free - Free a ContentCacheEntry - Implements ::hash_hdata_free_t
+ */
+static void content_cache_entry_free(int type, void *obj, intptr_t data)
+{
+  struct ContentCacheEntry *cce = obj;
+  FREE(&cce->conv_spec);
+  FREE(&cce->conv_from);
+  FREE(&cce->conv_to);
+  FREE(&obj);
+}
+
+/**
+ * mutt_content_cache_cleanup - Free the cached Content analyses
+ */
+void mutt_content_cache_cleanup(void)
+{
+  mutt_hash_free(&ContentCache);
+}
+
 /**
  * update_content_info - Cache some info about an email
  * @param info   Info about an Attachment
@@ -100,6 +140,42 @@ static void update_content_info(struct Content *info, struct ContentState *s,
   {
     char ch = *buf;
 
+    /* Fast path: past the "From " detection point of a line, a run of
+     * printable characters can't change any of the per-line flags, so
+     * classify it in one go instead of byte by byte */
+    if (!was_cr && (linelen >= 4))
+    {
+      size_t run = 0;
+      size_t hibin = 0;
+      while (run < buflen)
+      {
+        const unsigned char c = buf[run];
+        if ((c < 32) || (c == 127))
+          break;
+        if (c & 0x80)
+          hibin++;
+        run++;
+      }
+      if (run > 0)
+      {
+        info->hibin += hibin;
+        info->ascii += run - hibin;
+        linelen += run;
+        dot = false;
+
+        size_t ws = 0; // the run only keeps its own trailing spaces
+        while ((ws < run) && (buf[run - 1 - ws] == ' '))
+          ws++;
+        whitespace = (ws == run) ? (whitespace + (int) ws) : (int) ws;
+
+        buf += run;
+        buflen -= run;
+        if (buflen == 0)
+          break;
+        ch = *buf;
+      }
+    }
+
     if (was_cr)
     {
       was_cr = false;
@@ -230,7 +306,9 @@ static size_t convert_file_to(FILE *fp, const char *fromcode, int ncodes,
   char bufi[256], bufu[512], bufo[4 * sizeof(bufi)];
   size_t ret;
 
-  const iconv_t cd1 = mutt_ch_iconv_open("utf-8", fromcode, 0);
+  /* These descriptors stream the whole file, so they can't be shared with
+   * the descriptor cache */
+  const iconv_t cd1 = mutt_ch_iconv_open("utf-8", fromcode, MUTT_ICONV_NO_CACHE);
   if (cd1 == (iconv_t)(-1))
     return -1;
 
@@ -242,7 +320,7 @@ static size_t convert_file_to(FILE *fp, const char *fromcode, int ncodes,
   for (int i = 0; i < ncodes; i++)
   {
     if (!mutt_istr_equal(tocodes[i], "utf-8"))
-      cd[i] = mutt_ch_iconv_open(tocodes[i], "utf-8", 0);
+      cd[i] = mutt_ch_iconv_open(tocodes[i], "utf-8", MUTT_ICONV_NO_CACHE);
     else
     {
       /* Special case for conversion to UTF-8 */
@@ -493,6 +571,20 @@ struct Content *mutt_get_content_info(const char *fname, struct Body *b,
     return NULL;
   }
 
+  const bool convert = b && (b->type == TYPE_TEXT) && !b->noconv && !b->force_charset;
+
+  /* The scan result depends only on the file content, so an unchanged file
+   * needn't be rescanned, e.g. a large attachment on every postpone cycle */
+  struct ContentCacheEntry *cce = ContentCache ? mutt_hash_find(ContentCache, fname) : NULL;
+  if (cce && ((cce->size != sb.st_size) || (cce->mtime != sb.st_mtime)))
+    cce = NULL;
+  if (cce && !convert && !cce->conv_spec)
+  {
+    info = mutt_mem_calloc(1, sizeof(struct Content));
+    *info = cce->info;
+    return info;
+  }
+
   fp = fopen(fname, "r");
   if (!fp)
   {
@@ -504,7 +596,7 @@ struct Content *mutt_get_content_info(const char *fname, struct Body *b,
 
   const char *c_charset = cs_subset_string(sub, "charset");
 
-  if (b && (b->type == TYPE_TEXT) && (!b->noconv && !b->force_charset))
+  if (convert)
   {
     const char *c_attach_charset = cs_subset_string(sub, "attach_charset");
     const char *c_send_charset = cs_subset_string(sub, "send_charset");
@@ -512,32 +604,85 @@ struct Content *mutt_get_content_info(const char *fname, struct Body *b,
     char *chs = mutt_param_get(&b->parameter, "charset");
     const char *fchs =
         b->use_disp ? (c_attach_charset ? c_attach_charset : c_charset) : c_charset;
-    if (c_charset && (chs || c_send_charset) &&
-        (convert_file_from_to(fp, fchs, chs ? chs : c_send_charset, &fromcode,
-                              &tocode, info) != (size_t)(-1)))
+    if (c_charset && (chs || c_send_charset))
     {
-      if (!chs)
+      /* The conversion trial reads the whole file through iconv, and the
+       * compose menu repeats it after every editor invocation even if the
+       * body wasn't touched.  Its outcome depends only on the file and the
+       * charset lists, so an unchanged file replays the remembered answer. */
+      char spec[1024];
+      snprintf(spec, sizeof(spec), "%s>%s", fchs, chs ? chs : c_send_charset);
+
+      if (cce && mutt_str_equal(cce->conv_spec, spec))
+      {
+        *info = cce->info;
+        if (!chs)
+          mutt_param_set(&b->parameter, "charset", cce->conv_to);
+        mutt_str_replace(&b->charset, cce->conv_from);
+        mutt_file_fclose(&fp);
+        return info;
+      }
+
+      if (convert_file_from_to(fp, fchs, chs ? chs : c_send_charset, &fromcode,
+                               &tocode, info) != (size_t)(-1))
       {
         char chsbuf[256];
         mutt_ch_canonical_charset(chsbuf, sizeof(chsbuf), tocode);
-        mutt_param_set(&b->parameter, "charset", chsbuf);
+        if (!chs)
+          mutt_param_set(&b->parameter, "charset", chsbuf);
+
+        if (!ContentCache)
+        {
+          ContentCache = mutt_hash_new(64, MUTT_HASH_STRDUP_KEYS);
+          mutt_hash_set_destructor(ContentCache, content_cache_entry_free, 0);
+        }
+        cce = mutt_mem_calloc(1, sizeof(*cce));
+        cce->size = sb.st_size;
+        cce->mtime = sb.st_mtime;
+        cce->info = *info;
+        cce->conv_spec = mutt_str_dup(spec);
+        cce->conv_from = mutt_str_dup(fromcode);
+        cce->conv_to = mutt_str_dup(chsbuf);
+        mutt_hash_delete(ContentCache, fname, NULL); // drop a stale entry
+        mutt_hash_insert(ContentCache, fname, cce);
+
+        FREE(&b->charset);
+        b->charset = fromcode;
+        FREE(&tocode);
+        mutt_file_fclose(&fp);
+        return info;
       }
-      FREE(&b->charset);
-      b->charset = fromcode;
-      FREE(&tocode);
-      mutt_file_fclose(&fp);
-      return info;
     }
   }
 
-  rewind(fp);
-  while ((r = fread(buf, 1, sizeof(buf), fp)))
-    update_content_info(info, &state, buf, r);
-  update_content_info(info, &state, 0, 0);
+  if (cce && !cce->conv_spec)
+  {
+    *info = cce->info;
+  }
+  else
+  {
+    cce = NULL;
+    rewind(fp);
+    while ((r = fread(buf, 1, sizeof(buf), fp)))
+      update_content_info(info, &state, buf, r);
+    update_content_info(info, &state, 0, 0);
+
+    if (!ContentCache)
+    {
+      ContentCache = mutt_hash_new(64, MUTT_HASH_STRDUP_KEYS);
+      mutt_hash_set_destructor(ContentCache, content_cache_entry_free, 0);
+    }
+    cce = mutt_mem_calloc(1, sizeof(*cce));
+    cce->size = sb.st_size;
+    cce->mtime = sb.st_mtime;
+    cce->info = *info;
+    mutt_hash_delete(ContentCache, fname, NULL); // drop a stale entry
+    mutt_hash_insert(ContentCache, fname, cce);
+  }
 
   mutt_file_fclose(&fp);
 
-  if (b && (b->type == TYPE_TEXT) && (!b->noconv && !b->force_charset))
+  if (convert)
   {
     mutt_param_set(&b->parameter, "charset",
                    (!info->hibin ?
@@ -549,126 +694,200 @@ struct Content *mutt_get_content_info(const char *fname, struct Body *b,
 }
 
 /**
- * mutt_lookup_mime_type - Find the MIME type for an attachment
- * @param att  Email with attachment
- * @param path Path to attachment
- * @retval num MIME type, e.g. #TYPE_IMAGE
+ * struct MimeTypeEntry - One extension's mapping from the mime.types files
+ */
+struct MimeTypeEntry
+{
+  enum ContentType type; ///< Major type, e.g. #TYPE_IMAGE
+  char *subtype;         ///< Subtype, e.g. "jpeg"
+  char *xtype;           ///< Unrecognised major type verbatim, "" otherwise
+};
+
+/// Extension to MimeTypeEntry lookup, parsed from the mime.types files
+static struct HashTable *MimeTypes = NULL;
+/// Modification times of the mime.types files the table was built from
+static struct timespec MimeTypesMtime[4];
+/// Did any of the mime.types files exist last time we looked?
+static bool MimeTypesFound = false;
+
+/**
+ * mime_types_path - Get the path of one of the mime.types files
+ * @param count  File index, 0..3
+ * @param buf    Buffer for the path
+ * @param buflen Length of the buffer
+ */
+static void mime_types_path(int count, char *buf, size_t buflen)
+{
+  switch (count)
+  {
+    case 0:
+      /* check default unix mimetypes location first */
+      mutt_str_copy(buf, "/etc/mime.types", buflen);
+      break;
+    case 1:
+      mutt_str_copy(buf, SYSCONFDIR "/mime.types", buflen);
+      break;
+    case 2:
+      mutt_str_copy(buf, PKGDATADIR "/mime.types", buflen);
+      break;
+    case 3:
+      snprintf(buf, buflen, "%s/.mime.types", NONULL(HomeDir));
+      break;
+  }
+}
+
+/**
+ * mime_type_entry_free - Free a MimeTypeEntry - Implements ::hash_hdata_free_t
+ */
+static void mime_type_entry_free(int type, void *obj, intptr_t data)
+{
+  struct MimeTypeEntry *me = obj;
+  FREE(&me->subtype);
+  FREE(&me->xtype);
+  FREE(&me);
+}
+
+/**
+ * mime_types_update - Make sure the extension table matches the files on disk
  *
- * Given a file at 'path', see if there is a registered MIME type.
- * Returns the major MIME type, and copies the subtype to "d".  First look
- * in a system mime.types if we can find one, then look for ~/.mime.types.
- * The longest match is used so that we can match 'ps.gz' when 'gz' also
- * exists.
+ * Four stat()s replace four open-and-scan passes per attachment; the table is
+ * only (re)parsed when a file's mtime changes, appears or disappears.
+ *
+ * In each file, the first entry for an extension wins, matching the strictly
+ * longest-match rule of the old line scan.
  */
-enum ContentType mutt_lookup_mime_type(struct Body *att, const char *path)
+static void mime_types_update(void)
 {
-  FILE *fp = NULL;
-  char *p = NULL, *q = NULL, *ct = NULL;
   char buf[PATH_MAX];
-  char subtype[256] = { 0 };
-  char xtype[256] = { 0 };
-  int sze, cur_sze = 0;
-  bool found_mimetypes = false;
-  enum ContentType type = TYPE_OTHER;
-
-  int szf = mutt_str_len(path);
+  struct stat st;
+  struct timespec mtime[4] = { 0 };
+  bool found = false;
 
   for (int count = 0; count < 4; count++)
   {
-    /* can't use strtok() because we use it in an inner loop below, so use
-     * a switch statement here instead.  */
-    switch (count)
+    mime_types_path(count, buf, sizeof(buf));
+    if (stat(buf, &st) == 0)
     {
-      /* last file with last entry to match wins type/xtype */
-      case 0:
-        /* check default unix mimetypes location first */
-        mutt_str_copy(buf, "/etc/mime.types", sizeof(buf));
-        break;
-      case 1:
-        mutt_str_copy(buf, SYSCONFDIR "/mime.types", sizeof(buf));
-        break;
-      case 2:
-        mutt_str_copy(buf, PKGDATADIR "/mime.types", sizeof(buf));
-        break;
-      case 3:
-        snprintf(buf, sizeof(buf), "%s/.mime.types", NONULL(HomeDir));
-        break;
-      default:
-        mutt_debug(LL_DEBUG1, "Internal error, count = %d\n", count);
-        goto bye; /* shouldn't happen */
+      mutt_file_get_stat_timespec(&mtime[count], &st, MUTT_STAT_MTIME);
+      found = true;
     }
+  }
+
+  if (MimeTypes && (memcmp(mtime, MimeTypesMtime, sizeof(mtime)) == 0))
+    return;
+
+  memcpy(MimeTypesMtime, mtime, sizeof(mtime));
+  MimeTypesFound = found;
+  mutt_hash_free(&MimeTypes);
+  MimeTypes = mutt_hash_new(256, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
+  mutt_hash_set_destructor(MimeTypes, mime_type_entry_free, 0);
+
+  for (int count = 0; count < 4; count++)
+  {
+    mime_types_path(count, buf, sizeof(buf));
+    FILE *fp = fopen(buf, "r");
+    if (!fp)
+      continue;
 
-    fp = fopen(buf, "r");
-    if (fp)
+    char line[PATH_MAX];
+    while (fgets(line, sizeof(line) - 1, fp))
     {
-      found_mimetypes = true;
+      /* weed out any comments */
+      char *p = strchr(line, '#');
+      if (p)
+        *p = '\0';
+
+      /* remove any leading space. */
+      char *ct = line;
+      SKIPWS(ct);
+
+      /* position on the next field in this line */
+      p = strpbrk(ct, " \t");
+      if (!p)
+        continue;
+      *p++ = 0;
+      SKIPWS(p);
+
+      /* split the content-type */
+      char *subtype = strchr(ct, '/');
+      if (!subtype)
+        continue; /* malformed line, just skip it. */
+      *subtype++ = 0;
+
+      char *q = subtype;
+      for (; *q && !IS_SPACE(*q); q++)
+        ; // do nothing
+      *q = '\0';
 
-      while (fgets(buf, sizeof(buf) - 1, fp))
+      const enum ContentType type = mutt_check_mime_type(ct);
+
+      /* cycle through the file extensions */
+      while ((p = strtok(p, " \t\n")))
       {
-        /* weed out any comments */
-        p = strchr(buf, '#');
-        if (p)
-          *p = '\0';
-
-        /* remove any leading space. */
-        ct = buf;
-        SKIPWS(ct);
-
-        /* position on the next field in this line */
-        p = strpbrk(ct, " \t");
-        if (!p)
-          continue;
-        *p++ = 0;
-        SKIPWS(p);
-
-        /* cycle through the file extensions */
-        while ((p = strtok(p, " \t\n")))
+        if (!mutt_hash_find(MimeTypes, p))
         {
-          sze = mutt_str_len(p);
-          if ((sze > cur_sze) && (szf >= sze) && mutt_istr_equal(path + szf - sze, p) &&
-              ((szf == sze) || (path[szf - sze - 1] == '.')))
-          {
-            /* get the content-type */
-
-            p = strchr(ct, '/');
-            if (!p)
-            {
-              /* malformed line, just skip it. */
-              break;
-            }
-            *p++ = 0;
-
-            for (q = p; *q && !IS_SPACE(*q); q++)
-              ; // do nothing
-
-            mutt_strn_copy(subtype, p, q - p, sizeof(subtype));
-
-            type = mutt_check_mime_type(ct);
-            if (type == TYPE_OTHER)
-              mutt_str_copy(xtype, ct, sizeof(xtype));
-
-            cur_sze = sze;
-          }
-          p = NULL;
+          struct MimeTypeEntry *me = mutt_mem_calloc(1, sizeof(struct MimeTypeEntry));
+          me->type = type;
+          me->subtype = mutt_str_dup(subtype);
+          me->xtype = mutt_str_dup((type == TYPE_OTHER) ? ct : "");
+          mutt_hash_insert(MimeTypes, p, me);
         }
+        p = NULL;
       }
-      mutt_file_fclose(&fp);
     }
+    mutt_file_fclose(&fp);
   }
+}
+
+/**
+ * mutt_mime_type_cache_cleanup - Free the extension to MIME type table
+ */
+void mutt_mime_type_cache_cleanup(void)
+{
+  mutt_hash_free(&MimeTypes);
+}
+
+/**
+ * mutt_lookup_mime_type - Find the MIME type for an attachment
+ * @param att  Email with attachment
+ * @param path Path to attachment
+ * @retval num MIME type, e.g. #TYPE_IMAGE
+ *
+ * Given a file at 'path', see if there is a registered MIME type.
+ * Returns the major MIME type, and copies the subtype to "d".  First look
+ * in a system mime.types if we can find one, then look for ~/.mime.types.
+ * The longest match is used so that we can match 'ps.gz' when 'gz' also
+ * exists.
+ */
+enum ContentType mutt_lookup_mime_type(struct Body *att, const char *path)
+{
+  enum ContentType type = TYPE_OTHER;
 
-bye:
+  mime_types_update();
 
   /* no mime.types file found */
-  if (!found_mimetypes)
+  if (!MimeTypesFound)
   {
     mutt_error(_("Could not find any mime.types file."));
   }
 
-  if ((type != TYPE_OTHER) || (*xtype != '\0'))
+  /* longest match first: try each '.' boundary from the left, and the whole
+   * name, so 'ps.gz' beats 'gz' */
+  const int szf = mutt_str_len(path);
+  struct MimeTypeEntry *me = NULL;
+  for (int i = 0; !me && (i < szf); i++)
+  {
+    if ((i != 0) && (path[i - 1] != '.'))
+      continue;
+    me = mutt_hash_find(MimeTypes, path + i);
+  }
+
+  if (me && ((me->type != TYPE_OTHER) || (me->xtype[0] != '\0')))
   {
+    type = me->type;
     att->type = type;
-    mutt_str_replace(&att->subtype, subtype);
-    mutt_str_replace(&att->xtype, xtype);
+    mutt_str_replace(&att->subtype, me->subtype);
+    mutt_str_replace(&att->xtype, me->xtype);
   }
 
   return type;
@@ -905,6 +1124,9 @@ void mutt_update_encoding(struct Body *a, struct ConfigSubset *sub)
   struct Content *info = NULL;
   char chsbuf[256];
 
+  /* Content analysis needs the actual data, not the wire form */
+  mutt_body_decode_preencoded(a);
+
   /* override noconv when it's us-ascii */
   if (mutt_ch_is_us_ascii(mutt_body_get_charset(a, chsbuf, sizeof(chsbuf))))
     a->noconv = false;
@@ -1544,6 +1766,8 @@ int mutt_write_fcc(const char *path, struct Email *e, const char *msgid, bool po
       mx_mbox_close(&ctx_fcc);
       goto done;
     }
+    /* the body is staged here, then read back twice (line count + copy) */
+    setvbuf(fp_tmp, NULL, _IOFBF, 65536);
     /* remember new mail status before appending message */
     need_mailbox_cleanup = true;
     stat(path, &st);
@@ -35,11 +35,13 @@ struct Mailbox;
 #define MUTT_RANDTAG_LEN 16
 
 int              mutt_bounce_message(FILE *fp, struct Email *e, struct AddressList *to, struct ConfigSubset *sub);
+void             mutt_content_cache_cleanup(void);
 const char *     mutt_fqdn(bool may_hide_host, const struct ConfigSubset *sub);
 struct Content * mutt_get_content_info(const char *fname, struct Body *b, struct ConfigSubset *sub);
 enum ContentType mutt_lookup_mime_type(struct Body *att, const char *path);
 struct Body *    mutt_make_file_attach(const char *path, struct ConfigSubset *sub);
 struct Body *    mutt_make_message_attach(struct Mailbox *m, struct Email *e, bool attach_msg, struct ConfigSubset *sub);
+void             mutt_mime_type_cache_cleanup(void);
 void             mutt_message_to_7bit(struct Body *a, FILE *fp, struct ConfigSubset *sub);
 void             mutt_prepare_envelope(struct Envelope *env, bool final, struct ConfigSubset *sub);
 void             mutt_stamp_attachment(struct Body *a);
@@ -60,6 +60,19 @@ SIG_ATOMIC_VOLATILE_T SigAlrm; ///< true after SIGALRM is received
 
 ARRAY_HEAD(SendmailArgs, const char *);
 
+/**
+ * struct SendmailProc - An in-flight background delivery
+ */
+struct SendmailProc
+{
+  pid_t pid;      ///< Supervising child, its exit status is the delivery status
+  char *childout; ///< Temp file holding the delivery output
+};
+ARRAY_HEAD(SendmailPool, struct SendmailProc);
+
+/// Deliveries running concurrently, see `$sendmail_pool`
+static struct SendmailPool Pool = ARRAY_HEAD_INITIALIZER;
+
 /**
  * alarm_handler - Async notification of an alarm signal
  * @param sig Signal, (SIGALRM)
@@ -69,6 +82,67 @@ static void alarm_handler(int sig)
   SigAlrm = 1;
 }
 
+/**
+ * pool_report - Report the result of a finished background delivery
+ * @param sp Finished delivery
+ * @param st Exit status of the supervising child
+ */
+static void pool_report(struct SendmailProc *sp, int st)
+{
+  if (st == (0xff & EX_OK))
+  {
+    if (sp->childout)
+      unlink(sp->childout);
+  }
+  else
+  {
+    const char *e = mutt_str_sysexit(st);
+    mutt_error(_("Error sending message, child exited %d (%s)"), st, NONULL(e));
+    if (sp->childout)
+    {
+      struct stat stb;
+      if ((stat(sp->childout, &stb) == 0) && (stb.st_size > 0))
+      {
+        mutt_do_pager(_("Output of the delivery process"), sp->childout,
+                      MUTT_PAGER_NO_FLAGS, NULL);
+      }
+      unlink(sp->childout);
+    }
+  }
+  FREE(&sp->childout);
+}
+
+/**
+ * sendmail_pool_wait - Make room for another background delivery
+ * @param max_procs Maximum deliveries to leave in flight, `$sendmail_pool`
+ *
+ * Reap the deliveries that have finished, reporting any failures, then block
+ * on the oldest until no more than (max_procs - 1) remain.
+ */
+static void sendmail_pool_wait(size_t max_procs)
+{
+  struct SendmailProc *sp = NULL;
+  size_t i = 0;
+  while ((sp = ARRAY_GET(&Pool, i)))
+  {
+    int st = 0;
+    pid_t rc;
+    if (ARRAY_SIZE(&Pool) >= max_procs)
+      rc = waitpid(sp->pid, &st, 0); // pool is full, wait for the oldest
+    else
+      rc = waitpid(sp->pid, &st, WNOHANG);
+
+    if (rc <= 0)
+    {
+      i++;
+      continue;
+    }
+
+    pool_report(sp, WIFEXITED(st) ? WEXITSTATUS(st) : S_ERR);
+    ARRAY_REMOVE(&Pool, sp);
+  }
+}
+
 /**
  * send_msg - invoke sendmail in a subshell
  * @param[in]  path     Path to program to execute
@@ -79,11 +153,13 @@ static void alarm_handler(int sig)
  *                      child process. If it is NULL, stderr and stdout
  *                      are not redirected.
  * @param[in]  wait_time How long to wait for sendmail, `$sendmail_wait`
+ * @param[out] bg_pid   If not NULL, don't wait: the supervising child's pid is
+ *                      returned here and its exit status is the delivery status
  * @retval  0 Success
  * @retval >0 Failure, return code from sendmail
  */
-static int send_msg(const char *path, struct SendmailArgs *args,
-                    const char *msg, char **tempfile, int wait_time)
+static int send_msg(const char *path, struct SendmailArgs *args, const char *msg,
+                    char **tempfile, int wait_time, pid_t *bg_pid)
 {
   sigset_t set;
   int st;
@@ -230,7 +306,13 @@ static int send_msg(const char *path, struct SendmailArgs *args,
 
   sigprocmask(SIG_UNBLOCK, &set, NULL);
 
-  if ((pid != -1) && (waitpid(pid, &st, 0) > 0))
+  if (bg_pid && (pid != -1))
+  {
+    /* the pool will reap the child and report its status later */
+    *bg_pid = pid;
+    st = 0xff & EX_OK;
+  }
+  else if ((pid != -1) && (waitpid(pid, &st, 0) > 0))
     st = WIFEXITED(st) ? WEXITSTATUS(st) : S_ERR; /* return child status */
   else
     st = S_ERR; /* error */
@@ -240,6 +322,26 @@ static int send_msg(const char *path, struct SendmailArgs *args,
   return st;
 }
 
+/**
+ * mutt_sendmail_flush - Wait for the outstanding background deliveries
+ *
+ * Blocks until the `$sendmail_pool` deliveries have all finished, reporting
+ * any failures.  Call before exiting, or the results would be lost.
+ */
+void mutt_sendmail_flush(void)
+{
+  struct SendmailProc *sp = NULL;
+  ARRAY_FOREACH(sp, &Pool)
+  {
+    int st = 0;
+    if (waitpid(sp->pid, &st, 0) > 0)
+      pool_report(sp, WIFEXITED(st) ? WEXITSTATUS(st) : S_ERR);
+    else
+      FREE(&sp->childout);
+  }
+  ARRAY_FREE(&Pool);
+}
+
 /**
  * add_args_one - Add an Address to a dynamic array
  * @param[in, out] args    Array to add to
@@ -419,7 +521,27 @@ int mutt_invoke_sendmail(struct AddressList *from, struct AddressList *to,
     mutt_need_hard_redraw();
 
   const short c_sendmail_wait = cs_subset_number(sub, "sendmail_wait");
-  i = send_msg(path, &args, msg, OptNoCurses ? NULL : &childout, c_sendmail_wait);
+  const short c_sendmail_pool = cs_subset_number(sub, "sendmail_pool");
+  if (c_sendmail_pool > 0)
+  {
+    /* Overlap deliveries: hand the wait over to a supervising child and only
+     * block when `$sendmail_pool` of them are already in flight.  Failures
+     * are reported when the child is reaped, on a later send. */
+    sendmail_pool_wait(c_sendmail_pool);
+
+    pid_t bg_pid = -1;
+    i = send_msg(path, &args, msg, OptNoCurses ? NULL : &childout, 0, &bg_pid);
+    if (i == (EX_OK & 0xff))
+    {
+      struct SendmailProc sp = { bg_pid, childout };
+      ARRAY_ADD(&Pool, sp);
+      childout = NULL; // now owned by the pool
+    }
+  }
+  else
+  {
+    i = send_msg(path, &args, msg, OptNoCurses ? NULL : &childout, c_sendmail_wait, NULL);
+  }
   if (i != (EX_OK & 0xff))
   {
     if (i != S_BKG)
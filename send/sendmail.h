@@ -31,5 +31,6 @@ struct ConfigSubset;
 int mutt_invoke_sendmail(struct AddressList *from, struct AddressList *to,
                          struct AddressList *cc, struct AddressList *bcc,
                          const char *msg, bool eightbit, struct ConfigSubset *sub);
+void mutt_sendmail_flush(void);
 
 #endif /* MUTT_SEND_SENDMAIL_H */
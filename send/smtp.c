@@ -99,6 +99,13 @@ struct SmtpAccountData
   const char *fqdn;          ///< Fully-qualified domain name
 };
 
+/* The Connection from the previous send, held open so that a batch of
+ * messages doesn't pay connect + TLS + authentication per message.
+ * Only kept while $smtp_keepalive is positive. */
+static struct Connection *SmtpConnCached = NULL;
+static SmtpCapFlags SmtpCapsCached = SMTP_CAP_NO_FLAGS; ///< Capabilities of #SmtpConnCached
+static time_t SmtpConnUsed = 0; ///< When #SmtpConnCached was last used
+
 /**
  * struct SmtpAuth - SMTP authentication multiplexor
  */
@@ -390,6 +397,49 @@ static int smtp_fill_account(struct SmtpAccountData *adata, struct ConnAccount *
   return 0;
 }
 
+/**
+ * smtp_conn_cache_take - Try to reuse the connection from the previous send
+ * @param adata SMTP Account data
+ * @param cac   Credentials for the server we want
+ * @retval true adata->conn is open and authenticated, ready for MAIL FROM
+ *
+ * The cached connection is only reused if it's for the same server, was used
+ * within the last $smtp_keepalive seconds, and still answers a NOOP - servers
+ * drop idle clients, and a stale socket would fail the send instead of just
+ * costing a reconnect.
+ */
+static bool smtp_conn_cache_take(struct SmtpAccountData *adata, struct ConnAccount *cac)
+{
+  if (!SmtpConnCached)
+    return false;
+
+  struct Connection *conn = SmtpConnCached;
+  SmtpConnCached = NULL;
+
+  const short c_smtp_keepalive = cs_subset_number(adata->sub, "smtp_keepalive");
+  if ((c_smtp_keepalive <= 0) ||
+      ((mutt_date_epoch() - SmtpConnUsed) > c_smtp_keepalive) ||
+      !mutt_str_equal(conn->account.host, cac->host) || (conn->account.port != cac->port))
+  {
+    mutt_socket_send(conn, "QUIT\r\n");
+    mutt_socket_close(conn);
+    FREE(&conn);
+    return false;
+  }
+
+  adata->conn = conn;
+  if ((mutt_socket_send(conn, "NOOP\r\n") == -1) || (smtp_get_resp(adata) != 0))
+  {
+    mutt_socket_close(conn);
+    FREE(&conn);
+    adata->conn = NULL;
+    return false;
+  }
+
+  adata->capabilities = SmtpCapsCached;
+  return true;
+}
+
 /**
  * smtp_helo - Say hello to an SMTP Server
  * @param adata SMTP Account data
@@ -910,19 +960,26 @@ int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
   if (smtp_fill_account(&adata, &cac) < 0)
     return rc;
 
-  adata.conn = mutt_conn_find(&cac);
-  if (!adata.conn)
-    return -1;
+  const bool reused = smtp_conn_cache_take(&adata, &cac);
+  if (!reused)
+  {
+    adata.conn = mutt_conn_find(&cac);
+    if (!adata.conn)
+      return -1;
+  }
 
   const char *c_dsn_return = cs_subset_string(adata.sub, "dsn_return");
 
   do
   {
-    /* send our greeting */
-    rc = smtp_open(&adata, eightbit);
-    if (rc != 0)
-      break;
-    FREE(&adata.auth_mechs);
+    if (!reused)
+    {
+      /* send our greeting */
+      rc = smtp_open(&adata, eightbit);
+      if (rc != 0)
+        break;
+      FREE(&adata.auth_mechs);
+    }
 
     /* send the sender's address */
     int len = snprintf(buf, sizeof(buf), "MAIL FROM:<%s>", envfrom);
@@ -961,13 +1018,25 @@ int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
     if (rc != 0)
       break;
 
-    mutt_socket_send(adata.conn, "QUIT\r\n");
-
     rc = 0;
   } while (false);
 
-  mutt_socket_close(adata.conn);
-  FREE(&adata.conn);
+  const short c_smtp_keepalive = cs_subset_number(adata.sub, "smtp_keepalive");
+  if ((rc == 0) && (c_smtp_keepalive > 0))
+  {
+    /* hold the authenticated connection open for the next message */
+    SmtpConnCached = adata.conn;
+    SmtpCapsCached = adata.capabilities;
+    SmtpConnUsed = mutt_date_epoch();
+    adata.conn = NULL;
+  }
+  else
+  {
+    if (rc == 0)
+      mutt_socket_send(adata.conn, "QUIT\r\n");
+    mutt_socket_close(adata.conn);
+    FREE(&adata.conn);
+  }
 
   if (rc == SMTP_ERR_READ)
     mutt_error(_("SMTP session failed: read error"));
@@ -24,6 +24,7 @@
 #define MUTT_SIDEBAR_PRIVATE_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
 #include "gui/lib.h"
@@ -43,6 +44,7 @@ struct SbEntry
   struct Mailbox *mailbox; ///< Mailbox this represents
   bool is_hidden;          ///< Don't show, e.g. $sidebar_new_mail_only
   enum ColorId color;      ///< Colour to use
+  uint64_t render_sig;     ///< Hash of the inputs `display` was rendered from
 };
 
 /**
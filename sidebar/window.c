@@ -435,6 +435,48 @@ static const char *sidebar_format_str(char *buf, size_t buflen, size_t col, int
   return src;
 }
 
+/**
+ * entry_render_sig - Hash everything an entry's display string depends on
+ * @param m     Mailbox of the entry
+ * @param width Desired width in screen cells
+ * @retval num Signature of the render inputs
+ *
+ * The abbreviation, depth and expando work in sb_recalc() is repeated for
+ * every visible entry on every recalc, although normally only one mailbox's
+ * counts have changed.  The signature covers the message counts, the paths
+ * and every config knob the rendering reads, so an entry is re-rendered only
+ * when its line would actually differ.
+ */
+static uint64_t entry_render_sig(struct Mailbox *m, int width)
+{
+  uint64_t sig = MUTT_FASTHASH_INIT;
+
+  sig = mutt_fasthash_str(mailbox_path(m), sig);
+  sig = mutt_fasthash_str(m->name, sig);
+  sig = mutt_fasthash_str(C_SidebarFormat, sig);
+  sig = mutt_fasthash_str(C_SidebarDelimChars, sig);
+  sig = mutt_fasthash_str(C_SidebarIndentString, sig);
+  sig = mutt_fasthash_str(C_Folder, sig);
+
+  long nums[] = {
+    width,          C_SidebarShortPath, C_SidebarFolderIndent,
+    C_SidebarComponentDepth, m->msg_count, m->msg_unread,
+    m->msg_flagged, m->msg_new,        m->has_new,
+    0,              0,                 0,
+  };
+
+  /* the open mailbox renders some counts from the Context instead */
+  if (Context && Context->mailbox &&
+      mutt_str_equal(Context->mailbox->realpath, m->realpath))
+  {
+    nums[9] = Context->mailbox->msg_deleted;
+    nums[10] = Context->mailbox->msg_tagged;
+    nums[11] = Context->mailbox->vcount;
+  }
+
+  return mutt_fasthash_bytes(nums, sizeof(nums), sig);
+}
+
 /**
  * make_sidebar_entry - Turn mailbox data into a sidebar string
  * @param[out] buf     Buffer in which to save string
@@ -681,6 +723,14 @@ int sb_recalc(struct MuttWindow *win)
       m->msg_flagged = Context->mailbox->msg_flagged;
     }
 
+    const uint64_t sig = entry_render_sig(m, width);
+    if (sig == entry->render_sig)
+    {
+      row++;
+      continue; /* the cached display string is still right */
+    }
+    entry->render_sig = sig;
+
     const char *path = mailbox_path(m);
 
     // Try to abbreviate the full path
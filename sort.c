@@ -38,6 +38,7 @@
 #include "alias/lib.h"
 #include "sort.h"
 #include "context.h"
+#include "index.h"
 #include "mutt_globals.h"
 #include "mutt_logging.h"
 #include "mutt_thread.h"
@@ -203,6 +204,142 @@ static int compare_from(const void *a, const void *b)
   return SORT_CODE(result);
 }
 
+/**
+ * struct KeyedEmail - An Email with a cached sort key
+ *
+ * The Email must remain the first member: perform_auxsort() and the ::sort_t
+ * comparators only look at the leading `struct Email *`, so a pointer to a
+ * KeyedEmail can be handed to them unchanged.
+ */
+struct KeyedEmail
+{
+  struct Email *email;   ///< Email being sorted
+  char *name;            ///< Cached display name, see mutt_get_name()
+  bool has_spam;         ///< Email has a spam attribute
+  bool spam_numeric;     ///< Spam attribute has a numeric prefix
+  double spam_value;     ///< Numeric prefix of the spam attribute
+  const char *spam_rest; ///< Remainder of the spam attribute (points into env)
+};
+
+/**
+ * compare_keyed_name - Compare cached display names of two emails
+ * @param a First KeyedEmail
+ * @param b Second KeyedEmail
+ * @retval -1 a precedes b
+ * @retval  0 a and b are identical
+ * @retval  1 b precedes a
+ *
+ * qsort() helper for sort_keyed() - the names have already been computed,
+ * so no alias or IDN work is needed per comparison.
+ */
+static int compare_keyed_name(const void *a, const void *b)
+{
+  const struct KeyedEmail *ka = (const struct KeyedEmail *) a;
+  const struct KeyedEmail *kb = (const struct KeyedEmail *) b;
+
+  int result = mutt_istrn_cmp(ka->name, kb->name, 128);
+  result = perform_auxsort(result, a, b);
+  return SORT_CODE(result);
+}
+
+/**
+ * compare_keyed_spam - Compare cached spam attributes of two emails
+ * @param a First KeyedEmail
+ * @param b Second KeyedEmail
+ * @retval -1 a precedes b
+ * @retval  0 a and b are identical
+ * @retval  1 b precedes a
+ *
+ * qsort() helper for sort_keyed() - same ordering as compare_spam(), but the
+ * strtod() conversions have already been done.
+ */
+static int compare_keyed_spam(const void *a, const void *b)
+{
+  const struct KeyedEmail *ka = (const struct KeyedEmail *) a;
+  const struct KeyedEmail *kb = (const struct KeyedEmail *) b;
+
+  if (ka->has_spam && !kb->has_spam)
+    return SORT_CODE(1);
+  if (!ka->has_spam && kb->has_spam)
+    return SORT_CODE(-1);
+  if (!ka->has_spam && !kb->has_spam)
+    return SORT_CODE(perform_auxsort(0, a, b));
+
+  int result = (ka->spam_value < kb->spam_value) ?
+                   -1 :
+                   (ka->spam_value > kb->spam_value) ? 1 : 0;
+
+  /* If either attribute has no numeric value, compare lexically */
+  if (!ka->spam_numeric || !kb->spam_numeric)
+    return SORT_CODE(strcmp(ka->spam_rest, kb->spam_rest));
+
+  if (result == 0)
+  {
+    result = strcmp(ka->spam_rest, kb->spam_rest);
+    result = perform_auxsort(result, a, b);
+  }
+
+  return SORT_CODE(result);
+}
+
+/**
+ * sort_keyed - Sort emails using precomputed sort keys
+ * @param m       Mailbox
+ * @param primary Primary sort method, e.g. #SORT_FROM
+ *
+ * Equivalent to sorting with the matching ::sort_t comparator, but the
+ * expensive part of each email's key is computed just once up front.
+ * mutt_get_name() may perform an alias lookup and an IDN conversion, and
+ * compare_spam() calls strtod() twice - far too costly to repeat for every
+ * one of the O(n log n) comparisons.
+ */
+static void sort_keyed(struct Mailbox *m, enum SortType primary)
+{
+  struct KeyedEmail *ke = mutt_mem_calloc(m->msg_count, sizeof(struct KeyedEmail));
+  sort_t cmp = NULL;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    ke[i].email = e;
+    switch (primary)
+    {
+      case SORT_FROM:
+      case SORT_TO:
+      {
+        struct AddressList *al = (primary == SORT_FROM) ? &e->env->from : &e->env->to;
+        ke[i].name = mutt_str_dup(mutt_get_name(TAILQ_FIRST(al)));
+        cmp = compare_keyed_name;
+        break;
+      }
+      case SORT_SPAM:
+      {
+        ke[i].has_spam = e->env && !mutt_buffer_is_empty(&e->env->spam);
+        if (ke[i].has_spam)
+        {
+          char *rest = NULL;
+          ke[i].spam_value = strtod(e->env->spam.data, &rest);
+          ke[i].spam_numeric = (rest != e->env->spam.data);
+          ke[i].spam_rest = rest;
+        }
+        cmp = compare_keyed_spam;
+        break;
+      }
+      default:
+        break; /* not reached */
+    }
+  }
+
+  qsort(ke, m->msg_count, sizeof(struct KeyedEmail), cmp);
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    m->emails[i] = ke[i].email;
+    FREE(&ke[i].name);
+  }
+  FREE(&ke);
+}
+
 /**
  * compare_date_received - Compare the date received of two emails - Implements ::sort_t
  */
@@ -394,6 +531,7 @@ void mutt_sort_headers(struct Mailbox *m, struct ThreadsContext *threads,
       struct Email *e = m->emails[i];
       if (!e)
         break;
+      e->scored = false; /* the rules changed, so any cached score is void */
       mutt_score_message(m, e, true);
     }
   }
@@ -431,10 +569,15 @@ void mutt_sort_headers(struct Mailbox *m, struct ThreadsContext *threads,
   }
   else
   {
-    qsort((void *) m->emails, m->msg_count, sizeof(struct Email *), sortfunc);
+    const enum SortType primary = C_Sort & SORT_MASK;
+    if ((primary == SORT_FROM) || (primary == SORT_TO) || (primary == SORT_SPAM))
+      sort_keyed(m, primary);
+    else
+      qsort((void *) m->emails, m->msg_count, sizeof(struct Email *), sortfunc);
   }
 
   /* adjust the virtual message numbers */
+  const bool threaded = ((C_Sort & SORT_MASK) == SORT_THREADS);
   m->vcount = 0;
   for (int i = 0; i < m->msg_count; i++)
   {
@@ -444,15 +587,27 @@ void mutt_sort_headers(struct Mailbox *m, struct ThreadsContext *threads,
 
     if ((e_cur->vnum != -1) || (e_cur->collapsed && e_cur->visible))
     {
-      e_cur->vnum = m->vcount;
-      m->v2r[m->vcount] = i;
-      m->vcount++;
+      if (threaded)
+      {
+        /* mutt_set_vnum() below renumbers the view from scratch, so don't
+         * bother compacting v2r here - the collapse pass only needs to know
+         * which messages are in the view (vnum != -1) and their msgno */
+        e_cur->vnum = i;
+      }
+      else
+      {
+        e_cur->vnum = m->vcount;
+        m->v2r[m->vcount] = i;
+        m->vcount++;
+      }
     }
     e_cur->msgno = i;
   }
 
+  IndexLineGen++; /* sorting renumbered the messages */
+
   /* re-collapse threads marked as collapsed */
-  if ((C_Sort & SORT_MASK) == SORT_THREADS)
+  if (threaded)
   {
     mutt_thread_collapse_collapsed(threads);
     *vsize = mutt_set_vnum(m);
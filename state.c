@@ -176,5 +176,5 @@ void state_prefix_put(struct State *s, const char *buf, size_t buflen)
       state_prefix_putc(s, *buf++);
   }
   else
-    fwrite(buf, buflen, 1, s->fp_out);
+    state_write(s, buf, buflen);
 }
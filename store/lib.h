@@ -53,6 +53,7 @@
 #define MUTT_STORE_LIB_H
 
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 /**
@@ -127,7 +128,9 @@ struct StoreOps
   const char *(*version)(void);
 };
 
+const struct StoreOps *store_auto_backend_ops(const char *dir);
 const char *           store_backend_list(void);
+const struct StoreOps *store_benchmark(const char *dir, FILE *fp);
 const struct StoreOps *store_get_backend_ops(const char *str);
 bool                   store_is_valid_backend(const char *str);
 
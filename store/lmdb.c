@@ -40,6 +40,13 @@
  * The file is mmap(2)'d into memory. */
 const size_t LMDB_DB_SIZE = 2147483648;
 
+/** Number of writes after which the write transaction is committed.
+ * LMDB permits only one write transaction per environment across all
+ * processes, so holding ours open for the whole session would lock out every
+ * other neomutt instance sharing the cache (and hide our entries from them
+ * until exit). */
+const size_t LMDB_COMMIT_LIMIT = 1000;
+
 /**
  * enum MdbTxnMode - LMDB transaction state
  */
@@ -59,8 +66,33 @@ struct StoreLmdbCtx
   MDB_txn *txn;
   MDB_dbi db;
   enum MdbTxnMode txn_mode;
+  size_t dirty; ///< Writes in the current write transaction
 };
 
+/**
+ * mdb_commit_full_txn - Commit the write transaction once it's big enough
+ * @param ctx LMDB context
+ * @retval num LMDB return code, e.g. MDB_SUCCESS
+ *
+ * Committing every #LMDB_COMMIT_LIMIT writes keeps the per-write overhead low
+ * while releasing the environment's single writer lock often enough for other
+ * processes to get a turn.
+ */
+static int mdb_commit_full_txn(struct StoreLmdbCtx *ctx)
+{
+  if ((ctx->txn_mode != TXN_WRITE) || (ctx->dirty < LMDB_COMMIT_LIMIT))
+    return MDB_SUCCESS;
+
+  int rc = mdb_txn_commit(ctx->txn);
+  if (rc != MDB_SUCCESS)
+    mutt_debug(LL_DEBUG2, "mdb_txn_commit: %s\n", mdb_strerror(rc));
+
+  ctx->txn_mode = TXN_UNINITIALIZED;
+  ctx->txn = NULL;
+  ctx->dirty = 0;
+  return rc;
+}
+
 /**
  * mdb_get_r_txn - Get an LMDB read transaction
  * @param ctx LMDB context
@@ -251,8 +283,11 @@ static int store_lmdb_store(void *store, const char *key, size_t klen, void *val
     mdb_txn_abort(ctx->txn);
     ctx->txn_mode = TXN_UNINITIALIZED;
     ctx->txn = NULL;
+    ctx->dirty = 0;
+    return rc;
   }
-  return rc;
+  ctx->dirty++;
+  return mdb_commit_full_txn(ctx);
 }
 
 /**
@@ -282,9 +317,13 @@ static int store_lmdb_delete_record(void *store, const char *key, size_t klen)
     mdb_txn_abort(ctx->txn);
     ctx->txn_mode = TXN_UNINITIALIZED;
     ctx->txn = NULL;
+    ctx->dirty = 0;
+    return rc;
   }
-
-  return rc;
+  if (rc == MDB_NOTFOUND)
+    return rc;
+  ctx->dirty++;
+  return mdb_commit_full_txn(ctx);
 }
 
 /**
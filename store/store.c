@@ -28,11 +28,19 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "mutt/lib.h"
 #include "lib.h"
 
+/// Number of records used by store_benchmark()
+#define BENCH_RECORDS 1000
+/// Size of each benchmark Value - roughly a serialised Email
+#define BENCH_VALUE_SIZE 1024
+
 #define STORE_BACKEND(name) extern const struct StoreOps store_##name##_ops;
 STORE_BACKEND(bdb)
 STORE_BACKEND(gdbm)
@@ -128,5 +136,194 @@ const struct StoreOps *store_get_backend_ops(const char *str)
  */
 bool store_is_valid_backend(const char *str)
 {
+  if (mutt_istr_equal(str, "auto"))
+    return store_ops[0];
   return store_get_backend_ops(str);
 }
+
+/**
+ * bench_remove - Delete a scratch benchmark database
+ * @param path Path of the database (a file, or a directory for lmdb)
+ */
+static void bench_remove(const char *path)
+{
+  struct stat st = { 0 };
+  if (stat(path, &st) != 0)
+    return;
+
+  if (S_ISDIR(st.st_mode))
+    mutt_file_rmtree(path);
+  else
+    unlink(path);
+}
+
+/**
+ * bench_rate - Records per second for one timed phase
+ * @param ms Elapsed milliseconds
+ * @retval num Records per second
+ */
+static double bench_rate(uint64_t ms)
+{
+  return (BENCH_RECORDS * 1000.0) / MAX(1, ms);
+}
+
+/**
+ * store_benchmark - Measure every compiled backend on a filesystem
+ * @param dir Directory for the scratch databases, e.g. `$header_cache`
+ * @param fp  File to write a report to (may be NULL)
+ * @retval ptr  StoreOps of the backend with the best overall time
+ * @retval NULL No backend completed the benchmark
+ *
+ * Each backend batch-writes #BENCH_RECORDS envelope-sized values into a
+ * scratch database under @a dir, fetches them back in a scrambled order,
+ * re-reads them sequentially and finally deletes them.  The databases are
+ * removed afterwards.  Running this on the filesystem the real cache lives
+ * on is the point - the ranking on NFS and on a local disk can differ
+ * wildly.
+ *
+ * @note The StoreOps API has no cursor, so the sweep phase is a sequential
+ *       re-fetch rather than an iterator walk.
+ */
+const struct StoreOps *store_benchmark(const char *dir, FILE *fp)
+{
+  if (!dir || (*dir == '\0'))
+    return NULL;
+
+  const struct StoreOps *best = NULL;
+  uint64_t best_ms = UINT64_MAX;
+
+  char value[BENCH_VALUE_SIZE];
+  for (size_t i = 0; i < sizeof(value); i++)
+    value[i] = 'a' + (i % 26);
+
+  if (fp)
+  {
+    fprintf(fp, "# %d records of %d bytes in %s\n", BENCH_RECORDS, BENCH_VALUE_SIZE, dir);
+    fprintf(fp, "%-14s %10s %10s %10s %10s\n", "backend", "write/s",
+            "fetch/s", "sweep/s", "delete/s");
+  }
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  for (const struct StoreOps **sops = store_ops; *sops; sops++)
+  {
+    const struct StoreOps *ops = *sops;
+    mutt_buffer_printf(path, "%s/neomutt-bench-%s", dir, ops->name);
+    bench_remove(mutt_b2s(path));
+
+    void *db = ops->open(mutt_b2s(path));
+    if (!db)
+    {
+      if (fp)
+        fprintf(fp, "%-14s can't open %s\n", ops->name, mutt_b2s(path));
+      continue;
+    }
+
+    char key[32];
+    int errors = 0;
+    uint64_t t[4] = { 0 };
+
+    uint64_t start = mutt_date_epoch_ms();
+    for (int i = 0; i < BENCH_RECORDS; i++)
+    {
+      const size_t klen = snprintf(key, sizeof(key), "email%06d", i);
+      if (ops->store(db, key, klen, value, sizeof(value)) != 0)
+        errors++;
+    }
+    t[0] = mutt_date_epoch_ms() - start;
+
+    start = mutt_date_epoch_ms();
+    for (int i = 0; i < BENCH_RECORDS; i++)
+    {
+      const size_t klen =
+          snprintf(key, sizeof(key), "email%06d", (i * 7919) % BENCH_RECORDS);
+      size_t vlen = 0;
+      void *blob = ops->fetch(db, key, klen, &vlen);
+      if (!blob || (vlen != sizeof(value)))
+        errors++;
+      if (blob)
+        ops->free(db, &blob);
+    }
+    t[1] = mutt_date_epoch_ms() - start;
+
+    start = mutt_date_epoch_ms();
+    for (int i = 0; i < BENCH_RECORDS; i++)
+    {
+      const size_t klen = snprintf(key, sizeof(key), "email%06d", i);
+      size_t vlen = 0;
+      void *blob = ops->fetch(db, key, klen, &vlen);
+      if (!blob)
+        errors++;
+      else
+        ops->free(db, &blob);
+    }
+    t[2] = mutt_date_epoch_ms() - start;
+
+    start = mutt_date_epoch_ms();
+    for (int i = 0; i < BENCH_RECORDS; i++)
+    {
+      const size_t klen = snprintf(key, sizeof(key), "email%06d", i);
+      if (ops->delete_record(db, key, klen) != 0)
+        errors++;
+    }
+    t[3] = mutt_date_epoch_ms() - start;
+
+    ops->close(&db);
+    bench_remove(mutt_b2s(path));
+
+    if (errors != 0)
+    {
+      if (fp)
+        fprintf(fp, "%-14s %d errors\n", ops->name, errors);
+      continue;
+    }
+
+    if (fp)
+    {
+      fprintf(fp, "%-14s %10.0f %10.0f %10.0f %10.0f\n", ops->name,
+              bench_rate(t[0]), bench_rate(t[1]), bench_rate(t[2]), bench_rate(t[3]));
+    }
+
+    const uint64_t total = t[0] + t[1] + t[2] + t[3];
+    if (total < best_ms)
+    {
+      best_ms = total;
+      best = ops;
+    }
+  }
+  mutt_buffer_pool_release(&path);
+
+  if (fp)
+  {
+    if (best)
+      fprintf(fp, "\nfastest here: set header_cache_backend=%s\n", best->name);
+    else
+      fprintf(fp, "\nno backend completed the benchmark\n");
+  }
+
+  return best;
+}
+
+/**
+ * store_auto_backend_ops - Pick the fastest backend for a filesystem
+ * @param dir Directory the database will live in
+ * @retval ptr  StoreOps of the backend that measured fastest
+ * @retval NULL No backend is compiled in
+ *
+ * Backs `set header_cache_backend=auto`.  The benchmark runs once per
+ * process, on first use, and the winner is kept for all later opens.
+ */
+const struct StoreOps *store_auto_backend_ops(const char *dir)
+{
+  static const struct StoreOps *winner = NULL;
+
+  if (!winner)
+  {
+    winner = store_benchmark(dir, NULL);
+    if (winner)
+      mutt_debug(LL_DEBUG1, "auto-selected store backend: %s\n", winner->name);
+    else
+      winner = store_ops[0]; /* measured nothing, use the default choice */
+  }
+
+  return winner;
+}
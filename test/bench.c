@@ -0,0 +1,334 @@
+/**
+ * @file
+ * Timed benchmarks for hot parsing and serialization kernels
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page test_bench Kernel benchmarks
+ *
+ * Wall-clock benchmarks (`make bench`) for the kernels that dominate folder
+ * opens and header caching.  These measure throughput only - correctness is
+ * the unit tests' job - so a run before and after a change to any of these
+ * paths gives a regression number per commit.
+ */
+
+#define MAIN_C 1
+#include "config.h"
+#include <locale.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "email/lib.h"
+#include "pattern/lib.h"
+#include "mutt_globals.h"
+#ifdef USE_HCACHE
+#include "hcache/serialize.h"
+#endif
+
+/* number of synthetic messages in the parsing corpus */
+#define BENCH_CORPUS 2000
+
+typedef uint16_t MuttRedrawFlags;
+
+/**
+ * mutt_menu_set_current_redraw - Dummy - the bench has no menus
+ */
+void mutt_menu_set_current_redraw(MuttRedrawFlags redraw)
+{
+}
+
+/**
+ * mutt_menu_set_current_redraw_full - Dummy - the bench has no menus
+ */
+void mutt_menu_set_current_redraw_full(void)
+{
+}
+
+/**
+ * bench_report - Print one result line
+ * @param name  Name of the benchmark
+ * @param items Number of items processed
+ * @param ms    Elapsed wall-clock milliseconds
+ */
+static void bench_report(const char *name, size_t items, uint64_t ms)
+{
+  if (ms == 0)
+    ms = 1;
+  printf("%-28s %10zu items %8zu ms %12.0f items/s\n", name, items, (size_t) ms,
+         (double) items * 1000.0 / (double) ms);
+}
+
+/**
+ * corpus_create - Write a corpus of synthetic message headers
+ * @retval ptr Open file, rewound to the start
+ *
+ * The headers carry the fields the real parser spends its time on: addresses,
+ * encoded words, References and a few trace headers.
+ */
+static FILE *corpus_create(void)
+{
+  FILE *fp = mutt_file_mkstemp();
+  if (!fp)
+  {
+    perror("mkstemp");
+    exit(1);
+  }
+
+  for (int i = 0; i < BENCH_CORPUS; i++)
+  {
+    fprintf(fp, "Return-Path: <bounce-%d@lists.example.org>\n", i);
+    fprintf(fp, "Received: from mx%d.example.org (mx%d.example.org [10.0.0.%d])\n"
+                "\tby mail.example.net with ESMTPS id %08x\n"
+                "\tfor <user@example.net>; Thu, 11 Mar 2021 12:%02d:%02d +0000\n",
+            i % 9, i % 9, i % 250, i * 2654435761u, i % 60, (i * 7) % 60);
+    fprintf(fp, "From: =?utf-8?Q?J=C3=BCrgen_M=C3=BCller?= <sender-%d@example.org>\n", i);
+    fprintf(fp, "To: Alice Example <user@example.net>, bob-%d@example.com\n", i % 50);
+    fprintf(fp, "Subject: Re: [list] =?utf-8?B?c3ludGhldGljIGJlbmNobWFyaw==?= thread %d\n",
+            i % 100);
+    fprintf(fp, "Date: Thu, 11 Mar 2021 12:%02d:%02d +0000\n", i % 60, (i * 13) % 60);
+    fprintf(fp, "Message-ID: <msg-%d@example.org>\n", i);
+    if (i % 100)
+    {
+      fprintf(fp, "In-Reply-To: <msg-%d@example.org>\n", i - 1);
+      fprintf(fp, "References: <msg-%d@example.org> <msg-%d@example.org>\n",
+              (i / 100) * 100, i - 1);
+    }
+    fprintf(fp, "MIME-Version: 1.0\n");
+    fprintf(fp, "Content-Type: text/plain; charset=\"utf-8\"\n");
+    fprintf(fp, "X-Spam-Status: No, score=-%d.%d\n", i % 4, i % 10);
+    fprintf(fp, "\n"); /* end of header - the next call starts at the next message */
+  }
+
+  rewind(fp);
+  return fp;
+}
+
+/**
+ * bench_rfc822_read_header - Time mutt_rfc822_read_header()
+ */
+static void bench_rfc822_read_header(void)
+{
+  FILE *fp = corpus_create();
+  const int passes = 20;
+
+  const uint64_t start = mutt_date_epoch_ms();
+  for (int p = 0; p < passes; p++)
+  {
+    rewind(fp);
+    for (int i = 0; i < BENCH_CORPUS; i++)
+    {
+      struct Email *e = email_new();
+      e->env = mutt_rfc822_read_header(fp, e, false, false);
+      email_free(&e);
+    }
+  }
+  bench_report("mutt_rfc822_read_header", (size_t) passes * BENCH_CORPUS,
+               mutt_date_epoch_ms() - start);
+
+  mutt_file_fclose(&fp);
+}
+
+/**
+ * bench_rfc2047_decode - Time rfc2047_decode()
+ */
+static void bench_rfc2047_decode(void)
+{
+  static const char *samples[] = {
+    "=?utf-8?Q?J=C3=BCrgen_M=C3=BCller?= <j@example.org>",
+    "=?utf-8?B?c3ludGhldGljIGJlbmNobWFyayBzdWJqZWN0IGxpbmU=?=",
+    "=?iso-8859-1?Q?caf=E9_=E0_la_carte?= and plain trailing text",
+    "plain subject with no encoded words at all, the common case",
+  };
+  const size_t iters = 200000;
+
+  const uint64_t start = mutt_date_epoch_ms();
+  for (size_t i = 0; i < iters; i++)
+  {
+    char *s = mutt_str_dup(samples[i % mutt_array_size(samples)]);
+    rfc2047_decode(&s);
+    FREE(&s);
+  }
+  bench_report("rfc2047_decode", iters, mutt_date_epoch_ms() - start);
+}
+
+/**
+ * bench_b64_decode - Time mutt_b64_encode() and mutt_b64_decode()
+ */
+static void bench_b64_decode(void)
+{
+  const size_t rawlen = 65536;
+  char *raw = mutt_mem_malloc(rawlen);
+  for (size_t i = 0; i < rawlen; i++)
+    raw[i] = (char) (i * 131);
+
+  const size_t enclen = (rawlen / 3 + 1) * 4 + 1;
+  char *enc = mutt_mem_malloc(enclen);
+  mutt_b64_encode(raw, rawlen, enc, enclen);
+
+  char *dec = mutt_mem_malloc(rawlen + 4);
+  const size_t iters = 2000;
+
+  uint64_t start = mutt_date_epoch_ms();
+  for (size_t i = 0; i < iters; i++)
+    mutt_b64_encode(raw, rawlen, enc, enclen);
+  bench_report("mutt_b64_encode (64KiB)", iters, mutt_date_epoch_ms() - start);
+
+  start = mutt_date_epoch_ms();
+  for (size_t i = 0; i < iters; i++)
+  {
+    if (mutt_b64_decode(enc, dec, rawlen + 4) < 0)
+    {
+      fprintf(stderr, "b64 roundtrip failed\n");
+      exit(1);
+    }
+  }
+  bench_report("mutt_b64_decode (64KiB)", iters, mutt_date_epoch_ms() - start);
+
+  FREE(&raw);
+  FREE(&enc);
+  FREE(&dec);
+}
+
+/**
+ * corpus_email - Create one synthetic parsed Email
+ * @param i Seed for the synthetic fields
+ * @retval ptr New Email
+ */
+static struct Email *corpus_email(int i)
+{
+  struct Email *e = email_new();
+  e->env = mutt_env_new();
+
+  char buf[128];
+  snprintf(buf, sizeof(buf), "Jürgen Müller <sender-%d@example.org>", i);
+  mutt_addrlist_parse(&e->env->from, buf);
+  snprintf(buf, sizeof(buf), "user@example.net, bob-%d@example.com", i % 50);
+  mutt_addrlist_parse(&e->env->to, buf);
+  snprintf(buf, sizeof(buf), "Re: [list] synthetic benchmark thread %d", i % 100);
+  e->env->subject = mutt_str_dup(buf);
+  snprintf(buf, sizeof(buf), "<msg-%d@example.org>", i);
+  e->env->message_id = mutt_str_dup(buf);
+
+  return e;
+}
+
+/**
+ * bench_pattern_exec - Time mutt_pattern_comp() and mutt_pattern_exec()
+ */
+static void bench_pattern_exec(void)
+{
+  struct Buffer err = mutt_buffer_make(256);
+  const char *pattern = "(~s benchmark ~f example.org) | ~C bob-7@example.com";
+
+  const size_t comp_iters = 20000;
+  uint64_t start = mutt_date_epoch_ms();
+  for (size_t i = 0; i < comp_iters; i++)
+  {
+    struct PatternList *pat = mutt_pattern_comp(pattern, 0, &err);
+    if (!pat)
+    {
+      fprintf(stderr, "pattern comp failed: %s\n", mutt_b2s(&err));
+      exit(1);
+    }
+    mutt_pattern_free(&pat);
+  }
+  bench_report("mutt_pattern_comp", comp_iters, mutt_date_epoch_ms() - start);
+
+  struct Email *emails[100];
+  for (int i = 0; i < 100; i++)
+    emails[i] = corpus_email(i);
+
+  struct PatternList *pat = mutt_pattern_comp(pattern, 0, &err);
+  const size_t exec_iters = 2000;
+  start = mutt_date_epoch_ms();
+  for (size_t i = 0; i < exec_iters; i++)
+  {
+    for (int j = 0; j < 100; j++)
+    {
+      mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, NULL,
+                        emails[j], NULL);
+    }
+  }
+  bench_report("mutt_pattern_exec", exec_iters * 100, mutt_date_epoch_ms() - start);
+
+  mutt_pattern_free(&pat);
+  for (int i = 0; i < 100; i++)
+    email_free(&emails[i]);
+  mutt_buffer_dealloc(&err);
+}
+
+#ifdef USE_HCACHE
+/**
+ * bench_serial_envelope - Time serial_dump_envelope() / serial_restore_envelope()
+ */
+static void bench_serial_envelope(void)
+{
+  struct Email *e = corpus_email(42);
+  const size_t iters = 100000;
+
+  uint64_t start = mutt_date_epoch_ms();
+  for (size_t i = 0; i < iters; i++)
+  {
+    int off = 0;
+    unsigned char *d = mutt_mem_malloc(4096);
+    d = serial_dump_envelope(e->env, d, &off, false);
+    FREE(&d);
+  }
+  bench_report("serial_dump_envelope", iters, mutt_date_epoch_ms() - start);
+
+  int off = 0;
+  unsigned char *d = mutt_mem_malloc(4096);
+  d = serial_dump_envelope(e->env, d, &off, false);
+
+  start = mutt_date_epoch_ms();
+  for (size_t i = 0; i < iters; i++)
+  {
+    struct Envelope *env = mutt_env_new();
+    int roff = 0;
+    serial_restore_envelope(env, d, &roff, false);
+    mutt_env_free(&env);
+  }
+  bench_report("serial_restore_envelope", iters, mutt_date_epoch_ms() - start);
+
+  FREE(&d);
+  email_free(&e);
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  setlocale(LC_ALL, "");
+  C_Charset = "utf-8";
+
+  printf("neomutt benchmarks - wall-clock, single run, not statistically robust\n\n");
+
+  bench_rfc822_read_header();
+  bench_rfc2047_decode();
+  bench_b64_decode();
+  bench_pattern_exec();
+#ifdef USE_HCACHE
+  bench_serial_envelope();
+#endif
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file
+ * Test code for mutt_env_content_hash()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "email/lib.h"
+
+void test_mutt_env_content_hash(void)
+{
+  // uint64_t mutt_env_content_hash(struct Envelope *env);
+
+  {
+    TEST_CHECK(mutt_env_content_hash(NULL) == 0);
+  }
+
+  {
+    /* Identical Envelopes hash the same, and the hash is remembered */
+    struct Envelope *env1 = mutt_env_new();
+    struct Envelope *env2 = mutt_env_new();
+
+    env1->message_id = mutt_str_dup("<apple@example.com>");
+    env1->subject = mutt_str_dup("Apples");
+    mutt_addrlist_parse(&env1->from, "john@example.com");
+
+    env2->message_id = mutt_str_dup("<apple@example.com>");
+    env2->subject = mutt_str_dup("Apples");
+    mutt_addrlist_parse(&env2->from, "john@example.com");
+
+    const uint64_t hash1 = mutt_env_content_hash(env1);
+    const uint64_t hash2 = mutt_env_content_hash(env2);
+    TEST_CHECK(hash1 != 0);
+    TEST_CHECK(hash1 == hash2);
+    TEST_CHECK(env1->content_hash == hash1);
+    TEST_CHECK(mutt_env_content_hash(env1) == hash1);
+    TEST_CHECK(mutt_env_cmp_strict(env1, env2));
+
+    /* A changed field gives a different hash, once the cache is reset */
+    mutt_str_replace(&env2->subject, "Bananas");
+    env2->content_hash = 0;
+    TEST_CHECK(mutt_env_content_hash(env2) != hash1);
+    TEST_CHECK(!mutt_env_cmp_strict(env1, env2));
+
+    mutt_env_free(&env1);
+    mutt_env_free(&env2);
+  }
+
+  {
+    /* Fields that mutt_env_cmp_strict() ignores don't affect the hash */
+    struct Envelope *env1 = mutt_env_new();
+    struct Envelope *env2 = mutt_env_new();
+
+    env1->message_id = mutt_str_dup("<pear@example.com>");
+    env2->message_id = mutt_str_dup("<pear@example.com>");
+    env2->x_label = mutt_str_dup("fruit");
+
+    TEST_CHECK(mutt_env_content_hash(env1) == mutt_env_content_hash(env2));
+
+    mutt_env_free(&env1);
+    mutt_env_free(&env2);
+  }
+}
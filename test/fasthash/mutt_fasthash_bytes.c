@@ -0,0 +1,56 @@
+/**
+ * @file
+ * Test code for mutt_fasthash_bytes()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+void test_mutt_fasthash_bytes(void)
+{
+  // uint64_t mutt_fasthash_bytes(const void *buf, size_t buflen, uint64_t hash);
+
+  {
+    TEST_CHECK(mutt_fasthash_bytes(NULL, 10, MUTT_FASTHASH_INIT) == MUTT_FASTHASH_INIT);
+  }
+
+  {
+    /* Empty input leaves the state untouched */
+    TEST_CHECK(mutt_fasthash_bytes("apple", 0, MUTT_FASTHASH_INIT) == MUTT_FASTHASH_INIT);
+  }
+
+  {
+    /* FNV-1a 64-bit reference values */
+    TEST_CHECK(mutt_fasthash_bytes("a", 1, MUTT_FASTHASH_INIT) == 0xaf63dc4c8601ec8cULL);
+    TEST_CHECK(mutt_fasthash_bytes("apple", 5, MUTT_FASTHASH_INIT) == 0xf74a62a458befdbfULL);
+
+    const unsigned char raw[] = { 0x00, 0x01, 0x02, 0xff };
+    TEST_CHECK(mutt_fasthash_bytes(raw, sizeof(raw), MUTT_FASTHASH_INIT) == 0x4475de7f98e17855ULL);
+  }
+
+  {
+    /* Hashing piecewise matches hashing in one go */
+    uint64_t hash = mutt_fasthash_bytes("ap", 2, MUTT_FASTHASH_INIT);
+    hash = mutt_fasthash_bytes("ple", 3, hash);
+    TEST_CHECK(hash == mutt_fasthash_bytes("apple", 5, MUTT_FASTHASH_INIT));
+  }
+}
@@ -0,0 +1,47 @@
+/**
+ * @file
+ * Test code for mutt_fasthash_istr()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+void test_mutt_fasthash_istr(void)
+{
+  // uint64_t mutt_fasthash_istr(const char *str, uint64_t hash);
+
+  {
+    TEST_CHECK(mutt_fasthash_istr(NULL, MUTT_FASTHASH_INIT) == MUTT_FASTHASH_INIT);
+  }
+
+  {
+    /* Case differences don't change the hash */
+    TEST_CHECK(mutt_fasthash_istr("ApPlE", MUTT_FASTHASH_INIT) ==
+               mutt_fasthash_istr("apple", MUTT_FASTHASH_INIT));
+  }
+
+  {
+    /* Lower-case input matches the case-sensitive hash */
+    TEST_CHECK(mutt_fasthash_istr("apple", MUTT_FASTHASH_INIT) ==
+               mutt_fasthash_str("apple", MUTT_FASTHASH_INIT));
+  }
+}
@@ -0,0 +1,50 @@
+/**
+ * @file
+ * Test code for mutt_fasthash_str()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+void test_mutt_fasthash_str(void)
+{
+  // uint64_t mutt_fasthash_str(const char *str, uint64_t hash);
+
+  {
+    TEST_CHECK(mutt_fasthash_str(NULL, MUTT_FASTHASH_INIT) == MUTT_FASTHASH_INIT);
+  }
+
+  {
+    TEST_CHECK(mutt_fasthash_str("", MUTT_FASTHASH_INIT) == MUTT_FASTHASH_INIT);
+  }
+
+  {
+    /* Matches the byte hash of the same data */
+    TEST_CHECK(mutt_fasthash_str("apple", MUTT_FASTHASH_INIT) ==
+               mutt_fasthash_bytes("apple", 5, MUTT_FASTHASH_INIT));
+  }
+
+  {
+    TEST_CHECK(mutt_fasthash_str("apple", MUTT_FASTHASH_INIT) !=
+               mutt_fasthash_str("banana", MUTT_FASTHASH_INIT));
+  }
+}
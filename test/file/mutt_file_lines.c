@@ -0,0 +1,114 @@
+/**
+ * @file
+ * Test code for mutt_file_lines_load()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+#include "common.h"
+
+void test_mutt_file_lines(void)
+{
+  // bool mutt_file_lines_load(struct MuttFileLines *fl, FILE *fp);
+  // char *mutt_file_lines_next(struct MuttFileLines *fl);
+  // void mutt_file_lines_free(struct MuttFileLines *fl);
+
+  {
+    FILE fp = { 0 };
+    TEST_CHECK(!mutt_file_lines_load(NULL, &fp));
+  }
+
+  {
+    struct MuttFileLines fl = { 0 };
+    TEST_CHECK(!mutt_file_lines_load(&fl, NULL));
+    TEST_CHECK(!mutt_file_lines_next(&fl));
+    mutt_file_lines_free(&fl);
+  }
+
+  {
+    TEST_CHECK(!mutt_file_lines_next(NULL));
+    mutt_file_lines_free(NULL);
+  }
+
+  {
+    FILE *fp = SET_UP();
+    if (!fp)
+      return;
+    struct MuttFileLines fl = { 0 };
+    TEST_CHECK(mutt_file_lines_load(&fl, fp));
+    for (int i = 0; file_lines[i]; i++)
+    {
+      char *line = mutt_file_lines_next(&fl);
+      if (!TEST_CHECK(line != NULL))
+      {
+        TEST_MSG("Expected: %s", file_lines[i]);
+        TEST_MSG("Actual: NULL");
+        break;
+      }
+      if (!TEST_CHECK(strcmp(line, file_lines[i]) == 0))
+      {
+        TEST_MSG("Expected: %s", file_lines[i]);
+        TEST_MSG("Actual: %s", line);
+      }
+      if (!TEST_CHECK(fl.line_num == (i + 1)))
+      {
+        TEST_MSG("Expected: %d", i + 1);
+        TEST_MSG("Actual: %d", fl.line_num);
+      }
+    }
+    TEST_CHECK(!mutt_file_lines_next(&fl));
+    mutt_file_lines_free(&fl);
+    TEAR_DOWN(fp);
+  }
+
+  {
+    /* "\r\n" endings and a last line without one */
+    FILE *fp = tmpfile();
+    if (!fp)
+      return;
+    fputs("apple\r\nbanana\n\ncherry", fp);
+    rewind(fp);
+
+    struct MuttFileLines fl = { 0 };
+    TEST_CHECK(mutt_file_lines_load(&fl, fp));
+    TEST_CHECK(mutt_str_equal(mutt_file_lines_next(&fl), "apple"));
+    TEST_CHECK(mutt_str_equal(mutt_file_lines_next(&fl), "banana"));
+    TEST_CHECK(mutt_str_equal(mutt_file_lines_next(&fl), ""));
+    TEST_CHECK(mutt_str_equal(mutt_file_lines_next(&fl), "cherry"));
+    TEST_CHECK(!mutt_file_lines_next(&fl));
+    TEST_CHECK(fl.line_num == 4);
+    mutt_file_lines_free(&fl);
+    fclose(fp);
+  }
+
+  {
+    /* an empty file has no lines */
+    FILE *fp = tmpfile();
+    if (!fp)
+      return;
+    struct MuttFileLines fl = { 0 };
+    TEST_CHECK(mutt_file_lines_load(&fl, fp));
+    TEST_CHECK(!mutt_file_lines_next(&fl));
+    mutt_file_lines_free(&fl);
+    fclose(fp);
+  }
+}
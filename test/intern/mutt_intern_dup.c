@@ -0,0 +1,52 @@
+/**
+ * @file
+ * Test code for mutt_intern_dup()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+void test_mutt_intern_dup(void)
+{
+  // char *mutt_intern_dup(const char *str);
+
+  {
+    TEST_CHECK(!mutt_intern_dup(NULL));
+  }
+
+  {
+    char *apple1 = mutt_intern_dup("apple");
+    char *apple2 = mutt_intern_dup("apple");
+    char *banana = mutt_intern_dup("banana");
+
+    TEST_CHECK(apple1 != NULL);
+    TEST_CHECK(apple1 == apple2);
+    TEST_CHECK(banana != apple1);
+    TEST_CHECK(mutt_str_equal(apple1, "apple"));
+    TEST_CHECK(mutt_str_equal(banana, "banana"));
+
+    mutt_intern_release(&apple1);
+    mutt_intern_release(&apple2);
+    mutt_intern_release(&banana);
+    mutt_intern_cleanup();
+  }
+}
@@ -0,0 +1,53 @@
+/**
+ * @file
+ * Test code for mutt_intern_list_free()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+void test_mutt_intern_list_free(void)
+{
+  // void mutt_intern_list_free(struct ListHead *h);
+
+  {
+    mutt_intern_list_free(NULL);
+    TEST_CHECK_(1, "mutt_intern_list_free(NULL)");
+  }
+
+  {
+    struct ListHead lh = STAILQ_HEAD_INITIALIZER(lh);
+    mutt_intern_list_free(&lh);
+    TEST_CHECK_(1, "mutt_intern_list_free(&lh)");
+  }
+
+  {
+    /* interned and plain strings may share one List */
+    struct ListHead lh = STAILQ_HEAD_INITIALIZER(lh);
+    mutt_list_insert_tail(&lh, mutt_intern_dup("apple"));
+    mutt_list_insert_tail(&lh, mutt_intern_dup("apple"));
+    mutt_list_insert_tail(&lh, mutt_str_dup("banana"));
+    mutt_intern_list_free(&lh);
+    TEST_CHECK(STAILQ_EMPTY(&lh));
+    mutt_intern_cleanup();
+  }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file
+ * Test code for mutt_intern_release()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+void test_mutt_intern_release(void)
+{
+  // void mutt_intern_release(char **ptr);
+
+  {
+    mutt_intern_release(NULL);
+    TEST_CHECK_(1, "mutt_intern_release(NULL)");
+  }
+
+  {
+    char *ptr = NULL;
+    mutt_intern_release(&ptr);
+    TEST_CHECK_(1, "mutt_intern_release(&ptr)");
+  }
+
+  {
+    /* a plain heap string is simply freed */
+    char *plain = mutt_str_dup("apple");
+    mutt_intern_release(&plain);
+    TEST_CHECK(plain == NULL);
+  }
+
+  {
+    /* a heap duplicate of an interned string must not disturb the refcount */
+    char *apple = mutt_intern_dup("apple");
+    char *plain = mutt_str_dup("apple");
+    mutt_intern_release(&plain);
+    TEST_CHECK(plain == NULL);
+    TEST_CHECK(mutt_str_equal(apple, "apple"));
+
+    char *again = mutt_intern_dup("apple");
+    TEST_CHECK(again == apple);
+    mutt_intern_release(&again);
+    mutt_intern_release(&apple);
+    mutt_intern_cleanup();
+  }
+}
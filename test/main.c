@@ -192,6 +192,7 @@
                                                                                \
   /* envelope */                                                               \
   NEOMUTT_TEST_ITEM(test_mutt_env_cmp_strict)                                  \
+  NEOMUTT_TEST_ITEM(test_mutt_env_content_hash)                                \
   NEOMUTT_TEST_ITEM(test_mutt_env_free)                                        \
   NEOMUTT_TEST_ITEM(test_mutt_env_merge)                                       \
   NEOMUTT_TEST_ITEM(test_mutt_env_new)                                         \
@@ -205,6 +206,11 @@
   NEOMUTT_TEST_ITEM(test_mutt_envlist_set)                                     \
   NEOMUTT_TEST_ITEM(test_mutt_envlist_unset)                                   \
                                                                                \
+  /* fasthash */                                                               \
+  NEOMUTT_TEST_ITEM(test_mutt_fasthash_bytes)                                  \
+  NEOMUTT_TEST_ITEM(test_mutt_fasthash_istr)                                   \
+  NEOMUTT_TEST_ITEM(test_mutt_fasthash_str)                                    \
+                                                                               \
   /* file */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_buffer_file_expand_fmt_quote)                    \
   NEOMUTT_TEST_ITEM(test_mutt_buffer_quote_filename)                           \
@@ -224,6 +230,7 @@
   NEOMUTT_TEST_ITEM(test_mutt_file_get_size)                                   \
   NEOMUTT_TEST_ITEM(test_mutt_file_get_stat_timespec)                          \
   NEOMUTT_TEST_ITEM(test_mutt_file_iter_line)                                  \
+  NEOMUTT_TEST_ITEM(test_mutt_file_lines)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_file_lock)                                       \
   NEOMUTT_TEST_ITEM(test_mutt_file_map_lines)                                  \
   NEOMUTT_TEST_ITEM(test_mutt_file_mkdir)                                      \
@@ -307,6 +314,11 @@
   NEOMUTT_TEST_ITEM(test_mutt_idna_print_version)                              \
   NEOMUTT_TEST_ITEM(test_mutt_idna_to_ascii_lz)                                \
                                                                                \
+  /* intern */                                                                 \
+  NEOMUTT_TEST_ITEM(test_mutt_intern_dup)                                      \
+  NEOMUTT_TEST_ITEM(test_mutt_intern_list_free)                                \
+  NEOMUTT_TEST_ITEM(test_mutt_intern_release)                                  \
+                                                                               \
   /* list */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_list_clear)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_list_compare)                                    \
@@ -395,6 +407,7 @@
   NEOMUTT_TEST_ITEM(test_notify_observer_add)                                  \
   NEOMUTT_TEST_ITEM(test_notify_observer_remove)                               \
   NEOMUTT_TEST_ITEM(test_notify_send)                                          \
+  NEOMUTT_TEST_ITEM(test_notify_send_coalesce)                                 \
   NEOMUTT_TEST_ITEM(test_notify_set_parent)                                    \
                                                                                \
   /* parameter */                                                              \
@@ -499,6 +512,12 @@
   NEOMUTT_TEST_ITEM(test_slist_remove_string)                                  \
   NEOMUTT_TEST_ITEM(test_slist_to_buffer)                                      \
                                                                                \
+  /* stats */                                                                  \
+  NEOMUTT_TEST_ITEM(test_mutt_stats)                                           \
+                                                                               \
+  /* throttle */                                                               \
+  NEOMUTT_TEST_ITEM(test_mutt_throttle)                                        \
+                                                                               \
   /* string */                                                                 \
   NEOMUTT_TEST_ITEM(test_mutt_istr_equal)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_istr_find)                                       \
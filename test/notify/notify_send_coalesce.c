@@ -0,0 +1,81 @@
+/**
+ * @file
+ * Test code for notify_send_coalesce()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+static int CallbackCount = 0;
+static int LastPayload = 0;
+
+static int coalesce_observer(struct NotifyCallback *nc)
+{
+  CallbackCount++;
+  if (nc->event_data)
+    LastPayload = *(int *) nc->event_data;
+  return 0;
+}
+
+void test_notify_send_coalesce(void)
+{
+  // bool notify_send_coalesce(struct Notify *notify, enum NotifyType event_type, int event_subtype, void *event_data, size_t size);
+
+  struct Notify *notify = notify_new();
+  notify_observer_add(notify, NT_ALL, coalesce_observer, NULL);
+
+  int payload = 1;
+
+  {
+    /* Outside a batch, behaves like notify_send() */
+    CallbackCount = 0;
+    TEST_CHECK(notify_send_coalesce(notify, NT_GLOBAL, 1, &payload, sizeof(payload)));
+    TEST_CHECK(CallbackCount == 1);
+  }
+
+  {
+    /* In a batch, duplicates merge and the last payload wins */
+    CallbackCount = 0;
+    notify_begin_batch();
+    for (payload = 1; payload < 6; payload++)
+      TEST_CHECK(notify_send_coalesce(notify, NT_GLOBAL, 1, &payload, sizeof(payload)));
+    TEST_CHECK(CallbackCount == 0);
+    notify_end_batch();
+    TEST_CHECK(CallbackCount == 1);
+    TEST_CHECK(LastPayload == 5);
+  }
+
+  {
+    /* Distinct subtypes don't merge; nested batches defer to the outermost */
+    CallbackCount = 0;
+    notify_begin_batch();
+    notify_begin_batch();
+    TEST_CHECK(notify_send_coalesce(notify, NT_GLOBAL, 1, &payload, sizeof(payload)));
+    TEST_CHECK(notify_send_coalesce(notify, NT_GLOBAL, 2, &payload, sizeof(payload)));
+    notify_end_batch();
+    TEST_CHECK(CallbackCount == 0);
+    notify_end_batch();
+    TEST_CHECK(CallbackCount == 2);
+  }
+
+  notify_free(&notify);
+}
@@ -34,4 +34,34 @@ void test_mutt_matches_ignore(void)
   {
     TEST_CHECK(!mutt_matches_ignore(NULL));
   }
+
+  {
+    mutt_list_insert_tail(&Ignore, mutt_str_dup("x-"));
+    mutt_list_insert_tail(&Ignore, mutt_str_dup("received"));
+    mutt_list_insert_tail(&UnIgnore, mutt_str_dup("x-mailer"));
+    mutt_ignore_invalidate();
+
+    TEST_CHECK(mutt_matches_ignore("X-Spam-Status: No"));
+    TEST_CHECK(mutt_matches_ignore("Received: from example.com"));
+    TEST_CHECK(!mutt_matches_ignore("X-Mailer: NeoMutt"));
+    TEST_CHECK(!mutt_matches_ignore("Subject: hello"));
+    TEST_CHECK(!mutt_matches_ignore("Receive: truncated"));
+
+    mutt_list_free(&Ignore);
+    mutt_list_free(&UnIgnore);
+    mutt_ignore_invalidate();
+  }
+
+  {
+    mutt_list_insert_tail(&Ignore, mutt_str_dup("*"));
+    mutt_list_insert_tail(&UnIgnore, mutt_str_dup("subject"));
+    mutt_ignore_invalidate();
+
+    TEST_CHECK(mutt_matches_ignore("X-Mailer: NeoMutt"));
+    TEST_CHECK(!mutt_matches_ignore("Subject: hello"));
+
+    mutt_list_free(&Ignore);
+    mutt_list_free(&UnIgnore);
+    mutt_ignore_invalidate();
+  }
 }
@@ -33,6 +33,7 @@ struct Buffer;
 struct Email;
 struct EnterState;
 struct Envelope;
+struct HashTable;
 struct Keymap;
 struct Mailbox;
 struct Message;
@@ -53,6 +54,7 @@ bool g_is_mail_list = false;
 bool g_is_subscribed_list = false;
 const char *g_myvar = "hello";
 short AbortKey;
+int LastKey;
 
 enum MenuType
 {
@@ -118,6 +120,11 @@ bool mutt_is_subscribed_list(struct Address *addr)
   return g_is_subscribed_list;
 }
 
+struct HashTable *mutt_make_id_hash(struct Mailbox *m)
+{
+  return NULL;
+}
+
 void mutt_parse_mime_message(struct Mailbox *m, struct Email *e)
 {
 }
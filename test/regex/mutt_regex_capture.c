@@ -28,4 +28,52 @@
 void test_mutt_regex_capture(void)
 {
   // bool mutt_regex_capture(const struct Regex *regex, const char *str,;
+
+  {
+    /* Patterns with a literal prefilter must still match correctly */
+    struct Regex *rx = mutt_regex_compile("^(https?|ftp)://[^ ]+archive[^ ]*$", 0);
+    TEST_CHECK(rx != NULL);
+    TEST_CHECK(mutt_regex_capture(rx, "http://example.com/archive", 0, NULL));
+    TEST_CHECK(!mutt_regex_capture(rx, "http://example.com/index", 0, NULL));
+    TEST_CHECK(!mutt_regex_capture(rx, "archive but no scheme", 0, NULL));
+    mutt_regex_free(&rx);
+  }
+
+  {
+    /* Case-insensitive patterns must screen case-insensitively too */
+    struct Regex *rx = mutt_regex_compile("reply.*needed", REG_ICASE);
+    TEST_CHECK(rx != NULL);
+    TEST_CHECK(mutt_regex_capture(rx, "REPLY is Needed", 0, NULL));
+    TEST_CHECK(!mutt_regex_capture(rx, "no response", 0, NULL));
+    mutt_regex_free(&rx);
+  }
+
+  {
+    /* A quantifier after a multibyte character must not leave a truncated
+     * byte sequence in the prefilter */
+    struct Regex *rx = mutt_regex_compile("caf\xc3\xa9?", 0);
+    TEST_CHECK(rx != NULL);
+    TEST_CHECK(mutt_regex_capture(rx, "visit the caf now", 0, NULL));
+    TEST_CHECK(!mutt_regex_capture(rx, "nothing to see", 0, NULL));
+    mutt_regex_free(&rx);
+  }
+
+  {
+    /* Case-insensitive patterns with non-ASCII bytes fold per locale in
+     * regexec(), which a byte-wise prefilter can't mirror */
+    struct Regex *rx = mutt_regex_compile("caf\xc3\xa9 special", REG_ICASE);
+    TEST_CHECK(rx != NULL);
+    TEST_CHECK(mutt_regex_capture(rx, "caf\xc3\xa9 special today", 0, NULL));
+    mutt_regex_free(&rx);
+  }
+
+  {
+    /* Captures are still filled in when a prefilter is active */
+    struct Regex *rx = mutt_regex_compile("^subject: (.*)", REG_ICASE);
+    TEST_CHECK(rx != NULL);
+    regmatch_t pmatch[2];
+    TEST_CHECK(mutt_regex_capture(rx, "Subject: hello", 2, pmatch));
+    TEST_CHECK(pmatch[1].rm_so == 9);
+    mutt_regex_free(&rx);
+  }
 }
@@ -0,0 +1,88 @@
+/**
+ * @file
+ * Test code for the token-bucket rate limiter
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+void test_mutt_throttle(void)
+{
+  // void mutt_throttle_init(struct TokenBucket *tb, uint64_t rate, uint64_t burst);
+  // bool mutt_throttle_take_at(struct TokenBucket *tb, uint64_t cost, uint64_t now_ms);
+
+  {
+    TEST_CHECK(!mutt_throttle_take(NULL, 1));
+    mutt_throttle_init(NULL, 1, 1); /* shouldn't crash */
+  }
+
+  {
+    /* The bucket starts full, then refills at the configured rate */
+    struct TokenBucket tb;
+    mutt_throttle_init(&tb, 2, 4);
+    tb.last_ms = 1000; /* pin the clock for the test */
+    tb.level_milli = tb.burst * 1000;
+
+    TEST_CHECK(mutt_throttle_take_at(&tb, 4, 1000)); /* whole burst at once */
+    TEST_CHECK(!mutt_throttle_take_at(&tb, 1, 1000)); /* now empty */
+
+    /* 500ms at 2 tokens/s is one token */
+    TEST_CHECK(!mutt_throttle_take_at(&tb, 2, 1500));
+    TEST_CHECK(mutt_throttle_take_at(&tb, 1, 1500));
+
+    /* A long quiet period refills to the burst cap, no further */
+    TEST_CHECK(mutt_throttle_take_at(&tb, 4, 1000000));
+    TEST_CHECK(!mutt_throttle_take_at(&tb, 1, 1000000));
+  }
+
+  {
+    /* A clock that goes backwards refills nothing */
+    struct TokenBucket tb;
+    mutt_throttle_init(&tb, 1, 1);
+    tb.last_ms = 5000;
+    tb.level_milli = 0;
+    TEST_CHECK(!mutt_throttle_take_at(&tb, 1, 4000));
+    TEST_CHECK(tb.level_milli == 0);
+  }
+
+  {
+    // uint64_t mutt_throttle_wait_ms(const struct TokenBucket *tb, uint64_t cost);
+
+    TEST_CHECK(mutt_throttle_wait_ms(NULL, 1) == UINT64_MAX);
+
+    struct TokenBucket tb;
+    mutt_throttle_init(&tb, 2, 4);
+    tb.level_milli = 0;
+
+    TEST_CHECK(mutt_throttle_wait_ms(&tb, 1) == 500);
+    TEST_CHECK(mutt_throttle_wait_ms(&tb, 4) == 2000);
+    TEST_CHECK(mutt_throttle_wait_ms(&tb, 5) == UINT64_MAX); /* exceeds burst */
+
+    tb.level_milli = 1000;
+    TEST_CHECK(mutt_throttle_wait_ms(&tb, 1) == 0);
+    TEST_CHECK(mutt_throttle_wait_ms(&tb, 2) == 500);
+
+    /* partial refills round up to the next millisecond */
+    tb.level_milli = 999;
+    TEST_CHECK(mutt_throttle_wait_ms(&tb, 1) == 1);
+  }
+}